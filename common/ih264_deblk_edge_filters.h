@@ -192,4 +192,11 @@ ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_vert_bslt4_mbaff_ssse3;
 ih264_deblk_chroma_edge_bslt4_ft ih264_deblk_chroma_horz_bslt4_mbaff_ssse3;
 
+/*AVX2*/
+ih264_deblk_edge_bs4_ft ih264_deblk_luma_horz_bs4_avx2;
+ih264_deblk_edge_bs4_ft ih264_deblk_luma_vert_bs4_avx2;
+
+ih264_deblk_edge_bslt4_ft ih264_deblk_luma_horz_bslt4_avx2;
+ih264_deblk_edge_bslt4_ft ih264_deblk_luma_vert_bslt4_avx2;
+
 #endif /* IH264_DEBLK_H_ */
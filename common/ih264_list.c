@@ -30,8 +30,6 @@
 *
 * @par List of Functions:
 *  ih264_list_size()
-*  ih264_list_lock()
-*  ih264_list_unlock()
 *  ih264_list_yield()
 *  ih264_list_free()
 *  ih264_list_init()
@@ -42,7 +40,10 @@
 *  ih264_list_dequeue()
 *
 * @remarks
-*  None
+*  The list is a bounded multi-producer multi-consumer queue. Each entry
+*  carries a sequence number, readers and writers claim entries with compare
+*  and swap on the read and write indices and then publish them through the
+*  sequence number, so queue and dequeue do not take a lock.
 *
 *******************************************************************************
 */
@@ -85,75 +86,16 @@ WORD32 ih264_list_size(WORD32 num_entries, WORD32 entry_size)
     WORD32 size;
     WORD32 clz;
     size = sizeof(list_t);
-    size += ithread_get_mutex_lock_size();
 
     /* Use next power of two number of entries*/
     clz = CLZ(num_entries);
     num_entries = 1 << (32 - clz);
 
     size  += num_entries * entry_size;
+    size  += num_entries * sizeof(UWORD32);
     return size;
 }
 
-/**
-*******************************************************************************
-*
-* @brief
-*   Locks the list context
-*
-* @par   Description
-*   Locks the list context by calling ithread_mutex_lock()
-*
-* @param[in] ps_list
-*   Job Queue context
-*
-* @returns IH264_FAIL if mutex lock fails else IH264_SUCCESS
-*
-* @remarks
-*
-*******************************************************************************
-*/
-IH264_ERROR_T ih264_list_lock(list_t *ps_list)
-{
-    WORD32 retval;
-    retval = ithread_mutex_lock(ps_list->pv_mutex);
-    if(retval)
-    {
-        return IH264_FAIL;
-    }
-    return IH264_SUCCESS;
-}
-
-/**
-*******************************************************************************
-*
-* @brief
-*   Unlocks the list context
-*
-* @par   Description
-*   Unlocks the list context by calling ithread_mutex_unlock()
-*
-* @param[in] ps_list
-*   Job Queue context
-*
-* @returns IH264_FAIL if mutex unlock fails else IH264_SUCCESS
-*
-* @remarks
-*
-*******************************************************************************
-*/
-
-IH264_ERROR_T ih264_list_unlock(list_t *ps_list)
-{
-    WORD32 retval;
-    retval = ithread_mutex_unlock(ps_list->pv_mutex);
-    if(retval)
-    {
-        return IH264_FAIL;
-    }
-    return IH264_SUCCESS;
-
-}
 /**
 *******************************************************************************
 *
@@ -161,16 +103,13 @@ IH264_ERROR_T ih264_list_unlock(list_t *ps_list)
 *   Yields the thread
 *
 * @par   Description
-*   Unlocks the list context by calling
-* ih264_list_unlock(), ithread_yield() and then ih264_list_lock()
-* list is unlocked before to ensure the list can be accessed by other threads
-* If unlock is not done before calling yield then no other thread can access
-* the list functions and update list.
+*   Calls ithread_yield() and sleeps for the yield interval of the list, if
+* any, so that the thread waiting on the list does not load the core
 *
 * @param[in] ps_list
 *   Job Queue context
 *
-* @returns IH264_FAIL if mutex lock unlock or yield fails else IH264_SUCCESS
+* @returns IH264_SUCCESS
 *
 * @remarks
 *
@@ -178,21 +117,12 @@ IH264_ERROR_T ih264_list_unlock(list_t *ps_list)
 */
 IH264_ERROR_T ih264_list_yield(list_t *ps_list)
 {
-
-    IH264_ERROR_T ret = IH264_SUCCESS;
-
-    IH264_ERROR_T rettmp;
-    rettmp = ih264_list_unlock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
-
     ithread_yield();
 
     if(ps_list->i4_yeild_interval_us > 0)
         ithread_usleep(ps_list->i4_yeild_interval_us);
 
-    rettmp = ih264_list_lock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
-    return ret;
+    return IH264_SUCCESS;
 }
 
 
@@ -202,7 +132,8 @@ IH264_ERROR_T ih264_list_yield(list_t *ps_list)
 * @brief free the buf queue pointers
 *
 * @par   Description
-* Frees the list context
+* Frees the list context. The list holds no resources other than the memory
+* given at init, so there is nothing to be released
 *
 * @param[in] pv_buf
 * Memory for buf queue buffer and buf queue context
@@ -216,13 +147,8 @@ IH264_ERROR_T ih264_list_yield(list_t *ps_list)
 */
 IH264_ERROR_T ih264_list_free(list_t *ps_list)
 {
-    WORD32 ret;
-    ret = ithread_mutex_destroy(ps_list->pv_mutex);
-
-    if(0 == ret)
-        return IH264_SUCCESS;
-    else
-        return IH264_FAIL;
+    UNUSED(ps_list);
+    return IH264_SUCCESS;
 }
 
 /**
@@ -262,30 +188,26 @@ void* ih264_list_init(void *pv_buf,
     pu1_buf += sizeof(list_t);
     buf_size -= sizeof(list_t);
 
-    ps_list->pv_mutex = pu1_buf;
-    pu1_buf += ithread_get_mutex_lock_size();
-    buf_size -= ithread_get_mutex_lock_size();
-
     if (buf_size <= 0)
       return NULL;
 
-    ithread_mutex_init(ps_list->pv_mutex);
-
     /* Ensure num_entries is power of two */
     ASSERT(0 == (num_entries & (num_entries - 1)));
 
     /* Ensure remaining buffer is large enough to hold given number of entries */
-    ASSERT((num_entries * entry_size) <= buf_size);
+    ASSERT((num_entries * (entry_size + (WORD32)sizeof(UWORD32))) <= buf_size);
 
     ps_list->pv_buf_base = pu1_buf;
-    ps_list->i4_terminate = 0;
+    pu1_buf += num_entries * entry_size;
+    ps_list->pu4_entry_seq = (volatile UWORD32 *)pu1_buf;
+
     ps_list->i4_entry_size = entry_size;
-    ps_list->i4_buf_rd_idx = 0;
-    ps_list->i4_buf_wr_idx = 0;
     ps_list->i4_log2_buf_max_idx = 32 - CLZ(num_entries);
     ps_list->i4_buf_max_idx = num_entries;
     ps_list->i4_yeild_interval_us = yeild_interval_us;
 
+    ih264_list_reset(ps_list);
+
     return ps_list;
 }
 /**
@@ -300,26 +222,30 @@ void* ih264_list_init(void *pv_buf,
 * @param[in] ps_list
 *   Job Queue context
 *
-* @returns IH264_FAIL if lock unlock fails else IH264_SUCCESS
+* @returns IH264_SUCCESS
 *
 * @remarks
+*   Not thread safe, the list should not be in use by any other thread
 *
 *******************************************************************************
 */
 IH264_ERROR_T ih264_list_reset(list_t *ps_list)
 {
-    IH264_ERROR_T ret = IH264_SUCCESS;
-    ret = ih264_list_lock(ps_list);
-    RETURN_IF((ret != IH264_SUCCESS), ret);
+    WORD32 i;
 
     ps_list->i4_terminate  = 0;
-    ps_list->i4_buf_rd_idx = 0;
-    ps_list->i4_buf_wr_idx = 0;
+    ps_list->u4_buf_rd_idx = 0;
+    ps_list->u4_buf_wr_idx = 0;
 
-    ret = ih264_list_unlock(ps_list);
-    RETURN_IF((ret != IH264_SUCCESS), ret);
+    /* Every entry is free for the first round of writes */
+    for(i = 0; i < ps_list->i4_buf_max_idx; i++)
+    {
+        ps_list->pu4_entry_seq[i] = i;
+    }
+
+    __sync_synchronize();
 
-    return ret;
+    return IH264_SUCCESS;
 }
 
 /**
@@ -330,12 +256,11 @@ IH264_ERROR_T ih264_list_reset(list_t *ps_list)
 *
 * @par   Description
 *   Deinitializes the list context by calling ih264_list_reset()
-* and then destrying the mutex created
 *
 * @param[in] ps_list
 *   Job Queue context
 *
-* @returns IH264_FAIL if lock unlock fails else IH264_SUCCESS
+* @returns IH264_SUCCESS
 *
 * @remarks
 *
@@ -343,19 +268,7 @@ IH264_ERROR_T ih264_list_reset(list_t *ps_list)
 */
 IH264_ERROR_T ih264_list_deinit(list_t *ps_list)
 {
-    WORD32 retval;
-    IH264_ERROR_T ret = IH264_SUCCESS;
-
-    ret = ih264_list_reset(ps_list);
-    RETURN_IF((ret != IH264_SUCCESS), ret);
-
-    retval = ithread_mutex_destroy(ps_list->pv_mutex);
-    if(retval)
-    {
-        return IH264_FAIL;
-    }
-
-    return IH264_SUCCESS;
+    return ih264_list_reset(ps_list);
 }
 
 
@@ -371,7 +284,7 @@ IH264_ERROR_T ih264_list_deinit(list_t *ps_list)
 * @param[in] ps_list
 *   Job Queue context
 *
-* @returns IH264_FAIL if lock unlock fails else IH264_SUCCESS
+* @returns IH264_SUCCESS
 *
 * @remarks
 *
@@ -380,15 +293,10 @@ IH264_ERROR_T ih264_list_deinit(list_t *ps_list)
 
 IH264_ERROR_T ih264_list_terminate(list_t *ps_list)
 {
-    IH264_ERROR_T ret = IH264_SUCCESS;
-    ret = ih264_list_lock(ps_list);
-    RETURN_IF((ret != IH264_SUCCESS), ret);
-
     ps_list->i4_terminate = 1;
+    __sync_synchronize();
 
-    ret = ih264_list_unlock(ps_list);
-    RETURN_IF((ret != IH264_SUCCESS), ret);
-    return ret;
+    return IH264_SUCCESS;
 }
 
 
@@ -401,6 +309,10 @@ IH264_ERROR_T ih264_list_terminate(list_t *ps_list)
 * Adds a buf to the queue and updates wr address to next location.
 * Format/content of the buf structure is abstracted and hence size of the buf
 * buffer is being passed.
+* The entry at the write index is claimed by incrementing the write index
+* with compare and swap, once its sequence number shows that it has been read.
+* The buf is then copied and the entry is published by updating its sequence
+* number.
 *
 * @param[in] ps_list
 *   Job Queue context
@@ -408,76 +320,65 @@ IH264_ERROR_T ih264_list_terminate(list_t *ps_list)
 * @param[in] pv_buf
 *   Pointer to the location that contains details of the buf to be added
 *
-* @param[in] buf_size
-*   Size of the buf buffer
-*
 * @param[in] blocking
 *   To signal if the write is blocking or non-blocking.
 *
-* @returns
+* @returns IH264_FAIL if the list is full and the write is non-blocking
 *
 * @remarks
 * Job Queue buffer is assumed to be allocated to handle worst case number of bufs
-* Wrap around is not supported
 *
 *******************************************************************************
 */
 IH264_ERROR_T ih264_list_queue(list_t *ps_list, void *pv_buf, WORD32 blocking)
 {
-    IH264_ERROR_T ret = IH264_SUCCESS;
-    IH264_ERROR_T rettmp;
-
-    WORD32 diff;
-    void *pv_buf_wr;
-
-    volatile WORD32 *pi4_wr_idx, *pi4_rd_idx;
     WORD32 buf_size = ps_list->i4_entry_size;
+    UWORD32 mask = ps_list->i4_buf_max_idx - 1;
+    UWORD32 wr_idx;
+    void *pv_buf_wr;
 
-
-    rettmp = ih264_list_lock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
-
-
-
+    wr_idx = ps_list->u4_buf_wr_idx;
     while(1)
     {
-        /* Ensure wr idx does not go beyond rd idx by more than number of entries
-         */
-        pi4_wr_idx = &ps_list->i4_buf_wr_idx;
-        pi4_rd_idx = &ps_list->i4_buf_rd_idx;
-        diff = *pi4_wr_idx - *pi4_rd_idx;
+        WORD32 diff;
+
+        diff = (WORD32)(ps_list->pu4_entry_seq[wr_idx & mask] - wr_idx);
 
-        if(diff < ps_list->i4_buf_max_idx)
+        if(0 == diff)
         {
-            WORD32 wr_idx;
-            wr_idx = ps_list->i4_buf_wr_idx & (ps_list->i4_buf_max_idx - 1);
-            pv_buf_wr = (UWORD8 *)ps_list->pv_buf_base + wr_idx * buf_size;
+            /* Entry is free, claim it unless another writer got there first */
+            UWORD32 prev_idx = __sync_val_compare_and_swap(&ps_list->u4_buf_wr_idx,
+                                                           wr_idx, wr_idx + 1);
+            if(prev_idx == wr_idx)
+                break;
+            wr_idx = prev_idx;
+        }
+        else if(diff < 0)
+        {
+            /* wr is ahead, so wait for rd to consume */
+            if(!blocking)
+                return IH264_FAIL;
 
-            memcpy(pv_buf_wr, pv_buf, buf_size);
-            ps_list->i4_buf_wr_idx++;
-            break;
+            ih264_list_yield(ps_list);
+            wr_idx = ps_list->u4_buf_wr_idx;
         }
         else
         {
-            /* wr is ahead, so wait for rd to consume */
-            if(blocking)
-            {
-                ih264_list_yield(ps_list);
-            }
-            else
-            {
-                ret = IH264_FAIL;
-                break;
-            }
+            /* Another writer has claimed the entry */
+            wr_idx = ps_list->u4_buf_wr_idx;
         }
-
     }
-    ps_list->i4_terminate = 0;
 
-    rettmp = ih264_list_unlock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
+    pv_buf_wr = (UWORD8 *)ps_list->pv_buf_base + (wr_idx & mask) * buf_size;
+    memcpy(pv_buf_wr, pv_buf, buf_size);
+
+    /* Publish the entry after its contents */
+    __sync_synchronize();
+    ps_list->pu4_entry_seq[wr_idx & mask] = wr_idx + 1;
+
+    ps_list->i4_terminate = 0;
 
-    return ret;
+    return IH264_SUCCESS;
 }
 /**
 *******************************************************************************
@@ -487,9 +388,11 @@ IH264_ERROR_T ih264_list_queue(list_t *ps_list, void *pv_buf, WORD32 blocking)
 * @par   Description
 * Gets next buf from the buf queue and updates rd address to next location.
 * Format/content of the buf structure is abstracted and hence size of the buf
-* buffer is being passed. If it is a blocking call and if there is no new buf
-* then this functions unlocks the mutex and calls yield and then locks it back.
-* and continues till a buf is available or terminate is set
+* buffer is being passed. The entry at the read index is claimed by
+* incrementing the read index with compare and swap, once its sequence number
+* shows that it has been written. If it is a blocking call and if there is no
+* new buf then this functions calls yield and continues till a buf is
+* available or terminate is set
 *
 * @param[in] ps_list
 *   Job Queue context
@@ -497,78 +400,67 @@ IH264_ERROR_T ih264_list_queue(list_t *ps_list, void *pv_buf, WORD32 blocking)
 * @param[out] pv_buf
 *   Pointer to the location that contains details of the buf to be written
 *
-* @param[in] buf_size
-*   Size of the buf buffer
-*
 * @param[in] blocking
 *   To signal if the read is blocking or non-blocking.
 *
-* @returns
+* @returns IH264_FAIL if the list is empty and the read is non-blocking or the
+* list is terminated
 *
 * @remarks
 * Job Queue buffer is assumed to be allocated to handle worst case number of bufs
-* Wrap around is not supported
 *
 *******************************************************************************
 */
 IH264_ERROR_T ih264_list_dequeue(list_t *ps_list, void *pv_buf, WORD32 blocking)
 {
-    IH264_ERROR_T ret = IH264_SUCCESS;
-    IH264_ERROR_T rettmp;
     WORD32 buf_size = ps_list->i4_entry_size;
-    WORD32 diff;
-
+    UWORD32 mask = ps_list->i4_buf_max_idx - 1;
+    UWORD32 rd_idx;
     void *pv_buf_rd;
-    volatile WORD32 *pi4_wr_idx, *pi4_rd_idx;
-
-    rettmp = ih264_list_lock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
 
+    rd_idx = ps_list->u4_buf_rd_idx;
     while(1)
     {
-        /* Ensure wr idx is ahead of rd idx and
-         * wr idx does not go beyond rd idx by more than number of entries
-         */
-        pi4_wr_idx = &ps_list->i4_buf_wr_idx;
-        pi4_rd_idx = &ps_list->i4_buf_rd_idx;
-        diff = *pi4_wr_idx - *pi4_rd_idx;
+        WORD32 diff;
 
+        diff = (WORD32)(ps_list->pu4_entry_seq[rd_idx & mask] - (rd_idx + 1));
 
-        if(diff > 0)
+        if(0 == diff)
+        {
+            /* Entry is filled, claim it unless another reader got there first */
+            UWORD32 prev_idx = __sync_val_compare_and_swap(&ps_list->u4_buf_rd_idx,
+                                                           rd_idx, rd_idx + 1);
+            if(prev_idx == rd_idx)
+                break;
+            rd_idx = prev_idx;
+        }
+        else if(diff < 0)
         {
-            WORD32 rd_idx;
-            rd_idx = ps_list->i4_buf_rd_idx & (ps_list->i4_buf_max_idx - 1);
-            pv_buf_rd = (UWORD8 *)ps_list->pv_buf_base + rd_idx * buf_size;
+            /* If terminate is signaled then break, unless a writer has
+             * claimed the entry and is yet to fill it
+             */
+            if(ps_list->i4_terminate && (ps_list->u4_buf_wr_idx == rd_idx))
+                return IH264_FAIL;
 
-            memcpy(pv_buf, pv_buf_rd, buf_size);
-            ps_list->i4_buf_rd_idx++;
-            break;
+            if(!blocking)
+                return IH264_FAIL;
+
+            ih264_list_yield(ps_list);
+            rd_idx = ps_list->u4_buf_rd_idx;
         }
         else
         {
-            /* If terminate is signaled then break */
-            if(ps_list->i4_terminate)
-            {
-                ret = IH264_FAIL;
-                break;
-            }
-            /* wr is ahead, so wait for rd to consume */
-            if(blocking)
-            {
-                ih264_list_yield(ps_list);
-            }
-            else
-            {
-                ret = IH264_FAIL;
-                break;
-            }
+            /* Another reader has claimed the entry */
+            rd_idx = ps_list->u4_buf_rd_idx;
         }
-
     }
 
+    pv_buf_rd = (UWORD8 *)ps_list->pv_buf_base + (rd_idx & mask) * buf_size;
+    memcpy(pv_buf, pv_buf_rd, buf_size);
 
-    rettmp = ih264_list_unlock(ps_list);
-    RETURN_IF((rettmp != IH264_SUCCESS), rettmp);
+    /* Free the entry for the next round of writes after its contents are read */
+    __sync_synchronize();
+    ps_list->pu4_entry_seq[rd_idx & mask] = rd_idx + ps_list->i4_buf_max_idx;
 
-    return ret;
+    return IH264_SUCCESS;
 }
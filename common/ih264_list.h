@@ -39,19 +39,20 @@
 #ifndef _IH264_LIST_H_
 #define _IH264_LIST_H_
 
+/** Size of a cache line, the read and write indices are kept on separate lines */
+#define LIST_CACHE_LINE_SIZE 64
+
 typedef struct
 {
     /** Pointer to buffer base which contains the bufs */
     void *pv_buf_base;
 
-    /** Mutex used to keep the functions thread-safe */
-    void *pv_mutex;
-
-    /** Current write index */
-    volatile WORD32 i4_buf_wr_idx;
-
-    /** Current read index */
-    volatile WORD32 i4_buf_rd_idx;
+    /** Sequence number of each entry. It equals the write index that can fill
+     * the entry while the entry is free, and the write index plus one once it
+     * is filled. Readers and writers claim entries by incrementing the read
+     * and write indices with compare and swap, so no lock is taken.
+     */
+    volatile UWORD32 *pu4_entry_seq;
 
     /** Maximum index */
     WORD32 i4_buf_max_idx;
@@ -63,7 +64,7 @@ typedef struct
     WORD32 i4_log2_buf_max_idx;
 
     /** Flag to indicate list has to be terminated */
-    WORD32 i4_terminate;
+    volatile WORD32 i4_terminate;
 
     /** Size of each entry */
     WORD32 i4_entry_size;
@@ -75,6 +76,18 @@ typedef struct
      */
     WORD32 i4_yeild_interval_us;
 
+    UWORD8 au1_pad0[LIST_CACHE_LINE_SIZE];
+
+    /** Current write index */
+    volatile UWORD32 u4_buf_wr_idx;
+
+    UWORD8 au1_pad1[LIST_CACHE_LINE_SIZE];
+
+    /** Current read index */
+    volatile UWORD32 u4_buf_rd_idx;
+
+    UWORD8 au1_pad2[LIST_CACHE_LINE_SIZE];
+
 }list_t;
 
 WORD32 ih264_list_size(WORD32 num_entries, WORD32 entry_size);
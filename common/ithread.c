@@ -35,6 +35,10 @@
 /*****************************************************************************/
 /* File Includes                                                             */
 /*****************************************************************************/
+/* cpu_set_t and sched_setaffinity() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <string.h>
 #include "ih264_typedefs.h"
 
@@ -50,7 +54,6 @@
 //#define SYSCALL_AFFINITY
 
 #ifdef PTHREAD_AFFINITY
-#define _GNU_SOURCE
 #define __USE_GNU
 #endif
 
@@ -58,6 +61,8 @@
 #include <sched.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
 #ifdef PTHREAD_AFFINITY
 #include <sys/prctl.h>
 #endif
@@ -131,6 +136,14 @@ void ithread_usleep(UWORD32 u4_time_us)
     usleep(u4_time_us);
 }
 
+UWORD64 ithread_get_time_ns(void)
+{
+    struct timespec s_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &s_time);
+    return ((UWORD64)s_time.tv_sec * 1000000000ULL + (UWORD64)s_time.tv_nsec);
+}
+
 UWORD32 ithread_get_sem_struct_size(void)
 {
     return(sizeof(sem_t));
@@ -159,6 +172,208 @@ WORD32 ithread_sem_destroy(void *sem)
     return sem_destroy((sem_t *)sem);
 }
 
+UWORD32 ithread_get_cond_struct_size(void)
+{
+    return(sizeof(pthread_cond_t));
+}
+
+WORD32 ithread_cond_init(void *cond)
+{
+    return pthread_cond_init((pthread_cond_t *)cond, NULL);
+}
+
+WORD32 ithread_cond_destroy(void *cond)
+{
+    return pthread_cond_destroy((pthread_cond_t *)cond);
+}
+
+WORD32 ithread_cond_wait(void *cond, void *mutex)
+{
+    return pthread_cond_wait((pthread_cond_t *)cond, (pthread_mutex_t *)mutex);
+}
+
+WORD32 ithread_cond_signal(void *cond)
+{
+    return pthread_cond_signal((pthread_cond_t *)cond);
+}
+
+WORD32 ithread_cond_broadcast(void *cond)
+{
+    return pthread_cond_broadcast((pthread_cond_t *)cond);
+}
+
+/* Number of cpu relax iterations in one spin round */
+#define ITHREAD_PROGRESS_SPIN_ITERS     64
+
+/* Upper bound on a single blocking wait, in microseconds */
+#define ITHREAD_PROGRESS_MAX_BLOCK_US   2000
+
+#if defined(__i386__) || defined(__x86_64__)
+#define ITHREAD_CPU_RELAX()     __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__arm__) || defined(__aarch64__)
+#define ITHREAD_CPU_RELAX()     __asm__ __volatile__("yield" ::: "memory")
+#else
+#define ITHREAD_CPU_RELAX()     __asm__ __volatile__("" ::: "memory")
+#endif
+
+typedef struct
+{
+    pthread_mutex_t s_mutex;
+
+    pthread_cond_t s_cond;
+
+    /* Incremented on every ithread_progress_post() */
+    volatile UWORD32 u4_seq;
+
+    /* Number of threads blocked in ithread_progress_wait() */
+    volatile WORD32 i4_num_waiters;
+
+    /* Number of spin rounds before a waiter blocks */
+    WORD32 i4_max_spin_cnt;
+
+    /* Total time spent blocked, in microseconds */
+    volatile UWORD64 u8_wait_time_us;
+
+    /* Number of times a waiter blocked */
+    volatile UWORD32 u4_num_blocks;
+}ithread_progress_t;
+
+UWORD32 ithread_get_progress_struct_size(void)
+{
+    return(sizeof(ithread_progress_t));
+}
+
+WORD32 ithread_progress_init(void *pv_progress, WORD32 i4_max_spin_cnt)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+    WORD32 ret;
+
+    ps_progress->u4_seq = 0;
+    ps_progress->i4_num_waiters = 0;
+    ps_progress->u8_wait_time_us = 0;
+    ps_progress->u4_num_blocks = 0;
+
+    /* atleast one spin round is needed to sample the sequence number */
+    ps_progress->i4_max_spin_cnt = (i4_max_spin_cnt < 1) ? 1 : i4_max_spin_cnt;
+
+    ret = pthread_mutex_init(&ps_progress->s_mutex, NULL);
+    if(ret)
+        return ret;
+
+    return pthread_cond_init(&ps_progress->s_cond, NULL);
+}
+
+WORD32 ithread_progress_destroy(void *pv_progress)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+
+    pthread_cond_destroy(&ps_progress->s_cond);
+    return pthread_mutex_destroy(&ps_progress->s_mutex);
+}
+
+void ithread_progress_post(void *pv_progress)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+
+    /* full barrier, orders the caller's map update before the waiter check */
+    __sync_fetch_and_add(&ps_progress->u4_seq, 1);
+
+    if(ps_progress->i4_num_waiters)
+    {
+        pthread_mutex_lock(&ps_progress->s_mutex);
+        pthread_cond_broadcast(&ps_progress->s_cond);
+        pthread_mutex_unlock(&ps_progress->s_mutex);
+    }
+}
+
+WORD32 ithread_progress_spin(void *pv_progress, ithread_wait_state_t *ps_wait)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+    WORD32 i;
+
+    if(ps_wait->i4_spin_cnt >= ps_progress->i4_max_spin_cnt)
+        return 0;
+
+    ps_wait->i4_spin_cnt++;
+    for(i = 0; i < ITHREAD_PROGRESS_SPIN_ITERS; i++)
+    {
+        ITHREAD_CPU_RELAX();
+    }
+
+    /* sample the sequence before the caller checks its condition again */
+    ps_wait->u4_seq = ps_progress->u4_seq;
+    __sync_synchronize();
+
+    return 1;
+}
+
+void ithread_progress_wait(void *pv_progress, ithread_wait_state_t *ps_wait)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+    struct timeval s_start, s_end;
+    struct timespec s_abstime;
+
+    ps_wait->i4_spin_cnt = 0;
+
+    gettimeofday(&s_start, NULL);
+
+    s_abstime.tv_sec = s_start.tv_sec;
+    s_abstime.tv_nsec = (s_start.tv_usec + ITHREAD_PROGRESS_MAX_BLOCK_US) * 1000L;
+    if(s_abstime.tv_nsec >= 1000000000L)
+    {
+        s_abstime.tv_sec += s_abstime.tv_nsec / 1000000000L;
+        s_abstime.tv_nsec %= 1000000000L;
+    }
+
+    pthread_mutex_lock(&ps_progress->s_mutex);
+
+    /* full barrier, orders the waiter count before the sequence check */
+    __sync_fetch_and_add(&ps_progress->i4_num_waiters, 1);
+
+    /*
+     * Block only if nothing was posted since the sequence was sampled. The
+     * wait is bounded, so the caller always gets to recheck its condition
+     */
+    if(ps_progress->u4_seq == ps_wait->u4_seq)
+    {
+        pthread_cond_timedwait(&ps_progress->s_cond, &ps_progress->s_mutex,
+                               &s_abstime);
+    }
+
+    __sync_fetch_and_sub(&ps_progress->i4_num_waiters, 1);
+
+    gettimeofday(&s_end, NULL);
+    ps_progress->u8_wait_time_us += (UWORD64)((s_end.tv_sec - s_start.tv_sec) * 1000000LL
+                    + (s_end.tv_usec - s_start.tv_usec));
+    ps_progress->u4_num_blocks++;
+
+    pthread_mutex_unlock(&ps_progress->s_mutex);
+}
+
+UWORD64 ithread_progress_get_wait_time(void *pv_progress)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+
+    return ps_progress->u8_wait_time_us;
+}
+
+UWORD32 ithread_progress_get_num_blocks(void *pv_progress)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+
+    return ps_progress->u4_num_blocks;
+}
+
+void ithread_progress_reset_stats(void *pv_progress)
+{
+    ithread_progress_t *ps_progress = (ithread_progress_t *)pv_progress;
+
+    pthread_mutex_lock(&ps_progress->s_mutex);
+    ps_progress->u8_wait_time_us = 0;
+    ps_progress->u4_num_blocks = 0;
+    pthread_mutex_unlock(&ps_progress->s_mutex);
+}
+
 void ithread_set_name(CHAR *pc_thread_name)
 {
 
@@ -209,3 +424,27 @@ WORD32 ithread_set_affinity(WORD32 core_id)
     return 1;
 
 }
+
+/* Restricts the calling thread to the given CPUs. Returns 0 on success */
+WORD32 ithread_set_affinity_list(const WORD32 *pi4_cpu_ids, WORD32 i4_num_cpus)
+{
+#ifdef __linux__
+    cpu_set_t cpuset;
+    WORD32 i;
+
+    CPU_ZERO(&cpuset);
+    for(i = 0; i < i4_num_cpus; i++)
+    {
+        if((pi4_cpu_ids[i] < 0) || (pi4_cpu_ids[i] >= CPU_SETSIZE))
+            return -1;
+        CPU_SET(pi4_cpu_ids[i], &cpuset);
+    }
+
+    /* pid 0 is the calling thread */
+    return sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+#else
+    UNUSED(pi4_cpu_ids);
+    UNUSED(i4_num_cpus);
+    return -1;
+#endif
+}
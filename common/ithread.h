@@ -39,12 +39,29 @@
 /*                          ithread_sleep                                    */
 /*                          ithread_msleep                                   */
 /*                          ithread_usleep                                   */
+/*                          ithread_get_time_ns                              */
 /*                          ithread_get_sem_struct_size                      */
 /*                          ithread_sem_init                                 */
 /*                          ithread_sem_post                                 */
 /*                          ithread_sem_wait                                 */
 /*                          ithread_sem_destroy                              */
+/*                          ithread_get_cond_struct_size                     */
+/*                          ithread_cond_init                                */
+/*                          ithread_cond_destroy                             */
+/*                          ithread_cond_wait                                */
+/*                          ithread_cond_signal                              */
+/*                          ithread_cond_broadcast                           */
+/*                          ithread_get_progress_struct_size                 */
+/*                          ithread_progress_init                            */
+/*                          ithread_progress_destroy                         */
+/*                          ithread_progress_post                            */
+/*                          ithread_progress_spin                            */
+/*                          ithread_progress_wait                            */
+/*                          ithread_progress_get_wait_time                   */
+/*                          ithread_progress_get_num_blocks                  */
+/*                          ithread_progress_reset_stats                     */
 /*                          ithread_set_affinity                             */
+/*                          ithread_set_affinity_list                        */
 /*                                                                           */
 /*  Issues / Problems : None                                                 */
 /*                                                                           */
@@ -58,6 +75,23 @@
 #ifndef _ITHREAD_H_
 #define _ITHREAD_H_
 
+/*
+ * Progress primitive
+ * A producer calls ithread_progress_post() after it updates shared progress
+ * (e.g. an MB map). A consumer checks its condition and, while it is not met,
+ * calls ithread_progress_spin() which spins for a bounded number of rounds.
+ * Once spinning is exhausted, ithread_progress_wait() blocks until the next
+ * post. The wait state has to be zero initialized before the first check
+ */
+typedef struct
+{
+    /* Spin rounds done since the last block */
+    WORD32 i4_spin_cnt;
+
+    /* Progress sequence sampled before the last failed check */
+    UWORD32 u4_seq;
+}ithread_wait_state_t;
+
 UWORD32 ithread_get_handle_size(void);
 
 UWORD32 ithread_get_mutex_lock_size(void);
@@ -84,6 +118,9 @@ void    ithread_msleep(UWORD32 u4_time_ms);
 
 void    ithread_usleep(UWORD32 u4_time_us);
 
+/* Monotonic time in nanoseconds, used for instrumentation */
+UWORD64 ithread_get_time_ns(void);
+
 UWORD32 ithread_get_sem_struct_size(void);
 
 WORD32  ithread_sem_init(void *sem,WORD32 pshared,UWORD32 value);
@@ -94,8 +131,40 @@ WORD32  ithread_sem_wait(void *sem);
 
 WORD32  ithread_sem_destroy(void *sem);
 
+UWORD32 ithread_get_cond_struct_size(void);
+
+WORD32  ithread_cond_init(void *cond);
+
+WORD32  ithread_cond_destroy(void *cond);
+
+WORD32  ithread_cond_wait(void *cond, void *mutex);
+
+WORD32  ithread_cond_signal(void *cond);
+
+WORD32  ithread_cond_broadcast(void *cond);
+
+UWORD32 ithread_get_progress_struct_size(void);
+
+WORD32  ithread_progress_init(void *pv_progress, WORD32 i4_max_spin_cnt);
+
+WORD32  ithread_progress_destroy(void *pv_progress);
+
+void    ithread_progress_post(void *pv_progress);
+
+WORD32  ithread_progress_spin(void *pv_progress, ithread_wait_state_t *ps_wait);
+
+void    ithread_progress_wait(void *pv_progress, ithread_wait_state_t *ps_wait);
+
+UWORD64 ithread_progress_get_wait_time(void *pv_progress);
+
+UWORD32 ithread_progress_get_num_blocks(void *pv_progress);
+
+void    ithread_progress_reset_stats(void *pv_progress);
+
 WORD32  ithread_set_affinity(WORD32 core_id);
 
+WORD32  ithread_set_affinity_list(const WORD32 *pi4_cpu_ids, WORD32 i4_num_cpus);
+
 void    ithread_set_name(CHAR *pc_thread_name);
 
 #endif /* _ITHREAD_H_ */
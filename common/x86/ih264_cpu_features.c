@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.c
+*
+* @brief
+*  Contains function to detect x86 SIMD extensions at runtime
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ih264_get_cpu_features()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stddef.h>
+#include <cpuid.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_cpu_features.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+/* CPUID.1:ECX */
+#define CPUID1_ECX_SSSE3        (1 << 9)
+#define CPUID1_ECX_SSE42        (1 << 20)
+#define CPUID1_ECX_OSXSAVE      (1 << 27)
+#define CPUID1_ECX_AVX          (1 << 28)
+
+/* CPUID.(EAX=7,ECX=0):EBX */
+#define CPUID7_EBX_AVX2         (1 << 5)
+
+/* XCR0 bits for SSE and AVX register state */
+#define XCR0_SSE_AVX_STATE      0x6
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns the SIMD extensions usable on the current cpu
+*
+* @par Description:
+*  Queries cpuid for SSSE3, SSE4.2 and AVX2. AVX2 is reported only if the OS
+*  saves the ymm register state (XGETBV), as otherwise using it would fault
+*
+* @returns
+*  Bit mask of CPU_FEATURE_* flags
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+UWORD32 ih264_get_cpu_features(void)
+{
+    UWORD32 u4_eax, u4_ebx, u4_ecx, u4_edx;
+    UWORD32 u4_max_leaf;
+    UWORD32 u4_features = 0;
+
+    u4_max_leaf = __get_cpuid_max(0, NULL);
+    if(u4_max_leaf < 1)
+        return u4_features;
+
+    __cpuid(1, u4_eax, u4_ebx, u4_ecx, u4_edx);
+
+    if(u4_ecx & CPUID1_ECX_SSSE3)
+        u4_features |= CPU_FEATURE_SSSE3;
+
+    if(u4_ecx & CPUID1_ECX_SSE42)
+        u4_features |= CPU_FEATURE_SSE42;
+
+    if((u4_max_leaf >= 7) && (u4_ecx & CPUID1_ECX_OSXSAVE)
+                    && (u4_ecx & CPUID1_ECX_AVX))
+    {
+        UWORD32 u4_xcr0_lo, u4_xcr0_hi;
+
+        /* xgetbv with ecx = 0, encoded as bytes to not need -mxsave */
+        __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0"
+                        : "=a"(u4_xcr0_lo), "=d"(u4_xcr0_hi) : "c"(0));
+        (void)u4_xcr0_hi;
+
+        if((u4_xcr0_lo & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE)
+        {
+            __cpuid_count(7, 0, u4_eax, u4_ebx, u4_ecx, u4_edx);
+            if(u4_ebx & CPUID7_EBX_AVX2)
+                u4_features |= CPU_FEATURE_AVX2;
+        }
+    }
+
+    return u4_features;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.h
+*
+* @brief
+*  Runtime detection of x86 SIMD extensions
+*
+* @author
+*  Ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef _IH264_CPU_FEATURES_H_
+#define _IH264_CPU_FEATURES_H_
+
+/** SSSE3 is supported */
+#define CPU_FEATURE_SSSE3       (1 << 0)
+
+/** SSE4.2 is supported */
+#define CPU_FEATURE_SSE42       (1 << 1)
+
+/** AVX2 is supported by the cpu and its state is saved by the OS */
+#define CPU_FEATURE_AVX2        (1 << 2)
+
+UWORD32 ih264_get_cpu_features(void);
+
+#endif /* _IH264_CPU_FEATURES_H_ */
@@ -0,0 +1,501 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_deblk_luma_avx2.c                              */
+/*                                                                           */
+/*  Description       : Contains function definitions for luma deblocking    */
+/*                      in x86 avx2 intrinsics                               */
+/*                                                                           */
+/*  List of Functions : ih264_deblk_luma_vert_bs4_avx2()                     */
+/*                      ih264_deblk_luma_horz_bs4_avx2()                     */
+/*                      ih264_deblk_luma_vert_bslt4_avx2()                   */
+/*                      ih264_deblk_luma_horz_bslt4_avx2()                   */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_platform_macros.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_macros.h"
+
+/*****************************************************************************/
+/* Static Function Definitions                                               */
+/*****************************************************************************/
+/* All the 16 samples along an edge are filtered together in 16 bit         */
+/* precision. ppix_16x16b[0] to ppix_16x16b[7] hold the samples p3, p2, p1, */
+/* p0, q0, q1, q2 and q3 of the edge, one sample position per word.         */
+/*****************************************************************************/
+
+/* Transposes the 8x8 byte blocks held in the lower halves of the two lanes */
+/* of the 8 inputs; output k holds columns 2k and 2k + 1 of each block      */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_transpose_8x8x2_avx2(__m256i *pin_32x8b,
+                                                                     __m256i *pout_32x8b)
+{
+    __m256i a0, a1, a2, a3, b0, b1, b2, b3;
+
+    a0 = _mm256_unpacklo_epi8(pin_32x8b[0], pin_32x8b[1]);
+    a1 = _mm256_unpacklo_epi8(pin_32x8b[2], pin_32x8b[3]);
+    a2 = _mm256_unpacklo_epi8(pin_32x8b[4], pin_32x8b[5]);
+    a3 = _mm256_unpacklo_epi8(pin_32x8b[6], pin_32x8b[7]);
+
+    b0 = _mm256_unpacklo_epi16(a0, a1);
+    b1 = _mm256_unpackhi_epi16(a0, a1);
+    b2 = _mm256_unpacklo_epi16(a2, a3);
+    b3 = _mm256_unpackhi_epi16(a2, a3);
+
+    pout_32x8b[0] = _mm256_unpacklo_epi32(b0, b2);
+    pout_32x8b[1] = _mm256_unpackhi_epi32(b0, b2);
+    pout_32x8b[2] = _mm256_unpacklo_epi32(b1, b3);
+    pout_32x8b[3] = _mm256_unpackhi_epi32(b1, b3);
+}
+
+/* Loads p3 to q3 across a vertical edge of 16 (or 8) rows */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_load_vert_avx2(UWORD8 *pu1_src,
+                                                                    WORD32 src_strd,
+                                                                    WORD32 rows,
+                                                                    __m256i *ppix_16x16b)
+{
+    __m256i line_32x8b[8], col_32x8b[4];
+    WORD32 i;
+
+    pu1_src -= 4;
+    for(i = 0; i < 8; i++)
+    {
+        __m128i line_16x8b = _mm_loadl_epi64((__m128i *)(pu1_src + i * src_strd));
+
+        if(rows == 16)
+            line_32x8b[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(line_16x8b),
+                                                    _mm_loadl_epi64((__m128i *)(pu1_src + (i + 8) * src_strd)),
+                                                    1);
+        else
+            line_32x8b[i] = _mm256_broadcastsi128_si256(line_16x8b);
+    }
+
+    ih264_deblk_transpose_8x8x2_avx2(line_32x8b, col_32x8b);
+
+    for(i = 0; i < 4; i++)
+    {
+        /* rows 0-7 and 8-15 of a column made contiguous */
+        __m256i col_r0r15_32x8b = _mm256_permute4x64_epi64(col_32x8b[i], 0xD8);
+
+        ppix_16x16b[2 * i] = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(col_r0r15_32x8b));
+        ppix_16x16b[2 * i + 1] = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(col_r0r15_32x8b, 1));
+    }
+}
+
+/* Stores p3 to q3 across a vertical edge of 16 (or 8) rows */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_store_vert_avx2(UWORD8 *pu1_src,
+                                                                     WORD32 src_strd,
+                                                                     WORD32 rows,
+                                                                     __m256i *ppix_16x16b)
+{
+    __m256i col_32x8b[8], line_32x8b[4];
+    WORD32 i;
+
+    for(i = 0; i < 4; i++)
+    {
+        col_32x8b[2 * i] = _mm256_packus_epi16(ppix_16x16b[2 * i], ppix_16x16b[2 * i + 1]);
+        col_32x8b[2 * i + 1] = _mm256_srli_si256(col_32x8b[2 * i], 8);
+    }
+
+    ih264_deblk_transpose_8x8x2_avx2(col_32x8b, line_32x8b);
+
+    pu1_src -= 4;
+    for(i = 0; i < 4; i++)
+    {
+        __m128i line_16x8b = _mm256_castsi256_si128(line_32x8b[i]);
+
+        _mm_storel_epi64((__m128i *)(pu1_src + (2 * i) * src_strd), line_16x8b);
+        _mm_storel_epi64((__m128i *)(pu1_src + (2 * i + 1) * src_strd), _mm_srli_si128(line_16x8b, 8));
+
+        if(rows == 16)
+        {
+            line_16x8b = _mm256_extracti128_si256(line_32x8b[i], 1);
+            _mm_storel_epi64((__m128i *)(pu1_src + (2 * i + 8) * src_strd), line_16x8b);
+            _mm_storel_epi64((__m128i *)(pu1_src + (2 * i + 9) * src_strd), _mm_srli_si128(line_16x8b, 8));
+        }
+    }
+}
+
+/* Packs two rows of 16 samples and stores them */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_store_horz_avx2(UWORD8 *pu1_dst0,
+                                                                     UWORD8 *pu1_dst1,
+                                                                     __m256i row0_16x16b,
+                                                                     __m256i row1_16x16b)
+{
+    __m256i res_32x8b = _mm256_packus_epi16(row0_16x16b, row1_16x16b);
+
+    res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+    _mm_storeu_si128((__m128i *)pu1_dst0, _mm256_castsi256_si128(res_32x8b));
+    _mm_storeu_si128((__m128i *)pu1_dst1, _mm256_extracti128_si256(res_32x8b, 1));
+}
+
+/*****************************************************************************/
+/* Unpacks the four boundary strengths in u4_bs into tc0 and a non zero bs  */
+/* mask per sample. Byte i of seg_idx_16x8b holds the byte of u4_bs (the    */
+/* first edge segment being its most significant byte) used by sample i.    */
+/*****************************************************************************/
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_get_tc0_avx2(UWORD32 u4_bs,
+                                                                  const UWORD8 *pu1_cliptab,
+                                                                  __m128i seg_idx_16x8b,
+                                                                  __m256i *ptc0_16x16b,
+                                                                  __m256i *pbs_mask_16x16b)
+{
+    UWORD32 u4_tc0;
+    __m256i bs_16x16b;
+
+    u4_tc0 = ((UWORD32)pu1_cliptab[(u4_bs >> 24) & 0x0ff] << 24)
+                    | ((UWORD32)pu1_cliptab[(u4_bs >> 16) & 0x0ff] << 16)
+                    | ((UWORD32)pu1_cliptab[(u4_bs >> 8) & 0x0ff] << 8)
+                    | (UWORD32)pu1_cliptab[u4_bs & 0x0ff];
+
+    *ptc0_16x16b = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(_mm_cvtsi32_si128(u4_tc0), seg_idx_16x8b));
+    bs_16x16b = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(_mm_cvtsi32_si128(u4_bs), seg_idx_16x8b));
+    *pbs_mask_16x16b = _mm256_cmpgt_epi16(bs_16x16b, _mm256_setzero_si256());
+}
+
+/* Filter decision common to all luma edges */
+static FORCEINLINE AVX2_TARGET __m256i ih264_deblk_luma_filter_flag_avx2(__m256i *ppix_16x16b,
+                                                                         __m256i alpha_16x16b,
+                                                                         __m256i beta_16x16b)
+{
+    __m256i flag_16x16b;
+
+    flag_16x16b = _mm256_cmpgt_epi16(alpha_16x16b,
+                                     _mm256_abs_epi16(_mm256_sub_epi16(ppix_16x16b[3], ppix_16x16b[4])));
+    flag_16x16b = _mm256_and_si256(flag_16x16b,
+                                   _mm256_cmpgt_epi16(beta_16x16b,
+                                                      _mm256_abs_epi16(_mm256_sub_epi16(ppix_16x16b[5],
+                                                                                        ppix_16x16b[4]))));
+    return _mm256_and_si256(flag_16x16b,
+                            _mm256_cmpgt_epi16(beta_16x16b,
+                                               _mm256_abs_epi16(_mm256_sub_epi16(ppix_16x16b[2],
+                                                                                 ppix_16x16b[3]))));
+}
+
+/* Luma filtering for bS equal to 4, sec. 8.7.2.4 */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_bs4_avx2(__m256i *ppix_16x16b,
+                                                              WORD32 alpha,
+                                                              WORD32 beta)
+{
+    __m256i p3, p2, p1, p0, q0, q1, q2, q3;
+    __m256i flag, flag_p, flag_q, strong, beta_16x16b;
+    __m256i sum_p, sum_q, p0_w, q0_w, p0_s, p1_s, p2_s, q0_s, q1_s, q2_s;
+    __m256i const_val2 = _mm256_set1_epi16(2);
+    __m256i const_val4 = _mm256_set1_epi16(4);
+
+    p3 = ppix_16x16b[0];
+    p2 = ppix_16x16b[1];
+    p1 = ppix_16x16b[2];
+    p0 = ppix_16x16b[3];
+    q0 = ppix_16x16b[4];
+    q1 = ppix_16x16b[5];
+    q2 = ppix_16x16b[6];
+    q3 = ppix_16x16b[7];
+
+    beta_16x16b = _mm256_set1_epi16(beta);
+    flag = ih264_deblk_luma_filter_flag_avx2(ppix_16x16b, _mm256_set1_epi16(alpha), beta_16x16b);
+    strong = _mm256_cmpgt_epi16(_mm256_set1_epi16((alpha >> 2) + 2),
+                                _mm256_abs_epi16(_mm256_sub_epi16(p0, q0)));
+    strong = _mm256_and_si256(strong, flag);
+    flag_p = _mm256_and_si256(strong,
+                              _mm256_cmpgt_epi16(beta_16x16b, _mm256_abs_epi16(_mm256_sub_epi16(p2, p0))));
+    flag_q = _mm256_and_si256(strong,
+                              _mm256_cmpgt_epi16(beta_16x16b, _mm256_abs_epi16(_mm256_sub_epi16(q2, q0))));
+
+    /* p0', q0' of the normal filter */
+    p0_w = _mm256_add_epi16(_mm256_add_epi16(p1, p1), _mm256_add_epi16(p0, q1));
+    p0_w = _mm256_srli_epi16(_mm256_add_epi16(p0_w, const_val2), 2);
+    q0_w = _mm256_add_epi16(_mm256_add_epi16(q1, q1), _mm256_add_epi16(q0, p1));
+    q0_w = _mm256_srli_epi16(_mm256_add_epi16(q0_w, const_val2), 2);
+
+    /* p0', p1', p2' of the strong filter */
+    sum_p = _mm256_add_epi16(_mm256_add_epi16(p1, p0), q0);
+    p0_s = _mm256_add_epi16(_mm256_add_epi16(sum_p, sum_p), _mm256_add_epi16(p2, q1));
+    p0_s = _mm256_srli_epi16(_mm256_add_epi16(p0_s, const_val4), 3);
+    p1_s = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(sum_p, p2), const_val2), 2);
+    p2_s = _mm256_add_epi16(_mm256_add_epi16(p3, p3), _mm256_add_epi16(p2, _mm256_add_epi16(p2, p2)));
+    p2_s = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(p2_s, sum_p), const_val4), 3);
+
+    /* q0', q1', q2' of the strong filter */
+    sum_q = _mm256_add_epi16(_mm256_add_epi16(q1, q0), p0);
+    q0_s = _mm256_add_epi16(_mm256_add_epi16(sum_q, sum_q), _mm256_add_epi16(q2, p1));
+    q0_s = _mm256_srli_epi16(_mm256_add_epi16(q0_s, const_val4), 3);
+    q1_s = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(sum_q, q2), const_val2), 2);
+    q2_s = _mm256_add_epi16(_mm256_add_epi16(q3, q3), _mm256_add_epi16(q2, _mm256_add_epi16(q2, q2)));
+    q2_s = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(q2_s, sum_q), const_val4), 3);
+
+    p0 = _mm256_blendv_epi8(p0, p0_w, flag);
+    ppix_16x16b[3] = _mm256_blendv_epi8(p0, p0_s, flag_p);
+    ppix_16x16b[2] = _mm256_blendv_epi8(p1, p1_s, flag_p);
+    ppix_16x16b[1] = _mm256_blendv_epi8(p2, p2_s, flag_p);
+
+    q0 = _mm256_blendv_epi8(q0, q0_w, flag);
+    ppix_16x16b[4] = _mm256_blendv_epi8(q0, q0_s, flag_q);
+    ppix_16x16b[5] = _mm256_blendv_epi8(q1, q1_s, flag_q);
+    ppix_16x16b[6] = _mm256_blendv_epi8(q2, q2_s, flag_q);
+}
+
+/* Luma filtering for bS less than 4, sec. 8.7.2.3 */
+static FORCEINLINE AVX2_TARGET void ih264_deblk_luma_bslt4_avx2(__m256i *ppix_16x16b,
+                                                                WORD32 alpha,
+                                                                WORD32 beta,
+                                                                __m256i tc0,
+                                                                __m256i bs_mask)
+{
+    __m256i p2, p1, p0, q0, q1, q2;
+    __m256i flag, flag_p, flag_q, beta_16x16b;
+    __m256i tc, neg_tc0, delta, avg_pq, p1_d, q1_d;
+
+    p2 = ppix_16x16b[1];
+    p1 = ppix_16x16b[2];
+    p0 = ppix_16x16b[3];
+    q0 = ppix_16x16b[4];
+    q1 = ppix_16x16b[5];
+    q2 = ppix_16x16b[6];
+
+    beta_16x16b = _mm256_set1_epi16(beta);
+    flag = ih264_deblk_luma_filter_flag_avx2(ppix_16x16b, _mm256_set1_epi16(alpha), beta_16x16b);
+    flag = _mm256_and_si256(flag, bs_mask);
+    flag_p = _mm256_cmpgt_epi16(beta_16x16b, _mm256_abs_epi16(_mm256_sub_epi16(p2, p0)));
+    flag_q = _mm256_cmpgt_epi16(beta_16x16b, _mm256_abs_epi16(_mm256_sub_epi16(q2, q0)));
+
+    /* tc = tc0 + (ap < beta) + (aq < beta), the masks being -1 when set */
+    tc = _mm256_sub_epi16(_mm256_sub_epi16(tc0, flag_p), flag_q);
+    flag_p = _mm256_and_si256(flag_p, flag);
+    flag_q = _mm256_and_si256(flag_q, flag);
+
+    delta = _mm256_add_epi16(_mm256_slli_epi16(_mm256_sub_epi16(q0, p0), 2),
+                             _mm256_sub_epi16(p1, q1));
+    delta = _mm256_srai_epi16(_mm256_add_epi16(delta, _mm256_set1_epi16(4)), 3);
+    delta = _mm256_min_epi16(_mm256_max_epi16(delta, _mm256_sign_epi16(tc, _mm256_set1_epi16(-1))), tc);
+
+    /* p1' and q1' */
+    neg_tc0 = _mm256_sign_epi16(tc0, _mm256_set1_epi16(-1));
+    avg_pq = _mm256_avg_epu16(p0, q0);
+    p1_d = _mm256_srai_epi16(_mm256_sub_epi16(_mm256_add_epi16(p2, avg_pq), _mm256_add_epi16(p1, p1)), 1);
+    p1_d = _mm256_min_epi16(_mm256_max_epi16(p1_d, neg_tc0), tc0);
+    q1_d = _mm256_srai_epi16(_mm256_sub_epi16(_mm256_add_epi16(q2, avg_pq), _mm256_add_epi16(q1, q1)), 1);
+    q1_d = _mm256_min_epi16(_mm256_max_epi16(q1_d, neg_tc0), tc0);
+
+    /* p0' and q0' are clipped to 8 bits when packed */
+    ppix_16x16b[3] = _mm256_blendv_epi8(p0, _mm256_add_epi16(p0, delta), flag);
+    ppix_16x16b[4] = _mm256_blendv_epi8(q0, _mm256_sub_epi16(q0, delta), flag);
+    ppix_16x16b[2] = _mm256_blendv_epi8(p1, _mm256_add_epi16(p1, p1_d), flag_p);
+    ppix_16x16b[5] = _mm256_blendv_epi8(q1, _mm256_add_epi16(q1, q1_d), flag_q);
+}
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_vert_bs4_avx2()                         */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  vertical edge when the boundary strength is set to 4.    */
+/*                                                                           */
+/*  Inputs        : pu1_src    - pointer to the src sample q0                */
+/*                  src_strd   - source stride                               */
+/*                  alpha      - alpha value for the boundary                */
+/*                  beta       - beta value for the boundary                 */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4" in */
+/*                  ITU T Rec H.264.                                         */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_deblk_luma_vert_bs4_avx2(UWORD8 *pu1_src,
+                                                WORD32 src_strd,
+                                                WORD32 alpha,
+                                                WORD32 beta)
+{
+    __m256i pix_16x16b[8];
+
+    ih264_deblk_luma_load_vert_avx2(pu1_src, src_strd, 16, pix_16x16b);
+    ih264_deblk_luma_bs4_avx2(pix_16x16b, alpha, beta);
+    ih264_deblk_luma_store_vert_avx2(pu1_src, src_strd, 16, pix_16x16b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_horz_bs4_avx2()                         */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  horizontal edge when the boundary strength is set to 4.  */
+/*                                                                           */
+/*  Inputs        : pu1_src    - pointer to the src sample q0                */
+/*                  src_strd   - source stride                               */
+/*                  alpha      - alpha value for the boundary                */
+/*                  beta       - beta value for the boundary                 */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.4 under the    */
+/*                  title "Filtering process for edges for bS equal to 4" in */
+/*                  ITU T Rec H.264.                                         */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_deblk_luma_horz_bs4_avx2(UWORD8 *pu1_src,
+                                                WORD32 src_strd,
+                                                WORD32 alpha,
+                                                WORD32 beta)
+{
+    __m256i pix_16x16b[8];
+    UWORD8 *pu1_p3 = pu1_src - (src_strd << 2);
+    WORD32 i;
+
+    for(i = 0; i < 8; i++)
+        pix_16x16b[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_p3 + i * src_strd)));
+
+    ih264_deblk_luma_bs4_avx2(pix_16x16b, alpha, beta);
+
+    ih264_deblk_luma_store_horz_avx2(pu1_p3 + src_strd, pu1_p3 + 2 * src_strd,
+                                     pix_16x16b[1], pix_16x16b[2]);
+    ih264_deblk_luma_store_horz_avx2(pu1_p3 + 3 * src_strd, pu1_src,
+                                     pix_16x16b[3], pix_16x16b[4]);
+    ih264_deblk_luma_store_horz_avx2(pu1_src + src_strd, pu1_src + 2 * src_strd,
+                                     pix_16x16b[5], pix_16x16b[6]);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_vert_bslt4_avx2()                       */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  vertical edge when the boundary strength is less than 4. */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the src sample q0             */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the boundary             */
+/*                  beta          - beta value for the boundary              */
+/*                  u4_bs         - packed Boundary strength array           */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_deblk_luma_vert_bslt4_avx2(UWORD8 *pu1_src,
+                                                  WORD32 src_strd,
+                                                  WORD32 alpha,
+                                                  WORD32 beta,
+                                                  UWORD32 u4_bs,
+                                                  const UWORD8 *pu1_cliptab)
+{
+    __m256i pix_16x16b[8], tc0_16x16b, bs_mask_16x16b;
+
+    ih264_deblk_luma_get_tc0_avx2(u4_bs, pu1_cliptab,
+                                  _mm_setr_epi8(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0),
+                                  &tc0_16x16b, &bs_mask_16x16b);
+    ih264_deblk_luma_load_vert_avx2(pu1_src, src_strd, 16, pix_16x16b);
+    ih264_deblk_luma_bslt4_avx2(pix_16x16b, alpha, beta, tc0_16x16b, bs_mask_16x16b);
+    ih264_deblk_luma_store_vert_avx2(pu1_src, src_strd, 16, pix_16x16b);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_deblk_luma_horz_bslt4_avx2()                       */
+/*                                                                           */
+/*  Description   : This function performs filtering of a luma block         */
+/*                  horizontal edge when boundary strength is less than 4.   */
+/*                                                                           */
+/*  Inputs        : pu1_src       - pointer to the src sample q0             */
+/*                  src_strd      - source stride                            */
+/*                  alpha         - alpha value for the boundary             */
+/*                  beta          - beta value for the boundary              */
+/*                  u4_bs         - packed Boundary strength array           */
+/*                  pu1_cliptab   - tc0_table                                */
+/*                                                                           */
+/*  Globals       : None                                                     */
+/*                                                                           */
+/*  Processing    : This operation is described in Sec. 8.7.2.3 under the    */
+/*                  title "Filtering process for edges for bS less than 4"   */
+/*                  in ITU T Rec H.264.                                      */
+/*                                                                           */
+/*  Outputs       : None                                                     */
+/*                                                                           */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_deblk_luma_horz_bslt4_avx2(UWORD8 *pu1_src,
+                                                  WORD32 src_strd,
+                                                  WORD32 alpha,
+                                                  WORD32 beta,
+                                                  UWORD32 u4_bs,
+                                                  const UWORD8 *pu1_cliptab)
+{
+    __m256i pix_16x16b[8], tc0_16x16b, bs_mask_16x16b;
+    UWORD8 *pu1_p3 = pu1_src - (src_strd << 2);
+    WORD32 i;
+
+    ih264_deblk_luma_get_tc0_avx2(u4_bs, pu1_cliptab,
+                                  _mm_setr_epi8(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0),
+                                  &tc0_16x16b, &bs_mask_16x16b);
+
+    /* p3 and q3 are not used for bS less than 4 */
+    pix_16x16b[0] = pix_16x16b[7] = _mm256_setzero_si256();
+    for(i = 1; i < 7; i++)
+        pix_16x16b[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_p3 + i * src_strd)));
+
+    ih264_deblk_luma_bslt4_avx2(pix_16x16b, alpha, beta, tc0_16x16b, bs_mask_16x16b);
+
+    ih264_deblk_luma_store_horz_avx2(pu1_p3 + 2 * src_strd, pu1_p3 + 3 * src_strd,
+                                     pix_16x16b[2], pix_16x16b[3]);
+    ih264_deblk_luma_store_horz_avx2(pu1_src, pu1_src + src_strd,
+                                     pix_16x16b[4], pix_16x16b[5]);
+}
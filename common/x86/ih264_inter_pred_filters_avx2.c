@@ -0,0 +1,914 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264_inter_pred_filters_avx2.c                      */
+/*                                                                           */
+/*  Description       : Contains function definitions for luma and chroma    */
+/*                      inter prediction filters in x86 avx2 intrinsics      */
+/*                                                                           */
+/*  List of Functions : ih264_inter_pred_luma_horz_avx2()                    */
+/*                      ih264_inter_pred_luma_vert_avx2()                    */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_qpel_avx2()               */
+/*                      ih264_inter_pred_luma_vert_qpel_avx2()               */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2()     */
+/*                      ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2()     */
+/*                      ih264_inter_pred_chroma_avx2()                       */
+/*                                                                           */
+/*  Issues / Problems : Luma blocks of width 4 and chroma blocks of width    */
+/*                      less than 8 are too narrow to fill a 256 bit         */
+/*                      register and are handed over to the ssse3 versions   */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+#include <immintrin.h>
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_inter_pred_filters.h"
+
+/*****************************************************************************/
+/*  Static function definitions                                              */
+/*****************************************************************************/
+/* The kernels below produce two rows of the block per iteration. A 256 bit */
+/* register holds one row per 128 bit lane, i.e. 16 pixels of each row for   */
+/* a width of 16 and the lower 8 bytes of each lane for a width of 8.        */
+/*****************************************************************************/
+
+/* Loads rows 0 and 1 of 16 (wd 16) or 8 (wd 8) pixels, one per lane */
+static FORCEINLINE AVX2_TARGET __m256i ih264_load_row_pair_32x8b_avx2(UWORD8 *pu1_src,
+                                                                 WORD32 src_strd,
+                                                                 WORD32 wd)
+{
+    __m128i src_r0_16x8b, src_r1_16x8b;
+
+    if(wd == 16)
+    {
+        src_r0_16x8b = _mm_loadu_si128((__m128i *)pu1_src);
+        src_r1_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + src_strd));
+    }
+    else
+    {
+        src_r0_16x8b = _mm_loadl_epi64((__m128i *)pu1_src);
+        src_r1_16x8b = _mm_loadl_epi64((__m128i *)(pu1_src + src_strd));
+    }
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(src_r0_16x8b), src_r1_16x8b, 1);
+}
+
+/* Stores rows 0 and 1 of 16 (wd 16) or 8 (wd 8) pixels from the two lanes */
+static FORCEINLINE AVX2_TARGET void ih264_store_row_pair_avx2(UWORD8 *pu1_dst,
+                                                         WORD32 dst_strd,
+                                                         WORD32 wd,
+                                                         __m256i res_32x8b)
+{
+    if(wd == 16)
+    {
+        _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+        _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd), _mm256_extracti128_si256(res_32x8b, 1));
+    }
+    else
+    {
+        _mm_storel_epi64((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+        _mm_storel_epi64((__m128i *)(pu1_dst + dst_strd), _mm256_extracti128_si256(res_32x8b, 1));
+    }
+}
+
+/* Rounds the output of a single six tap stage */
+static FORCEINLINE AVX2_TARGET __m256i ih264_round_16x16b_avx2(__m256i res_16x16b)
+{
+    res_16x16b = _mm256_add_epi16(res_16x16b, _mm256_set1_epi16(16));
+    return _mm256_srai_epi16(res_16x16b, 5);
+}
+
+/* Packs pixels 0-7 (lo) and 8-15 (hi) of rows 0 and 1 into a row pair */
+static FORCEINLINE AVX2_TARGET __m256i ih264_pack_row_pair_32x8b_avx2(__m256i res_lo_16x16b,
+                                                                 __m256i res_hi_16x16b,
+                                                                 WORD32 wd)
+{
+    if(wd == 16)
+        return _mm256_packus_epi16(res_lo_16x16b, res_hi_16x16b);
+
+    return _mm256_packus_epi16(res_lo_16x16b, res_lo_16x16b);
+}
+
+/*****************************************************************************/
+/* Horizontal six tap filter on two rows, rounded and clipped to 8 bits. For */
+/* a width of 16 the lanes hold pixels 0-7 and 8-15 of a row while           */
+/* filtering, for a width of 8 they hold rows 0 and 1.                       */
+/*****************************************************************************/
+static FORCEINLINE AVX2_TARGET __m256i ih264_horz_row_pair_32x8b_avx2(UWORD8 *pu1_src,
+                                                                 WORD32 src_strd,
+                                                                 WORD32 wd)
+{
+    __m256i src_32x8b, res_r0_16x16b, res_r1_16x16b;
+    __m256i mask0_1_32x8b, mask2_3_32x8b, mask4_5_32x8b;
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    WORD32 i;
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+                                                    //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+    mask0_1_32x8b = _mm256_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+                                     0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8);
+    mask2_3_32x8b = _mm256_add_epi8(mask0_1_32x8b, _mm256_set1_epi8(2));
+    mask4_5_32x8b = _mm256_add_epi8(mask0_1_32x8b, _mm256_set1_epi8(4));
+
+    pu1_src -= 2; // the filter input starts from x[-2] (till x[3])
+
+    res_r1_16x16b = _mm256_setzero_si256();
+    for(i = 0; i < ((wd == 16) ? 2 : 1); i++)
+    {
+        __m256i res_16x16b;
+
+        if(wd == 16)
+        {
+            src_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 8)), 1);
+        }
+        else
+        {
+            src_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + src_strd)), 1);
+        }
+
+        res_16x16b = _mm256_maddubs_epi16(_mm256_shuffle_epi8(src_32x8b, mask0_1_32x8b),
+                                          coeff0_1_32x8b);
+        res_16x16b = _mm256_add_epi16(res_16x16b,
+                                      _mm256_maddubs_epi16(_mm256_shuffle_epi8(src_32x8b, mask2_3_32x8b),
+                                                           coeff2_3_32x8b));
+        res_16x16b = _mm256_add_epi16(res_16x16b,
+                                      _mm256_maddubs_epi16(_mm256_shuffle_epi8(src_32x8b, mask4_5_32x8b),
+                                                           coeff4_5_32x8b));
+        res_16x16b = ih264_round_16x16b_avx2(res_16x16b);
+
+        if(i == 0)
+            res_r0_16x16b = res_16x16b;
+        else
+            res_r1_16x16b = res_16x16b;
+
+        pu1_src += src_strd;
+    }
+
+    if(wd == 16)
+    {
+        /* r0 0-7, r1 0-7 | r0 8-15, r1 8-15 reordered to r0 | r1 */
+        src_32x8b = _mm256_packus_epi16(res_r0_16x16b, res_r1_16x16b);
+        return _mm256_permute4x64_epi64(src_32x8b, 0xD8);
+    }
+
+    return _mm256_packus_epi16(res_r0_16x16b, res_r0_16x16b);
+}
+
+/*****************************************************************************/
+/* Vertical six tap filter on two rows, unrounded. The lanes hold rows 0 and */
+/* 1, with pixels 0-7 returned in pres_lo_16x16b and pixels 8-15 (wd 16      */
+/* only) in pres_hi_16x16b.                                                  */
+/*****************************************************************************/
+static FORCEINLINE AVX2_TARGET void ih264_vert_six_tap_avx2(UWORD8 *pu1_src,
+                                                       WORD32 src_strd,
+                                                       WORD32 wd,
+                                                       __m256i *pres_lo_16x16b,
+                                                       __m256i *pres_hi_16x16b)
+{
+    __m256i src_r0r1_32x8b, src_r1r2_32x8b, src_r2r3_32x8b;
+    __m256i src_r3r4_32x8b, src_r4r5_32x8b, src_r5r6_32x8b;
+    __m256i src_t1_32x8b, src_t2_32x8b, src_t3_32x8b;
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i res_16x16b;
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+
+    pu1_src -= src_strd << 1; // the filter input starts from y[-2] (till y[3])
+
+    src_r0r1_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src, src_strd, wd);
+    src_r1r2_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src + src_strd, src_strd, wd);
+    src_r2r3_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src + 2 * src_strd, src_strd, wd);
+    src_r3r4_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src + 3 * src_strd, src_strd, wd);
+    src_r4r5_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src + 4 * src_strd, src_strd, wd);
+    src_r5r6_32x8b = ih264_load_row_pair_32x8b_avx2(pu1_src + 5 * src_strd, src_strd, wd);
+
+    src_t1_32x8b = _mm256_unpacklo_epi8(src_r0r1_32x8b, src_r1r2_32x8b);
+    src_t2_32x8b = _mm256_unpacklo_epi8(src_r2r3_32x8b, src_r3r4_32x8b);
+    src_t3_32x8b = _mm256_unpacklo_epi8(src_r4r5_32x8b, src_r5r6_32x8b);
+
+    res_16x16b = _mm256_maddubs_epi16(src_t1_32x8b, coeff0_1_32x8b);
+    res_16x16b = _mm256_add_epi16(res_16x16b, _mm256_maddubs_epi16(src_t2_32x8b, coeff2_3_32x8b));
+    *pres_lo_16x16b = _mm256_add_epi16(res_16x16b, _mm256_maddubs_epi16(src_t3_32x8b, coeff4_5_32x8b));
+
+    if(wd == 16)
+    {
+        src_t1_32x8b = _mm256_unpackhi_epi8(src_r0r1_32x8b, src_r1r2_32x8b);
+        src_t2_32x8b = _mm256_unpackhi_epi8(src_r2r3_32x8b, src_r3r4_32x8b);
+        src_t3_32x8b = _mm256_unpackhi_epi8(src_r4r5_32x8b, src_r5r6_32x8b);
+
+        res_16x16b = _mm256_maddubs_epi16(src_t1_32x8b, coeff0_1_32x8b);
+        res_16x16b = _mm256_add_epi16(res_16x16b, _mm256_maddubs_epi16(src_t2_32x8b, coeff2_3_32x8b));
+        *pres_hi_16x16b = _mm256_add_epi16(res_16x16b, _mm256_maddubs_epi16(src_t3_32x8b, coeff4_5_32x8b));
+    }
+    else
+    {
+        *pres_hi_16x16b = *pres_lo_16x16b;
+    }
+}
+
+/* Vertical six tap filter on two rows, rounded and clipped to 8 bits */
+static FORCEINLINE AVX2_TARGET __m256i ih264_vert_row_pair_32x8b_avx2(UWORD8 *pu1_src,
+                                                                 WORD32 src_strd,
+                                                                 WORD32 wd)
+{
+    __m256i res_lo_16x16b, res_hi_16x16b;
+
+    ih264_vert_six_tap_avx2(pu1_src, src_strd, wd, &res_lo_16x16b, &res_hi_16x16b);
+    return ih264_pack_row_pair_32x8b_avx2(ih264_round_16x16b_avx2(res_lo_16x16b),
+                                          ih264_round_16x16b_avx2(res_hi_16x16b), wd);
+}
+
+/*****************************************************************************/
+/* Second stage of the (1/2,1/2) filter on 8 pixels per lane. vert_l_16x16b  */
+/* and vert_h_16x16b hold the first stage output of columns x - 2 to x + 5   */
+/* and x + 6 to x + 13, the six taps are formed by aligning them. The        */
+/* second stage needs 32 bit precision.                                      */
+/*****************************************************************************/
+static FORCEINLINE AVX2_TARGET __m256i ih264_hpel_2nd_stage_16x16b_avx2(__m256i vert_l_16x16b,
+                                                                   __m256i vert_h_16x16b)
+{
+    __m256i tap0_16x16b, tap1_16x16b, tap2_16x16b;
+    __m256i res_lo_8x32b, res_hi_8x32b;
+    __m256i coeff0_1_16x16b, coeff2_3_16x16b, const_val512_8x32b;
+
+    /* pairwise sums of the first stage output fit in 16 bits */
+    tap0_16x16b = _mm256_add_epi16(vert_l_16x16b, _mm256_alignr_epi8(vert_h_16x16b, vert_l_16x16b, 10));
+    tap1_16x16b = _mm256_add_epi16(_mm256_alignr_epi8(vert_h_16x16b, vert_l_16x16b, 2),
+                                   _mm256_alignr_epi8(vert_h_16x16b, vert_l_16x16b, 8));
+    tap2_16x16b = _mm256_add_epi16(_mm256_alignr_epi8(vert_h_16x16b, vert_l_16x16b, 4),
+                                   _mm256_alignr_epi8(vert_h_16x16b, vert_l_16x16b, 6));
+
+    coeff0_1_16x16b = _mm256_set1_epi32(0xFFFB0001); //c0 c1 c0 c1 ... c0 = 1, c1 = -5
+    coeff2_3_16x16b = _mm256_set1_epi32(0x000A000A); //20 * (c + d) as 10 * (c + d) twice
+    const_val512_8x32b = _mm256_set1_epi32(512);
+
+    res_lo_8x32b = _mm256_madd_epi16(_mm256_unpacklo_epi16(tap0_16x16b, tap1_16x16b), coeff0_1_16x16b);
+    res_hi_8x32b = _mm256_madd_epi16(_mm256_unpackhi_epi16(tap0_16x16b, tap1_16x16b), coeff0_1_16x16b);
+    res_lo_8x32b = _mm256_add_epi32(res_lo_8x32b,
+                                    _mm256_madd_epi16(_mm256_unpacklo_epi16(tap2_16x16b, tap2_16x16b),
+                                                      coeff2_3_16x16b));
+    res_hi_8x32b = _mm256_add_epi32(res_hi_8x32b,
+                                    _mm256_madd_epi16(_mm256_unpackhi_epi16(tap2_16x16b, tap2_16x16b),
+                                                      coeff2_3_16x16b));
+
+    res_lo_8x32b = _mm256_srai_epi32(_mm256_add_epi32(res_lo_8x32b, const_val512_8x32b), 10);
+    res_hi_8x32b = _mm256_srai_epi32(_mm256_add_epi32(res_hi_8x32b, const_val512_8x32b), 10);
+
+    return _mm256_packs_epi32(res_lo_8x32b, res_hi_8x32b);
+}
+
+/*****************************************************************************/
+/* Two stage six tap filter at the (1/2,1/2) position on two rows. The       */
+/* vertical stage is evaluated for columns -2 to 13 (and 14 to 21 for wd 16) */
+/* with one row per lane. If pres_vert_32x8b is not NULL, the rounded and    */
+/* clipped output of the vertical stage at column (x_offset >> 1) is         */
+/* returned in it.                                                           */
+/*****************************************************************************/
+static FORCEINLINE AVX2_TARGET __m256i ih264_hpel_hpel_row_pair_32x8b_avx2(UWORD8 *pu1_src,
+                                                                      WORD32 src_strd,
+                                                                      WORD32 wd,
+                                                                      WORD32 x_offset,
+                                                                      __m256i *pres_vert_32x8b)
+{
+    __m256i vert_c0_16x16b, vert_c8_16x16b, vert_c16_16x16b;
+    __m256i res_lo_16x16b, res_hi_16x16b;
+
+    /* columns -2 to 5 and 6 to 13 */
+    ih264_vert_six_tap_avx2(pu1_src - 2, src_strd, 16, &vert_c0_16x16b, &vert_c8_16x16b);
+    res_lo_16x16b = ih264_hpel_2nd_stage_16x16b_avx2(vert_c0_16x16b, vert_c8_16x16b);
+    res_hi_16x16b = res_lo_16x16b;
+
+    if(wd == 16)
+    {
+        /* columns 14 to 21 */
+        ih264_vert_six_tap_avx2(pu1_src + 14, src_strd, 8, &vert_c16_16x16b, &vert_c16_16x16b);
+        res_hi_16x16b = ih264_hpel_2nd_stage_16x16b_avx2(vert_c8_16x16b, vert_c16_16x16b);
+    }
+
+    if(NULL != pres_vert_32x8b)
+    {
+        __m256i vert_lo_16x16b, vert_hi_16x16b;
+
+        if(x_offset >> 1)
+        {
+            vert_lo_16x16b = _mm256_alignr_epi8(vert_c8_16x16b, vert_c0_16x16b, 6);
+            vert_hi_16x16b = (wd == 16) ?
+                            _mm256_alignr_epi8(vert_c16_16x16b, vert_c8_16x16b, 6) : vert_lo_16x16b;
+        }
+        else
+        {
+            vert_lo_16x16b = _mm256_alignr_epi8(vert_c8_16x16b, vert_c0_16x16b, 4);
+            vert_hi_16x16b = (wd == 16) ?
+                            _mm256_alignr_epi8(vert_c16_16x16b, vert_c8_16x16b, 4) : vert_lo_16x16b;
+        }
+
+        *pres_vert_32x8b = ih264_pack_row_pair_32x8b_avx2(ih264_round_16x16b_avx2(vert_lo_16x16b),
+                                                          ih264_round_16x16b_avx2(vert_hi_16x16b),
+                                                          wd);
+    }
+
+    return ih264_pack_row_pair_32x8b_avx2(res_lo_16x16b, res_hi_16x16b, wd);
+}
+
+/*****************************************************************************/
+/*  Function definitions .                                                   */
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_avx2                          */
+/*                                                                           */
+/*  Description   : This function applies a horizontal 6-tap filter on       */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process". (ht,wd) can be      */
+/*                  (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).   */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_avx2(UWORD8 *pu1_src,
+                                                 UWORD8 *pu1_dst,
+                                                 WORD32 src_strd,
+                                                 WORD32 dst_strd,
+                                                 WORD32 ht,
+                                                 WORD32 wd,
+                                                 UWORD8* pu1_tmp,
+                                                 WORD32 dydx)
+{
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                         ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    do
+    {
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  ih264_horz_row_pair_32x8b_avx2(pu1_src, src_strd, wd));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_avx2                          */
+/*                                                                           */
+/*  Description   : This function applies a vertical 6-tap filter on         */
+/*                  ht x wd block as mentioned in sec. 8.4.2.2.1 titled      */
+/*                  "Luma sample interpolation process". (ht,wd) can be      */
+/*                  (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).   */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_vert_avx2(UWORD8 *pu1_src,
+                                                 UWORD8 *pu1_dst,
+                                                 WORD32 src_strd,
+                                                 WORD32 dst_strd,
+                                                 WORD32 ht,
+                                                 WORD32 wd,
+                                                 UWORD8* pu1_tmp,
+                                                 WORD32 dydx)
+{
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_vert_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                         ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    do
+    {
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  ih264_vert_row_pair_32x8b_avx2(pu1_src, src_strd, wd));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2           */
+/*                                                                           */
+/*  Description   : This function implements a two stage cascaded six tap    */
+/*                  filter, vertically and then horizontally on ht x wd      */
+/*                  block as mentioned in sec. 8.4.2.2.1 titled "Luma sample */
+/*                  interpolation process". (ht,wd) can be (4,4), (8,4),     */
+/*                  (4,8), (8,8), (16,8), (8,16) or (16,16).                 */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                                                                           */
+/*  Issues        : The intermediate output is kept in registers and         */
+/*                  pu1_tmp is used only for width 4                         */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_hpel_vert_hpel_avx2(UWORD8 *pu1_src,
+                                                                UWORD8 *pu1_dst,
+                                                                WORD32 src_strd,
+                                                                WORD32 dst_strd,
+                                                                WORD32 ht,
+                                                                WORD32 wd,
+                                                                UWORD8* pu1_tmp,
+                                                                WORD32 dydx)
+{
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                                        dst_strd, ht, wd, pu1_tmp,
+                                                        dydx);
+        return;
+    }
+
+    do
+    {
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  ih264_hpel_hpel_row_pair_32x8b_avx2(pu1_src, src_strd,
+                                                                      wd, 0, NULL));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_avx2                     */
+/*                                                                           */
+/*  Description   : This function implements a six-tap filter horizontally   */
+/*                  on ht x wd block and averages the values with the source */
+/*                  pixels to calculate horizontal quarter-pel as mentioned  */
+/*                  in sec. 8.4.2.2.1 titled "Luma sample interpolation      */
+/*                  process". (ht,wd) can be (4,4), (8,4), (4,8), (8,8),     */
+/*                  (16,8), (8,16) or (16,16).                               */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                  dydx     - x and y reference offset for q-pel            */
+/*                             calculations                                  */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_qpel_avx2(UWORD8 *pu1_src,
+                                                      UWORD8 *pu1_dst,
+                                                      WORD32 src_strd,
+                                                      WORD32 dst_strd,
+                                                      WORD32 ht,
+                                                      WORD32 wd,
+                                                      UWORD8* pu1_tmp,
+                                                      WORD32 dydx)
+{
+    WORD32 x_offset = dydx & 3;
+    UWORD8 *pu1_pred1;
+
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_qpel_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                              ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_pred1 = pu1_src + (x_offset >> 1);
+
+    do
+    {
+        __m256i res_32x8b;
+
+        res_32x8b = ih264_horz_row_pair_32x8b_avx2(pu1_src, src_strd, wd);
+        res_32x8b = _mm256_avg_epu8(res_32x8b,
+                                    ih264_load_row_pair_32x8b_avx2(pu1_pred1, src_strd, wd));
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd, res_32x8b);
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_pred1 += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_vert_qpel_avx2                     */
+/*                                                                           */
+/*  Description   : This function implements a six-tap filter vertically on  */
+/*                  ht x wd block and averages the values with the source    */
+/*                  pixels to calculate vertical quarter-pel as mentioned in */
+/*                  sec. 8.4.2.2.1 titled "Luma sample interpolation         */
+/*                  process". (ht,wd) can be (4,4), (8,4), (4,8), (8,8),     */
+/*                  (16,8), (8,16) or (16,16).                               */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                  dydx     - x and y reference offset for q-pel            */
+/*                             calculations                                  */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_vert_qpel_avx2(UWORD8 *pu1_src,
+                                                      UWORD8 *pu1_dst,
+                                                      WORD32 src_strd,
+                                                      WORD32 dst_strd,
+                                                      WORD32 ht,
+                                                      WORD32 wd,
+                                                      UWORD8* pu1_tmp,
+                                                      WORD32 dydx)
+{
+    WORD32 y_offset = (dydx >> 2) & 3;
+    UWORD8 *pu1_pred1;
+
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_vert_qpel_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                              ht, wd, pu1_tmp, dydx);
+        return;
+    }
+
+    pu1_pred1 = pu1_src + (y_offset >> 1) * src_strd;
+
+    do
+    {
+        __m256i res_32x8b;
+
+        res_32x8b = ih264_vert_row_pair_32x8b_avx2(pu1_src, src_strd, wd);
+        res_32x8b = _mm256_avg_epu8(res_32x8b,
+                                    ih264_load_row_pair_32x8b_avx2(pu1_pred1, src_strd, wd));
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd, res_32x8b);
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_pred1 += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2           */
+/*                                                                           */
+/*  Description   : This function implements two six tap filters, one       */
+/*                  horizontally and one vertically on ht x wd block and     */
+/*                  averages the two outputs to calculate the diagonal       */
+/*                  quarter-pel positions as mentioned in sec. 8.4.2.2.1     */
+/*                  titled "Luma sample interpolation process". (ht,wd) can  */
+/*                  be (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).*/
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                  dydx     - x and y reference offset for q-pel            */
+/*                             calculations                                  */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_qpel_vert_qpel_avx2(UWORD8 *pu1_src,
+                                                                UWORD8 *pu1_dst,
+                                                                WORD32 src_strd,
+                                                                WORD32 dst_strd,
+                                                                WORD32 ht,
+                                                                WORD32 wd,
+                                                                UWORD8* pu1_tmp,
+                                                                WORD32 dydx)
+{
+    WORD32 x_offset = dydx & 3;
+    WORD32 y_offset = (dydx >> 2) & 3;
+    UWORD8 *pu1_pred_vert, *pu1_pred_horz;
+
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                                        dst_strd, ht, wd, pu1_tmp,
+                                                        dydx);
+        return;
+    }
+
+    pu1_pred_horz = pu1_src + (y_offset >> 1) * src_strd;
+    pu1_pred_vert = pu1_src + (x_offset >> 1);
+
+    do
+    {
+        __m256i res_vert_32x8b, res_horz_32x8b;
+
+        res_vert_32x8b = ih264_vert_row_pair_32x8b_avx2(pu1_pred_vert, src_strd, wd);
+        res_horz_32x8b = ih264_horz_row_pair_32x8b_avx2(pu1_pred_horz, src_strd, wd);
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  _mm256_avg_epu8(res_vert_32x8b, res_horz_32x8b));
+
+        ht -= 2;
+        pu1_pred_vert += src_strd << 1;
+        pu1_pred_horz += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2           */
+/*                                                                           */
+/*  Description   : This function implements a two stage cascaded six tap    */
+/*                  filter and averages the output with the nearest vertical */
+/*                  half-pel to calculate the (1/4,1/2) and (3/4,1/2)        */
+/*                  positions as mentioned in sec. 8.4.2.2.1 titled "Luma    */
+/*                  sample interpolation process". (ht,wd) can be (4,4),     */
+/*                  (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).          */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                  dydx     - x and y reference offset for q-pel            */
+/*                             calculations                                  */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_qpel_vert_hpel_avx2(UWORD8 *pu1_src,
+                                                                UWORD8 *pu1_dst,
+                                                                WORD32 src_strd,
+                                                                WORD32 dst_strd,
+                                                                WORD32 ht,
+                                                                WORD32 wd,
+                                                                UWORD8* pu1_tmp,
+                                                                WORD32 dydx)
+{
+    WORD32 x_offset = dydx & 3;
+
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                                        dst_strd, ht, wd, pu1_tmp,
+                                                        dydx);
+        return;
+    }
+
+    do
+    {
+        __m256i res_32x8b, res_vert_32x8b;
+
+        res_32x8b = ih264_hpel_hpel_row_pair_32x8b_avx2(pu1_src, src_strd, wd, x_offset,
+                                                        &res_vert_32x8b);
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  _mm256_avg_epu8(res_32x8b, res_vert_32x8b));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2           */
+/*                                                                           */
+/*  Description   : This function implements a two stage cascaded six tap    */
+/*                  filter and averages the output with the nearest          */
+/*                  horizontal half-pel to calculate the (1/2,1/4) and       */
+/*                  (1/2,3/4) positions as mentioned in sec. 8.4.2.2.1       */
+/*                  titled "Luma sample interpolation process". (ht,wd) can  */
+/*                  be (4,4), (8,4), (4,8), (8,8), (16,8), (8,16) or (16,16).*/
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                  pu1_tmp  - pointer to temporary buffer                   */
+/*                  dydx     - x and y reference offset for q-pel            */
+/*                             calculations                                  */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_luma_horz_hpel_vert_qpel_avx2(UWORD8 *pu1_src,
+                                                                UWORD8 *pu1_dst,
+                                                                WORD32 src_strd,
+                                                                WORD32 dst_strd,
+                                                                WORD32 ht,
+                                                                WORD32 wd,
+                                                                UWORD8* pu1_tmp,
+                                                                WORD32 dydx)
+{
+    WORD32 y_offset = (dydx >> 2) & 3;
+    UWORD8 *pu1_pred1;
+
+    if(wd == 4)
+    {
+        ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3(pu1_src, pu1_dst, src_strd,
+                                                        dst_strd, ht, wd, pu1_tmp,
+                                                        dydx);
+        return;
+    }
+
+    pu1_pred1 = pu1_src + (y_offset >> 1) * src_strd;
+
+    do
+    {
+        __m256i res_32x8b, res_horz_32x8b;
+
+        /* both stages are evaluated in full precision, so the order of the */
+        /* cascade does not change the (1/2,1/2) output                     */
+        res_32x8b = ih264_hpel_hpel_row_pair_32x8b_avx2(pu1_src, src_strd, wd, 0, NULL);
+        res_horz_32x8b = ih264_horz_row_pair_32x8b_avx2(pu1_pred1, src_strd, wd);
+        ih264_store_row_pair_avx2(pu1_dst, dst_strd, wd,
+                                  _mm256_avg_epu8(res_32x8b, res_horz_32x8b));
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_pred1 += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264_inter_pred_chroma_avx2                             */
+/*                                                                           */
+/*  Description   : This function implements a four-tap 2D filter as         */
+/*                  mentioned in sec. 8.4.2.2.2 titled "Chroma sample        */
+/*                  "interpolation process". (ht,wd) can be (2,2), (4,2),    */
+/*                  (2,4), (4,4), (8,4), (4,8) or (8,8).                     */
+/*                                                                           */
+/*  Inputs        : puc_src  - pointer to source                             */
+/*                  puc_dst  - pointer to destination                        */
+/*                  src_strd - stride for source                             */
+/*                  dst_strd - stride for destination                        */
+/*                  dx       - x position of destination value               */
+/*                  dy       - y position of destination value               */
+/*                  ht       - height of the block                           */
+/*                  wd       - width of the block                            */
+/*                                                                           */
+/*  Issues        : Two rows of interleaved cb and cr samples are filtered   */
+/*                  per iteration, one row per 128 bit lane                  */
+/*                                                                           */
+/*****************************************************************************/
+AVX2_TARGET void ih264_inter_pred_chroma_avx2(UWORD8 *pu1_src,
+                                              UWORD8 *pu1_dst,
+                                              WORD32 src_strd,
+                                              WORD32 dst_strd,
+                                              WORD32 dx,
+                                              WORD32 dy,
+                                              WORD32 ht,
+                                              WORD32 wd)
+{
+    WORD32 A, B, C, D;
+
+    __m256i coeffAB_32x8b, coeffCD_32x8b, const_val32_16x16b;
+    __m128i src_r0_16x8b, src_r0_sht_16x8b;
+    __m128i src_r1_16x8b, src_r1_sht_16x8b;
+    __m128i src_r2_16x8b, src_r2_sht_16x8b;
+
+    if(wd != 8)
+    {
+        ih264_inter_pred_chroma_ssse3(pu1_src, pu1_dst, src_strd, dst_strd,
+                                      dx, dy, ht, wd);
+        return;
+    }
+
+    A = (8 - dx) * (8 - dy);
+    B = dx * (8 - dy);
+    C = (8 - dx) * dy;
+    D = dx * dy;
+
+    coeffAB_32x8b = _mm256_set1_epi16((B << 8) + A);
+    coeffCD_32x8b = _mm256_set1_epi16((D << 8) + C);
+    const_val32_16x16b = _mm256_set1_epi16(32);
+
+    src_r0_16x8b = _mm_loadu_si128((__m128i *)pu1_src);
+    src_r0_sht_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + 2));
+    pu1_src += src_strd;
+
+    do
+    {
+        __m256i src_r0r1_32x8b, src_r0r1_sht_32x8b;
+        __m256i src_r1r2_32x8b, src_r1r2_sht_32x8b;
+        __m256i res_lo_16x16b, res_hi_16x16b, res_32x8b;
+
+        src_r1_16x8b = _mm_loadu_si128((__m128i *)pu1_src);
+        src_r1_sht_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + 2));
+        src_r2_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + src_strd));
+        src_r2_sht_16x8b = _mm_loadu_si128((__m128i *)(pu1_src + src_strd + 2));
+
+        src_r0r1_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(src_r0_16x8b),
+                                                 src_r1_16x8b, 1);
+        src_r0r1_sht_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(src_r0_sht_16x8b),
+                                                     src_r1_sht_16x8b, 1);
+        src_r1r2_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(src_r1_16x8b),
+                                                 src_r2_16x8b, 1);
+        src_r1r2_sht_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(src_r1_sht_16x8b),
+                                                     src_r2_sht_16x8b, 1);
+
+        res_lo_16x16b = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(src_r0r1_32x8b, src_r0r1_sht_32x8b),
+                                             coeffAB_32x8b);
+        res_hi_16x16b = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(src_r0r1_32x8b, src_r0r1_sht_32x8b),
+                                             coeffAB_32x8b);
+        res_lo_16x16b = _mm256_add_epi16(res_lo_16x16b,
+                                         _mm256_maddubs_epi16(_mm256_unpacklo_epi8(src_r1r2_32x8b,
+                                                                                   src_r1r2_sht_32x8b),
+                                                              coeffCD_32x8b));
+        res_hi_16x16b = _mm256_add_epi16(res_hi_16x16b,
+                                         _mm256_maddubs_epi16(_mm256_unpackhi_epi8(src_r1r2_32x8b,
+                                                                                   src_r1r2_sht_32x8b),
+                                                              coeffCD_32x8b));
+
+        res_lo_16x16b = _mm256_srli_epi16(_mm256_add_epi16(res_lo_16x16b, const_val32_16x16b), 6);
+        res_hi_16x16b = _mm256_srli_epi16(_mm256_add_epi16(res_hi_16x16b, const_val32_16x16b), 6);
+
+        res_32x8b = _mm256_packus_epi16(res_lo_16x16b, res_hi_16x16b);
+
+        _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+        _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd), _mm256_extracti128_si256(res_32x8b, 1));
+
+        src_r0_16x8b = src_r2_16x8b;
+        src_r0_sht_16x8b = src_r2_sht_16x8b;
+
+        ht -= 2;
+        pu1_src += src_strd << 1;
+        pu1_dst += dst_strd << 1;
+    }
+    while(ht > 0);
+}
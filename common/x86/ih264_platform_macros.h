@@ -105,6 +105,7 @@ static __inline UWORD32 CTZ(UWORD32 u4_word)
 
 //#define INLINE __inline
 #define INLINE inline
+#define FORCEINLINE inline __attribute__ ((always_inline))
 
 #define PREFETCH_ENABLE 1
 
@@ -118,4 +119,8 @@ static __inline UWORD32 CTZ(UWORD32 u4_word)
 #define MEM_ALIGN16 __attribute__ ((aligned (16)))
 #define MEM_ALIGN32 __attribute__ ((aligned (32)))
 
+/* AVX2 functions are compiled for AVX2 irrespective of the baseline flags of
+the library and must only be called when the cpu reports AVX2 support */
+#define AVX2_TARGET __attribute__ ((target ("avx2")))
+
 #endif /* _IH264_PLATFORM_MACROS_H_ */
@@ -52,6 +52,9 @@ extern "C" {
 /*****************************************************************************/
 #define IVD_ERROR_MASK 0xFF
 
+/** Maximum number of CPUs in IH264D_CMD_CTL_SET_CPU_AFFINITY */
+#define IH264D_MAX_AFFINITY_CPUS 64
+
 /*****************************************************************************/
 /* Function Macros                                                           */
 /*****************************************************************************/
@@ -80,8 +83,64 @@ typedef enum {
 
     IH264D_VID_HDR_DEC_NUM_FRM_BUF_NOT_SUFFICIENT   = IVD_DUMMY_ELEMENT_FOR_CODEC_EXTENSIONS + 1,
 
+    /** Buffer not queued, as the queue is full */
+    IH264D_QUEUE_FULL,
+
+    /** No buffer to dequeue */
+    IH264D_QUEUE_EMPTY,
+
+    /** Call not allowed in the present (a)synchronous decode state */
+    IH264D_ASYNC_INVALID_CALL,
+
+    /** Invalid CPU set for thread affinity */
+    IH264D_INVALID_CPU_AFFINITY,
+
+    /** Invalid NAL length size or avcC record */
+    IH264D_INVALID_NAL_FORMAT,
+
 }IH264D_ERROR_CODES_T;
 
+/* Decode stages timed by IH264D_CMD_CTL_GET_STATS */
+typedef enum {
+
+    /** NAL extraction, header parsing and picture management */
+    IH264D_STATS_NAL_PARSE,
+
+    /** CAVLC / CABAC parsing of slice data */
+    IH264D_STATS_SLICE_PARSE,
+
+    /** Prediction, inverse transform and reconstruction */
+    IH264D_STATS_RECON,
+
+    /** Boundary strength computation */
+    IH264D_STATS_BS_COMPUTE,
+
+    /** Deblocking */
+    IH264D_STATS_DEBLOCK,
+
+    /** Conversion to the output color format */
+    IH264D_STATS_FMT_CONV,
+
+    IH264D_STATS_NUM_STAGES,
+
+}IH264D_STATS_STAGE_T;
+
+/* Decoder threads timed by IH264D_CMD_CTL_GET_STATS */
+typedef enum {
+
+    /** Thread calling the decoder, or the asynchronous decode thread */
+    IH264D_STATS_THREAD_PARSE,
+
+    /** Decode thread, when num_cores is 2 or more */
+    IH264D_STATS_THREAD_DECODE,
+
+    /** BS compute / deblock thread, when num_cores is 3 or more */
+    IH264D_STATS_THREAD_BS_DEBLK,
+
+    IH264D_STATS_NUM_THREADS,
+
+}IH264D_STATS_THREAD_T;
+
 /*****************************************************************************/
 /* Extended Structures                                                       */
 /*****************************************************************************/
@@ -132,6 +191,56 @@ typedef struct{
 }ih264d_video_decode_op_t;
 
 
+/*****************************************************************************/
+/*   Queue / Dequeue Input                                                   */
+/*****************************************************************************/
+
+
+typedef struct {
+    ivd_queue_input_ip_t                    s_ivd_queue_input_ip_t;
+}ih264d_queue_input_ip_t;
+
+
+typedef struct{
+    ivd_queue_input_op_t                    s_ivd_queue_input_op_t;
+}ih264d_queue_input_op_t;
+
+
+typedef struct {
+    ivd_dequeue_input_ip_t                  s_ivd_dequeue_input_ip_t;
+}ih264d_dequeue_input_ip_t;
+
+
+typedef struct{
+    ivd_dequeue_input_op_t                  s_ivd_dequeue_input_op_t;
+}ih264d_dequeue_input_op_t;
+
+
+/*****************************************************************************/
+/*   Queue / Dequeue Output                                                  */
+/*****************************************************************************/
+
+
+typedef struct {
+    ivd_queue_output_ip_t                   s_ivd_queue_output_ip_t;
+}ih264d_queue_output_ip_t;
+
+
+typedef struct{
+    ivd_queue_output_op_t                   s_ivd_queue_output_op_t;
+}ih264d_queue_output_op_t;
+
+
+typedef struct {
+    ivd_dequeue_output_ip_t                 s_ivd_dequeue_output_ip_t;
+}ih264d_dequeue_output_ip_t;
+
+
+typedef struct{
+    ivd_dequeue_output_op_t                 s_ivd_dequeue_output_op_t;
+}ih264d_dequeue_output_op_t;
+
+
 /*****************************************************************************/
 /*   Get Display Frame                                                       */
 /*****************************************************************************/
@@ -188,12 +297,27 @@ typedef enum {
     /** Set processor details */
     IH264D_CMD_CTL_SET_PROCESSOR         = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x001,
 
+    /** Set CPUs the decoder threads are pinned to */
+    IH264D_CMD_CTL_SET_CPU_AFFINITY      = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x002,
+
+    /** Enable / disable / reset decode statistics */
+    IH264D_CMD_CTL_SET_STATS             = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x003,
+
+    /** Set Annex B or length prefixed NAL units, and the avcC record */
+    IH264D_CMD_CTL_SET_NAL_FORMAT        = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x004,
+
     /** Get display buffer dimensions */
     IH264D_CMD_CTL_GET_BUFFER_DIMENSIONS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x100,
 
     /** Get VUI parameters */
     IH264D_CMD_CTL_GET_VUI_PARAMS        = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x101,
 
+    /** Get processor path in use */
+    IH264D_CMD_CTL_GET_PROCESSOR         = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x102,
+
+    /** Get decode statistics */
+    IH264D_CMD_CTL_GET_STATS             = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x103,
+
     /** Enable/disable GPU, supported on select platforms */
     IH264D_CMD_CTL_GPU_ENABLE_DISABLE    = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x200,
 
@@ -370,6 +494,146 @@ typedef struct{
     UWORD32                                     u4_error_code;
 }ih264d_ctl_set_num_cores_op_t;
 
+typedef struct
+{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Number of valid entries in au4_cpu_ids. 0 removes the CPU set and
+     * threads are no longer pinned by the decoder
+     */
+    UWORD32                                     u4_num_cpus;
+
+    /**
+     * CPUs the decoder threads are pinned to. Each of the parse, decode,
+     * bs-deblock and format conversion threads runs on one of them, round
+     * robin. Memory first touched by these threads is hence placed on the
+     * NUMA node of these CPUs
+     */
+    UWORD32                                     au4_cpu_ids[IH264D_MAX_AFFINITY_CPUS];
+}ih264d_ctl_set_cpu_affinity_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_set_cpu_affinity_op_t;
+
+typedef struct
+{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * 1 enables collection of statistics, 0 disables it. Statistics are
+     * disabled by default, and cost a few clock reads per macroblock group
+     * when enabled
+     */
+    UWORD32                                     u4_enable_stats;
+
+    /**
+     * 1 clears the statistics collected so far
+     */
+    UWORD32                                     u4_reset_stats;
+}ih264d_ctl_set_stats_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_set_stats_op_t;
+
+typedef struct
+{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * 0 for Annex B byte streams, where NAL units follow start codes. This
+     * is the default. 1, 2 or 4 if each NAL unit is instead preceded by its
+     * size in as many big-endian bytes, as in mp4 samples. Ignored when
+     * pv_avcc is set
+     */
+    UWORD32                                     u4_nal_length_size;
+
+    /**
+     * AVCDecoderConfigurationRecord (payload of the avcC box), or NULL. The
+     * NAL length size is taken from the record, and its parameter sets are
+     * decoded at the start of the next decode call, ahead of the bitstream
+     * buffer, and again after a reset. The record is copied
+     */
+    void                                        *pv_avcc;
+
+    /**
+     * Size of the record in bytes
+     */
+    UWORD32                                     u4_avcc_size;
+}ih264d_ctl_set_nal_format_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_set_nal_format_op_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ih264d_ctl_get_stats_ip_t;
+
+typedef struct
+{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Number of decode calls (or queued bitstream buffers decoded)
+     */
+    UWORD32                                     u4_num_decode_calls;
+
+    /**
+     * Number of pictures decoded
+     */
+    UWORD32                                     u4_num_pics_decoded;
+
+    /**
+     * Number of bitstream bytes consumed
+     */
+    UWORD64                                     u8_num_bytes;
+
+    /**
+     * Wall clock time spent in decode calls, in nanoseconds
+     */
+    UWORD64                                     u8_decode_ns;
+
+    /**
+     * Time spent in each stage, summed over all threads, in nanoseconds.
+     * Indexed by IH264D_STATS_STAGE_T
+     */
+    UWORD64                                     au8_stage_ns[IH264D_STATS_NUM_STAGES];
+
+    /**
+     * Time each thread spent working, in nanoseconds. Indexed by
+     * IH264D_STATS_THREAD_T
+     */
+    UWORD64                                     au8_thread_busy_ns[IH264D_STATS_NUM_THREADS];
+
+    /**
+     * Time each thread spent waiting on another thread, in nanoseconds.
+     * Indexed by IH264D_STATS_THREAD_T
+     */
+    UWORD64                                     au8_thread_wait_ns[IH264D_STATS_NUM_THREADS];
+
+    /**
+     * Number of CABAC context initializations, one per CABAC slice. Each is
+     * served by copying the prebuilt entry for its cabac_init_idc and slice
+     * QP, so there are never misses to count
+     */
+    UWORD32                                     u4_num_cabac_ctxt_inits;
+}ih264d_ctl_get_stats_op_t;
+
 typedef struct
 {
      /**
@@ -412,6 +676,43 @@ typedef struct
     UWORD32                                     u4_error_code;
 }ih264d_ctl_set_processor_op_t;
 
+typedef struct
+{
+     /**
+      * i4_size
+      */
+    UWORD32                                     u4_size;
+    /**
+     * cmd
+     */
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    /**
+     * sub cmd
+     */
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ih264d_ctl_get_processor_ip_t;
+
+typedef struct
+{
+    /**
+     * i4_size
+     */
+    UWORD32                                     u4_size;
+    /**
+     * error_code
+     */
+    UWORD32                                     u4_error_code;
+    /**
+     * Processor type whose function pointers are in use. This can differ
+     * from the one set, when the cpu does not support the requested one
+     */
+    UWORD32                                     u4_arch;
+    /**
+     * SOC type
+     */
+    UWORD32                                     u4_soc;
+}ih264d_ctl_get_processor_op_t;
+
 typedef struct{
     UWORD32                                     u4_size;
     IVD_API_COMMAND_TYPE_T                      e_cmd;
@@ -27,6 +27,7 @@
 /*                                                                           */
 /*  List of Functions : api_check_struct_sanity                              */
 /*          ih264d_set_processor                                             */
+/*          ih264d_get_processor                                             */
 /*          ih264d_create                                                    */
 /*          ih264d_delete                                                    */
 /*          ih264d_init                                                      */
@@ -46,6 +47,8 @@
 /*          ih264d_set_degrade                                               */
 /*          ih264d_get_frame_dimensions                                      */
 /*          ih264d_set_num_cores                                             */
+/*          ih264d_set_cpu_affinity                                          */
+/*          ih264d_set_nal_format                                            */
 /*          ih264d_fill_output_struct_from_context                           */
 /*          ih264d_api_function                                              */
 /*                                                                           */
@@ -91,6 +94,8 @@
 #include "ih264d_format_conv.h"
 #include "ih264d_parse_headers.h"
 #include "ih264d_thread_compute_bs.h"
+#include "ih264d_async.h"
+#include "ih264d_stats.h"
 #include <assert.h>
 
 
@@ -141,6 +146,14 @@ WORD32 ih264d_get_vui_params(iv_obj_t *dec_hdl,
 
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
 
+WORD32 ih264d_set_cpu_affinity(iv_obj_t *dec_hdl,
+                               void *pv_api_ip,
+                               void *pv_api_op);
+
+WORD32 ih264d_set_nal_format(iv_obj_t *dec_hdl,
+                             void *pv_api_ip,
+                             void *pv_api_op);
+
 WORD32 ih264d_deblock_display(dec_struct_t *ps_dec);
 
 void ih264d_signal_decode_thread(dec_struct_t *ps_dec);
@@ -186,6 +199,10 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
         case IVD_CMD_VIDEO_DECODE:
         case IVD_CMD_DELETE:
         case IVD_CMD_VIDEO_CTL:
+        case IVD_CMD_QUEUE_INPUT:
+        case IVD_CMD_DEQUEUE_INPUT:
+        case IVD_CMD_QUEUE_OUTPUT:
+        case IVD_CMD_DEQUEUE_OUTPUT:
             if(ps_handle == NULL)
             {
                 *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
@@ -465,6 +482,140 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                 return (IV_FAIL);
             }
 
+            /* synchronous calls are not mixed with the queue / dequeue ones */
+            if(((dec_struct_t *)ps_handle->pv_codec_handle)->s_async.i4_thread_created)
+            {
+                ps_op->s_ivd_video_decode_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_video_decode_op_t.u4_error_code |=
+                                IH264D_ASYNC_INVALID_CALL;
+                return (IV_FAIL);
+            }
+
+        }
+            break;
+
+        case IVD_CMD_QUEUE_INPUT:
+        {
+            ih264d_queue_input_ip_t *ps_ip =
+                            (ih264d_queue_input_ip_t *)pv_api_ip;
+            ih264d_queue_input_op_t *ps_op =
+                            (ih264d_queue_input_op_t *)pv_api_op;
+
+            ps_op->s_ivd_queue_input_op_t.u4_error_code = 0;
+
+            if(ps_ip->s_ivd_queue_input_ip_t.u4_size
+                            != sizeof(ih264d_queue_input_ip_t))
+            {
+                ps_op->s_ivd_queue_input_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_queue_input_op_t.u4_error_code |=
+                                IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->s_ivd_queue_input_op_t.u4_size
+                            != sizeof(ih264d_queue_input_op_t))
+            {
+                ps_op->s_ivd_queue_input_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_queue_input_op_t.u4_error_code |=
+                                IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+        }
+            break;
+
+        case IVD_CMD_DEQUEUE_INPUT:
+        {
+            ih264d_dequeue_input_ip_t *ps_ip =
+                            (ih264d_dequeue_input_ip_t *)pv_api_ip;
+            ih264d_dequeue_input_op_t *ps_op =
+                            (ih264d_dequeue_input_op_t *)pv_api_op;
+
+            ps_op->s_ivd_dequeue_input_op_t.u4_error_code = 0;
+
+            if(ps_ip->s_ivd_dequeue_input_ip_t.u4_size
+                            != sizeof(ih264d_dequeue_input_ip_t))
+            {
+                ps_op->s_ivd_dequeue_input_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_dequeue_input_op_t.u4_error_code |=
+                                IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->s_ivd_dequeue_input_op_t.u4_size
+                            != sizeof(ih264d_dequeue_input_op_t))
+            {
+                ps_op->s_ivd_dequeue_input_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_dequeue_input_op_t.u4_error_code |=
+                                IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+        }
+            break;
+
+        case IVD_CMD_QUEUE_OUTPUT:
+        {
+            ih264d_queue_output_ip_t *ps_ip =
+                            (ih264d_queue_output_ip_t *)pv_api_ip;
+            ih264d_queue_output_op_t *ps_op =
+                            (ih264d_queue_output_op_t *)pv_api_op;
+
+            ps_op->s_ivd_queue_output_op_t.u4_error_code = 0;
+
+            if(ps_ip->s_ivd_queue_output_ip_t.u4_size
+                            != sizeof(ih264d_queue_output_ip_t))
+            {
+                ps_op->s_ivd_queue_output_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_queue_output_op_t.u4_error_code |=
+                                IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->s_ivd_queue_output_op_t.u4_size
+                            != sizeof(ih264d_queue_output_op_t))
+            {
+                ps_op->s_ivd_queue_output_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_queue_output_op_t.u4_error_code |=
+                                IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+        }
+            break;
+
+        case IVD_CMD_DEQUEUE_OUTPUT:
+        {
+            ih264d_dequeue_output_ip_t *ps_ip =
+                            (ih264d_dequeue_output_ip_t *)pv_api_ip;
+            ih264d_dequeue_output_op_t *ps_op =
+                            (ih264d_dequeue_output_op_t *)pv_api_op;
+
+            ps_op->s_ivd_dequeue_output_op_t.u4_error_code = 0;
+
+            if(ps_ip->s_ivd_dequeue_output_ip_t.u4_size
+                            != sizeof(ih264d_dequeue_output_ip_t))
+            {
+                ps_op->s_ivd_dequeue_output_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_dequeue_output_op_t.u4_error_code |=
+                                IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if(ps_op->s_ivd_dequeue_output_op_t.u4_size
+                            != sizeof(ih264d_dequeue_output_op_t))
+            {
+                ps_op->s_ivd_dequeue_output_op_t.u4_error_code |= 1
+                                << IVD_UNSUPPORTEDPARAM;
+                ps_op->s_ivd_dequeue_output_op_t.u4_error_code |=
+                                IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
         }
             break;
 
@@ -810,6 +961,101 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     }
                     break;
                 }
+                case IH264D_CMD_CTL_SET_CPU_AFFINITY:
+                {
+                    ih264d_ctl_set_cpu_affinity_ip_t *ps_ip;
+                    ih264d_ctl_set_cpu_affinity_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_cpu_affinity_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_set_cpu_affinity_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_cpu_affinity_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_cpu_affinity_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_ip->u4_num_cpus > IH264D_MAX_AFFINITY_CPUS)
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IH264D_INVALID_CPU_AFFINITY;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
+                case IH264D_CMD_CTL_SET_STATS:
+                {
+                    ih264d_ctl_set_stats_ip_t *ps_ip;
+                    ih264d_ctl_set_stats_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_stats_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_set_stats_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_stats_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_stats_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+                case IH264D_CMD_CTL_SET_NAL_FORMAT:
+                {
+                    ih264d_ctl_set_nal_format_ip_t *ps_ip;
+                    ih264d_ctl_set_nal_format_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_nal_format_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_set_nal_format_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_set_nal_format_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_set_nal_format_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    /* the avcC record itself is checked as it is read */
+                    if((NULL == ps_ip->pv_avcc)
+                                    && (ps_ip->u4_nal_length_size != 0)
+                                    && (ps_ip->u4_nal_length_size != 1)
+                                    && (ps_ip->u4_nal_length_size != 2)
+                                    && (ps_ip->u4_nal_length_size != 4))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IH264D_INVALID_NAL_FORMAT;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
                 case IH264D_CMD_CTL_SET_PROCESSOR:
                 {
                     ih264d_ctl_set_processor_ip_t *ps_ip;
@@ -836,6 +1082,58 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
 
                     break;
                 }
+                case IH264D_CMD_CTL_GET_PROCESSOR:
+                {
+                    ih264d_ctl_get_processor_ip_t *ps_ip;
+                    ih264d_ctl_get_processor_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_get_processor_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_get_processor_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_get_processor_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_get_processor_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+                case IH264D_CMD_CTL_GET_STATS:
+                {
+                    ih264d_ctl_get_stats_ip_t *ps_ip;
+                    ih264d_ctl_get_stats_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_get_stats_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_get_stats_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_get_stats_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_get_stats_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
                 default:
                     *(pu4_api_op + 1) |= 1 << IVD_UNSUPPORTEDPARAM;
                     *(pu4_api_op + 1) |= IVD_UNSUPPORTED_API_CMD;
@@ -894,6 +1192,49 @@ WORD32 ih264d_set_processor(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     return IV_SUCCESS;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Gets Processor type
+ *
+ * @par Description:
+ *  Returns the processor type whose function pointers are in use. On x86 this
+ *  is resolved at runtime from the cpu features, so it can be lower than the
+ *  one set through IH264D_CMD_CTL_SET_PROCESSOR
+ *
+ * @param[in] ps_codec_obj
+ *  Pointer to codec object at API level
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns  Status
+ *
+ * @remarks
+ *
+ *
+ *******************************************************************************
+ */
+
+WORD32 ih264d_get_processor(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_get_processor_op_t *ps_op;
+    dec_struct_t *ps_codec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+
+    UNUSED(pv_api_ip);
+    ps_op = (ih264d_ctl_get_processor_op_t *)pv_api_op;
+
+    ps_op->u4_arch = (UWORD32)ps_codec->e_processor_arch;
+    ps_op->u4_soc = (UWORD32)ps_codec->e_processor_soc;
+
+    ps_op->u4_error_code = 0;
+    return IV_SUCCESS;
+}
+
 
 /**************************************************************************
  * \if Function name : ih264d_init_decoder \endif
@@ -1155,6 +1496,22 @@ WORD32 ih264d_free_static_bufs(iv_obj_t *dec_hdl)
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pps);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_thread_handle);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_bs_deblk_thread_handle);
+    if(ps_dec->s_async.pv_thread_handle)
+    {
+        ithread_cond_destroy(ps_dec->s_async.pv_cond);
+        ithread_mutex_destroy(ps_dec->s_async.pv_mutex);
+        PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->s_async.pv_thread_handle);
+    }
+    if(ps_dec->pv_dec_mb_progress)
+    {
+        ithread_progress_destroy(ps_dec->pv_dec_mb_progress);
+        PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_mb_progress);
+    }
+    if(ps_dec->pv_recon_mb_progress)
+    {
+        ithread_progress_destroy(ps_dec->pv_recon_mb_progress);
+        PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_recon_mb_progress);
+    }
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_dpb_mgr);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pred);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_disp_buf_mgr);
@@ -1167,6 +1524,7 @@ WORD32 ih264d_free_static_bufs(iv_obj_t *dec_hdl)
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_cur_slice);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_scratch_sps_pps);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_static);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_avcc_nals);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ppv_map_ref_idx_to_poc_base);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->p_cabac_ctxt_table_t);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_left_mb_ctxt_info);
@@ -1291,6 +1649,34 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     memset(pv_buf, 0, size);
     ps_dec->pv_bs_deblk_thread_handle = pv_buf;
 
+    /* decode thread handle, mutex and condition of the asynchronous interface */
+    size = ithread_get_handle_size() + ithread_get_mutex_lock_size()
+                    + ithread_get_cond_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    memset(pv_buf, 0, size);
+    ps_dec->s_async.pv_thread_handle = pv_buf;
+    ps_dec->s_async.pv_mutex = (UWORD8 *)pv_buf + ithread_get_handle_size();
+    ps_dec->s_async.pv_cond = (UWORD8 *)ps_dec->s_async.pv_mutex
+                    + ithread_get_mutex_lock_size();
+    ithread_mutex_init(ps_dec->s_async.pv_mutex);
+    ithread_cond_init(ps_dec->s_async.pv_cond);
+    ih264d_async_init(ps_dec);
+
+    size = ithread_get_progress_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    memset(pv_buf, 0, size);
+    ithread_progress_init(pv_buf, MB_MAP_WAIT_SPIN_CNT);
+    ps_dec->pv_dec_mb_progress = pv_buf;
+
+    size = ithread_get_progress_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    memset(pv_buf, 0, size);
+    ithread_progress_init(pv_buf, MB_MAP_WAIT_SPIN_CNT);
+    ps_dec->pv_recon_mb_progress = pv_buf;
+
     size = sizeof(dpb_manager_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
@@ -1799,6 +2185,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     UWORD8 *pu1_buf = NULL;
     WORD32 buflen;
     UWORD32 u4_max_ofst, u4_length_of_start_code = 0;
+    UWORD32 u4_avcc_nal_ofst = ps_dec->u4_avcc_nals_ofst;
 
     UWORD32 bytes_consumed = 0;
     UWORD32 cur_slice_is_nonref = 0;
@@ -1806,6 +2193,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     UWORD32 u4_first_start_code_found = 0;
     WORD32 ret = 0,api_ret_value = IV_SUCCESS;
     WORD32 header_data_left = 0,frame_data_left = 0;
+    WORD32 i4_stats_stage = STATS_STAGE_IDLE;
     UWORD8 *pu1_bitstrm_buf;
     ivd_video_decode_ip_t *ps_dec_ip;
     ivd_video_decode_op_t *ps_dec_op;
@@ -2028,9 +2416,12 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
             ps_dec->u4_fmt_conv_cur_row = 0;
             ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht;
+            i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                          IH264D_STATS_FMT_CONV);
             ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                   ps_dec->u4_fmt_conv_cur_row,
                                   ps_dec->u4_fmt_conv_num_rows);
+            STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
             ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
             ps_dec->u4_output_present = 1;
 
@@ -2133,29 +2524,48 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
         u4_next_is_aud = 0;
 
-        buflen = ih264d_find_start_code(pu1_buf, 0, u4_max_ofst,
-                                               &u4_length_of_start_code,
-                                               &u4_next_is_aud);
-
-        if(buflen == -1)
-            buflen = 0;
         /* Ignore bytes beyond the allocated size of intermediate buffer */
         /* Since 8 bytes are read ahead, ensure 8 bytes are free at the
         end of the buffer, which will be memset to 0 after emulation prevention */
-        buflen = MIN(buflen, buf_size - 8);
-
-        bytes_consumed = buflen + u4_length_of_start_code;
+        u4_avcc_nal_ofst = ps_dec->u4_avcc_nals_ofst;
+        if(u4_avcc_nal_ofst < ps_dec->u4_avcc_nals_size)
+        {
+            /* Parameter sets of the avcC record go ahead of the bitstream */
+            buflen = ih264d_extract_sized_nal_unit(ps_dec->ps_bitstrm,
+                                                   ps_dec->pf_find_nal_escape,
+                                                   ps_dec->pu1_avcc_nals + u4_avcc_nal_ofst,
+                                                   ps_dec->u4_avcc_nals_size - u4_avcc_nal_ofst,
+                                                   2, pu1_bitstrm_buf, buf_size - 8,
+                                                   &bytes_consumed,
+                                                   &u4_next_is_aud);
+            ps_dec->u4_avcc_nals_ofst += bytes_consumed;
+            bytes_consumed = 0;
+            u4_next_is_aud = 0;
+        }
+        else if(ps_dec->u4_nal_length_size)
+        {
+            buflen = ih264d_extract_sized_nal_unit(ps_dec->ps_bitstrm,
+                                                   ps_dec->pf_find_nal_escape,
+                                                   pu1_buf, u4_max_ofst,
+                                                   ps_dec->u4_nal_length_size,
+                                                   pu1_bitstrm_buf, buf_size - 8,
+                                                   &bytes_consumed,
+                                                   &u4_next_is_aud);
+        }
+        else
+        {
+            buflen = ih264d_extract_nal_unit(ps_dec->ps_bitstrm,
+                                             ps_dec->pf_find_nal_escape,
+                                             pu1_buf, u4_max_ofst,
+                                             pu1_bitstrm_buf, buf_size - 8,
+                                             &u4_length_of_start_code,
+                                             &u4_next_is_aud);
+            bytes_consumed = buflen + u4_length_of_start_code;
+        }
         ps_dec_op->u4_num_bytes_consumed += bytes_consumed;
 
         if(buflen)
         {
-            memcpy(pu1_bitstrm_buf, pu1_buf + u4_length_of_start_code,
-                   buflen);
-            /* Decoder may read extra 8 bytes near end of the frame */
-            if((buflen + 8) < buf_size)
-            {
-                memset(pu1_bitstrm_buf + buflen, 0, 8);
-            }
             u4_first_start_code_found = 1;
 
         }
@@ -2221,6 +2631,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             if((ret == ERROR_INCOMPLETE_FRAME) || (ret == ERROR_DANGLING_FIELD_IN_PIC))
             {
                 ps_dec_op->u4_num_bytes_consumed -= bytes_consumed;
+                ps_dec->u4_avcc_nals_ofst = u4_avcc_nal_ofst;
                 api_ret_value = IV_FAIL;
                 break;
             }
@@ -2295,6 +2706,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         if(ret == IVD_RES_CHANGED)
         {
             ps_dec_op->u4_num_bytes_consumed -= bytes_consumed;
+            ps_dec->u4_avcc_nals_ofst = u4_avcc_nal_ofst;
         }
         return IV_FAIL;
     }
@@ -2330,8 +2742,13 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
                 DEBUG_PERF_PRINTF("mbs left for deblocking= %d \n",u4_num_mbs);
 
                 if(u4_num_mbs != 0)
+                {
+                    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                                  IH264D_STATS_DEBLOCK);
                     ih264d_check_mb_map_deblk(ps_dec, u4_num_mbs,
                                                    ps_tfr_cxt,1);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
+                }
 
                 ps_dec->u4_start_recon_deblk  = 0;
 
@@ -2471,9 +2888,12 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         {
             ps_dec->u4_fmt_conv_num_rows = ps_dec->s_disp_frame_info.u4_y_ht
                             - ps_dec->u4_fmt_conv_cur_row;
+            i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                          IH264D_STATS_FMT_CONV);
             ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                   ps_dec->u4_fmt_conv_cur_row,
                                   ps_dec->u4_fmt_conv_num_rows);
+            STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
             ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
         }
 
@@ -3204,6 +3624,7 @@ WORD32 ih264d_delete(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_dec = (dec_struct_t *)(dec_hdl->pv_codec_handle);
     UNUSED(ps_ip);
     ps_op->s_ivd_delete_op_t.u4_error_code = 0;
+    ih264d_async_stop(ps_dec);
     ih264d_free_dynamic_bufs(ps_dec);
     ih264d_free_static_bufs(dec_hdl);
     return IV_SUCCESS;
@@ -3240,7 +3661,14 @@ WORD32 ih264d_reset(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     if(ps_dec != NULL)
     {
+        /* decode thread, if any, is stopped before the context is reset */
+        ih264d_async_stop(ps_dec);
+        ih264d_async_init(ps_dec);
         ih264d_init_decoder(ps_dec);
+
+        /* parameter sets are reset too, those of the avcC record are */
+        /* decoded again                                               */
+        ps_dec->u4_avcc_nals_ofst = 0;
     }
     else
     {
@@ -3290,6 +3718,19 @@ WORD32 ih264d_ctl(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_ctl_op->u4_error_code = 0;
     subcommand = ps_ctl_ip->e_sub_cmd;
 
+    /* decoder state is owned by the decode thread of the asynchronous
+     * interface, only calls that do not change it are served */
+    if(ps_dec->s_async.i4_thread_created
+                    && (subcommand != IVD_CMD_CTL_RESET)
+                    && (subcommand != IVD_CMD_CTL_GETVERSION)
+                    && (subcommand != IVD_CMD_CTL_GETBUFINFO)
+                    && (subcommand != IH264D_CMD_CTL_GET_STATS))
+    {
+        ps_ctl_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM)
+                        | IH264D_ASYNC_INVALID_CALL;
+        return IV_FAIL;
+    }
+
     switch(subcommand)
     {
         case IVD_CMD_CTL_GETPARAMS:
@@ -3341,6 +3782,26 @@ WORD32 ih264d_ctl(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             ret = ih264d_set_processor(dec_hdl, (void *)pv_api_ip,
                                        (void *)pv_api_op);
             break;
+        case IH264D_CMD_CTL_SET_CPU_AFFINITY:
+            ret = ih264d_set_cpu_affinity(dec_hdl, (void *)pv_api_ip,
+                                          (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_GET_PROCESSOR:
+            ret = ih264d_get_processor(dec_hdl, (void *)pv_api_ip,
+                                       (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_SET_STATS:
+            ret = ih264d_set_stats(dec_hdl, (void *)pv_api_ip,
+                                   (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_SET_NAL_FORMAT:
+            ret = ih264d_set_nal_format(dec_hdl, (void *)pv_api_ip,
+                                        (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_GET_STATS:
+            ret = ih264d_get_stats(dec_hdl, (void *)pv_api_ip,
+                                   (void *)pv_api_op);
+            break;
         default:
             H264_DEC_DEBUG_PRINT("\ndo nothing\n")
             ;
@@ -3656,6 +4117,72 @@ WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     return IV_SUCCESS;
 }
 
+WORD32 ih264d_set_cpu_affinity(iv_obj_t *dec_hdl,
+                               void *pv_api_ip,
+                               void *pv_api_op)
+{
+    ih264d_ctl_set_cpu_affinity_ip_t *ps_ip;
+    ih264d_ctl_set_cpu_affinity_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    UWORD32 i;
+
+    ps_ip = (ih264d_ctl_set_cpu_affinity_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_cpu_affinity_op_t *)pv_api_op;
+    ps_op->u4_error_code = 0;
+
+    /* Takes effect as the decoder threads are next created */
+    ps_dec->i4_num_affinity_cpus = ps_ip->u4_num_cpus;
+    for(i = 0; i < ps_ip->u4_num_cpus; i++)
+    {
+        ps_dec->ai4_affinity_cpus[i] = ps_ip->au4_cpu_ids[i];
+    }
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_nal_format(iv_obj_t *dec_hdl,
+                             void *pv_api_ip,
+                             void *pv_api_op)
+{
+    ih264d_ctl_set_nal_format_ip_t *ps_ip;
+    ih264d_ctl_set_nal_format_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    UWORD8 *pu1_nals = NULL;
+    UWORD32 u4_nals_size = 0;
+    UWORD32 u4_nal_length_size;
+
+    ps_ip = (ih264d_ctl_set_nal_format_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_nal_format_op_t *)pv_api_op;
+    ps_op->u4_error_code = 0;
+
+    u4_nal_length_size = ps_ip->u4_nal_length_size;
+    if(ps_ip->pv_avcc)
+    {
+        pu1_nals = ps_dec->pf_aligned_alloc(ps_dec->pv_mem_ctxt, 128,
+                                            ps_ip->u4_avcc_size);
+        RETURN_IF((NULL == pu1_nals), IV_FAIL);
+
+        if(OK != ih264d_parse_avcc(ps_ip->pv_avcc, ps_ip->u4_avcc_size,
+                                   pu1_nals, &u4_nals_size,
+                                   &u4_nal_length_size))
+        {
+            ps_dec->pf_aligned_free(ps_dec->pv_mem_ctxt, pu1_nals);
+            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+            ps_op->u4_error_code |= IH264D_INVALID_NAL_FORMAT;
+            return IV_FAIL;
+        }
+    }
+
+    /* The parameter sets of a previous record are dropped */
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_avcc_nals);
+    ps_dec->pu1_avcc_nals = pu1_nals;
+    ps_dec->u4_avcc_nals_size = u4_nals_size;
+    ps_dec->u4_avcc_nals_ofst = 0;
+    ps_dec->u4_nal_length_size = u4_nal_length_size;
+
+    return IV_SUCCESS;
+}
+
 void ih264d_fill_output_struct_from_context(dec_struct_t *ps_dec,
                                             ivd_video_decode_op_t *ps_dec_op)
 {
@@ -3744,8 +4271,11 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl,
             break;
 
         case IVD_CMD_VIDEO_DECODE:
+            ih264d_stats_decode_start(dec_hdl->pv_codec_handle);
             u4_api_ret = ih264d_video_decode(dec_hdl, (void *)pv_api_ip,
                                              (void *)pv_api_op);
+            ih264d_stats_decode_end(dec_hdl->pv_codec_handle,
+                                    (ivd_video_decode_op_t *)pv_api_op);
             break;
 
         case IVD_CMD_GET_DISPLAY_FRAME:
@@ -3769,6 +4299,26 @@ IV_API_CALL_STATUS_T ih264d_api_function(iv_obj_t *dec_hdl,
             u4_api_ret = ih264d_ctl(dec_hdl, (void *)pv_api_ip,
                                     (void *)pv_api_op);
             break;
+
+        case IVD_CMD_QUEUE_INPUT:
+            u4_api_ret = ih264d_queue_input(dec_hdl, (void *)pv_api_ip,
+                                            (void *)pv_api_op);
+            break;
+
+        case IVD_CMD_DEQUEUE_INPUT:
+            u4_api_ret = ih264d_dequeue_input(dec_hdl, (void *)pv_api_ip,
+                                              (void *)pv_api_op);
+            break;
+
+        case IVD_CMD_QUEUE_OUTPUT:
+            u4_api_ret = ih264d_queue_output(dec_hdl, (void *)pv_api_ip,
+                                             (void *)pv_api_op);
+            break;
+
+        case IVD_CMD_DEQUEUE_OUTPUT:
+            u4_api_ret = ih264d_dequeue_output(dec_hdl, (void *)pv_api_ip,
+                                               (void *)pv_api_op);
+            break;
         default:
             u4_api_ret = IV_FAIL;
             break;
@@ -0,0 +1,846 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_async.c                                       */
+/*                                                                           */
+/*  Description       : Contains functions of the asynchronous (queue /      */
+/*                      dequeue) decode interface. Bitstream and output      */
+/*                      buffers queued by the app are handed to              */
+/*                      ih264d_video_decode() by a dedicated decode thread,  */
+/*                      which runs ahead of the app across access units.     */
+/*                      Buffers released by the decoder are held till the    */
+/*                      app dequeues them                                    */
+/*                                                                           */
+/*  List of Functions : ih264d_async_init                                    */
+/*          ih264d_async_release_inp                                         */
+/*          ih264d_async_release_bufs                                        */
+/*          ih264d_async_thread                                              */
+/*          ih264d_async_launch                                              */
+/*          ih264d_async_stop                                                */
+/*          ih264d_queue_input                                               */
+/*          ih264d_dequeue_input                                             */
+/*          ih264d_queue_output                                              */
+/*          ih264d_dequeue_output                                            */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+#include "ithread.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_utils.h"
+#include "ih264d_async.h"
+#include "ih264d_stats.h"
+
+WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+WORD32 ih264d_set_flush_mode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Empties the queues of the asynchronous interface
+ *
+ * @par   Description
+ * Called at create and reset, once the decode thread, if any, has exited
+ *
+ * @param[in] ps_dec
+ *  Pointer to decoder context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+void ih264d_async_init(dec_struct_t *ps_dec)
+{
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+
+    ps_async->i4_exit = 0;
+    ps_async->i4_last_inp_queued = 0;
+    ps_async->i4_flush = 0;
+    ps_async->i4_eos = 0;
+    ps_async->u4_error_code = 0;
+    ps_async->u4_inp_ofst = 0;
+
+    ps_async->i4_inp_q_rd = 0;
+    ps_async->i4_inp_q_cnt = 0;
+    ps_async->i4_inp_done_rd = 0;
+    ps_async->i4_inp_done_cnt = 0;
+
+    ps_async->i4_out_q_rd = 0;
+    ps_async->i4_out_q_cnt = 0;
+    ps_async->i4_out_busy_cnt = 0;
+    ps_async->i4_out_done_rd = 0;
+    ps_async->i4_out_done_cnt = 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Moves the bitstream buffer at the head of the queue to the dequeue
+ * queue
+ *
+ * @par   Description
+ * Called with the mutex held. Empty buffers, allowed for the last one of the
+ * stream, are not returned
+ *
+ * @param[in] ps_async
+ *  Pointer to the asynchronous interface context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+static void ih264d_async_release_inp(dec_async_ctxt_t *ps_async)
+{
+    ivd_queue_input_ip_t *ps_inp = &ps_async->as_inp_q[ps_async->i4_inp_q_rd];
+
+    if(ps_inp->pv_stream_buffer)
+    {
+        ivd_dequeue_input_op_t *ps_done;
+        WORD32 idx;
+
+        idx = (ps_async->i4_inp_done_rd + ps_async->i4_inp_done_cnt)
+                        % MAX_ASYNC_INP_BUFS;
+        ps_done = &ps_async->as_inp_done[idx];
+
+        ps_done->u4_ts = ps_inp->u4_ts;
+        ps_done->u4_num_Bytes = ps_inp->u4_num_Bytes;
+        ps_done->pv_stream_buffer = ps_inp->pv_stream_buffer;
+        ps_done->u4_num_bytes_consumed = MIN(ps_async->u4_inp_ofst,
+                                             ps_inp->u4_num_Bytes);
+        ps_done->u4_is_last = ps_inp->u4_is_last;
+
+        ps_async->i4_inp_done_cnt++;
+    }
+
+    ps_async->u4_inp_ofst = 0;
+    ps_async->i4_inp_q_rd = (ps_async->i4_inp_q_rd + 1) % MAX_ASYNC_INP_BUFS;
+    ps_async->i4_inp_q_cnt--;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns all buffers held by the asynchronous interface to the app
+ *
+ * @par   Description
+ * Called with the mutex held, once the decoder has returned its last frame or
+ * has failed. Bitstream buffers still queued are returned with the bytes
+ * consumed so far. Output buffers are returned without a frame, and the last
+ * one of the stream is marked as such
+ *
+ * @param[in] ps_async
+ *  Pointer to the asynchronous interface context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+static void ih264d_async_release_bufs(dec_async_ctxt_t *ps_async)
+{
+    WORD32 i, idx;
+
+    while(ps_async->i4_inp_q_cnt)
+    {
+        ih264d_async_release_inp(ps_async);
+    }
+
+    for(i = 0; i < ps_async->i4_out_busy_cnt + ps_async->i4_out_q_cnt; i++)
+    {
+        ivd_dequeue_output_op_t *ps_out;
+
+        idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt)
+                        % MAX_ASYNC_OUT_BUFS;
+        ps_out = &ps_async->as_out_done[idx];
+
+        memset(ps_out, 0, sizeof(ivd_dequeue_output_op_t));
+        if(i < ps_async->i4_out_busy_cnt)
+        {
+            ps_out->s_out_buffer = ps_async->s_out_busy;
+        }
+        else
+        {
+            ps_out->s_out_buffer = ps_async->as_out_q[ps_async->i4_out_q_rd];
+            ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        }
+
+        ps_async->i4_out_done_cnt++;
+    }
+    ps_async->i4_out_busy_cnt = 0;
+    ps_async->i4_out_q_cnt = 0;
+
+    if(ps_async->i4_out_done_cnt)
+    {
+        idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt - 1)
+                        % MAX_ASYNC_OUT_BUFS;
+        ps_async->as_out_done[idx].u4_is_last = 1;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Entry point of the decode thread of the asynchronous interface
+ *
+ * @par   Description
+ * Waits till an output buffer and a bitstream buffer are queued, then decodes
+ * the next access unit of the bitstream buffer with a synchronous
+ * ih264d_video_decode() call. A bitstream buffer is returned once all of it
+ * is consumed, an output buffer once a frame is written to it. Frames are
+ * thus returned in display order. Once the last bitstream buffer is consumed
+ * the decoder is flushed till it has no frame left. Repeats till asked to
+ * exit
+ *
+ * Fatal errors and resolution changes end the stream, other errors are
+ * concealed by the decoder. Bytes of a bitstream buffer the decoder can not
+ * consume are dropped
+ *
+ * @param[in] pv_dec
+ *  Pointer to decoder context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_async_thread(void *pv_dec)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)pv_dec;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+    iv_obj_t *dec_hdl = (iv_obj_t *)ps_async->pv_dec_hdl;
+
+    ivd_video_decode_ip_t s_dec_ip;
+    ivd_video_decode_op_t s_dec_op;
+    ivd_ctl_flush_ip_t s_flush_ip;
+    ivd_ctl_flush_op_t s_flush_op;
+    ivd_queue_input_ip_t *ps_inp = NULL;
+    WORD32 idx, ret;
+
+    /* parsing runs on this thread */
+    ih264d_set_thread_affinity(ps_dec, 0);
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while(1)
+    {
+        while((0 == ps_async->i4_exit)
+                        && (ps_async->i4_eos || (0 == ps_async->i4_out_q_cnt)
+                                        || ((0 == ps_async->i4_inp_q_cnt)
+                                                        && (0 == ps_async->i4_flush))))
+        {
+            ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+        }
+
+        if(ps_async->i4_exit)
+        {
+            break;
+        }
+
+        memset(&s_dec_ip, 0, sizeof(ivd_video_decode_ip_t));
+        memset(&s_dec_op, 0, sizeof(ivd_video_decode_op_t));
+        s_dec_ip.u4_size = sizeof(ivd_video_decode_ip_t);
+        s_dec_ip.e_cmd = IVD_CMD_VIDEO_DECODE;
+        s_dec_op.u4_size = sizeof(ivd_video_decode_op_t);
+
+        /* bitstream */
+        if(0 == ps_async->i4_flush)
+        {
+            ps_inp = &ps_async->as_inp_q[ps_async->i4_inp_q_rd];
+
+            if(ps_async->u4_inp_ofst >= ps_inp->u4_num_Bytes)
+            {
+                ps_async->i4_flush = ps_inp->u4_is_last;
+                ih264d_async_release_inp(ps_async);
+
+                if(ps_async->i4_flush)
+                {
+                    s_flush_ip.u4_size = sizeof(ivd_ctl_flush_ip_t);
+                    s_flush_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+                    s_flush_ip.e_sub_cmd = IVD_CMD_CTL_FLUSH;
+                    s_flush_op.u4_size = sizeof(ivd_ctl_flush_op_t);
+                    ih264d_set_flush_mode(dec_hdl, &s_flush_ip, &s_flush_op);
+                }
+
+                ithread_cond_broadcast(ps_async->pv_cond);
+                continue;
+            }
+
+            s_dec_ip.u4_ts = ps_inp->u4_ts;
+            s_dec_ip.pv_stream_buffer = (UWORD8 *)ps_inp->pv_stream_buffer
+                            + ps_async->u4_inp_ofst;
+            s_dec_ip.u4_num_Bytes = ps_inp->u4_num_Bytes - ps_async->u4_inp_ofst;
+        }
+
+        /* output buffer */
+        s_dec_ip.s_out_buffer = ps_async->as_out_q[ps_async->i4_out_q_rd];
+        ps_async->s_out_busy = s_dec_ip.s_out_buffer;
+        ps_async->i4_out_busy_cnt = 1;
+
+        ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        ps_async->i4_out_q_cnt--;
+
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        ih264d_stats_decode_start(ps_dec);
+        ret = ih264d_video_decode(dec_hdl, &s_dec_ip, &s_dec_op);
+        ih264d_stats_decode_end(ps_dec, &s_dec_op);
+
+        ithread_mutex_lock(ps_async->pv_mutex);
+
+        ps_async->i4_out_busy_cnt = 0;
+
+        if(s_dec_op.u4_output_present)
+        {
+            ivd_dequeue_output_op_t *ps_out;
+
+            idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt)
+                            % MAX_ASYNC_OUT_BUFS;
+            ps_out = &ps_async->as_out_done[idx];
+
+            ps_out->s_out_buffer = s_dec_ip.s_out_buffer;
+            ps_out->u4_output_present = 1;
+            ps_out->u4_pic_wd = s_dec_op.u4_pic_wd;
+            ps_out->u4_pic_ht = s_dec_op.u4_pic_ht;
+            ps_out->u4_progressive_frame_flag = s_dec_op.u4_progressive_frame_flag;
+            ps_out->e_output_format = s_dec_op.e_output_format;
+            ps_out->s_disp_frm_buf = s_dec_op.s_disp_frm_buf;
+            ps_out->e4_fld_type = s_dec_op.e4_fld_type;
+            ps_out->u4_ts = s_dec_op.u4_ts;
+            ps_out->u4_disp_buf_id = s_dec_op.u4_disp_buf_id;
+            ps_out->u4_is_last = 0;
+
+            ps_async->i4_out_done_cnt++;
+        }
+        else
+        {
+            /* unused, it is the next one handed to the decoder */
+            ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd
+                            + MAX_ASYNC_OUT_BUFS - 1) % MAX_ASYNC_OUT_BUFS;
+            ps_async->as_out_q[ps_async->i4_out_q_rd] = s_dec_ip.s_out_buffer;
+            ps_async->i4_out_q_cnt++;
+        }
+
+        if(ps_async->i4_flush)
+        {
+            /* flushed till no frame is left */
+            if(0 == s_dec_op.u4_output_present)
+            {
+                ps_async->i4_eos = 1;
+                ih264d_async_release_bufs(ps_async);
+            }
+        }
+        else if(IV_SUCCESS != ret)
+        {
+            if(IS_IVD_FATAL_ERROR(s_dec_op.u4_error_code)
+                            || ((s_dec_op.u4_error_code & 0xFF) == IVD_RES_CHANGED))
+            {
+                ps_async->u4_error_code = s_dec_op.u4_error_code;
+                ps_async->u4_inp_ofst += s_dec_op.u4_num_bytes_consumed;
+                ps_async->i4_eos = 1;
+                ih264d_async_release_bufs(ps_async);
+            }
+            else if(0 == s_dec_op.u4_num_bytes_consumed)
+            {
+                ps_async->u4_inp_ofst = ps_inp->u4_num_Bytes;
+            }
+            else
+            {
+                ps_async->u4_inp_ofst += s_dec_op.u4_num_bytes_consumed;
+            }
+        }
+        else
+        {
+            ps_async->u4_inp_ofst += s_dec_op.u4_num_bytes_consumed;
+        }
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Creates the decode thread on the first queue call
+ *
+ * @par   Description
+ * Called with the mutex held
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @returns error status
+ *
+ *******************************************************************************
+ */
+static WORD32 ih264d_async_launch(iv_obj_t *dec_hdl)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+
+    if(0 == ps_async->i4_thread_created)
+    {
+        ps_async->pv_dec_hdl = dec_hdl;
+
+        if(0 != ithread_create(ps_async->pv_thread_handle, NULL,
+                               (void *)ih264d_async_thread, (void *)ps_dec))
+        {
+            return IV_FAIL;
+        }
+
+        ps_async->i4_thread_created = 1;
+    }
+
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Stops the decode thread of the asynchronous interface
+ *
+ * @par   Description
+ * The thread completes the decode call in progress, if any, and exits.
+ * Buffers still queued are dropped
+ *
+ * @param[in] ps_dec
+ *  Pointer to decoder context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+void ih264d_async_stop(dec_struct_t *ps_dec)
+{
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+
+    if(ps_async->i4_thread_created)
+    {
+        ithread_mutex_lock(ps_async->pv_mutex);
+        ps_async->i4_exit = 1;
+        ithread_cond_broadcast(ps_async->pv_cond);
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        if(0 != ithread_join(ps_async->pv_thread_handle, NULL))
+        {
+            printf("pthread Join Failed");
+            assert(0);
+        }
+
+        ps_async->i4_thread_created = 0;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Queues a bitstream buffer to be decoded
+ *
+ * @par   Description
+ * The buffer holds one or more complete access units, all decoded with the
+ * timestamp it is queued with. Blocks while the app has MAX_ASYNC_INP_BUFS
+ * bitstream buffers outstanding, if asked to, and fails otherwise. A buffer
+ * with u4_is_last set ends the stream, it may be empty. Further buffers are
+ * refused till the decoder is reset. Not supported in shared display buffer
+ * mode
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns error status
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_queue_input(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+    ivd_queue_input_ip_t *ps_ip =
+                    &((ih264d_queue_input_ip_t *)pv_api_ip)->s_ivd_queue_input_ip_t;
+    ivd_queue_input_op_t *ps_op =
+                    &((ih264d_queue_input_op_t *)pv_api_op)->s_ivd_queue_input_op_t;
+    UWORD32 u4_error_code = 0;
+    WORD32 idx;
+
+    ps_op->u4_error_code = 0;
+
+    if((ps_dec->init_done != 1) || ps_dec->u4_share_disp_buf)
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IH264D_ASYNC_INVALID_CALL;
+        return IV_FAIL;
+    }
+
+    if((ps_ip->u4_num_Bytes > 0) && (NULL == ps_ip->pv_stream_buffer))
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IVD_DEC_FRM_BS_BUF_NULL;
+        return IV_FAIL;
+    }
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while(1)
+    {
+        if(ps_async->i4_last_inp_queued || ps_async->i4_eos)
+        {
+            u4_error_code = IH264D_ASYNC_INVALID_CALL;
+            break;
+        }
+
+        if(ps_async->i4_inp_q_cnt + ps_async->i4_inp_done_cnt < MAX_ASYNC_INP_BUFS)
+        {
+            break;
+        }
+
+        if(0 == ps_ip->u4_is_blocking)
+        {
+            u4_error_code = IH264D_QUEUE_FULL;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if((0 == u4_error_code) && (IV_SUCCESS != ih264d_async_launch(dec_hdl)))
+    {
+        u4_error_code = IVD_MEM_ALLOC_FAILED;
+    }
+
+    if(0 == u4_error_code)
+    {
+        idx = (ps_async->i4_inp_q_rd + ps_async->i4_inp_q_cnt) % MAX_ASYNC_INP_BUFS;
+        ps_async->as_inp_q[idx] = *ps_ip;
+        ps_async->i4_inp_q_cnt++;
+
+        if(ps_ip->u4_is_last)
+        {
+            ps_async->i4_last_inp_queued = 1;
+        }
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    if(u4_error_code)
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | u4_error_code;
+        return IV_FAIL;
+    }
+
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns a bitstream buffer the decoder is done with
+ *
+ * @par   Description
+ * Buffers are returned in the order they are queued, along with the bytes
+ * consumed from them. Blocks till a buffer is consumed, if asked to, and
+ * fails otherwise. Fails once the stream has ended and all buffers are
+ * returned
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns error status
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_dequeue_input(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+    ivd_dequeue_input_ip_t *ps_ip =
+                    &((ih264d_dequeue_input_ip_t *)pv_api_ip)->s_ivd_dequeue_input_ip_t;
+    ivd_dequeue_input_op_t *ps_op =
+                    &((ih264d_dequeue_input_op_t *)pv_api_op)->s_ivd_dequeue_input_op_t;
+    UWORD32 u4_size = ps_op->u4_size;
+    UWORD32 u4_error_code = 0;
+
+    memset(ps_op, 0, sizeof(ivd_dequeue_input_op_t));
+    ps_op->u4_size = u4_size;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while(0 == ps_async->i4_inp_done_cnt)
+    {
+        if((0 == ps_ip->u4_is_blocking) || ps_async->i4_eos
+                        || (0 == ps_async->i4_thread_created))
+        {
+            u4_error_code = IH264D_QUEUE_EMPTY;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if(0 == u4_error_code)
+    {
+        *ps_op = ps_async->as_inp_done[ps_async->i4_inp_done_rd];
+        ps_op->u4_size = u4_size;
+        ps_op->u4_error_code = 0;
+
+        ps_async->i4_inp_done_rd = (ps_async->i4_inp_done_rd + 1) % MAX_ASYNC_INP_BUFS;
+        ps_async->i4_inp_done_cnt--;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    if(u4_error_code)
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | u4_error_code;
+        return IV_FAIL;
+    }
+
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Queues an output buffer to be filled
+ *
+ * @par   Description
+ * Blocks while the app has MAX_ASYNC_OUT_BUFS output buffers outstanding, if
+ * asked to, and fails otherwise. Buffers are refused once the stream has
+ * ended. Not supported in shared display buffer mode
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns error status
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_queue_output(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+    ivd_queue_output_ip_t *ps_ip =
+                    &((ih264d_queue_output_ip_t *)pv_api_ip)->s_ivd_queue_output_ip_t;
+    ivd_queue_output_op_t *ps_op =
+                    &((ih264d_queue_output_op_t *)pv_api_op)->s_ivd_queue_output_op_t;
+    ivd_out_bufdesc_t *ps_out_buf = &ps_ip->s_out_buffer;
+    UWORD32 u4_error_code = 0;
+    UWORD32 i;
+    WORD32 idx;
+
+    ps_op->u4_error_code = 0;
+
+    if((ps_dec->init_done != 1) || ps_dec->u4_share_disp_buf)
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IH264D_ASYNC_INVALID_CALL;
+        return IV_FAIL;
+    }
+
+    if((ps_out_buf->u4_num_bufs == 0)
+                    || (ps_out_buf->u4_num_bufs > IVD_VIDDEC_MAX_IO_BUFFERS))
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IVD_DISP_FRM_ZERO_OP_BUFS;
+        return IV_FAIL;
+    }
+
+    for(i = 0; i < ps_out_buf->u4_num_bufs; i++)
+    {
+        if(ps_out_buf->pu1_bufs[i] == NULL)
+        {
+            ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IVD_DISP_FRM_OP_BUF_NULL;
+            return IV_FAIL;
+        }
+
+        if(ps_out_buf->u4_min_out_buf_size[i] == 0)
+        {
+            ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM)
+                            | IVD_DISP_FRM_ZERO_OP_BUF_SIZE;
+            return IV_FAIL;
+        }
+    }
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while(1)
+    {
+        if(ps_async->i4_eos)
+        {
+            u4_error_code = IH264D_ASYNC_INVALID_CALL;
+            break;
+        }
+
+        if(ps_async->i4_out_q_cnt + ps_async->i4_out_busy_cnt
+                        + ps_async->i4_out_done_cnt < MAX_ASYNC_OUT_BUFS)
+        {
+            break;
+        }
+
+        if(0 == ps_ip->u4_is_blocking)
+        {
+            u4_error_code = IH264D_QUEUE_FULL;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if((0 == u4_error_code) && (IV_SUCCESS != ih264d_async_launch(dec_hdl)))
+    {
+        u4_error_code = IVD_MEM_ALLOC_FAILED;
+    }
+
+    if(0 == u4_error_code)
+    {
+        idx = (ps_async->i4_out_q_rd + ps_async->i4_out_q_cnt) % MAX_ASYNC_OUT_BUFS;
+        ps_async->as_out_q[idx] = *ps_out_buf;
+        ps_async->i4_out_q_cnt++;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    if(u4_error_code)
+    {
+        ps_op->u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | u4_error_code;
+        return IV_FAIL;
+    }
+
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns an output buffer filled by the decoder
+ *
+ * @par   Description
+ * Buffers are returned in display order along with the frame written to them.
+ * Once the stream has ended the unused buffers are returned without a frame,
+ * and the last buffer has u4_is_last set. Blocks till a frame is decoded, if
+ * asked to, and fails otherwise. Once all buffers are returned, the call
+ * returns no buffer with u4_is_last set, or fails with the error that ended
+ * the stream if any
+ *
+ * @param[in] dec_hdl
+ *  Decoder handle
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns error status
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_dequeue_output(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)dec_hdl->pv_codec_handle;
+    dec_async_ctxt_t *ps_async = &ps_dec->s_async;
+    ivd_dequeue_output_ip_t *ps_ip =
+                    &((ih264d_dequeue_output_ip_t *)pv_api_ip)->s_ivd_dequeue_output_ip_t;
+    ivd_dequeue_output_op_t *ps_op =
+                    &((ih264d_dequeue_output_op_t *)pv_api_op)->s_ivd_dequeue_output_op_t;
+    UWORD32 u4_size = ps_op->u4_size;
+    UWORD32 u4_error_code = 0;
+
+    memset(ps_op, 0, sizeof(ivd_dequeue_output_op_t));
+    ps_op->u4_size = u4_size;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while(0 == ps_async->i4_out_done_cnt)
+    {
+        if(ps_async->i4_eos)
+        {
+            break;
+        }
+
+        if((0 == ps_ip->u4_is_blocking) || (0 == ps_async->i4_thread_created))
+        {
+            u4_error_code = (1 << IVD_UNSUPPORTEDPARAM) | IH264D_QUEUE_EMPTY;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if(ps_async->i4_out_done_cnt)
+    {
+        *ps_op = ps_async->as_out_done[ps_async->i4_out_done_rd];
+        ps_op->u4_size = u4_size;
+        ps_op->u4_error_code = 0;
+
+        ps_async->i4_out_done_rd = (ps_async->i4_out_done_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        ps_async->i4_out_done_cnt--;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+    else if(ps_async->i4_eos)
+    {
+        ps_op->u4_is_last = 1;
+        u4_error_code = ps_async->u4_error_code;
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    if(u4_error_code)
+    {
+        /* the error that ended the stream carries its severity */
+        ps_op->u4_error_code = u4_error_code;
+        return IV_FAIL;
+    }
+
+    return IV_SUCCESS;
+}
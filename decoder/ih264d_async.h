@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_async.h                                       */
+/*                                                                           */
+/*  Description       : Declarations of the asynchronous (queue / dequeue)   */
+/*                      decode interface                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_ASYNC_H_
+#define _IH264D_ASYNC_H_
+
+/**
+ *******************************************************************************
+ *
+ * @brief Empties the queues of the asynchronous interface
+ *
+ *******************************************************************************
+ */
+void ih264d_async_init(dec_struct_t *ps_dec);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Entry point of the decode thread of the asynchronous interface
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_async_thread(void *pv_dec);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Stops the decode thread of the asynchronous interface, if running
+ *
+ *******************************************************************************
+ */
+void ih264d_async_stop(dec_struct_t *ps_dec);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Queues a bitstream buffer to be decoded (IVD_CMD_QUEUE_INPUT)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_queue_input(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns a consumed bitstream buffer (IVD_CMD_DEQUEUE_INPUT)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_dequeue_input(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Queues an output buffer to be filled (IVD_CMD_QUEUE_OUTPUT)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_queue_output(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns an output buffer in display order (IVD_CMD_DEQUEUE_OUTPUT)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_dequeue_output(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+#endif /* _IH264D_ASYNC_H_ */
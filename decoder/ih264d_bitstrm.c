@@ -114,20 +114,10 @@ UWORD32 ih264d_get_bits_h264(dec_bit_stream_t *ps_bitstrm, UWORD32 u4_num_bits)
  */
 UWORD32 ih264d_next_bits_h264(dec_bit_stream_t *ps_bitstrm, UWORD32 u4_num_bits)
 {
-    UWORD32 u4_word_off = (ps_bitstrm->u4_ofst >> 5);
-    UWORD32 u4_bit_off = ps_bitstrm->u4_ofst & 0x1F;
-    UWORD32 *pu4_bitstream = ps_bitstrm->pu4_buffer;
-    UWORD32 u4_bits = pu4_bitstream[u4_word_off++] << u4_bit_off;
+    UWORD32 u4_bits;
 
-    /*************************************************************************/
-    /* Test if number of bits to be read exceeds the number of bits in the   */
-    /* current word. If yes, read from the next word of the buffer, The bits */
-    /* from both the words are concatenated to get next 32 bits in 'u4_bits' */
-    /*************************************************************************/
-    if(u4_bit_off > (INT_IN_BITS - u4_num_bits))
-        u4_bits |= (pu4_bitstream[u4_word_off] >> (INT_IN_BITS - u4_bit_off));
-
-    return ((u4_bits >> (INT_IN_BITS - u4_num_bits)));
+    NEXTBITS(u4_bits, ps_bitstrm->u4_ofst, ps_bitstrm->pu4_buffer, u4_num_bits);
+    return u4_bits;
 }
 
 /*!
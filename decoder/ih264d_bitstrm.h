@@ -111,18 +111,27 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 
 
 
+/*****************************************************************************/
+/* Define a macro for inlining of NEXTBITS_64: the two words holding the bit */
+/* at u4_offset are read as one 64 bit window, shifted to put that bit at    */
+/* the msb. At least the top 33 bits of the window are valid, so any read of */
+/* up to 32 bits is served by one window, without a branch on the bit offset */
+/*****************************************************************************/
+#define     NEXTBITS_64(u8_window, u4_offset, pu4_bitstream)                \
+{                                                                           \
+    UWORD32 *pu4_win = (pu4_bitstream) + ((u4_offset) >> 5);                \
+    u8_window = ((UWORD64)pu4_win[0] << INT_IN_BITS) | pu4_win[1];          \
+    u8_window <<= ((u4_offset) & 0x1F);                                     \
+}
+
 /*****************************************************************************/
 /* Define a macro for inlining of GETBITS: u4_no_bits shall not exceed 32    */
 /*****************************************************************************/
 #define     GETBITS(u4_code, u4_offset, pu4_bitstream, u4_no_bits)          \
 {                                                                           \
-    UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
-    UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
-    UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
-    u4_code = pu4_buf[u4_word_off++] << u4_bit_off;                         \
-                                                                            \
-    if(u4_bit_off)                                                          \
-        u4_code |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));    \
+    UWORD64 u8_getbits_win;                                                 \
+    NEXTBITS_64(u8_getbits_win, u4_offset, pu4_bitstream);                  \
+    u4_code = (UWORD32)(u8_getbits_win >> INT_IN_BITS);                     \
     u4_code = u4_code >> (INT_IN_BITS - u4_no_bits);                        \
     (u4_offset) += u4_no_bits;                                              \
 }                                                                           \
@@ -133,12 +142,9 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 /*****************************************************************************/
 #define     NEXTBITS(u4_word, u4_offset, pu4_bitstream, u4_no_bits)         \
 {                                                                           \
-    UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
-    UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
-    UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
-    u4_word = pu4_buf[u4_word_off++] << u4_bit_off;                         \
-    if(u4_bit_off)                                                          \
-        u4_word |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));    \
+    UWORD64 u8_nextbits_win;                                                \
+    NEXTBITS_64(u8_nextbits_win, u4_offset, pu4_bitstream);                 \
+    u4_word = (UWORD32)(u8_nextbits_win >> INT_IN_BITS);                    \
     u4_word = u4_word >> (INT_IN_BITS - u4_no_bits);                        \
 }
 /*****************************************************************************/
@@ -146,13 +152,9 @@ UWORD8 ih264d_check_byte_aligned(dec_bit_stream_t * ps_bitstrm);
 /*****************************************************************************/
 #define     NEXTBITS_32(u4_word, u4_offset, pu4_bitstream)                  \
 {                                                                           \
-    UWORD32 *pu4_buf =  (pu4_bitstream);                                    \
-    UWORD32 u4_word_off = ((u4_offset) >> 5);                               \
-    UWORD32 u4_bit_off = (u4_offset) & 0x1F;                                \
-                                                                            \
-    u4_word = pu4_buf[u4_word_off++] << u4_bit_off;                         \
-    if(u4_bit_off)                                                          \
-    u4_word |= (pu4_buf[u4_word_off] >> (INT_IN_BITS - u4_bit_off));        \
+    UWORD64 u8_nextbits_win;                                                \
+    NEXTBITS_64(u8_nextbits_win, u4_offset, pu4_bitstream);                 \
+    u4_word = (UWORD32)(u8_nextbits_win >> INT_IN_BITS);                    \
 }
 
 
@@ -205,9 +205,16 @@ void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t * ps_dec)
         }
     }
 
+    /* The initial states of every (cabac_init_idc, QP) pair are prebuilt, */
+    /* so initialization is a single copy of the matching entry            */
     memcpy(p_cabac_ctxt_table_t,
            gau1_ih264d_cabac_ctxt_init_table[u1_cabac_init_Idc][u1_qp_y],
            NUM_CABAC_CTXTS * sizeof(bin_ctxt_model_t));
+
+    if(ps_dec->s_stats.u4_enable)
+    {
+        ps_dec->s_stats.u4_num_cabac_ctxt_inits++;
+    }
 }
 /*!
  **************************************************************************
@@ -621,70 +628,38 @@ UWORD32 ih264d_decode_bypass_bins_unary(decoding_envirnoment_t *ps_cab_env,
                                         dec_bit_stream_t *ps_bitstrm)
 {
     UWORD32 u4_value;
-    UWORD32 u4_bin;
+    UWORD32 u4_ones, u4_max_bins;
     UWORD32 u4_code_int_val_ofst, u4_code_int_range;
-
-    UWORD32 u1_max_bins;
+    UWORD32 *pu4_buffer, u4_offset;
 
     u4_code_int_val_ofst = ps_cab_env->u4_code_int_val_ofst;
     u4_code_int_range = ps_cab_env->u4_code_int_range;
+    pu4_buffer = ps_bitstrm->pu4_buffer;
+    u4_offset = ps_bitstrm->u4_ofst;
 
-    if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
-    {
-        UWORD32 *pu4_buffer, u4_offset;
-
-        pu4_buffer = ps_bitstrm->pu4_buffer;
-        u4_offset = ps_bitstrm->u4_ofst;
-
-        RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                            pu4_buffer)
-        ps_bitstrm->u4_ofst = u4_offset;
-    }
-
-    /*as it is called only form mvd*/
-    u1_max_bins = 32;
+    /*as it is called only form mvd, at most 32 bins, in batches*/
     u4_value = 0;
 
     do
     {
-        u4_value++;
-
-        u4_code_int_range = u4_code_int_range >> 1;
-        if(u4_code_int_val_ofst >= u4_code_int_range)
-        {
-            /* S=1 */
-            u4_bin = 1;
-            u4_code_int_val_ofst -= u4_code_int_range;
-        }
-        else
-        {
-            /* S=0 */
-            u4_bin = 0;
-        }
+        u4_max_bins = MIN(32 - u4_value, CABAC_BITS_TO_READ);
 
-        INC_BIN_COUNT(ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
+        DECODE_BYPASS_BINS_UNARY_MACRO(u4_ones, u4_max_bins, u4_code_int_range,
+                                       u4_code_int_val_ofst, u4_offset,
+                                       pu4_buffer)
 
-        if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
-        {
-            UWORD32 *pu4_buffer, u4_offset;
-
-            pu4_buffer = ps_bitstrm->pu4_buffer;
-            u4_offset = ps_bitstrm->u4_ofst;
-
-            RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                                pu4_buffer)
-
-            ps_bitstrm->u4_ofst = u4_offset;
-        }
+        INC_BIN_COUNT_BY(ps_cab_env, MIN(u4_ones + 1, u4_max_bins));
+        INC_BYPASS_BINS_BY(ps_cab_env, MIN(u4_ones + 1, u4_max_bins));
 
+        u4_value += u4_ones;
     }
-    while(u4_bin && (u4_value < u1_max_bins));
+    while((u4_ones == u4_max_bins) && (u4_value < 32));
 
     ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
     ps_cab_env->u4_code_int_range = u4_code_int_range;
-    u4_value = (u4_value - 1 + u4_bin);
+    ps_bitstrm->u4_ofst = u4_offset;
 
-return (u4_value);
+    return (u4_value);
 }
 
 /*****************************************************************************/
@@ -714,66 +689,33 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
                                   UWORD8 u1_max_bins,
                                   dec_bit_stream_t *ps_bitstrm)
 {
-    UWORD32 u4_bins;
-    UWORD32 u4_bin;
+    UWORD32 u4_bins, u4_batch, u4_num_bins;
     UWORD32 u4_code_int_val_ofst, u4_code_int_range;
+    UWORD32 *pu4_buffer, u4_offset;
 
     u4_bins = 0;
     u4_code_int_val_ofst = ps_cab_env->u4_code_int_val_ofst;
     u4_code_int_range = ps_cab_env->u4_code_int_range;
+    pu4_buffer = ps_bitstrm->pu4_buffer;
+    u4_offset = ps_bitstrm->u4_ofst;
 
-    if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
+    while(u1_max_bins)
     {
-        UWORD32 *pu4_buffer, u4_offset;
+        u4_num_bins = MIN(u1_max_bins, CABAC_BITS_TO_READ);
 
-        pu4_buffer = ps_bitstrm->pu4_buffer;
-        u4_offset = ps_bitstrm->u4_ofst;
+        DECODE_BYPASS_BINS_MACRO(u4_batch, u4_num_bins, u4_code_int_range,
+                                 u4_code_int_val_ofst, u4_offset, pu4_buffer)
 
-        RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                            pu4_buffer)
-        ps_bitstrm->u4_ofst = u4_offset;
-    }
-
-    do
-    {
-
-        u4_code_int_range = u4_code_int_range >> 1;
-
-        if(u4_code_int_val_ofst >= u4_code_int_range)
-        {
-            /* S=1 */
-            u4_bin = 1;
-            u4_code_int_val_ofst -= u4_code_int_range;
-        }
-        else
-        {
-            /* S=0 */
-            u4_bin = 0;
-        }
-
-        INC_BIN_COUNT(ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
-
-        u4_bins = ((u4_bins << 1) | u4_bin);
-        u1_max_bins--;
-
-        if(u4_code_int_range < ONE_RIGHT_SHIFTED_BY_9)
-        {
-            UWORD32 *pu4_buffer, u4_offset;
-
-            pu4_buffer = ps_bitstrm->pu4_buffer;
-            u4_offset = ps_bitstrm->u4_ofst;
-
-            RENORM_RANGE_OFFSET(u4_code_int_range, u4_code_int_val_ofst, u4_offset,
-                                pu4_buffer)
-            ps_bitstrm->u4_ofst = u4_offset;
-        }
+        INC_BIN_COUNT_BY(ps_cab_env, u4_num_bins);
+        INC_BYPASS_BINS_BY(ps_cab_env, u4_num_bins);
 
+        u4_bins = (u4_bins << u4_num_bins) | u4_batch;
+        u1_max_bins -= u4_num_bins;
     }
-    while(u1_max_bins);
 
     ps_cab_env->u4_code_int_val_ofst = u4_code_int_val_ofst;
     ps_cab_env->u4_code_int_range = u4_code_int_range;
+    ps_bitstrm->u4_ofst = u4_offset;
 
     return (u4_bins);
 }
-
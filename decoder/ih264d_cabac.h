@@ -176,6 +176,117 @@ UWORD32 ih264d_decode_bypass_bins(decoding_envirnoment_t *ps_cab_env,
     u4_codeIntValOffset_m = (u4_codeIntValOffset_m << u4_clz_m) | read_bits_m;              \
   }
 
+/*****************************************************************************/
+/* Defining a macro for decoding several bypass bins at once                 */
+/*****************************************************************************/
+
+/* Batches are decoded with a division. 32 bit ARM cores without a hardware
+ divider would turn it into a library call, so there the bins of a batch are
+ decoded one at a time */
+#ifndef CABAC_BYPASS_DIV
+#if defined(__arm__) && !defined(__ARM_FEATURE_IDIV) && !defined(__ARM_ARCH_EXT_IDIV__)
+#define CABAC_BYPASS_DIV 0
+#else
+#define CABAC_BYPASS_DIV 1
+#endif
+#endif
+
+/* The range keeps at most 9 significant bits, so with k bits read ahead its
+ low k bits are zero, and halving it k times is exact. Decoding k bypass bins
+ one by one is then a long division: the bins, msb first, are the quotient of
+ the offset by range >> k, and the new offset is the remainder. One division
+ replaces k compares with unpredictable outcomes. The offset register holds
+ CABAC_BITS_TO_READ bits read ahead, so that many bins are decoded per
+ renormalization; u4_num_bins_m shall be from 1 to CABAC_BITS_TO_READ */
+
+/* Unary bypass bins: up to u4_max_bins_m bins are decoded as above, the ones
+ before the first zero are counted, and only the bins up to and including
+ that zero are consumed, all u4_max_bins_m of them if no zero is found */
+
+#if CABAC_BYPASS_DIV
+
+#define DECODE_BYPASS_BINS_MACRO(u4_bins_m,u4_num_bins_m,u4_codeIntRange_m,                 \
+                                 u4_codeIntValOffset_m,u4_offset_m,pu4_buffer_m)            \
+  {                                                                                         \
+    UWORD32 u4_scaled_range_m;                                                              \
+    if(u4_codeIntRange_m < (1U << (8 + (u4_num_bins_m))))                                   \
+    {                                                                                       \
+        RENORM_RANGE_OFFSET(u4_codeIntRange_m,u4_codeIntValOffset_m,u4_offset_m,            \
+                            pu4_buffer_m)                                                   \
+    }                                                                                       \
+    u4_scaled_range_m = u4_codeIntRange_m >> (u4_num_bins_m);                               \
+    u4_bins_m = u4_codeIntValOffset_m / u4_scaled_range_m;                                  \
+    u4_codeIntValOffset_m -= u4_bins_m * u4_scaled_range_m;                                 \
+    u4_codeIntRange_m = u4_scaled_range_m;                                                  \
+  }
+
+#define DECODE_BYPASS_BINS_UNARY_MACRO(u4_ones_m,u4_max_bins_m,                             \
+                                       u4_codeIntRange_m,u4_codeIntValOffset_m,             \
+                                       u4_offset_m,pu4_buffer_m)                            \
+  {                                                                                         \
+    UWORD32 u4_scaled_range_m, u4_quot_m, u4_num_bins_m;                                    \
+    if(u4_codeIntRange_m < (1U << (8 + (u4_max_bins_m))))                                   \
+    {                                                                                       \
+        RENORM_RANGE_OFFSET(u4_codeIntRange_m,u4_codeIntValOffset_m,u4_offset_m,            \
+                            pu4_buffer_m)                                                   \
+    }                                                                                       \
+    u4_scaled_range_m = u4_codeIntRange_m >> (u4_max_bins_m);                               \
+    u4_quot_m = u4_codeIntValOffset_m / u4_scaled_range_m;                                  \
+    u4_ones_m = CLZ(~(u4_quot_m << (32 - (u4_max_bins_m))));                                \
+    u4_num_bins_m = MIN(u4_ones_m + 1, (u4_max_bins_m));                                    \
+    u4_scaled_range_m = u4_codeIntRange_m >> u4_num_bins_m;                                 \
+    u4_codeIntValOffset_m -= (u4_quot_m >> ((u4_max_bins_m) - u4_num_bins_m))               \
+                    * u4_scaled_range_m;                                                    \
+    u4_codeIntRange_m = u4_scaled_range_m;                                                  \
+  }
+
+#else /* CABAC_BYPASS_DIV */
+
+#define DECODE_BYPASS_BINS_MACRO(u4_bins_m,u4_num_bins_m,u4_codeIntRange_m,                 \
+                                 u4_codeIntValOffset_m,u4_offset_m,pu4_buffer_m)            \
+  {                                                                                         \
+    UWORD32 u4_bin_cnt_m;                                                                   \
+    if(u4_codeIntRange_m < (1U << (8 + (u4_num_bins_m))))                                   \
+    {                                                                                       \
+        RENORM_RANGE_OFFSET(u4_codeIntRange_m,u4_codeIntValOffset_m,u4_offset_m,            \
+                            pu4_buffer_m)                                                   \
+    }                                                                                       \
+    u4_bins_m = 0;                                                                          \
+    for(u4_bin_cnt_m = 0; u4_bin_cnt_m < (u4_num_bins_m); u4_bin_cnt_m++)                   \
+    {                                                                                       \
+        u4_codeIntRange_m = u4_codeIntRange_m >> 1;                                         \
+        u4_bins_m = u4_bins_m << 1;                                                         \
+        if(u4_codeIntValOffset_m >= u4_codeIntRange_m)                                      \
+        {                                                                                   \
+            u4_bins_m |= 1;                                                                 \
+            u4_codeIntValOffset_m -= u4_codeIntRange_m;                                     \
+        }                                                                                   \
+    }                                                                                       \
+  }
+
+#define DECODE_BYPASS_BINS_UNARY_MACRO(u4_ones_m,u4_max_bins_m,                             \
+                                       u4_codeIntRange_m,u4_codeIntValOffset_m,             \
+                                       u4_offset_m,pu4_buffer_m)                            \
+  {                                                                                         \
+    if(u4_codeIntRange_m < (1U << (8 + (u4_max_bins_m))))                                   \
+    {                                                                                       \
+        RENORM_RANGE_OFFSET(u4_codeIntRange_m,u4_codeIntValOffset_m,u4_offset_m,            \
+                            pu4_buffer_m)                                                   \
+    }                                                                                       \
+    u4_ones_m = 0;                                                                          \
+    do                                                                                      \
+    {                                                                                       \
+        u4_codeIntRange_m = u4_codeIntRange_m >> 1;                                         \
+        if(u4_codeIntValOffset_m < u4_codeIntRange_m)                                       \
+            break;                                                                          \
+        u4_codeIntValOffset_m -= u4_codeIntRange_m;                                         \
+        u4_ones_m++;                                                                        \
+    }                                                                                       \
+    while(u4_ones_m < (u4_max_bins_m));                                                     \
+  }
+
+#endif /* CABAC_BYPASS_DIV */
+
 /*****************************************************************************/
 /* Defining a macro for checking if the symbol is MPS*/
 /*****************************************************************************/
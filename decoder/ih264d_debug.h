@@ -80,6 +80,8 @@
 #define INC_BIN_COUNT(ps_cab_env)
 #define INC_DECISION_BINS(ps_cab_env)
 #define INC_BYPASS_BINS(ps_cab_env)
+#define INC_BIN_COUNT_BY(ps_cab_env, num_bins)
+#define INC_BYPASS_BINS_BY(ps_cab_env, num_bins)
 #define INC_SYM_COUNT(ps_cab_env)
 #define PRINT_BIN_BIT_RATIO(ps_dec)
 #define RESET_BIN_COUNTS(ps_cab_env)
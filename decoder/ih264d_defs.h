@@ -529,6 +529,28 @@ enum
 #define MAX_CABAC_INIT_IDC        2
 
 #define H264_DEFAULT_NUM_CORES 1
+
+
+/** Stage of a thread waiting on another decoder thread, see ih264d_stats.c */
+#define STATS_STAGE_WAIT IH264D_STATS_NUM_STAGES
+
+/** Stage of a thread outside the decoder */
+#define STATS_STAGE_IDLE (-1)
+
+/** Number of stages timed per thread, including the wait stage */
+#define STATS_NUM_STAGES (IH264D_STATS_NUM_STAGES + 1)
+
+/** Number of threads timed: parse, decode and bs-deblock */
+#define STATS_NUM_THREADS IH264D_STATS_NUM_THREADS
+
+/** Spin rounds on an MB map before a decoder thread blocks on its progress */
+#define MB_MAP_WAIT_SPIN_CNT 8
+
+/** Maximum number of bitstream buffers held by the asynchronous interface */
+#define MAX_ASYNC_INP_BUFS 32
+
+/** Maximum number of output buffers held by the asynchronous interface */
+#define MAX_ASYNC_OUT_BUFS 16
 #define DEFAULT_SEPARATE_PARSE (H264_DEFAULT_NUM_CORES == 2)? 1 :0
 
 /** Maximum number of Slice groups */
@@ -218,5 +218,7 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
 
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma;
 
+    ps_codec->pf_find_nal_escape = ih264d_find_nal_escape_generic;
+
     return;
 }
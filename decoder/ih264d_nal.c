@@ -29,7 +29,10 @@
  *         - AI  19 11 2002  Creation
  **************************************************************************
  */
+#include <string.h>
+
 #include "ih264d_bitstrm.h"
+#include "ih264d_nal.h"
 #include "ih264d_defs.h"
 #include "ih264_typedefs.h"
 #include "ih264_macros.h"
@@ -168,185 +171,436 @@ WORD32 ih264d_get_next_nal_unit(UWORD8 *pu1_buf,
 
 /*!
  **************************************************************************
- * \if Function name : ih264d_process_nal_unit \endif
+ * \if Function name : ih264d_find_nal_escape_generic \endif
  *
  * \brief
- *    This function removes emulation byte "0x03" from bitstream (EBSP to RBSP).
- *    It also converts bytestream format into 32 bit little-endian format.
+ *    This function searches for the first three byte sequence 0x0000xx
+ *    with xx <= 3, that is a start code prefix, an emulation prevention
+ *    byte or a run of zero bytes.
  *
- * \param ps_bitstrm : Poiter to dec_bit_stream_t structure.
- * \param pu1_nal_unit  : Pointer to char buffer of NalUnit.
- * \param u4_numbytes_in_nal_unit : Number bytes in NalUnit buffer.
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_cur_pos : Position the search starts at.
+ * \param u4_max_ofst : Number of bytes in Buffer.
  *
  * \return
- *    Returns number of bytes in RBSP ps_bitstrm.
+ *    Returns the position of the sequence, u4_max_ofst if there is none.
  *
  * \note
- *    This function is same as nal_unit() of 7.3.1. Apart from nal_unit()
- *    implementation it converts char buffer into 32 bit Buffer. This
- *    facilitates efficient access of bitstream. This has been done taking
- *    into account present processor architectures.
+ *    The third byte is tested first; when it is above 3, no sequence can
+ *    start at any of the three positions it belongs to.
  *
  **************************************************************************
  */
-WORD32 ih264d_process_nal_unit(dec_bit_stream_t *ps_bitstrm,
-                            UWORD8 *pu1_nal_unit,
-                            UWORD32 u4_numbytes_in_nal_unit)
+UWORD32 ih264d_find_nal_escape_generic(UWORD8 *pu1_buf,
+                                       UWORD32 u4_cur_pos,
+                                       UWORD32 u4_max_ofst)
 {
-    UWORD32 u4_num_bytes_in_rbsp;
-    UWORD8 u1_cur_byte;
-    WORD32 i = 0;
-    WORD8 c_count;
-    UWORD32 ui_word;
-    UWORD32 *puc_bitstream_buffer = (UWORD32*)pu1_nal_unit;
-    ps_bitstrm->pu4_buffer = puc_bitstream_buffer;
+    while(u4_cur_pos + 2 < u4_max_ofst)
+    {
+        if(pu1_buf[u4_cur_pos + 2] > EMULATION_PREVENTION_BYTE)
+            u4_cur_pos += 3;
+        else if(pu1_buf[u4_cur_pos + 1])
+            u4_cur_pos += 2;
+        else if(pu1_buf[u4_cur_pos])
+            u4_cur_pos += 1;
+        else
+            return u4_cur_pos;
+    }
+    return u4_max_ofst;
+}
 
-    /*--------------------------------------------------------------------*/
-    /* First Byte of the NAL Unit                                         */
-    /*--------------------------------------------------------------------*/
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_pack_rbsp \endif
+ *
+ * \brief
+ *    This function converts the RBSP bytes of a NAL unit into 32 bit
+ *    words and points the bitstream to them.
+ *
+ * \param ps_bitstrm : Poiter to dec_bit_stream_t structure.
+ * \param pu1_rbsp_buf : Buffer with the RBSP bytes.
+ * \param pu1_rbsp_end : End of the RBSP bytes.
+ * \param u4_max_nal_size : Number of bytes of pu1_rbsp_buf less 8.
+ *
+ * \return
+ *    None.
+ *
+ **************************************************************************
+ */
+static void ih264d_pack_rbsp(dec_bit_stream_t *ps_bitstrm,
+                             UWORD8 *pu1_rbsp_buf,
+                             UWORD8 *pu1_rbsp_end,
+                             UWORD32 u4_max_nal_size)
+{
+    UWORD32 *pu4_rbsp = (UWORD32 *)pu1_rbsp_buf;
+    UWORD32 u4_num_bytes_in_rbsp, u4_num_words, u4_pad_end, i;
 
-    ui_word = *pu1_nal_unit++;
+    /* First byte of the NAL unit and two more bytes are always present */
+    while(pu1_rbsp_end < pu1_rbsp_buf + NAL_FIRST_BYTE_SIZE + 2)
+        *pu1_rbsp_end++ = 0;
 
     /*--------------------------------------------------------------------*/
-    /* Convertion of the EBSP to RBSP                                     */
-    /* ie Remove the emulation_prevention_byte [equal to 0x03]            */
+    /* Zero the rest of the last word and the 8 bytes read ahead, then    */
+    /* convert the bytestream into 32 bit words                           */
     /*--------------------------------------------------------------------*/
-    u4_num_bytes_in_rbsp = 0;
-    c_count = 0;
+    u4_num_bytes_in_rbsp = (UWORD32)(pu1_rbsp_end - pu1_rbsp_buf);
+    u4_num_words = (u4_num_bytes_in_rbsp + 3) >> 2;
+    u4_pad_end = MIN((u4_num_words << 2) + 8, u4_max_nal_size + 8);
+    memset(pu1_rbsp_end, 0, u4_pad_end - u4_num_bytes_in_rbsp);
 
-//first iteration
-
-    u1_cur_byte = *pu1_nal_unit++;
-
-    ui_word = ((ui_word << 8) | u1_cur_byte);
-
-    c_count++;
-    if(u1_cur_byte != 0x00)
-        c_count = 0;
-
-//second iteration
+    for(i = 0; i < u4_num_words; i++)
+    {
+        UWORD8 *pu1_word = pu1_rbsp_buf + (i << 2);
 
-    u1_cur_byte = *pu1_nal_unit++;
+        pu4_rbsp[i] = ((UWORD32)pu1_word[0] << 24) | ((UWORD32)pu1_word[1] << 16)
+                        | ((UWORD32)pu1_word[2] << 8) | pu1_word[3];
+    }
 
-    ui_word = ((ui_word << 8) | u1_cur_byte);
-    u4_num_bytes_in_rbsp = 2;
+    ps_bitstrm->pu4_buffer = pu4_rbsp;
+    ps_bitstrm->u4_ofst = 0;
+    ps_bitstrm->u4_max_ofst = (u4_num_bytes_in_rbsp << 3);
+}
 
-    c_count++;
-    if(u1_cur_byte != 0x00)
-        c_count = 0;
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_extract_nal_unit \endif
+ *
+ * \brief
+ *    This function finds the next NAL unit in the bitstream, removes the
+ *    emulation bytes "0x03" from it (EBSP to RBSP) and stores the result
+ *    in 32 bit little-endian format.
+ *
+ * \param ps_bitstrm : Poiter to dec_bit_stream_t structure.
+ * \param pf_find_nal_escape : Search for start codes and emulation bytes.
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_max_ofst : Number of bytes in Buffer.
+ * \param pu1_rbsp_buf : Buffer the RBSP is stored in, with 8 bytes more
+ *                       than u4_max_nal_size.
+ * \param u4_max_nal_size : Number of bytes of the NAL unit to keep.
+ * \param pu4_length_of_start_code : Poiter to length of Start Code.
+ * \param pu4_next_is_aud : Set when the next NAL unit is an AUD.
+ *
+ * \return
+ *    Returns number of bytes in the NAL unit, 0 if there is none.
+ *
+ * \note
+ *    Start code search and emulation byte removal share a single pass:
+ *    bytes between two 0x0000xx sequences are copied as they are, so only
+ *    those sequences are looked at one byte at a time. Apart from the
+ *    number of bytes kept, the result is that of ih264d_find_start_code()
+ *    followed by the EBSP to RBSP conversion of the NAL unit it returns.
+ *
+ **************************************************************************
+ */
+WORD32 ih264d_extract_nal_unit(dec_bit_stream_t *ps_bitstrm,
+                               ih264d_find_nal_escape_ft *pf_find_nal_escape,
+                               UWORD8 *pu1_buf,
+                               UWORD32 u4_max_ofst,
+                               UWORD8 *pu1_rbsp_buf,
+                               UWORD32 u4_max_nal_size,
+                               UWORD32 *pu4_length_of_start_code,
+                               UWORD32 *pu4_next_is_aud)
+{
+    UWORD32 u4_cur_pos, u4_esc_pos, u4_nal_start, u4_nal_end;
+    UWORD32 u4_copy_pos, u4_epb_end, u4_trunc_pos, u4_num_bytes;
+    UWORD8 *pu1_out = pu1_rbsp_buf;
+    UWORD8 u1_byte;
 
-    if(u4_numbytes_in_nal_unit > 2)
+    /*--------------------------------------------------------------------*/
+    /* Find first start code                                              */
+    /*--------------------------------------------------------------------*/
+    u4_cur_pos = 0;
+    u4_nal_start = u4_max_ofst;
+    while(1)
     {
-        i = ((u4_numbytes_in_nal_unit - 3));
+        u4_esc_pos = pf_find_nal_escape(pu1_buf, u4_cur_pos, u4_max_ofst);
+        if(u4_esc_pos == u4_max_ofst)
+            break;
+
+        if(pu1_buf[u4_esc_pos + 2] == 0x01)
+        {
+            u4_nal_start = u4_esc_pos + 3;
+            break;
+        }
+        u4_cur_pos = u4_esc_pos + 1;
     }
+    *pu4_length_of_start_code = u4_nal_start;
 
-    for(; i > 8; i -= 4)
+    /*--------------------------------------------------------------------*/
+    /* Find Next Start Code, copying the bytes before every emulation     */
+    /* byte on the way. Emulation bytes beyond u4_trunc_pos are not       */
+    /* removed as those bytes are not kept                                */
+    /*--------------------------------------------------------------------*/
+    u4_trunc_pos = u4_nal_start + u4_max_nal_size;
+    u4_copy_pos = u4_nal_start;
+    u4_epb_end = 0;
+    u4_cur_pos = u4_nal_start;
+    while(1)
     {
-
-// loop 0
-        u1_cur_byte = *pu1_nal_unit++;
-
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
+        u4_esc_pos = pf_find_nal_escape(pu1_buf, u4_cur_pos, u4_max_ofst);
+        if(u4_esc_pos == u4_max_ofst)
         {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
+            /* Trailing zero bytes of the buffer are not part of the NAL */
+            u4_nal_end = u4_max_ofst;
+            while((u4_nal_end > u4_cur_pos) && (0 == pu1_buf[u4_nal_end - 1]))
+                u4_nal_end--;
+            break;
         }
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-        *puc_bitstream_buffer = ui_word;
-        puc_bitstream_buffer++;
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+        u1_byte = pu1_buf[u4_esc_pos + 2];
+        u4_cur_pos = u4_esc_pos + 3;
 
-// loop 1
-        u1_cur_byte = *pu1_nal_unit++;
+        if(0x01 == u1_byte)
+        {
+            ih264d_check_if_aud(pu1_buf, u4_esc_pos + 2, u4_max_ofst,
+                                pu4_next_is_aud);
+            u4_nal_end = u4_esc_pos;
+            break;
+        }
 
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
+        if(0x00 == u1_byte)
+        {
+            /* A run of zero bytes ends the NAL if a start code or the end */
+            /* of the buffer follows it                                    */
+            while((u4_cur_pos < u4_max_ofst) && (0 == pu1_buf[u4_cur_pos]))
+                u4_cur_pos++;
+
+            if((u4_cur_pos == u4_max_ofst) || (0x01 == pu1_buf[u4_cur_pos]))
+            {
+                if(u4_cur_pos < u4_max_ofst)
+                    ih264d_check_if_aud(pu1_buf, u4_cur_pos, u4_max_ofst,
+                                        pu4_next_is_aud);
+                u4_nal_end = u4_esc_pos;
+                break;
+            }
+
+            /* The first byte of the NAL does not count towards the zeros */
+            /* before an emulation byte, search again from the second one */
+            if(u4_esc_pos == u4_nal_start)
+                u4_cur_pos = u4_nal_start + 1;
+        }
+        else if((EMULATION_PREVENTION_BYTE == u1_byte)
+                        && (u4_esc_pos > u4_nal_start)
+                        && (u4_esc_pos + 2 < u4_trunc_pos))
         {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
+            /* The zeros before an emulation byte never follow another     */
+            /* zero, such a run would have been found as 0x000000 first.   */
+            /* The zeros must follow the first byte of the NAL though      */
+            memcpy(pu1_out, pu1_buf + u4_copy_pos, u4_esc_pos + 2 - u4_copy_pos);
+            pu1_out += u4_esc_pos + 2 - u4_copy_pos;
+            u4_copy_pos = u4_esc_pos + 3;
+            u4_epb_end = u4_copy_pos;
         }
-        ui_word = ((ui_word << 8) | u1_cur_byte);
+    }
 
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+    u4_num_bytes = MIN(u4_nal_end - u4_nal_start, u4_max_nal_size);
+    if(0 == u4_num_bytes)
+        return 0;
 
-// loop 2
-        u1_cur_byte = *pu1_nal_unit++;
+    u4_nal_end = u4_nal_start + u4_num_bytes;
+    memcpy(pu1_out, pu1_buf + u4_copy_pos, u4_nal_end - u4_copy_pos);
+    pu1_out += u4_nal_end - u4_copy_pos;
 
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
-        }
+    /* An emulation byte ending the NAL is replaced by the zero after it */
+    if(u4_epb_end == u4_nal_end)
+        *pu1_out++ = 0;
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
+    ih264d_pack_rbsp(ps_bitstrm, pu1_rbsp_buf, pu1_out, u4_max_nal_size);
 
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+    return (u4_num_bytes);
+}
 
-// loop 3
-        u1_cur_byte = *pu1_nal_unit++;
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_extract_sized_nal_unit \endif
+ *
+ * \brief
+ *    This function reads a NAL unit preceded by its size, removes the
+ *    emulation bytes "0x03" from it (EBSP to RBSP) and stores the result
+ *    in 32 bit little-endian format.
+ *
+ * \param ps_bitstrm : Poiter to dec_bit_stream_t structure.
+ * \param pf_find_nal_escape : Search for start codes and emulation bytes.
+ * \param pu1_buf : Pointer to char buffer which contains bitstream.
+ * \param u4_max_ofst : Number of bytes in Buffer.
+ * \param u4_nal_length_size : Number of bytes of the size, 1, 2 or 4.
+ * \param pu1_rbsp_buf : Buffer the RBSP is stored in, with 8 bytes more
+ *                       than u4_max_nal_size.
+ * \param u4_max_nal_size : Number of bytes of the NAL unit to keep.
+ * \param pu4_bytes_consumed : Number of bytes of the size and NAL unit.
+ * \param pu4_next_is_aud : Set when the next NAL unit is an AUD.
+ *
+ * \return
+ *    Returns number of bytes in the NAL unit, 0 if there is none.
+ *
+ * \note
+ *    The size is trusted, so no start code is searched for. Like the
+ *    trailing zero bytes of a byte stream, zero bytes ending the NAL
+ *    unit are dropped, and a size beyond the end of the buffer is cut
+ *    down to it.
+ *
+ **************************************************************************
+ */
+WORD32 ih264d_extract_sized_nal_unit(dec_bit_stream_t *ps_bitstrm,
+                                     ih264d_find_nal_escape_ft *pf_find_nal_escape,
+                                     UWORD8 *pu1_buf,
+                                     UWORD32 u4_max_ofst,
+                                     UWORD32 u4_nal_length_size,
+                                     UWORD8 *pu1_rbsp_buf,
+                                     UWORD32 u4_max_nal_size,
+                                     UWORD32 *pu4_bytes_consumed,
+                                     UWORD32 *pu4_next_is_aud)
+{
+    UWORD32 u4_cur_pos, u4_esc_pos, u4_nal_start, u4_nal_end;
+    UWORD32 u4_copy_pos, u4_epb_end, u4_nal_size, u4_num_bytes, i;
+    UWORD8 *pu1_out = pu1_rbsp_buf;
+    UWORD8 u1_byte;
 
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
-        {
-            c_count = 0;
-            u1_cur_byte = *pu1_nal_unit++;
-            i--;
-        }
+    if(u4_max_ofst < u4_nal_length_size)
+    {
+        *pu4_bytes_consumed = u4_max_ofst;
+        return 0;
+    }
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
+    u4_nal_size = 0;
+    for(i = 0; i < u4_nal_length_size; i++)
+        u4_nal_size = (u4_nal_size << 8) | pu1_buf[i];
 
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
+    u4_nal_start = u4_nal_length_size;
+    u4_nal_size = MIN(u4_nal_size, u4_max_ofst - u4_nal_start);
+    u4_nal_end = u4_nal_start + u4_nal_size;
+    *pu4_bytes_consumed = u4_nal_end;
 
-        u4_num_bytes_in_rbsp += 4;
+    if(u4_nal_end + u4_nal_length_size < u4_max_ofst)
+        ih264d_check_if_aud(pu1_buf, u4_nal_end + u4_nal_length_size - 1,
+                            u4_max_ofst, pu4_next_is_aud);
 
-    }
+    while((u4_nal_end > u4_nal_start) && (0 == pu1_buf[u4_nal_end - 1]))
+        u4_nal_end--;
 
-    for(; i > 0; i--)
+    u4_num_bytes = MIN(u4_nal_end - u4_nal_start, u4_max_nal_size);
+    if(0 == u4_num_bytes)
+        return 0;
+    u4_nal_end = u4_nal_start + u4_num_bytes;
+
+    /*--------------------------------------------------------------------*/
+    /* Copy the bytes before every emulation byte, same as in             */
+    /* ih264d_extract_nal_unit()                                          */
+    /*--------------------------------------------------------------------*/
+    u4_copy_pos = u4_nal_start;
+    u4_epb_end = 0;
+    u4_cur_pos = u4_nal_start;
+    while(1)
     {
-        u1_cur_byte = *pu1_nal_unit++;
+        u4_esc_pos = pf_find_nal_escape(pu1_buf, u4_cur_pos, u4_nal_end);
+        if(u4_esc_pos == u4_nal_end)
+            break;
 
-        if(c_count == NUM_OF_ZERO_BYTES_BEFORE_START_CODE
-                        && u1_cur_byte == EMULATION_PREVENTION_BYTE)
+        u1_byte = pu1_buf[u4_esc_pos + 2];
+        u4_cur_pos = u4_esc_pos + 3;
+
+        if(0x00 == u1_byte)
+        {
+            while((u4_cur_pos < u4_nal_end) && (0 == pu1_buf[u4_cur_pos]))
+                u4_cur_pos++;
+
+            if(u4_esc_pos == u4_nal_start)
+                u4_cur_pos = u4_nal_start + 1;
+        }
+        else if((EMULATION_PREVENTION_BYTE == u1_byte)
+                        && (u4_esc_pos > u4_nal_start))
         {
-            c_count = 0;
-            i--;
-            u1_cur_byte = *pu1_nal_unit++;
+            memcpy(pu1_out, pu1_buf + u4_copy_pos, u4_esc_pos + 2 - u4_copy_pos);
+            pu1_out += u4_esc_pos + 2 - u4_copy_pos;
+            u4_copy_pos = u4_esc_pos + 3;
+            u4_epb_end = u4_copy_pos;
         }
+    }
+
+    memcpy(pu1_out, pu1_buf + u4_copy_pos, u4_nal_end - u4_copy_pos);
+    pu1_out += u4_nal_end - u4_copy_pos;
+
+    if(u4_epb_end == u4_nal_end)
+        *pu1_out++ = 0;
+
+    ih264d_pack_rbsp(ps_bitstrm, pu1_rbsp_buf, pu1_out, u4_max_nal_size);
+
+    return (u4_num_bytes);
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_parse_avcc \endif
+ *
+ * \brief
+ *    This function reads an AVCDecoderConfigurationRecord (ISO/IEC
+ *    14496-15), the payload of the avcC box of mp4 files.
+ *
+ * \param pu1_avcc : Pointer to the record.
+ * \param u4_avcc_size : Number of bytes in the record.
+ * \param pu1_nals : Buffer of u4_avcc_size bytes the sequence and picture
+ *                   parameter sets are copied to, each preceded by its
+ *                   size in 2 bytes.
+ * \param pu4_nals_size : Number of bytes copied to pu1_nals.
+ * \param pu4_nal_length_size : Size of the length preceding NAL units in
+ *                              the samples.
+ *
+ * \return
+ *    Returns OK on success and NOT_OK if the record is malformed.
+ *
+ **************************************************************************
+ */
+WORD32 ih264d_parse_avcc(UWORD8 *pu1_avcc,
+                         UWORD32 u4_avcc_size,
+                         UWORD8 *pu1_nals,
+                         UWORD32 *pu4_nals_size,
+                         UWORD32 *pu4_nal_length_size)
+{
+    UWORD32 u4_ofst, u4_nals_size, u4_num_ps, u4_ps_size, u4_list;
+
+    /* configurationVersion, profile, compatibility, level, lengthSize */
+    if((u4_avcc_size < 7) || (1 != pu1_avcc[0]))
+        return NOT_OK;
+
+    *pu4_nal_length_size = (pu1_avcc[4] & 0x03) + 1;
+    if(3 == *pu4_nal_length_size)
+        return NOT_OK;
+
+    /* Sequence parameter sets, then picture parameter sets. Each list */
+    /* starts with its count, in 5 bits for the first and 8 bits for   */
+    /* the second; the rest of the record is not needed                */
+    u4_ofst = 5;
+    u4_nals_size = 0;
+    for(u4_list = 0; u4_list < 2; u4_list++)
+    {
+        if(u4_ofst >= u4_avcc_size)
+            return NOT_OK;
 
-        ui_word = ((ui_word << 8) | u1_cur_byte);
-        u4_num_bytes_in_rbsp++;
+        u4_num_ps = pu1_avcc[u4_ofst++];
+        if(0 == u4_list)
+            u4_num_ps &= 0x1F;
 
-        if((u4_num_bytes_in_rbsp & 0x03) == 0x03)
+        while(u4_num_ps--)
         {
-            *puc_bitstream_buffer = ui_word;
-            puc_bitstream_buffer++;
+            if(u4_ofst + 2 > u4_avcc_size)
+                return NOT_OK;
+
+            u4_ps_size = (pu1_avcc[u4_ofst] << 8) | pu1_avcc[u4_ofst + 1];
+            if(u4_ofst + 2 + u4_ps_size > u4_avcc_size)
+                return NOT_OK;
+
+            /* Empty parameter sets are dropped */
+            if(u4_ps_size)
+            {
+                memcpy(pu1_nals + u4_nals_size, pu1_avcc + u4_ofst, u4_ps_size + 2);
+                u4_nals_size += u4_ps_size + 2;
+            }
+            u4_ofst += u4_ps_size + 2;
         }
-        c_count++;
-        if(u1_cur_byte != 0x00)
-            c_count = 0;
-
     }
 
-    *puc_bitstream_buffer = (ui_word
-                    << ((3 - (((u4_num_bytes_in_rbsp << 30) >> 30))) << 3));
-    ps_bitstrm->u4_ofst = 0;
-    ps_bitstrm->u4_max_ofst = ((u4_num_bytes_in_rbsp + NAL_FIRST_BYTE_SIZE) << 3);
-
-    return (u4_num_bytes_in_rbsp);
+    *pu4_nals_size = u4_nals_size;
+    return OK;
 }
 
 
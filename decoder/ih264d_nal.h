@@ -42,9 +42,42 @@
 #include "ih264_platform_macros.h"
 #include "ih264d_bitstrm.h"
 
-WORD32 ih264d_process_nal_unit(dec_bit_stream_t *ps_bitstrm,
-                            UWORD8 *pu1_nal_unit,
-                            UWORD32 u4_numbytes_in_nal_unit);
+/**
+ * Returns the position of the first three byte sequence 0x0000xx with xx less
+ * than or equal to 3 that lies in [u4_cur_pos, u4_max_ofst), or u4_max_ofst
+ * if there is none. These are the sequences a start code search and the
+ * removal of emulation prevention bytes have to look at
+ */
+typedef UWORD32 ih264d_find_nal_escape_ft(UWORD8 *pu1_buf,
+                                          UWORD32 u4_cur_pos,
+                                          UWORD32 u4_max_ofst);
+
+ih264d_find_nal_escape_ft ih264d_find_nal_escape_generic;
+ih264d_find_nal_escape_ft ih264d_find_nal_escape_ssse3;
+ih264d_find_nal_escape_ft ih264d_find_nal_escape_avx2;
+
+WORD32 ih264d_extract_nal_unit(dec_bit_stream_t *ps_bitstrm,
+                               ih264d_find_nal_escape_ft *pf_find_nal_escape,
+                               UWORD8 *pu1_buf,
+                               UWORD32 u4_max_ofst,
+                               UWORD8 *pu1_rbsp_buf,
+                               UWORD32 u4_max_nal_size,
+                               UWORD32 *pu4_length_of_start_code,
+                               UWORD32 *pu4_next_is_aud);
+WORD32 ih264d_extract_sized_nal_unit(dec_bit_stream_t *ps_bitstrm,
+                                     ih264d_find_nal_escape_ft *pf_find_nal_escape,
+                                     UWORD8 *pu1_buf,
+                                     UWORD32 u4_max_ofst,
+                                     UWORD32 u4_nal_length_size,
+                                     UWORD8 *pu1_rbsp_buf,
+                                     UWORD32 u4_max_nal_size,
+                                     UWORD32 *pu4_bytes_consumed,
+                                     UWORD32 *pu4_next_is_aud);
+WORD32 ih264d_parse_avcc(UWORD8 *pu1_avcc,
+                         UWORD32 u4_avcc_size,
+                         UWORD8 *pu1_nals,
+                         UWORD32 *pu4_nals_size,
+                         UWORD32 *pu4_nal_length_size);
 void ih264d_rbsp_to_sodb(dec_bit_stream_t *ps_bitstrm);
 WORD32 ih264d_find_start_code(UWORD8 *pu1_buf,
                               UWORD32 u4_cur_pos,
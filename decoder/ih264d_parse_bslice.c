@@ -56,6 +56,7 @@
 #include "ih264d_mvpred.h"
 #include "ih264d_cabac.h"
 #include "ih264d_utils.h"
+#include "ih264d_stats.h"
 
 void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t * ps_dec);
 
@@ -1172,8 +1173,13 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_bmb(dec_struct_t * ps_dec,
         if(ps_dec->u4_num_cores < 3)
         {
             if(ps_dec->u4_app_disable_deblk_frm == 0)
+            {
+                WORD32 i4_stats_stage = STATS_SWITCH(ps_dec,
+                                IH264D_STATS_THREAD_PARSE, IH264D_STATS_BS_COMPUTE);
                 ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
-                                     (UWORD16)(i >> u1_mbaff));
+                                         (UWORD16)(i >> u1_mbaff));
+                STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
+            }
         }
     }
     return OK;
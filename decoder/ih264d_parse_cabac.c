@@ -292,6 +292,7 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
         {
 
             WORD32 i2_abs_lvl;
+            UWORD32 u4_sign;
             UWORD32 u1_abs_level_equal1 = 1, u1_abs_level_gt1 = 0;
 
             UWORD32 u4_ctx_inc;
@@ -390,132 +391,44 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
 
                     if(ui_prefix == UCOFF_LEVEL)
                     {
-                        UWORD32 ui16_sufS = 0;
-                        UWORD32 u1_max_bins;
-                        UWORD32 u4_value;
-
-                        i2_abs_lvl = UCOFF_LEVEL;
-                        /*inlining ih264d_decode_bypass_bins_unary begins*/
-
-                        {
-                            UWORD32 uc_bin;
-                            UWORD32 bits_to_flush;
-
-
-                            bits_to_flush = 0;
-                            /*renormalize to ensure there 23 bits more in the u4_code_int_val_ofst*/
-                            {
-                                UWORD32 u4_clz, read_bits;
-
-                                u4_clz = CLZ(u4_code_int_range);
-                                FLUSHBITS(u4_offset, u4_clz)
-                                NEXTBITS(read_bits, u4_offset, pu4_buffer, CABAC_BITS_TO_READ)
-                                u4_code_int_range = u4_code_int_range << u4_clz;
-                                u4_code_int_val_ofst = (u4_code_int_val_ofst
-                                                << u4_clz) | read_bits;
-
-                            }
-
-                            do
-                            {
-                                bits_to_flush++;
-
-                                u4_code_int_range = u4_code_int_range >> 1;
-
-                                if(u4_code_int_val_ofst >= u4_code_int_range)
-                                {
-                                    /* S=1 */
-                                    uc_bin = 1;
-                                    u4_code_int_val_ofst -= u4_code_int_range;
-                                }
-                                else
-                                {
-                                    /* S=0 */
-                                    uc_bin = 0;
-                                }
-
-                                INC_BIN_COUNT(
-                                                ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
-
-                            }
-                            while(uc_bin && (bits_to_flush < CABAC_BITS_TO_READ));
-
-                            u4_value = (bits_to_flush - 1);
-
-                        }
-                        /*inlining ih264d_decode_bypass_bins_unary ends*/
-
-                        ui16_sufS = (1 << u4_value);
-                        u1_max_bins = u4_value;
-
-                        if(u4_value > 0)
-                        {
-
-                            /*inline bypassbins_flc begins*/
-
-                            if(u4_value > 10)
-                            {
-                                UWORD32 u4_clz, read_bits;
-
-                                u4_clz = CLZ(u4_code_int_range);
-                                FLUSHBITS(u4_offset, u4_clz)
-                                NEXTBITS(read_bits, u4_offset, pu4_buffer, CABAC_BITS_TO_READ)
-                                u4_code_int_range = u4_code_int_range << u4_clz;
-                                u4_code_int_val_ofst = (u4_code_int_val_ofst
-                                                << u4_clz) | read_bits;
-                            }
-
-                            {
-                                UWORD32 ui_bins;
-                                UWORD32 uc_bin;
-                                UWORD32 bits_to_flush;
-
-                                ui_bins = 0;
-                                bits_to_flush = 0;
-
-                                do
-                                {
-                                    bits_to_flush++;
-
-                                    u4_code_int_range = u4_code_int_range >> 1;
-
-                                    if(u4_code_int_val_ofst
-                                                    >= u4_code_int_range)
-                                    {
-                                        /* S=1 */
-                                        uc_bin = 1;
-                                        u4_code_int_val_ofst -=
-                                                        u4_code_int_range;
-                                    }
-                                    else
-                                    {
-                                        /* S=0 */
-                                        uc_bin = 0;
-                                    }
-
-                                    INC_BIN_COUNT(
-                                                    ps_cab_env);INC_BYPASS_BINS(ps_cab_env);
-
-                                    ui_bins = ((ui_bins << 1) | uc_bin);
-
-                                }
-                                while(bits_to_flush < u1_max_bins);
-
-                                u4_value = ui_bins;
-                            }
-
-                            /*inline bypassbins_flc ends*/
-
-                        }
-
-                        //Value of K
-                        ui16_sufS += u4_value;
-                        i2_abs_lvl += ui16_sufS;
-
+                        UWORD32 u4_ones, u4_bins;
+
+                        /* The suffix is an Exp-Golomb code of order 0, k ones */
+                        /* then a zero, and k bits. The k bits and the sign    */
+                        /* flag after them are decoded as one batch            */
+                        DECODE_BYPASS_BINS_UNARY_MACRO(u4_ones,
+                                                       CABAC_BITS_TO_READ,
+                                                       u4_code_int_range,
+                                                       u4_code_int_val_ofst,
+                                                       u4_offset, pu4_buffer)
+                        INC_BIN_COUNT_BY(ps_cab_env,
+                                         MIN(u4_ones + 1, CABAC_BITS_TO_READ));
+                        INC_BYPASS_BINS_BY(ps_cab_env,
+                                           MIN(u4_ones + 1, CABAC_BITS_TO_READ));
+                        u4_ones = MIN(u4_ones, CABAC_BITS_TO_READ - 1);
+
+                        DECODE_BYPASS_BINS_MACRO(u4_bins, u4_ones + 1,
+                                                 u4_code_int_range,
+                                                 u4_code_int_val_ofst,
+                                                 u4_offset, pu4_buffer)
+                        INC_BIN_COUNT_BY(ps_cab_env, u4_ones + 1);
+                        INC_BYPASS_BINS_BY(ps_cab_env, u4_ones + 1);
+
+                        i2_abs_lvl = UCOFF_LEVEL + (1 << u4_ones)
+                                        + (WORD32)(u4_bins >> 1);
+                        u4_sign = u4_bins & 1;
                     }
                     else
+                    {
                         i2_abs_lvl = 1 + ui_prefix;
 
+                        /* coeff_sign_flag, the regular bins leave a range of */
+                        /* at least 1 << 9                                     */
+                        u4_code_int_range = u4_code_int_range >> 1;
+                        u4_sign = (u4_code_int_val_ofst >= u4_code_int_range);
+                        u4_code_int_val_ofst -= u4_code_int_range & (0 - u4_sign);
+                    }
+
                     if(i2_abs_lvl > 1)
                     {
                         u1_abs_level_gt1++;
@@ -530,19 +443,8 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
 
                     /*u4_ctx_inc = g_table_temp[u1_abs_level_gt1][u1_abs_level_equal1];*/
 
-                    /* encode coeff_sign_flag[i] */
-
-                    {
-                        u4_code_int_range = u4_code_int_range >> 1;
-
-                        if(u4_code_int_val_ofst >= (u4_code_int_range))
-                        {
-                            /* S=1 */
-                            u4_code_int_val_ofst -= u4_code_int_range;
-                            i2_abs_lvl = (-i2_abs_lvl);
-                        }
-
-                    }
+                    /* coeff_sign_flag[i] */
+                    i2_abs_lvl = (i2_abs_lvl ^ -(WORD32)u4_sign) + (WORD32)u4_sign;
                     num_sig_coeffs--;
                     *pi2_coeff_data++ = i2_abs_lvl;
                 }
@@ -772,6 +674,7 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
         /* Decode coeff_abs_level_minus1 and coeff_sign_flag */
         {
             WORD32 i2_abs_lvl;
+            UWORD32 u4_sign;
             UWORD32 u1_abs_level_equal1 = 1, u1_abs_level_gt1 = 0;
 
             UWORD32 u4_ctx_inc;
@@ -858,120 +761,42 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
 
                     if(ui_prefix == UCOFF_LEVEL)
                     {
-                        UWORD32 ui16_sufS = 0;
-                        UWORD32 u1_max_bins;
-                        UWORD32 u4_value;
-
-                        i2_abs_lvl = UCOFF_LEVEL;
-                        /*inlining ih264d_decode_bypass_bins_unary begins*/
-
-                        {
-                            UWORD32 uc_bin;
-                            UWORD32 bits_to_flush;
-
-
-                            bits_to_flush = 0;
-                            /*renormalize to ensure there 23 bits more in the u4_code_int_val_ofst*/
-                            {
-                                UWORD32 u4_clz, read_bits;
-
-                                u4_clz = CLZ(u4_code_int_range);
-                                FLUSHBITS(u4_offset, u4_clz)
-                                NEXTBITS(read_bits, u4_offset, pu4_buffer, CABAC_BITS_TO_READ)
-                                u4_code_int_range = u4_code_int_range << u4_clz;
-                                u4_code_int_val_ofst = (u4_code_int_val_ofst
-                                                << u4_clz) | read_bits;
-                            }
-
-                            do
-                            {
-                                bits_to_flush++;
-
-                                u4_code_int_range = u4_code_int_range >> 1;
-
-                                if(u4_code_int_val_ofst >= u4_code_int_range)
-                                {
-                                    /* S=1 */
-                                    uc_bin = 1;
-                                    u4_code_int_val_ofst -= u4_code_int_range;
-                                }
-                                else
-                                {
-                                    /* S=0 */
-                                    uc_bin = 0;
-                                }
-
-                            }
-                            while(uc_bin && (bits_to_flush < CABAC_BITS_TO_READ));
-
-                            u4_value = (bits_to_flush - 1);
-                        }
-                        /*inlining ih264d_decode_bypass_bins_unary ends*/
-
-                        ui16_sufS = (1 << u4_value);
-                        u1_max_bins = u4_value;
-
-                        if(u4_value > 0)
-                        {
-                            /*inline bypassbins_flc begins*/
-
-                            if(u4_value > 10)
-                            {
-                                UWORD32 u4_clz, read_bits;
-
-                                u4_clz = CLZ(u4_code_int_range);
-                                FLUSHBITS(u4_offset, u4_clz)
-                                NEXTBITS(read_bits, u4_offset, pu4_buffer, CABAC_BITS_TO_READ)
-                                u4_code_int_range = u4_code_int_range << u4_clz;
-                                u4_code_int_val_ofst = (u4_code_int_val_ofst
-                                                << u4_clz) | read_bits;
-                            }
-
-                            {
-                                UWORD32 ui_bins;
-                                UWORD32 uc_bin;
-                                UWORD32 bits_to_flush;
-
-                                ui_bins = 0;
-                                bits_to_flush = 0;
-
-                                do
-                                {
-                                    bits_to_flush++;
-
-                                    u4_code_int_range = u4_code_int_range >> 1;
-
-                                    if(u4_code_int_val_ofst
-                                                    >= u4_code_int_range)
-                                    {
-                                        /* S=1 */
-                                        uc_bin = 1;
-                                        u4_code_int_val_ofst -=
-                                                        u4_code_int_range;
-                                    }
-                                    else
-                                    {
-                                        /* S=0 */
-                                        uc_bin = 0;
-                                    }
-
-                                    ui_bins = ((ui_bins << 1) | uc_bin);
-
-                                }
-                                while(bits_to_flush < u1_max_bins);
-
-                                u4_value = ui_bins;
-                            }
-                            /*inline bypassbins_flc ends*/
-                        }
-
-                        //Value of K
-                        ui16_sufS += u4_value;
-                        i2_abs_lvl += (WORD32)ui16_sufS;
+                        UWORD32 u4_ones, u4_bins;
+
+                        /* The suffix is an Exp-Golomb code of order 0, k ones */
+                        /* then a zero, and k bits. The k bits and the sign    */
+                        /* flag after them are decoded as one batch            */
+                        DECODE_BYPASS_BINS_UNARY_MACRO(u4_ones,
+                                                       CABAC_BITS_TO_READ,
+                                                       u4_code_int_range,
+                                                       u4_code_int_val_ofst,
+                                                       u4_offset, pu4_buffer)
+                        INC_BIN_COUNT_BY(ps_cab_env,
+                                         MIN(u4_ones + 1, CABAC_BITS_TO_READ));
+                        INC_BYPASS_BINS_BY(ps_cab_env,
+                                           MIN(u4_ones + 1, CABAC_BITS_TO_READ));
+                        u4_ones = MIN(u4_ones, CABAC_BITS_TO_READ - 1);
+
+                        DECODE_BYPASS_BINS_MACRO(u4_bins, u4_ones + 1,
+                                                 u4_code_int_range,
+                                                 u4_code_int_val_ofst,
+                                                 u4_offset, pu4_buffer)
+                        INC_BIN_COUNT_BY(ps_cab_env, u4_ones + 1);
+                        INC_BYPASS_BINS_BY(ps_cab_env, u4_ones + 1);
+
+                        i2_abs_lvl = UCOFF_LEVEL + (1 << u4_ones)
+                                        + (WORD32)(u4_bins >> 1);
+                        u4_sign = u4_bins & 1;
                     }
                     else
                     {
                         i2_abs_lvl = 1 + ui_prefix;
+
+                        /* coeff_sign_flag, the regular bins leave a range of */
+                        /* at least 1 << 9                                     */
+                        u4_code_int_range = u4_code_int_range >> 1;
+                        u4_sign = (u4_code_int_val_ofst >= u4_code_int_range);
+                        u4_code_int_val_ofst -= u4_code_int_range & (0 - u4_sign);
                     }
 
                     if(i2_abs_lvl > 1)
@@ -990,18 +815,8 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
 
                     /*u4_ctx_inc = g_table_temp[u1_abs_level_gt1][u1_abs_level_equal1];*/
 
-                    /* encode coeff_sign_flag[i] */
-
-                    {
-                        u4_code_int_range = u4_code_int_range >> 1;
-
-                        if(u4_code_int_val_ofst >= (u4_code_int_range))
-                        {
-                            /* S=1 */
-                            u4_code_int_val_ofst -= u4_code_int_range;
-                            i2_abs_lvl = (-i2_abs_lvl);
-                        }
-                    }
+                    /* coeff_sign_flag[i] */
+                    i2_abs_lvl = (i2_abs_lvl ^ -(WORD32)u4_sign) + (WORD32)u4_sign;
 
                     *pi2_coeff_data++ = i2_abs_lvl;
                     num_sig_coeffs--;
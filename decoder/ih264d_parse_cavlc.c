@@ -78,12 +78,22 @@ UWORD32 ih264d_uev(UWORD32 *pu4_bitstrm_ofst, UWORD32 *pu4_bitstrm_buf)
 {
     UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
     UWORD32 u4_word, u4_ldz;
+    UWORD64 u8_window;
 
     /***************************************************************/
     /* Find leading zeros in next 32 bits                          */
     /***************************************************************/
-    NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+    NEXTBITS_64(u8_window, u4_bitstream_offset, pu4_bitstrm_buf);
+    u4_word = (UWORD32)(u8_window >> INT_IN_BITS);
     u4_ldz = CLZ(u4_word);
+
+    /* Codes of up to 31 bits are taken from the window as they are */
+    if(u4_ldz < 16)
+    {
+        *pu4_bitstrm_ofst = u4_bitstream_offset + 2 * u4_ldz + 1;
+        return ((UWORD32)(u8_window >> (63 - 2 * u4_ldz)) - 1);
+    }
+
     /* Flush the ps_bitstrm */
     u4_bitstream_offset += (u4_ldz + 1);
     /* Read the suffix from the ps_bitstrm */
@@ -123,13 +133,25 @@ WORD32 ih264d_sev(UWORD32 *pu4_bitstrm_ofst, UWORD32 *pu4_bitstrm_buf)
 {
     UWORD32 u4_bitstream_offset = *pu4_bitstrm_ofst;
     UWORD32 u4_word, u4_ldz, u4_abs_val;
+    UWORD64 u8_window;
 
     /***************************************************************/
     /* Find leading zeros in next 32 bits                          */
     /***************************************************************/
-    NEXTBITS_32(u4_word, u4_bitstream_offset, pu4_bitstrm_buf);
+    NEXTBITS_64(u8_window, u4_bitstream_offset, pu4_bitstrm_buf);
+    u4_word = (UWORD32)(u8_window >> INT_IN_BITS);
     u4_ldz = CLZ(u4_word);
 
+    /* Codes of up to 31 bits are taken from the window as they are, */
+    /* the lsb of the code is the sign                               */
+    if(u4_ldz < 16)
+    {
+        u4_word = (UWORD32)(u8_window >> (63 - 2 * u4_ldz));
+        *pu4_bitstrm_ofst = u4_bitstream_offset + 2 * u4_ldz + 1;
+        u4_abs_val = u4_word >> 1;
+        return (u4_word & 0x1) ? (-(WORD32)u4_abs_val) : (WORD32)u4_abs_val;
+    }
+
     /* Flush the ps_bitstrm */
     u4_bitstream_offset += (u4_ldz + 1);
 
@@ -209,20 +231,10 @@ WORD32 ih264d_uvlc(dec_bit_stream_t *ps_bitstrm,
                    UWORD32 u4_bitstrm_ofst,
                    UWORD32 *pu4_bitstrm_buf)
 {
-    UWORD32 word, word2, cur_bit, cur_word, code_val, code_num, clz;
+    UWORD32 word, code_val, code_num, clz;
 
     SWITCHOFFTRACE;
-    cur_bit = u4_bitstrm_ofst & 0x1F;
-    cur_word = u4_bitstrm_ofst >> 5;
-    word = pu4_bitstrm_buf[cur_word];
-    word2 = pu4_bitstrm_buf[cur_word + 1];
-
-    if(cur_bit != 0)
-    {
-        word <<= cur_bit;
-        word2 >>= (32 - cur_bit);
-        word |= word2;
-    }
+    NEXTBITS_32(word, u4_bitstrm_ofst, pu4_bitstrm_buf);
 
     if(u1_flag == TEV && u4_range == 1)
     {
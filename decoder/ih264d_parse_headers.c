@@ -1098,7 +1098,8 @@ WORD32 ih264d_access_unit_delimiter_rbsp(dec_struct_t * ps_dec)
  * \if Function name : ih264d_parse_nal_unit \endif
  *
  * \brief
- *    Decodes NAL unit
+ *    Decodes NAL unit. The RBSP of the NAL unit has been set up in
+ *    ps_dec->ps_bitstrm by ih264d_extract_nal_unit()
  *
  * \return
  *    0 on Success and error code otherwise
@@ -1128,8 +1129,6 @@ WORD32 ih264d_parse_nal_unit(iv_obj_t *dec_hdl,
         if(u4_length)
         {
             ps_dec_op->u4_frame_decoded_flag = 0;
-            ih264d_process_nal_unit(ps_dec->ps_bitstrm, pu1_buf,
-                                    u4_length);
 
             SWITCHOFFTRACE;
             u1_first_byte = ih264d_get_bits_h264(ps_bitstrm, 8);
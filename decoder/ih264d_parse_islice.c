@@ -61,6 +61,7 @@
 #include "assert.h"
 #include "ih264d_utils.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_stats.h"
 
 void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t * ps_dec);
 
@@ -898,8 +899,13 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
         if(ps_dec->u4_num_cores < 3)
         {
             if(ps_dec->u4_app_disable_deblk_frm == 0)
+            {
+                WORD32 i4_stats_stage = STATS_SWITCH(ps_dec,
+                                IH264D_STATS_THREAD_PARSE, IH264D_STATS_BS_COMPUTE);
                 ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
-                                     (UWORD16)(u1_num_mbs >> u1_mbaff));
+                                         (UWORD16)(u1_num_mbs >> u1_mbaff));
+                STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
+            }
         }
         u1_num_mbs++;
 
@@ -1125,8 +1131,13 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
             if(ps_dec->u4_num_cores < 3)
             {
                 if(ps_dec->u4_app_disable_deblk_frm == 0)
+                {
+                    WORD32 i4_stats_stage = STATS_SWITCH(ps_dec,
+                                    IH264D_STATS_THREAD_PARSE, IH264D_STATS_BS_COMPUTE);
                     ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
-                                         (UWORD16)(u1_num_mbs >> u1_mbaff));
+                                             (UWORD16)(u1_num_mbs >> u1_mbaff));
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
+                }
             }
             u1_num_mbs++;
 
@@ -70,6 +70,7 @@
 #include "ih264d_dpb_manager.h"
 #include <assert.h>
 #include "ih264d_parse_islice.h"
+#include "ih264d_stats.h"
 #define RET_LAST_SKIP  0x80000000
 
 WORD32 check_app_out_buf_size(dec_struct_t *ps_dec);
@@ -930,9 +931,12 @@ void ih264d_deblock_picture(void *ptr)
  */
 WORD32 ih264d_deblock_display(dec_struct_t *ps_dec)
 {
-    WORD32 ret;
+    WORD32 ret, i4_stats_stage;
     /* Call deblocking */
+    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                  IH264D_STATS_DEBLOCK);
     ih264d_deblock_picture(ps_dec);
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
 
     ret = ih264d_end_of_pic_dispbuf_mgr(ps_dec);
     if(ret != OK)
@@ -1087,6 +1091,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     UWORD32 u4_temp;
     WORD32 i_temp;
     UWORD32 u4_call_end_of_pic = 0;
+    WORD32 i4_stats_stage;
 
     /* read FirstMbInSlice  and slice type*/
     ps_dec->ps_dpb_cmds->u1_dpb_commands_read_slc = 0;
@@ -1839,6 +1844,8 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     if(ret < 0)
         return ERROR_DBP_MANAGER_T;
 
+    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                  IH264D_STATS_SLICE_PARSE);
     if(u1_slice_type == I_SLICE)
     {
         ps_dec->ps_cur_pic->u4_pack_slc_typ |= I_SLC_BIT;
@@ -1866,6 +1873,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     }
     else
         return ERROR_INV_SLC_TYPE_T;
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
 
     if(ps_dec->u1_slice_header_done)
     {
@@ -58,6 +58,7 @@
 #include "ih264d_parse_islice.h"
 #include "ih264d_process_bslice.h"
 #include "ih264d_process_intra_mb.h"
+#include "ih264d_stats.h"
 
 void ih264d_init_cabac_contexts(UWORD8 u1_slice_type, dec_struct_t * ps_dec);
 
@@ -318,8 +319,13 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t * ps_dec,
         {
 
             if(ps_dec->u4_app_disable_deblk_frm == 0)
+            {
+                WORD32 i4_stats_stage = STATS_SWITCH(ps_dec,
+                                IH264D_STATS_THREAD_PARSE, IH264D_STATS_BS_COMPUTE);
                 ps_dec->pf_compute_bs(ps_dec, ps_cur_mb_info,
-                                     (UWORD16)(i >> u1_mbaff));
+                                         (UWORD16)(i >> u1_mbaff));
+                STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
+            }
         }
     }
 
@@ -348,10 +354,10 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
                                     (ps_dec->u1_B ? B_8x8 : PRED_8x8R0) : -1);
     const UWORD32 u1_ipcm_th = (
                     (u1_slice_type != I_SLICE) ? (ps_dec->u1_B ? 23 : 5) : 0);
+    WORD32 i4_stats_stage;
 
-
-
-
+    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                  IH264D_STATS_RECON);
 
     /* N Mb MC Loop */
     for(i = u1_mb_idx; i < u1_num_mbs; i++)
@@ -467,6 +473,7 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
         ps_dec->u4_deblk_mb_x = ps_cur_mb_info->u2_mbx;
         ps_dec->u4_deblk_mb_y = ps_cur_mb_info->u2_mby;
 
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, IH264D_STATS_DEBLOCK);
         for(j = u1_mb_idx; j < i; j++)
         {
 
@@ -476,6 +483,7 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
 
 
         }
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, IH264D_STATS_RECON);
 
 
 
@@ -511,6 +519,7 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
 
 
     }
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
     return OK;
 }
 
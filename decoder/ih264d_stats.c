@@ -0,0 +1,259 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_stats.c                                       */
+/*                                                                           */
+/*  Description       : Contains functions collecting per stage / per thread */
+/*                      decode statistics. Every decoder thread is in one    */
+/*                      stage at a time, and charges the time since its last */
+/*                      switch to that stage on moving to another one. Each  */
+/*                      thread writes only its own entry, hence no locking   */
+/*                      is needed. Collection is off by default, and costs   */
+/*                      one clock read per switch when on                    */
+/*                                                                           */
+/*  List of Functions : ih264d_stats_switch_stage                            */
+/*          ih264d_stats_decode_start                                        */
+/*          ih264d_stats_decode_end                                          */
+/*          ih264d_set_stats                                                 */
+/*          ih264d_get_stats                                                 */
+/*                                                                           */
+/*  Issues / Problems : None                                                 */
+/*                                                                           */
+/*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+#include "ithread.h"
+#include "ih264d_defs.h"
+#include "ih264d_structs.h"
+#include "ih264d_stats.h"
+
+/**
+ *******************************************************************************
+ *
+ * @brief Charges the time since the last switch to the current stage of a
+ * thread and moves the thread to a new stage
+ *
+ * @param[in] ps_dec
+ *  Pointer to decoder context
+ *
+ * @param[in] i4_thread
+ *  Thread index, IH264D_STATS_THREAD_T
+ *
+ * @param[in] i4_stage
+ *  New stage, IH264D_STATS_STAGE_T, STATS_STAGE_WAIT or STATS_STAGE_IDLE
+ *
+ * @returns Stage the thread was in
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_stats_switch_stage(dec_struct_t *ps_dec,
+                                 WORD32 i4_thread,
+                                 WORD32 i4_stage)
+{
+    dec_thread_stats_t *ps_thread = &ps_dec->s_stats.as_thread[i4_thread];
+    WORD32 i4_prev_stage = ps_thread->i4_stage;
+    UWORD64 u8_now;
+
+    if(i4_stage == i4_prev_stage)
+        return i4_prev_stage;
+
+    u8_now = ithread_get_time_ns();
+    if(STATS_STAGE_IDLE != i4_prev_stage)
+    {
+        ps_thread->au8_stage_ns[i4_prev_stage] += u8_now
+                        - ps_thread->u8_stage_start_ns;
+    }
+    ps_thread->i4_stage = i4_stage;
+    ps_thread->u8_stage_start_ns = u8_now;
+
+    return i4_prev_stage;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Marks the start of a decode call
+ *
+ * @par   Description
+ * Called by the thread calling ih264d_video_decode(), which is the parse
+ * thread. Time till the first slice is parsed is NAL parse time
+ *
+ * @param[in] ps_dec
+ *  Pointer to decoder context
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+void ih264d_stats_decode_start(dec_struct_t *ps_dec)
+{
+    if(0 == ps_dec->s_stats.u4_enable)
+        return;
+
+    ps_dec->s_stats.u8_call_start_ns = ithread_get_time_ns();
+    ih264d_stats_switch_stage(ps_dec, IH264D_STATS_THREAD_PARSE,
+                              IH264D_STATS_NAL_PARSE);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Marks the end of a decode call and counts its output
+ *
+ * @param[in] ps_dec
+ *  Pointer to decoder context
+ *
+ * @param[in] ps_dec_op
+ *  Output of the decode call
+ *
+ * @returns none
+ *
+ *******************************************************************************
+ */
+void ih264d_stats_decode_end(dec_struct_t *ps_dec,
+                             ivd_video_decode_op_t *ps_dec_op)
+{
+    dec_stats_t *ps_stats = &ps_dec->s_stats;
+
+    if(0 == ps_stats->u4_enable)
+        return;
+
+    ih264d_stats_switch_stage(ps_dec, IH264D_STATS_THREAD_PARSE,
+                              STATS_STAGE_IDLE);
+    ps_stats->u8_decode_ns += ps_stats->as_thread[IH264D_STATS_THREAD_PARSE]
+                    .u8_stage_start_ns - ps_stats->u8_call_start_ns;
+    ps_stats->u4_num_decode_calls++;
+    ps_stats->u8_num_bytes += ps_dec_op->u4_num_bytes_consumed;
+    ps_stats->u4_num_pics_decoded += (0 != ps_dec_op->u4_frame_decoded_flag);
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Enables, disables or resets statistics (IH264D_CMD_CTL_SET_STATS)
+ *
+ * @par   Description
+ * Not allowed while the decode thread of the asynchronous interface runs,
+ * hence all decoder threads are outside the decoder here
+ *
+ * @param[in] dec_hdl
+ *  Pointer to codec object at API level
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns IV_SUCCESS
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_set_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_set_stats_ip_t *ps_ip;
+    ih264d_ctl_set_stats_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    dec_stats_t *ps_stats = &ps_dec->s_stats;
+    WORD32 i;
+
+    ps_ip = (ih264d_ctl_set_stats_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_stats_op_t *)pv_api_op;
+
+    if(ps_ip->u4_reset_stats)
+    {
+        memset(ps_stats, 0, sizeof(dec_stats_t));
+    }
+
+    for(i = 0; i < STATS_NUM_THREADS; i++)
+    {
+        ps_stats->as_thread[i].i4_stage = STATS_STAGE_IDLE;
+    }
+    ps_stats->u4_enable = (0 != ps_ip->u4_enable_stats);
+
+    ps_op->u4_error_code = 0;
+    return IV_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns the statistics collected (IH264D_CMD_CTL_GET_STATS)
+ *
+ * @par   Description
+ * Allowed while the decode thread of the asynchronous interface runs. Time in
+ * the stage a thread is in at the moment is not included
+ *
+ * @param[in] dec_hdl
+ *  Pointer to codec object at API level
+ *
+ * @param[in] pv_api_ip
+ *  Pointer to input argument structure
+ *
+ * @param[out] pv_api_op
+ *  Pointer to output argument structure
+ *
+ * @returns IV_SUCCESS
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_get_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_get_stats_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    dec_stats_t *ps_stats = &ps_dec->s_stats;
+    WORD32 i, j;
+    UNUSED(pv_api_ip);
+
+    ps_op = (ih264d_ctl_get_stats_op_t *)pv_api_op;
+
+    ps_op->u4_num_decode_calls = ps_stats->u4_num_decode_calls;
+    ps_op->u4_num_pics_decoded = ps_stats->u4_num_pics_decoded;
+    ps_op->u8_num_bytes = ps_stats->u8_num_bytes;
+    ps_op->u4_num_cabac_ctxt_inits = ps_stats->u4_num_cabac_ctxt_inits;
+    ps_op->u8_decode_ns = ps_stats->u8_decode_ns;
+    memset(ps_op->au8_stage_ns, 0, sizeof(ps_op->au8_stage_ns));
+    memset(ps_op->au8_thread_busy_ns, 0, sizeof(ps_op->au8_thread_busy_ns));
+    memset(ps_op->au8_thread_wait_ns, 0, sizeof(ps_op->au8_thread_wait_ns));
+
+    for(i = 0; i < STATS_NUM_THREADS; i++)
+    {
+        dec_thread_stats_t *ps_thread = &ps_stats->as_thread[i];
+
+        for(j = 0; j < IH264D_STATS_NUM_STAGES; j++)
+        {
+            ps_op->au8_stage_ns[j] += ps_thread->au8_stage_ns[j];
+            ps_op->au8_thread_busy_ns[i] += ps_thread->au8_stage_ns[j];
+        }
+        ps_op->au8_thread_wait_ns[i] +=
+                        ps_thread->au8_stage_ns[STATS_STAGE_WAIT];
+    }
+
+    ps_op->u4_error_code = 0;
+    return IV_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : ih264d_stats.h                                       */
+/*                                                                           */
+/*  Description       : Declarations of the per stage / per thread decode    */
+/*                      statistics (IH264D_CMD_CTL_GET_STATS)                */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _IH264D_STATS_H_
+#define _IH264D_STATS_H_
+
+/**
+ * Moves a thread to a new stage, when statistics are enabled. Evaluates to
+ * the stage the thread was in, which is to be restored with another
+ * STATS_SWITCH once the new stage is done
+ */
+#define STATS_SWITCH(ps_dec, thread, stage)                                   \
+    ((ps_dec)->s_stats.u4_enable ?                                            \
+        ih264d_stats_switch_stage((ps_dec), (thread), (stage)) :              \
+        STATS_STAGE_IDLE)
+
+/**
+ *******************************************************************************
+ *
+ * @brief Charges the time since the last switch to the current stage of a
+ * thread and moves the thread to a new stage
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_stats_switch_stage(dec_struct_t *ps_dec,
+                                 WORD32 i4_thread,
+                                 WORD32 i4_stage);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Marks the start of a decode call
+ *
+ *******************************************************************************
+ */
+void ih264d_stats_decode_start(dec_struct_t *ps_dec);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Marks the end of a decode call and counts its output
+ *
+ *******************************************************************************
+ */
+void ih264d_stats_decode_end(dec_struct_t *ps_dec,
+                             ivd_video_decode_op_t *ps_dec_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Enables, disables or resets statistics (IH264D_CMD_CTL_SET_STATS)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_set_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns the statistics collected (IH264D_CMD_CTL_GET_STATS)
+ *
+ *******************************************************************************
+ */
+WORD32 ih264d_get_stats(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+
+#endif /* _IH264D_STATS_H_ */
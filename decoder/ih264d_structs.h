@@ -25,11 +25,13 @@
 #include "ih264_platform_macros.h"
 #include "iv.h"
 #include "ivd.h"
+#include "ih264d.h"
 
 #include "ih264d_transfer_address.h"
 #include "ih264d_defs.h"
 #include "ih264d_defs.h"
 #include "ih264d_bitstrm.h"
+#include "ih264d_nal.h"
 #include "ih264d_debug.h"
 #include "ih264d_dpb_manager.h"
 /* includes for CABAC */
@@ -670,6 +672,102 @@ typedef struct _dec_slice_struct
     volatile void *pv_tu_coeff_data_start;
 } dec_slice_struct_t;
 
+/**
+ * State of the asynchronous (queue / dequeue) decode interface
+ */
+typedef struct
+{
+    /**
+     * Decode thread handle
+     */
+    void *pv_thread_handle;
+
+    /**
+     * Flag to indicate the decode thread is created
+     */
+    WORD32 i4_thread_created;
+
+    /**
+     * Mutex guarding the queues and flags below
+     */
+    void *pv_mutex;
+
+    /**
+     * Condition signalled on every change of the queues and flags below
+     */
+    void *pv_cond;
+
+    /**
+     * Decoder handle passed to the decode calls
+     */
+    void *pv_dec_hdl;
+
+    /**
+     * Flag to ask the decode thread to exit
+     */
+    WORD32 i4_exit;
+
+    /**
+     * Flag to indicate the last bitstream buffer is queued
+     */
+    WORD32 i4_last_inp_queued;
+
+    /**
+     * Flag to indicate the last bitstream buffer is consumed and the
+     * decoder is being flushed
+     */
+    WORD32 i4_flush;
+
+    /**
+     * Flag to indicate the decoder returned its last output or failed
+     */
+    WORD32 i4_eos;
+
+    /**
+     * Error code of the failed decode call, if any
+     */
+    UWORD32 u4_error_code;
+
+    /**
+     * Bytes of the bitstream buffer at the head of the queue consumed so far
+     */
+    UWORD32 u4_inp_ofst;
+
+    /**
+     * Queued bitstream buffers, the one at the head being decoded
+     */
+    ivd_queue_input_ip_t as_inp_q[MAX_ASYNC_INP_BUFS];
+    WORD32 i4_inp_q_rd;
+    WORD32 i4_inp_q_cnt;
+
+    /**
+     * Consumed bitstream buffers, to be dequeued
+     */
+    ivd_dequeue_input_op_t as_inp_done[MAX_ASYNC_INP_BUFS];
+    WORD32 i4_inp_done_rd;
+    WORD32 i4_inp_done_cnt;
+
+    /**
+     * Queued output buffers
+     */
+    ivd_out_bufdesc_t as_out_q[MAX_ASYNC_OUT_BUFS];
+    WORD32 i4_out_q_rd;
+    WORD32 i4_out_q_cnt;
+
+    /**
+     * Output buffer of the decode call in progress
+     */
+    ivd_out_bufdesc_t s_out_busy;
+    WORD32 i4_out_busy_cnt;
+
+    /**
+     * Output buffers holding frames in display order, to be dequeued
+     */
+    ivd_dequeue_output_op_t as_out_done[MAX_ASYNC_OUT_BUFS];
+    WORD32 i4_out_done_rd;
+    WORD32 i4_out_done_cnt;
+}dec_async_ctxt_t;
+
 /**
  * Structure to hold coefficient info for a 4x4 transform
  */
@@ -703,6 +801,75 @@ typedef struct
     WORD16  ai2_level[64];
 }tu_blk8x8_coeff_data_t;
 
+/**
+ * Time spent by one decoder thread in each stage
+ */
+typedef struct
+{
+    /**
+     * Stage the thread is in, STATS_STAGE_IDLE outside the decoder
+     */
+    WORD32 i4_stage;
+
+    /**
+     * Time at which the thread entered i4_stage
+     */
+    UWORD64 u8_stage_start_ns;
+
+    /**
+     * Time spent in each stage, the last entry is the time spent waiting
+     */
+    UWORD64 au8_stage_ns[STATS_NUM_STAGES];
+}dec_thread_stats_t;
+
+/**
+ * Decode statistics returned by IH264D_CMD_CTL_GET_STATS. Every thread
+ * updates only its own entry of as_thread
+ */
+typedef struct
+{
+    /**
+     * 1 if statistics are being collected
+     */
+    UWORD32 u4_enable;
+
+    /**
+     * Number of decode calls
+     */
+    UWORD32 u4_num_decode_calls;
+
+    /**
+     * Number of pictures decoded
+     */
+    UWORD32 u4_num_pics_decoded;
+
+    /**
+     * Number of bitstream bytes consumed
+     */
+    UWORD64 u8_num_bytes;
+
+    /**
+     * Number of CABAC context initializations
+     */
+    UWORD32 u4_num_cabac_ctxt_inits;
+
+    /**
+     * Wall clock time spent in decode calls
+     */
+    UWORD64 u8_decode_ns;
+
+    /**
+     * Time of the start of the current decode call
+     */
+    UWORD64 u8_call_start_ns;
+
+    /**
+     * Per thread stage times, indexed by IH264D_STATS_THREAD_T and then by
+     * format conversion job
+     */
+    dec_thread_stats_t as_thread[STATS_NUM_THREADS];
+}dec_stats_t;
+
 /** Aggregating structure that is globally available */
 typedef struct _DecStruct
 {
@@ -1261,6 +1428,11 @@ typedef struct _DecStruct
     ivd_get_display_frame_op_t s_disp_op;
     UWORD32 u4_output_present;
 
+    /**
+     * Asynchronous (queue / dequeue) decode interface
+     */
+    dec_async_ctxt_t s_async;
+
     volatile UWORD16 cur_dec_mb_num;
     volatile UWORD16 cur_recon_mb_num;
     volatile UWORD16 u2_cur_mb_addr;
@@ -1272,6 +1444,18 @@ typedef struct _DecStruct
     void *pv_dec_thread_handle;
     volatile UWORD8 *pu1_dec_mb_map;
     volatile UWORD8 *pu1_recon_mb_map;
+
+    /**
+     * Progress posted on every pu1_dec_mb_map update, waited on by the
+     * decode thread
+     */
+    void *pv_dec_mb_progress;
+
+    /**
+     * Progress posted on every pu1_recon_mb_map update, waited on by the
+     * bs / deblock thread
+     */
+    void *pv_recon_mb_progress;
     volatile UWORD16 *pu2_slice_num_map;
     dec_slice_struct_t *ps_dec_slice_buf;
     void *pv_map_ref_idx_to_poc_buf;
@@ -1285,6 +1469,43 @@ typedef struct _DecStruct
     /* 2 first slice not parsed , 1 :first slice parsed , 0 :first valid slice header parsed*/
     UWORD32 u4_first_slice_in_pic;
     UWORD32 u4_num_cores;
+
+    /**
+     * Number of CPUs the decoder threads are pinned to, 0 if not pinned
+     */
+    WORD32 i4_num_affinity_cpus;
+
+    /**
+     * CPUs the decoder threads are pinned to
+     */
+    WORD32 ai4_affinity_cpus[IH264D_MAX_AFFINITY_CPUS];
+
+    /**
+     * Size of the length preceding each NAL unit, 0 for Annex B byte streams
+     */
+    UWORD32 u4_nal_length_size;
+
+    /**
+     * Parameter sets of the avcC record, each preceded by its size in 2
+     * bytes
+     */
+    UWORD8 *pu1_avcc_nals;
+
+    /**
+     * Number of bytes in pu1_avcc_nals
+     */
+    UWORD32 u4_avcc_nals_size;
+
+    /**
+     * Offset of the next parameter set of the avcC record to be decoded,
+     * u4_avcc_nals_size once all of them are
+     */
+    UWORD32 u4_avcc_nals_ofst;
+
+    /**
+     * Decode statistics
+     */
+    dec_stats_t s_stats;
     IVD_ARCH_T e_processor_arch;
     IVD_SOC_T e_processor_soc;
 
@@ -1458,6 +1679,10 @@ typedef struct _DecStruct
      */
     ih264_deblk_chroma_edge_bslt4_ft *pf_deblk_chroma_horz_bslt4;
 
+    /**
+     * search for start codes and emulation prevention bytes in the stream
+     */
+    ih264d_find_nal_escape_ft *pf_find_nal_escape;
 
 } dec_struct_t;
 
@@ -51,7 +51,9 @@
 #include "ih264d_mb_utils.h"
 #include "ih264d_tables.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_utils.h"
 #include "ih264d_defs.h"
+#include "ih264d_stats.h"
 UWORD16 ih264d_update_csbp_8x8(UWORD16 u2_luma_csbp);
 void ih264d_fill_bs2_horz_vert(UWORD32 *pu4_bs, /* Base pointer of BS table */
                                WORD32 u4_left_mb_csbp, /* csbp of left mb */
@@ -339,7 +341,7 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
 
     for(i = 0; i < deblk_mb_grp; i++)
     {
-        WORD32 nop_cnt = 8*128;
+        ithread_wait_state_t s_wait = {0, 0};
         while(u4_check_mb_map == 1)
         {
             u4_mb_num = ps_dec->u4_cur_deblk_mb_num;
@@ -353,15 +355,13 @@ void ih264d_check_mb_map_deblk(dec_struct_t *ps_dec,
             }
             else
             {
-                if(nop_cnt > 0)
+                if(!ithread_progress_spin(ps_dec->pv_recon_mb_progress, &s_wait))
                 {
-                    nop_cnt -= 128;
-                    NOP(128);
-                }
-                else
-                {
-                    nop_cnt = 8*128;
-                    ithread_yield();
+                    /* only the parse thread waits on the MB map here */
+                    WORD32 i4_stats_stage = STATS_SWITCH(ps_dec,
+                                    IH264D_STATS_THREAD_PARSE, STATS_STAGE_WAIT);
+                    ithread_progress_wait(ps_dec->pv_recon_mb_progress, &s_wait);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
                 }
             }
         }
@@ -399,13 +399,14 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     UWORD32 x_offset, y_offset;
     UWORD32 u4_slice_end;
     pad_mgr_t *ps_pad_mgr ;
+    ithread_wait_state_t s_wait = {0, 0};
+    WORD32 i4_stats_stage;
 
     /*check for mb map of first mb in slice to ensure slice header is parsed*/
     while(1)
     {
         UWORD32 u4_mb_num = ps_dec->cur_recon_mb_num;
         UWORD32 u4_cond = 0;
-        WORD32 nop_cnt = 8*128;
 
         CHECK_MB_MAP_BYTE(u4_mb_num, ps_dec->pu1_recon_mb_map, u4_cond);
         if(u4_cond)
@@ -414,10 +415,9 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
         }
         else
         {
-            if(nop_cnt > 0)
+            if(ithread_progress_spin(ps_dec->pv_recon_mb_progress, &s_wait))
             {
-                nop_cnt -= 128;
-                NOP(128);
+                continue;
             }
             else
             {
@@ -428,15 +428,20 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                                     MIN(FMT_CONV_NUM_ROWS,
                                         (ps_dec->s_disp_frame_info.u4_y_ht
                                                         - ps_dec->u4_fmt_conv_cur_row));
+                    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                                  IH264D_STATS_FMT_CONV);
                     ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                           ps_dec->u4_fmt_conv_cur_row,
                                           ps_dec->u4_fmt_conv_num_rows);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
                     ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
                 }
                 else
                 {
-                    nop_cnt = 8*128;
-                    ithread_yield();
+                    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                                  STATS_STAGE_WAIT);
+                    ithread_progress_wait(ps_dec->pv_recon_mb_progress, &s_wait);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
                 }
             }
             DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
@@ -512,7 +517,8 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     while(u4_slice_end != 1)
     {
         WORD32 recon_mb_grp,bs_mb_grp;
-        WORD32 nop_cnt = 8*128;
+
+        s_wait.i4_spin_cnt = 0;
         u1_num_mbsleft = ((i2_pic_wdin_mbs - i16_mb_x) << u1_mbaff);
         if(u1_num_mbsleft <= ps_dec->u1_recon_mb_grp)
         {
@@ -547,10 +553,9 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
             }
             else
             {
-                if(nop_cnt > 0)
+                if(ithread_progress_spin(ps_dec->pv_recon_mb_progress, &s_wait))
                 {
-                    nop_cnt -= 128;
-                    NOP(128);
+                    continue;
                 }
                 else
                 {
@@ -561,20 +566,27 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                                         MIN(FMT_CONV_NUM_ROWS,
                                             (ps_dec->s_disp_frame_info.u4_y_ht
                                                             - ps_dec->u4_fmt_conv_cur_row));
+                        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                                      IH264D_STATS_FMT_CONV);
                         ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                               ps_dec->u4_fmt_conv_cur_row,
                                               ps_dec->u4_fmt_conv_num_rows);
+                        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
                         ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
                     }
                     else
                     {
-                        nop_cnt = 8*128;
-                        ithread_yield();
+                        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                                      STATS_STAGE_WAIT);
+                        ithread_progress_wait(ps_dec->pv_recon_mb_progress, &s_wait);
+                        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
                     }
                 }
             }
         }
 
+        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                      IH264D_STATS_RECON);
         for(j = 0; j < recon_mb_grp; j++)
         {
             GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, ps_dec->cur_recon_mb_num,
@@ -606,6 +618,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
             }
             ps_dec->cur_recon_mb_num++;
         }
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
 
         if(j != recon_mb_grp)
         {
@@ -679,7 +692,10 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
             else
                 u4_num_mbs = 0;
 
+            i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                          IH264D_STATS_DEBLOCK);
             ih264d_check_mb_map_deblk(ps_dec, u4_num_mbs, ps_tfr_cxt,0);
+            STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
         }
 
     }
@@ -692,8 +708,11 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
 
 
     UWORD32 yield_cnt = 0;
+    WORD32 i4_stats_stage;
 
     ithread_set_name("ih264d_recon_deblk_thread");
+    ih264d_set_thread_affinity(ps_dec, 2);
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, IH264D_STATS_BS_COMPUTE);
 
     while(1)
     {
@@ -723,15 +742,16 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
         ps_dec->u4_fmt_conv_num_rows =
                         (ps_dec->s_disp_frame_info.u4_y_ht
                                         - ps_dec->u4_fmt_conv_cur_row);
+        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK,
+                                      IH264D_STATS_FMT_CONV);
         ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                               ps_dec->u4_fmt_conv_cur_row,
                               ps_dec->u4_fmt_conv_num_rows);
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, i4_stats_stage);
         ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
 
     }
-
-
-
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_BS_DEBLK, STATS_STAGE_IDLE);
 }
 
 
@@ -50,6 +50,8 @@
 #include "ih264d_process_intra_mb.h"
 #include "ih264d_deblocking.h"
 #include "ih264d_format_conv.h"
+#include "ih264d_utils.h"
+#include "ih264d_stats.h"
 
 void ih264d_deblock_mb_level(dec_struct_t *ps_dec,
                              dec_mb_info_t *ps_cur_mb_info,
@@ -93,6 +95,7 @@ void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
 
             u4_mb_num++;
         }
+        ithread_progress_post(ps_dec->pv_dec_mb_progress);
 
         /****************************************************************/
         /* Check for End Of Row in Next iteration                       */
@@ -213,7 +216,8 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     UWORD16 u2_slice_num,u2_cur_dec_mb_num;
     WORD32 ret;
     UWORD32 u4_mb_num;
-    WORD32 nop_cnt = 8*128;
+    ithread_wait_state_t s_wait = {0, 0};
+    WORD32 i4_stats_stage;
     u1_slice_type = ps_dec->ps_decode_cur_slice->slice_type;
 
     u1_B = (u1_slice_type == B_SLICE);
@@ -240,10 +244,9 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
         }
         else
         {
-            if(nop_cnt > 0)
+            if(ithread_progress_spin(ps_dec->pv_dec_mb_progress, &s_wait))
             {
-                nop_cnt -= 128;
-                NOP(128);
+                continue;
             }
             else
             {
@@ -254,15 +257,20 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                                 MIN(FMT_CONV_NUM_ROWS,
                                     (ps_dec->s_disp_frame_info.u4_y_ht
                                                     - ps_dec->u4_fmt_conv_cur_row));
+                    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                                  IH264D_STATS_FMT_CONV);
                     ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                           ps_dec->u4_fmt_conv_cur_row,
                                           ps_dec->u4_fmt_conv_num_rows);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
                     ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
                 }
                 else
                 {
-                    nop_cnt = 8*128;
-                    ithread_yield();
+                    i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                                  STATS_STAGE_WAIT);
+                    ithread_progress_wait(ps_dec->pv_dec_mb_progress, &s_wait);
+                    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
                 }
             }
         }
@@ -389,6 +397,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
         }
         ps_dec->cur_dec_mb_num++;
      }
+    ithread_progress_post(ps_dec->pv_recon_mb_progress);
 
     /*N MB deblocking*/
     if(ps_dec->u4_nmb_deblk == 1)
@@ -410,6 +419,8 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
         ps_dec->u4_deblk_mb_y = ps_cur_mb_info->u2_mby;
 
 
+        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                      IH264D_STATS_DEBLOCK);
         for(j = 0; j < i; j++)
         {
             ih264d_deblock_mb_nonmbaff(ps_dec, ps_tfr_cxt,
@@ -417,6 +428,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                                         u4_wd_y, u4_wd_uv);
 
         }
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
     }
 
     /*handle the last mb in picture case*/
@@ -448,13 +460,14 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
     WORD32 ret;
 
     tfr_ctxt_t *ps_trns_addr;
+    ithread_wait_state_t s_wait = {0, 0};
+    WORD32 i4_stats_stage;
 
     /*check for mb map of first mb in slice to ensure slice header is parsed*/
     while(1)
     {
         UWORD32 u4_mb_num = ps_dec->cur_dec_mb_num;
         UWORD32 u4_cond = 0;
-        WORD32 nop_cnt = 8 * 128;
         CHECK_MB_MAP_BYTE(u4_mb_num, ps_dec->pu1_dec_mb_map, u4_cond);
         if(u4_cond)
         {
@@ -462,10 +475,9 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
         }
         else
         {
-            if(nop_cnt > 0)
+            if(ithread_progress_spin(ps_dec->pv_dec_mb_progress, &s_wait))
             {
-                nop_cnt -= 128;
-                NOP(128);
+                continue;
             }
             else if(ps_dec->u4_output_present && (2 == ps_dec->u4_num_cores) &&
                (ps_dec->u4_fmt_conv_cur_row < ps_dec->s_disp_frame_info.u4_y_ht))
@@ -474,15 +486,20 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
                                 MIN(FMT_CONV_NUM_ROWS,
                                     (ps_dec->s_disp_frame_info.u4_y_ht
                                                     - ps_dec->u4_fmt_conv_cur_row));
+                i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                              IH264D_STATS_FMT_CONV);
                 ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                                       ps_dec->u4_fmt_conv_cur_row,
                                       ps_dec->u4_fmt_conv_num_rows);
+                STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
                 ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
             }
             else
             {
-                nop_cnt = 8*128;
-                ithread_yield();
+                i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                              STATS_STAGE_WAIT);
+                ithread_progress_wait(ps_dec->pv_dec_mb_progress, &s_wait);
+                STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
             }
             DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
                             ps_dec->u2_cur_mb_addr);
@@ -592,7 +609,11 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
 
 void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
 {
+    WORD32 i4_stats_stage;
+
     ithread_set_name("ih264d_decode_picture_thread");
+    ih264d_set_thread_affinity(ps_dec, 1);
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, IH264D_STATS_RECON);
     while(1)
     {
         /*Complete all writes before processing next slice*/
@@ -622,18 +643,25 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
         ps_dec->u4_fmt_conv_num_rows =
                         (ps_dec->s_disp_frame_info.u4_y_ht
                                         - ps_dec->u4_fmt_conv_cur_row);
+        i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE,
+                                      IH264D_STATS_FMT_CONV);
         ih264d_format_convert(ps_dec, &(ps_dec->s_disp_op),
                               ps_dec->u4_fmt_conv_cur_row,
                               ps_dec->u4_fmt_conv_num_rows);
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, i4_stats_stage);
         ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
     }
+    STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_DECODE, STATS_STAGE_IDLE);
 }
 
 void ih264d_signal_decode_thread(dec_struct_t *ps_dec)
 {
     if(ps_dec->u4_dec_thread_created == 1)
     {
+        WORD32 i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                             STATS_STAGE_WAIT);
         ithread_join(ps_dec->pv_dec_thread_handle, NULL);
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
         ps_dec->u4_dec_thread_created = 0;
     }
 }
@@ -641,7 +669,10 @@ void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec)
 {
     if(ps_dec->u4_bs_deblk_thread_created)
     {
+        WORD32 i4_stats_stage = STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE,
+                                             STATS_STAGE_WAIT);
         ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
+        STATS_SWITCH(ps_dec, IH264D_STATS_THREAD_PARSE, i4_stats_stage);
         ps_dec->u4_bs_deblk_thread_created = 0;
     }
 
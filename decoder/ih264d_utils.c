@@ -2349,3 +2349,33 @@ void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
 
     }
 }
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_set_thread_affinity                               */
+/*                                                                           */
+/*  Description   : Pins the calling decoder thread to one CPU of the CPU    */
+/*                  set given by IH264D_CMD_CTL_SET_CPU_AFFINITY, round      */
+/*                  robin on the thread index. Buffers first touched by the  */
+/*                  thread are hence placed on the NUMA node of the set. No  */
+/*                  op if no CPU set is given                                */
+/*  Inputs        : ps_dec     - Decoder parameters                          */
+/*                  thread_idx - 0 : parse, 1 : decode, 2 : bs-deblock,      */
+/*                               3 onwards : format conversion               */
+/*  Globals       : None                                                     */
+/*  Outputs       : None                                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_set_thread_affinity(dec_struct_t *ps_dec, WORD32 thread_idx)
+{
+    WORD32 num_cpus = ps_dec->i4_num_affinity_cpus;
+
+    if(num_cpus > 0)
+    {
+        ithread_set_affinity_list(&ps_dec->ai4_affinity_cpus[thread_idx % num_cpus],
+                                  1);
+    }
+}
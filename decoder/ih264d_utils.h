@@ -99,4 +99,5 @@ WORD32 ih264d_get_next_nal_unit(UWORD8 *pu1_buf,
                                 UWORD32 *pu4_length_of_start_code);
 
 WORD16 ih264d_free_dynamic_bufs(dec_struct_t * ps_dec);
+void ih264d_set_thread_affinity(dec_struct_t *ps_dec, WORD32 thread_idx);
 #endif /* _IH264D_UTILS_H_ */
@@ -134,7 +134,11 @@ typedef enum {
     IVD_CMD_VIDEO_DECODE,
     IVD_CMD_GET_DISPLAY_FRAME,
     IVD_CMD_REL_DISPLAY_FRAME,
-    IVD_CMD_SET_DISPLAY_FRAME
+    IVD_CMD_SET_DISPLAY_FRAME,
+    IVD_CMD_QUEUE_INPUT,
+    IVD_CMD_DEQUEUE_INPUT,
+    IVD_CMD_QUEUE_OUTPUT,
+    IVD_CMD_DEQUEUE_OUTPUT
 }IVD_API_COMMAND_TYPE_T;
 
 /* IVD_CONTROL_API_COMMAND_TYPE_T: Video Control API command type            */
@@ -489,6 +493,276 @@ typedef struct{
 }ivd_video_decode_op_t;
 
 
+/*****************************************************************************/
+/*   Queue Input                                                             */
+/*****************************************************************************/
+
+
+/* IVD_API_COMMAND_TYPE_T::e_cmd = IVD_CMD_QUEUE_INPUT                       */
+
+
+typedef struct {
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd
+     */
+    IVD_API_COMMAND_TYPE_T                  e_cmd;
+
+    /**
+     * u4_ts
+     */
+    UWORD32                                 u4_ts;
+
+    /**
+     * u4_num_Bytes
+     */
+    UWORD32                                 u4_num_Bytes;
+
+    /**
+     * pv_stream_buffer, holds one or more complete access units
+     */
+    void                                    *pv_stream_buffer;
+
+    /**
+     * Flag to indicate the last bitstream buffer of the stream, which may
+     * be empty
+     */
+    UWORD32                                 u4_is_last;
+
+    /**
+     * Flag to block till the buffer can be queued
+     */
+    UWORD32                                 u4_is_blocking;
+
+}ivd_queue_input_ip_t;
+
+
+typedef struct{
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+
+}ivd_queue_input_op_t;
+
+
+/*****************************************************************************/
+/*   Dequeue Input                                                           */
+/*****************************************************************************/
+
+
+/* IVD_API_COMMAND_TYPE_T::e_cmd = IVD_CMD_DEQUEUE_INPUT                     */
+
+
+typedef struct {
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd
+     */
+    IVD_API_COMMAND_TYPE_T                  e_cmd;
+
+    /**
+     * Flag to block till a bitstream buffer is returned
+     */
+    UWORD32                                 u4_is_blocking;
+
+}ivd_dequeue_input_ip_t;
+
+
+typedef struct{
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+
+    /**
+     * u4_ts
+     */
+    UWORD32                                 u4_ts;
+
+    /**
+     * u4_num_Bytes
+     */
+    UWORD32                                 u4_num_Bytes;
+
+    /**
+     * pv_stream_buffer
+     */
+    void                                    *pv_stream_buffer;
+
+    /**
+     * num_bytes_consumed
+     */
+    UWORD32                                 u4_num_bytes_consumed;
+
+    /**
+     * Flag to indicate the last bitstream buffer of the stream
+     */
+    UWORD32                                 u4_is_last;
+
+}ivd_dequeue_input_op_t;
+
+
+/*****************************************************************************/
+/*   Queue Output                                                            */
+/*****************************************************************************/
+
+
+/* IVD_API_COMMAND_TYPE_T::e_cmd = IVD_CMD_QUEUE_OUTPUT                      */
+
+
+typedef struct {
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd
+     */
+    IVD_API_COMMAND_TYPE_T                  e_cmd;
+
+    /**
+     * output buffer desc
+     */
+    ivd_out_bufdesc_t                       s_out_buffer;
+
+    /**
+     * Flag to block till the buffer can be queued
+     */
+    UWORD32                                 u4_is_blocking;
+
+}ivd_queue_output_ip_t;
+
+
+typedef struct{
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+
+}ivd_queue_output_op_t;
+
+
+/*****************************************************************************/
+/*   Dequeue Output                                                          */
+/*****************************************************************************/
+
+
+/* IVD_API_COMMAND_TYPE_T::e_cmd = IVD_CMD_DEQUEUE_OUTPUT                    */
+
+
+typedef struct {
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * e_cmd
+     */
+    IVD_API_COMMAND_TYPE_T                  e_cmd;
+
+    /**
+     * Flag to block till an output buffer is returned
+     */
+    UWORD32                                 u4_is_blocking;
+
+}ivd_dequeue_output_ip_t;
+
+
+typedef struct{
+    /**
+     * u4_size of the structure
+     */
+    UWORD32                                 u4_size;
+
+    /**
+     * u4_error_code
+     */
+    UWORD32                                 u4_error_code;
+
+    /**
+     * output buffer desc
+     */
+    ivd_out_bufdesc_t                       s_out_buffer;
+
+    /**
+     * output_present
+     */
+    UWORD32                                 u4_output_present;
+
+    /**
+     * pic_wd
+     */
+    UWORD32                                 u4_pic_wd;
+
+    /**
+     * pic_ht
+     */
+    UWORD32                                 u4_pic_ht;
+
+    /**
+     * progressive_frame_flag
+     */
+    UWORD32                                 u4_progressive_frame_flag;
+
+    /**
+     * output_format
+     */
+    IV_COLOR_FORMAT_T                       e_output_format;
+
+    /**
+     * disp_frm_buf
+     */
+    iv_yuv_buf_t                            s_disp_frm_buf;
+
+    /**
+     * fld_type
+     */
+    IV_FLD_TYPE_T                           e4_fld_type;
+
+    /**
+     * ts
+     */
+    UWORD32                                 u4_ts;
+
+    /**
+     * disp_buf_id
+     */
+    UWORD32                                 u4_disp_buf_id;
+
+    /**
+     * Flag to indicate the last output buffer of the stream
+     */
+    UWORD32                                 u4_is_last;
+
+}ivd_dequeue_output_op_t;
+
+
 /*****************************************************************************/
 /*   Get Display Frame                                                       */
 /*****************************************************************************/
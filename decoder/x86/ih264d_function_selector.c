@@ -55,9 +55,50 @@
 
 #include "ih264d_structs.h"
 #include "ih264d_function_selector.h"
+#include "ih264_cpu_features.h"
+
+/* Returns the highest x86 path usable on this cpu, capped by DEFAULT_ARCH */
+static IVD_ARCH_T ih264d_get_max_arch(void)
+{
+    UWORD32 u4_features = ih264_get_cpu_features();
+    IVD_ARCH_T e_arch = ARCH_X86_GENERIC;
+
+    if(u4_features & CPU_FEATURE_SSSE3)
+    {
+        e_arch = ARCH_X86_SSSE3;
+        if(u4_features & CPU_FEATURE_SSE42)
+        {
+            e_arch = ARCH_X86_SSE42;
+            if(u4_features & CPU_FEATURE_AVX2)
+                e_arch = ARCH_X86_AVX2;
+        }
+    }
+
+#ifdef DEFAULT_ARCH
+#if DEFAULT_ARCH == D_ARCH_X86_SSE42
+    if(e_arch > ARCH_X86_SSE42)
+        e_arch = ARCH_X86_SSE42;
+#elif DEFAULT_ARCH == D_ARCH_X86_SSSE3
+    if(e_arch > ARCH_X86_SSSE3)
+        e_arch = ARCH_X86_SSSE3;
+#elif DEFAULT_ARCH == D_ARCH_X86_GENERIC
+    e_arch = ARCH_X86_GENERIC;
+#endif
+#endif
+
+    return e_arch;
+}
 
 void ih264d_init_function_ptr(dec_struct_t *ps_codec)
 {
+    IVD_ARCH_T e_max_arch = ih264d_get_max_arch();
+
+    /* Requests for a non x86 or unsupported path fall back to the best one */
+    if((ps_codec->e_processor_arch < ARCH_X86_GENERIC)
+                    || (ps_codec->e_processor_arch > e_max_arch))
+    {
+        ps_codec->e_processor_arch = e_max_arch;
+    }
 
     ih264d_init_function_ptr_generic(ps_codec);
     switch(ps_codec->e_processor_arch)
@@ -69,26 +110,18 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec)
             ih264d_init_function_ptr_ssse3(ps_codec);
             break;
         case ARCH_X86_SSE42:
+            ih264d_init_function_ptr_ssse3(ps_codec);
+            ih264d_init_function_ptr_sse42(ps_codec);
+            break;
+        case ARCH_X86_AVX2:
         default:
             ih264d_init_function_ptr_ssse3(ps_codec);
             ih264d_init_function_ptr_sse42(ps_codec);
+            ih264d_init_function_ptr_avx2(ps_codec);
         break;
     }
 }
 void ih264d_init_arch(dec_struct_t *ps_codec)
 {
-#ifdef DEFAULT_ARCH
-#if DEFAULT_ARCH == D_ARCH_X86_SSE42
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#elif DEFAULT_ARCH == D_ARCH_X86_SSSE3
-    ps_codec->e_processor_arch = ARCH_X86_SSSE3;
-#elif DEFAULT_ARCH == D_ARCH_X86_AVX2
-    ps_codec->e_processor_arch = D_ARCH_X86_AVX2;
-#else
-    ps_codec->e_processor_arch = ARCH_X86_GENERIC;
-#endif
-#else
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#endif
-
+    ps_codec->e_processor_arch = ih264d_get_max_arch();
 }
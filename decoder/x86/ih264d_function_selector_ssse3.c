@@ -176,6 +176,7 @@ void ih264d_init_function_ptr_ssse3(dec_struct_t *ps_codec)
 
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma_ssse3;
 
+    ps_codec->pf_find_nal_escape = ih264d_find_nal_escape_ssse3;
 
     return;
 }
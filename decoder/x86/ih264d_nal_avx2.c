@@ -0,0 +1,108 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_nal_avx2.c
+ *
+ * @brief
+ *  Contains the x86 avx2 intrinsic definition of the start code and
+ *  emulation prevention byte search of the NAL parser
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264d_find_nal_escape_avx2
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_nal.h"
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Finds the first three byte sequence 0x0000xx with xx <= 3
+ *
+ * @par Description:
+ *  Same as ih264d_find_nal_escape_ssse3() with 32 positions per iteration
+ *
+ * @param[in] pu1_buf
+ *  Pointer to the bitstream
+ *
+ * @param[in] u4_cur_pos
+ *  Position the search starts at
+ *
+ * @param[in] u4_max_ofst
+ *  Number of bytes in the bitstream
+ *
+ * @returns
+ *  Position of the sequence, u4_max_ofst if there is none
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+AVX2_TARGET UWORD32 ih264d_find_nal_escape_avx2(UWORD8 *pu1_buf,
+                                                UWORD32 u4_cur_pos,
+                                                UWORD32 u4_max_ofst)
+{
+    __m256i zero_32x8b = _mm256_setzero_si256();
+    __m256i three_32x8b = _mm256_set1_epi8(3);
+
+    while(u4_cur_pos + 34 <= u4_max_ofst)
+    {
+        __m256i b0_32x8b, b1_32x8b, b2_32x8b, zeros_32x8b, small_32x8b;
+        UWORD32 u4_mask;
+
+        b0_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_cur_pos));
+        b1_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_cur_pos + 1));
+        b2_32x8b = _mm256_loadu_si256((__m256i *)(pu1_buf + u4_cur_pos + 2));
+
+        zeros_32x8b = _mm256_cmpeq_epi8(_mm256_or_si256(b0_32x8b, b1_32x8b), zero_32x8b);
+        small_32x8b = _mm256_cmpeq_epi8(_mm256_subs_epu8(b2_32x8b, three_32x8b), zero_32x8b);
+        u4_mask = (UWORD32)_mm256_movemask_epi8(_mm256_and_si256(zeros_32x8b, small_32x8b));
+
+        if(u4_mask)
+            return u4_cur_pos + CTZ(u4_mask);
+
+        u4_cur_pos += 32;
+    }
+
+    return ih264d_find_nal_escape_ssse3(pu1_buf, u4_cur_pos, u4_max_ofst);
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_nal_ssse3.c
+ *
+ * @brief
+ *  Contains the x86 intrinsic definition of the start code and emulation
+ *  prevention byte search of the NAL parser
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264d_find_nal_escape_ssse3
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_nal.h"
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+ *******************************************************************************
+ *
+ * @brief
+ *  Finds the first three byte sequence 0x0000xx with xx <= 3
+ *
+ * @par Description:
+ *  Tests 16 positions per iteration: the two bytes at a position and the one
+ *  after them are loaded as three overlapping vectors, so that a sequence
+ *  straddling two iterations is not missed. The last positions are left to
+ *  the generic search
+ *
+ * @param[in] pu1_buf
+ *  Pointer to the bitstream
+ *
+ * @param[in] u4_cur_pos
+ *  Position the search starts at
+ *
+ * @param[in] u4_max_ofst
+ *  Number of bytes in the bitstream
+ *
+ * @returns
+ *  Position of the sequence, u4_max_ofst if there is none
+ *
+ * @remarks
+ *  Uses SSE2 instructions only
+ *
+ *******************************************************************************
+ */
+UWORD32 ih264d_find_nal_escape_ssse3(UWORD8 *pu1_buf,
+                                     UWORD32 u4_cur_pos,
+                                     UWORD32 u4_max_ofst)
+{
+    __m128i zero_16x8b = _mm_setzero_si128();
+    __m128i three_16x8b = _mm_set1_epi8(3);
+
+    while(u4_cur_pos + 18 <= u4_max_ofst)
+    {
+        __m128i b0_16x8b, b1_16x8b, b2_16x8b, zeros_16x8b, small_16x8b;
+        WORD32 i4_mask;
+
+        b0_16x8b = _mm_loadu_si128((__m128i *)(pu1_buf + u4_cur_pos));
+        b1_16x8b = _mm_loadu_si128((__m128i *)(pu1_buf + u4_cur_pos + 1));
+        b2_16x8b = _mm_loadu_si128((__m128i *)(pu1_buf + u4_cur_pos + 2));
+
+        zeros_16x8b = _mm_cmpeq_epi8(_mm_or_si128(b0_16x8b, b1_16x8b), zero_16x8b);
+        small_16x8b = _mm_cmpeq_epi8(_mm_subs_epu8(b2_16x8b, three_16x8b), zero_16x8b);
+        i4_mask = _mm_movemask_epi8(_mm_and_si128(zeros_16x8b, small_16x8b));
+
+        if(i4_mask)
+            return u4_cur_pos + CTZ(i4_mask);
+
+        u4_cur_pos += 16;
+    }
+
+    return ih264d_find_nal_escape_generic(pu1_buf, u4_cur_pos, u4_max_ofst);
+}
@@ -83,6 +83,39 @@
 #include "ih264e_fmt_conv.h"
 #include "ih264e_half_pel.h"
 
+/*****************************************************************************/
+/* Static Function Definitions                                               */
+/*****************************************************************************/
+
+/* Candidate list sad using the neon sad of a single candidate */
+static void ime_compute_sad_16x16_batch_a9q(UWORD8 *pu1_src,
+                                            UWORD8 **ppu1_est,
+                                            WORD32 src_strd,
+                                            WORD32 est_strd,
+                                            WORD32 i4_num_est,
+                                            WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+        ime_compute_sad_16x16_a9q(pu1_src, ppu1_est[i], src_strd, est_strd,
+                                  0x7FFFFFFF, &pi4_sad[i]);
+}
+
+static void ime_compute_sad_16x16_fast_batch_a9q(UWORD8 *pu1_src,
+                                                 UWORD8 **ppu1_est,
+                                                 WORD32 src_strd,
+                                                 WORD32 est_strd,
+                                                 WORD32 i4_num_est,
+                                                 WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+        ime_compute_sad_16x16_fast_a9q(pu1_src, ppu1_est[i], src_strd, est_strd,
+                                       0x7FFFFFFF, &pi4_sad[i]);
+}
+
 /**
 *******************************************************************************
 *
@@ -130,6 +163,7 @@ void ih264e_init_function_ptr_neon_a9q(codec_t *ps_codec)
     /* Init function pointers for intra pred leaf level functions luma
      * Intra 8x8 */
     ps_codec->apf_intra_pred_8_l[0] = ih264_intra_pred_luma_8x8_mode_vert_a9q;
+    ps_codec->apf_intra_pred_8_l[1] = ih264_intra_pred_luma_8x8_mode_horz_a9q;
     ps_codec->apf_intra_pred_8_l[2] = ih264_intra_pred_luma_8x8_mode_dc_a9q;
     ps_codec->apf_intra_pred_8_l[3] = ih264_intra_pred_luma_8x8_mode_diag_dl_a9q;
     ps_codec->apf_intra_pred_8_l[4] = ih264_intra_pred_luma_8x8_mode_diag_dr_a9q;
@@ -165,6 +199,7 @@ void ih264e_init_function_ptr_neon_a9q(codec_t *ps_codec)
     /* Init fn ptr luma core coding */
     ps_codec->luma_energy_compaction[0] = ih264e_code_luma_intra_macroblock_16x16;
     ps_codec->luma_energy_compaction[1] = ih264e_code_luma_intra_macroblock_4x4;
+    ps_codec->luma_energy_compaction[2] = ih264e_code_luma_intra_macroblock_8x8;
     ps_codec->luma_energy_compaction[3] = ih264e_code_luma_inter_macroblock_16x16;
 
     /* Init fn ptr chroma core coding */
@@ -222,6 +257,8 @@ void ih264e_init_function_ptr_neon_a9q(codec_t *ps_codec)
         ps_me_ctxt = &ps_proc->s_me_ctxt;
         ps_me_ctxt->pf_ime_compute_sad_16x16[0] = ime_compute_sad_16x16_a9q;
         ps_me_ctxt->pf_ime_compute_sad_16x16[1] = ime_compute_sad_16x16_fast_a9q;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[0] = ime_compute_sad_16x16_batch_a9q;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[1] = ime_compute_sad_16x16_fast_batch_a9q;
         ps_me_ctxt->pf_ime_compute_sad_16x8 = ime_compute_sad_16x8_a9q;
         ps_me_ctxt->pf_ime_compute_sad4_diamond = ime_calculate_sad4_prog_a9q;
         ps_me_ctxt->pf_ime_compute_sad3_diamond = ime_calculate_sad3_prog_a9q;
@@ -88,6 +88,39 @@
 #include "ih264e_half_pel.h"
 
 
+/*****************************************************************************/
+/* Static Function Definitions                                               */
+/*****************************************************************************/
+
+/* Candidate list sad using the neon sad of a single candidate */
+static void ime_compute_sad_16x16_batch_av8(UWORD8 *pu1_src,
+                                            UWORD8 **ppu1_est,
+                                            WORD32 src_strd,
+                                            WORD32 est_strd,
+                                            WORD32 i4_num_est,
+                                            WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+        ime_compute_sad_16x16_av8(pu1_src, ppu1_est[i], src_strd, est_strd,
+                                  0x7FFFFFFF, &pi4_sad[i]);
+}
+
+static void ime_compute_sad_16x16_fast_batch_av8(UWORD8 *pu1_src,
+                                                 UWORD8 **ppu1_est,
+                                                 WORD32 src_strd,
+                                                 WORD32 est_strd,
+                                                 WORD32 i4_num_est,
+                                                 WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+        ime_compute_sad_16x16_fast_av8(pu1_src, ppu1_est[i], src_strd, est_strd,
+                                       0x7FFFFFFF, &pi4_sad[i]);
+}
+
 /**
 *******************************************************************************
 *
@@ -137,6 +170,7 @@ void ih264e_init_function_ptr_neon_av8(codec_t *ps_codec)
         /* Init function pointers for intra pred leaf level functions luma
          * Intra 8x8 */
         ps_codec->apf_intra_pred_8_l[0] = ih264_intra_pred_luma_8x8_mode_vert_av8;
+        ps_codec->apf_intra_pred_8_l[1] = ih264_intra_pred_luma_8x8_mode_horz_av8;
         ps_codec->apf_intra_pred_8_l[2] = ih264_intra_pred_luma_8x8_mode_dc_av8;
         ps_codec->apf_intra_pred_8_l[3] = ih264_intra_pred_luma_8x8_mode_diag_dl_av8;
         ps_codec->apf_intra_pred_8_l[4] = ih264_intra_pred_luma_8x8_mode_diag_dr_av8;
@@ -173,6 +207,7 @@ void ih264e_init_function_ptr_neon_av8(codec_t *ps_codec)
         /* Init fn ptr luma core coding */
         ps_codec->luma_energy_compaction[0] = ih264e_code_luma_intra_macroblock_16x16;
         ps_codec->luma_energy_compaction[1] = ih264e_code_luma_intra_macroblock_4x4;
+        ps_codec->luma_energy_compaction[2] = ih264e_code_luma_intra_macroblock_8x8;
         ps_codec->luma_energy_compaction[3] = ih264e_code_luma_inter_macroblock_16x16;
 
         /* Init fn ptr chroma core coding */
@@ -232,6 +267,8 @@ void ih264e_init_function_ptr_neon_av8(codec_t *ps_codec)
             ps_me_ctxt = &ps_proc->s_me_ctxt;
             ps_me_ctxt->pf_ime_compute_sad_16x16[0] = ime_compute_sad_16x16_av8;
             ps_me_ctxt->pf_ime_compute_sad_16x16[1] = ime_compute_sad_16x16_fast_av8;
+            ps_me_ctxt->pf_ime_compute_sad_16x16_batch[0] = ime_compute_sad_16x16_batch_av8;
+            ps_me_ctxt->pf_ime_compute_sad_16x16_batch[1] = ime_compute_sad_16x16_fast_batch_av8;
             ps_me_ctxt->pf_ime_compute_sad_16x8 = ime_compute_sad_16x8_av8;
             ps_me_ctxt->pf_ime_compute_sad4_diamond = ime_calculate_sad4_prog_av8;
             ps_me_ctxt->pf_ime_compute_sad3_diamond = ime_calculate_sad3_prog_av8;
@@ -50,6 +50,9 @@ extern "C" {
 /* Constant Macros                                                           */
 /*****************************************************************************/
 
+/** Maximum number of CPUs in IH264E_CMD_CTL_SET_CPU_AFFINITY */
+#define IH264E_MAX_AFFINITY_CPUS    64
+
 
 /*****************************************************************************/
 /* API Function Prototype                                                    */
@@ -62,8 +65,35 @@ IV_STATUS_T ih264e_api_function(iv_obj_t *ps_handle, void *pv_api_ip,void *pv_ap
 typedef enum
 {
     IH264E_CMD_CTL_SET_ME_INFO_ENABLE,
+    IH264E_CMD_CTL_SET_CPU_AFFINITY         = IVE_CMD_CTL_CODEC_SUBCMD_START,
+    IH264E_CMD_CTL_SET_STATS,
+    IH264E_CMD_CTL_GET_STATS,
 }IH264E_CMD_CTL_SUB_CMDS;
 
+/** Encoder stages timed by IH264E_CMD_CTL_GET_STATS */
+typedef enum
+{
+    /** Motion estimation                                               */
+    IH264E_STATS_ME,
+
+    /** Intra mode evaluation of luma and chroma                        */
+    IH264E_STATS_INTRA_EVAL,
+
+    /** Transform, quantization, reconstruction and skip decision       */
+    IH264E_STATS_CORE_CODING,
+
+    /** Entropy coding, including slice headers                         */
+    IH264E_STATS_ENTROPY,
+
+    /** Boundary strength, deblocking, padding and half pel planes      */
+    IH264E_STATS_DBLK_PAD_HPEL,
+
+    /** Rate control, before and after coding the picture               */
+    IH264E_STATS_RC,
+
+    IH264E_STATS_NUM_STAGES,
+}IH264E_STATS_STAGE_T;
+
 
 /*****************************************************************************/
 /* Extended Structures                                                       */
@@ -126,6 +156,37 @@ typedef struct
 typedef struct
 {
     ive_init_ip_t                           s_ive_ip;
+
+    /**
+     * Keep the processing threads alive across encode calls. Threads wait
+     * on a condition variable between frames instead of being created and
+     * joined for every frame
+     */
+    UWORD32                                 u4_keep_threads_active;
+
+    /**
+     * Number of pictures analysed ahead of the current one for scene cut
+     * detection. 0 disables the lookahead, values above 16 are clipped
+     */
+    UWORD32                                 u4_lookahead;
+
+    /**
+     * Rate control stats of a first pass, used when e_rc_mode is
+     * IVE_RC_TWOPASS. This is the concatenation, in encode order, of the
+     * pv_rc_stats returned by every encode call of the first pass. The
+     * buffer must stay valid until the encoder is deleted
+     */
+    void                                    *pv_rc_stats;
+
+    /** Size of pv_rc_stats in bytes */
+    UWORD32                                 u4_rc_stats_size;
+
+    /**
+     * Overlap the entropy coding of a picture with the analysis of the next
+     * one. The bitstream of a picture is then returned by the following
+     * encode call. Honoured only when e_rc_mode is IVE_RC_NONE
+     */
+    UWORD32                                 u4_frame_pipelining;
 }ih264e_init_ip_t;
 
 
@@ -186,6 +247,9 @@ typedef struct
 typedef struct
 {
     ive_dequeue_out_op_t                      s_ive_op;
+
+    /** Frame type of the picture coded in the buffer                   */
+    UWORD32                                   u4_encoded_frame_type;
 }ih264e_dequeue_out_op_t;
 
 
@@ -270,6 +334,20 @@ typedef struct
     ive_ctl_getversioninfo_op_t         s_ive_op;
 }ih264e_ctl_getversioninfo_op_t;
 
+/*****************************************************************************/
+/*   Video control:Get Architecture                                          */
+/*****************************************************************************/
+
+typedef struct
+{
+    ive_ctl_get_arch_ip_t               s_ive_ip;
+}ih264e_ctl_get_arch_ip_t;
+
+typedef struct
+{
+    ive_ctl_get_arch_op_t               s_ive_op;
+}ih264e_ctl_get_arch_op_t;
+
 /*****************************************************************************/
 /*   Video control:Set default params                                       */
 /*****************************************************************************/
@@ -470,6 +548,138 @@ typedef struct
     ive_ctl_set_profile_params_op_t s_ive_op;
 }ih264e_ctl_set_profile_params_op_t;
 
+/*****************************************************************************/
+/*   Video control  Set CPU affinity                                         */
+/*****************************************************************************/
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Command type : IVE_CMD_VIDEO_CTL                                */
+    IVE_API_COMMAND_TYPE_T                      e_cmd;
+
+    /** Sub command type : IH264E_CMD_CTL_SET_CPU_AFFINITY              */
+    IVE_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Number of valid entries in au4_cpu_ids. 0 removes the CPU set and
+     * threads are no longer pinned by the encoder
+     */
+    UWORD32                                     u4_num_cpus;
+
+    /**
+     * CPUs the codec threads are pinned to. Processing thread i runs on
+     * au4_cpu_ids[i % u4_num_cpus], other codec threads may run on any of
+     * them. Memory first touched by these threads is hence placed on the
+     * NUMA node of these CPUs
+     */
+    UWORD32                                     au4_cpu_ids[IH264E_MAX_AFFINITY_CPUS];
+}ih264e_ctl_set_cpu_affinity_ip_t;
+
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Return error code                                               */
+    UWORD32                                     u4_error_code;
+}ih264e_ctl_set_cpu_affinity_op_t;
+
+/*****************************************************************************/
+/*   Video control  Set / Get statistics                                     */
+/*****************************************************************************/
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Command type : IVE_CMD_VIDEO_CTL                                */
+    IVE_API_COMMAND_TYPE_T                      e_cmd;
+
+    /** Sub command type : IH264E_CMD_CTL_SET_STATS                     */
+    IVE_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Enables collection of statistics. Off by default, as timing the
+     * stages costs a few clock reads per macroblock
+     */
+    UWORD32                                     u4_enable_stats;
+
+    /** Clears the statistics collected so far                         */
+    UWORD32                                     u4_reset_stats;
+}ih264e_ctl_set_stats_ip_t;
+
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Return error code                                               */
+    UWORD32                                     u4_error_code;
+}ih264e_ctl_set_stats_op_t;
+
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Command type : IVE_CMD_VIDEO_CTL                                */
+    IVE_API_COMMAND_TYPE_T                      e_cmd;
+
+    /** Sub command type : IH264E_CMD_CTL_GET_STATS                     */
+    IVE_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ih264e_ctl_get_stats_ip_t;
+
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Return error code                                               */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Frame type (IV_PICTURE_CODING_TYPE_T) of the last frame returned by
+     * an encode call. The u4_frame_* fields below refer to that frame
+     */
+    UWORD32                                     u4_frame_type;
+
+    /** Sum of the mb SADs of the frame                                 */
+    UWORD32                                     u4_frame_sad;
+
+    /** Bits in the frame, including headers                           */
+    UWORD32                                     u4_frame_bits;
+
+    /** Frame QP                                                        */
+    UWORD32                                     u4_frame_qp;
+
+    /** Number of mbs in the frame                                      */
+    UWORD32                                     u4_frame_num_mbs;
+
+    /** Number of P / B skip mbs in the frame                           */
+    UWORD32                                     u4_frame_num_skip_mbs;
+
+    /** Time in each stage (IH264E_STATS_STAGE_T) for the frame, summed
+     *  over the threads, in nanoseconds                                */
+    UWORD64                                     au8_frame_stage_ns[IH264E_STATS_NUM_STAGES];
+
+    /** Time threads waited on each other for the frame, in nanoseconds */
+    UWORD64                                     u8_frame_wait_ns;
+
+    /** Number of frames returned since the statistics were reset       */
+    UWORD32                                     u4_num_frames;
+
+    /** Bits in these frames                                            */
+    UWORD64                                     u8_num_bits;
+
+    /** Time in each stage for these frames, in nanoseconds             */
+    UWORD64                                     au8_stage_ns[IH264E_STATS_NUM_STAGES];
+
+    /** Time threads waited on each other for these frames, in nanoseconds */
+    UWORD64                                     u8_wait_ns;
+}ih264e_ctl_get_stats_op_t;
+
 /*****************************************************************************/
 /*   Synchronous video encode call                                           */
 /*****************************************************************************/
@@ -481,6 +691,16 @@ typedef struct
 typedef struct
 {
     ive_video_encode_op_t s_ive_op;
+
+    /**
+     * Rate control stats of the picture returned by this call, NULL if no
+     * picture is returned. Valid until the next encode call. The stats of
+     * all pictures of a clip are the input of a second, two pass encode
+     */
+    void                  *pv_rc_stats;
+
+    /** Size of pv_rc_stats in bytes */
+    UWORD32               u4_rc_stats_size;
 }ih264e_video_encode_op_t;
 
 
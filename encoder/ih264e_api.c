@@ -124,6 +124,8 @@
 #include "ih264e_master.h"
 #include "ih264e_fmt_conv.h"
 #include "ih264e_version.h"
+#include "ih264e_async.h"
+#include "ih264e_stats.h"
 
 
 /*****************************************************************************/
@@ -213,6 +215,7 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
             break;
 
         case IVE_CMD_QUEUE_INPUT:
+        case IVE_CMD_DEQUEUE_INPUT:
         case IVE_CMD_QUEUE_OUTPUT:
         case IVE_CMD_DEQUEUE_OUTPUT:
         case IVE_CMD_GET_RECON:
@@ -461,7 +464,8 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
 
             if ((ps_ip->s_ive_ip.e_rc_mode != IVE_RC_NONE)
                             && (ps_ip->s_ive_ip.e_rc_mode != IVE_RC_STORAGE)
-                            && (ps_ip->s_ive_ip.e_rc_mode != IVE_RC_CBR_NON_LOW_DELAY))
+                            && (ps_ip->s_ive_ip.e_rc_mode != IVE_RC_CBR_NON_LOW_DELAY)
+                            && (ps_ip->s_ive_ip.e_rc_mode != IVE_RC_TWOPASS))
             {
                 ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
                 ps_op->s_ive_op.u4_error_code |=
@@ -469,6 +473,17 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                 return (IV_FAIL);
             }
 
+            if ((ps_ip->s_ive_ip.e_rc_mode == IVE_RC_TWOPASS)
+                            && ((NULL == ps_ip->pv_rc_stats)
+                                            || (0 == ps_ip->u4_rc_stats_size)
+                                            || (ps_ip->u4_rc_stats_size
+                                                            % sizeof(rc_frm_stats_t))))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |= IH264E_INVALID_RC_STATS;
+                return (IV_FAIL);
+            }
+
             if (ps_ip->s_ive_ip.u4_max_framerate > DEFAULT_MAX_FRAMERATE)
             {
                 ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
@@ -762,8 +777,97 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
         }
 
         case IVE_CMD_QUEUE_INPUT:
+        {
+            ih264e_queue_inp_ip_t *ps_ip = pv_api_ip;
+            ih264e_queue_inp_op_t *ps_op = pv_api_op;
+
+            if (ps_ip->s_ive_ip.u4_size != sizeof(ih264e_queue_inp_ip_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_IP_QUEUE_INPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if (ps_op->s_ive_op.u4_size != sizeof(ih264e_queue_inp_op_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_OP_QUEUE_INPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+            break;
+        }
+
+        case IVE_CMD_DEQUEUE_INPUT:
+        {
+            ih264e_dequeue_inp_ip_t *ps_ip = pv_api_ip;
+            ih264e_dequeue_inp_op_t *ps_op = pv_api_op;
+
+            if (ps_ip->s_ive_ip.u4_size != sizeof(ih264e_dequeue_inp_ip_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_IP_DEQUEUE_INPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if (ps_op->s_ive_op.u4_size != sizeof(ih264e_dequeue_inp_op_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_OP_DEQUEUE_INPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+            break;
+        }
+
         case IVE_CMD_QUEUE_OUTPUT:
+        {
+            ih264e_queue_out_ip_t *ps_ip = pv_api_ip;
+            ih264e_queue_out_op_t *ps_op = pv_api_op;
+
+            if (ps_ip->s_ive_ip.u4_size != sizeof(ih264e_queue_out_ip_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_IP_QUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if (ps_op->s_ive_op.u4_size != sizeof(ih264e_queue_out_op_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_OP_QUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+            break;
+        }
+
         case IVE_CMD_DEQUEUE_OUTPUT:
+        {
+            ih264e_dequeue_out_ip_t *ps_ip = pv_api_ip;
+            ih264e_dequeue_out_op_t *ps_op = pv_api_op;
+
+            if (ps_ip->s_ive_ip.u4_size != sizeof(ih264e_dequeue_out_ip_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_IP_DEQUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+
+            if (ps_op->s_ive_op.u4_size != sizeof(ih264e_dequeue_out_op_t))
+            {
+                ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                ps_op->s_ive_op.u4_error_code |=
+                                IVE_ERR_OP_DEQUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT;
+                return (IV_FAIL);
+            }
+            break;
+        }
+
         case IVE_CMD_GET_RECON:
             break;
 
@@ -836,6 +940,18 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                                 IVE_ERR_OP_ENCODE_API_STRUCT_SIZE_INCORRECT;
                 return (IV_FAIL);
             }
+
+            /* synchronous calls are not mixed with the queue / dequeue ones */
+            {
+                codec_t *ps_codec = (codec_t *) (ps_handle->pv_codec_handle);
+
+                if (ps_codec->s_async.i4_thread_created)
+                {
+                    ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                    ps_op->s_ive_op.u4_error_code |= IH264E_ASYNC_INVALID_CALL;
+                    return (IV_FAIL);
+                }
+            }
             break;
         }
 
@@ -990,6 +1106,34 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     break;
                 }
 
+                case IVE_CMD_CTL_GET_ARCH:
+                {
+                    ih264e_ctl_get_arch_ip_t *ps_ip = pv_api_ip;
+                    ih264e_ctl_get_arch_op_t *ps_op = pv_api_op;
+
+                    if (ps_ip->s_ive_ip.u4_size
+                                    != sizeof(ih264e_ctl_get_arch_ip_t))
+                    {
+                        ps_op->s_ive_op.u4_error_code |= 1
+                                        << IVE_UNSUPPORTEDPARAM;
+                        ps_op->s_ive_op.u4_error_code |=
+                                        IVE_ERR_IP_CTL_GET_ARCH_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if (ps_op->s_ive_op.u4_size
+                                    != sizeof(ih264e_ctl_get_arch_op_t))
+                    {
+                        ps_op->s_ive_op.u4_error_code |= 1
+                                        << IVE_UNSUPPORTEDPARAM;
+                        ps_op->s_ive_op.u4_error_code |=
+                                        IVE_ERR_OP_CTL_GET_ARCH_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
                 case IVE_CMD_CTL_FLUSH:
                 {
                     ih264e_ctl_flush_ip_t *ps_ip = pv_api_ip;
@@ -1627,6 +1771,85 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     break;
                 }
 
+                case IH264E_CMD_CTL_SET_CPU_AFFINITY:
+                {
+                    ih264e_ctl_set_cpu_affinity_ip_t *ps_ip = pv_api_ip;
+                    ih264e_ctl_set_cpu_affinity_op_t *ps_op = pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264e_ctl_set_cpu_affinity_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_IP_CTL_SET_CPU_AFFINITY_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264e_ctl_set_cpu_affinity_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_OP_CTL_SET_CPU_AFFINITY_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_ip->u4_num_cpus > IH264E_MAX_AFFINITY_CPUS)
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |= IH264E_INVALID_CPU_AFFINITY;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264E_CMD_CTL_SET_STATS:
+                {
+                    ih264e_ctl_set_stats_ip_t *ps_ip = pv_api_ip;
+                    ih264e_ctl_set_stats_op_t *ps_op = pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264e_ctl_set_stats_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_IP_CTL_SET_STATS_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264e_ctl_set_stats_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_OP_CTL_SET_STATS_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264E_CMD_CTL_GET_STATS:
+                {
+                    ih264e_ctl_get_stats_ip_t *ps_ip = pv_api_ip;
+                    ih264e_ctl_get_stats_op_t *ps_op = pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264e_ctl_get_stats_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_IP_CTL_GET_STATS_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264e_ctl_get_stats_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVE_ERR_OP_CTL_GET_STATS_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
                 case IVE_CMD_CTL_SET_VUI_PARAMS:
                 {
                     ih264e_vui_ip_t *ps_ip = pv_api_ip;
@@ -1801,7 +2024,8 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     }
 
                     if (ps_ip->s_ive_ip.e_profile != IV_PROFILE_BASE &&
-                        ps_ip->s_ive_ip.e_profile != IV_PROFILE_MAIN)
+                        ps_ip->s_ive_ip.e_profile != IV_PROFILE_MAIN &&
+                        ps_ip->s_ive_ip.e_profile != IV_PROFILE_HIGH)
                     {
                         ps_op->s_ive_op.u4_error_code |= 1
                                         << IVE_UNSUPPORTEDPARAM;
@@ -2051,6 +2275,9 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = (1 << P16x8) | (1 << P8x16) | (1 << P8x8);
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_NORMAL)
         {/* normal */
@@ -2069,6 +2296,9 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = (1 << P16x8) | (1 << P8x16);
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_FAST)
         {/* normal */
@@ -2087,6 +2317,9 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_HIGH_SPEED)
         {/* fast */
@@ -2105,6 +2338,9 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_FASTEST)
         {/* fastest */
@@ -2123,10 +2359,16 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_CONFIG)
         {
             ps_curr_cfg->u4_enable_intra_4x4 = ps_cfg->u4_enable_intra_4x4;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
     }
     else if (ps_cfg->e_cmd == IVE_CMD_CTL_SET_GOP_PARAMS)
@@ -2247,6 +2489,9 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
     {
         ps_codec->s_cfg.e_profile = ps_cfg->e_profile;
         ps_codec->s_cfg.u4_entropy_coding_mode = ps_cfg->u4_entropy_coding_mode;
+
+        /* intra 8x8 prediction is coded only with the high profile 8x8 transform */
+        ps_codec->s_cfg.u4_enable_intra_8x8 = (ps_cfg->e_profile == IV_PROFILE_HIGH);
     }
     else if (ps_cfg->e_cmd == IVE_CMD_CTL_SET_NUM_CORES)
     {
@@ -2290,6 +2535,7 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
         switch (ps_codec->s_cfg.e_rc_mode)
         {
             case IVE_RC_STORAGE:
+            case IVE_RC_TWOPASS:
                 ps_codec->s_rate_control.e_rc_type = VBR_STORAGE;
                 break;
 
@@ -2325,6 +2571,15 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
                        ps_codec->s_cfg.u4_num_bframes + 1, au1_init_qp,
                        ps_codec->s_cfg.u4_num_bframes + 2, au1_min_max_qp,
                        ps_codec->s_cfg.u4_max_level);
+
+        /* resume the two pass plan from the next frame to be coded */
+        if (IVE_RC_TWOPASS == ps_codec->s_cfg.e_rc_mode)
+        {
+            irc_init_two_pass(ps_codec->s_rate_control.pps_rate_control_api,
+                              ps_codec->s_cfg.pv_rc_stats,
+                              ps_codec->s_cfg.u4_rc_stats_size / sizeof(rc_frm_stats_t),
+                              ps_codec->s_rate_control.i4_num_frms_coded);
+        }
     }
 
     return err;
@@ -2518,6 +2773,9 @@ static WORD32 ih264e_init(codec_t *ps_codec)
     /* inter gating enable */
     ps_codec->u4_inter_gate = 0;
 
+    /* P MB partitions, only P16x16 unless a speed preset enables them */
+    ps_codec->u4_mb_part_modes = 0;
+
     /* entropy mutex init */
     ithread_mutex_init(ps_codec->pv_entropy_mutex);
 
@@ -2530,6 +2788,15 @@ static WORD32 ih264e_init(codec_t *ps_codec)
     /* Process thread created status */
     memset(ps_codec->ai4_process_thread_created, 0, MAX_PROCESS_THREADS);
 
+    /* Thread pool status */
+    ps_codec->i4_pool_thread_cnt = 0;
+    ps_codec->i4_pool_frame_id = 0;
+    ps_codec->i4_pool_busy_cnt = 0;
+    ps_codec->i4_pool_exit = 0;
+
+    /* Asynchronous interface queues are empty */
+    ih264e_async_init(ps_codec);
+
     /* Number of MBs processed together */
     ps_codec->i4_proc_nmb = 8;
 
@@ -2642,9 +2909,13 @@ static WORD32 ih264e_init(codec_t *ps_codec)
     ih264e_init_function_ptr(ps_codec);
 
     /* reset status flags */
+    ps_codec->u4_entropy_thread_active = 0;
+    ps_codec->i4_pending_ctxt_sel = -1;
+    ps_codec->i4_frame_pipelining = 0;
+
     for (i = 0; i < MAX_CTXT_SETS; i++)
     {
-        ps_codec->au4_entropy_thread_active[i] = 0;
+        ps_codec->au4_entropy_done[i] = 0;
         ps_codec->ai4_pic_cnt[i] = -1;
 
         ps_codec->s_rate_control.pre_encode_skip[i] = 0;
@@ -3118,6 +3389,25 @@ static WORD32 ih264e_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op)
     }
     DEBUG("\nMemory record Id %d = %d \n", MEM_REC_ENTROPY_MUTEX, ps_mem_rec->u4_mem_size);
 
+    /************************************************************************
+     * Request memory to hold mutex and condition variables of thread pool  *
+     ************************************************************************/
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_THREAD_POOL];
+    {
+        ps_mem_rec->u4_mem_size = ithread_get_mutex_lock_size()
+                        + 2 * ithread_get_cond_struct_size();
+    }
+    DEBUG("\nMemory record Id %d = %d \n", MEM_REC_THREAD_POOL, ps_mem_rec->u4_mem_size);
+
+    /************************************************************************
+     * Request memory to hold proc and ME map progress primitives           *
+     ************************************************************************/
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_MB_PROGRESS];
+    {
+        ps_mem_rec->u4_mem_size = 2 * ithread_get_progress_struct_size();
+    }
+    DEBUG("\nMemory record Id %d = %d \n", MEM_REC_MB_PROGRESS, ps_mem_rec->u4_mem_size);
+
     /************************************************************************
      * Request memory to hold process jobs                                  *
      ***********************************************************************/
@@ -3341,8 +3631,13 @@ static WORD32 ih264e_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op)
         /* Size for SATDQ threshold matrix for palnes y, cb and cr */
         total_size += ALIGN64(sizeof(UWORD16) * 9) * 3;
 
+        /* quantization parameter list, threshold matrix and forward weight
+         * matrix for plane y when the transform_8x8_flag is enabled */
+        total_size += ALIGN64(sizeof(quant_params_t));
+        total_size += ALIGN64(sizeof(WORD16) * 8 * 8) * 2;
+
         /* total size per each proc thread */
-        total_size *= MAX_PROCESS_CTXT;
+        total_size = ALIGN128(total_size) * MAX_PROCESS_CTXT;
 
         ps_mem_rec->u4_mem_size = total_size;
     }
@@ -3376,7 +3671,7 @@ static WORD32 ih264e_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op)
 
         /* size in bytes to store  1 row + 1 of enc_pu_t */
         /* one additional mb, to avoid checking end of row condition */
-        total_size += (max_mb_cols + 1) * sizeof(enc_pu_t);
+        total_size += (max_mb_cols + 1) * ENC_NUM_PU_IN_MB * sizeof(enc_pu_t);
 
         /* total size per proc ctxt */
         total_size = ALIGN128(total_size);
@@ -3533,6 +3828,32 @@ static WORD32 ih264e_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op)
     }
     DEBUG("\nMemory record Id %d = %d \n", MEM_REC_MB_INFO_NMB, ps_mem_rec->u4_mem_size);
 
+    /************************************************************************
+     * size for memory required by the lookahead: two 2:1 downscaled luma   *
+     * planes and one motion vector per lookahead block                     *
+     ************************************************************************/
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_LOOKAHEAD];
+    {
+        WORD32 ds_size = (max_wd_luma >> 1) * (max_ht_luma >> 1);
+
+        ps_mem_rec->u4_mem_size = 2 * ALIGN64(ds_size);
+        ps_mem_rec->u4_mem_size += 2 * sizeof(WORD16)
+                        * (ds_size / (LOOKAHEAD_BLK_SIZE * LOOKAHEAD_BLK_SIZE));
+    }
+    DEBUG("\nMemory record Id %d = %d \n", MEM_REC_LOOKAHEAD, ps_mem_rec->u4_mem_size);
+
+    /************************************************************************
+     * Request memory to hold the encode thread handle, mutex and condition *
+     * variable of the asynchronous interface                               *
+     ************************************************************************/
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_ASYNC];
+    {
+        ps_mem_rec->u4_mem_size = ithread_get_handle_size()
+                        + ithread_get_mutex_lock_size()
+                        + ithread_get_cond_struct_size();
+    }
+    DEBUG("\nMemory record Id %d = %d \n", MEM_REC_ASYNC, ps_mem_rec->u4_mem_size);
+
     /************************************************************************
      * RC mem records                                                       *
      ************************************************************************/
@@ -3668,6 +3989,11 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
     ps_cfg->e_soc = ps_ip->s_ive_ip.e_soc;
     ps_cfg->u4_enable_recon = ps_ip->s_ive_ip.u4_enable_recon;
     ps_cfg->e_rc_mode = ps_ip->s_ive_ip.e_rc_mode;
+    ps_cfg->u4_keep_threads_active = ps_ip->u4_keep_threads_active;
+    ps_cfg->u4_lookahead = MIN(ps_ip->u4_lookahead, MAX_LOOKAHEAD_FRAMES);
+    ps_cfg->pv_rc_stats = ps_ip->pv_rc_stats;
+    ps_cfg->u4_rc_stats_size = ps_ip->u4_rc_stats_size;
+    ps_cfg->u4_frame_pipelining = ps_ip->u4_frame_pipelining;
 
     /* Validate params */
     if ((ps_ip->s_ive_ip.u4_max_level < MIN_LEVEL)
@@ -4016,6 +4342,36 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
         ps_codec->pv_entropy_mutex = ps_mem_rec->pv_base;
     }
 
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_THREAD_POOL];
+    {
+        UWORD8 *pu1_buf = ps_mem_rec->pv_base;
+
+        ps_codec->pv_thread_pool_mutex = pu1_buf;
+        pu1_buf += ithread_get_mutex_lock_size();
+
+        ps_codec->pv_thread_pool_start_cond = pu1_buf;
+        pu1_buf += ithread_get_cond_struct_size();
+
+        ps_codec->pv_thread_pool_done_cond = pu1_buf;
+
+        ithread_mutex_init(ps_codec->pv_thread_pool_mutex);
+        ithread_cond_init(ps_codec->pv_thread_pool_start_cond);
+        ithread_cond_init(ps_codec->pv_thread_pool_done_cond);
+    }
+
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_MB_PROGRESS];
+    {
+        UWORD8 *pu1_buf = ps_mem_rec->pv_base;
+
+        ps_codec->pv_proc_map_progress = pu1_buf;
+        pu1_buf += ithread_get_progress_struct_size();
+
+        ps_codec->pv_me_map_progress = pu1_buf;
+
+        ithread_progress_init(ps_codec->pv_proc_map_progress, MB_MAP_WAIT_SPIN_CNT);
+        ithread_progress_init(ps_codec->pv_me_map_progress, MB_MAP_WAIT_SPIN_CNT);
+    }
+
     ps_mem_rec = &ps_mem_rec_base[MEM_REC_PROC_JOBQ];
     {
         ps_codec->pv_proc_jobq_buf = ps_mem_rec->pv_base;
@@ -4216,7 +4572,7 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
 
         /* size of qp, threshold matrix, fwd scaling list for one plane */
         WORD32 size_quant_param, size_thres_mat, size_fwd_weight_mat,
-                        size_satqd_weight_mat;
+                        size_satqd_weight_mat, size_thres_mat_8x8;
 
         /* temp var */
         WORD32 total_size = 0;
@@ -4237,6 +4593,9 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
         /* size of SATQD matrix*/
         size_satqd_weight_mat = ALIGN64(sizeof(UWORD16) * 9);
 
+        /* size of threshold (or fwd weight) matrix for 8x8 luma transform */
+        size_thres_mat_8x8 = ALIGN64(sizeof(WORD16) * 8 * 8);
+
         for (i = 0; i < MAX_PROCESS_CTXT; i++)
         {
             quant_params_t **ps_qp_params = ps_codec->as_process[i].ps_qp_params;
@@ -4273,6 +4632,16 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
             ps_qp_params[2]->pu2_sad_thrsh = (void *) (pu1_buf + total_size);
             total_size = total_size + size_satqd_weight_mat;
 
+            /* quantization param structure for 8x8 luma transform */
+            ps_codec->as_process[i].ps_qp_params_8x8 = (quant_params_t *) (pu1_buf + total_size);
+            total_size = total_size + size_quant_param;
+
+            /* threshold matrix & fwd weight matrix for 8x8 luma transform */
+            ps_codec->as_process[i].ps_qp_params_8x8->pu2_thres_mat = (void *) (pu1_buf + total_size);
+            total_size = total_size + size_thres_mat_8x8;
+            ps_codec->as_process[i].ps_qp_params_8x8->pu2_weigh_mat = (void *) (pu1_buf + total_size);
+            total_size = total_size + size_thres_mat_8x8;
+
             total_size = ALIGN128(total_size);
         }
     }
@@ -4294,7 +4663,7 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
 
         /* size in bytes to store  1 row + 1 of enc_pu_t */
         /* one additional mb, to avoid checking end of row condition */
-        size_mv = (max_mb_cols + 1) * sizeof(enc_pu_t);
+        size_mv = (max_mb_cols + 1) * ENC_NUM_PU_IN_MB * sizeof(enc_pu_t);
 
         /* total size per proc ctxt */
         total_size = size_csbp + size_intra_modes + size_mv;
@@ -4464,12 +4833,49 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
         }
     }
 
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_LOOKAHEAD];
+    {
+        UWORD8 *pu1_buf = ps_mem_rec->pv_base;
+        WORD32 ds_size = (max_wd_luma >> 1) * (max_ht_luma >> 1);
+
+        ps_codec->s_lookahead.apu1_ds_buf[0] = pu1_buf;
+        pu1_buf += ALIGN64(ds_size);
+
+        ps_codec->s_lookahead.apu1_ds_buf[1] = pu1_buf;
+        pu1_buf += ALIGN64(ds_size);
+
+        ps_codec->s_lookahead.pi2_blk_mv = (WORD16 *) pu1_buf;
+
+        ps_codec->s_lookahead.i4_ds_strd = max_wd_luma >> 1;
+    }
+
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_ASYNC];
+    {
+        UWORD8 *pu1_buf = ps_mem_rec->pv_base;
+
+        ps_codec->s_async.pv_thread_handle = pu1_buf;
+        pu1_buf += ithread_get_handle_size();
+
+        ps_codec->s_async.pv_mutex = pu1_buf;
+        pu1_buf += ithread_get_mutex_lock_size();
+
+        ps_codec->s_async.pv_cond = pu1_buf;
+
+        ps_codec->s_async.i4_thread_created = 0;
+
+        ithread_mutex_init(ps_codec->s_async.pv_mutex);
+        ithread_cond_init(ps_codec->s_async.pv_cond);
+    }
+
     ps_mem_rec = &ps_mem_rec_base[MEM_REC_RC];
     {
         ih264e_get_rate_control_mem_tab(&ps_codec->s_rate_control, ps_mem_rec,
                                         USE_BASE);
     }
 
+    /* threads are not pinned till a CPU set is given, kept across resets */
+    ps_codec->i4_num_affinity_cpus = 0;
+
     /* init codec ctxt */
     status = ih264e_init(ps_codec);
 
@@ -4518,6 +4924,9 @@ static WORD32 ih264e_retrieve_memrec(iv_obj_t *ps_codec_obj,
         return IV_FAIL;
     }
 
+    /* stop the encode thread of the asynchronous interface, if running */
+    ih264e_async_stop(ps_codec);
+
     /* join threads upon at end of sequence */
     ih264e_join_threads(ps_codec);
 
@@ -4531,6 +4940,13 @@ static WORD32 ih264e_retrieve_memrec(iv_obj_t *ps_codec_obj,
     ih264_list_free(ps_codec->pv_proc_jobq);
     ithread_mutex_destroy(ps_codec->pv_ctl_mutex);
     ithread_mutex_destroy(ps_codec->pv_entropy_mutex);
+    ithread_cond_destroy(ps_codec->pv_thread_pool_start_cond);
+    ithread_cond_destroy(ps_codec->pv_thread_pool_done_cond);
+    ithread_mutex_destroy(ps_codec->pv_thread_pool_mutex);
+    ithread_cond_destroy(ps_codec->s_async.pv_cond);
+    ithread_mutex_destroy(ps_codec->s_async.pv_mutex);
+    ithread_progress_destroy(ps_codec->pv_proc_map_progress);
+    ithread_progress_destroy(ps_codec->pv_me_map_progress);
 
 
     ih264_buf_mgr_free((buf_mgr_t *)ps_codec->pv_mv_buf_mgr);
@@ -5428,6 +5844,11 @@ static WORD32 ih264e_reset(iv_obj_t *ps_codec_obj,
 
     if (ps_codec != NULL)
     {
+        /* encode and pool threads, if any, are stopped before the context
+         * is reset */
+        ih264e_async_stop(ps_codec);
+        ih264e_join_threads(ps_codec);
+
         ih264e_init(ps_codec);
     }
     else
@@ -5483,6 +5904,9 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
     WORD32 i;
     cfg_params_t *ps_cfg = NULL;
 
+    /* set, if the config param set is to be applied by a later encode call */
+    UWORD32 u4_cfg_valid = 1;
+
     /* control call is for configuring encoding params, this is not to be called
      * before a successful init call */
     if (ps_codec->i4_init_done != 1)
@@ -5492,6 +5916,13 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
         return IV_FAIL;
     }
 
+    /* the encode thread of the asynchronous interface takes the ctl mutex to
+     * read config params, so it is stopped before reset takes the mutex */
+    if (IVE_CMD_CTL_RESET == sub_cmd)
+    {
+        ih264e_async_stop(ps_codec);
+    }
+
     /* make it thread safe */
     ithread_mutex_lock(ps_codec->pv_ctl_mutex);
 
@@ -5511,11 +5942,13 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
         ps_cfg = &ps_codec->as_cfg[0];
     }
 
-    ps_cfg->u4_is_valid = 1;
+    /* the set is published to the encode call only after it is filled */
+    ps_cfg->u4_is_valid = 0;
 
     ps_cfg->e_cmd = sub_cmd;
 
-    switch (sub_cmd)
+    /* codec specific sub commands are outside IVE_CONTROL_API_COMMAND_TYPE_T */
+    switch ((WORD32)sub_cmd)
     {
         case IVE_CMD_CTL_SET_DIMENSIONS:
             ret = ih264e_set_dimensions(pv_api_ip, pv_api_op, ps_cfg);
@@ -5576,7 +6009,7 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
         case IVE_CMD_CTL_RESET:
 
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             ret = ih264e_reset(ps_codec_obj, pv_api_ip, pv_api_op);
             break;
@@ -5587,7 +6020,7 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
             ih264e_ctl_setdefault_op_t *ps_op = pv_api_op;
 
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             /* error status */
             ret = ih264e_set_default_params(ps_cfg);
@@ -5600,7 +6033,7 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
         case IVE_CMD_CTL_FLUSH:
 
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             ret = ih264e_set_flush_mode(ps_codec_obj, pv_api_ip, pv_api_op);
             break;
@@ -5608,7 +6041,7 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
         case IVE_CMD_CTL_GETBUFINFO:
 
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             ret = ih264e_get_buf_info(ps_codec_obj, pv_api_ip, pv_api_op);
             break;
@@ -5620,7 +6053,7 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
             ih264e_ctl_getversioninfo_op_t *ps_op = pv_api_op;
 
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             /* error status */
             ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
@@ -5646,18 +6079,72 @@ static WORD32 ih264e_ctl(iv_obj_t *ps_codec_obj,
             break;
         }
 
+        case IVE_CMD_CTL_GET_ARCH:
+        {
+            /* ctrl call I/O structures */
+            ih264e_ctl_get_arch_op_t *ps_op = pv_api_op;
+
+            /* invalidate config param struct as it is being served right away */
+            u4_cfg_valid = 0;
+
+            ps_op->s_ive_op.e_arch = ps_codec->s_cfg.e_arch;
+            ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
+            break;
+        }
+
         case IVE_CMD_CTL_SET_NUM_CORES:
             ret = ih264e_set_num_cores(pv_api_ip, pv_api_op, ps_cfg);
             break;
 
+        case IH264E_CMD_CTL_SET_CPU_AFFINITY:
+        {
+            /* ctrl call I/O structures */
+            ih264e_ctl_set_cpu_affinity_ip_t *ps_ip = pv_api_ip;
+            ih264e_ctl_set_cpu_affinity_op_t *ps_op = pv_api_op;
+
+            /* invalidate config param struct as it is being served right away */
+            u4_cfg_valid = 0;
+
+            /* takes effect as the codec threads next start processing */
+            ps_codec->i4_num_affinity_cpus = ps_ip->u4_num_cpus;
+            for (i = 0; i < (WORD32)ps_ip->u4_num_cpus; i++)
+            {
+                ps_codec->ai4_affinity_cpus[i] = ps_ip->au4_cpu_ids[i];
+            }
+
+            ps_op->u4_error_code = IV_SUCCESS;
+            break;
+        }
+
+        case IH264E_CMD_CTL_SET_STATS:
+
+            /* invalidate config param struct as it is being served right away */
+            u4_cfg_valid = 0;
+
+            ret = ih264e_set_stats(ps_codec, pv_api_ip, pv_api_op);
+            break;
+
+        case IH264E_CMD_CTL_GET_STATS:
+
+            /* invalidate config param struct as it is being served right away */
+            u4_cfg_valid = 0;
+
+            ret = ih264e_get_stats(ps_codec, pv_api_ip, pv_api_op);
+            break;
+
         default:
             /* invalidate config param struct as it is being served right away */
-            ps_codec->as_cfg[i].u4_is_valid = 0;
+            u4_cfg_valid = 0;
 
             DEBUG("Warning !! unrecognized control api command \n");
             break;
     }
 
+    if (u4_cfg_valid)
+    {
+        ps_cfg->u4_is_valid = 1;
+    }
+
     ithread_mutex_unlock(ps_codec->pv_ctl_mutex);
 
     return ret;
@@ -5742,6 +6229,22 @@ IV_STATUS_T ih264e_api_function(iv_obj_t *ps_handle,
             ret = ih264e_encode(ps_handle, pv_api_ip, pv_api_op);
             break;
 
+        case IVE_CMD_QUEUE_INPUT:
+            ret = ih264e_queue_input(ps_handle, pv_api_ip, pv_api_op);
+            break;
+
+        case IVE_CMD_DEQUEUE_INPUT:
+            ret = ih264e_dequeue_input(ps_handle, pv_api_ip, pv_api_op);
+            break;
+
+        case IVE_CMD_QUEUE_OUTPUT:
+            ret = ih264e_queue_output(ps_handle, pv_api_ip, pv_api_op);
+            break;
+
+        case IVE_CMD_DEQUEUE_OUTPUT:
+            ret = ih264e_dequeue_output(ps_handle, pv_api_ip, pv_api_op);
+            break;
+
         default:
             ret = IV_FAIL;
             break;
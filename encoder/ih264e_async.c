@@ -0,0 +1,924 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_async.c
+*
+* @brief
+*  Contains functions of the asynchronous (queue / dequeue) encode interface.
+*  Input and bitstream buffers queued by the app are handed to ih264e_encode()
+*  by a dedicated encode thread, buffers released by the encoder are held till
+*  the app dequeues them
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264e_async_init()
+*  - ih264e_async_release_bufs()
+*  - ih264e_async_thread()
+*  - ih264e_async_launch()
+*  - ih264e_async_stop()
+*  - ih264e_queue_input()
+*  - ih264e_dequeue_input()
+*  - ih264e_queue_output()
+*  - ih264e_dequeue_output()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264e.h"
+#include "ithread.h"
+#include "ih264_defs.h"
+#include "ih264_debug.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_buf_mgr.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_master.h"
+#include "ih264e_utils.h"
+#include "ih264e_async.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Empties the queues of the asynchronous interface
+*
+* @par Description:
+*  Called at init and reset, once the encode thread, if any, has exited
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void ih264e_async_init(codec_t *ps_codec)
+{
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    ps_async->i4_exit = 0;
+    ps_async->i4_last_inp_queued = 0;
+    ps_async->i4_flush = 0;
+    ps_async->i4_eos = 0;
+    ps_async->u4_error_code = IV_SUCCESS;
+
+    ps_async->i4_inp_q_rd = 0;
+    ps_async->i4_inp_q_cnt = 0;
+    ps_async->i4_inp_busy_cnt = 0;
+    ps_async->i4_inp_done_rd = 0;
+    ps_async->i4_inp_done_cnt = 0;
+
+    ps_async->i4_out_q_rd = 0;
+    ps_async->i4_out_q_cnt = 0;
+    ps_async->i4_out_busy_cnt = 0;
+    ps_async->i4_out_done_rd = 0;
+    ps_async->i4_out_done_cnt = 0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns all buffers held by the asynchronous interface to the app
+*
+* @par Description:
+*  Called with the mutex held, once the encoder has returned its last output
+*  or has failed. Inputs and bitstream buffers, queued or held by the encoder,
+*  are moved to the dequeue queues. Bitstream buffers are returned empty and
+*  the last one of the stream is marked as such
+*
+* @param[in] ps_async
+*  Pointer to the asynchronous interface context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static void ih264e_async_release_bufs(async_ctxt_t *ps_async)
+{
+    WORD32 i, idx;
+
+    for (i = 0; i < ps_async->i4_inp_busy_cnt; i++)
+    {
+        idx = (ps_async->i4_inp_done_rd + ps_async->i4_inp_done_cnt)
+                        % MAX_ASYNC_INP_BUFS;
+        ps_async->as_inp_done[idx] = ps_async->as_inp_busy[i];
+        ps_async->i4_inp_done_cnt++;
+    }
+    ps_async->i4_inp_busy_cnt = 0;
+
+    while (ps_async->i4_inp_q_cnt)
+    {
+        /* inputs queued after the last one are never encoded */
+        if (ps_async->as_inp_q[ps_async->i4_inp_q_rd].s_inp_buf.apv_bufs[0])
+        {
+            idx = (ps_async->i4_inp_done_rd + ps_async->i4_inp_done_cnt)
+                            % MAX_ASYNC_INP_BUFS;
+            ps_async->as_inp_done[idx] = ps_async->as_inp_q[ps_async->i4_inp_q_rd];
+            ps_async->i4_inp_done_cnt++;
+        }
+        ps_async->i4_inp_q_rd = (ps_async->i4_inp_q_rd + 1) % MAX_ASYNC_INP_BUFS;
+        ps_async->i4_inp_q_cnt--;
+    }
+
+    for (i = 0; i < ps_async->i4_out_busy_cnt + ps_async->i4_out_q_cnt; i++)
+    {
+        async_out_buf_t *ps_out;
+
+        idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt)
+                        % MAX_ASYNC_OUT_BUFS;
+        ps_out = &ps_async->as_out_done[idx];
+
+        if (i < ps_async->i4_out_busy_cnt)
+        {
+            ps_out->s_bits_buf = ps_async->as_out_busy[i];
+        }
+        else
+        {
+            ps_out->s_bits_buf = ps_async->as_out_q[ps_async->i4_out_q_rd];
+            ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        }
+        ps_out->s_bits_buf.u4_bytes = 0;
+        ps_out->u4_timestamp_low = 0;
+        ps_out->u4_timestamp_high = 0;
+        ps_out->u4_encoded_frame_type = IV_NA_FRAME;
+        ps_out->u4_is_last = 0;
+
+        ps_async->i4_out_done_cnt++;
+    }
+    ps_async->i4_out_busy_cnt = 0;
+    ps_async->i4_out_q_cnt = 0;
+
+    if (ps_async->i4_out_done_cnt)
+    {
+        idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt - 1)
+                        % MAX_ASYNC_OUT_BUFS;
+        ps_async->as_out_done[idx].u4_is_last = 1;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Entry point of the encode thread of the asynchronous interface
+*
+* @par Description:
+*  Waits till a bitstream buffer and an input are queued, then encodes the
+*  input with a synchronous ih264e_encode() call. The input and bitstream
+*  buffers released by the call are moved to the dequeue queues. Once the last
+*  input is handed over, the encoder is flushed with empty inputs till it
+*  returns its last output. Repeats till asked to exit
+*
+*  Header mode calls do not consume an input, such calls are made without one
+*
+* @param[in] pv_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_async_thread(void *pv_codec)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = pv_codec;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    /* encode call I/O structures */
+    ih264e_video_encode_ip_t s_encode_ip;
+    ih264e_video_encode_op_t s_encode_op;
+    ive_video_encode_ip_t *ps_ip = &s_encode_ip.s_ive_ip;
+    ive_video_encode_op_t *ps_op = &s_encode_op.s_ive_op;
+
+    /* temp var */
+    WORD32 i, idx, ret;
+
+    /* the encode calls of this thread run on the CPU set of the instance */
+    ih264e_set_thread_affinity(ps_codec, -1);
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while (1)
+    {
+        while ((0 == ps_async->i4_exit)
+                        && (ps_async->i4_eos || (0 == ps_async->i4_out_q_cnt)
+                                        || ((0 == ps_async->i4_inp_q_cnt)
+                                                        && (0 == ps_async->i4_flush))))
+        {
+            ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+        }
+
+        if (ps_async->i4_exit)
+        {
+            break;
+        }
+
+        memset(&s_encode_ip, 0, sizeof(s_encode_ip));
+        memset(&s_encode_op, 0, sizeof(s_encode_op));
+
+        ps_ip->u4_size = sizeof(ih264e_video_encode_ip_t);
+        ps_ip->e_cmd = IVE_CMD_VIDEO_ENCODE;
+        ps_op->u4_size = sizeof(ih264e_video_encode_op_t);
+
+        /* input */
+        if (ps_async->i4_flush || (1 == ps_codec->i4_header_mode))
+        {
+            ps_ip->u4_is_last = ps_async->i4_flush;
+        }
+        else
+        {
+            ive_queue_inp_ip_t *ps_inp = &ps_async->as_inp_q[ps_async->i4_inp_q_rd];
+
+            ps_ip->s_inp_buf = ps_inp->s_inp_buf;
+            ps_ip->u4_mb_info_type = ps_inp->u4_mb_info_type;
+            ps_ip->pv_mb_info = ps_inp->pv_mb_info;
+            ps_ip->u4_pic_info_type = ps_inp->u4_pic_info_type;
+            ps_ip->pv_pic_info = ps_inp->pv_pic_info;
+            ps_ip->u4_timestamp_low = ps_inp->u4_timestamp_low;
+            ps_ip->u4_timestamp_high = ps_inp->u4_timestamp_high;
+            ps_ip->u4_is_last = ps_inp->u4_is_last;
+
+            if (ps_inp->s_inp_buf.apv_bufs[0])
+            {
+                ps_async->as_inp_busy[ps_async->i4_inp_busy_cnt++] = *ps_inp;
+            }
+
+            ps_async->i4_flush = ps_inp->u4_is_last;
+
+            ps_async->i4_inp_q_rd = (ps_async->i4_inp_q_rd + 1) % MAX_ASYNC_INP_BUFS;
+            ps_async->i4_inp_q_cnt--;
+        }
+
+        /* bitstream buffer */
+        ps_ip->s_out_buf = ps_async->as_out_q[ps_async->i4_out_q_rd];
+        ps_async->as_out_busy[ps_async->i4_out_busy_cnt++] = ps_ip->s_out_buf;
+
+        ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        ps_async->i4_out_q_cnt--;
+
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        ret = ih264e_encode(ps_async->ps_codec_obj, &s_encode_ip, &s_encode_op);
+
+        ithread_mutex_lock(ps_async->pv_mutex);
+
+        if (IV_SUCCESS != ret)
+        {
+            ps_async->u4_error_code = ps_op->u4_error_code;
+            ps_async->i4_eos = 1;
+            ih264e_async_release_bufs(ps_async);
+
+            ithread_cond_broadcast(ps_async->pv_cond);
+            continue;
+        }
+
+        /* input released by the encoder. An input returned again by a later
+         * call is no longer held and is ignored */
+        if (ps_op->s_inp_buf.apv_bufs[0])
+        {
+            for (i = 0; i < ps_async->i4_inp_busy_cnt; i++)
+            {
+                if (ps_async->as_inp_busy[i].s_inp_buf.apv_bufs[0]
+                                == ps_op->s_inp_buf.apv_bufs[0])
+                {
+                    idx = (ps_async->i4_inp_done_rd + ps_async->i4_inp_done_cnt)
+                                    % MAX_ASYNC_INP_BUFS;
+                    ps_async->as_inp_done[idx] = ps_async->as_inp_busy[i];
+                    ps_async->i4_inp_done_cnt++;
+
+                    ps_async->as_inp_busy[i] =
+                                    ps_async->as_inp_busy[--ps_async->i4_inp_busy_cnt];
+                    break;
+                }
+            }
+        }
+
+        /* bitstream buffer released by the encoder */
+        if (ps_op->s_out_buf.pv_buf)
+        {
+            for (i = 0; i < ps_async->i4_out_busy_cnt; i++)
+            {
+                if (ps_async->as_out_busy[i].pv_buf == ps_op->s_out_buf.pv_buf)
+                {
+                    ps_async->as_out_busy[i] =
+                                    ps_async->as_out_busy[--ps_async->i4_out_busy_cnt];
+                    break;
+                }
+            }
+
+            if (ps_op->output_present)
+            {
+                async_out_buf_t *ps_out;
+
+                idx = (ps_async->i4_out_done_rd + ps_async->i4_out_done_cnt)
+                                % MAX_ASYNC_OUT_BUFS;
+                ps_out = &ps_async->as_out_done[idx];
+
+                ps_out->s_bits_buf = ps_op->s_out_buf;
+                ps_out->u4_timestamp_low = ps_op->u4_timestamp_low;
+                ps_out->u4_timestamp_high = ps_op->u4_timestamp_high;
+                ps_out->u4_encoded_frame_type = ps_op->u4_encoded_frame_type;
+                ps_out->u4_is_last = 0;
+
+                ps_async->i4_out_done_cnt++;
+            }
+            else
+            {
+                /* unused, it is the next one handed to the encoder */
+                ps_async->i4_out_q_rd = (ps_async->i4_out_q_rd
+                                + MAX_ASYNC_OUT_BUFS - 1) % MAX_ASYNC_OUT_BUFS;
+                ps_async->as_out_q[ps_async->i4_out_q_rd] = ps_op->s_out_buf;
+                ps_async->i4_out_q_cnt++;
+            }
+        }
+
+        if (ps_op->u4_is_last)
+        {
+            ps_async->i4_eos = 1;
+            ih264e_async_release_bufs(ps_async);
+        }
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    return 0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Creates the encode thread on the first queue call
+*
+* @par Description:
+*  Called with the mutex held
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static IH264E_ERROR_T ih264e_async_launch(iv_obj_t *ps_codec_obj)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = (codec_t *) ps_codec_obj->pv_codec_handle;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    if (0 == ps_async->i4_thread_created)
+    {
+        ps_async->ps_codec_obj = ps_codec_obj;
+
+        if (0 != ithread_create(ps_async->pv_thread_handle, NULL,
+                                (void *)ih264e_async_thread, ps_codec))
+        {
+            return IH264E_FAIL;
+        }
+
+        ps_async->i4_thread_created = 1;
+    }
+
+    return IH264E_SUCCESS;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Stops the encode thread of the asynchronous interface
+*
+* @par Description:
+*  The thread completes the encode call in progress, if any, and exits. Buffers
+*  still queued are dropped
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void ih264e_async_stop(codec_t *ps_codec)
+{
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    if (ps_async->i4_thread_created)
+    {
+        ithread_mutex_lock(ps_async->pv_mutex);
+        ps_async->i4_exit = 1;
+        ithread_cond_broadcast(ps_async->pv_cond);
+        ithread_mutex_unlock(ps_async->pv_mutex);
+
+        if (0 != ithread_join(ps_async->pv_thread_handle, NULL))
+        {
+            printf("pthread Join Failed");
+            assert(0);
+        }
+
+        ps_async->i4_thread_created = 0;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues an input buffer to be encoded
+*
+* @par Description:
+*  Blocks while the app has MAX_ASYNC_INP_BUFS inputs outstanding, if asked
+*  to, and fails otherwise. An input with u4_is_last set ends the stream, its
+*  buffer may be empty. Further inputs are refused till the encoder is reset
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_queue_input(iv_obj_t *ps_codec_obj,
+                          void *pv_api_ip,
+                          void *pv_api_op)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = (codec_t *) ps_codec_obj->pv_codec_handle;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    /* queue call I/O structures */
+    ih264e_queue_inp_ip_t *ps_ip = pv_api_ip;
+    ih264e_queue_inp_op_t *ps_op = pv_api_op;
+
+    /* error status */
+    IH264E_ERROR_T error_status = IH264E_SUCCESS;
+
+    /* temp var */
+    WORD32 idx;
+
+    ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
+
+    /* recon is returned by synchronous encode calls only */
+    if (ps_codec->s_cfg.u4_enable_recon)
+    {
+        error_status = IH264E_ASYNC_INVALID_CALL;
+    }
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_UNSUPPORTEDPARAM,
+                        ps_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while (1)
+    {
+        if (ps_async->i4_last_inp_queued || ps_async->i4_eos)
+        {
+            error_status = IH264E_ASYNC_INVALID_CALL;
+            break;
+        }
+
+        if (ps_async->i4_inp_q_cnt + ps_async->i4_inp_busy_cnt
+                        + ps_async->i4_inp_done_cnt < MAX_ASYNC_INP_BUFS)
+        {
+            break;
+        }
+
+        if (0 == ps_ip->s_ive_ip.u4_is_blocking)
+        {
+            error_status = IH264E_QUEUE_FULL;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if (IH264E_SUCCESS == error_status)
+    {
+        error_status = ih264e_async_launch(ps_codec_obj);
+    }
+
+    if (IH264E_SUCCESS == error_status)
+    {
+        idx = (ps_async->i4_inp_q_rd + ps_async->i4_inp_q_cnt) % MAX_ASYNC_INP_BUFS;
+        ps_async->as_inp_q[idx] = ps_ip->s_ive_ip;
+        ps_async->i4_inp_q_cnt++;
+
+        if (ps_ip->s_ive_ip.u4_is_last)
+        {
+            ps_async->i4_last_inp_queued = 1;
+        }
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_UNSUPPORTEDPARAM,
+                        ps_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    return IV_SUCCESS;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns an input buffer the encoder is done with
+*
+* @par Description:
+*  Inputs are returned along with the mb info, pic info and timestamp they
+*  were queued with. Blocks till an input is released, if asked to, and fails
+*  otherwise. Fails once the stream has ended and all inputs are returned
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_dequeue_input(iv_obj_t *ps_codec_obj,
+                            void *pv_api_ip,
+                            void *pv_api_op)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = (codec_t *) ps_codec_obj->pv_codec_handle;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    /* dequeue call I/O structures */
+    ih264e_dequeue_inp_ip_t *ps_ip = pv_api_ip;
+    ih264e_dequeue_inp_op_t *ps_op = pv_api_op;
+
+    /* error status */
+    IH264E_ERROR_T error_status = IH264E_SUCCESS;
+
+    ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while (0 == ps_async->i4_inp_done_cnt)
+    {
+        if ((0 == ps_ip->s_ive_ip.u4_is_blocking) || ps_async->i4_eos)
+        {
+            error_status = IH264E_QUEUE_EMPTY;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if (IH264E_SUCCESS == error_status)
+    {
+        ive_queue_inp_ip_t *ps_inp = &ps_async->as_inp_done[ps_async->i4_inp_done_rd];
+
+        ps_op->s_ive_op.s_inp_buf = ps_inp->s_inp_buf;
+        ps_op->s_ive_op.u4_mb_info_type = ps_inp->u4_mb_info_type;
+        ps_op->s_ive_op.u4_mb_info_size = ps_inp->u4_mb_info_size;
+        ps_op->s_ive_op.pv_mb_info = ps_inp->pv_mb_info;
+        ps_op->s_ive_op.u4_pic_info_type = ps_inp->u4_pic_info_type;
+        ps_op->s_ive_op.pv_pic_info = ps_inp->pv_pic_info;
+        ps_op->s_ive_op.u4_timestamp_low = ps_inp->u4_timestamp_low;
+        ps_op->s_ive_op.u4_timestamp_high = ps_inp->u4_timestamp_high;
+        ps_op->s_ive_op.u4_is_last = ps_inp->u4_is_last;
+
+        ps_async->i4_inp_done_rd = (ps_async->i4_inp_done_rd + 1) % MAX_ASYNC_INP_BUFS;
+        ps_async->i4_inp_done_cnt--;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_UNSUPPORTEDPARAM,
+                        ps_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    return IV_SUCCESS;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues a bitstream buffer to be filled
+*
+* @par Description:
+*  Blocks while the app has MAX_ASYNC_OUT_BUFS bitstream buffers outstanding,
+*  if asked to, and fails otherwise. Buffers are refused once the stream has
+*  ended
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_queue_output(iv_obj_t *ps_codec_obj,
+                           void *pv_api_ip,
+                           void *pv_api_op)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = (codec_t *) ps_codec_obj->pv_codec_handle;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    /* queue call I/O structures */
+    ih264e_queue_out_ip_t *ps_ip = pv_api_ip;
+    ih264e_queue_out_op_t *ps_op = pv_api_op;
+
+    /* error status */
+    IH264E_ERROR_T error_status = IH264E_SUCCESS;
+
+    /* temp var */
+    WORD32 idx;
+
+    ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
+
+    if (ps_ip->s_ive_ip.s_out_buf.u4_bufsize < MIN_STREAM_SIZE)
+    {
+        error_status = IH264E_INSUFFICIENT_OUTPUT_BUFFER;
+    }
+    else if (ps_codec->s_cfg.u4_enable_recon)
+    {
+        error_status = IH264E_ASYNC_INVALID_CALL;
+    }
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_UNSUPPORTEDPARAM,
+                        ps_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while (1)
+    {
+        if (ps_async->i4_eos)
+        {
+            error_status = IH264E_ASYNC_INVALID_CALL;
+            break;
+        }
+
+        if (ps_async->i4_out_q_cnt + ps_async->i4_out_busy_cnt
+                        + ps_async->i4_out_done_cnt < MAX_ASYNC_OUT_BUFS)
+        {
+            break;
+        }
+
+        if (0 == ps_ip->s_ive_ip.u4_is_blocking)
+        {
+            error_status = IH264E_QUEUE_FULL;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if (IH264E_SUCCESS == error_status)
+    {
+        error_status = ih264e_async_launch(ps_codec_obj);
+    }
+
+    if (IH264E_SUCCESS == error_status)
+    {
+        idx = (ps_async->i4_out_q_rd + ps_async->i4_out_q_cnt) % MAX_ASYNC_OUT_BUFS;
+        ps_async->as_out_q[idx] = ps_ip->s_ive_ip.s_out_buf;
+        ps_async->as_out_q[idx].u4_bytes = 0;
+        ps_async->i4_out_q_cnt++;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_UNSUPPORTEDPARAM,
+                        ps_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    return IV_SUCCESS;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns a bitstream buffer filled by the encoder
+*
+* @par Description:
+*  Buffers are returned in encode order along with the timestamp and frame
+*  type of the picture coded in them. Once the stream has ended the unused
+*  buffers are returned empty, and the last buffer has u4_is_last set. Blocks
+*  till a buffer is filled, if asked to, and fails otherwise. Once all buffers
+*  are returned, the call returns no buffer with u4_is_last set, or fails with
+*  the error of the failed encode call if any
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_dequeue_output(iv_obj_t *ps_codec_obj,
+                             void *pv_api_ip,
+                             void *pv_api_op)
+{
+    /* codec ctxt */
+    codec_t *ps_codec = (codec_t *) ps_codec_obj->pv_codec_handle;
+
+    /* async ctxt */
+    async_ctxt_t *ps_async = &ps_codec->s_async;
+
+    /* dequeue call I/O structures */
+    ih264e_dequeue_out_ip_t *ps_ip = pv_api_ip;
+    ih264e_dequeue_out_op_t *ps_op = pv_api_op;
+
+    /* error status */
+    IH264E_ERROR_T error_status = IH264E_SUCCESS;
+
+    ps_op->s_ive_op.u4_error_code = IV_SUCCESS;
+    ps_op->s_ive_op.s_out_buf.pv_buf = NULL;
+    ps_op->s_ive_op.s_out_buf.u4_bytes = 0;
+    ps_op->s_ive_op.s_out_buf.u4_bufsize = 0;
+    ps_op->s_ive_op.u4_timestamp_low = 0;
+    ps_op->s_ive_op.u4_timestamp_high = 0;
+    ps_op->s_ive_op.u4_is_last = 0;
+    ps_op->u4_encoded_frame_type = IV_NA_FRAME;
+
+    ithread_mutex_lock(ps_async->pv_mutex);
+
+    while (0 == ps_async->i4_out_done_cnt)
+    {
+        if (ps_async->i4_eos)
+        {
+            break;
+        }
+
+        if (0 == ps_ip->s_ive_ip.u4_is_blocking)
+        {
+            error_status = IH264E_QUEUE_EMPTY;
+            break;
+        }
+
+        ithread_cond_wait(ps_async->pv_cond, ps_async->pv_mutex);
+    }
+
+    if (ps_async->i4_out_done_cnt)
+    {
+        async_out_buf_t *ps_out = &ps_async->as_out_done[ps_async->i4_out_done_rd];
+
+        ps_op->s_ive_op.s_out_buf = ps_out->s_bits_buf;
+        ps_op->s_ive_op.u4_timestamp_low = ps_out->u4_timestamp_low;
+        ps_op->s_ive_op.u4_timestamp_high = ps_out->u4_timestamp_high;
+        ps_op->s_ive_op.u4_is_last = ps_out->u4_is_last;
+        ps_op->u4_encoded_frame_type = ps_out->u4_encoded_frame_type;
+
+        ps_async->i4_out_done_rd = (ps_async->i4_out_done_rd + 1) % MAX_ASYNC_OUT_BUFS;
+        ps_async->i4_out_done_cnt--;
+
+        ithread_cond_broadcast(ps_async->pv_cond);
+    }
+    else if (ps_async->i4_eos)
+    {
+        ps_op->s_ive_op.u4_is_last = 1;
+        error_status = (IH264E_ERROR_T) ps_async->u4_error_code;
+    }
+
+    ithread_mutex_unlock(ps_async->pv_mutex);
+
+    if (error_status != IH264E_SUCCESS)
+    {
+        /* the error of a failed encode call carries its severity */
+        ps_op->s_ive_op.u4_error_code = error_status;
+        if (IH264E_QUEUE_EMPTY == error_status)
+        {
+            ps_op->s_ive_op.u4_error_code |= 1 << IVE_UNSUPPORTEDPARAM;
+        }
+        return IV_FAIL;
+    }
+
+    return IV_SUCCESS;
+}
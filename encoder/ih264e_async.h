@@ -0,0 +1,183 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_async.h
+*
+* @brief
+*  This file contains declarations of functions of the asynchronous (queue /
+*  dequeue) encode interface
+*
+* @author
+*  ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef IH264E_ASYNC_H_
+#define IH264E_ASYNC_H_
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Empties the queues of the asynchronous interface
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+void ih264e_async_init(codec_t *ps_codec);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Entry point of the encode thread of the asynchronous interface
+*
+* @param[in] pv_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+WORD32 ih264e_async_thread(void *pv_codec);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Stops the encode thread of the asynchronous interface, if running
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+void ih264e_async_stop(codec_t *ps_codec);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues an input buffer to be encoded (IVE_CMD_QUEUE_INPUT)
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+*******************************************************************************
+*/
+WORD32 ih264e_queue_input(iv_obj_t *ps_codec_obj,
+                          void *pv_api_ip,
+                          void *pv_api_op);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns an input buffer the encoder is done with (IVE_CMD_DEQUEUE_INPUT)
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+*******************************************************************************
+*/
+WORD32 ih264e_dequeue_input(iv_obj_t *ps_codec_obj,
+                            void *pv_api_ip,
+                            void *pv_api_op);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues a bitstream buffer to be filled (IVE_CMD_QUEUE_OUTPUT)
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+*******************************************************************************
+*/
+WORD32 ih264e_queue_output(iv_obj_t *ps_codec_obj,
+                           void *pv_api_ip,
+                           void *pv_api_op);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns a bitstream buffer filled by the encoder (IVE_CMD_DEQUEUE_OUTPUT)
+*
+* @param[in] ps_codec_obj
+*  Pointer to codec object at API level
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  error status
+*
+*******************************************************************************
+*/
+WORD32 ih264e_dequeue_output(iv_obj_t *ps_codec_obj,
+                             void *pv_api_ip,
+                             void *pv_api_op);
+
+#endif /* IH264E_ASYNC_H_ */
@@ -324,6 +324,10 @@ static void ih264e_cabac_enc_intra_mb_type(UWORD32 u4_slice_type,
  *  Pointer to array containing prev_intra4x4_pred_mode_flag and
  *  rem_intra4x4_pred_mode
  *
+ *  @param[in] i4_num_sub_blks
+ *  Number of sub blocks, 16 for I4x4 and 4 for I8x8 (the contexts of
+ *  prev_intra8x8_pred_mode_flag and rem_intra8x8_pred_mode are shared)
+ *
  * @returns
  *
  * @remarks
@@ -332,11 +336,12 @@ static void ih264e_cabac_enc_intra_mb_type(UWORD32 u4_slice_type,
  *******************************************************************************
  */
 static void ih264e_cabac_enc_4x4mb_modes(cabac_ctxt_t *ps_cabac_ctxt,
-                                         UWORD8 *pu1_intra_4x4_modes)
+                                         UWORD8 *pu1_intra_4x4_modes,
+                                         WORD32 i4_num_sub_blks)
 {
     WORD32 i;
     WORD8 byte;
-    for (i = 0; i < 16; i += 2)
+    for (i = 0; i < i4_num_sub_blks; i += 2)
     {
         /* sub blk idx 1 */
         byte = pu1_intra_4x4_modes[i >> 1];
@@ -866,6 +871,168 @@ static void ih264e_cabac_write_coeff4x4(WORD16 *pi2_res_block, UWORD8 u1_nnz,
 }
 
 
+/* ctxIdxInc of significant_coeff_flag of an 8x8 luma block in frame coded
+ * macroblocks, Table 9-43 of ITU_T_H264-201402 */
+static const UWORD8 gu1_sig_coeff_ctxinc_8x8_frame[64] =
+    { 0, 1, 2, 3, 4, 5, 5, 4, 4, 3, 3, 4, 4, 4, 5, 5,
+      4, 4, 4, 4, 3, 3, 6, 7, 7, 7, 8, 9, 10, 9, 8, 7,
+      7, 6, 11, 12, 13, 11, 6, 7, 8, 9, 14, 10, 9, 8, 6, 11,
+      12, 13, 11, 6, 9, 14, 10, 9, 11, 12, 13, 11, 14, 10, 12, 0 };
+
+/* ctxIdxInc of last_significant_coeff_flag of an 8x8 luma block,
+ * Table 9-43 of ITU_T_H264-201402 */
+static const UWORD8 gu1_last_coeff_ctxinc_8x8[64] =
+    { 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+      2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+      3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4,
+      5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 0 };
+
+/**
+ *******************************************************************************
+ * @brief
+ *  Encodes residual_block_cabac of an 8x8 luma block (ctxBlockCat 5)
+ *
+ * @param[in] pi2_res_block
+ *  pointer to the non zero coeffs of the block in scan order
+ *
+ * @param[in]  u1_nnz
+ *  Number of non zero coeffs in the block
+ *
+ * @param[in] pu1_sig_coeff
+ *  significance of each of the 64 coeffs of the block in scan order
+ *
+ * @param[in] ps_cabac_ctxt
+ *  Pointer to cabac context structure
+ *
+ * @returns
+ *
+ * @remarks
+ *  coded_block_flag is not coded for 8x8 blocks (4:2:0), it is inferred as 1
+ *
+ *******************************************************************************
+ */
+static void ih264e_cabac_write_coeff8x8(WORD16 *pi2_res_block, UWORD8 u1_nnz,
+                                        UWORD8 *pu1_sig_coeff,
+                                        cabac_ctxt_t *ps_cabac_ctxt)
+{
+    bin_ctxt_model *pu1_ctxt_table = ps_cabac_ctxt->au1_cabac_ctxt_table;
+    WORD32 i, i4_last_sig_coef_index;
+    WORD16 *pi16_coeffs;
+
+    /* index of the last significant coeff */
+    for (i4_last_sig_coef_index = 63; !pu1_sig_coeff[i4_last_sig_coef_index];
+                    i4_last_sig_coef_index--);
+
+    /* Encode significant_coeff_flag and last_significant_coeff_flag */
+    for (i = 0; i < 63; i++)
+    {
+        ih264e_cabac_encode_bin(ps_cabac_ctxt, pu1_sig_coeff[i],
+                                pu1_ctxt_table + SIGNIFICANT_COEFF_FLAG_8X8_FRAME
+                                    + gu1_sig_coeff_ctxinc_8x8_frame[i]);
+        if (pu1_sig_coeff[i])
+        {
+            ih264e_cabac_encode_bin(ps_cabac_ctxt,
+                                    (i == i4_last_sig_coef_index),
+                                    pu1_ctxt_table + LAST_SIGNIFICANT_COEFF_FLAG_8X8_FRAME
+                                        + gu1_last_coeff_ctxinc_8x8[i]);
+            if (i == i4_last_sig_coef_index)
+                break;
+        }
+    }
+
+    /* Encode coeff_abs_level_minus1 and coeff_sign_flag */
+    {
+        UWORD8 u1_sign;
+        UWORD16 u2_abs_level;
+        UWORD8 u1_abs_level_equal1 = 1, u1_abs_level_gt1 = 0;
+        UWORD32 u4_bins, u4_ctx_inc;
+        UWORD8 u1_ctx_inc;
+        UWORD8 u1_coff = 14;
+        WORD16 i2_sufs;
+        WORD8 i1_bins_len;
+
+        for (pi16_coeffs = pi2_res_block + u1_nnz - 1;
+                        pi16_coeffs >= pi2_res_block; pi16_coeffs--)
+        {
+            /* Encode the AbsLevelMinus1 */
+            u2_abs_level = ABS(*(pi16_coeffs)) - 1;
+            /* CtxInc for bin0 */
+            u4_ctx_inc = MIN(u1_abs_level_equal1, 4);
+            /* CtxInc for remaining */
+            u1_ctx_inc = 5 + MIN(u1_abs_level_gt1, 4);
+            u4_ctx_inc = u4_ctx_inc + (u1_ctx_inc << 4);
+            if (u2_abs_level)
+            {
+                u1_abs_level_gt1++;
+                u1_abs_level_equal1 = 0;
+            }
+            if (!u1_abs_level_gt1)
+                u1_abs_level_equal1++;
+
+            if (u2_abs_level >= u1_coff)
+            {
+                /* Prefix TU i.e string of 14 1's */
+                u4_bins = 0x3fff;
+                i1_bins_len = 14;
+                ih264e_encode_decision_bins(u4_bins, i1_bins_len, u4_ctx_inc, 1,
+                                            pu1_ctxt_table + COEFF_ABS_LEVEL_MINUS1_8X8,
+                                            ps_cabac_ctxt);
+
+                /* Suffix, uses EncodeBypass */
+                i2_sufs = u2_abs_level - u1_coff;
+
+                u4_bins = ih264e_cabac_UEGk0_binarization(i2_sufs, &i1_bins_len);
+
+                ih264e_cabac_encode_bypass_bins(ps_cabac_ctxt, u4_bins,
+                                                i1_bins_len);
+            }
+            else
+            {
+                /* Prefix only */
+                u4_bins = (1 << u2_abs_level) - 1;
+                i1_bins_len = u2_abs_level + 1;
+                ih264e_encode_decision_bins(u4_bins, i1_bins_len, u4_ctx_inc, 1,
+                                            pu1_ctxt_table + COEFF_ABS_LEVEL_MINUS1_8X8,
+                                            ps_cabac_ctxt);
+            }
+
+            /* encode coeff_sign_flag[i] */
+            u1_sign = ((*pi16_coeffs) < 0) ? 1 : 0;
+            ih264e_cabac_encode_bypass_bin(ps_cabac_ctxt, u1_sign);
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief
+ *  Encodes transform_size_8x8_flag of the MB
+ *
+ * @param[in] u1_transform_8x8_flag
+ *  transform_size_8x8_flag
+ *
+ * @param[in] ps_cabac_ctxt
+ *  Pointer to cabac context structure
+ *
+ * @returns
+ *
+ * @remarks
+ *  ctxIdxInc is derived as per 9.3.3.1.1.10 of ITU_T_H264-201402
+ *
+ *******************************************************************************
+ */
+static void ih264e_cabac_enc_transform_size_8x8_flag(UWORD8 u1_transform_8x8_flag,
+                                                     cabac_ctxt_t *ps_cabac_ctxt)
+{
+    UWORD32 u4_ctx_inc = ps_cabac_ctxt->ps_left_ctxt_mb_info->u1_transform8x8_ctxt
+                    + ps_cabac_ctxt->ps_top_ctxt_mb_info->u1_transform8x8_ctxt;
+
+    ih264e_cabac_encode_bin(ps_cabac_ctxt, u1_transform_8x8_flag,
+                            ps_cabac_ctxt->au1_cabac_ctxt_table
+                                + TRANSFORM_SIZE_8X8_FLAG + u4_ctx_inc);
+}
+
+
 /**
  *******************************************************************************
  * @brief
@@ -1129,7 +1296,7 @@ static void ih264e_cabac_write_chroma_residue(entropy_ctxt_t *ps_ent_ctxt,
  * coded block pattern
  *
  * @param[in] u1_ctx_cat
- * Context category, LUMA_AC_CTXCAT or LUMA_4x4_CTXCAT
+ * Context category, LUMA_AC_CTXCAT, LUMA_4x4_CTXCAT or LUMA_8X8_CTXCAT
  *
  * @returns
  *
@@ -1159,7 +1326,68 @@ static void ih264e_cabac_encode_residue(entropy_ctxt_t *ps_ent_ctxt,
     u1_left_ac_csbp = ps_cabac_ctxt->pu1_left_y_ac_csbp[0];
     u1_top_ac_csbp = ps_top_ctxt->u1_yuv_ac_csbp;
 
-    if (u4_cbp & 0xf)
+    if ((u4_cbp & 0xf) && (u1_ctx_cat == LUMA_8X8_CTXCAT))
+    {
+        /*  Write luma residue of 8x8 transform blocks  */
+        WORD16 ai2_coeffs[64];
+        UWORD8 au1_sig_coeff[64];
+        WORD16 *api2_res_block[4];
+        UWORD16 au2_sig_coeff_map[4];
+        UWORD8 au1_nnz[4];
+        UWORD8 u1_b8, u1_b4, u1_top_mask, u1_left_mask;
+        WORD32 i;
+
+        for (u1_b8 = 0; u1_b8 < 4; u1_b8++)
+        {
+            /* csbp bits of the 4x4 blocks covered by the 8x8 block */
+            u1_top_mask = 3 << ((u1_b8 & 1) << 1);
+            u1_left_mask = 3 << ((u1_b8 >> 1) << 1);
+
+            if (!((u4_cbp >> u1_b8) & 0x1))
+            {
+                u1_top_ac_csbp &= ~u1_top_mask;
+                u1_left_ac_csbp &= ~u1_left_mask;
+                continue;
+            }
+
+            /* the 8x8 block is packed as 4 interleaved 4x4 units, coeff i of
+             * unit k is the (4 * i + k)th coeff of the 8x8 block */
+            for (u1_b4 = 0; u1_b4 < 4; u1_b4++)
+            {
+                au2_sig_coeff_map[u1_b4] = 0;
+                PARSE_COEFF_DATA_BLOCK_4x4(pv_mb_coeff_data, ps_mb_coeff_data,
+                                           au1_nnz[u1_b4],
+                                           au2_sig_coeff_map[u1_b4],
+                                           api2_res_block[u1_b4]);
+            }
+
+            u1_nnz = 0;
+            for (i = 0; i < 64; i++)
+            {
+                u1_b4 = i & 3;
+                au1_sig_coeff[i] = (au2_sig_coeff_map[u1_b4] >> (i >> 2)) & 0x1;
+                if (au1_sig_coeff[i])
+                {
+                    ai2_coeffs[u1_nnz++] = *api2_res_block[u1_b4]++;
+                }
+            }
+
+            ih264e_cabac_write_coeff8x8(ai2_coeffs, u1_nnz, au1_sig_coeff,
+                                        ps_cabac_ctxt);
+
+            /* coded_block_flag of an 8x8 block is inferred to be 1 */
+            u1_top_ac_csbp |= u1_top_mask;
+            u1_left_ac_csbp |= u1_left_mask;
+        }
+        /**************************************************************************/
+        /*                   Update the AC csbp                                   */
+        /**************************************************************************/
+        ps_cabac_ctxt->pu1_left_y_ac_csbp[0] = u1_left_ac_csbp & 0xf;
+        u1_top_ac_csbp &= 0x0f;
+        ps_curr_ctxt->u1_yuv_ac_csbp &= 0xf0;
+        ps_curr_ctxt->u1_yuv_ac_csbp |= u1_top_ac_csbp;
+    }
+    else if (u4_cbp & 0xf)
     {
         /*  Write luma residue  */
         UWORD8 u1_offset;
@@ -1438,7 +1666,7 @@ static void ih264e_cabac_enc_ctx_mvd(WORD16 u1_mvd, UWORD32 u4_ctx_idx_offset,
 /**
  *******************************************************************************
  * @brief
- * Encodes all motion vectors for a P16x16 MB
+ * Encodes all motion vectors for a P MB (P16x16, P16x8, P8x16 or P8x8)
  *
  * @param[in] ps_cabac_ctxt
  *  Pointer to cabac context structure
@@ -1446,28 +1674,58 @@ static void ih264e_cabac_enc_ctx_mvd(WORD16 u1_mvd, UWORD32 u4_ctx_idx_offset,
  * @param[in] pi2_mv_ptr
  * Pointer to array of motion vectors
  *
+ * @param[in] u4_mb_type
+ * mb type of the current MB
+ *
  * @returns
  *
  * @remarks
- *  None
+ *  The abs mvd contexts are tracked at 8x8 granularity: top context entry 'n'
+ *  holds the bottom partition of 8x8 column 'n' and left context entry 'n'
+ *  holds the right partition of 8x8 row 'n'.
  *
  *******************************************************************************
  */
-static void ih264e_cabac_enc_mvds_p16x16(cabac_ctxt_t *ps_cabac_ctxt,
-                                         WORD16 *pi2_mv_ptr)
+static void ih264e_cabac_enc_mvds_p(cabac_ctxt_t *ps_cabac_ctxt,
+                                    WORD16 *pi2_mv_ptr,
+                                    UWORD32 u4_mb_type)
 {
+    UWORD32 u4_num_parts = 1;
+    UWORD32 i, j;
 
+    if (u4_mb_type == P16x8 || u4_mb_type == P8x16)
+        u4_num_parts = 2;
+    else if (u4_mb_type == P8x8)
+        u4_num_parts = 4;
 
     /* Encode the differential component of the motion vectors */
-
+    for (i = 0; i < u4_num_parts; i++)
     {
         UWORD8 u1_abs_mvd_x, u1_abs_mvd_y;
         UWORD8 *pu1_top_mv_ctxt, *pu1_lft_mv_ctxt;
         WORD16 u2_mv;
-        u1_abs_mvd_x = 0;
-        u1_abs_mvd_y = 0;
-        pu1_top_mv_ctxt = ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[0];
-        pu1_lft_mv_ctxt = ps_cabac_ctxt->pu1_left_mv_ctxt_inc[0];
+        UWORD32 u4_x = 0, u4_y = 0, u4_wd = 2, u4_ht = 2;
+
+        /* partition geometry in 8x8 units */
+        if (u4_mb_type == P16x8)
+        {
+            u4_y = i;
+            u4_ht = 1;
+        }
+        else if (u4_mb_type == P8x16)
+        {
+            u4_x = i;
+            u4_wd = 1;
+        }
+        else if (u4_mb_type == P8x8)
+        {
+            u4_x = i & 1;
+            u4_y = i >> 1;
+            u4_wd = u4_ht = 1;
+        }
+
+        pu1_top_mv_ctxt = ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[u4_x];
+        pu1_lft_mv_ctxt = ps_cabac_ctxt->pu1_left_mv_ctxt_inc[u4_y];
         {
             UWORD16 u2_abs_mvd_x_a, u2_abs_mvd_x_b, u2_abs_mvd_y_a,
                             u2_abs_mvd_y_b;
@@ -1493,8 +1751,16 @@ static void ih264e_cabac_enc_mvds_p16x16(cabac_ctxt_t *ps_cabac_ctxt,
         /***************************************************************/
         /* Store abs_mvd_values cabac contexts                         */
         /***************************************************************/
-        pu1_top_mv_ctxt[0] = pu1_lft_mv_ctxt[0] = u1_abs_mvd_x;
-        pu1_top_mv_ctxt[1] = pu1_lft_mv_ctxt[1] = u1_abs_mvd_y;
+        for (j = u4_x; j < u4_x + u4_wd; j++)
+        {
+            ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[j][0] = u1_abs_mvd_x;
+            ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[j][1] = u1_abs_mvd_y;
+        }
+        for (j = u4_y; j < u4_y + u4_ht; j++)
+        {
+            ps_cabac_ctxt->pu1_left_mv_ctxt_inc[j][0] = u1_abs_mvd_x;
+            ps_cabac_ctxt->pu1_left_mv_ctxt_inc[j][1] = u1_abs_mvd_y;
+        }
     }
 }
 
@@ -1669,11 +1935,24 @@ IH264E_ERROR_T ih264e_write_islice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
     ih264e_cabac_enc_intra_mb_type(ISLICE, luma_intra_mode, ps_cabac_ctxt,
                                    MB_TYPE_I_SLICE);
 
-    if (mb_type == I4x4)
+    if (mb_type == I4x4 || mb_type == I8x8)
     {
-        /* Encode 4x4 MB modes */
-        mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
-        ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes);
+        /* Encode transform_size_8x8_flag */
+        if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+            ih264e_cabac_enc_transform_size_8x8_flag(mb_type == I8x8, ps_cabac_ctxt);
+
+        if (mb_type == I4x4)
+        {
+            /* Encode 4x4 MB modes */
+            mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
+            ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes, 16);
+        }
+        else
+        {
+            /* Encode 8x8 MB modes */
+            mb_hdr_i8x8_t *ps_mb_hdr_i8x8 = (mb_hdr_i8x8_t *)ps_ent_ctxt->pv_mb_header_data;
+            ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i8x8->au1_sub_blk_modes, 4);
+        }
     }
     /* Encode chroma mode */
     ih264e_cabac_enc_chroma_predmode(chroma_intra_mode, ps_cabac_ctxt);
@@ -1705,7 +1984,8 @@ IH264E_ERROR_T ih264e_write_islice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             ps_curr_ctxt->u1_cbp = cbp;
             ps_curr_ctxt->u1_mb_type = I4x4;
             ps_curr_ctxt->u1_mb_type = CAB_I4x4;
-            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp, LUMA_4X4_CTXCAT);
+            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp,
+                                       (mb_type == I8x8) ? LUMA_8X8_CTXCAT : LUMA_4X4_CTXCAT);
             ps_cabac_ctxt->pu1_left_yuv_dc_csbp[0] &= 0x6;
             ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_yuv_dc_csbp &= 0x6;
         }
@@ -1737,11 +2017,17 @@ IH264E_ERROR_T ih264e_write_islice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
         ps_curr_ctxt->u1_mb_type = CAB_I16x16;
         pu1_byte += sizeof(mb_hdr_i16x16_t);
     }
+    else if (mb_type == I8x8)
+    {
+        ps_curr_ctxt->u1_mb_type = CAB_I4x4;
+        pu1_byte += sizeof(mb_hdr_i8x8_t);
+    }
     else
     {
         ps_curr_ctxt->u1_mb_type = CAB_I4x4;
         pu1_byte += sizeof(mb_hdr_i4x4_t);
     }
+    ps_curr_ctxt->u1_transform8x8_ctxt = (mb_type == I8x8);
     ps_ent_ctxt->pv_mb_header_data = pu1_byte;
     return IH264E_SUCCESS;
 }
@@ -1798,7 +2084,7 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
     ps_curr_ctxt = ps_cabac_ctxt->ps_curr_ctxt_mb_info;
 
     /* if Intra MB */
-    if (mb_type == I16x16 || mb_type == I4x4)
+    if (mb_type == I16x16 || mb_type == I4x4 || mb_type == I8x8)
     {
         cbp = ps_mb_hdr->u1_cbp;
         mb_qp_delta = ps_mb_hdr->u1_mb_qp_delta;
@@ -1830,11 +2116,24 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
                                            ps_cabac_ctxt, MB_TYPE_P_SLICE);
         }
 
-        if (mb_type == I4x4)
+        if (mb_type == I4x4 || mb_type == I8x8)
         {
-            /* Intra 4x4 modes */
-            mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
-            ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes);
+            /* Encode transform_size_8x8_flag */
+            if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+                ih264e_cabac_enc_transform_size_8x8_flag(mb_type == I8x8, ps_cabac_ctxt);
+
+            if (mb_type == I4x4)
+            {
+                /* Encode 4x4 MB modes */
+                mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
+                ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes, 16);
+            }
+            else
+            {
+                /* Encode 8x8 MB modes */
+                mb_hdr_i8x8_t *ps_mb_hdr_i8x8 = (mb_hdr_i8x8_t *)ps_ent_ctxt->pv_mb_header_data;
+                ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i8x8->au1_sub_blk_modes, 4);
+            }
         }
         chroma_intra_mode = (mb_tpm >> 6);
 
@@ -1870,7 +2169,8 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
                 ps_curr_ctxt->u1_cbp = (UWORD8) cbp;
                 ps_curr_ctxt->u1_mb_type = I4x4;
                 ps_curr_ctxt->u1_mb_type = CAB_I4x4;
-                ih264e_cabac_encode_residue(ps_ent_ctxt, cbp, LUMA_4X4_CTXCAT);
+                ih264e_cabac_encode_residue(ps_ent_ctxt, cbp,
+                                           (mb_type == I8x8) ? LUMA_8X8_CTXCAT : LUMA_4X4_CTXCAT);
                 ps_cabac_ctxt->pu1_left_yuv_dc_csbp[0] &= 0x6;
                 ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_yuv_dc_csbp &= 0x6;
             }
@@ -1902,11 +2202,17 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             ps_curr_ctxt->u1_mb_type = CAB_I16x16;
             pu1_byte += sizeof(mb_hdr_i16x16_t);
         }
+        else if (mb_type == I8x8)
+        {
+            ps_curr_ctxt->u1_mb_type = CAB_I4x4;
+            pu1_byte += sizeof(mb_hdr_i8x8_t);
+        }
         else
         {
             ps_curr_ctxt->u1_mb_type = CAB_I4x4;
             pu1_byte += sizeof(mb_hdr_i4x4_t);
         }
+        ps_curr_ctxt->u1_transform8x8_ctxt = (mb_type == I8x8);
 
         ps_ent_ctxt->pv_mb_header_data = pu1_byte;
 
@@ -1916,37 +2222,72 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
     {
         /* Starting bitstream offset for header in bits */
         bitstream_start_offset = GET_NUM_BITS(ps_bitstream);
-        /* Encoding P16x16 */
+        /* Encoding P16x16, P16x8, P8x16 or P8x8 */
         if (mb_type != PSKIP)
         {
-            mb_hdr_p16x16_t *ps_mb_hdr_p16x16 = (mb_hdr_p16x16_t *)ps_ent_ctxt->pv_mb_header_data;
+            WORD16 *pi2_mv_ptr;
+            UWORD32 u4_bins = 0, u4_ctx_inc_p = (0x010 + ((2) << 8));
+
             cbp = ps_mb_hdr->u1_cbp;
             mb_qp_delta = ps_mb_hdr->u1_mb_qp_delta;
 
             /* Encoding mb_skip */
             ih264e_cabac_enc_mb_skip(0, ps_cabac_ctxt, MB_SKIP_FLAG_P_SLICE);
 
-            /* Encoding mb_type as P16x16 */
+            /* Encoding mb_type, bins are '000' (P16x16), '011' (P16x8), */
+            /* '010' (P8x16) and '001' (P8x8). ctxIdxInc of third bin is */
+            /* 3 when the second bin is 1 and 2 otherwise                */
+            if (mb_type == P16x8)
+            {
+                u4_bins = 6;
+                u4_ctx_inc_p = (0x010 + ((3) << 8));
+            }
+            else if (mb_type == P8x16)
+            {
+                u4_bins = 2;
+                u4_ctx_inc_p = (0x010 + ((3) << 8));
+            }
+            else if (mb_type == P8x8)
             {
-                UWORD32 u4_ctx_inc_p;
-                u4_ctx_inc_p = (0x010 + ((2) << 8));
+                u4_bins = 4;
+            }
+            ih264e_encode_decision_bins(u4_bins, 3, u4_ctx_inc_p, 3,
+                                        &(ps_cabac_ctxt->au1_cabac_ctxt_table[MB_TYPE_P_SLICE]),
+                                        ps_cabac_ctxt);
 
-                ih264e_encode_decision_bins(0, 3, u4_ctx_inc_p, 3,
-                                            &(ps_cabac_ctxt->au1_cabac_ctxt_table[MB_TYPE_P_SLICE]),
-                                            ps_cabac_ctxt);
+            /* sub_mb_type is always P_L0_8x8, coded as the single bin '1' */
+            if (mb_type == P8x8)
+            {
+                WORD32 i;
+
+                for (i = 0; i < 4; i++)
+                {
+                    ih264e_cabac_encode_bin(ps_cabac_ctxt, 1,
+                                            ps_cabac_ctxt->au1_cabac_ctxt_table
+                                                + SUB_MB_TYPE_P_SLICE);
+                }
             }
             ps_curr_ctxt->u1_mb_type = CAB_P;
+            if (mb_type == P16x8)
+                pi2_mv_ptr = ((mb_hdr_p16x8_t *)ps_mb_hdr)->ai2_mv[0];
+            else if (mb_type == P8x8)
+                pi2_mv_ptr = ((mb_hdr_p8x8_t *)ps_mb_hdr)->ai2_mv[0];
+            else
+                pi2_mv_ptr = (WORD16 *) ((mb_hdr_p16x16_t *)ps_mb_hdr)->ai2_mv;
             {
-                WORD16 *pi2_mv_ptr = (WORD16 *) ps_mb_hdr_p16x16->ai2_mv;
-
                 ps_curr_ctxt->u1_mb_type = (ps_curr_ctxt->u1_mb_type
                                             | CAB_NON_BD16x16);
-                 /* Encoding motion vector for P16x16 */
-                ih264e_cabac_enc_mvds_p16x16(ps_cabac_ctxt, pi2_mv_ptr);
+                 /* Encoding motion vectors */
+                ih264e_cabac_enc_mvds_p(ps_cabac_ctxt, pi2_mv_ptr, mb_type);
             }
             /* Encode CBP */
             ih264e_cabac_enc_cbp(cbp, ps_cabac_ctxt);
 
+            /* Encode transform_size_8x8_flag */
+            if ((cbp & 0xf) && ps_ent_ctxt->i1_transform_8x8_mode_flag)
+                ih264e_cabac_enc_transform_size_8x8_flag(
+                                ps_mb_hdr->u1_transform_8x8_flag, ps_cabac_ctxt);
+
             if (cbp)
             {
                 /* encode mb_qp_delta */
@@ -1960,7 +2301,12 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             /* Starting bitstream offset for residue */
             bitstream_start_offset = bitstream_end_offset;
 
-            pu1_byte += sizeof(mb_hdr_p16x16_t);
+            if (mb_type == P8x8)
+                pu1_byte += sizeof(mb_hdr_p8x8_t);
+            else if (mb_type == P16x8 || mb_type == P8x16)
+                pu1_byte += sizeof(mb_hdr_p16x8_t);
+            else
+                pu1_byte += sizeof(mb_hdr_p16x16_t);
 
         }
         else/* MB = PSKIP */
@@ -1986,7 +2332,9 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
         if (cbp > 0)
         {
             /* Encode residue */
-            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp, LUMA_4X4_CTXCAT);
+            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp,
+                                       ps_mb_hdr->u1_transform_8x8_flag ?
+                                       LUMA_8X8_CTXCAT : LUMA_4X4_CTXCAT);
             /* Ending bitstream offset for reside in bits */
             bitstream_end_offset = GET_NUM_BITS(ps_bitstream);
             ps_ent_ctxt->u4_residue_bits[1] += bitstream_end_offset
@@ -2005,6 +2353,8 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
         }
         ps_curr_ctxt->u1_intrapred_chroma_mode = 0;
         ps_curr_ctxt->u1_cbp = cbp;
+        ps_curr_ctxt->u1_transform8x8_ctxt = (cbp & 0xf) ?
+                        ps_mb_hdr->u1_transform_8x8_flag : 0;
         ps_ent_ctxt->pv_mb_header_data = pu1_byte;
 
         return IH264E_SUCCESS;
@@ -2089,7 +2439,7 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
     ps_curr_ctxt = ps_cabac_ctxt->ps_curr_ctxt_mb_info;
 
     /* if Intra MB */
-    if (mb_type == I16x16 || mb_type == I4x4)
+    if (mb_type == I16x16 || mb_type == I4x4 || mb_type == I8x8)
     {
         cbp = ps_mb_hdr->u1_cbp;
         mb_qp_delta = ps_mb_hdr->u1_mb_qp_delta;
@@ -2138,11 +2488,24 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
 
         }
 
-        if (mb_type == I4x4)
+        if (mb_type == I4x4 || mb_type == I8x8)
         {
-            /* Intra 4x4 modes */
-            mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
-            ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes);
+            /* Encode transform_size_8x8_flag */
+            if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+                ih264e_cabac_enc_transform_size_8x8_flag(mb_type == I8x8, ps_cabac_ctxt);
+
+            if (mb_type == I4x4)
+            {
+                /* Encode 4x4 MB modes */
+                mb_hdr_i4x4_t *ps_mb_hdr_i4x4 = (mb_hdr_i4x4_t *)ps_ent_ctxt->pv_mb_header_data;
+                ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i4x4->au1_sub_blk_modes, 16);
+            }
+            else
+            {
+                /* Encode 8x8 MB modes */
+                mb_hdr_i8x8_t *ps_mb_hdr_i8x8 = (mb_hdr_i8x8_t *)ps_ent_ctxt->pv_mb_header_data;
+                ih264e_cabac_enc_4x4mb_modes(ps_cabac_ctxt, ps_mb_hdr_i8x8->au1_sub_blk_modes, 4);
+            }
         }
         chroma_intra_mode = (mb_tpm >> 6);
 
@@ -2178,7 +2541,8 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
                 ps_curr_ctxt->u1_cbp = (UWORD8) cbp;
                 ps_curr_ctxt->u1_mb_type = I4x4;
                 ps_curr_ctxt->u1_mb_type = CAB_I4x4;
-                ih264e_cabac_encode_residue(ps_ent_ctxt, cbp, LUMA_4X4_CTXCAT);
+                ih264e_cabac_encode_residue(ps_ent_ctxt, cbp,
+                                           (mb_type == I8x8) ? LUMA_8X8_CTXCAT : LUMA_4X4_CTXCAT);
                 ps_cabac_ctxt->pu1_left_yuv_dc_csbp[0] &= 0x6;
                 ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_yuv_dc_csbp &= 0x6;
             }
@@ -2210,11 +2574,17 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             ps_curr_ctxt->u1_mb_type = CAB_I16x16;
             pu1_byte += sizeof(mb_hdr_i16x16_t);
         }
+        else if (mb_type == I8x8)
+        {
+            ps_curr_ctxt->u1_mb_type = CAB_I4x4;
+            pu1_byte += sizeof(mb_hdr_i8x8_t);
+        }
         else
         {
             ps_curr_ctxt->u1_mb_type = CAB_I4x4;
             pu1_byte += sizeof(mb_hdr_i4x4_t);
         }
+        ps_curr_ctxt->u1_transform8x8_ctxt = (mb_type == I8x8);
 
         ps_ent_ctxt->pv_mb_header_data = pu1_byte;
 
@@ -2264,6 +2634,11 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             /* Encode CBP */
             ih264e_cabac_enc_cbp(cbp, ps_cabac_ctxt);
 
+            /* Encode transform_size_8x8_flag */
+            if ((cbp & 0xf) && ps_ent_ctxt->i1_transform_8x8_mode_flag)
+                ih264e_cabac_enc_transform_size_8x8_flag(
+                                ps_mb_hdr->u1_transform_8x8_flag, ps_cabac_ctxt);
+
             if (cbp)
             {
                 /* encode mb_qp_delta */
@@ -2355,6 +2730,11 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             /* Encode CBP */
             ih264e_cabac_enc_cbp(cbp, ps_cabac_ctxt);
 
+            /* Encode transform_size_8x8_flag */
+            if ((cbp & 0xf) && ps_ent_ctxt->i1_transform_8x8_mode_flag)
+                ih264e_cabac_enc_transform_size_8x8_flag(
+                                ps_mb_hdr->u1_transform_8x8_flag, ps_cabac_ctxt);
+
             if (cbp)
             {
                 /* encode mb_qp_delta */
@@ -2374,7 +2754,9 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
         if (cbp > 0)
         {
             /* Encode residue */
-            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp, LUMA_4X4_CTXCAT);
+            ih264e_cabac_encode_residue(ps_ent_ctxt, cbp,
+                                       ps_mb_hdr->u1_transform_8x8_flag ?
+                                       LUMA_8X8_CTXCAT : LUMA_4X4_CTXCAT);
             /* Ending bitstream offset for reside in bits */
             bitstream_end_offset = GET_NUM_BITS(ps_bitstream);
             ps_ent_ctxt->u4_residue_bits[1] += bitstream_end_offset
@@ -2393,6 +2775,8 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
         }
         ps_curr_ctxt->u1_intrapred_chroma_mode = 0;
         ps_curr_ctxt->u1_cbp = cbp;
+        ps_curr_ctxt->u1_transform8x8_ctxt = (cbp & 0xf) ?
+                        ps_mb_hdr->u1_transform_8x8_flag : 0;
         ps_ent_ctxt->pv_mb_header_data = pu1_byte;
         return IH264E_SUCCESS;
     }
@@ -164,6 +164,7 @@ void ih264e_init_cabac_table(entropy_ctxt_t *ps_ent_ctxt)
         ps_def_ctxt->u1_mb_type = CAB_SKIP;
         ps_def_ctxt->u1_cbp = 0x0f;
         ps_def_ctxt->u1_intrapred_chroma_mode = 0;
+        ps_def_ctxt->u1_transform8x8_ctxt = 0;
 
         memset(ps_def_ctxt->i1_ref_idx, 0, sizeof(ps_def_ctxt->i1_ref_idx));
         memset(ps_def_ctxt->u1_mv, 0, sizeof(ps_def_ctxt->u1_mv));
@@ -65,6 +65,7 @@ typedef struct
 
     UWORD8 u1_cbp; /* !< Coded Block Pattern */
     UWORD8 u1_intrapred_chroma_mode;
+    UWORD8 u1_transform8x8_ctxt; /* !< transform_size_8x8_flag of the MB */
 
     /*************************************************************************/
     /*               Arrangnment of AC CSBP                                  */
@@ -1026,6 +1026,12 @@ IH264E_ERROR_T ih264e_write_islice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 0, error_status, "mb type");
 
+        /* transform_size_8x8_flag */
+        if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+        {
+            PUT_BITS(ps_bitstream, 0, 1, error_status, "u4_transform_size_8x8_flag");
+        }
+
         for (i = 0; i < 16; i += 2)
         {
             /* sub blk idx 1 */
@@ -1076,8 +1082,6 @@ IH264E_ERROR_T ih264e_write_islice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
 
         chroma_intra_mode = (mb_tpm >> 6);
 
-        ASSERT(0);
-
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 0, error_status, "mb type");
 
@@ -1085,7 +1089,7 @@ IH264E_ERROR_T ih264e_write_islice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         PUT_BITS(ps_bitstream, u4_transform_size_8x8_flag, 1, error_status, "u4_transform_size_8x8_flag");
 
         /* write sub block modes */
-        for (i = 0; i < 4; i++)
+        for (i = 0; i < 4; i += 2)
         {
             /* sub blk idx 1 */
             byte = ps_mb_hdr_i8x8->au1_sub_blk_modes[i >> 1];
@@ -1308,6 +1312,12 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 5, error_status, "mb type");
 
+        /* transform_size_8x8_flag */
+        if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+        {
+            PUT_BITS(ps_bitstream, 0, 1, error_status, "u4_transform_size_8x8_flag");
+        }
+
         for (i = 0; i < 16; i += 2)
         {
             /* sub blk idx 1 */
@@ -1362,8 +1372,6 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         chroma_intra_mode = (mb_tpm >> 6);
         cbptable = 0;
 
-        ASSERT(0);
-
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 5, error_status, "mb type");
 
@@ -1371,7 +1379,7 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         PUT_BITS(ps_bitstream, u4_transform_size_8x8_flag, 1, error_status, "u4_transform_size_8x8_flag");
 
         /* write sub block modes */
-        for (i = 0; i < 4; i++)
+        for (i = 0; i < 4; i += 2)
         {
             /* sub blk idx 1 */
             byte = ps_mb_hdr_i8x8->au1_sub_blk_modes[i >> 1];
@@ -1427,13 +1435,27 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, mb_type - 3, error_status, "mb type");
 
+        if (mb_type == P8x8)
+        {
+            /* sub_mb_type : every sub mb is a single 8x8 partition */
+            for (i = 0; i < (WORD32)u4_part_cnt; i++)
+            {
+                PUT_BITS_UEV(ps_bitstream, 0, error_status, "sub_mb_type");
+            }
+        }
+
         for (i = 0; i < (WORD32)u4_part_cnt; i++)
         {
             PUT_BITS_SEV(ps_bitstream, *pi2_mv_ptr++, error_status, "mv x");
             PUT_BITS_SEV(ps_bitstream, *pi2_mv_ptr++, error_status, "mv y");
         }
 
-        pu1_byte += sizeof(mb_hdr_p16x16_t);
+        if (mb_type == P16x16)
+            pu1_byte += sizeof(mb_hdr_p16x16_t);
+        else if (mb_type == P8x8)
+            pu1_byte += sizeof(mb_hdr_p8x8_t);
+        else
+            pu1_byte += sizeof(mb_hdr_p16x8_t);
 
     }
 
@@ -1443,6 +1465,12 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         PUT_BITS_UEV(ps_bitstream, gu1_cbp_map_tables[cbp][cbptable], error_status, "coded_block_pattern");
     }
 
+    /* transform_size_8x8_flag */
+    if (is_inter && (cbp & 0xF) && ps_ent_ctxt->i1_transform_8x8_mode_flag)
+    {
+        PUT_BITS(ps_bitstream, ps_mb_hdr->u1_transform_8x8_flag, 1, error_status, "u4_transform_size_8x8_flag");
+    }
+
     if (cbp || mb_type == I16x16)
     {
         /* mb_qp_delta */
@@ -1622,6 +1650,12 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 23, error_status, "mb type");
 
+        /* transform_size_8x8_flag */
+        if (ps_ent_ctxt->i1_transform_8x8_mode_flag)
+        {
+            PUT_BITS(ps_bitstream, 0, 1, error_status, "u4_transform_size_8x8_flag");
+        }
+
         for (i = 0; i < 16; i += 2)
         {
             /* sub blk idx 1 */
@@ -1676,8 +1710,6 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         chroma_intra_mode = (mb_tpm >> 6);
         cbptable = 0;
 
-        ASSERT(0);
-
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, 23, error_status, "mb type");
 
@@ -1685,7 +1717,7 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         PUT_BITS(ps_bitstream, u4_transform_size_8x8_flag, 1, error_status, "u4_transform_size_8x8_flag");
 
         /* write sub block modes */
-        for (i = 0; i < 4; i++)
+        for (i = 0; i < 4; i += 2)
         {
             /* sub blk idx 1 */
             byte = ps_mb_hdr_i8x8->au1_sub_blk_modes[i >> 1];
@@ -1774,6 +1806,12 @@ IH264E_ERROR_T ih264e_write_bslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         PUT_BITS_UEV(ps_bitstream, gu1_cbp_map_tables[cbp][cbptable], error_status, "coded_block_pattern");
     }
 
+    /* transform_size_8x8_flag */
+    if (is_inter && (cbp & 0xF) && ps_ent_ctxt->i1_transform_8x8_mode_flag)
+    {
+        PUT_BITS(ps_bitstream, ps_mb_hdr->u1_transform_8x8_flag, 1, error_status, "u4_transform_size_8x8_flag");
+    }
+
     if (cbp || mb_type == I16x16)
     {
         /* mb_qp_delta */
@@ -33,9 +33,14 @@
  * @par List of Functions:
  *  - ih264e_pack_l_mb_i16()
  *  - ih264e_pack_c_mb_i8()
+ *  - ih264e_pack_l_8x8()
  *  - ih264e_code_luma_intra_macroblock_16x16()
  *  - ih264e_code_luma_intra_macroblock_4x4()
+ *  - ih264e_code_luma_intra_macroblock_8x8()
  *  - ih264e_code_chroma_intra_macroblock_8x8()
+ *  - ih264e_luma_transform_8x8_decision()
+ *  - ih264e_code_luma_inter_macroblock_transform_8x8()
+ *  - ih264e_code_luma_inter_macroblock_16x16()
  *
  * @remarks
  *  None
@@ -75,6 +80,7 @@
 #include "ih264_intra_pred_filters.h"
 #include "ih264_deblk_edge_filters.h"
 #include "ih264_cabac_tables.h"
+#include "ih264_common_tables.h"
 #include "irc_cntrl_param.h"
 #include "irc_frame_info_collector.h"
 #include "ih264e_rate_control.h"
@@ -1456,6 +1462,105 @@ void ih264e_pack_c_mb(WORD16 *pi2_res_mb,
     return ;
 }
 
+/**
+******************************************************************************
+*
+* @brief  This function packs residue of a luma 8x8 transform block for
+*  entropy coding
+*
+* @par   Description
+*  The 64 coefficients of an 8x8 transform block are split in to 4 interleaved
+*  4x4 units, coefficient i of unit k being the (4 * i + k)th coefficient of
+*  the 8x8 zig-zag scan. Each unit is then packed exactly like a 4x4 block,
+*  i.e. nnz, significant coefficient map and the nonzero coefficients. Cavlc
+*  codes the units as is, while cabac merges them back to a 64 coefficient
+*  block.
+*
+* @param[in]  pi2_res_blk
+*  pointer to quantized coefficients of the 8x8 block (raster order)
+*
+* @param[in, out]  pv_mb_coeff_data
+*  buffer pointing to packed residue coefficients
+*
+* @param[in]  u4_thres_resi
+*  flag to compute the coefficient cost of the block
+*
+* @return coefficient cost of the block
+*
+* @remarks none
+*
+******************************************************************************
+*/
+UWORD32 ih264e_pack_l_8x8(WORD16 *pi2_res_blk,
+                          void **pv_mb_coeff_data,
+                          UWORD32 u4_thres_resi)
+{
+    /* pointer to packed sub block buffer space */
+    tu_sblk_coeff_data_t *ps_mb_coeff_data;
+
+    /* pointer to interleaved scanning matrix */
+    const UWORD8 *pu1_scan_order = gau1_ih264_inv_scan_prog8x8_cavlc;
+
+    /* coeff cost */
+    const UWORD8 *pu1_coeff_cost = gu1_coeff_cost;
+
+    /* no of non zero coefficients, significant coefficient map */
+    UWORD32 u4_nnz_cnt, u4_s_map;
+
+    /* temp var */
+    UWORD32 u4_coeff_cost = 0, coeff_cnt, b4;
+    WORD32 i4_res_val, i4_run = -1;
+
+    for (b4 = 0; b4 < 4; b4++)
+    {
+        ps_mb_coeff_data = (*pv_mb_coeff_data);
+
+        for (u4_nnz_cnt = 0, u4_s_map = 0, coeff_cnt = 0; coeff_cnt < 16; coeff_cnt++)
+        {
+            i4_res_val = pi2_res_blk[pu1_scan_order[(b4 << 4) + coeff_cnt]];
+
+            if (i4_res_val)
+            {
+                /* write residue */
+                ps_mb_coeff_data->ai2_residue[u4_nnz_cnt++] = i4_res_val;
+                u4_s_map |= (1 << coeff_cnt);
+            }
+        }
+
+        /* write number of non zero coefficients & significant coeff map */
+        ps_mb_coeff_data->i4_sig_map_nnz = u4_nnz_cnt | (u4_s_map << 16);
+        (*pv_mb_coeff_data) = ps_mb_coeff_data->ai2_residue + ALIGN2(u4_nnz_cnt);
+    }
+
+    if (u4_thres_resi)
+    {
+        /* coeff cost, runs are counted in the 8x8 zig-zag scan order */
+        pu1_scan_order = gau1_ih264_inv_scan_prog8x8_cabac;
+
+        for (coeff_cnt = 0; coeff_cnt < 64; coeff_cnt++)
+        {
+            i4_run++;
+
+            i4_res_val = pi2_res_blk[pu1_scan_order[coeff_cnt]];
+
+            if (i4_res_val)
+            {
+                if (i4_res_val == 1 || i4_res_val == -1)
+                {
+                    if (i4_run < 6)
+                        u4_coeff_cost += pu1_coeff_cost[i4_run];
+                }
+                else
+                    u4_coeff_cost += 9;
+
+                i4_run = -1;
+            }
+        }
+    }
+
+    return u4_coeff_cost;
+}
+
 /**
 *******************************************************************************
 *
@@ -1971,6 +2076,172 @@ UWORD8 ih264e_code_luma_intra_macroblock_4x4_rdopt_on(process_ctxt_t *ps_proc)
 }
 
 
+/**
+*******************************************************************************
+*
+* @brief performs luma core coding when intra mode is i8x8
+*
+* @par Description:
+*  If the current mb is to be coded as intra of mb type i8x8, each 8x8 block
+*  of the mb is predicted using one of the i8x8 prediction filters (from the
+*  filtered reconstructed neighbors), basing on the intra mode chosen. Then,
+*  error is computed between the input blk and the estimated blk. This error is
+*  transformed using the 8x8 transform and quantized. The quantized
+*  coefficients are packed in scan order for entropy coding.
+*
+* @param[in] ps_proc_ctxt
+*  pointer to the current macro block context
+*
+* @returns u1_cbp_l
+*  coded block pattern luma
+*
+* @remarks
+*  The traversal of 8x8 subblocks in the 16x16 macroblock is as per the scan
+*  order mentioned in h.264 specification
+*
+*******************************************************************************
+*/
+UWORD8 ih264e_code_luma_intra_macroblock_8x8(process_ctxt_t *ps_proc)
+{
+    /* Codec Context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* pointer to ref macro block */
+    UWORD8 *pu1_ref_mb;
+
+    /* pointer to src macro block */
+    UWORD8 *pu1_curr_mb;
+
+    /* pointer to prediction macro block */
+    UWORD8 *pu1_pred_mb = ps_proc->pu1_pred_mb;
+
+    /* pointer to residual macro block */
+    WORD16 *pi2_res_mb = ps_proc->pi2_res_buf;
+
+    /* strides */
+    WORD32 i4_src_strd = ps_proc->i4_src_strd;
+    WORD32 i4_rec_strd = ps_proc->i4_rec_strd;
+    WORD32 i4_pred_strd = ps_proc->i4_pred_strd;
+
+    /* pointer to neighbors: left, top, top-left */
+    UWORD8 *pu1_mb_a;
+    UWORD8 *pu1_mb_b;
+    UWORD8 *pu1_mb_d;
+
+    /* intra mode */
+    UWORD32 u4_intra_mode;
+
+    /* neighbor availability */
+    WORD32 i4_ngbr_avbl;
+
+    /* neighbor pels for intra prediction */
+    UWORD8 *pu1_ngbr_pels_i8 = ps_proc->au1_ngbr_pels;
+
+    /* coded block pattern */
+    UWORD8 u1_cbp_l = 0;
+
+    /* number of non zero coeffs*/
+    UWORD8 u1_nnz;
+
+    /* quantization parameters */
+    quant_params_t *ps_qp_params = ps_proc->ps_qp_params_8x8;
+
+    /* pointer to packed mb coeff data */
+    void **pv_mb_coeff_data = &(ps_proc->pv_mb_coeff_data);
+
+    /*Dummy variable for 8x8 trans fucntion*/
+    WORD16 i2_dc_dummy;
+
+    /* temp var */
+    UWORD32 b8, u4_pix_x, u4_pix_y;
+
+    /* Process 4 8x8 lum sub-blocks of the MB in scan order */
+    for (b8 = 0; b8 < 4; b8++)
+    {
+        /* index of pel in MB */
+        u4_pix_x = (b8 & 0x01) << 3;
+        u4_pix_y = (b8 >> 1) << 3;
+
+        /* Initialize source and reference pointers */
+        pu1_curr_mb = ps_proc->pu1_src_buf_luma + u4_pix_x + (u4_pix_y * i4_src_strd);
+        pu1_ref_mb = ps_proc->pu1_rec_buf_luma + u4_pix_x + (u4_pix_y * i4_rec_strd);
+
+        /* pointer to left of ref macro block */
+        pu1_mb_a = pu1_ref_mb - 1;
+        /* pointer to top of ref macro block */
+        pu1_mb_b = pu1_ref_mb - i4_rec_strd;
+        /* pointer to topleft macro block */
+        pu1_mb_d = pu1_mb_b - 1;
+
+        /* neighbor availability */
+        i4_ngbr_avbl = ps_proc->ai4_neighbor_avail_8x8_subblks[b8];
+
+        /* sub block intra mode */
+        u4_intra_mode = ps_proc->au1_intra_luma_mb_8x8_modes[b8];
+
+        /********************************************************/
+        /* gather & filter prediction pels from neighbors       */
+        /********************************************************/
+        /* top left pointer also signals the availability of top left pel */
+        ih264_intra_pred_luma_8x8_mode_ref_filtering(pu1_mb_a,
+                                                     (i4_ngbr_avbl & TOP_LEFT_MB_AVAILABLE_MASK) ? pu1_mb_d : NULL,
+                                                     pu1_mb_b, pu1_ngbr_pels_i8,
+                                                     i4_rec_strd, i4_ngbr_avbl);
+
+        /********************************************************/
+        /*  prediction                                          */
+        /********************************************************/
+        (ps_codec->apf_intra_pred_8_l)[u4_intra_mode](pu1_ngbr_pels_i8,
+                                                      pu1_pred_mb, 0,
+                                                      i4_pred_strd,
+                                                      i4_ngbr_avbl);
+
+        /********************************************************/
+        /*  error estimation,                                   */
+        /*  transform                                           */
+        /*  quantization                                        */
+        /********************************************************/
+        ps_codec->pf_resi_trans_quant_8x8(pu1_curr_mb, pu1_pred_mb,
+                                          pi2_res_mb, i4_src_strd,
+                                          i4_pred_strd,
+                                          ps_qp_params->pu2_scale_mat,
+                                          ps_qp_params->pu2_thres_mat,
+                                          ps_qp_params->u1_qbits,
+                                          ps_qp_params->u4_dead_zone,
+                                          &u1_nnz, &i2_dc_dummy);
+
+        /********************************************************/
+        /*  pack coeff data for entropy coding,                 */
+        /*  iquantization                                       */
+        /*  itransform                                          */
+        /********************************************************/
+        if (u1_nnz)
+        {
+            ih264e_pack_l_8x8(pi2_res_mb, pv_mb_coeff_data, 0);
+
+            /* cbp */
+            u1_cbp_l |= (1 << b8);
+
+            ps_codec->pf_iquant_itrans_recon_8x8(
+                            pi2_res_mb, pu1_pred_mb, pu1_ref_mb,
+                            i4_pred_strd, i4_rec_strd,
+                            ps_qp_params->pu2_iscale_mat,
+                            ps_qp_params->pu2_weigh_mat,
+                            ps_qp_params->u1_qp_div,
+                            ps_proc->pv_scratch_buff, 0, NULL);
+        }
+        else
+        {
+            ps_codec->pf_inter_pred_luma_copy(pu1_pred_mb, pu1_ref_mb,
+                                              i4_pred_strd, i4_rec_strd,
+                                              BLK8x8SIZE, BLK8x8SIZE, NULL,
+                                              0);
+        }
+    }
+
+    return (u1_cbp_l);
+}
+
 /**
 *******************************************************************************
 *
@@ -2088,6 +2359,442 @@ UWORD8 ih264e_code_chroma_intra_macroblock_8x8(process_ctxt_t *ps_proc)
 }
 
 
+/**
+*******************************************************************************
+*
+* @brief estimates the bits taken by the quantized levels of a luma block
+*
+* @par Description:
+*  Each non zero level is charged the exp-golomb code length of the zero run
+*  preceding it in scan order and of its magnitude, plus a sign bit. A coded
+*  block is charged two more bits for its end. Both transform sizes are
+*  measured with this model, so the estimates are comparable even though
+*  they are not the exact cavlc / cabac costs
+*
+* @param[in] pi2_coeff
+*  quantized levels in raster order
+*
+* @param[in] pu1_scan_order
+*  scan order of the levels
+*
+* @param[in] i4_num_coeffs
+*  number of levels in the block
+*
+* @returns estimated bits, 0 for a block with no levels
+*
+*******************************************************************************
+*/
+static UWORD32 ih264e_luma_coeff_bits(WORD16 *pi2_coeff,
+                                      const UWORD8 *pu1_scan_order,
+                                      WORD32 i4_num_coeffs)
+{
+    /* estimated bits */
+    UWORD32 u4_bits = 0;
+
+    /* temp var */
+    WORD32 i, i4_run = 0, i4_level;
+
+    for (i = 0; i < i4_num_coeffs; i++)
+    {
+        i4_level = ABS(pi2_coeff[pu1_scan_order[i]]);
+
+        if (i4_level)
+        {
+            /* ue(v) length of n is 2 * floor(log2(n + 1)) + 1 */
+            u4_bits += 2 * (31 - CLZ(i4_run + 1)) + 1;
+            u4_bits += 2 * (31 - CLZ(2 * i4_level - 1)) + 1 + 1;
+            i4_run = 0;
+        }
+        else
+        {
+            i4_run++;
+        }
+    }
+
+    return u4_bits ? (u4_bits + 2) : 0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief rate distortion cost of coding an 8x8 luma block of an inter mb
+*
+* @par Description:
+*  The residue of the block is transformed and quantized with the 4x4 or the
+*  8x8 transform and reconstructed again. The cost is the sum of squared
+*  errors of the reconstruction plus lambda times the estimated bits of the
+*  levels.
+*
+* @param[in] ps_proc
+*  pointer to the current macro block context
+*
+* @param[in] pu1_src
+*  pointer to source 8x8 block
+*
+* @param[in] pu1_pred
+*  pointer to prediction 8x8 block
+*
+* @param[in] i4_src_strd
+*  source stride
+*
+* @param[in] i4_pred_strd
+*  prediction stride
+*
+* @param[in] u4_transform_8x8
+*  1 to use the 8x8 transform, 0 for the 4x4 transform
+*
+* @returns cost, in units of 1/256 of a squared error
+*
+*******************************************************************************
+*/
+static UWORD64 ih264e_luma_8x8_rd_cost(process_ctxt_t *ps_proc,
+                                       UWORD8 *pu1_src,
+                                       UWORD8 *pu1_pred,
+                                       WORD32 i4_src_strd,
+                                       WORD32 i4_pred_strd,
+                                       UWORD32 u4_transform_8x8)
+{
+    /* Codec Context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* quantized levels and reconstruction of the 8x8 block */
+    WORD16 ai2_coeff[64];
+    UWORD8 au1_rec[64];
+
+    /* lambda for ssd, 0.85 * 2 ^ ((qp - 12) / 3), in Q8 */
+    UWORD64 u8_lambda = (UWORD64)ps_proc->u4_lambda * ps_proc->u4_lambda * 218;
+
+    /* distortion and rate */
+    UWORD64 u8_ssd = 0;
+    UWORD32 u4_bits = 0;
+
+    /* temp var */
+    UWORD8 u1_nnz;
+    WORD16 i2_dc;
+    WORD32 b4, i, j, i4_diff;
+
+    if (u4_transform_8x8)
+    {
+        quant_params_t *ps_qp_params = ps_proc->ps_qp_params_8x8;
+
+        ps_codec->pf_resi_trans_quant_8x8(pu1_src, pu1_pred, ai2_coeff,
+                                          i4_src_strd, i4_pred_strd,
+                                          ps_qp_params->pu2_scale_mat,
+                                          ps_qp_params->pu2_thres_mat,
+                                          ps_qp_params->u1_qbits,
+                                          ps_qp_params->u4_dead_zone,
+                                          &u1_nnz, &i2_dc);
+
+        if (u1_nnz)
+        {
+            /* cavlc codes the levels as four interleaved 4x4 blocks */
+            if (CABAC == ps_codec->s_cfg.u4_entropy_coding_mode)
+            {
+                u4_bits = ih264e_luma_coeff_bits(ai2_coeff,
+                                                 gau1_ih264_inv_scan_prog8x8_cabac,
+                                                 64);
+            }
+            else
+            {
+                for (b4 = 0; b4 < 4; b4++)
+                {
+                    u4_bits += ih264e_luma_coeff_bits(ai2_coeff,
+                                                      gau1_ih264_inv_scan_prog8x8_cavlc + (b4 << 4),
+                                                      16);
+                }
+            }
+
+            ps_codec->pf_iquant_itrans_recon_8x8(ai2_coeff, pu1_pred, au1_rec,
+                                                 i4_pred_strd, BLK8x8SIZE,
+                                                 ps_qp_params->pu2_iscale_mat,
+                                                 ps_qp_params->pu2_weigh_mat,
+                                                 ps_qp_params->u1_qp_div,
+                                                 ps_proc->pv_scratch_buff, 0,
+                                                 NULL);
+        }
+        else
+        {
+            ps_codec->pf_inter_pred_luma_copy(pu1_pred, au1_rec, i4_pred_strd,
+                                              BLK8x8SIZE, BLK8x8SIZE,
+                                              BLK8x8SIZE, NULL, 0);
+        }
+    }
+    else
+    {
+        quant_params_t *ps_qp_params = ps_proc->ps_qp_params[0];
+
+        for (b4 = 0; b4 < 4; b4++)
+        {
+            WORD32 i4_pix_x = (b4 & 1) << 2;
+            WORD32 i4_pix_y = (b4 >> 1) << 2;
+            WORD16 *pi2_coeff = ai2_coeff + (b4 << 4);
+            UWORD8 *pu1_pred_b4 = pu1_pred + i4_pix_x + i4_pix_y * i4_pred_strd;
+            UWORD8 *pu1_rec_b4 = au1_rec + i4_pix_x + i4_pix_y * BLK8x8SIZE;
+
+            ps_codec->pf_resi_trans_quant_4x4(pu1_src + i4_pix_x + i4_pix_y * i4_src_strd,
+                                              pu1_pred_b4, pi2_coeff,
+                                              i4_src_strd, i4_pred_strd,
+                                              ps_qp_params->pu2_scale_mat,
+                                              ps_qp_params->pu2_thres_mat,
+                                              ps_qp_params->u1_qbits,
+                                              ps_qp_params->u4_dead_zone,
+                                              &u1_nnz, &i2_dc);
+
+            if (u1_nnz)
+            {
+                u4_bits += ih264e_luma_coeff_bits(pi2_coeff,
+                                                  gu1_luma_scan_order, 16);
+
+                ps_codec->pf_iquant_itrans_recon_4x4(pi2_coeff, pu1_pred_b4,
+                                                     pu1_rec_b4, i4_pred_strd,
+                                                     BLK8x8SIZE,
+                                                     ps_qp_params->pu2_iscale_mat,
+                                                     ps_qp_params->pu2_weigh_mat,
+                                                     ps_qp_params->u1_qp_div,
+                                                     ps_proc->pv_scratch_buff,
+                                                     0, pi2_coeff);
+            }
+            else
+            {
+                ps_codec->pf_inter_pred_luma_copy(pu1_pred_b4, pu1_rec_b4,
+                                                  i4_pred_strd, BLK8x8SIZE,
+                                                  SIZE_4X4_BLK_HRZ,
+                                                  SIZE_4X4_BLK_VERT, NULL, 0);
+            }
+        }
+    }
+
+    for (i = 0; i < BLK8x8SIZE; i++)
+    {
+        for (j = 0; j < BLK8x8SIZE; j++)
+        {
+            i4_diff = pu1_src[i * i4_src_strd + j] - au1_rec[i * BLK8x8SIZE + j];
+            u8_ssd += i4_diff * i4_diff;
+        }
+    }
+
+    return (u8_ssd << 8) + u8_lambda * u4_bits;
+}
+
+/**
+*******************************************************************************
+*
+* @brief decides the luma transform size of an inter macro block
+*
+* @par Description:
+*  Each 8x8 block of the macro block is coded with both the 4x4 and the 8x8
+*  transform and the rate distortion costs (ssd + lambda * estimated bits)
+*  are summed over the macro block. The transform size with the lower cost
+*  is chosen.
+*
+* @param[in] ps_proc
+*  pointer to the current macro block context
+*
+* @param[in] pu1_src
+*  pointer to source macro block
+*
+* @param[in] pu1_pred
+*  pointer to prediction macro block
+*
+* @param[in] i4_src_strd
+*  source stride
+*
+* @param[in] i4_pred_strd
+*  prediction stride
+*
+* @returns 1 if 8x8 transform is to be used, 0 otherwise
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+UWORD32 ih264e_luma_transform_8x8_decision(process_ctxt_t *ps_proc,
+                                           UWORD8 *pu1_src,
+                                           UWORD8 *pu1_pred,
+                                           WORD32 i4_src_strd,
+                                           WORD32 i4_pred_strd)
+{
+    /* rd costs of the two transform sizes */
+    UWORD64 u8_cost_4x4 = 0, u8_cost_8x8 = 0;
+
+    /* temp var */
+    WORD32 b8;
+
+    for (b8 = 0; b8 < 4; b8++)
+    {
+        UWORD8 *pu1_src_b8 = pu1_src + ((b8 & 1) << 3) + ((b8 >> 1) << 3) * i4_src_strd;
+        UWORD8 *pu1_pred_b8 = pu1_pred + ((b8 & 1) << 3) + ((b8 >> 1) << 3) * i4_pred_strd;
+
+        u8_cost_4x4 += ih264e_luma_8x8_rd_cost(ps_proc, pu1_src_b8, pu1_pred_b8,
+                                               i4_src_strd, i4_pred_strd, 0);
+        u8_cost_8x8 += ih264e_luma_8x8_rd_cost(ps_proc, pu1_src_b8, pu1_pred_b8,
+                                               i4_src_strd, i4_pred_strd, 1);
+    }
+
+    return (u8_cost_8x8 < u8_cost_4x4);
+}
+
+/**
+*******************************************************************************
+*
+* @brief performs luma core coding of an inter mb with 8x8 transform
+*
+* @par Description:
+*  The error between the input mb and the motion compensated prediction is
+*  transformed using the 8x8 transform and quantized, for each of the four 8x8
+*  blocks. The quantized coefficients are packed for entropy coding and the
+*  mb is reconstructed. As with the 4x4 transform, blocks (and mb) with
+*  insignificant coefficients are not coded.
+*
+* @param[in] ps_proc_ctxt
+*  pointer to the current macro block context
+*
+* @param[in] pu1_pred_mb
+*  pointer to prediction macro block
+*
+* @param[in] i4_pred_strd
+*  prediction stride
+*
+* @returns u1_cbp_l
+*  coded block pattern luma
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+UWORD8 ih264e_code_luma_inter_macroblock_transform_8x8(process_ctxt_t *ps_proc,
+                                                       UWORD8 *pu1_pred_mb,
+                                                       WORD32 i4_pred_strd)
+{
+    /* Codec Context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* pointer to ref macro block */
+    UWORD8 *pu1_rec_mb = ps_proc->pu1_rec_buf_luma;
+
+    /* pointer to src macro block */
+    UWORD8 *pu1_curr_mb = ps_proc->pu1_src_buf_luma;
+
+    /* pointer to residual macro block */
+    WORD16 *pi2_res_mb = ps_proc->pi2_res_buf;
+
+    /* strides */
+    WORD32 i4_src_strd = ps_proc->i4_src_strd;
+    WORD32 i4_rec_strd = ps_proc->i4_rec_strd;
+
+    /* coded block pattern */
+    UWORD8 u1_cbp_l = 0;
+
+    /* number of non zero coeffs of each 8x8 block and each 4x4 unit */
+    UWORD8 au1_nnz[4];
+    UWORD8 *pu1_nnz = (UWORD8 *)ps_proc->au4_nnz;
+
+    /* quantization parameters */
+    quant_params_t *ps_qp_params = ps_proc->ps_qp_params_8x8;
+
+    /* pointer to packed mb coeff data */
+    void **pv_mb_coeff_data = &(ps_proc->pv_mb_coeff_data);
+    void *pv_mb_coeff_data_mb = *pv_mb_coeff_data, *pv_mb_coeff_data_b8;
+
+    /* coeff cost */
+    UWORD32 u4_thres_resi = ps_codec->u4_thres_resi;
+    UWORD32 u4_b8_coeff_cost, u4_mb_coeff_cost = 0;
+
+    /*Dummy variable for 8x8 trans fucntion*/
+    WORD16 i2_dc_dummy;
+
+    /* temp var */
+    UWORD32 b8, u4_pix_x, u4_pix_y, u4_blk;
+
+    /********************************************************/
+    /*  error estimation,                                   */
+    /*  transform                                           */
+    /*  quantization                                        */
+    /*  pack coeff data for entropy coding                  */
+    /********************************************************/
+    for (b8 = 0; b8 < 4; b8++)
+    {
+        u4_pix_x = (b8 & 0x01) << 3;
+        u4_pix_y = (b8 >> 1) << 3;
+
+        ps_codec->pf_resi_trans_quant_8x8(pu1_curr_mb + u4_pix_x + u4_pix_y * i4_src_strd,
+                                          pu1_pred_mb + u4_pix_x + u4_pix_y * i4_pred_strd,
+                                          pi2_res_mb + (b8 << 6),
+                                          i4_src_strd, i4_pred_strd,
+                                          ps_qp_params->pu2_scale_mat,
+                                          ps_qp_params->pu2_thres_mat,
+                                          ps_qp_params->u1_qbits,
+                                          ps_qp_params->u4_dead_zone,
+                                          &au1_nnz[b8], &i2_dc_dummy);
+
+        if (au1_nnz[b8])
+        {
+            pv_mb_coeff_data_b8 = *pv_mb_coeff_data;
+
+            u4_b8_coeff_cost = ih264e_pack_l_8x8(pi2_res_mb + (b8 << 6),
+                                                 pv_mb_coeff_data,
+                                                 u4_thres_resi);
+
+            /* Decide if the 8x8 unit has to be sent for entropy coding? */
+            if (u4_thres_resi && (u4_b8_coeff_cost <= LUMA_SUB_BLOCK_SKIP_THRESHOLD))
+            {
+                *pv_mb_coeff_data = pv_mb_coeff_data_b8;
+                au1_nnz[b8] = 0;
+            }
+            else
+            {
+                u1_cbp_l |= (1 << b8);
+                u4_mb_coeff_cost += u4_b8_coeff_cost;
+            }
+        }
+    }
+
+    if (u4_thres_resi && (u4_mb_coeff_cost <= LUMA_BLOCK_SKIP_THRESHOLD) && u1_cbp_l)
+    {
+        *pv_mb_coeff_data = pv_mb_coeff_data_mb;
+        u1_cbp_l = 0;
+        memset(au1_nnz, 0, 4);
+    }
+
+    /********************************************************/
+    /*  iquantization                                       */
+    /*  itransform                                          */
+    /*  recon                                               */
+    /********************************************************/
+    for (b8 = 0; b8 < 4; b8++)
+    {
+        u4_pix_x = (b8 & 0x01) << 3;
+        u4_pix_y = (b8 >> 1) << 3;
+
+        /* the 4x4 units of an 8x8 block share its nnz (used for deblocking) */
+        u4_blk = ((b8 >> 1) << 3) + ((b8 & 1) << 1);
+        pu1_nnz[1 + u4_blk] = pu1_nnz[2 + u4_blk] = au1_nnz[b8];
+        pu1_nnz[5 + u4_blk] = pu1_nnz[6 + u4_blk] = au1_nnz[b8];
+
+        if (u1_cbp_l & (1 << b8))
+        {
+            ps_codec->pf_iquant_itrans_recon_8x8(
+                            pi2_res_mb + (b8 << 6),
+                            pu1_pred_mb + u4_pix_x + u4_pix_y * i4_pred_strd,
+                            pu1_rec_mb + u4_pix_x + u4_pix_y * i4_rec_strd,
+                            i4_pred_strd, i4_rec_strd,
+                            ps_qp_params->pu2_iscale_mat,
+                            ps_qp_params->pu2_weigh_mat,
+                            ps_qp_params->u1_qp_div,
+                            ps_proc->pv_scratch_buff, 0, NULL);
+        }
+        else
+        {
+            ps_codec->pf_inter_pred_luma_copy(pu1_pred_mb + u4_pix_x + u4_pix_y * i4_pred_strd,
+                                              pu1_rec_mb + u4_pix_x + u4_pix_y * i4_rec_strd,
+                                              i4_pred_strd, i4_rec_strd,
+                                              BLK8x8SIZE, BLK8x8SIZE, NULL, 0);
+        }
+    }
+
+    return (u1_cbp_l);
+}
+
 /**
 *******************************************************************************
 *
@@ -2167,6 +2874,23 @@ UWORD8 ih264e_code_luma_inter_macroblock_16x16(process_ctxt_t *ps_proc)
     /********************************************************/
     ih264e_motion_comp_luma(ps_proc, &pu1_pseudo_pred, &i4_pseudo_pred_strd);
 
+    /********************************************************/
+    /*  transform size decision                             */
+    /********************************************************/
+    if (ps_proc->i1_transform_8x8_mode_flag && ps_proc->u4_frame_qp > 10 &&
+        (ps_proc->u4_min_sad_reached == 0 || ps_proc->u4_min_sad != 0))
+    {
+        ps_proc->u4_transform_8x8 = ih264e_luma_transform_8x8_decision(
+                        ps_proc, pu1_curr_mb, pu1_pseudo_pred, i4_src_strd,
+                        i4_pseudo_pred_strd);
+    }
+
+    if (ps_proc->u4_transform_8x8)
+    {
+        return ih264e_code_luma_inter_macroblock_transform_8x8(
+                        ps_proc, pu1_pseudo_pred, i4_pseudo_pred_strd);
+    }
+
     /********************************************************/
     /*  error estimation,                                   */
     /*  transform                                           */
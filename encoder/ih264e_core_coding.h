@@ -482,6 +482,28 @@ void ih264e_pack_c_mb(WORD16 *pi2_res_mb, void **pv_mb_coeff_data,
                       UWORD32 u4_kill_coffs_flag, UWORD32 *pu4_cntrl,
                       UWORD32 u4_swap_uv);
 
+/**
+******************************************************************************
+*
+* @brief  This function packs residue of a luma 8x8 transform block for
+*  entropy coding
+*
+* @param[in]   pi2_res_blk
+*  pointer to residue of the 8x8 block (raster order)
+*
+* @param[out]  pv_mb_coeff_data
+*  pointer to the packed coefficient buffer
+*
+* @param[in]   u4_thres_resi
+*  flag to compute the coefficient cost of the block
+*
+* @return coefficient cost of the block (0 if u4_thres_resi is not set)
+*
+******************************************************************************
+*/
+UWORD32 ih264e_pack_l_8x8(WORD16 *pi2_res_blk, void **pv_mb_coeff_data,
+                          UWORD32 u4_thres_resi);
+
 /**
 *******************************************************************************
 *
@@ -568,6 +590,33 @@ UWORD8 ih264e_code_luma_intra_macroblock_4x4_rdopt_on
             process_ctxt_t *ps_proc
         );
 
+/**
+*******************************************************************************
+*
+* @brief performs luma core coding when intra mode is i8x8
+*
+* @par Description:
+*  If the current mb is to be coded as intra of mb type i8x8, each 8x8 block of
+*  the mb is predicted using one of i8x8 prediction filters, basing on the intra
+*  mode chosen. The error between the input blk and the estimated blk is 8x8
+*  dct transformed and quantized. The quantized coefficients are packed for
+*  entropy coding.
+*
+* @param[in] ps_proc_ctxt
+*  pointer to the current macro block context
+*
+* @returns u1_cbp_l
+*  coded block pattern luma
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+UWORD8 ih264e_code_luma_intra_macroblock_8x8
+        (
+            process_ctxt_t *ps_proc
+        );
+
 /**
 *******************************************************************************
 *
@@ -598,6 +647,63 @@ UWORD8 ih264e_code_chroma_intra_macroblock_8x8
             process_ctxt_t *ps_proc
         );
 
+/**
+*******************************************************************************
+*
+* @brief decides the luma transform size of an inter macro block
+*
+* @par Description:
+*  The transform size with the lower rate distortion cost, summed over the
+*  four 8x8 blocks, is chosen
+*
+* @param[in] ps_proc
+*  pointer to the current macro block context
+*
+* @param[in] pu1_src
+*  pointer to source macro block
+*
+* @param[in] pu1_pred
+*  pointer to prediction macro block
+*
+* @param[in] i4_src_strd
+*  source stride
+*
+* @param[in] i4_pred_strd
+*  prediction stride
+*
+* @returns 1 if 8x8 transform is to be used, 0 otherwise
+*
+*******************************************************************************
+*/
+UWORD32 ih264e_luma_transform_8x8_decision(process_ctxt_t *ps_proc,
+                                           UWORD8 *pu1_src,
+                                           UWORD8 *pu1_pred,
+                                           WORD32 i4_src_strd,
+                                           WORD32 i4_pred_strd);
+
+/**
+*******************************************************************************
+*
+* @brief performs luma core coding of an inter mb with 8x8 transform
+*
+* @param[in] ps_proc_ctxt
+*  pointer to the current macro block context
+*
+* @param[in] pu1_pred_mb
+*  pointer to prediction macro block
+*
+* @param[in] i4_pred_strd
+*  prediction stride
+*
+* @returns u1_cbp_l
+*  coded block pattern luma
+*
+*******************************************************************************
+*/
+UWORD8 ih264e_code_luma_inter_macroblock_transform_8x8(process_ctxt_t *ps_proc,
+                                                       UWORD8 *pu1_pred_mb,
+                                                       WORD32 i4_pred_strd);
+
 /**
 *******************************************************************************
 * @brief performs luma core coding when  mode is inter
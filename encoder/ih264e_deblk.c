@@ -30,6 +30,8 @@
  *  ittiam
  *
  * @par List of Functions:
+ *  - ih264e_compute_mv_edge_flag
+ *  - ih264e_get_edge_bs
  *  - ih264e_fill_bs_1mv_1ref_non_mbaff
  *  - ih264e_calculate_csbp
  *  - ih264e_compute_bs
@@ -132,13 +134,111 @@ static const UWORD16  ih264e_gu2_4x4_v2h_reorder[16] =
 /* Function Definitions                                                      */
 /*****************************************************************************/
 
+/**
+*******************************************************************************
+*
+* @brief Checks if motion vectors differ across an edge
+*
+* @par Description:
+*  Returns 1 if the blocks on either side of an edge use different prediction
+*  modes or if any component of their motion vectors differs by one full pel
+*  or more
+*
+* @param[in] ps_p_pu
+*  PU on the left / top side of the edge
+*
+* @param[in] ps_q_pu
+*  PU on the right / bottom side of the edge
+*
+* @returns  mv edge flag
+*
+* @remarks  Assumes single reference frame per list
+*
+*******************************************************************************
+*/
+static UWORD32 ih264e_compute_mv_edge_flag(enc_pu_t *ps_p_pu, enc_pu_t *ps_q_pu)
+{
+    /* motion vectors of blks p & q */
+    WORD16 i16_qMvl0_x, i16_qMvl0_y, i16_pMvl0_x, i16_pMvl0_y;
+    WORD16 i16_qMvl1_x, i16_qMvl1_y, i16_pMvl1_x, i16_pMvl1_y;
+
+    if (ps_q_pu->b2_pred_mode != ps_p_pu->b2_pred_mode)
+    {
+        return 1;
+    }
+    else if(ps_q_pu->b2_pred_mode != 2)/* Not bipred */
+    {
+        i16_pMvl0_x = ps_p_pu->s_me_info[ps_p_pu->b2_pred_mode].s_mv.i2_mvx;
+        i16_pMvl0_y = ps_p_pu->s_me_info[ps_p_pu->b2_pred_mode].s_mv.i2_mvy;
+
+        i16_qMvl0_x = ps_q_pu->s_me_info[ps_q_pu->b2_pred_mode].s_mv.i2_mvx;
+        i16_qMvl0_y = ps_q_pu->s_me_info[ps_q_pu->b2_pred_mode].s_mv.i2_mvy;
+
+
+        return (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
+             | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4);
+    }
+    else
+    {
+
+        i16_pMvl0_x = ps_p_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
+        i16_pMvl0_y = ps_p_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
+        i16_pMvl1_x = ps_p_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
+        i16_pMvl1_y = ps_p_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
+
+        i16_qMvl0_x = ps_q_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
+        i16_qMvl0_y = ps_q_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
+        i16_qMvl1_x = ps_q_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
+        i16_qMvl1_y = ps_q_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
+
+
+        return (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
+             | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4)
+             | (ABS((i16_pMvl1_x - i16_qMvl1_x)) >= 4)
+             | (ABS((i16_pMvl1_y - i16_qMvl1_y)) >= 4);
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief BS of an edge spanning two 8x8 quadrants
+*
+* @par Description:
+*  The first two 4x4 segments of the edge (MSB half) take their mv flag from
+*  the first quadrant pair and the last two from the second pair
+*
+* @param[in] u4_bs_enc
+*  coded pattern of the 4 segments of the edge
+*
+* @param[in] u4_flag0
+*  mv edge flag of the first half of the edge
+*
+* @param[in] u4_flag1
+*  mv edge flag of the second half of the edge
+*
+* @returns  packed BS of the edge
+*
+* @remarks  none
+*
+*******************************************************************************
+*/
+static UWORD32 ih264e_get_edge_bs(UWORD32 u4_bs_enc,
+                                  UWORD32 u4_flag0,
+                                  UWORD32 u4_flag1)
+{
+    return (gu4_bs_table[!!u4_flag0][u4_bs_enc] & 0xFFFF0000)
+                    | (gu4_bs_table[!!u4_flag1][u4_bs_enc] & 0x0000FFFF);
+}
+
 /**
 *******************************************************************************
 *
 * @brief Fill BS value for all the edges of an mb
 *
 * @par Description:
-*  Fill BS value for all the edges of an mb
+*  Fill BS value for all the edges of an mb. Motion vectors can change only
+*  between 8x8 quadrants, hence only edges 0 and 2 check the mvs
 *
 * @param[in] pu4_horz_bs
 *  Base pointer of horizontal BS table
@@ -153,13 +253,13 @@ static const UWORD16  ih264e_gu2_4x4_v2h_reorder[16] =
 *  coded sub block pattern of top mb
 *
 * @param[in] ps_left_pu
-*  PU for left MB
+*  PU for left MB, one entry per 8x8 quadrant
 *
 * @param[in] ps_top_pu
-*  PU for top MB
+*  PU for top MB, one entry per 8x8 quadrant
 *
 * @param[in] ps_curr_pu
-*  PU for current MB
+*  PU for current MB, one entry per 8x8 quadrant
 *
 *
 * @returns  none
@@ -177,12 +277,7 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
                                               enc_pu_t *ps_top_pu,
                                               enc_pu_t *ps_curr_pu)
 {
-    /* motion vectors of blks p & q */
-    WORD16 i16_qMvl0_x, i16_qMvl0_y, i16_pMvl0_x, i16_pMvl0_y;
-    WORD16 i16_qMvl1_x, i16_qMvl1_y, i16_pMvl1_x, i16_pMvl1_y;
-
     /* temp var */
-    UWORD32 u4_left_flag, u4_top_flag;
     const UWORD32 *bs_map;
     UWORD32 u4_reordered_vert_bs_enc, u4_temp;
 
@@ -217,7 +312,9 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
     /* BS calculation for 1 2 3 horizontal boundary */
     bs_map = gu4_bs_table[0];
     pu4_horz_bs[1] = bs_map[(u4_horz_bs_enc >> 4) & 0xF];
-    pu4_horz_bs[2] = bs_map[(u4_horz_bs_enc >> 8) & 0xF];
+    pu4_horz_bs[2] = ih264e_get_edge_bs((u4_horz_bs_enc >> 8) & 0xF,
+                                        ih264e_compute_mv_edge_flag(&ps_curr_pu[0], &ps_curr_pu[2]),
+                                        ih264e_compute_mv_edge_flag(&ps_curr_pu[1], &ps_curr_pu[3]));
     pu4_horz_bs[3] = bs_map[(u4_horz_bs_enc >> 12) & 0xF];
 
     /* BS calculation for 5 6 7 vertical boundary */
@@ -234,7 +331,9 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
     u4_reordered_vert_bs_enc |= (u4_temp << 3);
 
     pu4_vert_bs[1] = bs_map[(u4_reordered_vert_bs_enc >> 4) & 0xF];
-    pu4_vert_bs[2] = bs_map[(u4_reordered_vert_bs_enc >> 8) & 0xF];
+    pu4_vert_bs[2] = ih264e_get_edge_bs((u4_reordered_vert_bs_enc >> 8) & 0xF,
+                                        ih264e_compute_mv_edge_flag(&ps_curr_pu[0], &ps_curr_pu[1]),
+                                        ih264e_compute_mv_edge_flag(&ps_curr_pu[2], &ps_curr_pu[3]));
     pu4_vert_bs[3] = bs_map[(u4_reordered_vert_bs_enc >> 12) & 0xF];
 
 
@@ -245,44 +344,10 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
     }
     else
     {
-        if (ps_curr_pu->b2_pred_mode != ps_top_pu->b2_pred_mode)
-        {
-            u4_top_flag = 1;
-        }
-        else if(ps_curr_pu->b2_pred_mode != 2)
-        {
-            i16_pMvl0_x = ps_top_pu->s_me_info[ps_top_pu->b2_pred_mode].s_mv.i2_mvx;
-            i16_pMvl0_y = ps_top_pu->s_me_info[ps_top_pu->b2_pred_mode].s_mv.i2_mvy;
-
-            i16_qMvl0_x = ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv.i2_mvx;
-            i16_qMvl0_y = ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv.i2_mvy;
-
-
-            u4_top_flag =  (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
-                         | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4);
-        }
-        else
-        {
-
-            i16_pMvl0_x = ps_top_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
-            i16_pMvl0_y = ps_top_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
-            i16_pMvl1_x = ps_top_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
-            i16_pMvl1_y = ps_top_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
-
-            i16_qMvl0_x = ps_curr_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
-            i16_qMvl0_y = ps_curr_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
-            i16_qMvl1_x = ps_curr_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
-            i16_qMvl1_y = ps_curr_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
-
-
-            u4_top_flag =  (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
-                         | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4)
-                         | (ABS((i16_pMvl1_x - i16_qMvl1_x)) >= 4)
-                         | (ABS((i16_pMvl1_y - i16_qMvl1_y)) >= 4);
-        }
-
-        bs_map = gu4_bs_table[!!u4_top_flag];
-        pu4_horz_bs[0] = bs_map[u4_horz_bs_enc & 0xF];
+        /* bottom quadrants of top mb against top quadrants of current mb */
+        pu4_horz_bs[0] = ih264e_get_edge_bs(u4_horz_bs_enc & 0xF,
+                                            ih264e_compute_mv_edge_flag(&ps_top_pu[2], &ps_curr_pu[0]),
+                                            ih264e_compute_mv_edge_flag(&ps_top_pu[3], &ps_curr_pu[1]));
     }
 
 
@@ -292,44 +357,10 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
     }
     else
     {
-        if (ps_curr_pu->b2_pred_mode != ps_left_pu->b2_pred_mode)
-        {
-            u4_left_flag = 1;
-        }
-        else if(ps_curr_pu->b2_pred_mode != 2)/* Not bipred */
-        {
-            i16_pMvl0_x = ps_left_pu->s_me_info[ps_left_pu->b2_pred_mode].s_mv.i2_mvx;
-            i16_pMvl0_y = ps_left_pu->s_me_info[ps_left_pu->b2_pred_mode].s_mv.i2_mvy;
-
-            i16_qMvl0_x = ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv.i2_mvx;
-            i16_qMvl0_y = ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv.i2_mvy;
-
-
-            u4_left_flag =  (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
-                          | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4);
-        }
-        else
-        {
-
-            i16_pMvl0_x = ps_left_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
-            i16_pMvl0_y = ps_left_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
-            i16_pMvl1_x = ps_left_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
-            i16_pMvl1_y = ps_left_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
-
-            i16_qMvl0_x = ps_curr_pu->s_me_info[PRED_L0].s_mv.i2_mvx;
-            i16_qMvl0_y = ps_curr_pu->s_me_info[PRED_L0].s_mv.i2_mvy;
-            i16_qMvl1_x = ps_curr_pu->s_me_info[PRED_L1].s_mv.i2_mvx;
-            i16_qMvl1_y = ps_curr_pu->s_me_info[PRED_L1].s_mv.i2_mvy;
-
-
-            u4_left_flag =  (ABS((i16_pMvl0_x - i16_qMvl0_x)) >= 4)
-                          | (ABS((i16_pMvl0_y - i16_qMvl0_y)) >= 4)
-                          | (ABS((i16_pMvl1_x - i16_qMvl1_x)) >= 4)
-                          | (ABS((i16_pMvl1_y - i16_qMvl1_y)) >= 4);
-        }
-
-        bs_map = gu4_bs_table[!!u4_left_flag];
-        pu4_vert_bs[0] = bs_map[u4_reordered_vert_bs_enc & 0xF];
+        /* right quadrants of left mb against left quadrants of current mb */
+        pu4_vert_bs[0] = ih264e_get_edge_bs(u4_reordered_vert_bs_enc & 0xF,
+                                            ih264e_compute_mv_edge_flag(&ps_left_pu[1], &ps_curr_pu[0]),
+                                            ih264e_compute_mv_edge_flag(&ps_left_pu[3], &ps_curr_pu[2]));
     }
 }
 
@@ -439,27 +470,45 @@ void ih264e_compute_bs(process_ctxt_t * ps_proc)
         mb_info_t *ps_top_mb_syntax_ele = ps_proc->ps_top_row_mb_syntax_ele + i4_mb_x;
 
         /* top row motion vector info */
-        enc_pu_t *ps_top_row_pu = ps_proc->ps_top_row_pu + i4_mb_x;
+        enc_pu_t *ps_top_row_pu = ps_proc->ps_top_row_pu + i4_mb_x * ENC_NUM_PU_IN_MB;
+
+        /* left mb motion vector info */
+        enc_pu_t *ps_left_mb_pu = ps_proc->as_left_mb_pu;
+
+        /* temp var */
+        WORD32 i;
 
         /* csbp for curr mb */
         ps_proc->u4_csbp = ih264e_calculate_csbp(ps_proc);
 
         /* csbp for ngbrs */
+        /* picture edges are not filtered, mirror the adjacent quadrants of
+         * the current mb into the missing neighbour */
         if (i4_mb_x == 0)
         {
             ps_left_mb_syntax_ele->u4_csbp = 0;
-            ps_proc->s_left_mb_pu.b1_intra_flag = 0;
-            ps_proc->s_left_mb_pu.b2_pred_mode = ps_proc->ps_pu->b2_pred_mode;
-            ps_proc->s_left_mb_pu.s_me_info[0].s_mv = ps_proc->ps_pu->s_me_info[0].s_mv;
-            ps_proc->s_left_mb_pu.s_me_info[1].s_mv = ps_proc->ps_pu->s_me_info[1].s_mv;
+            for (i = 0; i < ENC_NUM_PU_IN_MB; i++)
+            {
+                enc_pu_t *ps_curr_pu = &ps_proc->ps_pu[i & 2];
+
+                ps_left_mb_pu[i].b1_intra_flag = 0;
+                ps_left_mb_pu[i].b2_pred_mode = ps_curr_pu->b2_pred_mode;
+                ps_left_mb_pu[i].s_me_info[0].s_mv = ps_curr_pu->s_me_info[0].s_mv;
+                ps_left_mb_pu[i].s_me_info[1].s_mv = ps_curr_pu->s_me_info[1].s_mv;
+            }
         }
         if (i4_mb_y == 0)
         {
             ps_top_mb_syntax_ele->u4_csbp = 0;
-            ps_top_row_pu->b1_intra_flag = 0;
-            ps_top_row_pu->b2_pred_mode = ps_proc->ps_pu->b2_pred_mode;
-            ps_top_row_pu->s_me_info[0].s_mv = ps_proc->ps_pu->s_me_info[0].s_mv;
-            ps_top_row_pu->s_me_info[1].s_mv = ps_proc->ps_pu->s_me_info[1].s_mv;
+            for (i = 0; i < ENC_NUM_PU_IN_MB; i++)
+            {
+                enc_pu_t *ps_curr_pu = &ps_proc->ps_pu[i & 1];
+
+                ps_top_row_pu[i].b1_intra_flag = 0;
+                ps_top_row_pu[i].b2_pred_mode = ps_curr_pu->b2_pred_mode;
+                ps_top_row_pu[i].s_me_info[0].s_mv = ps_curr_pu->s_me_info[0].s_mv;
+                ps_top_row_pu[i].s_me_info[1].s_mv = ps_curr_pu->s_me_info[1].s_mv;
+            }
         }
 
         ih264e_fill_bs_1mv_1ref_non_mbaff(pu4_pic_horz_bs,
@@ -467,11 +516,18 @@ void ih264e_compute_bs(process_ctxt_t * ps_proc)
                                           ps_left_mb_syntax_ele->u4_csbp,
                                           ps_top_mb_syntax_ele->u4_csbp,
                                           ps_proc->u4_csbp,
-                                          &ps_proc->s_left_mb_pu,
+                                          ps_left_mb_pu,
                                           ps_top_row_pu,
                                           ps_proc->ps_pu);
     }
 
+    /* internal 4x4 edges are not filtered when 8x8 transform is used */
+    if (ps_proc->u4_transform_8x8)
+    {
+        pu4_pic_vert_bs[1] = pu4_pic_vert_bs[3] = 0;
+        pu4_pic_horz_bs[1] = pu4_pic_horz_bs[3] = 0;
+    }
+
     return ;
 }
 
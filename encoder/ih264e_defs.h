@@ -141,6 +141,46 @@
  */
 #define MAX_NUM_INP_FRAMES  ((MAX_NUM_BFRAMES) + 2)
 
+/**
+ *  Maximum number of pictures held in the lookahead queue
+ */
+#define MAX_LOOKAHEAD_FRAMES    16
+
+/**
+ *  Maximum number of input buffers the app can have queued with the
+ *  asynchronous encode interface, the ones held by the encoder included
+ */
+#define MAX_ASYNC_INP_BUFS  ((MAX_NUM_INP_FRAMES) + (MAX_LOOKAHEAD_FRAMES) + 8)
+
+/**
+ *  Maximum number of bitstream buffers the app can have queued with the
+ *  asynchronous encode interface, the ones held by the encoder included
+ */
+#define MAX_ASYNC_OUT_BUFS  16
+
+/**
+ *  Block size (in downscaled pels) used by the lookahead analysis. The
+ *  lookahead runs on a 2:1 downscaled luma plane, hence a block maps to a
+ *  16x16 area of the source
+ */
+#define LOOKAHEAD_BLK_SIZE      8
+
+/**
+ *  Search range (in downscaled pels) of the lookahead motion search
+ */
+#define LOOKAHEAD_SRCH_RNG      16
+
+/**
+ *  Maximum number of small diamond steps per lookahead block
+ */
+#define LOOKAHEAD_SRCH_ITERS    8
+
+/**
+ *  A picture is a scene cut when its inter cost is at least this percentage
+ *  of its intra cost
+ */
+#define LOOKAHEAD_SCENE_CUT_PCT     80
+
 /**
  *  Maximum number of reference buffers in DPB manager
  */
@@ -149,7 +189,20 @@
 /*****************************************************************************/
 /* Minimum size of inter prediction unit supported by encoder                */
 /*****************************************************************************/
-#define ENC_MIN_PU_SIZE     16
+#define ENC_MIN_PU_SIZE     8
+
+/*****************************************************************************/
+/* Number of min size prediction units in an MB. Every MB owns these many    */
+/* entries in the pu bank, one per 8x8 quadrant in raster order, whatever    */
+/* its partitioning                                                          */
+/*****************************************************************************/
+#define ENC_NUM_PU_IN_MB    ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE))
+
+/*****************************************************************************/
+/* Maximum number of small diamond steps in the full pel search of a P mb    */
+/* partition. The search starts from candidates close to the 16x16 result    */
+/*****************************************************************************/
+#define MB_PART_FPEL_SRCH_ITERS     4
 
 /*****************************************************************************/
 /* Num cores releated defs                                                   */
@@ -168,7 +221,7 @@
  * Maximum process context sets
  * Used to stagger encoding of MAX_CTXT_SETS in parallel
  */
-#define MAX_CTXT_SETS   1
+#define MAX_CTXT_SETS   2
 /**
  * Maximum number of contexts
  * Kept as twice the number of threads, to make it easier to initialize the contexts
@@ -176,6 +229,33 @@
  */
 #define MAX_PROCESS_CTXT    MAX_NUM_CORES * MAX_CTXT_SETS
 
+/**
+ *  Maximum number of CPUs the codec threads are pinned to, same as
+ *  IH264E_MAX_AFFINITY_CPUS of the API
+ */
+#define MAX_AFFINITY_CPUS   64
+
+/**
+ * Spin rounds on a proc / ME map before a thread blocks on its progress
+ */
+#define MB_MAP_WAIT_SPIN_CNT    8
+
+/**
+ * Statistics stage of a thread waiting on another one, counted after the
+ * stages of IH264E_STATS_STAGE_T, same as IH264E_STATS_NUM_STAGES of the API
+ */
+#define STATS_STAGE_WAIT    6
+
+/**
+ * Statistics stage of a thread outside the encoder, not timed
+ */
+#define STATS_STAGE_IDLE    (-1)
+
+/**
+ * Number of timed statistics stages
+ */
+#define STATS_NUM_STAGES    (STATS_STAGE_WAIT + 1)
+
 /*****************************************************************************/
 /* Profile and level restrictions                                            */
 /*****************************************************************************/
@@ -384,6 +464,16 @@ enum
      */
     MEM_REC_ENTROPY_MUTEX,
 
+    /**
+     * Holds mutex and condition variables of the thread pool
+     */
+    MEM_REC_THREAD_POOL,
+
+    /**
+     * Holds progress primitives for proc and ME map waits
+     */
+    MEM_REC_MB_PROGRESS,
+
     /**
      * Holds memory for Process JOB Queue
      */
@@ -466,6 +556,17 @@ enum
      */
     MEM_REC_MB_INFO_NMB,
 
+    /**
+     * Holds downscaled planes and block motion vectors of the lookahead
+     */
+    MEM_REC_LOOKAHEAD,
+
+    /**
+     * Holds thread handle, mutex and condition variable of the asynchronous
+     * encode interface
+     */
+    MEM_REC_ASYNC,
+
     /**
      * Rate control of memory records.
      */
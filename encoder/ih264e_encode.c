@@ -33,6 +33,9 @@
 * List of Functions
 *  - ih264e_join_threads()
 *  - ih264e_wait_for_thread()
+*  - ih264e_thread_pool_worker()
+*  - ih264e_thread_pool_launch()
+*  - ih264e_thread_pool_wait()
 *  - ih264e_encode()
 *
 ******************************************************************************
@@ -92,6 +95,7 @@
 #include "ih264e_statistics.h"
 #include "ih264e_trace.h"
 #include "ih264e_debug.h"
+#include "ih264e_stats.h"
 #ifdef LOGO_EN
 #include "ih264e_ittiam_logo.h"
 #endif
@@ -122,6 +126,15 @@ void ih264e_join_threads(codec_t *ps_codec)
    WORD32 i = 0;
    WORD32 ret = 0;
 
+   /* pool threads are parked between frames, ask them to exit */
+   if (ps_codec->i4_pool_thread_cnt)
+   {
+       ithread_mutex_lock(ps_codec->pv_thread_pool_mutex);
+       ps_codec->i4_pool_exit = 1;
+       ithread_cond_broadcast(ps_codec->pv_thread_pool_start_cond);
+       ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
+   }
+
    /* join spawned threads */
    while (i < ps_codec->i4_proc_thread_cnt)
    {
@@ -139,6 +152,157 @@ void ih264e_join_threads(codec_t *ps_codec)
    }
 
    ps_codec->i4_proc_thread_cnt = 0;
+   ps_codec->i4_pool_thread_cnt = 0;
+   ps_codec->i4_pool_exit = 0;
+}
+
+/**
+******************************************************************************
+*
+* @brief
+*  Entry point of a thread pool thread
+*
+* @par   Description
+*  Waits on the start condition for a new frame, processes it by calling
+*  ih264e_process_thread() and signals the encode thread when done. Repeats
+*  till the pool is asked to exit
+*
+* @param[in] pv_proc
+*  process context of the thread
+*
+* @returns  none
+*
+******************************************************************************
+*/
+WORD32 ih264e_thread_pool_worker(void *pv_proc)
+{
+    /* proc ctxt */
+    process_ctxt_t *ps_proc = pv_proc;
+
+    /* codec ctxt */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* last frame processed by this thread, set before the thread is created */
+    WORD32 i4_frame_id = ps_proc->i4_pool_frame_id;
+
+    while (1)
+    {
+        ithread_mutex_lock(ps_codec->pv_thread_pool_mutex);
+        while ((i4_frame_id == ps_codec->i4_pool_frame_id)
+                        && (0 == ps_codec->i4_pool_exit))
+        {
+            ithread_cond_wait(ps_codec->pv_thread_pool_start_cond,
+                              ps_codec->pv_thread_pool_mutex);
+        }
+        if (ps_codec->i4_pool_exit)
+        {
+            ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
+            break;
+        }
+        i4_frame_id = ps_codec->i4_pool_frame_id;
+        ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
+
+        ih264e_process_thread(ps_proc);
+
+        ithread_mutex_lock(ps_codec->pv_thread_pool_mutex);
+        ps_codec->i4_pool_busy_cnt--;
+        if (0 == ps_codec->i4_pool_busy_cnt)
+        {
+            ithread_cond_signal(ps_codec->pv_thread_pool_done_cond);
+        }
+        ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
+    }
+
+    return 0;
+}
+
+/**
+******************************************************************************
+*
+* @brief
+*  Hands over the current frame to the thread pool
+*
+* @par   Description
+*  Creates the pool threads on first use, or when the number of cores has
+*  changed since the pool was created. Then wakes up all pool threads to
+*  process the jobs of the current frame
+*
+* @param[in] ps_codec
+*  pointer to codec context
+*
+* @param[in] num_thread_cnt
+*  number of threads in addition to the encode thread
+*
+* @returns  none
+*
+******************************************************************************
+*/
+void ih264e_thread_pool_launch(codec_t *ps_codec, WORD32 num_thread_cnt)
+{
+    /* temp var */
+    WORD32 i, ret;
+
+    if (ps_codec->i4_pool_thread_cnt != num_thread_cnt)
+    {
+        /* core count changed, restart the pool */
+        ih264e_join_threads(ps_codec);
+
+        for (i = 0; i < num_thread_cnt; i++)
+        {
+            /* new threads only pick up frames handed over from here on */
+            ps_codec->as_process[i + 1].i4_pool_frame_id =
+                            ps_codec->i4_pool_frame_id;
+
+            ret = ithread_create(ps_codec->apv_proc_thread_handle[i],
+                                 NULL,
+                                 (void *)ih264e_thread_pool_worker,
+                                 &ps_codec->as_process[i + 1]);
+            if (ret != 0)
+            {
+                printf("pthread Create Failed");
+                assert(0);
+            }
+
+            ps_codec->ai4_process_thread_created[i] = 1;
+
+            ps_codec->i4_proc_thread_cnt++;
+        }
+        ps_codec->i4_pool_thread_cnt = num_thread_cnt;
+    }
+
+    ithread_mutex_lock(ps_codec->pv_thread_pool_mutex);
+    ps_codec->i4_pool_busy_cnt = num_thread_cnt;
+    ps_codec->i4_pool_frame_id++;
+    ithread_cond_broadcast(ps_codec->pv_thread_pool_start_cond);
+    ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
+}
+
+/**
+******************************************************************************
+*
+* @brief
+*  Waits for the thread pool to finish the current frame
+*
+* @par   Description
+*  Blocks on the done condition till all pool threads have returned from
+*  ih264e_process_thread() for the current frame. Pool threads are not joined
+*
+* @param[in] ps_codec
+*  pointer to codec context
+*
+* @returns  none
+*
+******************************************************************************
+*/
+void ih264e_thread_pool_wait(codec_t *ps_codec)
+{
+    ithread_mutex_lock(ps_codec->pv_thread_pool_mutex);
+    while (ps_codec->i4_pool_busy_cnt > 0)
+    {
+        ithread_cond_wait(ps_codec->pv_thread_pool_done_cond,
+                          ps_codec->pv_thread_pool_mutex);
+    }
+    ithread_mutex_unlock(ps_codec->pv_thread_pool_mutex);
 }
 
 /**
@@ -214,6 +378,16 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
     inp_buf_t s_inp_buf;
     out_buf_t s_out_buf;
 
+    /* context set of the picture of the previous call, yet to be returned */
+    WORD32 prev_ctxt_sel = -1;
+
+    /* context set whose bitstream is returned in this call */
+    WORD32 out_ctxt_sel = -1;
+
+    /* rate control time of the input, statistics enable at its start */
+    UWORD64 u8_rc_pre_enc_ns;
+    UWORD32 u4_stats_enable;
+
     /* temp var */
     WORD32 ctxt_sel = 0, i, i4_rc_pre_enc_skip;
 
@@ -225,6 +399,8 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
     ps_video_encode_op->s_ive_op.output_present  = 0;
     ps_video_encode_op->s_ive_op.dump_recon = 0;
     ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_NA_FRAME;
+    ps_video_encode_op->pv_rc_stats = NULL;
+    ps_video_encode_op->u4_rc_stats_size = 0;
 
     /* Check for output memory allocation size */
     if (ps_video_encode_ip->s_ive_ip.s_out_buf.u4_bufsize < MIN_STREAM_SIZE)
@@ -262,7 +438,9 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
         ih264e_codec_init(ps_codec);
     }
 
-    /* parse configuration params */
+    /* parse configuration params. Control calls may fill them from another
+     * thread while the asynchronous interface encodes */
+    ithread_mutex_lock(ps_codec->pv_ctl_mutex);
     for (i = 0; i < MAX_ACTIVE_CONFIG_PARAMS; i++)
     {
         cfg_params_t *ps_cfg = &ps_codec->as_cfg[i];
@@ -274,7 +452,17 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
                             ((WORD32)ps_cfg->u4_timestamp_high == -1) ||
                             ((WORD32)ps_cfg->u4_timestamp_low == -1) )
             {
+                /* the picture in flight is coded with the old config */
+                if (ps_codec->i4_pending_ctxt_sel >= 0)
+                {
+                    error_status |= ih264e_finish_entropy(ps_codec, ps_codec->i4_pending_ctxt_sel);
+                }
+
                 error_status |= ih264e_codec_update_config(ps_codec, ps_cfg);
+                if (IH264E_SUCCESS != error_status)
+                {
+                    ithread_mutex_unlock(ps_codec->pv_ctl_mutex);
+                }
                 SET_ERROR_ON_RETURN(error_status,
                                     IVE_UNSUPPORTEDPARAM,
                                     ps_video_encode_op->s_ive_op.u4_error_code,
@@ -284,6 +472,12 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
             }
         }
     }
+    ithread_mutex_unlock(ps_codec->pv_ctl_mutex);
+
+    /* frame pipelining is limited to constant qp, as rate control needs the
+     * bits consumed by a picture before the qp of the next one is decided */
+    ps_codec->i4_frame_pipelining = ps_codec->s_cfg.u4_frame_pipelining
+                    && (IVE_RC_NONE == ps_codec->s_cfg.e_rc_mode);
 
     /******************************************************************
      * INSERT LOGO
@@ -350,6 +544,12 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
          */
         ps_codec->force_curr_frame_type = IV_IDR_FRAME;
 
+        /* the picture in flight refers to the current sps and pps */
+        if (ps_codec->i4_pending_ctxt_sel >= 0)
+        {
+            error_status |= ih264e_finish_entropy(ps_codec, ps_codec->i4_pending_ctxt_sel);
+        }
+
         /* generate header */
         error_status |= ih264e_generate_sps_pps(ps_codec);
 
@@ -387,13 +587,26 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
     /* curr pic cnt */
      ps_codec->i4_pic_cnt += 1;
 
+    /* time the rate control of the input, when statistics are enabled */
+    u4_stats_enable = ps_codec->s_stats.u4_enable;
+    u8_rc_pre_enc_ns = u4_stats_enable ? ithread_get_time_ns() : 0;
+
     i4_rc_pre_enc_skip = 0;
     i4_rc_pre_enc_skip = ih264e_input_queue_update(
                     ps_codec, &ps_video_encode_ip->s_ive_ip, &s_inp_buf);
 
+    if (u4_stats_enable)
+    {
+        u8_rc_pre_enc_ns = ithread_get_time_ns() - u8_rc_pre_enc_ns;
+    }
+
     s_out_buf.u4_is_last = s_inp_buf.u4_is_last;
     ps_video_encode_op->s_ive_op.u4_is_last = s_inp_buf.u4_is_last;
 
+    /* the picture encoded in the previous call is returned in this call */
+    prev_ctxt_sel = ps_codec->i4_pending_ctxt_sel;
+    ps_codec->i4_pending_ctxt_sel = -1;
+
     /* Only encode if the current frame is not pre-encode skip */
     if (!i4_rc_pre_enc_skip && s_inp_buf.s_raw_buf.apv_bufs[0])
     {
@@ -411,6 +624,12 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
         /* array giving pic cnt that is being processed in curr context set */
         ps_codec->ai4_pic_cnt[ctxt_sel] = ps_codec->i4_pic_cnt;
 
+        /* the picture in flight refers to the sps and pps to be repopulated */
+        if (ps_codec->i4_gen_header && (prev_ctxt_sel >= 0))
+        {
+            error_status |= ih264e_finish_entropy(ps_codec, prev_ctxt_sel);
+        }
+
         /* initialize all relevant process ctxts */
         error_status |= ih264e_pic_init(ps_codec, &s_inp_buf);
         SET_ERROR_ON_RETURN(error_status,
@@ -418,34 +637,94 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
                             ps_video_encode_op->s_ive_op.u4_error_code,
                             IV_FAIL);
 
-        for (i = 0; i < num_thread_cnt; i++)
+        /* the stats of the picture are reset by pic init */
+        ps_proc->s_stats.au8_stage_ns[IH264E_STATS_RC] += u8_rc_pre_enc_ns;
+
+        if (ps_codec->s_cfg.u4_keep_threads_active)
         {
-            ret = ithread_create(ps_codec->apv_proc_thread_handle[i],
-                                 NULL,
-                                 (void *)ih264e_process_thread,
-                                 &ps_codec->as_process[i + 1]);
-            if (ret != 0)
-            {
-                printf("pthread Create Failed");
-                assert(0);
-            }
+            /* wake up pool threads */
+            ih264e_thread_pool_launch(ps_codec, num_thread_cnt);
 
-            ps_codec->ai4_process_thread_created[i] = 1;
+            /* launch job */
+            ih264e_process_thread(ps_proc);
 
-            ps_codec->i4_proc_thread_cnt++;
+            /* Wait for pool threads, they stay alive for the next frame */
+            ih264e_thread_pool_wait(ps_codec);
         }
+        else
+        {
+            for (i = 0; i < num_thread_cnt; i++)
+            {
+                ret = ithread_create(ps_codec->apv_proc_thread_handle[i],
+                                     NULL,
+                                     (void *)ih264e_process_thread,
+                                     &ps_codec->as_process[i + 1]);
+                if (ret != 0)
+                {
+                    printf("pthread Create Failed");
+                    assert(0);
+                }
 
+                ps_codec->ai4_process_thread_created[i] = 1;
 
-        /* launch job */
-        ih264e_process_thread(ps_proc);
+                ps_codec->i4_proc_thread_cnt++;
+            }
 
-        /* Join threads at the end of encoding a frame */
-        ih264e_join_threads(ps_codec);
+            /* launch job */
+            ih264e_process_thread(ps_proc);
+
+            /* Join threads at the end of encoding a frame */
+            ih264e_join_threads(ps_codec);
+        }
 
         ih264_list_reset(ps_codec->pv_proc_jobq);
 
+        /*
+         * With frame pipelining the entropy coding of the current picture is
+         * completed in the next call, while the next picture is analysed.
+         * The output of the last picture is not returned, see below
+         */
+        if ((ps_codec->i4_frame_pipelining || (prev_ctxt_sel >= 0))
+                        && !s_inp_buf.u4_is_last
+                        && !ps_codec->s_rate_control.post_encode_skip[ctxt_sel])
+        {
+            ps_codec->i4_pending_ctxt_sel = ctxt_sel;
+        }
+        else if (ps_codec->i4_frame_pipelining)
+        {
+            error_status |= ih264e_finish_entropy(ps_codec, ctxt_sel);
+        }
+    }
+
+    /* complete the entropy coding of the picture of the previous call */
+    if (prev_ctxt_sel >= 0)
+    {
+        error_status |= ih264e_finish_entropy(ps_codec, prev_ctxt_sel);
+    }
+    SET_ERROR_ON_RETURN(error_status,
+                        IVE_FATALERROR,
+                        ps_video_encode_op->s_ive_op.u4_error_code,
+                        IV_FAIL);
+
+    if (ps_codec->i4_pending_ctxt_sel < 0)
+    {
         ih264_list_reset(ps_codec->pv_entropy_jobq);
     }
+    else
+    {
+        /* more output to follow */
+        s_out_buf.u4_is_last = 0;
+        ps_video_encode_op->s_ive_op.u4_is_last = 0;
+    }
+
+    /* without pipelining the current picture, if encoded, is returned */
+    out_ctxt_sel = prev_ctxt_sel;
+
+    if ((out_ctxt_sel < 0) && (ps_codec->i4_pending_ctxt_sel < 0)
+                    && !i4_rc_pre_enc_skip && s_inp_buf.s_raw_buf.apv_bufs[0])
+    {
+        out_ctxt_sel = ctxt_sel;
+    }
 
 
    /****************************************************************************
@@ -643,49 +922,63 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
      *  We will have to return the output and input buffers unconditionally
      *  so that app can release them
      **************************************************************************/
-    if (!i4_rc_pre_enc_skip
-                    && !ps_codec->s_rate_control.post_encode_skip[ctxt_sel]
-                    && s_inp_buf.s_raw_buf.apv_bufs[0])
+    if ((out_ctxt_sel >= 0)
+                    && !ps_codec->s_rate_control.post_encode_skip[out_ctxt_sel])
     {
+        /* proc ctxt of the picture being returned */
+        process_ctxt_t *ps_proc = &ps_codec->as_process[out_ctxt_sel * MAX_PROCESS_THREADS];
 
         /* receive output back from codec */
-        s_out_buf = ps_codec->as_out_buf[ctxt_sel];
+        s_out_buf = ps_codec->as_out_buf[out_ctxt_sel];
 
         /* send the output to app */
         ps_video_encode_op->s_ive_op.output_present  = 1;
         ps_video_encode_op->s_ive_op.u4_error_code = IV_SUCCESS;
 
         /* Set the time stamps of the encodec input */
-        ps_video_encode_op->s_ive_op.u4_timestamp_low = s_inp_buf.u4_timestamp_low;
-        ps_video_encode_op->s_ive_op.u4_timestamp_high = s_inp_buf.u4_timestamp_high;
-
+        ps_video_encode_op->s_ive_op.u4_timestamp_low = ps_proc->s_inp_buf.u4_timestamp_low;
+        ps_video_encode_op->s_ive_op.u4_timestamp_high = ps_proc->s_inp_buf.u4_timestamp_high;
 
-        switch (ps_codec->pic_type)
+        /* the codec pic type may belong to a later picture */
+        if (ps_proc->u4_is_idr)
         {
-            case PIC_IDR:
-                ps_video_encode_op->s_ive_op.u4_encoded_frame_type =IV_IDR_FRAME;
-                break;
+            ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_IDR_FRAME;
+        }
+        else
+        {
+            switch (ps_proc->i4_slice_type)
+            {
+                case ISLICE:
+                    ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_I_FRAME;
+                    break;
 
-            case PIC_I:
-                ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_I_FRAME;
-                break;
+                case PSLICE:
+                    ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_P_FRAME;
+                    break;
 
-            case PIC_P:
-                ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_P_FRAME;
-                break;
+                case BSLICE:
+                    ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_B_FRAME;
+                    break;
 
-            case PIC_B:
-                ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_B_FRAME;
-                break;
+                default:
+                    ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_NA_FRAME;
+                    break;
+            }
+        }
 
-            default:
-                ps_video_encode_op->s_ive_op.u4_encoded_frame_type = IV_NA_FRAME;
-                break;
+        /* rc stats of the frame, input for a second pass */
+        ps_video_encode_op->pv_rc_stats = &ps_codec->s_rate_control.as_frm_stats[out_ctxt_sel];
+        ps_video_encode_op->u4_rc_stats_size = sizeof(rc_frm_stats_t);
+
+        if (ps_codec->s_stats.u4_enable)
+        {
+            ih264e_stats_frame_done(ps_codec, out_ctxt_sel,
+                                    ps_video_encode_op->s_ive_op.u4_encoded_frame_type);
         }
 
         for (i = 0; i < (WORD32)ps_codec->s_cfg.u4_num_cores; i++)
         {
-            error_status |= ps_codec->as_process[ctxt_sel + i].i4_error_code;
+            error_status |= ps_proc[i].i4_error_code;
         }
         SET_ERROR_ON_RETURN(error_status,
                             IVE_FATALERROR,
@@ -716,6 +1009,12 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
 
         ps_video_encode_op->s_ive_op.u4_encoded_frame_type =  IV_NA_FRAME;
 
+        /* the output buffer is held till its picture is returned */
+        if (ps_codec->i4_pending_ctxt_sel == ctxt_sel)
+        {
+            s_out_buf.s_bits_buf.pv_buf = NULL;
+            s_out_buf.s_bits_buf.u4_bytes = 0;
+        }
     }
 
     /* Send the input to encoder so that it can free it if possible */
@@ -723,10 +1022,13 @@ WORD32 ih264e_encode(iv_obj_t *ps_codec_obj, void *pv_api_ip, void *pv_api_op)
     ps_video_encode_op->s_ive_op.s_inp_buf = s_inp_buf.s_raw_buf;
 
 
-    if (1 == s_inp_buf.u4_is_last)
+    /* a picture delayed by frame pipelining is still returned */
+    if ((1 == s_inp_buf.u4_is_last) && (prev_ctxt_sel < 0))
     {
         ps_video_encode_op->s_ive_op.output_present = 0;
         ps_video_encode_op->s_ive_op.dump_recon = 0;
+        ps_video_encode_op->pv_rc_stats = NULL;
+        ps_video_encode_op->u4_rc_stats_size = 0;
     }
 
     return IV_SUCCESS;
@@ -1004,7 +1004,11 @@ IH264E_ERROR_T ih264e_populate_sps(codec_t *ps_codec, sps_t *ps_sps)
      * To the constrained baseline profile if we add support for B slices, support for encoding interlaced frames,
      * support for weighted prediction and introduce CABAC entropy coding then we have Main Profile.
      */
-    if ((ps_cfg->u4_num_bframes) || (ps_cfg->e_content_type != IV_PROGRESSIVE) ||
+    if (ps_cfg->e_profile == IV_PROFILE_HIGH)
+    {
+        ps_sps->u1_profile_idc = IH264_PROFILE_HIGH;
+    }
+    else if ((ps_cfg->u4_num_bframes) || (ps_cfg->e_content_type != IV_PROGRESSIVE) ||
         (ps_cfg->u4_entropy_coding_mode == CABAC) || (ps_cfg->u4_weighted_prediction))
     {
         ps_sps->u1_profile_idc = IH264_PROFILE_MAIN;
@@ -1129,7 +1133,9 @@ IH264E_ERROR_T ih264e_populate_sps(codec_t *ps_codec, sps_t *ps_sps)
     }
 
     /* direct_8x8_inference_flag */
-    if (ps_sps->u1_level_idc < IH264_LEVEL_30)
+    /* 8x8 transform in direct mbs requires direct_8x8_inference_flag */
+    if (ps_sps->u1_level_idc < IH264_LEVEL_30 &&
+        ps_sps->u1_profile_idc < IH264_PROFILE_HIGH)
     {
         ps_sps->i1_direct_8x8_inference_flag = 0;
     }
@@ -1244,6 +1250,12 @@ IH264E_ERROR_T ih264e_populate_pps(codec_t *ps_codec, pps_t *ps_pps)
     ps_pps->i1_redundant_pic_cnt_present_flag = 0;
 
     ps_pps->u1_slice_group_map_type = 0;
+
+    /* 8x8 transform is enabled for high profile, with flat scaling lists */
+    ps_pps->i1_transform_8x8_mode_flag = (ps_cfg->e_profile == IV_PROFILE_HIGH);
+    ps_pps->i1_pic_scaling_matrix_present_flag = 0;
+    ps_pps->i1_second_chroma_qp_index_offset = ps_pps->i1_chroma_qp_index_offset;
+
     return IH264E_SUCCESS;
 }
 
@@ -1279,9 +1291,7 @@ WORD32 ih264e_populate_slice_header(process_ctxt_t *ps_proc,
     /* entropy context */
     entropy_ctxt_t *ps_entropy = &ps_proc->s_entropy;
 
-    codec_t *ps_codec = ps_proc->ps_codec;
-
-    if (ps_proc->ps_codec->u4_is_curr_frm_ref)
+    if (ps_proc->u4_is_curr_frm_ref)
     {
         ps_slice_hdr->i1_nal_unit_idc = 3;
     }
@@ -1331,7 +1341,7 @@ WORD32 ih264e_populate_slice_header(process_ctxt_t *ps_proc,
     {
 
         WORD32 i4_poc;
-        i4_poc = ps_codec->i4_poc;
+        i4_poc = ps_entropy->i4_abs_pic_order_cnt;
         i4_poc %= (1 << ps_sps->i1_log2_max_pic_order_cnt_lsb);
         ps_slice_hdr->i4_pic_order_cnt_lsb = i4_poc;
     }
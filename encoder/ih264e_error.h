@@ -229,6 +229,21 @@ typedef enum
     /**Invalid Constrained Intra prediction mode */
     IH264E_INVALID_CONSTRAINED_INTRA_PREDICTION_MODE                = IH264E_CODEC_ERROR_START + 0x32,
 
+    /**Two pass rate control stats missing or of invalid size */
+    IH264E_INVALID_RC_STATS                                         = IH264E_CODEC_ERROR_START + 0x33,
+
+    /**Queue of the asynchronous interface has no room for the buffer */
+    IH264E_QUEUE_FULL                                               = IH264E_CODEC_ERROR_START + 0x34,
+
+    /**Queue of the asynchronous interface has no buffer to return */
+    IH264E_QUEUE_EMPTY                                              = IH264E_CODEC_ERROR_START + 0x35,
+
+    /**Call not allowed in the current state of the asynchronous interface */
+    IH264E_ASYNC_INVALID_CALL                                       = IH264E_CODEC_ERROR_START + 0x36,
+
+    /**Invalid CPU set for thread affinity */
+    IH264E_INVALID_CPU_AFFINITY                                     = IH264E_CODEC_ERROR_START + 0x37,
+
     /**max failure error code to ensure enum is 32 bits wide */
     IH264E_FAIL                                                     = -1,
 
@@ -139,6 +139,7 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
     /* Init function pointers for intra pred leaf level functions luma
      * Intra 8x8 */
     ps_codec->apf_intra_pred_8_l[0] = ih264_intra_pred_luma_8x8_mode_vert;
+    ps_codec->apf_intra_pred_8_l[1] = ih264_intra_pred_luma_8x8_mode_horz;
     ps_codec->apf_intra_pred_8_l[2] = ih264_intra_pred_luma_8x8_mode_dc;
     ps_codec->apf_intra_pred_8_l[3] = ih264_intra_pred_luma_8x8_mode_diag_dl;
     ps_codec->apf_intra_pred_8_l[4] = ih264_intra_pred_luma_8x8_mode_diag_dr;
@@ -175,6 +176,7 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
     /* Init fn ptr luma core coding */
     ps_codec->luma_energy_compaction[0] = ih264e_code_luma_intra_macroblock_16x16;
     ps_codec->luma_energy_compaction[1] = ih264e_code_luma_intra_macroblock_4x4;
+    ps_codec->luma_energy_compaction[2] = ih264e_code_luma_intra_macroblock_8x8;
     ps_codec->luma_energy_compaction[3] = ih264e_code_luma_inter_macroblock_16x16;
 
     /* Init fn ptr chroma core coding */
@@ -235,7 +237,10 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
         ps_me_ctxt = &ps_proc->s_me_ctxt;
         ps_me_ctxt->pf_ime_compute_sad_16x16[0] = ime_compute_sad_16x16;
         ps_me_ctxt->pf_ime_compute_sad_16x16[1] = ime_compute_sad_16x16_fast;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[0] = ime_compute_sad_16x16_batch;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[1] = ime_compute_sad_16x16_fast_batch;
         ps_me_ctxt->pf_ime_compute_sad_16x8 = ime_compute_sad_16x8;
+        ps_me_ctxt->pf_ime_compute_sad_8x8 = ime_compute_sad_8x8;
         ps_me_ctxt->pf_ime_compute_sad4_diamond = ime_calculate_sad4_prog;
         ps_me_ctxt->pf_ime_compute_sad3_diamond = ime_calculate_sad3_prog;
         ps_me_ctxt->pf_ime_compute_sad2_diamond = ime_calculate_sad2_prog;
@@ -509,8 +509,6 @@ void ih264e_evaluate_intra16x16_modes_for_least_cost_rdoptoff(process_ctxt_t *ps
 *  the distortion as the deviation b/w input and the predicted block as opposed
 *  to input and reconstructed block.
 *
-*  NOTE: TODO: This function needs to be tested
-*
 *  @return      none
 *
 ******************************************************************************
@@ -620,7 +618,10 @@ void ih264e_evaluate_intra8x8_modes_for_least_cost_rdoptoff(process_ctxt_t *ps_p
         ps_proc->ai4_neighbor_avail_8x8_subblks[b8] = i4_ngbr_avbl;
 
 
-        ih264_intra_pred_luma_8x8_mode_ref_filtering(pu1_mb_a, pu1_mb_b, pu1_mb_d, pu1_ngbr_pels_i8,
+        /* top left pointer also signals the availability of top left pel */
+        ih264_intra_pred_luma_8x8_mode_ref_filtering(pu1_mb_a,
+                                                     (i4_ngbr_avbl & TOP_LEFT_MB_AVAILABLE_MASK) ? pu1_mb_d : NULL,
+                                                     pu1_mb_b, pu1_ngbr_pels_i8,
                                                      i4_src_strd, i4_ngbr_avbl);
 
         i4_partition_cost_least = INT_MAX;
@@ -663,7 +664,7 @@ void ih264e_evaluate_intra8x8_modes_for_least_cost_rdoptoff(process_ctxt_t *ps_p
                 }
                 else if (ps_proc->s_left_mb_syntax_ele.u2_mb_type == I4x4)
                 {
-                    u4_left_intra_8x8_mode = ps_proc->au1_left_mb_intra_modes[(b8+1)*4+2];
+                    u4_left_intra_8x8_mode = ps_proc->au1_left_mb_intra_modes[(b8+1)*4+1];
                 }
             }
             else
@@ -689,6 +690,7 @@ void ih264e_evaluate_intra8x8_modes_for_least_cost_rdoptoff(process_ctxt_t *ps_p
 
             u4_estimated_intra_8x8_mode = MIN(u4_left_intra_8x8_mode, u4_top_intra_8x8_mode);
         }
+        ps_proc->au1_predicted_intra_luma_mb_8x8_modes[b8] = u4_estimated_intra_8x8_mode;
 
         /* perform intra mode 8x8 evaluation */
         for (u4_intra_mode = VERT_I8x8; u4_valid_intra_modes != 0; u4_intra_mode++, u4_valid_intra_modes >>= 1)
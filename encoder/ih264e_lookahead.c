@@ -0,0 +1,514 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_lookahead.c
+*
+* @brief
+*  Contains functions of the lookahead stage. Pictures are analysed on a 2:1
+*  downscaled luma plane before they are handed to rate control, so that
+*  I pictures can be placed on scene cuts
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264e_lookahead_init()
+*  - ih264e_lookahead_downscale()
+*  - ih264e_lookahead_blk_intra_cost()
+*  - ih264e_lookahead_blk_inter_cost()
+*  - ih264e_lookahead_analyse()
+*  - ih264e_lookahead_update()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264e.h"
+#include "ithread.h"
+#include "ih264_defs.h"
+#include "ih264_debug.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_buf_mgr.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_lookahead.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Resets the lookahead queue
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_init(codec_t *ps_codec)
+{
+    lookahead_ctxt_t *ps_lkahd = &ps_codec->s_lookahead;
+
+    ps_lkahd->i4_rd_idx = 0;
+    ps_lkahd->i4_num_frms = 0;
+    ps_lkahd->i4_prev_ds_idx = 0;
+    ps_lkahd->i4_prev_ds_valid = 0;
+    ps_lkahd->i4_ds_wd = 0;
+    ps_lkahd->i4_ds_ht = 0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Downscales the luma plane of an input picture by 2 in both directions
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_raw_buf
+*  Input picture
+*
+* @param[out] pu1_dst
+*  Downscaled plane
+*
+* @returns  none
+*
+* @remarks
+*  For 422 interleaved input the luma samples are read from odd bytes
+*
+*******************************************************************************
+*/
+static void ih264e_lookahead_downscale(codec_t *ps_codec,
+                                       iv_raw_buf_t *ps_raw_buf,
+                                       UWORD8 *pu1_dst)
+{
+    lookahead_ctxt_t *ps_lkahd = &ps_codec->s_lookahead;
+    UWORD8 *pu1_src = ps_raw_buf->apv_bufs[0];
+    WORD32 i4_src_strd = ps_raw_buf->au4_strd[0];
+    WORD32 i4_step = 1;
+    WORD32 i, j;
+
+    if (ps_codec->s_cfg.e_inp_color_fmt == IV_YUV_422ILE)
+    {
+        pu1_src += 1;
+        i4_step = 2;
+    }
+
+    for (i = 0; i < ps_lkahd->i4_ds_ht; i++)
+    {
+        UWORD8 *pu1_row0 = pu1_src + 2 * i * i4_src_strd;
+        UWORD8 *pu1_row1 = pu1_row0 + i4_src_strd;
+
+        for (j = 0; j < ps_lkahd->i4_ds_wd; j++)
+        {
+            WORD32 i4_ofst = 2 * j * i4_step;
+
+            pu1_dst[j] = (pu1_row0[i4_ofst] + pu1_row0[i4_ofst + i4_step]
+                            + pu1_row1[i4_ofst] + pu1_row1[i4_ofst + i4_step]
+                            + 2) >> 2;
+        }
+        pu1_dst += ps_lkahd->i4_ds_strd;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Computes the intra cost of a lookahead block as the sum of absolute
+*  deviations from its mean
+*
+* @param[in] pu1_src
+*  Pointer to the block
+*
+* @param[in] i4_strd
+*  Stride of the plane
+*
+* @returns  Intra cost of the block
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_blk_intra_cost(UWORD8 *pu1_src, WORD32 i4_strd)
+{
+    WORD32 i4_sum = 0, i4_cost = 0, i4_mean;
+    WORD32 i, j;
+
+    for (i = 0; i < LOOKAHEAD_BLK_SIZE; i++)
+    {
+        for (j = 0; j < LOOKAHEAD_BLK_SIZE; j++)
+        {
+            i4_sum += pu1_src[i * i4_strd + j];
+        }
+    }
+
+    i4_mean = (i4_sum + (LOOKAHEAD_BLK_SIZE * LOOKAHEAD_BLK_SIZE / 2))
+                    / (LOOKAHEAD_BLK_SIZE * LOOKAHEAD_BLK_SIZE);
+
+    for (i = 0; i < LOOKAHEAD_BLK_SIZE; i++)
+    {
+        for (j = 0; j < LOOKAHEAD_BLK_SIZE; j++)
+        {
+            i4_cost += ABS(pu1_src[i * i4_strd + j] - i4_mean);
+        }
+    }
+
+    return i4_cost;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Computes the inter cost of a lookahead block against the previous picture
+*
+* @par Description:
+*  The zero vector and the vectors of the left and top blocks are evaluated
+*  and the best of them is refined with a small diamond search. The search is
+*  restricted to LOOKAHEAD_SRCH_RNG and to the picture area
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] pu1_src
+*  Pointer to the block in the current plane
+*
+* @param[in] pu1_ref
+*  Pointer to the co-located block in the previous plane
+*
+* @param[in] i4_blk_x
+*  Horizontal position of the block in blocks
+*
+* @param[in] i4_blk_y
+*  Vertical position of the block in blocks
+*
+* @param[in] i4_blks_in_row
+*  Number of blocks in a row
+*
+* @returns  Inter cost of the block
+*
+* @remarks
+*  The motion vector of the block is stored for use by the next blocks
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_blk_inter_cost(codec_t *ps_codec,
+                                              UWORD8 *pu1_src,
+                                              UWORD8 *pu1_ref,
+                                              WORD32 i4_blk_x,
+                                              WORD32 i4_blk_y,
+                                              WORD32 i4_blks_in_row)
+{
+    lookahead_ctxt_t *ps_lkahd = &ps_codec->s_lookahead;
+    ime_compute_sad_ft *pf_compute_sad =
+                    ps_codec->as_process[0].s_me_ctxt.pf_ime_compute_sad_8x8;
+    WORD16 *pi2_mv = ps_lkahd->pi2_blk_mv
+                    + 2 * (i4_blk_y * i4_blks_in_row + i4_blk_x);
+    WORD32 i4_strd = ps_lkahd->i4_ds_strd;
+    WORD32 i4_pos_x = i4_blk_x * LOOKAHEAD_BLK_SIZE;
+    WORD32 i4_pos_y = i4_blk_y * LOOKAHEAD_BLK_SIZE;
+    WORD32 i4_min_x, i4_max_x, i4_min_y, i4_max_y;
+    WORD32 ai4_cand[3][2];
+    WORD32 i4_num_cand = 1;
+    WORD32 i4_best_x = 0, i4_best_y = 0, i4_best_sad = INT_MAX;
+    WORD32 i, i4_iter;
+
+    /* search window, clipped to the picture */
+    i4_min_x = MAX(-LOOKAHEAD_SRCH_RNG, -i4_pos_x);
+    i4_min_y = MAX(-LOOKAHEAD_SRCH_RNG, -i4_pos_y);
+    i4_max_x = MIN(LOOKAHEAD_SRCH_RNG,
+                   ps_lkahd->i4_ds_wd - LOOKAHEAD_BLK_SIZE - i4_pos_x);
+    i4_max_y = MIN(LOOKAHEAD_SRCH_RNG,
+                   ps_lkahd->i4_ds_ht - LOOKAHEAD_BLK_SIZE - i4_pos_y);
+
+    /* candidates */
+    ai4_cand[0][0] = 0;
+    ai4_cand[0][1] = 0;
+    if (i4_blk_x > 0)
+    {
+        ai4_cand[i4_num_cand][0] = pi2_mv[-2];
+        ai4_cand[i4_num_cand][1] = pi2_mv[-1];
+        i4_num_cand++;
+    }
+    if (i4_blk_y > 0)
+    {
+        ai4_cand[i4_num_cand][0] = pi2_mv[-2 * i4_blks_in_row];
+        ai4_cand[i4_num_cand][1] = pi2_mv[-2 * i4_blks_in_row + 1];
+        i4_num_cand++;
+    }
+
+    for (i = 0; i < i4_num_cand; i++)
+    {
+        WORD32 i4_mv_x = CLIP3(i4_min_x, i4_max_x, ai4_cand[i][0]);
+        WORD32 i4_mv_y = CLIP3(i4_min_y, i4_max_y, ai4_cand[i][1]);
+        WORD32 i4_sad;
+
+        pf_compute_sad(pu1_src, pu1_ref + i4_mv_y * i4_strd + i4_mv_x,
+                       i4_strd, i4_strd, INT_MAX, &i4_sad);
+
+        if (i4_sad < i4_best_sad)
+        {
+            i4_best_sad = i4_sad;
+            i4_best_x = i4_mv_x;
+            i4_best_y = i4_mv_y;
+        }
+    }
+
+    /* small diamond refinement */
+    for (i4_iter = 0; i4_iter < LOOKAHEAD_SRCH_ITERS; i4_iter++)
+    {
+        static const WORD8 ai1_dia[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        WORD32 i4_cntr_x = i4_best_x, i4_cntr_y = i4_best_y;
+
+        for (i = 0; i < 4; i++)
+        {
+            WORD32 i4_mv_x = i4_cntr_x + ai1_dia[i][0];
+            WORD32 i4_mv_y = i4_cntr_y + ai1_dia[i][1];
+            WORD32 i4_sad;
+
+            if (i4_mv_x < i4_min_x || i4_mv_x > i4_max_x
+                            || i4_mv_y < i4_min_y || i4_mv_y > i4_max_y)
+                continue;
+
+            pf_compute_sad(pu1_src, pu1_ref + i4_mv_y * i4_strd + i4_mv_x,
+                           i4_strd, i4_strd, INT_MAX, &i4_sad);
+
+            if (i4_sad < i4_best_sad)
+            {
+                i4_best_sad = i4_sad;
+                i4_best_x = i4_mv_x;
+                i4_best_y = i4_mv_y;
+            }
+        }
+
+        if (i4_cntr_x == i4_best_x && i4_cntr_y == i4_best_y)
+            break;
+    }
+
+    pi2_mv[0] = i4_best_x;
+    pi2_mv[1] = i4_best_y;
+
+    return i4_best_sad;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Analyses a picture entering the lookahead
+*
+* @par Description:
+*  The luma plane is downscaled and, when the previous picture is available,
+*  intra and inter costs are accumulated over all lookahead blocks. The
+*  picture is marked as a scene cut when inter prediction saves too little
+*  over intra prediction
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_frm
+*  Picture entering the lookahead
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+static void ih264e_lookahead_analyse(codec_t *ps_codec, lookahead_frm_t *ps_frm)
+{
+    lookahead_ctxt_t *ps_lkahd = &ps_codec->s_lookahead;
+    WORD32 i4_cur_idx = !ps_lkahd->i4_prev_ds_idx;
+    WORD32 i4_ds_wd = ps_codec->s_cfg.u4_disp_wd >> 1;
+    WORD32 i4_ds_ht = ps_codec->s_cfg.u4_disp_ht >> 1;
+    WORD32 i4_blks_in_row, i4_blks_in_col;
+    WORD32 i4_intra_cost = 0, i4_inter_cost = 0;
+    UWORD8 *pu1_cur, *pu1_prev;
+    WORD32 i, j;
+
+    /* a change in resolution breaks the chain of pictures */
+    if (i4_ds_wd != ps_lkahd->i4_ds_wd || i4_ds_ht != ps_lkahd->i4_ds_ht)
+    {
+        ps_lkahd->i4_ds_wd = i4_ds_wd;
+        ps_lkahd->i4_ds_ht = i4_ds_ht;
+        ps_lkahd->i4_prev_ds_valid = 0;
+    }
+
+    pu1_cur = ps_lkahd->apu1_ds_buf[i4_cur_idx];
+    pu1_prev = ps_lkahd->apu1_ds_buf[!i4_cur_idx];
+
+    ih264e_lookahead_downscale(ps_codec, &ps_frm->s_ive_ip.s_inp_buf, pu1_cur);
+
+    i4_blks_in_row = i4_ds_wd / LOOKAHEAD_BLK_SIZE;
+    i4_blks_in_col = i4_ds_ht / LOOKAHEAD_BLK_SIZE;
+
+    for (i = 0; i < i4_blks_in_col; i++)
+    {
+        for (j = 0; j < i4_blks_in_row; j++)
+        {
+            WORD32 i4_ofst = i * LOOKAHEAD_BLK_SIZE * ps_lkahd->i4_ds_strd
+                            + j * LOOKAHEAD_BLK_SIZE;
+            WORD32 i4_blk_intra, i4_blk_inter;
+
+            i4_blk_intra = ih264e_lookahead_blk_intra_cost(
+                            pu1_cur + i4_ofst, ps_lkahd->i4_ds_strd);
+            i4_intra_cost += i4_blk_intra;
+
+            if (ps_lkahd->i4_prev_ds_valid)
+            {
+                i4_blk_inter = ih264e_lookahead_blk_inter_cost(
+                                ps_codec, pu1_cur + i4_ofst, pu1_prev + i4_ofst,
+                                j, i, i4_blks_in_row);
+                i4_inter_cost += MIN(i4_blk_inter, i4_blk_intra);
+            }
+        }
+    }
+
+    ps_frm->i4_intra_cost = i4_intra_cost;
+    ps_frm->i4_inter_cost = ps_lkahd->i4_prev_ds_valid ? i4_inter_cost : i4_intra_cost;
+
+    /* Flat pictures (mean deviation below one level) are never scene cuts, */
+    /* this keeps fades to and from black from triggering I pictures       */
+    ps_frm->i4_scene_cut = ps_lkahd->i4_prev_ds_valid
+                    && (i4_intra_cost > i4_blks_in_row * i4_blks_in_col
+                                    * LOOKAHEAD_BLK_SIZE * LOOKAHEAD_BLK_SIZE)
+                    && ((WORD64)i4_inter_cost * 100
+                                    >= (WORD64)i4_intra_cost * LOOKAHEAD_SCENE_CUT_PCT);
+
+    ps_lkahd->i4_prev_ds_idx = i4_cur_idx;
+    ps_lkahd->i4_prev_ds_valid = 1;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues an input picture in the lookahead and returns the picture that
+*  leaves it
+*
+* @par Description:
+*  The incoming picture is analysed against its predecessor on a downscaled
+*  luma plane and appended to the queue. Once the queue holds more pictures
+*  than the configured depth, or once the last input has been received, the
+*  oldest picture is removed from the queue and returned
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_ive_ip
+*  Current input arguments to the encoder
+*
+* @returns  Picture leaving the lookahead, NULL while the queue is filling
+*
+* @remarks
+*  The returned picture remains valid until the next call
+*
+*******************************************************************************
+*/
+lookahead_frm_t *ih264e_lookahead_update(codec_t *ps_codec,
+                                         ive_video_encode_ip_t *ps_ive_ip)
+{
+    lookahead_ctxt_t *ps_lkahd = &ps_codec->s_lookahead;
+    lookahead_frm_t *ps_frm;
+
+    /* append the current picture */
+    ps_frm = &ps_lkahd->as_frms[(ps_lkahd->i4_rd_idx + ps_lkahd->i4_num_frms)
+                    % (MAX_LOOKAHEAD_FRAMES + 1)];
+
+    ps_frm->s_ive_ip = *ps_ive_ip;
+    ps_frm->i4_pic_cnt = ps_codec->i4_pic_cnt;
+    ps_frm->e_force_frame_type = ps_codec->force_curr_frame_type;
+    ps_frm->i4_intra_cost = 0;
+    ps_frm->i4_inter_cost = 0;
+    ps_frm->i4_scene_cut = 0;
+
+    ps_codec->force_curr_frame_type = IV_NA_FRAME;
+
+    if (ps_ive_ip->s_inp_buf.apv_bufs[0] != NULL)
+    {
+        ih264e_lookahead_analyse(ps_codec, ps_frm);
+    }
+
+    ps_lkahd->i4_num_frms++;
+
+    /* release the oldest picture */
+    if ((ps_lkahd->i4_num_frms > (WORD32)ps_codec->s_cfg.u4_lookahead)
+                    || ps_codec->i4_last_inp_buff_received)
+    {
+        ps_frm = &ps_lkahd->as_frms[ps_lkahd->i4_rd_idx];
+
+        ps_lkahd->i4_rd_idx = (ps_lkahd->i4_rd_idx + 1)
+                        % (MAX_LOOKAHEAD_FRAMES + 1);
+        ps_lkahd->i4_num_frms--;
+
+        return ps_frm;
+    }
+
+    return NULL;
+}
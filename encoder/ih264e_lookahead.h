@@ -0,0 +1,91 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_lookahead.h
+*
+* @brief
+*  This file contains declarations of functions used by the lookahead stage
+*
+* @author
+*  ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef IH264E_LOOKAHEAD_H_
+#define IH264E_LOOKAHEAD_H_
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Resets the lookahead queue
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_init(codec_t *ps_codec);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Queues an input picture in the lookahead and returns the picture that
+*  leaves it
+*
+* @par Description:
+*  The incoming picture is analysed against its predecessor on a downscaled
+*  luma plane and appended to the queue. Once the queue holds more pictures
+*  than the configured depth, or once the last input has been received, the
+*  oldest picture is removed from the queue and returned
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_ive_ip
+*  Current input arguments to the encoder
+*
+* @returns  Picture leaving the lookahead, NULL while the queue is filling
+*
+* @remarks
+*  The returned picture remains valid until the next call
+*
+*******************************************************************************
+*/
+lookahead_frm_t *ih264e_lookahead_update(codec_t *ps_codec,
+                                         ive_video_encode_ip_t *ps_ive_ip);
+
+#endif /* IH264E_LOOKAHEAD_H_ */
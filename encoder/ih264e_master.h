@@ -60,6 +60,61 @@
 */
 void ih264e_join_threads(codec_t *ps_codec);
 
+/**
+******************************************************************************
+*
+* @brief
+*  Entry point of a thread pool thread
+*
+* @par   Description
+*  Processes one frame every time the pool is launched, till the pool is
+*  asked to exit by ih264e_join_threads()
+*
+* @param[in] pv_proc
+*  process context of the thread
+*
+* @returns  none
+*
+******************************************************************************
+*/
+WORD32 ih264e_thread_pool_worker(void *pv_proc);
+
+/**
+******************************************************************************
+*
+* @brief
+*  Hands over the current frame to the thread pool
+*
+* @par   Description
+*  Creates the pool threads if needed and wakes them up
+*
+* @param[in] ps_codec
+*  pointer to codec context
+*
+* @param[in] num_thread_cnt
+*  number of threads in addition to the encode thread
+*
+* @returns  none
+*
+******************************************************************************
+*/
+void ih264e_thread_pool_launch(codec_t *ps_codec, WORD32 num_thread_cnt);
+
+/**
+******************************************************************************
+*
+* @brief
+*  Waits for the thread pool to finish the current frame
+*
+* @param[in] ps_codec
+*  pointer to codec context
+*
+* @returns  none
+*
+******************************************************************************
+*/
+void ih264e_thread_pool_wait(codec_t *ps_codec);
+
 /**
 ******************************************************************************
 *
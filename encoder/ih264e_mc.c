@@ -160,14 +160,18 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
     i4_ref_strd[1] = i4_ref_strd[2] = i4_ref_strd[3] =
                     ps_me_ctxt->u4_subpel_buf_strd;
 
-    for (u4_num_prtn = 0; u4_num_prtn < ps_proc->u4_num_sub_partitions;
-                    u4_num_prtn++)
+    for (u4_num_prtn = 0; u4_num_prtn < ENC_NUM_PU_IN_MB; u4_num_prtn++)
     {
         mv_t *ps_curr_mv;
 
         /* update ptr to curr partition */
         ps_curr_pu = ps_proc->ps_pu + u4_num_prtn;
 
+        /* every partition is compensated once, from its top left quadrant */
+        if ((ps_curr_pu->b4_pos_x != ((u4_num_prtn & 1) << 1))
+                        || (ps_curr_pu->b4_pos_y != ((u4_num_prtn >> 1) << 1)))
+            continue;
+
         /* Set no no bipred */
         i4_bipred_flag = 0;
 
@@ -226,10 +230,14 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
 
         /* Move ref to position given by MV */
         pu1_ref[0] += ((u4_mv_y_full * i4_ref_strd[0]) + u4_mv_x_full);
+        pu1_ref[0] += 4 * ps_curr_pu->b4_pos_y * i4_ref_strd[0]
+                        + 4 * ps_curr_pu->b4_pos_x;
 
         /* Sub pel ptrs/ Biperd pointers init */
-        pu1_ref[1] = ps_proc->pu1_best_subpel_buf;
         i4_ref_strd[1] = ps_proc->u4_bst_spel_buf_strd;
+        pu1_ref[1] = ps_proc->pu1_best_subpel_buf
+                        + 4 * ps_curr_pu->b4_pos_y * i4_ref_strd[1]
+                        + 4 * ps_curr_pu->b4_pos_x;
 
         /* update pred buff ptr */
         pu1_pred = ps_proc->pu1_pred_mb
@@ -254,8 +262,7 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
 
             }
             /*
-             * Copying half pel or full pel to prediction buffer
-             * Currently ps_proc->u4_num_sub_partitions will always be 1 as we only support 16x16 in P mbs
+             * Copying half pel or full pel of each partition to prediction buffer
              */
             else
             {
@@ -328,13 +335,17 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
     WORD32 u4_mv_y;
     UWORD8 u1_dx, u1_dy;
 
-    for (u4_num_prtn = 0; u4_num_prtn < ps_proc->u4_num_sub_partitions;
-                    u4_num_prtn++)
+    for (u4_num_prtn = 0; u4_num_prtn < ENC_NUM_PU_IN_MB; u4_num_prtn++)
     {
         mv_t *ps_curr_mv;
 
         ps_curr_pu = ps_proc->ps_pu + u4_num_prtn;
 
+        /* every partition is compensated once, from its top left quadrant */
+        if ((ps_curr_pu->b4_pos_x != ((u4_num_prtn & 1) << 1))
+                        || (ps_curr_pu->b4_pos_y != ((u4_num_prtn >> 1) << 1)))
+            continue;
+
         if (ps_curr_pu->b2_pred_mode != PRED_BI)
         {
             ps_curr_mv = &ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv;
@@ -362,9 +373,13 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
             /* move the pointers so that they point to the motion compensated locations */
             pu1_ref += ((u4_mv_y * i4_ref_strd) + (u4_mv_x << 1));
 
+            /* partition offset, chroma is subsampled by 2 and interleaved */
+            pu1_ref += 2 * ps_curr_pu->b4_pos_y * i4_ref_strd
+                            + 4 * ps_curr_pu->b4_pos_x;
+
             pu1_pred = ps_proc->pu1_pred_mb
-                            + 4 * ps_curr_pu->b4_pos_y * i4_pred_strd
-                            + 2 * ps_curr_pu->b4_pos_x;
+                            + 2 * ps_curr_pu->b4_pos_y * i4_pred_strd
+                            + 4 * ps_curr_pu->b4_pos_x;
 
             u1_dx = (u4_mv_x_full << 2) + (u4_mv_x_hpel << 1) + (u4_mv_x_qpel);
             u1_dy = (u4_mv_y_full << 2) + (u4_mv_y_hpel << 1) + (u4_mv_y_qpel);
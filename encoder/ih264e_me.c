@@ -37,11 +37,13 @@
  *  - ih264e_get_search_candidates()
  *  - ih264e_find_skip_motion_vector()
  *  - ih264e_get_mv_predictor()
+ *  - ih264e_get_mb_part_mv_predictor()
  *  - ih264e_mv_pred()
  *  - ih264e_mv_pred_me()
  *  - ih264e_init_me()
  *  - ih264e_compute_me()
  *  - ih264e_compute_me_nmb()
+ *  - ih264e_evaluate_mb_partitions()
  *
  * @remarks
  *  None
@@ -57,11 +59,13 @@
 #include <stdio.h>
 #include <assert.h>
 #include <limits.h>
+#include <string.h>
 
 /* User include files */
 #include "ih264_typedefs.h"
 #include "iv2.h"
 #include "ive2.h"
+#include "ih264e.h"
 #include "ithread.h"
 #include "ih264_platform_macros.h"
 #include "ih264_defs.h"
@@ -96,6 +100,7 @@
 #include "ih264e_half_pel.h"
 #include "ime_statistics.h"
 #include "ih264e_platform_macros.h"
+#include "ih264e_stats.h"
 
 
 /*****************************************************************************/
@@ -217,6 +222,9 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
     /* curr mb indices */
     WORD32 i4_mb_x = ps_proc->i4_mb_x;
 
+    /* neighbour pu */
+    enc_pu_t *ps_left_pu, *ps_top_pu, *ps_top_right_pu;
+
     /* Motion vector */
     mv_t *ps_left_mv, *ps_top_mv, *ps_top_left_mv, *ps_top_right_mv;
 
@@ -244,15 +252,20 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
     /* num of candidate search candidates */
     UWORD32 u4_num_candidates = 0;
 
-    ps_left_mv = &ps_proc->s_left_mb_pu_ME.s_me_info[i4_reflist].s_mv;
-    ps_top_mv = &(ps_proc->ps_top_row_pu_ME + i4_mb_x)->s_me_info[i4_reflist].s_mv;
+    /* neighbouring quadrants adjacent to the top left pel of the current mb */
+    ps_left_pu = &ps_proc->as_left_mb_pu_ME[1];
+    ps_top_pu = ps_proc->ps_top_row_pu_ME + i4_mb_x * ENC_NUM_PU_IN_MB + 2;
+    ps_top_right_pu = ps_top_pu + ENC_NUM_PU_IN_MB;
+
+    ps_left_mv = &ps_left_pu->s_me_info[i4_reflist].s_mv;
+    ps_top_mv = &ps_top_pu->s_me_info[i4_reflist].s_mv;
     ps_top_left_mv = &ps_proc->s_top_left_mb_pu_ME.s_me_info[i4_reflist].s_mv;
-    ps_top_right_mv = &(ps_proc->ps_top_row_pu_ME + i4_mb_x + 1)->s_me_info[i4_reflist].s_mv;
+    ps_top_right_mv = &ps_top_right_pu->s_me_info[i4_reflist].s_mv;
 
-    i4_left_mode = ps_proc->s_left_mb_pu_ME.b2_pred_mode != i4_cmpl_predmode;
-    i4_top_mode = (ps_proc->ps_top_row_pu_ME + i4_mb_x)->b2_pred_mode != i4_cmpl_predmode;
+    i4_left_mode = ps_left_pu->b2_pred_mode != i4_cmpl_predmode;
+    i4_top_mode = ps_top_pu->b2_pred_mode != i4_cmpl_predmode;
     i4_top_left_mode = ps_proc->s_top_left_mb_pu_ME.b2_pred_mode != i4_cmpl_predmode;
-    i4_top_right_mode = (ps_proc->ps_top_row_pu_ME + i4_mb_x + 1)->b2_pred_mode != i4_cmpl_predmode;
+    i4_top_right_mode = ps_top_right_pu->b2_pred_mode != i4_cmpl_predmode;
 
     /* Taking the Zero motion vector as one of the candidates   */
     ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvx = 0;
@@ -402,8 +415,8 @@ WORD32 ih264e_find_pskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 
     UNUSED(i4_reflist);
 
-    ps_left_mb_pu = &ps_proc->s_left_mb_pu ;
-    ps_top_mb_pu = ps_proc->ps_top_row_pu + ps_proc->i4_mb_x;
+    ps_left_mb_pu = &ps_proc->as_left_mb_pu[1];
+    ps_top_mb_pu = ps_proc->ps_top_row_pu + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB + 2;
 
     if ((!ps_proc->ps_ngbr_avbl->u1_mb_a) ||
         (!ps_proc->ps_ngbr_avbl->u1_mb_b) ||
@@ -476,8 +489,8 @@ WORD32 ih264e_find_pskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 
     UNUSED(i4_reflist);
 
-    ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
-    ps_top_mb_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x;
+    ps_left_mb_pu = &ps_proc->as_left_mb_pu_ME[1];
+    ps_top_mb_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB + 2;
 
     if ((!ps_proc->ps_ngbr_avbl->u1_mb_a) ||
         (!ps_proc->ps_ngbr_avbl->u1_mb_b) ||
@@ -519,8 +532,11 @@ WORD32 ih264e_find_pskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 * @param[in] ps_left_mb_pu
 *  pointer to left mb motion vector info
 *
-* @param[in] ps_top_row_pu
-*  pointer to top & top right mb motion vector info
+* @param[in] ps_top_pu
+*  pointer to top mb motion vector info
+*
+* @param[in] ps_top_right_pu
+*  pointer to top right mb motion vector info
 *
 * @param[out] ps_pred_mv
 *  pointer to candidate predictors for the current block
@@ -535,7 +551,8 @@ WORD32 ih264e_find_pskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 *******************************************************************************
 */
 void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
-                             enc_pu_t *ps_top_row_pu,
+                             enc_pu_t *ps_top_pu,
+                             enc_pu_t *ps_top_right_pu,
                              enc_pu_mv_t *ps_pred_mv,
                              WORD32 i4_ref_list)
 {
@@ -552,8 +569,8 @@ void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
         /* If only one of the candidate blocks has a reference frame equal to
          * the current block then use the same block as the final predictor */
         a = (ps_left_mb_pu->s_me_info[i4_ref_list].i1_ref_idx == i1_ref_idx) ? 0 : -1;
-        b = (ps_top_row_pu[0].s_me_info[i4_ref_list].i1_ref_idx == i1_ref_idx) ? 0 : -1;
-        c = (ps_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx == i1_ref_idx) ? 0 : -1;
+        b = (ps_top_pu->s_me_info[i4_ref_list].i1_ref_idx == i1_ref_idx) ? 0 : -1;
+        c = (ps_top_right_pu->s_me_info[i4_ref_list].i1_ref_idx == i1_ref_idx) ? 0 : -1;
 
         if (a == 0 && b == -1 && c == -1)
             pred_algo = 0; /* LEFT */
@@ -571,23 +588,23 @@ void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
                 break;
             case 1:
                 /* top */
-                ps_pred_mv->s_mv.i2_mvx = ps_top_row_pu[0].s_me_info[i4_ref_list].s_mv.i2_mvx;
-                ps_pred_mv->s_mv.i2_mvy = ps_top_row_pu[0].s_me_info[i4_ref_list].s_mv.i2_mvy;
+                ps_pred_mv->s_mv.i2_mvx = ps_top_pu->s_me_info[i4_ref_list].s_mv.i2_mvx;
+                ps_pred_mv->s_mv.i2_mvy = ps_top_pu->s_me_info[i4_ref_list].s_mv.i2_mvy;
                 break;
             case 2:
                 /* top right */
-                ps_pred_mv->s_mv.i2_mvx = ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv.i2_mvx;
-                ps_pred_mv->s_mv.i2_mvy = ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv.i2_mvy;
+                ps_pred_mv->s_mv.i2_mvx = ps_top_right_pu->s_me_info[i4_ref_list].s_mv.i2_mvx;
+                ps_pred_mv->s_mv.i2_mvy = ps_top_right_pu->s_me_info[i4_ref_list].s_mv.i2_mvy;
                 break;
             case 3:
                 /* median */
                 MEDIAN(ps_left_mb_pu->s_me_info[i4_ref_list].s_mv.i2_mvx,
-                       ps_top_row_pu[0].s_me_info[i4_ref_list].s_mv.i2_mvx,
-                       ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv.i2_mvx,
+                       ps_top_pu->s_me_info[i4_ref_list].s_mv.i2_mvx,
+                       ps_top_right_pu->s_me_info[i4_ref_list].s_mv.i2_mvx,
                        ps_pred_mv->s_mv.i2_mvx);
                 MEDIAN(ps_left_mb_pu->s_me_info[i4_ref_list].s_mv.i2_mvy,
-                       ps_top_row_pu[0].s_me_info[i4_ref_list].s_mv.i2_mvy,
-                       ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv.i2_mvy,
+                       ps_top_pu->s_me_info[i4_ref_list].s_mv.i2_mvy,
+                       ps_top_right_pu->s_me_info[i4_ref_list].s_mv.i2_mvy,
                        ps_pred_mv->s_mv.i2_mvy);
 
                 break;
@@ -597,6 +614,283 @@ void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
     }
 }
 
+/**
+*******************************************************************************
+*
+* @brief Returns position and size of a P mb partition
+*
+* @par Description:
+*  Position and size are in units of 8x8 quadrants
+*
+* @param[in] u4_mb_type
+*  P16x8, P8x16 or P8x8
+*
+* @param[in] i4_part_idx
+*  partition index
+*
+* @param[out] pi4_x
+*  horizontal position
+*
+* @param[out] pi4_y
+*  vertical position
+*
+* @param[out] pi4_wd
+*  width
+*
+* @param[out] pi4_ht
+*  height
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_get_mb_part_geometry(UWORD32 u4_mb_type,
+                                        WORD32 i4_part_idx,
+                                        WORD32 *pi4_x,
+                                        WORD32 *pi4_y,
+                                        WORD32 *pi4_wd,
+                                        WORD32 *pi4_ht)
+{
+    if (u4_mb_type == P16x8)
+    {
+        *pi4_x = 0;
+        *pi4_y = i4_part_idx;
+        *pi4_wd = 2;
+        *pi4_ht = 1;
+    }
+    else if (u4_mb_type == P8x16)
+    {
+        *pi4_x = i4_part_idx;
+        *pi4_y = 0;
+        *pi4_wd = 1;
+        *pi4_ht = 2;
+    }
+    else
+    {
+        *pi4_x = i4_part_idx & 1;
+        *pi4_y = i4_part_idx >> 1;
+        *pi4_wd = 1;
+        *pi4_ht = 1;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Returns the neighbouring 8x8 quadrant used for partition mv prediction
+*
+* @par Description:
+*  The position is given in 8x8 units relative to the top left quadrant of the
+*  current mb. Quadrants of the current mb that are not yet assigned a motion
+*  vector and positions right of the current mb are not available.
+*
+* @param[in] ps_left_mb_pu
+*  quadrants of left mb, NULL if not available
+*
+* @param[in] ps_top_mb_pu
+*  quadrants of top mb, NULL if not available
+*
+* @param[in] ps_top_right_pu
+*  bottom left quadrant of top right mb, NULL if not available
+*
+* @param[in] ps_top_left_pu
+*  bottom right quadrant of top left mb, NULL if not available
+*
+* @param[in] ps_curr_mb_pu
+*  quadrants of current mb
+*
+* @param[in] u4_coded_quads
+*  mask of quadrants of current mb whose motion vectors are final
+*
+* @param[in] i4_x
+*  horizontal position
+*
+* @param[in] i4_y
+*  vertical position
+*
+* @returns  pointer to the neighbour, NULL if not available
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static enc_pu_t *ih264e_get_mb_part_ngbr(enc_pu_t *ps_left_mb_pu,
+                                         enc_pu_t *ps_top_mb_pu,
+                                         enc_pu_t *ps_top_right_pu,
+                                         enc_pu_t *ps_top_left_pu,
+                                         enc_pu_t *ps_curr_mb_pu,
+                                         UWORD32 u4_coded_quads,
+                                         WORD32 i4_x,
+                                         WORD32 i4_y)
+{
+    if (i4_y < 0)
+    {
+        if (i4_x < 0)
+            return ps_top_left_pu;
+        if (i4_x < 2)
+            return ps_top_mb_pu ? &ps_top_mb_pu[2 + i4_x] : NULL;
+        return ps_top_right_pu;
+    }
+
+    if (i4_x < 0)
+        return ps_left_mb_pu ? &ps_left_mb_pu[2 * i4_y + 1] : NULL;
+
+    if ((i4_x < 2) && ((u4_coded_quads >> (2 * i4_y + i4_x)) & 1))
+        return &ps_curr_mb_pu[2 * i4_y + i4_x];
+
+    return NULL;
+}
+
+/**
+*******************************************************************************
+*
+* @brief motion vector predictor of a mb partition
+*
+* @par Description:
+*  The routine calculates the L0 motion vector predictor of a 16x8, 8x16 or
+*  8x8 partition of a P mb. Neighbours are addressed at 8x8 granularity, all
+*  earlier partitions of the current mb must already be present in
+*  ps_curr_mb_pu.
+*
+* @param[in] ps_left_mb_pu
+*  quadrants of left mb, NULL if not available
+*
+* @param[in] ps_top_mb_pu
+*  quadrants of top mb, NULL if not available
+*
+* @param[in] ps_top_right_pu
+*  bottom left quadrant of top right mb, NULL if not available
+*
+* @param[in] ps_top_left_pu
+*  bottom right quadrant of top left mb, NULL if not available
+*
+* @param[in] ps_curr_mb_pu
+*  quadrants of current mb
+*
+* @param[in] u4_mb_type
+*  P16x8, P8x16 or P8x8
+*
+* @param[in] i4_part_idx
+*  partition index
+*
+* @param[out] ps_pred_mv
+*  predicted motion vector
+*
+* @returns  none
+*
+* @remarks The code implements the logic as described in sec 8.4.1.3 in H264
+*   specification. Neighbours with a reference other than L0 ref 0 are
+*   treated as mv (0, 0)
+*
+*******************************************************************************
+*/
+void ih264e_get_mb_part_mv_predictor(enc_pu_t *ps_left_mb_pu,
+                                     enc_pu_t *ps_top_mb_pu,
+                                     enc_pu_t *ps_top_right_pu,
+                                     enc_pu_t *ps_top_left_pu,
+                                     enc_pu_t *ps_curr_mb_pu,
+                                     UWORD32 u4_mb_type,
+                                     WORD32 i4_part_idx,
+                                     mv_t *ps_pred_mv)
+{
+    /* partition geometry in 8x8 units */
+    WORD32 i4_x, i4_y, i4_wd, i4_ht;
+
+    /* quadrants of the current mb that precede this partition */
+    UWORD32 u4_coded_quads;
+
+    /* A, B, C neighbours */
+    enc_pu_t *aps_ngbr[3];
+    mv_t as_mv[3];
+    WORD32 ai4_match[3];
+
+    /* temp var */
+    WORD32 i, i4_num_match, i4_pred = -1;
+
+    ih264e_get_mb_part_geometry(u4_mb_type, i4_part_idx, &i4_x, &i4_y, &i4_wd, &i4_ht);
+
+    if (u4_mb_type == P16x8)
+        u4_coded_quads = i4_part_idx ? 0x3 : 0;
+    else if (u4_mb_type == P8x16)
+        u4_coded_quads = i4_part_idx ? 0x5 : 0;
+    else
+        u4_coded_quads = (1 << i4_part_idx) - 1;
+
+    aps_ngbr[0] = ih264e_get_mb_part_ngbr(ps_left_mb_pu, ps_top_mb_pu,
+                                          ps_top_right_pu, ps_top_left_pu,
+                                          ps_curr_mb_pu, u4_coded_quads,
+                                          i4_x - 1, i4_y);
+    aps_ngbr[1] = ih264e_get_mb_part_ngbr(ps_left_mb_pu, ps_top_mb_pu,
+                                          ps_top_right_pu, ps_top_left_pu,
+                                          ps_curr_mb_pu, u4_coded_quads,
+                                          i4_x, i4_y - 1);
+    aps_ngbr[2] = ih264e_get_mb_part_ngbr(ps_left_mb_pu, ps_top_mb_pu,
+                                          ps_top_right_pu, ps_top_left_pu,
+                                          ps_curr_mb_pu, u4_coded_quads,
+                                          i4_x + i4_wd, i4_y - 1);
+
+    /* C is replaced by D when not available */
+    if (NULL == aps_ngbr[2])
+    {
+        aps_ngbr[2] = ih264e_get_mb_part_ngbr(ps_left_mb_pu, ps_top_mb_pu,
+                                              ps_top_right_pu, ps_top_left_pu,
+                                              ps_curr_mb_pu, u4_coded_quads,
+                                              i4_x - 1, i4_y - 1);
+    }
+
+    /* only A available, use it for all three */
+    if ((NULL == aps_ngbr[1]) && (NULL == aps_ngbr[2]) && (NULL != aps_ngbr[0]))
+    {
+        aps_ngbr[1] = aps_ngbr[0];
+        aps_ngbr[2] = aps_ngbr[0];
+    }
+
+    i4_num_match = 0;
+    for (i = 0; i < 3; i++)
+    {
+        ai4_match[i] = (NULL != aps_ngbr[i])
+                        && (aps_ngbr[i]->s_me_info[PRED_L0].i1_ref_idx == -1);
+
+        as_mv[i].i2_mvx = ai4_match[i] ? aps_ngbr[i]->s_me_info[PRED_L0].s_mv.i2_mvx : 0;
+        as_mv[i].i2_mvy = ai4_match[i] ? aps_ngbr[i]->s_me_info[PRED_L0].s_mv.i2_mvy : 0;
+
+        i4_num_match += ai4_match[i];
+    }
+
+    /* directional prediction of 16x8 and 8x16 partitions */
+    if (u4_mb_type == P16x8)
+    {
+        if (i4_part_idx == 0 && ai4_match[1])
+            i4_pred = 1;
+        else if (i4_part_idx == 1 && ai4_match[0])
+            i4_pred = 0;
+    }
+    else if (u4_mb_type == P8x16)
+    {
+        if (i4_part_idx == 0 && ai4_match[0])
+            i4_pred = 0;
+        else if (i4_part_idx == 1 && ai4_match[2])
+            i4_pred = 2;
+    }
+
+    if ((i4_pred == -1) && (i4_num_match == 1))
+    {
+        i4_pred = ai4_match[0] ? 0 : (ai4_match[1] ? 1 : 2);
+    }
+
+    if (i4_pred != -1)
+    {
+        *ps_pred_mv = as_mv[i4_pred];
+    }
+    else
+    {
+        MEDIAN(as_mv[0].i2_mvx, as_mv[1].i2_mvx, as_mv[2].i2_mvx, ps_pred_mv->i2_mvx);
+        MEDIAN(as_mv[0].i2_mvy, as_mv[1].i2_mvy, as_mv[2].i2_mvy, ps_pred_mv->i2_mvy);
+    }
+}
+
 /**
 *******************************************************************************
 *
@@ -618,14 +912,14 @@ void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
 void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
 {
 
-    /* left mb motion vector */
+    /* left mb motion vector, one entry per quadrant */
     enc_pu_t *ps_left_mb_pu;
 
     /* top left mb motion vector */
     enc_pu_t *ps_top_left_mb_pu;
 
-    /* top row motion vector info */
-    enc_pu_t *ps_top_row_pu;
+    /* top and top right mb motion vectors, one entry per quadrant */
+    enc_pu_t *ps_top_mb_pu, *ps_top_right_mb_pu;
 
     /* predicted motion vector */
     enc_pu_mv_t *ps_pred_mv = ps_proc->ps_pred_mv;
@@ -642,13 +936,14 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
     UWORD32 u4_left_is_intra;
 
     /* Temp var */
-    WORD32 i4_reflist, max_reflist, i4_cmpl_predmode;
+    WORD32 i4_reflist, max_reflist, i4_cmpl_predmode, i;
 
     ps_top_left_syn = &(ps_proc->s_top_left_mb_syntax_ele);
     u4_left_is_intra = ps_proc->s_left_mb_syntax_ele.u2_is_intra;
-    ps_left_mb_pu = &ps_proc->s_left_mb_pu;
+    ps_left_mb_pu = ps_proc->as_left_mb_pu;
     ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu;
-    ps_top_row_pu = (ps_proc->ps_top_row_pu + ps_proc->i4_mb_x);
+    ps_top_mb_pu = ps_proc->ps_top_row_pu + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB;
+    ps_top_right_mb_pu = ps_top_mb_pu + ENC_NUM_PU_IN_MB;
 
     /* Number of ref lists to process */
     max_reflist = (i4_slice_type == PSLICE) ? 1 : 2;
@@ -658,20 +953,27 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
         i4_cmpl_predmode = (i4_reflist == 0) ? PRED_L1 : PRED_L0;
 
         /* Before performing mv prediction prepare the ngbr information and
-         * reset motion vectors basing on their availability */
+         * reset motion vectors basing on their availability. Both quadrants
+         * adjacent to the current mb are updated */
         if (!ps_ngbr_avbl->u1_mb_a || (u4_left_is_intra == 1)
-                        || (ps_left_mb_pu->b2_pred_mode == i4_cmpl_predmode))
+                        || (ps_left_mb_pu[1].b2_pred_mode == i4_cmpl_predmode))
         {
             /* left mv */
-            ps_left_mb_pu->s_me_info[i4_reflist].i1_ref_idx = 0;
-            ps_left_mb_pu->s_me_info[i4_reflist].s_mv = zero_mv;
+            for (i = 1; i < ENC_NUM_PU_IN_MB; i += 2)
+            {
+                ps_left_mb_pu[i].s_me_info[i4_reflist].i1_ref_idx = 0;
+                ps_left_mb_pu[i].s_me_info[i4_reflist].s_mv = zero_mv;
+            }
         }
         if (!ps_ngbr_avbl->u1_mb_b || ps_top_syn->u2_is_intra
-                        || (ps_top_row_pu[0].b2_pred_mode == i4_cmpl_predmode))
+                        || (ps_top_mb_pu[2].b2_pred_mode == i4_cmpl_predmode))
         {
             /* top mv */
-            ps_top_row_pu[0].s_me_info[i4_reflist].i1_ref_idx = 0;
-            ps_top_row_pu[0].s_me_info[i4_reflist].s_mv = zero_mv;
+            for (i = 2; i < ENC_NUM_PU_IN_MB; i++)
+            {
+                ps_top_mb_pu[i].s_me_info[i4_reflist].i1_ref_idx = 0;
+                ps_top_mb_pu[i].s_me_info[i4_reflist].s_mv = zero_mv;
+            }
         }
 
         if (!ps_ngbr_avbl->u1_mb_c)
@@ -683,23 +985,59 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
             if (!ps_ngbr_avbl->u1_mb_d || ps_top_left_syn->u2_is_intra
                             || (ps_top_left_mb_pu->b2_pred_mode == i4_cmpl_predmode))
             {
-                ps_top_row_pu[1].s_me_info[i4_reflist].i1_ref_idx = 0;
-                ps_top_row_pu[1].s_me_info[i4_reflist].s_mv = zero_mv;
+                for (i = 2; i < ENC_NUM_PU_IN_MB; i++)
+                {
+                    ps_top_right_mb_pu[i].s_me_info[i4_reflist].i1_ref_idx = 0;
+                    ps_top_right_mb_pu[i].s_me_info[i4_reflist].s_mv = zero_mv;
+                }
             }
             else
             {
-                ps_top_row_pu[1].s_me_info[i4_reflist].i1_ref_idx = ps_top_left_mb_pu->s_me_info[i4_reflist].i1_ref_idx;
-                ps_top_row_pu[1].s_me_info[i4_reflist].s_mv = ps_top_left_mb_pu->s_me_info[i4_reflist].s_mv;
+                for (i = 2; i < ENC_NUM_PU_IN_MB; i++)
+                {
+                    ps_top_right_mb_pu[i].s_me_info[i4_reflist].i1_ref_idx = ps_top_left_mb_pu->s_me_info[i4_reflist].i1_ref_idx;
+                    ps_top_right_mb_pu[i].s_me_info[i4_reflist].s_mv = ps_top_left_mb_pu->s_me_info[i4_reflist].s_mv;
+                }
             }
         }
         else if(ps_top_syn[1].u2_is_intra
-                        || (ps_top_row_pu[1].b2_pred_mode == i4_cmpl_predmode))
+                        || (ps_top_right_mb_pu[2].b2_pred_mode == i4_cmpl_predmode))
+        {
+            for (i = 2; i < ENC_NUM_PU_IN_MB; i++)
+            {
+                ps_top_right_mb_pu[i].s_me_info[i4_reflist].i1_ref_idx = 0;
+                ps_top_right_mb_pu[i].s_me_info[i4_reflist].s_mv = zero_mv;
+            }
+        }
+
+        ih264e_get_mv_predictor(&ps_left_mb_pu[1], &ps_top_mb_pu[2],
+                                &ps_top_right_mb_pu[2], &ps_pred_mv[i4_reflist],
+                                i4_reflist);
+    }
+
+    /* predictors of the individual partitions of a P mb */
+    if ((ps_proc->u4_mb_type == P16x8) || (ps_proc->u4_mb_type == P8x16)
+                    || (ps_proc->u4_mb_type == P8x8))
+    {
+        enc_pu_t s_top_left_pu = *ps_top_left_mb_pu;
+        WORD32 i4_num_parts = (ps_proc->u4_mb_type == P8x8) ? 4 : 2;
+
+        if (ps_top_left_syn->u2_is_intra)
         {
-            ps_top_row_pu[1].s_me_info[i4_reflist].i1_ref_idx = 0;
-            ps_top_row_pu[1].s_me_info[i4_reflist].s_mv = zero_mv;
+            s_top_left_pu.s_me_info[PRED_L0].i1_ref_idx = 0;
+            s_top_left_pu.s_me_info[PRED_L0].s_mv = zero_mv;
         }
 
-        ih264e_get_mv_predictor(ps_left_mb_pu, ps_top_row_pu, &ps_pred_mv[i4_reflist], i4_reflist);
+        for (i = 0; i < i4_num_parts; i++)
+        {
+            ih264e_get_mb_part_mv_predictor(
+                            ps_ngbr_avbl->u1_mb_a ? ps_left_mb_pu : NULL,
+                            ps_ngbr_avbl->u1_mb_b ? ps_top_mb_pu : NULL,
+                            ps_ngbr_avbl->u1_mb_c ? &ps_top_right_mb_pu[2] : NULL,
+                            ps_ngbr_avbl->u1_mb_d ? &s_top_left_pu : NULL,
+                            ps_proc->ps_pu, ps_proc->u4_mb_type, i,
+                            &ps_proc->as_part_pred_mv[i]);
+        }
     }
 
 }
@@ -747,12 +1085,13 @@ void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
     /*  mb neighbor availability */
     block_neighbors_t *ps_ngbr_avbl = ps_proc->ps_ngbr_avbl;
 
-    ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
+    ps_left_mb_pu = &ps_proc->as_left_mb_pu_ME[1];
     ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu_ME;
-    ps_top_row_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x);
+    ps_top_row_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB);
 
-    s_top_row_pu[0] = ps_top_row_pu[0];
-    s_top_row_pu[1] = ps_top_row_pu[1];
+    /* bottom left quadrants of top and top right mbs */
+    s_top_row_pu[0] = ps_top_row_pu[2];
+    s_top_row_pu[1] = ps_top_row_pu[ENC_NUM_PU_IN_MB + 2];
 
     /*
      * Before performing mv prediction prepare the ngbr information and
@@ -792,13 +1131,13 @@ void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
             s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = ps_top_left_mb_pu->s_me_info[0].s_mv;
         }
     }
-    else if (ps_top_row_pu[1].b2_pred_mode == i4_cmpl_predmode)
+    else if (ps_top_row_pu[ENC_NUM_PU_IN_MB + 2].b2_pred_mode == i4_cmpl_predmode)
     {
-        ps_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = 0;
-        ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv = zero_mv;
+        ps_top_row_pu[ENC_NUM_PU_IN_MB + 2].s_me_info[i4_ref_list].i1_ref_idx = 0;
+        ps_top_row_pu[ENC_NUM_PU_IN_MB + 2].s_me_info[i4_ref_list].s_mv = zero_mv;
     }
 
-    ih264e_get_mv_predictor(ps_left_mb_pu, &(s_top_row_pu[0]),
+    ih264e_get_mv_predictor(ps_left_mb_pu, &(s_top_row_pu[0]), &(s_top_row_pu[1]),
                             &ps_pred_mv[i4_ref_list], i4_ref_list);
 }
 
@@ -854,6 +1193,572 @@ void ih264e_init_me(process_ctxt_t *ps_proc)
 }
 
 
+/**
+*******************************************************************************
+*
+* @brief Computes SAD of a P mb partition
+*
+* @par Description:
+*  The partition is evaluated with the 16x8 kernel when possible, otherwise as
+*  a set of 8x8 blocks
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] pu1_src
+*  pointer to top left of source partition
+*
+* @param[in] pu1_ref
+*  pointer to top left of reference partition
+*
+* @param[in] i4_src_strd
+*  source stride
+*
+* @param[in] i4_ref_strd
+*  reference stride
+*
+* @param[in] i4_wd
+*  width in 8x8 units
+*
+* @param[in] i4_ht
+*  height in 8x8 units
+*
+* @returns  SAD of the partition
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_compute_mb_part_sad(me_ctxt_t *ps_me_ctxt,
+                                         UWORD8 *pu1_src,
+                                         UWORD8 *pu1_ref,
+                                         WORD32 i4_src_strd,
+                                         WORD32 i4_ref_strd,
+                                         WORD32 i4_wd,
+                                         WORD32 i4_ht)
+{
+    WORD32 i4_sad = 0, i4_blk_sad, i, j;
+
+    if (i4_wd == 2 && i4_ht == 1)
+    {
+        ps_me_ctxt->pf_ime_compute_sad_16x8(pu1_src, pu1_ref, i4_src_strd,
+                                            i4_ref_strd, INT_MAX, &i4_sad);
+        return i4_sad;
+    }
+
+    for (j = 0; j < i4_ht; j++)
+    {
+        for (i = 0; i < i4_wd; i++)
+        {
+            ps_me_ctxt->pf_ime_compute_sad_8x8(pu1_src + 8 * j * i4_src_strd + 8 * i,
+                                               pu1_ref + 8 * j * i4_ref_strd + 8 * i,
+                                               i4_src_strd, i4_ref_strd,
+                                               INT_MAX, &i4_blk_sad);
+            i4_sad += i4_blk_sad;
+        }
+    }
+
+    return i4_sad;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Assigns a motion vector to the quadrants covered by a P mb partition
+*
+* @par Description:
+*
+* @param[out] ps_mb_pu
+*  quadrants of current mb
+*
+* @param[in] i4_x
+*  horizontal position of the partition in 8x8 units
+*
+* @param[in] i4_y
+*  vertical position of the partition in 8x8 units
+*
+* @param[in] i4_wd
+*  width of the partition in 8x8 units
+*
+* @param[in] i4_ht
+*  height of the partition in 8x8 units
+*
+* @param[in] ps_mv
+*  L0 motion vector in qpel units
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_set_mb_part_pu(enc_pu_t *ps_mb_pu,
+                                  WORD32 i4_x,
+                                  WORD32 i4_y,
+                                  WORD32 i4_wd,
+                                  WORD32 i4_ht,
+                                  mv_t *ps_mv)
+{
+    WORD32 i, j;
+
+    for (j = i4_y; j < i4_y + i4_ht; j++)
+    {
+        for (i = i4_x; i < i4_x + i4_wd; i++)
+        {
+            enc_pu_t *ps_pu = &ps_mb_pu[2 * j + i];
+
+            ps_pu->b1_intra_flag = 0;
+            ps_pu->b2_pred_mode = PRED_L0;
+            ps_pu->b4_pos_x = i4_x << 1;
+            ps_pu->b4_pos_y = i4_y << 1;
+            ps_pu->b4_wd = (i4_wd << 1) - 1;
+            ps_pu->b4_ht = (i4_ht << 1) - 1;
+            ps_pu->s_me_info[PRED_L0].s_mv = *ps_mv;
+            ps_pu->s_me_info[PRED_L0].i1_ref_idx = -1;
+            ps_pu->s_me_info[PRED_L1].i1_ref_idx = 0;
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Full pel search of a P mb partition
+*
+* @par Description:
+*  The candidates are evaluated first and the best of them is refined with a
+*  small diamond for at most MB_PART_FPEL_SRCH_ITERS steps. All motion vectors
+*  are clipped to the search range of the current mb.
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] i4_x, i4_y, i4_wd, i4_ht
+*  partition position and size in 8x8 units
+*
+* @param[in] ps_mvp
+*  predicted motion vector in qpel units
+*
+* @param[in] ps_cands
+*  search candidates in full pel units
+*
+* @param[in] i4_num_cands
+*  number of search candidates
+*
+* @param[out] ps_mv
+*  best motion vector in full pel units
+*
+* @param[out] pi4_sad
+*  SAD at the best motion vector
+*
+* @returns  cost at the best motion vector
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_mb_part_fpel_search(me_ctxt_t *ps_me_ctxt,
+                                         WORD32 i4_x,
+                                         WORD32 i4_y,
+                                         WORD32 i4_wd,
+                                         WORD32 i4_ht,
+                                         mv_t *ps_mvp,
+                                         mv_t *ps_cands,
+                                         WORD32 i4_num_cands,
+                                         mv_t *ps_mv,
+                                         WORD32 *pi4_sad)
+{
+    /* small diamond */
+    static const WORD8 ai1_dx[4] = { -1, 1, 0, 0 };
+    static const WORD8 ai1_dy[4] = { 0, 0, -1, 1 };
+
+    WORD32 i4_src_strd = ps_me_ctxt->i4_src_strd;
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+    UWORD8 *pu1_src = ps_me_ctxt->pu1_src_buf_luma + 8 * (i4_y * i4_src_strd + i4_x);
+    UWORD8 *pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] + 8 * (i4_y * i4_rec_strd + i4_x);
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+    UWORD32 u4_lambda_motion = ps_me_ctxt->u4_lambda_motion;
+
+    WORD32 i4_cost, i4_sad, i4_best_cost = INT_MAX, i4_best_sad = INT_MAX;
+    WORD32 i4_mvx, i4_mvy, i4_best_mvx = 0, i4_best_mvy = 0;
+    WORD32 i, i4_iter;
+
+    for (i = 0; i < i4_num_cands; i++)
+    {
+        i4_mvx = CLIP3(ps_me_ctxt->i4_srch_range_w, ps_me_ctxt->i4_srch_range_e, ps_cands[i].i2_mvx);
+        i4_mvy = CLIP3(ps_me_ctxt->i4_srch_range_n, ps_me_ctxt->i4_srch_range_s, ps_cands[i].i2_mvy);
+
+        i4_sad = ih264e_compute_mb_part_sad(ps_me_ctxt, pu1_src,
+                                            pu1_ref + i4_mvy * i4_rec_strd + i4_mvx,
+                                            i4_src_strd, i4_rec_strd, i4_wd, i4_ht);
+
+        i4_cost = i4_sad + u4_lambda_motion * (pu1_mv_bits[(i4_mvx << 2) - ps_mvp->i2_mvx]
+                        + pu1_mv_bits[(i4_mvy << 2) - ps_mvp->i2_mvy]);
+
+        if (i4_cost < i4_best_cost)
+        {
+            i4_best_cost = i4_cost;
+            i4_best_sad = i4_sad;
+            i4_best_mvx = i4_mvx;
+            i4_best_mvy = i4_mvy;
+        }
+    }
+
+    for (i4_iter = 0; i4_iter < MB_PART_FPEL_SRCH_ITERS; i4_iter++)
+    {
+        WORD32 i4_cntr_mvx = i4_best_mvx, i4_cntr_mvy = i4_best_mvy;
+
+        for (i = 0; i < 4; i++)
+        {
+            i4_mvx = i4_cntr_mvx + ai1_dx[i];
+            i4_mvy = i4_cntr_mvy + ai1_dy[i];
+
+            if ((i4_mvx < ps_me_ctxt->i4_srch_range_w) || (i4_mvx > ps_me_ctxt->i4_srch_range_e)
+                            || (i4_mvy < ps_me_ctxt->i4_srch_range_n) || (i4_mvy > ps_me_ctxt->i4_srch_range_s))
+                continue;
+
+            i4_sad = ih264e_compute_mb_part_sad(ps_me_ctxt, pu1_src,
+                                                pu1_ref + i4_mvy * i4_rec_strd + i4_mvx,
+                                                i4_src_strd, i4_rec_strd, i4_wd, i4_ht);
+
+            i4_cost = i4_sad + u4_lambda_motion * (pu1_mv_bits[(i4_mvx << 2) - ps_mvp->i2_mvx]
+                            + pu1_mv_bits[(i4_mvy << 2) - ps_mvp->i2_mvy]);
+
+            if (i4_cost < i4_best_cost)
+            {
+                i4_best_cost = i4_cost;
+                i4_best_sad = i4_sad;
+                i4_best_mvx = i4_mvx;
+                i4_best_mvy = i4_mvy;
+            }
+        }
+
+        if ((i4_best_mvx == i4_cntr_mvx) && (i4_best_mvy == i4_cntr_mvy))
+            break;
+    }
+
+    ps_mv->i2_mvx = i4_best_mvx;
+    ps_mv->i2_mvy = i4_best_mvy;
+    *pi4_sad = i4_best_sad;
+
+    return i4_best_cost;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Half pel refinement of a P mb partition
+*
+* @par Description:
+*  Half pel planes are generated around the full pel motion vector of the
+*  partition and the 8 neighbouring half pel positions are evaluated. If one
+*  of them wins, its samples are copied to the co-located part of
+*  apu1_subpel_buffs[3].
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_x, i4_y, i4_wd, i4_ht
+*  partition position and size in 8x8 units
+*
+* @param[in] ps_mvp
+*  predicted motion vector in qpel units
+*
+* @param[in/out] ps_mv
+*  full pel motion vector in qpel units on input, refined motion vector on
+*  output
+*
+* @param[in/out] pi4_sad
+*  SAD at the full pel motion vector on input, at the refined motion vector
+*  on output
+*
+* @returns  cost at the refined motion vector
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_mb_part_hpel_search(process_ctxt_t *ps_proc,
+                                         WORD32 i4_x,
+                                         WORD32 i4_y,
+                                         WORD32 i4_wd,
+                                         WORD32 i4_ht,
+                                         mv_t *ps_mvp,
+                                         mv_t *ps_mv,
+                                         WORD32 *pi4_sad)
+{
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    WORD32 i4_src_strd = ps_me_ctxt->i4_src_strd;
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+    WORD32 i4_hp_strd = HP_BUFF_WD;
+    WORD32 i4_part_offset = 8 * (i4_y * i4_hp_strd + i4_x);
+    UWORD8 *pu1_src = ps_me_ctxt->pu1_src_buf_luma + 8 * (i4_y * i4_src_strd + i4_x);
+    UWORD8 *pu1_hpel_src;
+    UWORD8 *pu1_best_buf = NULL;
+    UWORD8 *pu1_buf;
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+    UWORD32 u4_lambda_motion = ps_me_ctxt->u4_lambda_motion;
+
+    WORD32 i4_mvx = ps_mv->i2_mvx, i4_mvy = ps_mv->i2_mvy;
+    WORD32 i4_cost, i4_sad, i4_best_cost, i4_dx, i4_dy;
+
+    i4_best_cost = *pi4_sad + u4_lambda_motion * (pu1_mv_bits[i4_mvx - ps_mvp->i2_mvx]
+                    + pu1_mv_bits[i4_mvy - ps_mvp->i2_mvy]);
+
+    /* half pel planes of the mb at the full pel mv of the partition, laid
+     * out as in the 16x16 search */
+    pu1_hpel_src = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] + (i4_mvx >> 2)
+                    + (i4_mvy >> 2) * i4_rec_strd - 1;
+
+    ps_codec->pf_ih264e_sixtapfilter_horz(pu1_hpel_src,
+                                          ps_proc->apu1_subpel_buffs[0],
+                                          i4_rec_strd, i4_hp_strd);
+
+    pu1_hpel_src -= i4_rec_strd;
+
+    ps_codec->pf_ih264e_sixtap_filter_2dvh_vert(pu1_hpel_src,
+                                                ps_proc->apu1_subpel_buffs[1],
+                                                ps_proc->apu1_subpel_buffs[2],
+                                                i4_rec_strd, i4_hp_strd,
+                                                ps_proc->ai16_pred1 + 3,
+                                                i4_hp_strd);
+
+    for (i4_dy = -1; i4_dy <= 1; i4_dy++)
+    {
+        for (i4_dx = -1; i4_dx <= 1; i4_dx++)
+        {
+            if (i4_dx == 0 && i4_dy == 0)
+                continue;
+
+            if (i4_dy == 0)
+                pu1_buf = ps_proc->apu1_subpel_buffs[0] + (i4_dx == 1);
+            else if (i4_dx == 0)
+                pu1_buf = ps_proc->apu1_subpel_buffs[1] + 1 + (i4_dy == 1) * i4_hp_strd;
+            else
+                pu1_buf = ps_proc->apu1_subpel_buffs[2] + (i4_dx == 1) + (i4_dy == 1) * i4_hp_strd;
+
+            pu1_buf += i4_part_offset;
+
+            i4_sad = ih264e_compute_mb_part_sad(ps_me_ctxt, pu1_src, pu1_buf,
+                                                i4_src_strd, i4_hp_strd,
+                                                i4_wd, i4_ht);
+
+            i4_cost = i4_sad + u4_lambda_motion * (pu1_mv_bits[i4_mvx + 2 * i4_dx - ps_mvp->i2_mvx]
+                            + pu1_mv_bits[i4_mvy + 2 * i4_dy - ps_mvp->i2_mvy]);
+
+            if (i4_cost < i4_best_cost)
+            {
+                i4_best_cost = i4_cost;
+                *pi4_sad = i4_sad;
+                ps_mv->i2_mvx = i4_mvx + 2 * i4_dx;
+                ps_mv->i2_mvy = i4_mvy + 2 * i4_dy;
+                pu1_best_buf = pu1_buf;
+            }
+        }
+    }
+
+    if (pu1_best_buf)
+    {
+        ps_codec->pf_inter_pred_luma_copy(pu1_best_buf,
+                                          ps_proc->apu1_subpel_buffs[3] + i4_part_offset,
+                                          i4_hp_strd, i4_hp_strd,
+                                          i4_ht << 3, i4_wd << 3, NULL, 0);
+    }
+
+    return i4_best_cost;
+}
+
+/**
+*******************************************************************************
+*
+* @brief This function evaluates P mb partitions for the current mb
+*
+* @par Description:
+*  Every partition mode enabled in u4_mb_part_modes is searched at full pel,
+*  each partition starting from the 16x16 mv, its rounded predictor and the
+*  mv of the previous partition. 8x8 is tried only when 16x8 or 8x16 improved
+*  on 16x16. The best mode is refined to half pel and replaces the 16x16
+*  decision of the current mb if it is cheaper.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_fpel_cost_16x16
+*  full pel cost of the 16x16 partition
+*
+* @returns  none
+*
+* @remarks Single reference, L0 only. Must be called after the 16x16 result is
+*  stored in the pu of the current mb
+*
+*******************************************************************************
+*/
+void ih264e_evaluate_mb_partitions(process_ctxt_t *ps_proc, WORD32 i4_fpel_cost_16x16)
+{
+    /* partition modes in the order of evaluation */
+    static const UWORD32 au4_mb_types[3] = { P16x8, P8x16, P8x8 };
+
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+    codec_t *ps_codec = ps_proc->ps_codec;
+    block_neighbors_t *ps_ngbr_avbl = ps_proc->ps_ngbr_avbl;
+
+    /* neighbours of the current mb */
+    enc_pu_t *ps_top_mb_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB;
+    enc_pu_t *ps_left_pu = ps_ngbr_avbl->u1_mb_a ? ps_proc->as_left_mb_pu_ME : NULL;
+    enc_pu_t *ps_top_pu = ps_ngbr_avbl->u1_mb_b ? ps_top_mb_pu : NULL;
+    enc_pu_t *ps_top_right_pu = ps_ngbr_avbl->u1_mb_c ? &ps_top_mb_pu[ENC_NUM_PU_IN_MB + 2] : NULL;
+    enc_pu_t *ps_top_left_pu = ps_ngbr_avbl->u1_mb_d ? &ps_proc->s_top_left_mb_pu_ME : NULL;
+
+    /* quadrants of the mode under evaluation and of the best mode */
+    enc_pu_t as_mb_pu[ENC_NUM_PU_IN_MB], as_best_mb_pu[ENC_NUM_PU_IN_MB];
+
+    /* per partition SAD of the best mode */
+    WORD32 ai4_part_sad[ENC_NUM_PU_IN_MB], ai4_best_part_sad[ENC_NUM_PU_IN_MB];
+
+    /* full pel 16x16 mv */
+    mv_t s_mv_16x16;
+
+    UWORD32 u4_mb_type, u4_best_mb_type = P16x16;
+    WORD32 i4_cost, i4_best_cost = INT_MAX, i4_distortion;
+    WORD32 i4_num_parts, i4_mode, i;
+    WORD32 i4_x, i4_y, i4_wd, i4_ht;
+    UWORD32 u4_lambda_motion = ps_me_ctxt->u4_lambda_motion;
+
+    s_mv_16x16.i2_mvx = ps_proc->ps_pu->s_me_info[PRED_L0].s_mv.i2_mvx >> 2;
+    s_mv_16x16.i2_mvy = ps_proc->ps_pu->s_me_info[PRED_L0].s_mv.i2_mvy >> 2;
+
+    /**************************************************************************
+     * full pel search of all enabled modes
+     **************************************************************************/
+    for (i4_mode = 0; i4_mode < 3; i4_mode++)
+    {
+        u4_mb_type = au4_mb_types[i4_mode];
+
+        if (!(ps_codec->u4_mb_part_modes & (1 << u4_mb_type)))
+            continue;
+
+        /* 8x8 is worth a try only if a coarser partitioning helped */
+        if ((u4_mb_type == P8x8) && (i4_best_cost >= i4_fpel_cost_16x16)
+                        && (ps_codec->u4_mb_part_modes & ((1 << P16x8) | (1 << P8x16))))
+            continue;
+
+        i4_num_parts = (u4_mb_type == P8x8) ? 4 : 2;
+
+        /* mode overhead over 16x16 in bits : mb_type and sub_mb_types */
+        i4_cost = u4_lambda_motion * ((u4_mb_type == P8x8) ? 6 : 2);
+
+        memcpy(as_mb_pu, ps_proc->ps_pu, sizeof(as_mb_pu));
+
+        for (i = 0; i < i4_num_parts; i++)
+        {
+            mv_t s_mvp, s_mv, as_cands[3];
+            WORD32 i4_num_cands = 0;
+
+            ih264e_get_mb_part_geometry(u4_mb_type, i, &i4_x, &i4_y, &i4_wd, &i4_ht);
+
+            ih264e_get_mb_part_mv_predictor(ps_left_pu, ps_top_pu,
+                                            ps_top_right_pu, ps_top_left_pu,
+                                            as_mb_pu, u4_mb_type, i, &s_mvp);
+
+            as_cands[i4_num_cands++] = s_mv_16x16;
+            as_cands[i4_num_cands].i2_mvx = (s_mvp.i2_mvx + 2) >> 2;
+            as_cands[i4_num_cands++].i2_mvy = (s_mvp.i2_mvy + 2) >> 2;
+            if (i > 0)
+            {
+                WORD32 i4_prev_x, i4_prev_y, i4_prev_wd, i4_prev_ht;
+
+                ih264e_get_mb_part_geometry(u4_mb_type, i - 1, &i4_prev_x,
+                                            &i4_prev_y, &i4_prev_wd, &i4_prev_ht);
+
+                as_cands[i4_num_cands].i2_mvx = as_mb_pu[2 * i4_prev_y + i4_prev_x].s_me_info[PRED_L0].s_mv.i2_mvx >> 2;
+                as_cands[i4_num_cands++].i2_mvy = as_mb_pu[2 * i4_prev_y + i4_prev_x].s_me_info[PRED_L0].s_mv.i2_mvy >> 2;
+            }
+
+            i4_cost += ih264e_mb_part_fpel_search(ps_me_ctxt, i4_x, i4_y, i4_wd,
+                                                  i4_ht, &s_mvp, as_cands,
+                                                  i4_num_cands, &s_mv,
+                                                  &ai4_part_sad[i]);
+
+            s_mv.i2_mvx <<= 2;
+            s_mv.i2_mvy <<= 2;
+            ih264e_set_mb_part_pu(as_mb_pu, i4_x, i4_y, i4_wd, i4_ht, &s_mv);
+        }
+
+        if (i4_cost < i4_best_cost)
+        {
+            i4_best_cost = i4_cost;
+            u4_best_mb_type = u4_mb_type;
+            memcpy(as_best_mb_pu, as_mb_pu, sizeof(as_mb_pu));
+            memcpy(ai4_best_part_sad, ai4_part_sad, sizeof(ai4_part_sad));
+        }
+    }
+
+    if (i4_best_cost >= i4_fpel_cost_16x16)
+        return;
+
+    i4_num_parts = (u4_best_mb_type == P8x8) ? 4 : 2;
+
+    /**************************************************************************
+     * half pel refinement of the best mode, the predictors are recomputed as
+     * earlier partitions may have moved
+     **************************************************************************/
+    if (ps_me_ctxt->u4_enable_hpel)
+    {
+        i4_best_cost = u4_lambda_motion * ((u4_best_mb_type == P8x8) ? 6 : 2);
+
+        for (i = 0; i < i4_num_parts; i++)
+        {
+            mv_t s_mvp, s_mv;
+
+            ih264e_get_mb_part_geometry(u4_best_mb_type, i, &i4_x, &i4_y, &i4_wd, &i4_ht);
+
+            ih264e_get_mb_part_mv_predictor(ps_left_pu, ps_top_pu,
+                                            ps_top_right_pu, ps_top_left_pu,
+                                            as_best_mb_pu, u4_best_mb_type, i,
+                                            &s_mvp);
+
+            s_mv = as_best_mb_pu[2 * i4_y + i4_x].s_me_info[PRED_L0].s_mv;
+
+            i4_best_cost += ih264e_mb_part_hpel_search(ps_proc, i4_x, i4_y, i4_wd,
+                                                       i4_ht, &s_mvp, &s_mv,
+                                                       &ai4_best_part_sad[i]);
+
+            ih264e_set_mb_part_pu(as_best_mb_pu, i4_x, i4_y, i4_wd, i4_ht, &s_mv);
+        }
+    }
+
+    if (i4_best_cost >= ps_proc->ps_cur_mb->i4_mb_cost)
+        return;
+
+    /**************************************************************************
+     * partitioned mb is cheaper, update the mb decision
+     **************************************************************************/
+    i4_distortion = 0;
+    for (i = 0; i < i4_num_parts; i++)
+    {
+        i4_distortion += ai4_best_part_sad[i];
+    }
+
+    if (ps_me_ctxt->u4_enable_hpel)
+    {
+        ps_codec->pf_inter_pred_luma_copy(ps_proc->apu1_subpel_buffs[3],
+                                          ps_proc->pu1_best_subpel_buf,
+                                          HP_BUFF_WD,
+                                          ps_proc->u4_bst_spel_buf_strd,
+                                          MB_SIZE, MB_SIZE, NULL, 0);
+    }
+
+    memcpy(ps_proc->ps_pu, as_best_mb_pu, sizeof(as_best_mb_pu));
+
+    ps_proc->ps_cur_mb->u4_mb_type = u4_best_mb_type;
+    ps_proc->ps_cur_mb->i4_mb_cost = i4_best_cost;
+    ps_proc->ps_cur_mb->i4_mb_distortion = i4_distortion;
+
+    *(ps_proc->pu4_mb_pu_cnt) = i4_num_parts;
+}
+
 /**
 *******************************************************************************
 *
@@ -896,6 +1801,9 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     /* Mb part ctxts for SKIP */
     mb_part_ctxt s_skip_mbpart;
 
+    /* full pel cost of 16x16, threshold for the partition search */
+    WORD32 i4_fpel_cost_16x16 = INT_MAX;
+
     /* Sad therholds */
     ps_me_ctxt->pu2_sad_thrsh = ps_qp_params->pu2_sad_thrsh;
 
@@ -978,6 +1886,9 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
         /********************************************************************/
         ime_full_pel_motion_estimation_16x16(ps_me_ctxt, PRED_L0);
 
+        i4_fpel_cost_16x16 = MIN(ps_me_ctxt->as_mb_part[PRED_L0].i4_mb_cost,
+                                 s_skip_mbpart.i4_mb_cost);
+
         /* Scale the MV to qpel resolution */
         ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvx <<= 2;
         ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvy <<= 2;
@@ -1077,6 +1988,15 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     ps_proc->ps_pu->b4_wd = 3;
     ps_proc->ps_pu->b4_ht = 3;
 
+    /* 16x16 mv is shared by all quadrants */
+    ps_proc->ps_pu[1] = ps_proc->ps_pu[2] = ps_proc->ps_pu[3] = ps_proc->ps_pu[0];
+
+    /* Evaluate smaller partitions unless the 16x16 search stopped early */
+    if (ps_codec->u4_mb_part_modes && !ps_me_ctxt->u4_min_sad_reached)
+    {
+        ih264e_evaluate_mb_partitions(ps_proc, i4_fpel_cost_16x16);
+    }
+
     /* Update min sad conditions */
     if (ps_me_ctxt->u4_min_sad_reached == 1)
     {
@@ -1125,6 +2045,7 @@ void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count)
         {
             /* Wait for top right ME to be done */
             UWORD8 *pu1_me_map_tp_rw = ps_proc->pu1_me_map + (ps_proc->i4_mb_y - 1) * ps_proc->i4_wd_mbs;
+            ithread_wait_state_t s_wait = {0, 0};
 
             while (1)
             {
@@ -1135,8 +2056,11 @@ void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count)
                 pu1_buf =  pu1_me_map_tp_rw + idx;
                 if(*pu1_buf)
                     break;
-                ithread_yield();
+                STATS_SWITCH(ps_proc, STATS_STAGE_WAIT);
+                if(!ithread_progress_spin(ps_proc->ps_codec->pv_me_map_progress, &s_wait))
+                    ithread_progress_wait(ps_proc->ps_codec->pv_me_map_progress, &s_wait);
             }
+            STATS_SWITCH(ps_proc, IH264E_STATS_ME);
         }
 
         ps_proc->ps_skip_mv = &(ps_proc->ps_nmb_info[u4_i].as_skip_mv[0]);
@@ -1172,17 +2096,17 @@ void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count)
         {
             mb_info_t *ps_top_syn = ps_proc->ps_top_row_mb_syntax_ele + ps_proc->i4_mb_x;
             mb_info_t *ps_top_left_syn = &(ps_proc->s_top_left_mb_syntax_ME);
-            enc_pu_t *ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
+            enc_pu_t *ps_left_mb_pu = ps_proc->as_left_mb_pu_ME;
             enc_pu_t *ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu_ME;
-            enc_pu_t *ps_top_mv = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x;
+            enc_pu_t *ps_top_mv = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB;
 
             *ps_top_left_syn = *ps_top_syn;
 
-            *ps_top_left_mb_pu = *ps_top_mv;
-            *ps_left_mb_pu = *ps_proc->ps_pu;
+            *ps_top_left_mb_pu = ps_top_mv[3];
+            memcpy(ps_left_mb_pu, ps_proc->ps_pu, ENC_NUM_PU_IN_MB * sizeof(enc_pu_t));
         }
 
-        ps_proc->ps_pu += *ps_proc->pu4_mb_pu_cnt;
+        ps_proc->ps_pu += ENC_NUM_PU_IN_MB;
 
         /* Copy the min sad reached info */
         ps_proc->ps_nmb_info[u4_i].u4_min_sad_reached = ps_proc->ps_cur_mb->u4_min_sad_reached;
@@ -1196,6 +2120,7 @@ void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count)
             DATA_SYNC();
 
             pu1_me_map[ps_proc->i4_mb_x] = 1;
+            ithread_progress_post(ps_proc->ps_codec->pv_me_map_progress);
         }
         ps_proc->i4_mb_x++;
 
@@ -1346,13 +2271,13 @@ WORD32 ih264e_find_bskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
      **************************************************************************/
     {
     /* Get the neighbouring MBS according to Section 8.4.1.2.2 */
-    ps_a_pu = &ps_proc->s_left_mb_pu_ME;
-    ps_b_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x);
+    ps_a_pu = &ps_proc->as_left_mb_pu_ME[1];
+    ps_b_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB + 2);
 
     i4_c_avail = 0;
     if (ps_ngbr_avbl->u1_mb_c)
     {
-        ps_c_pu = &((ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x)[1]);
+        ps_c_pu = (ps_proc->ps_top_row_pu_ME + (ps_proc->i4_mb_x + 1) * ENC_NUM_PU_IN_MB + 2);
         i4_c_avail = 1;
     }
     else
@@ -1499,17 +2424,21 @@ WORD32 ih264e_find_bskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
      *Find co-locates parameters
      *      See sec 8.4.1.2.1  for reference
      **************************************************************************/
+    for (i = 0; i < ENC_NUM_PU_IN_MB; i++)
     {
         /*
          * Find the co-located Mb and update the skip and pred appropriately
          * 1) Default colpic is forward ref : Table 8-6
          * 2) Default mb col is current MB : Table 8-8
+         * With direct_8x8_inference colZeroFlag is derived per 8x8 quadrant,
+         * the skip mv is common to the mb only when all quadrants agree
          */
 
         mv_t s_mvcol;
-        WORD32 i4_refidxcol;
+        WORD32 i4_refidxcol, i4_quad_colzeroflag;
+        enc_pu_t *ps_colpu = ps_proc->ps_colpu + i;
 
-        if (ps_proc->ps_colpu->b1_intra_flag)
+        if (ps_colpu->b1_intra_flag)
         {
             s_mvcol.i2_mvx = 0;
             s_mvcol.i2_mvy = 0;
@@ -1517,22 +2446,30 @@ WORD32 ih264e_find_bskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
         }
         else
         {
-            if (ps_proc->ps_colpu->b2_pred_mode != PRED_L1)
+            if (ps_colpu->b2_pred_mode != PRED_L1)
             {
-                s_mvcol = ps_proc->ps_colpu->s_me_info[PRED_L0].s_mv;
+                s_mvcol = ps_colpu->s_me_info[PRED_L0].s_mv;
                 i4_refidxcol = 0;
             }
-            else // if(ps_proc->ps_colpu->b2_pred_mode != PRED_L0)
+            else // if(ps_colpu->b2_pred_mode != PRED_L0)
             {
-                s_mvcol = ps_proc->ps_colpu->s_me_info[PRED_L1].s_mv;
+                s_mvcol = ps_colpu->s_me_info[PRED_L1].s_mv;
                 i4_refidxcol = 0;
             }
         }
 
         /* RefPicList1[ 0 ]  is marked as  "used for short-term reference", as default */
-        i4_colzeroflag = (!i4_refidxcol && (ABS(s_mvcol.i2_mvx) <= 1)
+        i4_quad_colzeroflag = (!i4_refidxcol && (ABS(s_mvcol.i2_mvx) <= 1)
                         && (ABS(s_mvcol.i2_mvy) <= 1));
 
+        if (i == 0)
+        {
+            i4_colzeroflag = i4_quad_colzeroflag;
+        }
+        else if (i4_quad_colzeroflag != i4_colzeroflag)
+        {
+            return 0;
+        }
     }
 
     /***************************************************************************
@@ -1540,16 +2477,16 @@ WORD32 ih264e_find_bskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
      **************************************************************************/
     /* Section 8.4.1.2.2 */
     ps_a_syn = &ps_proc->s_left_mb_syntax_ele;
-    ps_a_pu = &ps_proc->s_left_mb_pu;
+    ps_a_pu = &ps_proc->as_left_mb_pu[1];
 
     ps_b_syn = ps_proc->ps_top_row_mb_syntax_ele + ps_proc->i4_mb_x;
-    ps_b_pu = (ps_proc->ps_top_row_pu + ps_proc->i4_mb_x);
+    ps_b_pu = (ps_proc->ps_top_row_pu + ps_proc->i4_mb_x * ENC_NUM_PU_IN_MB + 2);
 
     i4_c_avail = 0;
     if (ps_ngbr_avbl->u1_mb_c)
     {
         ps_c_syn = &((ps_proc->ps_top_row_mb_syntax_ele + ps_proc->i4_mb_x)[1]);
-        ps_c_pu = &((ps_proc->ps_top_row_pu + ps_proc->i4_mb_x)[1]);
+        ps_c_pu = (ps_proc->ps_top_row_pu + (ps_proc->i4_mb_x + 1) * ENC_NUM_PU_IN_MB + 2);
         i4_c_avail = 1;
     }
     else
@@ -2118,6 +3055,9 @@ void ih264e_compute_me_multi_reflist(process_ctxt_t *ps_proc)
     ps_proc->ps_pu->b4_wd = 3;
     ps_proc->ps_pu->b4_ht = 3;
 
+    /* 16x16 mv is shared by all quadrants */
+    ps_proc->ps_pu[1] = ps_proc->ps_pu[2] = ps_proc->ps_pu[3] = ps_proc->ps_pu[0];
+
     /* Update min sad conditions */
     if (ps_me_ctxt->u4_min_sad_reached == 1)
     {
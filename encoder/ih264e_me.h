@@ -234,8 +234,11 @@ ih264e_skip_params_ft  ih264e_find_bskip_params_me;
  * @param[in] ps_left_mb_pu
  *  pointer to left mb motion vector info
  *
- * @param[in] ps_top_row_pu
- *  pointer to top & top right mb motion vector info
+ * @param[in] ps_top_pu
+ *  pointer to top mb motion vector info
+ *
+ * @param[in] ps_top_right_pu
+ *  pointer to top right mb motion vector info
  *
  * @param[out] ps_pred_mv
  *  pointer to candidate predictors for the current block
@@ -248,9 +251,59 @@ ih264e_skip_params_ft  ih264e_find_bskip_params_me;
  *
  *******************************************************************************
  */
-void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu, enc_pu_t *ps_top_row_pu,
+void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu, enc_pu_t *ps_top_pu,
+                             enc_pu_t *ps_top_right_pu,
                              enc_pu_mv_t *ps_pred_mv, WORD32 i4_ref_list);
 
+/**
+ *******************************************************************************
+ *
+ * @brief motion vector predictor of a mb partition
+ *
+ * @par Description:
+ *  The routine calculates the L0 motion vector predictor of a 16x8, 8x16 or
+ *  8x8 partition of a P mb from the neighbouring 8x8 quadrants.
+ *
+ * @param[in] ps_left_mb_pu
+ *  quadrants of left mb, NULL if not available
+ *
+ * @param[in] ps_top_mb_pu
+ *  quadrants of top mb, NULL if not available
+ *
+ * @param[in] ps_top_right_pu
+ *  bottom left quadrant of top right mb, NULL if not available
+ *
+ * @param[in] ps_top_left_pu
+ *  bottom right quadrant of top left mb, NULL if not available
+ *
+ * @param[in] ps_curr_mb_pu
+ *  quadrants of current mb, earlier partitions must be filled
+ *
+ * @param[in] u4_mb_type
+ *  P16x8, P8x16 or P8x8
+ *
+ * @param[in] i4_part_idx
+ *  partition index
+ *
+ * @param[out] ps_pred_mv
+ *  predicted motion vector
+ *
+ * @returns  none
+ *
+ * @remarks The code implements the logic as described in sec 8.4.1.3 in H264
+ *   specification.
+ *
+ *******************************************************************************
+ */
+void ih264e_get_mb_part_mv_predictor(enc_pu_t *ps_left_mb_pu,
+                                     enc_pu_t *ps_top_mb_pu,
+                                     enc_pu_t *ps_top_right_pu,
+                                     enc_pu_t *ps_top_left_pu,
+                                     enc_pu_t *ps_curr_mb_pu,
+                                     UWORD32 u4_mb_type,
+                                     WORD32 i4_part_idx,
+                                     mv_t *ps_pred_mv);
+
 /**
  *******************************************************************************
  *
@@ -329,6 +382,29 @@ void ih264e_init_me(process_ctxt_t *ps_proc);
  */
 void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count);
 
+/**
+ *******************************************************************************
+ *
+ * @brief This function evaluates P mb partitions for the current mb
+ *
+ * @par Description:
+ *  Searches the partition modes enabled in u4_mb_part_modes and replaces the
+ *  16x16 decision of the current mb if a partitioned mb is cheaper.
+ *
+ * @param[in] ps_proc
+ *  Process context corresponding to the job
+ *
+ * @param[in] i4_fpel_cost_16x16
+ *  full pel cost of the 16x16 partition
+ *
+ * @returns  none
+ *
+ * @remarks Single reference, L0 only
+ *
+ *******************************************************************************
+ */
+void ih264e_evaluate_mb_partitions(process_ctxt_t *ps_proc, WORD32 i4_fpel_cost_16x16);
+
 /**
  *******************************************************************************
  *
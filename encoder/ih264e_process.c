@@ -42,6 +42,7 @@
 * - ih264e_set_rc_pic_params()
 * - ih264e_update_rc_post_enc()
 * - ih264e_process_thread()
+* - ih264e_finish_entropy()
 *
 * @remarks
 *  None
@@ -65,6 +66,7 @@
 #include "ih264_typedefs.h"
 #include "iv2.h"
 #include "ive2.h"
+#include "ih264e.h"
 #include "ih264_defs.h"
 #include "ih264_debug.h"
 #include "ime_distortion_metrics.h"
@@ -112,6 +114,7 @@
 #include "irc_rate_control_api.h"
 #include "ih264e_platform_macros.h"
 #include "ime_statistics.h"
+#include "ih264e_stats.h"
 
 
 /*****************************************************************************/
@@ -308,6 +311,9 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
     /* entropy map */
     UWORD8  *pu1_entropy_map_curr;
 
+    /* proc map wait state */
+    ithread_wait_state_t s_wait = {0, 0};
+
     /* proc base idx */
     WORD32 ctxt_sel = ps_proc->i4_encode_api_call_cnt % MAX_CTXT_SETS;
 
@@ -315,6 +321,9 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
     WORD32 i4_wd_mbs, i4_ht_mbs;
     UWORD32 u4_mb_cnt, u4_mb_idx, u4_mb_end_idx;
     WORD32 bitstream_start_offset, bitstream_end_offset;
+
+    STATS_SWITCH(ps_proc, IH264E_STATS_ENTROPY);
+
     /********************************************************************/
     /*                            BEGIN INIT                            */
     /********************************************************************/
@@ -366,6 +375,10 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
         /********************************************************************/
         ih264e_bitstrm_init(ps_bitstrm, s_out_buf.s_bits_buf.pv_buf, s_out_buf.s_bits_buf.u4_bufsize);
 
+        /* cabac state is shared by the context sets, initialize it only once
+         * the previous picture is entropy coded */
+        ih264e_init_cabac_table(ps_entropy);
+
         /********************************************************************/
         /*                    BEGIN HEADER GENERATION                       */
         /********************************************************************/
@@ -432,6 +445,7 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
         /* The wait for curr mb to be core coded is essential when entropy is launched
          * as a separate job
          */
+        s_wait.i4_spin_cnt = 0;
         while (1)
         {
             volatile UWORD8 *pu1_buf1;
@@ -440,8 +454,11 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
             pu1_buf1 = pu1_proc_map + idx;
             if (*pu1_buf1)
                 break;
-            ithread_yield();
+            STATS_SWITCH(ps_proc, STATS_STAGE_WAIT);
+            if (!ithread_progress_spin(ps_codec->pv_proc_map_progress, &s_wait))
+                ithread_progress_wait(ps_codec->pv_proc_map_progress, &s_wait);
         }
+        STATS_SWITCH(ps_proc, IH264E_STATS_ENTROPY);
 
 
         /* write mb layer */
@@ -582,9 +599,11 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
             WORD32 i4_stuff_bytes;
 
             /* update */
+            STATS_SWITCH(ps_proc, IH264E_STATS_RC);
             i4_stuff_bytes = ih264e_update_rc_post_enc(
                             ps_codec, ctxt_sel,
-                            (ps_proc->ps_codec->i4_poc == 0));
+                            (ps_entropy->i4_abs_pic_order_cnt == 0));
+            STATS_SWITCH(ps_proc, IH264E_STATS_ENTROPY);
 
             /* cbr rc - house keeping */
             if (ps_codec->s_rate_control.post_encode_skip[ctxt_sel])
@@ -599,14 +618,13 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
         }
 
         /*
-         *Frame number is to be incremented only if the current frame is a
-         * reference frame. After each successful frame encode, we increment
-         * frame number by 1
+         * Frame number was incremented during pic init for a reference frame.
+         * A skipped frame does not make it to the stream, hence undo it
          */
-        if (!ps_codec->s_rate_control.post_encode_skip[ctxt_sel]
-                        && ps_codec->u4_is_curr_frm_ref)
+        if (ps_codec->s_rate_control.post_encode_skip[ctxt_sel]
+                        && ps_proc->u4_is_curr_frm_ref)
         {
-            ps_codec->i4_frame_num++;
+            ps_codec->i4_frame_num--;
         }
         /********************************************************************/
         /*      signal the output                                           */
@@ -614,11 +632,15 @@ IH264E_ERROR_T ih264e_entropy(process_ctxt_t *ps_proc)
         ps_codec->as_out_buf[ctxt_sel].s_bits_buf.u4_bytes =
                         ps_entropy->ps_bitstrm->u4_strm_buf_offset;
 
+        ps_codec->au4_entropy_done[ctxt_sel] = 1;
+
         DEBUG("entropy status %x", ps_entropy->i4_error_code);
     }
 
+    STATS_SWITCH(ps_proc, STATS_STAGE_IDLE);
+
     /* allow threads to dequeue entropy jobs */
-    ps_codec->au4_entropy_thread_active[ctxt_sel] = 0;
+    ps_codec->u4_entropy_thread_active = 0;
 
     return ps_entropy->i4_error_code;
 }
@@ -666,6 +688,9 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* mb qp delta */
         ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
 
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
         /* sub mb modes */
         for (i4 = 0; i4 < 16; i4 ++)
         {
@@ -718,6 +743,79 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         pu1_ptr += sizeof(mb_hdr_i4x4_t);
         ps_proc->pv_mb_header_data = pu1_ptr;
     }
+    else if (u4_mb_type == I8x8)
+    {
+        /* pointer to mb header storage space */
+        UWORD8 *pu1_ptr = ps_proc->pv_mb_header_data;
+        mb_hdr_i8x8_t *ps_mb_hdr = (mb_hdr_i8x8_t *)ps_proc->pv_mb_header_data;
+
+        /* temp var */
+        WORD32 i4, byte;
+
+        /* mb type plus mode */
+        ps_mb_hdr->common.u1_mb_type_mode = (ps_proc->u1_c_i8_mode << 6) + u4_mb_type;
+
+        /* cbp */
+        ps_mb_hdr->common.u1_cbp = ps_proc->u4_cbp;
+
+        /* mb qp delta */
+        ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
+
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = 1;
+
+        /* sub mb modes */
+        for (i4 = 0; i4 < 4; i4 ++)
+        {
+            byte = 0;
+
+            if (ps_proc->au1_predicted_intra_luma_mb_8x8_modes[i4] ==
+                            ps_proc->au1_intra_luma_mb_8x8_modes[i4])
+            {
+                byte |= 1;
+            }
+            else
+            {
+
+                if (ps_proc->au1_intra_luma_mb_8x8_modes[i4] <
+                                ps_proc->au1_predicted_intra_luma_mb_8x8_modes[i4])
+                {
+                    byte |= (ps_proc->au1_intra_luma_mb_8x8_modes[i4] << 1);
+                }
+                else
+                {
+                    byte |= (ps_proc->au1_intra_luma_mb_8x8_modes[i4] - 1) << 1;
+                }
+            }
+
+            i4++;
+
+            if (ps_proc->au1_predicted_intra_luma_mb_8x8_modes[i4] ==
+                            ps_proc->au1_intra_luma_mb_8x8_modes[i4])
+            {
+                byte |= 16;
+            }
+            else
+            {
+
+                if (ps_proc->au1_intra_luma_mb_8x8_modes[i4] <
+                                ps_proc->au1_predicted_intra_luma_mb_8x8_modes[i4])
+                {
+                    byte |= (ps_proc->au1_intra_luma_mb_8x8_modes[i4] << 5);
+                }
+                else
+                {
+                    byte |= (ps_proc->au1_intra_luma_mb_8x8_modes[i4] - 1) << 5;
+                }
+            }
+
+            ps_mb_hdr->au1_sub_blk_modes[i4 >> 1] =  byte;
+        }
+
+        /* end of mb layer */
+        pu1_ptr += sizeof(mb_hdr_i8x8_t);
+        ps_proc->pv_mb_header_data = pu1_ptr;
+    }
     else if (u4_mb_type == I16x16)
     {
         /* pointer to mb header storage space */
@@ -733,6 +831,9 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* mb qp delta */
         ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
 
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
         /* end of mb layer */
         pu1_ptr += sizeof(mb_hdr_i16x16_t);
         ps_proc->pv_mb_header_data = pu1_ptr;
@@ -752,6 +853,9 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* mb qp delta */
         ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
 
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
         ps_mb_hdr->ai2_mv[0] = ps_proc->ps_pu->s_me_info[0].s_mv.i2_mvx - ps_proc->ps_pred_mv[0].s_mv.i2_mvx;
 
         ps_mb_hdr->ai2_mv[1] = ps_proc->ps_pu->s_me_info[0].s_mv.i2_mvy - ps_proc->ps_pred_mv[0].s_mv.i2_mvy;
@@ -760,6 +864,68 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         pu1_ptr += sizeof(mb_hdr_p16x16_t);
         ps_proc->pv_mb_header_data = pu1_ptr;
     }
+    else if (u4_mb_type == P16x8 || u4_mb_type == P8x16)
+    {
+        /* pointer to mb header storage space */
+        UWORD8 *pu1_ptr = ps_proc->pv_mb_header_data;
+        mb_hdr_p16x8_t *ps_mb_hdr = (mb_hdr_p16x8_t *)ps_proc->pv_mb_header_data;
+
+        /* second partition starts at the bottom left (16x8) or top right (8x16) quadrant */
+        enc_pu_t *ps_part_pu = ps_proc->ps_pu + ((u4_mb_type == P16x8) ? 2 : 1);
+
+        /* mb type */
+        ps_mb_hdr->common.u1_mb_type_mode = u4_mb_type;
+
+        /* cbp */
+        ps_mb_hdr->common.u1_cbp = ps_proc->u4_cbp;
+
+        /* mb qp delta */
+        ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
+
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
+        ps_mb_hdr->ai2_mv[0][0] = ps_proc->ps_pu->s_me_info[0].s_mv.i2_mvx - ps_proc->as_part_pred_mv[0].i2_mvx;
+        ps_mb_hdr->ai2_mv[0][1] = ps_proc->ps_pu->s_me_info[0].s_mv.i2_mvy - ps_proc->as_part_pred_mv[0].i2_mvy;
+
+        ps_mb_hdr->ai2_mv[1][0] = ps_part_pu->s_me_info[0].s_mv.i2_mvx - ps_proc->as_part_pred_mv[1].i2_mvx;
+        ps_mb_hdr->ai2_mv[1][1] = ps_part_pu->s_me_info[0].s_mv.i2_mvy - ps_proc->as_part_pred_mv[1].i2_mvy;
+
+        /* end of mb layer */
+        pu1_ptr += sizeof(mb_hdr_p16x8_t);
+        ps_proc->pv_mb_header_data = pu1_ptr;
+    }
+    else if (u4_mb_type == P8x8)
+    {
+        /* pointer to mb header storage space */
+        UWORD8 *pu1_ptr = ps_proc->pv_mb_header_data;
+        mb_hdr_p8x8_t *ps_mb_hdr = (mb_hdr_p8x8_t *)ps_proc->pv_mb_header_data;
+
+        /* temp var */
+        WORD32 i;
+
+        /* mb type */
+        ps_mb_hdr->common.u1_mb_type_mode = u4_mb_type;
+
+        /* cbp */
+        ps_mb_hdr->common.u1_cbp = ps_proc->u4_cbp;
+
+        /* mb qp delta */
+        ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
+
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
+        for (i = 0; i < 4; i++)
+        {
+            ps_mb_hdr->ai2_mv[i][0] = ps_proc->ps_pu[i].s_me_info[0].s_mv.i2_mvx - ps_proc->as_part_pred_mv[i].i2_mvx;
+            ps_mb_hdr->ai2_mv[i][1] = ps_proc->ps_pu[i].s_me_info[0].s_mv.i2_mvy - ps_proc->as_part_pred_mv[i].i2_mvy;
+        }
+
+        /* end of mb layer */
+        pu1_ptr += sizeof(mb_hdr_p8x8_t);
+        ps_proc->pv_mb_header_data = pu1_ptr;
+    }
     else if (u4_mb_type == PSKIP)
     {
         /* pointer to mb header storage space */
@@ -791,6 +957,9 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* mb qp delta */
         ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
 
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
         /* l0 & l1 me data */
         if (u4_pred_mode != PRED_L1)
         {
@@ -829,6 +998,9 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* mb qp delta */
         ps_mb_hdr->common.u1_mb_qp_delta = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
 
+        /* transform size */
+        ps_mb_hdr->common.u1_transform_8x8_flag = ps_proc->u4_transform_8x8;
+
         /* end of mb layer */
         pu1_ptr += sizeof(mb_hdr_bdirect_t);
         ps_proc->pv_mb_header_data = pu1_ptr;
@@ -919,13 +1091,13 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
     bs_ctxt_t *ps_bs = &(ps_deblk->s_bs_ctxt);
 
     /* top row motion vector info */
-    enc_pu_t *ps_top_row_pu = ps_proc->ps_top_row_pu + i4_mb_x;
+    enc_pu_t *ps_top_row_pu = ps_proc->ps_top_row_pu + i4_mb_x * ENC_NUM_PU_IN_MB;
 
     /* top left mb motion vector */
     enc_pu_t *ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu;
 
     /* left mb motion vector */
-    enc_pu_t *ps_left_mb_pu = &ps_proc->s_left_mb_pu;
+    enc_pu_t *ps_left_mb_pu = ps_proc->as_left_mb_pu;
 
     /* sub mb modes */
     UWORD8 *pu1_top_mb_intra_modes = ps_proc->pu1_top_mb_intra_modes + (i4_mb_x << 4);
@@ -946,7 +1118,7 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
         /* update top left with top info results */
         /*****************************************/
         /* mv */
-        *ps_top_left_mb_pu = *ps_top_row_pu;
+        *ps_top_left_mb_pu = ps_top_row_pu[3];
     }
 
     /*************************************************/
@@ -986,7 +1158,8 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
         if ((ps_proc->i4_slice_type == PSLICE) ||(ps_proc->i4_slice_type == BSLICE))
         {
             /* mv */
-            *ps_left_mb_pu = *ps_top_row_pu = *(ps_proc->ps_pu);
+            memcpy(ps_left_mb_pu, ps_proc->ps_pu, ENC_NUM_PU_IN_MB * sizeof(enc_pu_t));
+            memcpy(ps_top_row_pu, ps_proc->ps_pu, ENC_NUM_PU_IN_MB * sizeof(enc_pu_t));
         }
 
         *ps_proc->pu4_mb_pu_cnt = 1;
@@ -994,7 +1167,8 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
     else
     {
         /* mv */
-        *ps_left_mb_pu = *ps_top_row_pu = *(ps_proc->ps_pu);
+        memcpy(ps_left_mb_pu, ps_proc->ps_pu, ENC_NUM_PU_IN_MB * sizeof(enc_pu_t));
+        memcpy(ps_top_row_pu, ps_proc->ps_pu, ENC_NUM_PU_IN_MB * sizeof(enc_pu_t));
     }
 
     /*
@@ -1045,7 +1219,7 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
         s_job.i2_mb_y = ps_proc->i4_mb_y;
 
         /* proc base idx */
-        s_job.i2_proc_base_idx = (ps_codec->i4_encode_api_call_cnt % MAX_CTXT_SETS) ? (MAX_PROCESS_CTXT / 2) : 0;
+        s_job.i2_proc_base_idx = (ps_proc->i4_encode_api_call_cnt % MAX_CTXT_SETS) ? (MAX_PROCESS_CTXT / 2) : 0;
 
         /* queue the job */
         error_status |= ih264_list_queue(ps_proc->pv_entropy_jobq, &s_job, 1);
@@ -1056,6 +1230,7 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
 
     /* update proc map */
     pu1_proc_map[i4_mb_x] = 1;
+    ithread_progress_post(ps_codec->pv_proc_map_progress);
 
     /**************************************************/
     /* update proc ctxt elements for encoding next mb */
@@ -1094,13 +1269,13 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
     ps_proc->i4_mb_cost = INT_MAX;
     ps_proc->i4_mb_distortion = SHRT_MAX;
 
-    ps_proc->ps_pu += *ps_proc->pu4_mb_pu_cnt;
+    ps_proc->ps_pu += ENC_NUM_PU_IN_MB;
 
     ps_proc->pu4_mb_pu_cnt += 1;
 
     /* Update colocated pu */
     if (ps_proc->i4_slice_type == BSLICE)
-        ps_proc->ps_colpu += *(ps_proc->aps_mv_buf[1]->pu4_mb_pu_cnt +  (i4_mb_y * ps_proc->i4_wd_mbs) + i4_mb_x);
+        ps_proc->ps_colpu += ENC_NUM_PU_IN_MB;
 
     /* deblk ctxts */
     if (ps_proc->u4_disable_deblock_level != 1)
@@ -1380,11 +1555,11 @@ IH264E_ERROR_T ih264e_init_proc_ctxt(process_ctxt_t *ps_proc)
 
     /* init mv buffer ptr */
     ps_proc->ps_pu = ps_cur_mv_buf->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs *
-                     ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+                     ENC_NUM_PU_IN_MB);
 
     /* Init co-located mv buffer */
     ps_proc->ps_colpu = ps_proc->aps_mv_buf[1]->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs *
-                        ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+                        ENC_NUM_PU_IN_MB);
 
     if (i4_mb_y == 0)
     {
@@ -1393,7 +1568,7 @@ IH264E_ERROR_T ih264e_init_proc_ctxt(process_ctxt_t *ps_proc)
     else
     {
         ps_proc->ps_top_row_pu_ME = ps_cur_mv_buf->ps_pic_pu + ((i4_mb_y - 1) * ps_proc->i4_wd_mbs *
-                                    ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+                                    ENC_NUM_PU_IN_MB);
     }
 
     ps_proc->pu4_mb_pu_cnt = ps_cur_mv_buf->pu4_mb_pu_cnt + (i4_mb_y * ps_proc->i4_wd_mbs);
@@ -1921,9 +2096,16 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
     /* is intra */
     WORD32 luma_idx, chroma_idx, is_intra;
 
+    /* statistics stage mb analysis starts in */
+    WORD32 i4_analysis_stage;
+
     /* temp variables */
     WORD32 ctxt_sel = ps_proc->i4_encode_api_call_cnt % MAX_CTXT_SETS;
 
+    /* intra 8x8 mbs need the 8x8 transform to be enabled in the pps */
+    UWORD32 u4_enable_intra_8x8 = ps_codec->s_cfg.u4_enable_intra_8x8 &&
+                                  ps_proc->i1_transform_8x8_mode_flag;
+
     /*
      * list of modes for evaluation
      * -------------------------------------------------------------------------
@@ -1941,7 +2123,7 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
             u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_16x16 ? (1 << I16x16) : 0;
 
             /* enable intra 8x8 */
-            u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_8x8 ? (1 << I8x8) : 0;
+            u4_valid_modes |= u4_enable_intra_8x8 ? (1 << I8x8) : 0;
         }
 
         /* enable intra 4x4 */
@@ -1957,10 +2139,11 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
             u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_16x16 ? (1 << I16x16) : 0;
         }
 
-        /* enable intra 4x4 */
+        /* enable intra 4x4 and intra 8x8 */
         if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_SLOWEST)
         {
             u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_4x4 ? (1 << I4x4) : 0;
+            u4_valid_modes |= (u4_enable_intra_8x8 && ps_proc->u4_frame_qp > 10) ? (1 << I8x8) : 0;
         }
         u4_valid_modes |= (ps_proc->u4_frame_qp <= 10) << I4x4;
 
@@ -1975,10 +2158,11 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
             u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_16x16 ? (1 << I16x16) : 0;
         }
 
-        /* enable intra 4x4 */
+        /* enable intra 4x4 and intra 8x8 */
         if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_SLOWEST)
         {
             u4_valid_modes |= ps_codec->s_cfg.u4_enable_intra_4x4 ? (1 << I4x4) : 0;
+            u4_valid_modes |= (u4_enable_intra_8x8 && ps_proc->u4_frame_qp > 10) ? (1 << I8x8) : 0;
         }
         u4_valid_modes |= (ps_proc->u4_frame_qp <= 10) << I4x4;
 
@@ -1986,6 +2170,9 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
         u4_valid_modes |= (1 << B16x16);
     }
 
+    /* inter slices start mb analysis with motion estimation */
+    i4_analysis_stage = (u4_valid_modes & ((1 << P16x16) | (1 << B16x16))) ?
+                    IH264E_STATS_ME : IH264E_STATS_INTRA_EVAL;
 
     /* init entropy */
     ps_proc->s_entropy.i4_mb_x = ps_proc->i4_mb_x;
@@ -2009,6 +2196,11 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
         ps_proc->u4_min_sad = ps_codec->s_cfg.i4_min_sad;
         ps_proc->u4_min_sad_reached = 0;
 
+        /* luma transform size is decided during core coding */
+        ps_proc->u4_transform_8x8 = 0;
+
+        STATS_SWITCH(ps_proc, i4_analysis_stage);
+
         /* mb analysis */
         {
             /* temp var */
@@ -2082,6 +2274,8 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
                 /* proc map */
                 UWORD8  *pu1_proc_map_top;
 
+                ithread_wait_state_t s_wait = {0, 0};
+
                 pu1_proc_map_top = ps_proc->pu1_proc_map + ((ps_proc->i4_mb_y - 1) * i4_wd_mbs);
 
                 while (1)
@@ -2093,10 +2287,14 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
                     pu1_buf =  pu1_proc_map_top + idx;
                     if(*pu1_buf)
                         break;
-                    ithread_yield();
+                    STATS_SWITCH(ps_proc, STATS_STAGE_WAIT);
+                    if(!ithread_progress_spin(ps_codec->pv_proc_map_progress, &s_wait))
+                        ithread_progress_wait(ps_codec->pv_proc_map_progress, &s_wait);
                 }
             }
 
+            STATS_SWITCH(ps_proc, IH264E_STATS_INTRA_EVAL);
+
             /* If we already have the minimum sad, there is no point in searching for sad again */
             if (ps_proc->u4_min_sad_reached == 0 || ps_codec->s_cfg.u4_enc_speed_preset != IVE_FASTEST)
             {
@@ -2168,8 +2366,17 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
             chroma_idx = 1;
             is_intra = 0;
         }
+
+        STATS_SWITCH(ps_proc, IH264E_STATS_CORE_CODING);
+
         ps_proc->u4_is_intra = is_intra;
-        ps_proc->ps_pu->b1_intra_flag = is_intra;
+        ps_proc->ps_pu[0].b1_intra_flag = is_intra;
+        ps_proc->ps_pu[1].b1_intra_flag = is_intra;
+        ps_proc->ps_pu[2].b1_intra_flag = is_intra;
+        ps_proc->ps_pu[3].b1_intra_flag = is_intra;
+
+        /* number of inter partitions to be motion compensated */
+        ps_proc->u4_num_sub_partitions = is_intra ? 1 : *ps_proc->pu4_mb_pu_cnt;
 
         /* redo MV pred of neighbors in the case intra mb */
         /* TODO : currently called unconditionally, needs to be called only in the case of intra
@@ -2179,9 +2386,19 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
             ih264e_mv_pred(ps_proc, ps_proc->i4_slice_type);
         }
 
+        /* intra 8x8 mbs always use the 8x8 transform */
+        ps_proc->u4_transform_8x8 = (ps_proc->u4_mb_type == I8x8);
+
         /* Perform luma mb core coding */
         u4_cbp_l = (ps_codec->luma_energy_compaction)[luma_idx](ps_proc);
 
+        /* transform_size_8x8_flag is not signalled for inter mbs with no
+         * luma residue */
+        if (ps_proc->u4_mb_type != I8x8 && (u4_cbp_l & 0xF) == 0)
+        {
+            ps_proc->u4_transform_8x8 = 0;
+        }
+
         /* Perform luma mb core coding */
         u4_cbp_c = (ps_codec->chroma_energy_compaction)[chroma_idx](ps_proc);
 
@@ -2197,7 +2414,7 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
                     ps_proc->u4_mb_type = (ps_proc->u4_cbp) ? BDIRECT : BSKIP;
                 }
             }
-            else if(!ps_proc->u4_cbp)
+            else if(!ps_proc->u4_cbp && ps_proc->u4_mb_type == P16x16)
             {
                 if (ih264e_find_pskip_params(ps_proc, PRED_L0))
                 {
@@ -2208,9 +2425,14 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
 
 UPDATE_MB_INFO:
 
+        STATS_SWITCH(ps_proc, IH264E_STATS_RC);
+
         /* Update mb sad, mb qp and intra mb cost. Will be used by rate control */
         ih264e_update_rc_mb_info(&ps_proc->s_frame_info, ps_proc);
 
+        ps_proc->s_stats.u4_num_skip_mbs += (ps_proc->u4_mb_type == PSKIP) ||
+                                            (ps_proc->u4_mb_type == BSKIP);
+
         /**********************************************************************/
         /* if disable deblock level is '0' this implies enable deblocking for */
         /* all edges of all macroblocks with out any restrictions             */
@@ -2236,6 +2458,8 @@ UPDATE_MB_INFO:
             UWORD32 i4_mb_x = ps_proc->i4_mb_x;
             UWORD32 i4_mb_y = ps_proc->i4_mb_y;
 
+            STATS_SWITCH(ps_proc, IH264E_STATS_DBLK_PAD_HPEL);
+
             /* compute blocking strength */
             if (ps_proc->u4_disable_deblock_level != 1)
             {
@@ -2296,6 +2520,8 @@ UPDATE_MB_INFO:
         }
     }
 
+    STATS_SWITCH(ps_proc, STATS_STAGE_IDLE);
+
     DEBUG_HISTOGRAM_DUMP(ps_codec->s_cfg.i4_ht_mbs == ps_proc->i4_mb_y);
 
     return error_status;
@@ -2338,7 +2564,7 @@ WORD32 ih264e_update_rc_post_enc(codec_t *ps_codec, WORD32 ctxt_sel, WORD32 i4_i
     process_ctxt_t *ps_proc = &ps_codec->as_process[i4_proc_ctxt_sel_base];
 
     /* frame qp */
-    UWORD8 u1_frame_qp = ps_codec->u4_frame_qp;
+    UWORD8 u1_frame_qp = ps_proc->u4_frame_qp;
 
     /* cbr rc return status */
     WORD32 i4_stuffing_byte = 0;
@@ -2384,17 +2610,17 @@ WORD32 ih264e_update_rc_post_enc(codec_t *ps_codec, WORD32 ctxt_sel, WORD32 i4_i
         ih264e_update_rc_bits_info(&s_frame_info, &ps_proc[i].s_entropy);
     }
 
-    /* get pic type */
-    switch (ps_codec->pic_type)
+    /* get pic type, from the context set as the codec may have moved on to
+     * the next picture */
+    switch (ps_proc->i4_slice_type)
     {
-        case PIC_I:
-        case PIC_IDR:
+        case ISLICE:
             rc_pic_type = I_PIC;
             break;
-        case PIC_P:
+        case PSLICE:
             rc_pic_type = P_PIC;
             break;
-        case PIC_B:
+        case BSLICE:
             rc_pic_type = B_PIC;
             break;
         default:
@@ -2402,6 +2628,19 @@ WORD32 ih264e_update_rc_post_enc(codec_t *ps_codec, WORD32 ctxt_sel, WORD32 i4_i
             break;
     }
 
+    /* record the frame stats, these are returned to the app for two pass */
+    {
+        rc_frm_stats_t *ps_frm_stats = &ps_codec->s_rate_control.as_frm_stats[ctxt_sel];
+
+        ps_frm_stats->i4_pic_type = rc_pic_type;
+        ps_frm_stats->i4_frame_sad = irc_fi_get_total_frame_sad(&s_frame_info);
+        ps_frm_stats->i4_header_bits = irc_fi_get_total_header_bits(&s_frame_info);
+        ps_frm_stats->i4_total_bits = ps_frm_stats->i4_header_bits
+                        + irc_fi_get_total_texture_bits(&s_frame_info);
+        ps_frm_stats->i4_avg_qp = irc_fi_get_average_qp(&s_frame_info);
+    }
+    ps_codec->s_rate_control.i4_num_frms_coded++;
+
     /* update rc lib with current frame stats */
     i4_stuffing_byte =  ih264e_rc_post_enc(ps_codec->s_rate_control.pps_rate_control_api,
                                           &(s_frame_info),
@@ -2457,7 +2696,7 @@ WORD32 ih264e_process_thread(void *pv_proc)
     WORD32 is_blocking = 0;
 
     /* set affinity */
-    ithread_set_affinity(ps_proc->i4_id);
+    ih264e_set_thread_affinity(ps_codec, ps_proc->i4_id);
 
     while(1)
     {
@@ -2465,10 +2704,7 @@ WORD32 ih264e_process_thread(void *pv_proc)
         {
             int error = ithread_mutex_lock(ps_codec->pv_entropy_mutex);
 
-            /* codec context selector */
-            WORD32 ctxt_sel = ps_codec->i4_encode_api_call_cnt % MAX_CTXT_SETS;
-
-            volatile UWORD32 *pu4_buf = &ps_codec->au4_entropy_thread_active[ctxt_sel];
+            volatile UWORD32 *pu4_buf = &ps_codec->u4_entropy_thread_active;
 
             /* have the lock */
             if (error == 0)
@@ -2497,7 +2733,9 @@ WORD32 ih264e_process_thread(void *pv_proc)
         ret = ih264_list_dequeue(ps_proc->pv_proc_jobq, &s_job, 1);
         if (IH264_SUCCESS != ret)
         {
-            if(ps_proc->i4_id)
+            /* with frame pipelining the remaining entropy jobs are left for
+             * the next encode call */
+            if(ps_proc->i4_id || ps_codec->i4_frame_pipelining)
                 break;
             else
             {
@@ -2546,3 +2784,68 @@ WORKER:
     ps_proc->i4_error_code = error_status;
     return ret;
 }
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Completes the entropy coding of the picture of a context set
+*
+* @par Description:
+*  With frame pipelining, the entropy jobs of a picture that are not picked
+*  by the encoder threads are left in the entropy queue. This function codes
+*  them on the calling thread. Jobs are dequeued in order, so the rows of any
+*  earlier picture still in the queue are coded first. It must be called only
+*  when no other encoder thread is alive
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ctxt_sel
+*  Context set of the picture
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+IH264E_ERROR_T ih264e_finish_entropy(codec_t *ps_codec, WORD32 ctxt_sel)
+{
+    /* error status */
+    IH264E_ERROR_T error_status = IH264E_SUCCESS;
+
+    /* structure to represent a processing job entry */
+    job_t s_job;
+
+    while (!ps_codec->au4_entropy_done[ctxt_sel])
+    {
+        /* proc ctxt */
+        process_ctxt_t *ps_proc;
+
+        /* all the proc jobs are done, so the entropy jobs are already queued */
+        if (IH264_SUCCESS != ih264_list_dequeue(ps_codec->pv_entropy_jobq, &s_job, 0))
+        {
+            error_status |= IH264E_FAIL;
+            break;
+        }
+
+        /* choose appropriate proc context based on proc_base_idx */
+        ps_proc = &ps_codec->as_process[s_job.i2_proc_base_idx];
+
+        ps_proc->s_entropy.i4_mb_x = s_job.i2_mb_x;
+        ps_proc->s_entropy.i4_mb_y = s_job.i2_mb_y;
+        ps_proc->s_entropy.i4_mb_cnt = s_job.i2_mb_cnt;
+
+        /* released by ih264e_entropy() */
+        ps_codec->u4_entropy_thread_active = 1;
+
+        /* init entropy */
+        ih264e_init_entropy_ctxt(ps_proc);
+
+        /* entropy code all mbs enlisted under the current job */
+        error_status |= ih264e_entropy(ps_proc);
+    }
+
+    return error_status;
+}
@@ -331,4 +331,31 @@ WORD32 ih264e_update_rc_post_enc(codec_t *ps_codec, WORD32 ctxt_sel, WORD32 pic_
 */
 WORD32 ih264e_process_thread(void *pv_proc);
 
+/**
+*******************************************************************************
+*
+* @brief
+*  Completes the entropy coding of the picture of a context set
+*
+* @par Description:
+*  With frame pipelining, the entropy jobs of a picture that are not picked
+*  by the encoder threads are left in the entropy queue. This function codes
+*  them on the calling thread. Jobs are dequeued in order, so the rows of any
+*  earlier picture still in the queue are coded first. It must be called only
+*  when no other encoder thread is alive
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ctxt_sel
+*  Context set of the picture
+*
+* @returns  error status
+*
+* @remarks
+*
+*******************************************************************************
+*/
+IH264E_ERROR_T ih264e_finish_entropy(codec_t *ps_codec, WORD32 ctxt_sel);
+
 #endif /* IH264E_PROCESS_H_ */
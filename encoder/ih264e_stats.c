@@ -0,0 +1,284 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_stats.c
+*
+* @brief
+*  Contains functions collecting per frame encode statistics. Each thread
+*  charges the time since its last stage switch to the stage it leaves, in
+*  the process context it codes the picture with. A context is used by one
+*  thread at a time, hence no locking is needed. The contexts of a picture
+*  are summed up once the picture is returned
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264e_stats_switch_stage()
+*  - ih264e_stats_frame_done()
+*  - ih264e_set_stats()
+*  - ih264e_get_stats()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System Include files */
+#include <stdio.h>
+#include <string.h>
+
+/* User Include files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264e.h"
+#include "ithread.h"
+#include "ih264_defs.h"
+#include "ih264_debug.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_buf_mgr.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_master.h"
+#include "ih264e_utils.h"
+#include "ih264e_stats.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Charges the time since the last switch to the current stage of a thread
+*  and moves the thread to a new stage
+*
+* @param[in] ps_proc
+*  Process context the thread codes the picture with
+*
+* @param[in] i4_stage
+*  New stage, IH264E_STATS_STAGE_T, STATS_STAGE_WAIT or STATS_STAGE_IDLE
+*
+* @returns  Stage the thread was in
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_stats_switch_stage(process_ctxt_t *ps_proc, WORD32 i4_stage)
+{
+    proc_stats_t *ps_stats = &ps_proc->s_stats;
+    WORD32 i4_prev_stage = ps_stats->i4_stage;
+    UWORD64 u8_now;
+
+    if (i4_stage == i4_prev_stage)
+        return i4_prev_stage;
+
+    u8_now = ithread_get_time_ns();
+    if (STATS_STAGE_IDLE != i4_prev_stage)
+    {
+        ps_stats->au8_stage_ns[i4_prev_stage] += u8_now - ps_stats->u8_stage_start_ns;
+    }
+    ps_stats->i4_stage = i4_stage;
+    ps_stats->u8_stage_start_ns = u8_now;
+
+    return i4_prev_stage;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Records the statistics of a picture being returned by an encode call
+*
+* @par Description:
+*  Called by the encode call once all the threads are done with the picture
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ctxt_sel
+*  Context set of the picture
+*
+* @param[in] u4_frame_type
+*  Frame type returned for the picture
+*
+* @returns  none
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void ih264e_stats_frame_done(codec_t *ps_codec, WORD32 ctxt_sel, UWORD32 u4_frame_type)
+{
+    enc_stats_t *ps_stats = &ps_codec->s_stats;
+    process_ctxt_t *ps_proc = &ps_codec->as_process[ctxt_sel * MAX_PROCESS_THREADS];
+    WORD32 i, j;
+
+    ps_stats->u4_frame_type = u4_frame_type;
+    ps_stats->u4_frame_sad = ps_codec->s_rate_control.as_frm_stats[ctxt_sel].i4_frame_sad;
+    ps_stats->u4_frame_bits = ps_codec->as_out_buf[ctxt_sel].s_bits_buf.u4_bytes << 3;
+    ps_stats->u4_frame_qp = ps_proc->u4_frame_qp;
+    ps_stats->u4_frame_num_mbs = ps_proc->i4_wd_mbs * ps_proc->i4_ht_mbs;
+    ps_stats->u4_frame_num_skip_mbs = 0;
+    memset(ps_stats->au8_frame_stage_ns, 0, sizeof(ps_stats->au8_frame_stage_ns));
+
+    /* contexts not used for the picture were reset by pic init */
+    for (i = 0; i < MAX_PROCESS_THREADS; i++)
+    {
+        ps_stats->u4_frame_num_skip_mbs += ps_proc[i].s_stats.u4_num_skip_mbs;
+
+        for (j = 0; j < STATS_NUM_STAGES; j++)
+        {
+            ps_stats->au8_frame_stage_ns[j] += ps_proc[i].s_stats.au8_stage_ns[j];
+        }
+    }
+
+    ps_stats->u4_num_frames++;
+    ps_stats->u8_num_bits += ps_stats->u4_frame_bits;
+    for (j = 0; j < STATS_NUM_STAGES; j++)
+    {
+        ps_stats->au8_stage_ns[j] += ps_stats->au8_frame_stage_ns[j];
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Enables, disables or resets statistics (IH264E_CMD_CTL_SET_STATS)
+*
+* @par Description:
+*  Served right away. A picture being coded as statistics are enabled is
+*  partially timed
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  IV_SUCCESS
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_set_stats(codec_t *ps_codec, void *pv_api_ip, void *pv_api_op)
+{
+    ih264e_ctl_set_stats_ip_t *ps_ip = pv_api_ip;
+    ih264e_ctl_set_stats_op_t *ps_op = pv_api_op;
+    enc_stats_t *ps_stats = &ps_codec->s_stats;
+
+    if (ps_ip->u4_reset_stats)
+    {
+        memset(ps_stats, 0, sizeof(enc_stats_t));
+    }
+    ps_stats->u4_enable = (0 != ps_ip->u4_enable_stats);
+
+    ps_op->u4_error_code = IV_SUCCESS;
+    return IV_SUCCESS;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns the statistics collected (IH264E_CMD_CTL_GET_STATS)
+*
+* @par Description:
+*  The frame statistics are those of the last frame returned by an encode
+*  call, hence are to be read after each encode call for per frame values
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  IV_SUCCESS
+*
+* @remarks
+*
+*******************************************************************************
+*/
+WORD32 ih264e_get_stats(codec_t *ps_codec, void *pv_api_ip, void *pv_api_op)
+{
+    ih264e_ctl_get_stats_op_t *ps_op = pv_api_op;
+    enc_stats_t *ps_stats = &ps_codec->s_stats;
+    WORD32 i;
+    UNUSED(pv_api_ip);
+
+    ps_op->u4_frame_type = ps_stats->u4_frame_type;
+    ps_op->u4_frame_sad = ps_stats->u4_frame_sad;
+    ps_op->u4_frame_bits = ps_stats->u4_frame_bits;
+    ps_op->u4_frame_qp = ps_stats->u4_frame_qp;
+    ps_op->u4_frame_num_mbs = ps_stats->u4_frame_num_mbs;
+    ps_op->u4_frame_num_skip_mbs = ps_stats->u4_frame_num_skip_mbs;
+    ps_op->u4_num_frames = ps_stats->u4_num_frames;
+    ps_op->u8_num_bits = ps_stats->u8_num_bits;
+
+    for (i = 0; i < IH264E_STATS_NUM_STAGES; i++)
+    {
+        ps_op->au8_frame_stage_ns[i] = ps_stats->au8_frame_stage_ns[i];
+        ps_op->au8_stage_ns[i] = ps_stats->au8_stage_ns[i];
+    }
+    ps_op->u8_frame_wait_ns = ps_stats->au8_frame_stage_ns[STATS_STAGE_WAIT];
+    ps_op->u8_wait_ns = ps_stats->au8_stage_ns[STATS_STAGE_WAIT];
+
+    ps_op->u4_error_code = IV_SUCCESS;
+    return IV_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_stats.h
+*
+* @brief
+*  This file contains declarations of functions collecting per frame encode
+*  statistics (IH264E_CMD_CTL_GET_STATS)
+*
+* @author
+*  ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef IH264E_STATS_H_
+#define IH264E_STATS_H_
+
+/*****************************************************************************/
+/* Function Macros                                                           */
+/*****************************************************************************/
+
+/**
+ * Moves the thread using a process context to a new stage, when statistics
+ * are enabled. Evaluates to the stage the thread was in
+ */
+#define STATS_SWITCH(ps_proc, stage)                                          \
+    ((ps_proc)->ps_codec->s_stats.u4_enable ?                                 \
+        ih264e_stats_switch_stage((ps_proc), (stage)) :                       \
+        STATS_STAGE_IDLE)
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Charges the time since the last switch to the current stage of a thread
+*  and moves the thread to a new stage
+*
+* @param[in] ps_proc
+*  Process context the thread codes the picture with
+*
+* @param[in] i4_stage
+*  New stage
+*
+* @returns  Stage the thread was in
+*
+*******************************************************************************
+*/
+WORD32 ih264e_stats_switch_stage(process_ctxt_t *ps_proc, WORD32 i4_stage);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Records the statistics of a picture being returned by an encode call
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ctxt_sel
+*  Context set of the picture
+*
+* @param[in] u4_frame_type
+*  Frame type returned for the picture
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+void ih264e_stats_frame_done(codec_t *ps_codec, WORD32 ctxt_sel, UWORD32 u4_frame_type);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Enables, disables or resets statistics (IH264E_CMD_CTL_SET_STATS)
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  IV_SUCCESS
+*
+*******************************************************************************
+*/
+WORD32 ih264e_set_stats(codec_t *ps_codec, void *pv_api_ip, void *pv_api_op);
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns the statistics collected (IH264E_CMD_CTL_GET_STATS)
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] pv_api_ip
+*  Pointer to input argument structure
+*
+* @param[out] pv_api_op
+*  Pointer to output argument structure
+*
+* @returns  IV_SUCCESS
+*
+*******************************************************************************
+*/
+WORD32 ih264e_get_stats(codec_t *ps_codec, void *pv_api_ip, void *pv_api_op);
+
+#endif /* IH264E_STATS_H_ */
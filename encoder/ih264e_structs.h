@@ -375,6 +375,21 @@ typedef struct
     /** Rate control mode                                                   */
     IVE_RC_MODE_T                               e_rc_mode;
 
+    /** Keep processing threads alive across encode calls                  */
+    UWORD32                                     u4_keep_threads_active;
+
+    /** Number of pictures analysed ahead of the current one, 0 disables    */
+    UWORD32                                     u4_lookahead;
+
+    /** First pass rate control stats for two pass, owned by the app        */
+    void                                        *pv_rc_stats;
+
+    /** Size of pv_rc_stats in bytes                                        */
+    UWORD32                                     u4_rc_stats_size;
+
+    /** Overlap entropy coding of a picture with analysis of the next one   */
+    UWORD32                                     u4_frame_pipelining;
+
     /** Maximum frame rate to be supported                                  */
     UWORD32                                     u4_max_framerate;
 
@@ -1174,9 +1189,9 @@ typedef struct
     UWORD8 u1_mb_qp_delta;
 
     /**
-     * Element to align structure to 2 byte boundary
+     * transform_size_8x8_flag, also aligns structure to 2 byte boundary
      */
-    UWORD8 u1_pad;
+    UWORD8 u1_transform_8x8_flag;
 }mb_hdr_common_t;
 
 /**
@@ -1248,6 +1263,42 @@ typedef struct
     WORD16 ai2_mv[2];
 }mb_hdr_p16x16_t;
 
+/**
+******************************************************************************
+*  @brief      macro block info for P16x8 and P8x16 MB
+******************************************************************************
+*/
+typedef struct
+{
+    /**
+     * Common MB header params
+     */
+    mb_hdr_common_t common;
+
+    /**
+     * MV of each partition
+     */
+    WORD16 ai2_mv[2][2];
+}mb_hdr_p16x8_t;
+
+/**
+******************************************************************************
+*  @brief      macro block info for P8x8 MB (sub mb type is always P_L0_8x8)
+******************************************************************************
+*/
+typedef struct
+{
+    /**
+     * Common MB header params
+     */
+    mb_hdr_common_t common;
+
+    /**
+     * MV of each sub mb
+     */
+    WORD16 ai2_mv[4][2];
+}mb_hdr_p8x8_t;
+
 /**
 ******************************************************************************
 *  @brief      macro block info for PSKIP MB
@@ -1322,6 +1373,8 @@ typedef union
     mb_hdr_i8x8_t       mb_hdr_i8x8;
     mb_hdr_i16x16_t     mb_hdr_i16x16;
     mb_hdr_p16x16_t     mb_hdr_p16x16;
+    mb_hdr_p16x8_t      mb_hdr_p16x8;
+    mb_hdr_p8x8_t       mb_hdr_p8x8;
     mb_hdr_pskip_t      mb_hdr_pskip;
     mb_hdr_b16x16_t     mb_hdr_b16x16;
     mb_hdr_bdirect_t    mb_hdr_bdirect;
@@ -1388,6 +1441,100 @@ typedef struct
 
 }mb_info_nmb_t;
 
+/**
+ ******************************************************************************
+ *  @brief      Statistics of the picture coded with a process context.
+ *  Written only by the thread using the context
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * Stage the thread is in, STATS_STAGE_IDLE if outside the encoder
+     */
+    WORD32 i4_stage;
+
+    /**
+     * Time the thread entered the stage at
+     */
+    UWORD64 u8_stage_start_ns;
+
+    /**
+     * Time spent in each stage, STATS_STAGE_WAIT included
+     */
+    UWORD64 au8_stage_ns[STATS_NUM_STAGES];
+
+    /**
+     * Number of P / B skip mbs
+     */
+    UWORD32 u4_num_skip_mbs;
+
+}proc_stats_t;
+
+/**
+ ******************************************************************************
+ *  @brief      Statistics returned by IH264E_CMD_CTL_GET_STATS
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * Flag to enable statistics collection
+     */
+    UWORD32 u4_enable;
+
+    /**
+     * Frame type of the last frame returned
+     */
+    UWORD32 u4_frame_type;
+
+    /**
+     * Sum of the mb SADs of the last frame returned
+     */
+    UWORD32 u4_frame_sad;
+
+    /**
+     * Bits in the last frame returned
+     */
+    UWORD32 u4_frame_bits;
+
+    /**
+     * QP of the last frame returned
+     */
+    UWORD32 u4_frame_qp;
+
+    /**
+     * Number of mbs in the last frame returned
+     */
+    UWORD32 u4_frame_num_mbs;
+
+    /**
+     * Number of skip mbs in the last frame returned
+     */
+    UWORD32 u4_frame_num_skip_mbs;
+
+    /**
+     * Time in each stage for the last frame returned
+     */
+    UWORD64 au8_frame_stage_ns[STATS_NUM_STAGES];
+
+    /**
+     * Number of frames returned since reset
+     */
+    UWORD32 u4_num_frames;
+
+    /**
+     * Bits in the frames returned since reset
+     */
+    UWORD64 u8_num_bits;
+
+    /**
+     * Time in each stage for the frames returned since reset
+     */
+    UWORD64 au8_stage_ns[STATS_NUM_STAGES];
+
+}enc_stats_t;
+
 /**
  ******************************************************************************
  *  @brief      Pixel processing thread context
@@ -1584,6 +1731,11 @@ struct _proc_t
      */
     WORD32 i4_frame_num;
 
+    /**
+     * Is the current picture used for reference
+     */
+    UWORD32 u4_is_curr_frm_ref;
+
     /**
      * start address of frame / sub-frame
      */
@@ -1700,6 +1852,11 @@ struct _proc_t
      */
     UWORD8  au1_intra_luma_mb_8x8_modes[4];
 
+    /**
+     * array to store the predicted mode of the macro block intra 8x8 4 modes
+     */
+    UWORD8  au1_predicted_intra_luma_mb_8x8_modes[4];
+
     /**
      * intra chroma mb mode
      */
@@ -1750,6 +1907,11 @@ struct _proc_t
      */
     enc_pu_mv_t *ps_pred_mv;
 
+    /**
+     * predicted motion vector of each partition of a P16x8, P8x16 or P8x8 MB
+     */
+    mv_t as_part_pred_mv[ENC_NUM_PU_IN_MB];
+
     /**
      * top row mb syntax information base
      * In normal working scenarios, for a given context set,
@@ -1787,12 +1949,12 @@ struct _proc_t
     mb_info_t s_top_left_mb_syntax_ME;
 
     /**
-     * left mb motion vector
+     * left mb motion vectors, one per 8x8 quadrant
      */
-    enc_pu_t s_left_mb_pu_ME;
+    enc_pu_t as_left_mb_pu_ME[ENC_NUM_PU_IN_MB];
 
     /**
-     * top left mb motion vector
+     * top left mb motion vector (its bottom right quadrant)
      */
     enc_pu_t s_top_left_mb_pu_ME;
 
@@ -1831,12 +1993,12 @@ struct _proc_t
     UWORD8 *pu1_top_mb_intra_modes;
 
     /**
-     * left mb motion vector
+     * left mb motion vectors, one per 8x8 quadrant
      */
-    enc_pu_t s_left_mb_pu;
+    enc_pu_t as_left_mb_pu[ENC_NUM_PU_IN_MB];
 
     /**
-     * top left mb motion vector
+     * top left mb motion vector (its bottom right quadrant)
      */
     enc_pu_t s_top_left_mb_pu;
 
@@ -1883,6 +2045,16 @@ struct _proc_t
      */
     UWORD32 au4_nnz_intra_4x4[4];
 
+    /**
+     * transform_8x8_mode_flag of the active pps
+     */
+    WORD8 i1_transform_8x8_mode_flag;
+
+    /**
+     * transform_size_8x8_flag of the current mb
+     */
+    UWORD32 u4_transform_8x8;
+
     /**
      * frame qp & mb qp
      */
@@ -1898,6 +2070,11 @@ struct _proc_t
      */
     quant_params_t *ps_qp_params[3];
 
+    /**
+     * quantization parameters for luma plane with 8x8 transform
+     */
+    quant_params_t *ps_qp_params_8x8;
+
     /**
      * Pointer frame level mb subblock coeff data
      */
@@ -1945,6 +2122,11 @@ struct _proc_t
      */
     WORD32 i4_id;
 
+    /**
+     * Last thread pool frame id seen by the pool thread using this context
+     */
+    WORD32 i4_pool_frame_id;
+
     /**
      * Pointer to current picture buffer structure
      */
@@ -2052,6 +2234,11 @@ struct _proc_t
      */
     frame_info_t s_frame_info;
 
+    /**
+     * statistics of the picture, IH264E_CMD_CTL_GET_STATS
+     */
+    proc_stats_t s_stats;
+
     /*
      * NOTE NOT PERSISTANT INSIDE FUNCTIONS
      * Min sad for current MB
@@ -2137,8 +2324,254 @@ typedef struct
      */
     WORD32 i4_avg_activity;
 
+    /**
+     * rc stats of the current frame, returned to the app
+     */
+    rc_frm_stats_t as_frm_stats[MAX_CTXT_SETS];
+
+    /**
+     * number of frames updated to the rc library, i.e. the index of the
+     * current frame in two pass stats
+     */
+    WORD32 i4_num_frms_coded;
+
 }rate_control_ctxt_t;
 
+/**
+ ******************************************************************************
+ *  @brief      Picture held in the lookahead queue
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * input arguments the picture was queued with
+     */
+    ive_video_encode_ip_t s_ive_ip;
+
+    /**
+     * picture count at the time the picture was queued
+     */
+    WORD32 i4_pic_cnt;
+
+    /**
+     * frame type requested by the app for this picture
+     */
+    IV_PICTURE_CODING_TYPE_T e_force_frame_type;
+
+    /**
+     * sum of intra costs of all lookahead blocks
+     */
+    WORD32 i4_intra_cost;
+
+    /**
+     * sum of min(inter, intra) costs of all lookahead blocks
+     */
+    WORD32 i4_inter_cost;
+
+    /**
+     * set if the picture starts a new scene
+     */
+    WORD32 i4_scene_cut;
+
+}lookahead_frm_t;
+
+/**
+ ******************************************************************************
+ *  @brief      Lookahead related variables
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * queue of pictures yet to be handed to rate control
+     */
+    lookahead_frm_t as_frms[MAX_LOOKAHEAD_FRAMES + 1];
+
+    /**
+     * index of the oldest picture in the queue
+     */
+    WORD32 i4_rd_idx;
+
+    /**
+     * number of pictures in the queue
+     */
+    WORD32 i4_num_frms;
+
+    /**
+     * downscaled luma planes of the current and previous pictures
+     */
+    UWORD8 *apu1_ds_buf[2];
+
+    /**
+     * index of the plane holding the previous picture
+     */
+    WORD32 i4_prev_ds_idx;
+
+    /**
+     * set if the previous plane holds a valid picture
+     */
+    WORD32 i4_prev_ds_valid;
+
+    /**
+     * dimensions and stride of downscaled planes
+     */
+    WORD32 i4_ds_wd;
+
+    WORD32 i4_ds_ht;
+
+    WORD32 i4_ds_strd;
+
+    /**
+     * motion vectors of lookahead blocks of the current picture, used as
+     * search candidates by the neighbouring blocks
+     */
+    WORD16 *pi2_blk_mv;
+
+}lookahead_ctxt_t;
+
+/**
+ ******************************************************************************
+ *  @brief      Bitstream buffer returned by the asynchronous encode interface
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * bitstream buffer and the number of bytes written to it
+     */
+    iv_bits_buf_t s_bits_buf;
+
+    /**
+     * timestamp of the picture coded in the buffer
+     */
+    UWORD32 u4_timestamp_low;
+
+    UWORD32 u4_timestamp_high;
+
+    /**
+     * frame type of the picture coded in the buffer, IV_NA_FRAME if none
+     */
+    UWORD32 u4_encoded_frame_type;
+
+    /**
+     * set for the last buffer of the stream
+     */
+    UWORD32 u4_is_last;
+
+}async_out_buf_t;
+
+/**
+ ******************************************************************************
+ *  @brief      State of the asynchronous (queue / dequeue) encode interface.
+ *  Queues are circular buffers, accessed with the mutex held
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * api handle passed to ih264e_encode() by the encode thread
+     */
+    iv_obj_t *ps_codec_obj;
+
+    /**
+     * handle of the encode thread
+     */
+    void *pv_thread_handle;
+
+    /**
+     * set once the encode thread has been created
+     */
+    WORD32 i4_thread_created;
+
+    /**
+     * mutex guarding this context
+     */
+    void *pv_mutex;
+
+    /**
+     * condition broadcast on every change of the queues
+     */
+    void *pv_cond;
+
+    /**
+     * set to ask the encode thread to exit
+     */
+    WORD32 i4_exit;
+
+    /**
+     * set once the app has queued the last input
+     */
+    WORD32 i4_last_inp_queued;
+
+    /**
+     * set once the last input has been handed to the encoder, the encoder is
+     * flushed from then on
+     */
+    WORD32 i4_flush;
+
+    /**
+     * set once the encoder has returned the last output, or has failed
+     */
+    WORD32 i4_eos;
+
+    /**
+     * error code of the failed encode call, if any
+     */
+    UWORD32 u4_error_code;
+
+    /**
+     * inputs queued by the app, yet to be handed to the encoder
+     */
+    ive_queue_inp_ip_t as_inp_q[MAX_ASYNC_INP_BUFS];
+
+    WORD32 i4_inp_q_rd;
+
+    WORD32 i4_inp_q_cnt;
+
+    /**
+     * inputs held by the encoder, in no particular order
+     */
+    ive_queue_inp_ip_t as_inp_busy[MAX_ASYNC_INP_BUFS];
+
+    WORD32 i4_inp_busy_cnt;
+
+    /**
+     * inputs released by the encoder, yet to be dequeued by the app
+     */
+    ive_queue_inp_ip_t as_inp_done[MAX_ASYNC_INP_BUFS];
+
+    WORD32 i4_inp_done_rd;
+
+    WORD32 i4_inp_done_cnt;
+
+    /**
+     * bitstream buffers queued by the app, yet to be handed to the encoder
+     */
+    iv_bits_buf_t as_out_q[MAX_ASYNC_OUT_BUFS];
+
+    WORD32 i4_out_q_rd;
+
+    WORD32 i4_out_q_cnt;
+
+    /**
+     * bitstream buffers held by the encoder, in no particular order
+     */
+    iv_bits_buf_t as_out_busy[MAX_ASYNC_OUT_BUFS];
+
+    WORD32 i4_out_busy_cnt;
+
+    /**
+     * bitstream buffers returned by the encoder, yet to be dequeued
+     */
+    async_out_buf_t as_out_done[MAX_ASYNC_OUT_BUFS];
+
+    WORD32 i4_out_done_rd;
+
+    WORD32 i4_out_done_cnt;
+
+}async_ctxt_t;
+
 /**
  * Codec context
  */
@@ -2287,6 +2720,12 @@ struct _codec_t
      */
     UWORD32 u4_inter_gate;
 
+    /**
+     * Bitmask of the P MB partitions (1 << P16x8, 1 << P8x16, 1 << P8x8)
+     * evaluated in addition to P16x16 during motion estimation
+     */
+    UWORD32 u4_mb_part_modes;
+
     /**
      * Holds mem records passed during init.
      * This will be used to return the mem records during retrieve call
@@ -2294,9 +2733,28 @@ struct _codec_t
     iv_mem_rec_t *ps_mem_rec_backup;
 
     /**
-     * Flag to determine if the entropy thread is active
+     * Flag to determine if the entropy thread is active. Entropy jobs of
+     * both the context sets share this flag, so that the rows of a picture
+     * are always coded after all the rows of the previous picture
+     */
+    volatile UWORD32 u4_entropy_thread_active;
+
+    /**
+     * Set by the entropy thread once the last row of the picture of a
+     * context set is coded
+     */
+    volatile UWORD32 au4_entropy_done[MAX_CTXT_SETS];
+
+    /**
+     * Context set whose bitstream is yet to be returned to the app when
+     * frame pipelining is active, -1 if none
      */
-    volatile UWORD32 au4_entropy_thread_active[MAX_CTXT_SETS];
+    WORD32 i4_pending_ctxt_sel;
+
+    /**
+     * Frame pipelining is in effect for the current encode call
+     */
+    WORD32 i4_frame_pipelining;
 
     /**
      * Mutex used to keep the entropy calls thread-safe
@@ -2469,6 +2927,63 @@ struct _codec_t
      */
     WORD32 ai4_process_thread_created[MAX_PROCESS_THREADS];
 
+    /**
+     * Number of CPUs the codec threads are pinned to, 0 if not pinned
+     */
+    WORD32 i4_num_affinity_cpus;
+
+    /**
+     * CPUs the codec threads are pinned to
+     */
+    WORD32 ai4_affinity_cpus[MAX_AFFINITY_CPUS];
+
+    /**
+     * Mutex guarding the thread pool state
+     */
+    void *pv_thread_pool_mutex;
+
+    /**
+     * Condition signalled to pool threads when a new frame is to be processed
+     */
+    void *pv_thread_pool_start_cond;
+
+    /**
+     * Condition signalled to the encode thread when all pool threads are done
+     */
+    void *pv_thread_pool_done_cond;
+
+    /**
+     * Progress posted on every proc map update. Waited on by threads that
+     * depend on the top row (proc) or the current mb (entropy) being coded
+     */
+    void *pv_proc_map_progress;
+
+    /**
+     * Progress posted on every ME map update
+     */
+    void *pv_me_map_progress;
+
+    /**
+     * Number of threads in the pool. These threads are alive across encode
+     * calls when u4_keep_threads_active is set
+     */
+    WORD32 i4_pool_thread_cnt;
+
+    /**
+     * Incremented for every frame handed to the pool
+     */
+    volatile WORD32 i4_pool_frame_id;
+
+    /**
+     * Number of pool threads that are yet to finish the current frame
+     */
+    volatile WORD32 i4_pool_busy_cnt;
+
+    /**
+     * Flag to signal pool threads to exit
+     */
+    volatile WORD32 i4_pool_exit;
+
     /**
      * Void pointer to process job context
      */
@@ -2803,6 +3318,21 @@ struct _codec_t
      */
     inp_buf_t as_inp_list[MAX_NUM_INP_FRAMES];
 
+    /**
+     * lookahead context
+     */
+    lookahead_ctxt_t s_lookahead;
+
+    /**
+     * context of the asynchronous encode interface
+     */
+    async_ctxt_t s_async;
+
+    /**
+     * statistics returned by IH264E_CMD_CTL_GET_STATS
+     */
+    enc_stats_t s_stats;
+
     /**
      * Flag to indicate if any IDR requests are pending
      */
@@ -41,6 +41,7 @@
 *  - ih264e_init_air_map()
 *  - ih264e_codec_init()
 *  - ih264e_pic_init()
+*  - ih264e_set_thread_affinity()
 *
 * @remarks
 *  None
@@ -108,6 +109,7 @@
 #include "ih264e_time_stamp.h"
 #include "ih264e_debug.h"
 #include "ih264e_process.h"
+#include "ih264e_lookahead.h"
 #include "ih264e_master.h"
 #include "irc_rate_control_api.h"
 #include "ime_statistics.h"
@@ -195,6 +197,9 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     UWORD32 ctxt_sel, u4_pic_id, u4_pic_disp_id;
     UWORD8 u1_frame_qp, i;
     UWORD32 max_frame_bits = 0x7FFFFFFF;
+    WORD32 i4_pic_cnt = ps_codec->i4_pic_cnt;
+    WORD32 i4_scene_cut = 0;
+    IV_PICTURE_CODING_TYPE_T e_force_frame_type;
 
     /*  Mark that the last input frame has been received */
     if (ps_ive_ip->u4_is_last == 1)
@@ -210,6 +215,33 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
         return 0;
     }
 
+    /***************************************************************************
+     * Lookahead
+     *   The input is delayed by the lookahead depth. From here on, the picture
+     *   leaving the lookahead is treated as the current input
+     **************************************************************************/
+    if (ps_codec->s_cfg.u4_lookahead)
+    {
+        lookahead_frm_t *ps_lkahd_frm = ih264e_lookahead_update(ps_codec,
+                                                                ps_ive_ip);
+
+        if (ps_lkahd_frm == NULL)
+        {
+            ps_enc_buff->s_raw_buf.apv_bufs[0] = NULL;
+            ps_enc_buff->u4_is_last = 0;
+            return 0;
+        }
+
+        ps_ive_ip = &ps_lkahd_frm->s_ive_ip;
+        i4_pic_cnt = ps_lkahd_frm->i4_pic_cnt;
+        i4_scene_cut = ps_lkahd_frm->i4_scene_cut;
+        e_force_frame_type = ps_lkahd_frm->e_force_frame_type;
+    }
+    else
+    {
+        e_force_frame_type = ps_codec->force_curr_frame_type;
+    }
+
     /***************************************************************************
      * Check for pre enc skip
      *   When src and target frame rates donot match, we skip some frames to
@@ -234,8 +266,7 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     /***************************************************************************
      *Queue the input to the queue
      **************************************************************************/
-    ps_inp_buf = &(ps_codec->as_inp_list[ps_codec->i4_pic_cnt
-                                         % MAX_NUM_INP_FRAMES]);
+    ps_inp_buf = &(ps_codec->as_inp_list[i4_pic_cnt % MAX_NUM_INP_FRAMES]);
 
     /* copy input info. to internal structure */
     ps_inp_buf->s_raw_buf = ps_ive_ip->s_inp_buf;
@@ -260,14 +291,15 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     {
         WORD32 i4_force_idr, i4_force_i;
 
-        i4_force_idr = (ps_codec->force_curr_frame_type == IV_IDR_FRAME);
-        i4_force_idr |= !(ps_codec->i4_pic_cnt % ps_codec->s_cfg.u4_idr_frm_interval);
+        i4_force_idr = (e_force_frame_type == IV_IDR_FRAME);
+        i4_force_idr |= !(i4_pic_cnt % ps_codec->s_cfg.u4_idr_frm_interval);
 
-        i4_force_i = (ps_codec->force_curr_frame_type == IV_I_FRAME);
+        /* A scene cut found by the lookahead is coded as an I picture */
+        i4_force_i = (e_force_frame_type == IV_I_FRAME) || i4_scene_cut;
 
         ps_codec->i4_pending_idr_flag |= i4_force_idr;
 
-        if ((ps_codec->i4_pic_cnt > 0) && (i4_force_idr || i4_force_i))
+        if ((i4_pic_cnt > 0) && (i4_force_idr || i4_force_i))
         {
             irc_force_I_frame(ps_codec->s_rate_control.pps_rate_control_api);
         }
@@ -275,11 +307,11 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     }
 
     irc_add_picture_to_stack(ps_codec->s_rate_control.pps_rate_control_api,
-                             ps_codec->i4_pic_cnt);
+                             i4_pic_cnt);
 
 
-    /* Delay */
-    if (ps_codec->i4_encode_api_call_cnt
+    /* Delay, the calls spent filling the lookahead do not count */
+    if (ps_codec->i4_encode_api_call_cnt - (WORD32)ps_codec->s_cfg.u4_lookahead
                     < (WORD32)(ps_codec->s_cfg.u4_num_bframes))
     {
         ps_enc_buff->s_raw_buf.apv_bufs[0] = NULL;
@@ -1081,6 +1113,43 @@ void ih264e_init_quant_params(process_ctxt_t *ps_proc, int qp)
 
         plane += 1;
     }
+
+    /********************************************************************/
+    /* init quant params for luma 8x8 transform                         */
+    /********************************************************************/
+    if (ps_proc->i1_transform_8x8_mode_flag)
+    {
+        u4_qp_div6 = (u4_qp[Y] / 6);
+        u4_qp_mod6 = (u4_qp[Y] % 6);
+
+        ps_qp_params = ps_proc->ps_qp_params_8x8;
+
+        ps_qp_params->u1_mb_qp = u4_qp[Y];
+        ps_qp_params->u1_qp_div = u4_qp_div6;
+        ps_qp_params->u1_qp_rem = u4_qp_mod6;
+
+        /* QP bits */
+        ps_qp_params->u1_qbits = QP_BITS_h264_8x8 + u4_qp_div6;
+
+        /* forward scale matrix */
+        ps_qp_params->pu2_scale_mat = gu2_quant_scale_matrix_8x8 + (u4_qp_mod6 * 64);
+
+        /* qp dependent rounding constant, same fraction of a quant step as
+         * the 4x4 transform */
+        ps_qp_params->u4_dead_zone = ps_proc->ps_qp_params[Y]->u4_dead_zone << 1;
+
+        /* threshold matrix & weight for quantization. Any coefficient below
+         * the threshold quantizes to zero */
+        u4_satdq_t = ((1 << (ps_qp_params->u1_qbits)) - ps_qp_params->u4_dead_zone);
+        for (i = 0; i < 64; i++)
+        {
+            ps_qp_params->pu2_thres_mat[i] = u4_satdq_t / ps_qp_params->pu2_scale_mat[i];
+            ps_qp_params->pu2_weigh_mat[i] = 16;
+        }
+
+        /* inverse scale matrix */
+        ps_qp_params->pu2_iscale_mat = gau2_ih264_iquant_scale_matrix_8x8 + (u4_qp_mod6 * 64);
+    }
     return ;
 }
 
@@ -1198,6 +1267,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = (1 << P16x8) | (1 << P8x16) | (1 << P8x8);
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_NORMAL)
         {/* normal */
@@ -1216,6 +1288,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = (1 << P16x8) | (1 << P8x16);
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_FAST)
          {/* normal */
@@ -1234,6 +1309,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
              /* disabled intra inter gating in Inter slices */
              ps_codec->u4_inter_gate = 1;
+
+             /* P MB partitions evaluated in addition to P16x16 */
+             ps_codec->u4_mb_part_modes = 0;
          }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_HIGH_SPEED)
         {/* fast */
@@ -1252,6 +1330,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_FASTEST)
         {/* fastest */
@@ -1269,6 +1350,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* P MB partitions evaluated in addition to P16x16 */
+            ps_codec->u4_mb_part_modes = 0;
         }
     }
 
@@ -1317,6 +1401,7 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
         switch (ps_codec->s_cfg.e_rc_mode)
         {
             case IVE_RC_STORAGE:
+            case IVE_RC_TWOPASS:
                 ps_codec->s_rate_control.e_rc_type = VBR_STORAGE;
                 break;
             case IVE_RC_CBR_NON_LOW_DELAY:
@@ -1349,6 +1434,16 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
                        ps_codec->s_cfg.u4_num_bframes + 2 , au1_min_max_qp,
                        MAX(ps_codec->s_cfg.u4_max_level,
                                (UWORD32)ih264e_get_min_level(ps_codec->s_cfg.u4_max_wd, ps_codec->s_cfg.u4_max_ht)));
+
+        /* plan the bits of the clip from the first pass stats */
+        ps_codec->s_rate_control.i4_num_frms_coded = 0;
+        if (IVE_RC_TWOPASS == ps_codec->s_cfg.e_rc_mode)
+        {
+            irc_init_two_pass(ps_codec->s_rate_control.pps_rate_control_api,
+                              ps_codec->s_cfg.pv_rc_stats,
+                              ps_codec->s_cfg.u4_rc_stats_size / sizeof(rc_frm_stats_t),
+                              0);
+        }
     }
 
     /* recon stride */
@@ -1365,6 +1460,9 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
     /* Init dependecy vars */
     ps_codec->i4_last_inp_buff_received = 0;
 
+    /* empty lookahead */
+    ih264e_lookahead_init(ps_codec);
+
     /* At codec start no IDR is pending */
     ps_codec->i4_pending_idr_flag = 0;
 
@@ -1840,6 +1938,9 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
             /* frame num */
             ps_proc->i4_frame_num = ps_codec->i4_frame_num;
 
+            /* is ref */
+            ps_proc->u4_is_curr_frm_ref = ps_codec->u4_is_curr_frm_ref;
+
             /* is idr */
             ps_proc->u4_is_idr = ps_codec->u4_is_idr;
 
@@ -1873,6 +1974,10 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
 
             ps_proc->ps_top_row_pu = ps_proc->ps_top_row_pu_base;
 
+            /* transform_8x8_mode_flag of the active pps */
+            ps_proc->i1_transform_8x8_mode_flag =
+                            ps_codec->ps_pps_base[ps_codec->i4_pps_id].i1_transform_8x8_mode_flag;
+
             /* initialize quant params */
             ps_proc->u4_frame_qp = ps_codec->u4_frame_qp;
             ps_proc->u4_mb_qp = ps_codec->u4_frame_qp;
@@ -1884,6 +1989,10 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
             /* Reset frame info */
             memset(&ps_proc->s_frame_info, 0, sizeof(frame_info_t));
 
+            /* Reset frame stats */
+            memset(&ps_proc->s_stats, 0, sizeof(proc_stats_t));
+            ps_proc->s_stats.i4_stage = STATS_STAGE_IDLE;
+
             /* initialize proc, deblk and ME map */
             if (i == j)
             {
@@ -2048,9 +2157,6 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
                     memset(ps_entropy->pu1_entropy_map - ps_proc->i4_wd_mbs, 1, ps_proc->i4_wd_mbs);
                     /* row 0 to ht in mbs */
                     memset(ps_entropy->pu1_entropy_map, 0, ps_proc->i4_wd_mbs * ps_proc->i4_ht_mbs);
-
-                    /* intialize cabac tables */
-                    ih264e_init_cabac_table(ps_entropy);
                 }
 
                 /* wd in mbs */
@@ -2060,7 +2166,7 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
                 ps_entropy->i4_ht_mbs = ps_proc->i4_ht_mbs;
 
                 /* transform_8x8_mode_flag */
-                ps_entropy->i1_transform_8x8_mode_flag = 0;
+                ps_entropy->i1_transform_8x8_mode_flag = ps_proc->i1_transform_8x8_mode_flag;
 
                 /* entropy_coding_mode_flag */
                 ps_entropy->u1_entropy_coding_mode_flag =
@@ -2156,6 +2262,20 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
 
         /* reset encoder header */
         ps_codec->i4_gen_header = 0;
+
+        /* entropy of the current picture is yet to be done */
+        ps_codec->au4_entropy_done[ctxt_sel] = 0;
+
+        /*
+         * Frame number is to be incremented only if the current frame is a
+         * reference frame. It is done here rather than at the end of entropy
+         * coding so that the next picture can be initialized while the current
+         * one is still being entropy coded
+         */
+        if (ps_codec->u4_is_curr_frm_ref)
+        {
+            ps_codec->i4_frame_num++;
+        }
     }
 
     /********************************************************************/
@@ -2202,3 +2322,51 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
 
     return error_status;
 }
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Pins the calling codec thread to the CPU set of the encoder instance
+*
+* @par Description:
+*  If no CPU set is given (IH264E_CMD_CTL_SET_CPU_AFFINITY), the thread is
+*  pinned to core thread_idx as before, which is a no-op unless ithread is
+*  built with affinity support. Otherwise processing thread thread_idx is
+*  pinned to one CPU of the set, round robin, and threads with a negative
+*  index may run on any CPU of the set. As the buffers of a frame are first
+*  touched by the processing threads, pinning them keeps the pages on the
+*  NUMA node of the CPU set
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] thread_idx
+*  Index of the processing thread, negative for other codec threads
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+void ih264e_set_thread_affinity(codec_t *ps_codec, WORD32 thread_idx)
+{
+    /* CPU set of the encoder instance */
+    WORD32 num_cpus = ps_codec->i4_num_affinity_cpus;
+    WORD32 *pi4_cpus = ps_codec->ai4_affinity_cpus;
+
+    if (0 == num_cpus)
+    {
+        if (thread_idx >= 0)
+        {
+            ithread_set_affinity(thread_idx);
+        }
+    }
+    else if (thread_idx >= 0)
+    {
+        ithread_set_affinity_list(&pi4_cpus[thread_idx % num_cpus], 1);
+    }
+    else
+    {
+        ithread_set_affinity_list(pi4_cpus, num_cpus);
+    }
+}
@@ -357,4 +357,22 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec);
 */
 IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf);
 
+/**
+*******************************************************************************
+*
+* @brief
+*  Pins the calling codec thread to the CPU set of the encoder instance
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] thread_idx
+*  Index of the processing thread, negative for other codec threads
+*
+* @returns  none
+*
+*******************************************************************************
+*/
+void ih264e_set_thread_affinity(codec_t *ps_codec, WORD32 thread_idx);
+
 #endif /* IH264E_UTILS_H_ */
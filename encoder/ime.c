@@ -297,9 +297,6 @@ void ime_evaluate_init_srchposn_16x16
     /* enabled fast sad computation */
     UWORD32 u4_enable_fast_sad = ps_me_ctxt->u4_enable_fast_sad;
 
-    /* SAD(distortion metric) of an 8x8 block */
-    WORD32 i4_mb_distortion;
-
     /* cost = distortion + u4_lambda_motion * rate */
     WORD32 i4_mb_cost, i4_mb_cost_least = INT_MAX, i4_distortion_least = INT_MAX;
 
@@ -309,10 +306,15 @@ void ime_evaluate_init_srchposn_16x16
     /* mv bits */
     UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
 
+    /* unique candidates, their ref pointers and sads */
+    UWORD8 u1_num_uniq = 0;
+    UWORD8 au1_uniq_idx[MAX_INIT_SRCH_CAND];
+    UWORD8 *apu1_ref[MAX_INIT_SRCH_CAND];
+    WORD32 ai4_mb_distortion[MAX_INIT_SRCH_CAND];
+
     /* temp var */
     UWORD32  i, j;
     WORD32 i4_srch_pos_idx = 0;
-    UWORD8 *pu1_ref = NULL;
 
     /* Carry out a search using each of the motion vector pairs identified above as predictors. */
     /* TODO : Just like Skip, Do we need to add any bias to zero mv as well */
@@ -333,24 +335,30 @@ void ime_evaluate_init_srchposn_16x16
         if(c_sad)
         {
             /* adjust ref pointer */
-            pu1_ref = pu1_ref_mb + ps_mv_list[i].i2_mvx + (ps_mv_list[i].i2_mvy * i4_ref_strd);
+            apu1_ref[u1_num_uniq] = pu1_ref_mb + ps_mv_list[i].i2_mvx + (ps_mv_list[i].i2_mvy * i4_ref_strd);
+            au1_uniq_idx[u1_num_uniq++] = i;
+        }
+    }
 
-            /* compute distortion */
-            ps_me_ctxt->pf_ime_compute_sad_16x16[u4_enable_fast_sad](pu1_curr_mb, pu1_ref, i4_src_strd, i4_ref_strd, i4_mb_cost_least, &i4_mb_distortion);
+    /* compute distortion of all the unique candidates at once */
+    ps_me_ctxt->pf_ime_compute_sad_16x16_batch[u4_enable_fast_sad](pu1_curr_mb, apu1_ref, i4_src_strd, i4_ref_strd, u1_num_uniq, ai4_mb_distortion);
 
-            DEBUG_SAD_HISTOGRAM_ADD(i4_mb_distortion, 3);
-            /* compute cost */
-            i4_mb_cost = i4_mb_distortion + u4_lambda_motion * ( pu1_mv_bits[ (ps_mv_list[i].i2_mvx << 2) - ps_mb_part->s_mv_pred.i2_mvx]
-                            + pu1_mv_bits[(ps_mv_list[i].i2_mvy << 2) - ps_mb_part->s_mv_pred.i2_mvy] );
+    for(j = 0; j < u1_num_uniq; j++)
+    {
+        i = au1_uniq_idx[j];
 
-            if (i4_mb_cost < i4_mb_cost_least)
-            {
-                i4_mb_cost_least = i4_mb_cost;
+        DEBUG_SAD_HISTOGRAM_ADD(ai4_mb_distortion[j], 3);
+        /* compute cost */
+        i4_mb_cost = ai4_mb_distortion[j] + u4_lambda_motion * ( pu1_mv_bits[ (ps_mv_list[i].i2_mvx << 2) - ps_mb_part->s_mv_pred.i2_mvx]
+                        + pu1_mv_bits[(ps_mv_list[i].i2_mvy << 2) - ps_mb_part->s_mv_pred.i2_mvy] );
 
-                i4_distortion_least = i4_mb_distortion;
+        if (i4_mb_cost < i4_mb_cost_least)
+        {
+            i4_mb_cost_least = i4_mb_cost;
 
-                i4_srch_pos_idx = i;
-            }
+            i4_distortion_least = ai4_mb_distortion[j];
+
+            i4_srch_pos_idx = i;
         }
     }
 
@@ -42,6 +42,9 @@
 #define     TOP_CAND  3
 #define     TOPR_CAND 4
 
+/* Maximum number of candidates for the initial search position */
+#define MAX_INIT_SRCH_CAND 6
+
 #define NONE 0
 #define LEFT 1
 #define RIGHT 2
@@ -36,6 +36,8 @@
 *  - ime_calculate_sad2_prog()
 *  - ime_compute_sad_16x16()
 *  - ime_compute_sad_16x16_fast()
+*  - ime_compute_sad_16x16_batch()
+*  - ime_compute_sad_16x16_fast_batch()
 *  - ime_compute_sad_16x16_ea8()
 *  - ime_compute_sad_8x8()
 *  - ime_compute_sad_4x4()
@@ -59,6 +61,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 /* User include files */
 #include "ime_typedefs.h"
@@ -575,6 +578,103 @@ void ime_compute_sad_16x16_fast(UWORD8 *pu1_src,
     return ;
 }
 
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks
+*
+* @par   Description
+*   This functions computes SAD between the source and each of the candidate
+*   16x16 blocks. The distortion of the entire block is computed for every
+*   candidate.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ime_compute_sad_16x16_batch(UWORD8 *pu1_src,
+                                 UWORD8 **ppu1_est,
+                                 WORD32 src_strd,
+                                 WORD32 est_strd,
+                                 WORD32 i4_num_est,
+                                 WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+    {
+        ime_compute_sad_16x16(pu1_src, ppu1_est[i], src_strd, est_strd,
+                              USHRT_MAX, &pi4_sad[i]);
+    }
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks (fast mode)
+*
+* @par   Description
+*   Same as ime_compute_sad_16x16_batch() but processing alternate rows as in
+*   ime_compute_sad_16x16_fast().
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ime_compute_sad_16x16_fast_batch(UWORD8 *pu1_src,
+                                      UWORD8 **ppu1_est,
+                                      WORD32 src_strd,
+                                      WORD32 est_strd,
+                                      WORD32 i4_num_est,
+                                      WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i < i4_num_est; i++)
+    {
+        ime_compute_sad_16x16_fast(pu1_src, ppu1_est[i], src_strd, est_strd,
+                                   USHRT_MAX, &pi4_sad[i]);
+    }
+}
+
 /**
 ******************************************************************************
 *
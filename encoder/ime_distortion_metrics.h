@@ -50,6 +50,13 @@ typedef void ime_compute_sad_ft(UWORD8 *pu1_src,
                                 WORD32 i4_max_sad,
                                 WORD32 *pi4_mb_distortion);
 
+typedef void ime_compute_sad_batch_ft(UWORD8 *pu1_src,
+                                      UWORD8 **ppu1_est,
+                                      WORD32 src_strd,
+                                      WORD32 est_strd,
+                                      WORD32 i4_num_est,
+                                      WORD32 *pi4_sad);
+
 typedef void ime_compute_sad4_diamond(UWORD8 *pu1_ref,
                                       UWORD8 *pu1_src,
                                       WORD32 ref_strd,
@@ -121,6 +128,8 @@ ime_compute_sad_ft ime_compute_sad_16x8;
 ime_compute_sad_ft ime_compute_sad_16x16_ea8;
 ime_compute_sad_ft ime_compute_sad_8x8;
 ime_compute_sad_ft ime_compute_sad_4x4;
+ime_compute_sad_batch_ft ime_compute_sad_16x16_batch;
+ime_compute_sad_batch_ft ime_compute_sad_16x16_fast_batch;
 ime_compute_sad4_diamond ime_calculate_sad4_prog;
 ime_compute_sad3_diamond ime_calculate_sad3_prog;
 ime_compute_sad2_diamond ime_calculate_sad2_prog;
@@ -135,11 +144,21 @@ ime_compute_satqd_16x16_lumaintra_ft ime_compute_satqd_16x16_lumaintra;
 ime_compute_sad_ft ime_compute_sad_16x16_sse42;
 ime_compute_sad_ft ime_compute_sad_16x16_fast_sse42;
 ime_compute_sad_ft ime_compute_sad_16x8_sse42;
+ime_compute_sad_ft ime_compute_sad_8x8_sse42;
 ime_compute_sad_ft ime_compute_sad_16x16_ea8_sse42;
+ime_compute_sad_batch_ft ime_compute_sad_16x16_batch_sse42;
+ime_compute_sad_batch_ft ime_compute_sad_16x16_fast_batch_sse42;
 ime_sub_pel_compute_sad_16x16_ft ime_sub_pel_compute_sad_16x16_sse42;
 ime_compute_sad4_diamond ime_calculate_sad4_prog_sse42;
 ime_compute_satqd_16x16_lumainter_ft ime_compute_satqd_16x16_lumainter_sse42;
 
+/*AVX2 Declarations*/
+ime_compute_sad_batch_ft ime_compute_sad_16x16_batch_avx2;
+ime_compute_sad_batch_ft ime_compute_sad_16x16_fast_batch_avx2;
+ime_sub_pel_compute_sad_16x16_ft ime_sub_pel_compute_sad_16x16_avx2;
+ime_compute_sad4_diamond ime_calculate_sad4_prog_avx2;
+ime_compute_satqd_16x16_lumainter_ft ime_compute_satqd_16x16_lumainter_avx2;
+
 /* assembly */
 ime_compute_sad_ft ime_compute_sad_16x16_a9q;
 ime_compute_sad_ft ime_compute_sad_16x16_fast_a9q;
@@ -196,7 +196,7 @@ typedef struct
      * Motion vector predictors derived from neighboring
      * blocks for each of the six block partitions
      */
-    ime_mv_t as_mv_init_search[MAX_NUM_REFLIST + 1][6];
+    ime_mv_t as_mv_init_search[MAX_NUM_REFLIST + 1][MAX_INIT_SRCH_CAND];
 
     /**
      * mv bits
@@ -267,7 +267,9 @@ typedef struct
      * fn ptrs for compute sad routines
      */
     ime_compute_sad_ft *pf_ime_compute_sad_16x16[2];
+    ime_compute_sad_batch_ft *pf_ime_compute_sad_16x16_batch[2];
     ime_compute_sad_ft *pf_ime_compute_sad_16x8;
+    ime_compute_sad_ft *pf_ime_compute_sad_8x8;
     ime_compute_sad4_diamond *pf_ime_compute_sad4_diamond;
     ime_compute_sad3_diamond *pf_ime_compute_sad3_diamond;
     ime_compute_sad2_diamond *pf_ime_compute_sad2_diamond;
@@ -21,6 +21,7 @@
 /** Includes */
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "irc_datatypes.h"
 #include "irc_mem_req_and_acq.h"
 #include "irc_common.h"
@@ -83,8 +84,40 @@ typedef struct bit_allocation_t
 
     WORD32 ai4_peak_bit_rate[MAX_NUM_DRAIN_RATES];
 
+    /* First pass stats for two pass RC, NULL when two pass is disabled */
+    const rc_frm_stats_t *ps_two_pass_stats;
+
+    WORD32 i4_two_pass_num_frms;
+
+    /* Index of the current frame in the first pass stats */
+    WORD32 i4_two_pass_frm_idx;
+
+    /* Average first pass complexity of each picture type */
+    DOUBLE ad_two_pass_avg_cplx[MAX_PIC_TYPE];
+
+    /* Sum of the weights of the frames yet to be encoded */
+    DOUBLE d_two_pass_rem_weight;
+
+    /* Bits available for the frames yet to be encoded */
+    DOUBLE d_two_pass_rem_bits;
+
+    /* Bits per unit weight as planned before the errors crept in */
+    DOUBLE d_two_pass_plan_scale;
+
+    /* Average weight of a frame of the clip */
+    DOUBLE d_two_pass_avg_weight;
+
 } bit_allocation_t;
 
+/* Two pass targets are kept within this factor of the planned target */
+#define TWO_PASS_MAX_DEV_FACTOR 2
+
+/*
+ * The deviation from the two pass plan is spread across at least these many
+ * frames, so that the last frames of the clip are not starved or flooded
+ */
+#define TWO_PASS_ERR_SPREAD_FRMS 30
+
 static WORD32 get_number_of_frms_in_a_gop(pic_handling_handle ps_pic_handling)
 {
     WORD32 i4_tot_frms_in_gop = 0, i;
@@ -246,6 +279,89 @@ static void irc_ba_change_rbip(rem_bit_in_prd_t *ps_rbip,
     ps_rbip->i4_bits_per_frm = i4_new_bits_per_frm;
 }
 
+/*
+ * Complexity of a first pass frame: texture bits scaled by the QP they were
+ * coded with, which the first order RD model expects to be nearly constant
+ */
+static DOUBLE get_two_pass_cplx(const rc_frm_stats_t *ps_stats)
+{
+    WORD32 i4_tex_bits = ps_stats->i4_total_bits - ps_stats->i4_header_bits;
+    WORD32 i4_qp = ps_stats->i4_avg_qp;
+
+    if(i4_tex_bits < 1)
+        i4_tex_bits = 1;
+    if(i4_qp < 1)
+        i4_qp = 1;
+
+    return ((DOUBLE)i4_tex_bits * i4_qp);
+}
+
+/*
+ * Share of bits of a first pass frame. The complexity is compressed by a
+ * square root around the average of its picture type, so that complex frames
+ * get more bits but at a higher QP, while the I:P:B ratio of the first pass
+ * is retained for frames of average complexity
+ */
+static DOUBLE get_two_pass_weight(bit_allocation_t *ps_bit_allocation,
+                                  const rc_frm_stats_t *ps_stats)
+{
+    WORD32 i4_pic_type = ps_stats->i4_pic_type;
+
+    if(i4_pic_type < I_PIC || i4_pic_type >= MAX_PIC_TYPE)
+        i4_pic_type = P_PIC;
+
+    return (sqrt(get_two_pass_cplx(ps_stats)
+                    * ps_bit_allocation->ad_two_pass_avg_cplx[i4_pic_type]));
+}
+
+/*
+ * Bits allocated to the current frame from the first pass stats, -1 if the
+ * stats do not describe the current frame
+ */
+static WORD32 get_two_pass_frm_bits(bit_allocation_t *ps_bit_allocation,
+                                    picture_type_e e_pic_type)
+{
+    const rc_frm_stats_t *ps_stats;
+    DOUBLE d_weight, d_bits, d_plan_bits, d_err_bits, d_spread_weight;
+
+    if((NULL == ps_bit_allocation->ps_two_pass_stats)
+                    || (ps_bit_allocation->i4_two_pass_frm_idx
+                                    >= ps_bit_allocation->i4_two_pass_num_frms))
+    {
+        return (-1);
+    }
+
+    ps_stats = &ps_bit_allocation->ps_two_pass_stats[ps_bit_allocation->i4_two_pass_frm_idx];
+    if(ps_stats->i4_pic_type != (WORD32)e_pic_type)
+    {
+        return (-1);
+    }
+
+    d_weight = get_two_pass_weight(ps_bit_allocation, ps_stats);
+    d_plan_bits = d_weight * ps_bit_allocation->d_two_pass_plan_scale;
+
+    /* Spread the deviation from the plan across the frames ahead */
+    d_err_bits = ps_bit_allocation->d_two_pass_rem_bits
+                    - ps_bit_allocation->d_two_pass_rem_weight
+                                    * ps_bit_allocation->d_two_pass_plan_scale;
+    d_spread_weight = ps_bit_allocation->d_two_pass_avg_weight
+                    * TWO_PASS_ERR_SPREAD_FRMS;
+    if(d_spread_weight < ps_bit_allocation->d_two_pass_rem_weight)
+        d_spread_weight = ps_bit_allocation->d_two_pass_rem_weight;
+
+    d_bits = d_plan_bits;
+    if(d_spread_weight > 0)
+        d_bits += d_weight * d_err_bits / d_spread_weight;
+
+    /* Do not let the accumulated error swing the target too far from the plan */
+    if(d_bits > d_plan_bits * TWO_PASS_MAX_DEV_FACTOR)
+        d_bits = d_plan_bits * TWO_PASS_MAX_DEV_FACTOR;
+    if(d_bits < d_plan_bits / TWO_PASS_MAX_DEV_FACTOR)
+        d_bits = d_plan_bits / TWO_PASS_MAX_DEV_FACTOR;
+
+    return ((WORD32)d_bits);
+}
+
 WORD32 irc_ba_num_fill_use_free_memtab(bit_allocation_t **pps_bit_allocation,
                                        itt_memtab_t *ps_memtab,
                                        ITT_FUNC_TYPE_E e_func_type)
@@ -338,6 +454,107 @@ void irc_ba_init_bit_allocation(bit_allocation_t *ps_bit_allocation,
     memset(ps_bit_allocation->i4_prev_frm_header_bits, 0, sizeof(ps_bit_allocation->i4_prev_frm_header_bits));
     for(i=0;i<MAX_NUM_DRAIN_RATES;i++)
         ps_bit_allocation->ai4_peak_bit_rate[i] = i4_peak_bit_rate[i];
+
+    /* Two pass is enabled separately once the first pass stats are known */
+    ps_bit_allocation->ps_two_pass_stats = NULL;
+    ps_bit_allocation->i4_two_pass_num_frms = 0;
+    ps_bit_allocation->i4_two_pass_frm_idx = 0;
+}
+
+/*******************************************************************************
+ Function Name : irc_ba_init_two_pass
+ Description   : Plans the bits of the frames [i4_start_frm, i4_num_frms) of
+                 the clip from the stats of a first pass. The stats are
+                 referenced, not copied.
+ ******************************************************************************/
+void irc_ba_init_two_pass(bit_allocation_t *ps_bit_allocation,
+                          const rc_frm_stats_t *ps_stats,
+                          WORD32 i4_num_frms,
+                          WORD32 i4_start_frm)
+{
+    WORD32 i, ai4_num_frms[MAX_PIC_TYPE];
+
+    ps_bit_allocation->ps_two_pass_stats = NULL;
+    if((NULL == ps_stats) || (i4_start_frm >= i4_num_frms))
+    {
+        return;
+    }
+
+    /* Average complexity of each picture type over the entire clip */
+    for(i = 0; i < MAX_PIC_TYPE; i++)
+    {
+        ps_bit_allocation->ad_two_pass_avg_cplx[i] = 0;
+        ai4_num_frms[i] = 0;
+    }
+    for(i = 0; i < i4_num_frms; i++)
+    {
+        WORD32 i4_pic_type = ps_stats[i].i4_pic_type;
+
+        if(i4_pic_type < I_PIC || i4_pic_type >= MAX_PIC_TYPE)
+            i4_pic_type = P_PIC;
+
+        ps_bit_allocation->ad_two_pass_avg_cplx[i4_pic_type] +=
+                        get_two_pass_cplx(&ps_stats[i]);
+        ai4_num_frms[i4_pic_type]++;
+    }
+    for(i = 0; i < MAX_PIC_TYPE; i++)
+    {
+        if(ai4_num_frms[i])
+            ps_bit_allocation->ad_two_pass_avg_cplx[i] /= ai4_num_frms[i];
+    }
+
+    ps_bit_allocation->ps_two_pass_stats = ps_stats;
+    ps_bit_allocation->i4_two_pass_num_frms = i4_num_frms;
+    ps_bit_allocation->i4_two_pass_frm_idx = i4_start_frm;
+
+    /* Budget of the remaining frames and their total weight */
+    ps_bit_allocation->d_two_pass_rem_weight = 0;
+    for(i = i4_start_frm; i < i4_num_frms; i++)
+    {
+        ps_bit_allocation->d_two_pass_rem_weight += get_two_pass_weight(
+                        ps_bit_allocation, &ps_stats[i]);
+    }
+    ps_bit_allocation->d_two_pass_rem_bits = (DOUBLE)ps_bit_allocation->i4_bits_per_frm
+                    * (i4_num_frms - i4_start_frm);
+    ps_bit_allocation->d_two_pass_avg_weight =
+                    ps_bit_allocation->d_two_pass_rem_weight
+                                    / (i4_num_frms - i4_start_frm);
+
+    ps_bit_allocation->d_two_pass_plan_scale = 0;
+    if(ps_bit_allocation->d_two_pass_rem_weight > 0)
+    {
+        ps_bit_allocation->d_two_pass_plan_scale =
+                        ps_bit_allocation->d_two_pass_rem_bits
+                                        / ps_bit_allocation->d_two_pass_rem_weight;
+    }
+}
+
+/*******************************************************************************
+ Function Name : irc_ba_get_two_pass_frm_qp
+ Description   : QP that meets the two pass target of the current frame as per
+                 its first pass complexity. Used for frames that precede the
+                 RD model being trained. Returns 0 if there is no estimate.
+ ******************************************************************************/
+WORD32 irc_ba_get_two_pass_frm_qp(bit_allocation_t *ps_bit_allocation,
+                                  picture_type_e e_pic_type)
+{
+    const rc_frm_stats_t *ps_stats;
+    WORD32 i4_tex_bits;
+    WORD32 i4_bits = get_two_pass_frm_bits(ps_bit_allocation, e_pic_type);
+
+    if(i4_bits < 0)
+    {
+        return (0);
+    }
+
+    ps_stats = &ps_bit_allocation->ps_two_pass_stats[ps_bit_allocation->i4_two_pass_frm_idx];
+    i4_tex_bits = i4_bits - ps_stats->i4_header_bits;
+    if(i4_tex_bits <= 0)
+    {
+        return (0);
+    }
+
+    return ((WORD32)(get_two_pass_cplx(ps_stats) / i4_tex_bits + 0.5));
 }
 
 /*******************************************************************************
@@ -362,6 +579,20 @@ WORD32 irc_ba_get_cur_frm_est_texture_bits(bit_allocation_t *ps_bit_allocation,
 
     WORD32 complexity_est = 0;
 
+    /* In two pass the bits come from the plan made from the first pass stats */
+    i4_est_texture_bits_for_frm = get_two_pass_frm_bits(ps_bit_allocation,
+                                                        e_pic_type);
+    if(i4_est_texture_bits_for_frm >= 0)
+    {
+        i4_est_texture_bits_for_frm -=
+                        ps_bit_allocation->i4_prev_frm_header_bits[e_pic_type];
+        if(i4_est_texture_bits_for_frm < 0)
+        {
+            i4_est_texture_bits_for_frm = 0;
+        }
+        return (i4_est_texture_bits_for_frm);
+    }
+
     /* Get the rem_frms_in_gop & the frms_in_gop from the pic_type state struct */
     irc_pic_type_get_rem_frms_in_gop(ps_pic_handling, i4_rem_frms_in_period);
     irc_pic_type_get_frms_in_gop(ps_pic_handling, i4_frms_in_period);
@@ -580,6 +811,18 @@ void irc_ba_update_cur_frm_consumed_bits(bit_allocation_t *ps_bit_allocation,
 {
     WORD32 i4_error_bits = irc_get_error_bits(ps_bit_allocation->ps_error_bits);
 
+    /* Move the two pass plan to the next frame */
+    if((NULL != ps_bit_allocation->ps_two_pass_stats)
+                    && (ps_bit_allocation->i4_two_pass_frm_idx
+                                    < ps_bit_allocation->i4_two_pass_num_frms))
+    {
+        ps_bit_allocation->d_two_pass_rem_weight -= get_two_pass_weight(
+                        ps_bit_allocation,
+                        &ps_bit_allocation->ps_two_pass_stats[ps_bit_allocation->i4_two_pass_frm_idx]);
+        ps_bit_allocation->d_two_pass_rem_bits -= i4_total_frame_bits;
+        ps_bit_allocation->i4_two_pass_frm_idx++;
+    }
+
     /* Update the remaining bits in period */
     irc_ba_update_rbip(&ps_bit_allocation->s_rbip, ps_pic_handling,
                        (-i4_total_frame_bits + i4_error_bits));
@@ -682,6 +925,23 @@ void irc_ba_change_remaining_bits_in_period(bit_allocation_t *ps_bit_allocation,
                        i4_new_avg_bits_per_frm,
                        ps_bit_allocation->i4_num_gops_in_period);
 
+    /*
+     * Rescale the two pass budget of the remaining frames. The plan follows
+     * the new rate while the deviation from it is retained
+     */
+    if((NULL != ps_bit_allocation->ps_two_pass_stats)
+                    && (i4_new_avg_bits_per_frm != ps_bit_allocation->i4_bits_per_frm)
+                    && (ps_bit_allocation->i4_bits_per_frm > 0))
+    {
+        WORD32 i4_rem_frms = ps_bit_allocation->i4_two_pass_num_frms
+                        - ps_bit_allocation->i4_two_pass_frm_idx;
+
+        ps_bit_allocation->d_two_pass_rem_bits += (DOUBLE)(i4_new_avg_bits_per_frm
+                        - ps_bit_allocation->i4_bits_per_frm) * i4_rem_frms;
+        ps_bit_allocation->d_two_pass_plan_scale *= (DOUBLE)i4_new_avg_bits_per_frm
+                        / ps_bit_allocation->i4_bits_per_frm;
+    }
+
     /* Update the new average bits per frame */
     ps_bit_allocation->i4_bits_per_frm = i4_new_avg_bits_per_frm;
     /* change the lower modules state */
@@ -35,6 +35,16 @@ void irc_ba_init_bit_allocation(bit_allocation_handle ps_bit_allocation,
                                 WORD32 *u4_peak_bit_rate,
                                 WORD32 i4_min_bitrate);
 
+/* Plans the bits of the clip from the stats of a first pass */
+void irc_ba_init_two_pass(bit_allocation_handle ps_bit_allocation,
+                          const rc_frm_stats_t *ps_stats,
+                          WORD32 i4_num_frms,
+                          WORD32 i4_start_frm);
+
+/* QP of the current frame as per its first pass complexity, 0 if unknown */
+WORD32 irc_ba_get_two_pass_frm_qp(bit_allocation_handle ps_bit_allocation,
+                                  picture_type_e e_pic_type);
+
 /* Estimates the number of texture bits required by the current frame */
 WORD32 irc_ba_get_cur_frm_est_texture_bits(bit_allocation_handle ps_bit_allocation,
                                            rc_rd_model_handle *pps_rd_model,
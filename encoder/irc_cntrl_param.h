@@ -21,7 +21,7 @@
 #ifndef _RC_CNTRL_PARAM_H_
 #define _RC_CNTRL_PARAM_H_
 
-/* This file should contain only enumerations exported to codec by RC */
+/* This file should contain only enumerations and types exported to codec by RC */
 
 /* RC algo type */
 typedef enum
@@ -55,5 +55,25 @@ typedef enum
 
 } vbv_buf_status_e;
 
+/* Per picture statistics of a first pass, consumed by two pass RC */
+typedef struct
+{
+    /* Picture type (picture_type_e) */
+    WORD32 i4_pic_type;
+
+    /* Sum of all MB SADs */
+    WORD32 i4_frame_sad;
+
+    /* Total bits consumed by the picture */
+    WORD32 i4_total_bits;
+
+    /* Header bits consumed by the picture */
+    WORD32 i4_header_bits;
+
+    /* Average QP (mpeg2 scale) */
+    WORD32 i4_avg_qp;
+
+} rc_frm_stats_t;
+
 #endif
 
@@ -313,6 +313,31 @@ void irc_initialise_rate_control(rate_control_api_t *ps_rate_control_api,
     ps_rate_control_api->prev_ref_pic_type = I_PIC;
 }
 
+/*****************************************************************************
+ Function Name : irc_init_two_pass
+ Description   : Enables two pass bit allocation
+ Inputs        : ps_rate_control_api - api struct
+                 ps_stats            - per frame stats of the first pass, in
+                                       encode order. Referenced, not copied
+                 i4_num_frms         - number of frames in ps_stats
+                 i4_start_frm        - index of the next frame to be encoded
+ *****************************************************************************/
+void irc_init_two_pass(rate_control_api_t *ps_rate_control_api,
+                       const rc_frm_stats_t *ps_stats,
+                       WORD32 i4_num_frms,
+                       WORD32 i4_start_frm)
+{
+    /* Only the RC types that use the bit allocation module */
+    if((ps_rate_control_api->e_rc_type == VBR_STORAGE)
+                    || (ps_rate_control_api->e_rc_type == VBR_STORAGE_DVD_COMP)
+                    || (ps_rate_control_api->e_rc_type == VBR_STREAMING)
+                    || (ps_rate_control_api->e_rc_type == CBR_NLDRC))
+    {
+        irc_ba_init_two_pass(ps_rate_control_api->ps_bit_allocation, ps_stats,
+                             i4_num_frms, i4_start_frm);
+    }
+}
+
 /******************************************************************************
  *Description   : calls irc_add_pic_to_stack
  ******************************************************************************/
@@ -655,6 +680,24 @@ UWORD8 irc_get_frame_level_qp(rate_control_api_t *ps_rate_control_api,
             {
                 u1_frame_qp = ps_rate_control_api->au1_prev_frm_qp[e_pic_type];
             }
+
+            /*
+             * In two pass, the first pass complexity of the frame gives a
+             * better estimate than the previous QP
+             */
+            {
+                WORD32 i4_two_pass_qp = irc_ba_get_two_pass_frm_qp(
+                                ps_rate_control_api->ps_bit_allocation,
+                                e_pic_type);
+
+                if(i4_two_pass_qp)
+                {
+                    u1_frame_qp = (UWORD8)CLIP_QP(
+                                    i4_two_pass_qp,
+                                    ps_rate_control_api->au1_min_max_qp[(e_pic_type << 1) + 1],
+                                    ps_rate_control_api->au1_min_max_qp[(e_pic_type << 1)]);
+                }
+            }
         }
     }
     else
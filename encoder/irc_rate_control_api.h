@@ -52,6 +52,12 @@ void irc_initialise_rate_control(rate_control_handle ps_rate_control_api,
                                  UWORD32 u4_src_ticks,
                                  UWORD32 u4_tgt_ticks);
 
+/* Enables two pass bit allocation from the stats of a first pass */
+void irc_init_two_pass(rate_control_handle ps_rate_control_api,
+                       const rc_frm_stats_t *ps_stats,
+                       WORD32 i4_num_frms,
+                       WORD32 i4_start_frm);
+
 /*****************************************************************************
  Process level API fuctions (FRAME LEVEL)
  *****************************************************************************/
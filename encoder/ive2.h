@@ -145,6 +145,7 @@ typedef enum
     IVE_CMD_CTL_FLUSH                       = 0xB0,
     IVE_CMD_CTL_GETBUFINFO                  = 0xC0,
     IVE_CMD_CTL_GETVERSION                  = 0xC1,
+    IVE_CMD_CTL_GET_ARCH                    = 0xC2,
     IVE_CMD_CTL_CODEC_SUBCMD_START          = 0x100,
 }IVE_CONTROL_API_COMMAND_TYPE_T;
 
@@ -238,6 +239,22 @@ typedef enum
     IVE_ERR_OP_CTL_SETPROFILE_API_STRUCT_SIZE_INCORRECT         = 0x3F,
     IVE_ERR_IP_CTL_SET_VUI_STRUCT_SIZE_INCORRECT                = 0x40,
     IVE_ERR_OP_CTL_SET_VUI_STRUCT_SIZE_INCORRECT                = 0x41,
+    IVE_ERR_IP_CTL_GET_ARCH_STRUCT_SIZE_INCORRECT               = 0x42,
+    IVE_ERR_OP_CTL_GET_ARCH_STRUCT_SIZE_INCORRECT               = 0x43,
+    IVE_ERR_IP_QUEUE_INPUT_API_STRUCT_SIZE_INCORRECT            = 0x44,
+    IVE_ERR_OP_QUEUE_INPUT_API_STRUCT_SIZE_INCORRECT            = 0x45,
+    IVE_ERR_IP_DEQUEUE_INPUT_API_STRUCT_SIZE_INCORRECT          = 0x46,
+    IVE_ERR_OP_DEQUEUE_INPUT_API_STRUCT_SIZE_INCORRECT          = 0x47,
+    IVE_ERR_IP_QUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT           = 0x48,
+    IVE_ERR_OP_QUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT           = 0x49,
+    IVE_ERR_IP_DEQUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT         = 0x4A,
+    IVE_ERR_OP_DEQUEUE_OUTPUT_API_STRUCT_SIZE_INCORRECT         = 0x4B,
+    IVE_ERR_IP_CTL_SET_CPU_AFFINITY_STRUCT_SIZE_INCORRECT       = 0x4C,
+    IVE_ERR_OP_CTL_SET_CPU_AFFINITY_STRUCT_SIZE_INCORRECT       = 0x4D,
+    IVE_ERR_IP_CTL_SET_STATS_STRUCT_SIZE_INCORRECT              = 0x4E,
+    IVE_ERR_OP_CTL_SET_STATS_STRUCT_SIZE_INCORRECT              = 0x4F,
+    IVE_ERR_IP_CTL_GET_STATS_STRUCT_SIZE_INCORRECT              = 0x50,
+    IVE_ERR_OP_CTL_GET_STATS_STRUCT_SIZE_INCORRECT              = 0x51,
 }IVE_ERROR_CODES_T;
 
 
@@ -793,6 +810,40 @@ typedef struct
 }ive_ctl_getversioninfo_op_t;
 
 
+/*****************************************************************************/
+/*   Video control:Get Architecture                                          */
+/*****************************************************************************/
+
+/** Input structure : Get architecture whose kernels are in use         */
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Command type : IVE_CMD_VIDEO_CTL                                */
+    IVE_API_COMMAND_TYPE_T                      e_cmd;
+
+    /** Sub command type : IVE_CMD_CTL_GET_ARCH                         */
+    IVE_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ive_ctl_get_arch_ip_t;
+
+/** Output structure : Get architecture whose kernels are in use        */
+typedef struct
+{
+    /** size of the structure                                           */
+    UWORD32                                     u4_size;
+
+    /** Return error code                                               */
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Architecture in use. This can differ from the one requested at init,
+     * when the cpu does not support it
+     */
+    IV_ARCH_T                                   e_arch;
+}ive_ctl_get_arch_op_t;
+
+
 /*****************************************************************************/
 /*   Video control:set  default params                                       */
 /*****************************************************************************/
@@ -78,6 +78,7 @@
 #include "ih264e_structs.h"
 #include "ih264e_cabac.h"
 #include "ih264e_platform_macros.h"
+#include "ih264_cpu_features.h"
 
 /**
 *******************************************************************************
@@ -100,6 +101,26 @@
 void ih264e_init_function_ptr(void *pv_codec)
 {
     codec_t *ps_codec = (codec_t *)pv_codec;
+    IV_ARCH_T e_max_arch = ih264e_default_arch();
+
+    /* Requests for a non x86 or unsupported path fall back to the best one */
+    switch(ps_codec->s_cfg.e_arch)
+    {
+        case ARCH_X86_GENERIC:
+            break;
+        case ARCH_X86_SSSE3:
+            if(e_max_arch == ARCH_X86_GENERIC)
+                ps_codec->s_cfg.e_arch = e_max_arch;
+            break;
+        case ARCH_X86_SSE42:
+            if((e_max_arch != ARCH_X86_SSE42) && (e_max_arch != ARCH_X86_AVX2))
+                ps_codec->s_cfg.e_arch = e_max_arch;
+            break;
+        default:
+            ps_codec->s_cfg.e_arch = e_max_arch;
+            break;
+    }
+
     ih264e_init_function_ptr_generic(ps_codec);
     switch(ps_codec->s_cfg.e_arch)
     {
@@ -110,9 +131,14 @@ void ih264e_init_function_ptr(void *pv_codec)
             ih264e_init_function_ptr_ssse3(ps_codec);
             break;
         case ARCH_X86_SSE42:
+            ih264e_init_function_ptr_ssse3(ps_codec);
+            ih264e_init_function_ptr_sse42(ps_codec);
+            break;
+        case ARCH_X86_AVX2:
         default:
             ih264e_init_function_ptr_ssse3(ps_codec);
             ih264e_init_function_ptr_sse42(ps_codec);
+            ih264e_init_function_ptr_avx2(ps_codec);
             break;
     }
 }
@@ -122,8 +148,8 @@ void ih264e_init_function_ptr(void *pv_codec)
 *
 * @brief Determine the architecture of the encoder executing environment
 *
-* @par Description: This routine returns the architecture of the enviro-
-* ment in which the current encoder is being tested
+* @par Description: This routine returns the highest x86 SIMD path supported
+* by the cpu the encoder is running on, as detected by cpuid
 *
 * @param[in] void
 *
@@ -136,7 +162,17 @@ void ih264e_init_function_ptr(void *pv_codec)
 */
 IV_ARCH_T ih264e_default_arch(void)
 {
-    return ARCH_X86_SSE42;
-}
+    UWORD32 u4_features = ih264_get_cpu_features();
+
+    if(!(u4_features & CPU_FEATURE_SSSE3))
+        return ARCH_X86_GENERIC;
+
+    if(!(u4_features & CPU_FEATURE_SSE42))
+        return ARCH_X86_SSSE3;
 
+    if(!(u4_features & CPU_FEATURE_AVX2))
+        return ARCH_X86_SSE42;
+
+    return ARCH_X86_AVX2;
+}
 
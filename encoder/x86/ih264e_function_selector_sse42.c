@@ -132,7 +132,10 @@ void ih264e_init_function_ptr_sse42(codec_t *ps_codec)
         ps_me_ctxt = &ps_proc->s_me_ctxt;
         ps_me_ctxt->pf_ime_compute_sad_16x16[0] = ime_compute_sad_16x16_sse42;
         ps_me_ctxt->pf_ime_compute_sad_16x16[1] = ime_compute_sad_16x16_fast_sse42;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[0] = ime_compute_sad_16x16_batch_sse42;
+        ps_me_ctxt->pf_ime_compute_sad_16x16_batch[1] = ime_compute_sad_16x16_fast_batch_sse42;
         ps_me_ctxt->pf_ime_compute_sad_16x8 = ime_compute_sad_16x8_sse42;
+        ps_me_ctxt->pf_ime_compute_sad_8x8 = ime_compute_sad_8x8_sse42;
         ps_me_ctxt->pf_ime_compute_sad4_diamond = ime_calculate_sad4_prog_sse42;
         ps_me_ctxt->pf_ime_sub_pel_compute_sad_16x16 = ime_sub_pel_compute_sad_16x16_sse42;
         ps_me_ctxt->pf_ime_compute_sad_stat_luma_16x16      = ime_compute_satqd_16x16_lumainter_sse42;
@@ -127,6 +127,7 @@ void ih264e_init_function_ptr_ssse3(codec_t *ps_codec)
      /* Init function pointers for intra pred leaf level functions luma
       * Intra 8x8 */
      ps_codec->apf_intra_pred_8_l[0] = ih264_intra_pred_luma_8x8_mode_vert_ssse3;
+     ps_codec->apf_intra_pred_8_l[1] = ih264_intra_pred_luma_8x8_mode_horz_ssse3;
      ps_codec->apf_intra_pred_8_l[2] = ih264_intra_pred_luma_8x8_mode_dc_ssse3;
      ps_codec->apf_intra_pred_8_l[3] = ih264_intra_pred_luma_8x8_mode_diag_dl_ssse3;
      ps_codec->apf_intra_pred_8_l[4] = ih264_intra_pred_luma_8x8_mode_diag_dr_ssse3;
@@ -0,0 +1,587 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+******************************************************************************
+* @file ime_distortion_metrics_avx2.c
+*
+* @brief
+*  This file contains definitions of routines that compute distortion
+*  between two macro/sub blocks of identical dimensions using avx2 intrinsics.
+*  Each 256 bit operation works on two rows of a block or on one row of two
+*  candidate blocks.
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ime_compute_sad_16x16_batch_avx2()
+*  - ime_compute_sad_16x16_fast_batch_avx2()
+*  - ime_calculate_sad4_prog_avx2()
+*  - ime_sub_pel_compute_sad_16x16_avx2()
+*  - ime_compute_satqd_16x16_lumainter_avx2()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User include files */
+#include "ime_typedefs.h"
+#include "ime_defs.h"
+#include "ime_macros.h"
+#include "ime_statistics.h"
+#include "ime_platform_macros.h"
+#include "ime_distortion_metrics.h"
+#include "ih264_platform_macros.h"
+#include <immintrin.h>
+
+/*****************************************************************************/
+/* Static Function Definitions                                               */
+/*****************************************************************************/
+
+/* Loads 16 pixels of two rows, the first one into the lower lane */
+static FORCEINLINE AVX2_TARGET __m256i ime_load_row_pair_avx2(UWORD8 *pu1_row0,
+                                                              UWORD8 *pu1_row1)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_row0)),
+                                   _mm_loadu_si128((__m128i *)pu1_row1), 1);
+}
+
+/* Adds the four 64 bit partial sads of both lanes */
+static FORCEINLINE AVX2_TARGET WORD32 ime_sum_sad_avx2(__m256i sad_4x64b)
+{
+    __m128i sad_2x64b = _mm_add_epi64(_mm256_castsi256_si128(sad_4x64b),
+                                      _mm256_extracti128_si256(sad_4x64b, 1));
+
+    return _mm_cvtsi128_si32(_mm_add_epi64(sad_2x64b, _mm_srli_si128(sad_2x64b, 8)));
+}
+
+/* Adds the 64 bit partial sads of each lane separately */
+static FORCEINLINE AVX2_TARGET void ime_sum_sad_lanes_avx2(__m256i sad_4x64b,
+                                                           WORD32 *pi4_sad_lane0,
+                                                           WORD32 *pi4_sad_lane1)
+{
+    sad_4x64b = _mm256_add_epi64(sad_4x64b, _mm256_srli_si256(sad_4x64b, 8));
+    *pi4_sad_lane0 = _mm256_extract_epi32(sad_4x64b, 0);
+    *pi4_sad_lane1 = _mm256_extract_epi32(sad_4x64b, 4);
+}
+
+/* SAD of ht rows of a 16 wide block, rows taken row_step apart */
+static FORCEINLINE AVX2_TARGET WORD32 ime_sad_16xn_avx2(UWORD8 *pu1_src,
+                                                        UWORD8 *pu1_est,
+                                                        WORD32 src_strd,
+                                                        WORD32 est_strd,
+                                                        WORD32 ht,
+                                                        WORD32 row_step)
+{
+    __m256i sad_4x64b = _mm256_setzero_si256();
+    WORD32 src_step = src_strd * row_step;
+    WORD32 est_step = est_strd * row_step;
+    WORD32 i;
+
+    /* four rows per iteration, ht being a multiple of 4 */
+    for(i = 0; i < ht; i += 4)
+    {
+        __m256i src0_32x8b = ime_load_row_pair_avx2(pu1_src, pu1_src + src_step);
+        __m256i est0_32x8b = ime_load_row_pair_avx2(pu1_est, pu1_est + est_step);
+        __m256i src1_32x8b = ime_load_row_pair_avx2(pu1_src + 2 * src_step,
+                                                    pu1_src + 3 * src_step);
+        __m256i est1_32x8b = ime_load_row_pair_avx2(pu1_est + 2 * est_step,
+                                                    pu1_est + 3 * est_step);
+
+        sad_4x64b = _mm256_add_epi64(sad_4x64b, _mm256_sad_epu8(src0_32x8b, est0_32x8b));
+        sad_4x64b = _mm256_add_epi64(sad_4x64b, _mm256_sad_epu8(src1_32x8b, est1_32x8b));
+
+        pu1_src += 4 * src_step;
+        pu1_est += 4 * est_step;
+    }
+
+    return ime_sum_sad_avx2(sad_4x64b);
+}
+
+/* SADs of a 16 wide block against two candidates, rows taken row_step apart */
+static FORCEINLINE AVX2_TARGET void ime_sad_16xn_x2_avx2(UWORD8 *pu1_src,
+                                                         UWORD8 *pu1_est0,
+                                                         UWORD8 *pu1_est1,
+                                                         WORD32 src_strd,
+                                                         WORD32 est_strd,
+                                                         WORD32 ht,
+                                                         WORD32 row_step,
+                                                         WORD32 *pi4_sad)
+{
+    __m256i sad_4x64b = _mm256_setzero_si256();
+    WORD32 src_step = src_strd * row_step;
+    WORD32 est_step = est_strd * row_step;
+    WORD32 i;
+
+    /* two rows per iteration, ht being even */
+    for(i = 0; i < ht; i += 2)
+    {
+        __m256i src0_32x8b = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+        __m256i est0_32x8b = ime_load_row_pair_avx2(pu1_est0, pu1_est1);
+        __m256i src1_32x8b = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)(pu1_src + src_step)));
+        __m256i est1_32x8b = ime_load_row_pair_avx2(pu1_est0 + est_step, pu1_est1 + est_step);
+
+        sad_4x64b = _mm256_add_epi64(sad_4x64b, _mm256_sad_epu8(src0_32x8b, est0_32x8b));
+        sad_4x64b = _mm256_add_epi64(sad_4x64b, _mm256_sad_epu8(src1_32x8b, est1_32x8b));
+
+        pu1_src += 2 * src_step;
+        pu1_est0 += 2 * est_step;
+        pu1_est1 += 2 * est_step;
+    }
+
+    ime_sum_sad_lanes_avx2(sad_4x64b, &pi4_sad[0], &pi4_sad[1]);
+}
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks
+*
+* @par   Description
+*   The source rows are loaded once for every pair of candidates and scored
+*   against both of them in a single operation.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+AVX2_TARGET void ime_compute_sad_16x16_batch_avx2(UWORD8 *pu1_src,
+                                                  UWORD8 **ppu1_est,
+                                                  WORD32 src_strd,
+                                                  WORD32 est_strd,
+                                                  WORD32 i4_num_est,
+                                                  WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i + 1 < i4_num_est; i += 2)
+        ime_sad_16xn_x2_avx2(pu1_src, ppu1_est[i], ppu1_est[i + 1], src_strd, est_strd, 16, 1,
+                             &pi4_sad[i]);
+
+    if(i < i4_num_est)
+        pi4_sad[i] = ime_sad_16xn_avx2(pu1_src, ppu1_est[i], src_strd, est_strd, 16, 1);
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks (fast mode)
+*
+* @par   Description
+*   Same as ime_compute_sad_16x16_batch_avx2() but processing alternate rows
+*   as in ime_compute_sad_16x16_fast().
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+AVX2_TARGET void ime_compute_sad_16x16_fast_batch_avx2(UWORD8 *pu1_src,
+                                                       UWORD8 **ppu1_est,
+                                                       WORD32 src_strd,
+                                                       WORD32 est_strd,
+                                                       WORD32 i4_num_est,
+                                                       WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    for(i = 0; i + 1 < i4_num_est; i += 2)
+    {
+        ime_sad_16xn_x2_avx2(pu1_src, ppu1_est[i], ppu1_est[i + 1], src_strd, est_strd, 8, 2,
+                             &pi4_sad[i]);
+        pi4_sad[i] <<= 1;
+        pi4_sad[i + 1] <<= 1;
+    }
+
+    if(i < i4_num_est)
+        pi4_sad[i] = ime_sad_16xn_avx2(pu1_src, ppu1_est[i], src_strd, est_strd, 8, 2) << 1;
+}
+
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad at vertices of diamond grid
+* centered at reference pointer and at unit distance from it. The left and
+* right vertices share one operation, as do the top and bottom ones.
+*
+* @param[in] pu1_ref
+*  UWORD8 pointer to the reference
+*
+* @param[out] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad
+*
+* @returns  sad at all evaluated vertexes
+*
+* @remarks  none
+*
+*******************************************************************************
+*/
+AVX2_TARGET void ime_calculate_sad4_prog_avx2(UWORD8 *pu1_ref,
+                                              UWORD8 *pu1_src,
+                                              WORD32 ref_strd,
+                                              WORD32 src_strd,
+                                              WORD32 *pi4_sad)
+{
+    __m256i sad_lr_4x64b = _mm256_setzero_si256();
+    __m256i sad_tb_4x64b = _mm256_setzero_si256();
+    __m128i ref_prev_16x8b, ref_curr_16x8b, ref_next_16x8b;
+    WORD32 i;
+
+    ref_prev_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref - ref_strd));
+    ref_curr_16x8b = _mm_loadu_si128((__m128i *)pu1_ref);
+
+    for(i = 0; i < 16; i++)
+    {
+        __m256i src_32x8b = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+        __m256i ref_lr_32x8b = ime_load_row_pair_avx2(pu1_ref - 1, pu1_ref + 1);
+        __m256i ref_tb_32x8b;
+
+        /* the top and bottom vertices are the rows above and below */
+        ref_next_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref + ref_strd));
+        ref_tb_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(ref_prev_16x8b),
+                                               ref_next_16x8b, 1);
+
+        sad_lr_4x64b = _mm256_add_epi64(sad_lr_4x64b, _mm256_sad_epu8(src_32x8b, ref_lr_32x8b));
+        sad_tb_4x64b = _mm256_add_epi64(sad_tb_4x64b, _mm256_sad_epu8(src_32x8b, ref_tb_32x8b));
+
+        ref_prev_16x8b = ref_curr_16x8b;
+        ref_curr_16x8b = ref_next_16x8b;
+        pu1_src += src_strd;
+        pu1_ref += ref_strd;
+    }
+
+    ime_sum_sad_lanes_avx2(sad_lr_4x64b, &pi4_sad[0], &pi4_sad[1]);
+    ime_sum_sad_lanes_avx2(sad_tb_4x64b, &pi4_sad[2], &pi4_sad[3]);
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) at all subpel points about the src location
+*
+* @par Description
+*   This functions computes SAD at all points at a subpel distance from the
+*   current source location, scoring two of the points per operation.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_ref_half_x
+*  UWORD8 pointer to half pel buffer
+*
+* @param[out] pu1_ref_half_y
+*  UWORD8 pointer to half pel buffer
+*
+* @param[out] pu1_ref_half_xy
+*  UWORD8 pointer to half pel buffer
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] ref_strd
+*  integer ref stride
+*
+* @param[out] pi4_sad
+*  integer evaluated sad
+*  pi4_sad[0] - half x
+*  pi4_sad[1] - half x - 1
+*  pi4_sad[2] - half y
+*  pi4_sad[3] - half y - 1
+*  pi4_sad[4] - half xy
+*  pi4_sad[5] - half xy - 1
+*  pi4_sad[6] - half xy - strd
+*  pi4_sad[7] - half xy - 1 - strd
+*
+* @remarks
+*
+******************************************************************************
+*/
+AVX2_TARGET void ime_sub_pel_compute_sad_16x16_avx2(UWORD8 *pu1_src,
+                                                    UWORD8 *pu1_ref_half_x,
+                                                    UWORD8 *pu1_ref_half_y,
+                                                    UWORD8 *pu1_ref_half_xy,
+                                                    WORD32 src_strd,
+                                                    WORD32 ref_strd,
+                                                    WORD32 *pi4_sad)
+{
+    __m256i sad_x_4x64b = _mm256_setzero_si256();
+    __m256i sad_y_4x64b = _mm256_setzero_si256();
+    __m256i sad_xy_4x64b = _mm256_setzero_si256();
+    __m256i sad_xy_top_4x64b = _mm256_setzero_si256();
+    __m128i half_y_prev_16x8b, half_xy_prev_16x8b, half_xy_left_prev_16x8b;
+    WORD32 i;
+
+    /* the rows above the first row, used by the top points */
+    half_y_prev_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref_half_y - ref_strd));
+    half_xy_prev_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref_half_xy - ref_strd));
+    half_xy_left_prev_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref_half_xy - ref_strd - 1));
+
+    for(i = 0; i < 16; i++)
+    {
+        __m256i src_32x8b = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)pu1_src));
+        __m128i half_y_16x8b = _mm_loadu_si128((__m128i *)pu1_ref_half_y);
+        __m128i half_xy_16x8b = _mm_loadu_si128((__m128i *)pu1_ref_half_xy);
+        __m128i half_xy_left_16x8b = _mm_loadu_si128((__m128i *)(pu1_ref_half_xy - 1));
+        __m256i ref_32x8b;
+
+        /* half x and half x - 1 */
+        ref_32x8b = ime_load_row_pair_avx2(pu1_ref_half_x, pu1_ref_half_x - 1);
+        sad_x_4x64b = _mm256_add_epi64(sad_x_4x64b, _mm256_sad_epu8(src_32x8b, ref_32x8b));
+
+        /* half y and half y - strd */
+        ref_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(half_y_16x8b),
+                                            half_y_prev_16x8b, 1);
+        sad_y_4x64b = _mm256_add_epi64(sad_y_4x64b, _mm256_sad_epu8(src_32x8b, ref_32x8b));
+
+        /* half xy and half xy - 1 */
+        ref_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(half_xy_16x8b),
+                                            half_xy_left_16x8b, 1);
+        sad_xy_4x64b = _mm256_add_epi64(sad_xy_4x64b, _mm256_sad_epu8(src_32x8b, ref_32x8b));
+
+        /* half xy - strd and half xy - 1 - strd */
+        ref_32x8b = _mm256_inserti128_si256(_mm256_castsi128_si256(half_xy_prev_16x8b),
+                                            half_xy_left_prev_16x8b, 1);
+        sad_xy_top_4x64b = _mm256_add_epi64(sad_xy_top_4x64b, _mm256_sad_epu8(src_32x8b, ref_32x8b));
+
+        half_y_prev_16x8b = half_y_16x8b;
+        half_xy_prev_16x8b = half_xy_16x8b;
+        half_xy_left_prev_16x8b = half_xy_left_16x8b;
+
+        pu1_src += src_strd;
+        pu1_ref_half_x += ref_strd;
+        pu1_ref_half_y += ref_strd;
+        pu1_ref_half_xy += ref_strd;
+    }
+
+    ime_sum_sad_lanes_avx2(sad_x_4x64b, &pi4_sad[0], &pi4_sad[1]);
+    ime_sum_sad_lanes_avx2(sad_y_4x64b, &pi4_sad[2], &pi4_sad[3]);
+    ime_sum_sad_lanes_avx2(sad_xy_4x64b, &pi4_sad[4], &pi4_sad[5]);
+    ime_sum_sad_lanes_avx2(sad_xy_top_4x64b, &pi4_sad[6], &pi4_sad[7]);
+}
+
+/**
+******************************************************************************
+*
+* @brief This function computes SAD between two 16x16 blocks
+*        It also computes if the block will be zero after H264 transform and quant for
+*        Intra 16x16 blocks
+*
+* @par Description
+*   The partial sums s1 to s4 of all the sixteen 4x4 blocks are gathered into
+*   one vector each, with a 4x4 block per word, so that the thresholds are
+*   checked for all the blocks together. A block is non zero if any of its
+*   checks fail, so the result matches the block by block evaluation.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] pu2_thrsh
+*  Threshold for each element of transofrmed quantized block
+*
+* @param[out] pi4_mb_distortion
+*  integer evaluated sad
+*
+* @param[out] pu4_is_non_zero
+*  Poitner to store if the block is non zero after transform and quantization
+*
+* @remarks
+*
+******************************************************************************
+*/
+AVX2_TARGET void ime_compute_satqd_16x16_lumainter_avx2(UWORD8 *pu1_src,
+                                                        UWORD8 *pu1_est,
+                                                        WORD32 src_strd,
+                                                        WORD32 est_strd,
+                                                        UWORD16 *pu2_thrsh,
+                                                        WORD32 *pi4_mb_distortion,
+                                                        UWORD32 *pu4_is_non_zero)
+{
+    /* orders the columns of each 4x4 block as 0, 3, 1, 2 */
+    __m256i col_order_32x8b = _mm256_setr_epi8(0, 1, 6, 7, 2, 3, 4, 5,
+                                               8, 9, 14, 15, 10, 11, 12, 13,
+                                               0, 1, 6, 7, 2, 3, 4, 5,
+                                               8, 9, 14, 15, 10, 11, 12, 13);
+    __m256i lo_word_8x32b = _mm256_set1_epi32(0xffff);
+    __m256i outer_16x16b[2], inner_16x16b[2];
+    __m256i s1, s2, s3, s4, sad, sad_x2, ls, flag;
+    WORD32 i;
+
+    for(i = 0; i < 4; i++)
+    {
+        __m256i diff_16x16b[4];
+        __m256i outer, inner;
+        WORD32 j;
+
+        for(j = 0; j < 4; j++)
+        {
+            __m256i src_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_src + j * src_strd)));
+            __m256i est_16x16b = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_est + j * est_strd)));
+
+            diff_16x16b[j] = _mm256_abs_epi16(_mm256_sub_epi16(src_16x16b, est_16x16b));
+        }
+
+        /* rows 0 and 3 give s1 and s4, rows 1 and 2 give s2 and s3 */
+        outer = _mm256_add_epi16(diff_16x16b[0], diff_16x16b[3]);
+        inner = _mm256_add_epi16(diff_16x16b[1], diff_16x16b[2]);
+        outer = _mm256_shuffle_epi8(outer, col_order_32x8b);
+        inner = _mm256_shuffle_epi8(inner, col_order_32x8b);
+
+        /* pairs of rows of blocks are combined: s1 (or s2) in the low */
+        /* word and s4 (or s3) in the high word of each dword          */
+        if(i & 1)
+        {
+            outer_16x16b[i >> 1] = _mm256_hadd_epi16(outer_16x16b[i >> 1], outer);
+            inner_16x16b[i >> 1] = _mm256_hadd_epi16(inner_16x16b[i >> 1], inner);
+        }
+        else
+        {
+            outer_16x16b[i >> 1] = outer;
+            inner_16x16b[i >> 1] = inner;
+        }
+
+        pu1_src += 4 * src_strd;
+        pu1_est += 4 * est_strd;
+    }
+
+    /* one 4x4 block per word */
+    s1 = _mm256_packus_epi32(_mm256_and_si256(outer_16x16b[0], lo_word_8x32b),
+                             _mm256_and_si256(outer_16x16b[1], lo_word_8x32b));
+    s4 = _mm256_packus_epi32(_mm256_srli_epi32(outer_16x16b[0], 16),
+                             _mm256_srli_epi32(outer_16x16b[1], 16));
+    s2 = _mm256_packus_epi32(_mm256_and_si256(inner_16x16b[0], lo_word_8x32b),
+                             _mm256_and_si256(inner_16x16b[1], lo_word_8x32b));
+    s3 = _mm256_packus_epi32(_mm256_srli_epi32(inner_16x16b[0], 16),
+                             _mm256_srli_epi32(inner_16x16b[1], 16));
+
+    sad = _mm256_add_epi16(_mm256_add_epi16(s1, s2), _mm256_add_epi16(s3, s4));
+    {
+        __m256i sad_8x32b = _mm256_madd_epi16(sad, _mm256_set1_epi16(1));
+        __m128i sad_4x32b = _mm_add_epi32(_mm256_castsi256_si128(sad_8x32b),
+                                          _mm256_extracti128_si256(sad_8x32b, 1));
+
+        sad_4x32b = _mm_hadd_epi32(sad_4x32b, sad_4x32b);
+        sad_4x32b = _mm_hadd_epi32(sad_4x32b, sad_4x32b);
+        *pi4_mb_distortion = _mm_cvtsi128_si32(sad_4x32b);
+    }
+
+    /* pu2_thrsh[k] <= ls, all the ls values being non negative */
+#define IME_SATQD_CHECK_AVX2(ls, k)                                                     \
+    flag = _mm256_or_si256(flag,                                                        \
+                           _mm256_cmpeq_epi16(_mm256_max_epu16(ls,                      \
+                                                               _mm256_set1_epi16(pu2_thrsh[k])), \
+                                              ls));
+
+    sad_x2 = _mm256_slli_epi16(sad, 1);
+    flag = _mm256_setzero_si256();
+    IME_SATQD_CHECK_AVX2(sad, 8);
+    ls = _mm256_sub_epi16(sad_x2, _mm256_add_epi16(s1, s4));
+    IME_SATQD_CHECK_AVX2(ls, 0);
+    ls = _mm256_sub_epi16(sad_x2, _mm256_add_epi16(s2, s3));
+    IME_SATQD_CHECK_AVX2(ls, 1);
+    ls = _mm256_add_epi16(_mm256_sub_epi16(sad_x2, s1), _mm256_slli_epi16(s3, 1));
+    IME_SATQD_CHECK_AVX2(ls, 2);
+    ls = _mm256_add_epi16(_mm256_sub_epi16(sad_x2, s4), _mm256_slli_epi16(s2, 1));
+    IME_SATQD_CHECK_AVX2(ls, 3);
+    ls = _mm256_sub_epi16(sad_x2, _mm256_add_epi16(s1, s2));
+    IME_SATQD_CHECK_AVX2(ls, 4);
+    ls = _mm256_sub_epi16(sad_x2, _mm256_add_epi16(s3, s4));
+    IME_SATQD_CHECK_AVX2(ls, 5);
+    ls = _mm256_add_epi16(_mm256_sub_epi16(sad_x2, s2), _mm256_slli_epi16(s4, 1));
+    IME_SATQD_CHECK_AVX2(ls, 6);
+    ls = _mm256_add_epi16(_mm256_sub_epi16(sad_x2, s3), _mm256_slli_epi16(s1, 1));
+    IME_SATQD_CHECK_AVX2(ls, 7);
+
+#undef IME_SATQD_CHECK_AVX2
+
+    *pu4_is_non_zero = !_mm256_testz_si256(flag, flag);
+}
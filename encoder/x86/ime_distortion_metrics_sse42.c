@@ -32,8 +32,11 @@
 * @par List of Functions:
 *  - ime_compute_sad_16x16_sse42()
 *  - ime_compute_sad_16x16_fast_sse42()
+*  - ime_compute_sad_16x16_batch_sse42()
+*  - ime_compute_sad_16x16_fast_batch_sse42()
 *  - ime_compute_sad_16x16_ea8_sse42()
 *  - ime_compute_sad_16x8_sse42()
+*  - ime_compute_sad_8x8_sse42()
 *  - ime_calculate_sad4_prog_sse42()
 *  - ime_sub_pel_compute_sad_16x16_sse42()
 *  - ime_compute_satqd_16x16_lumainter_sse42()
@@ -306,6 +309,85 @@ void ime_compute_sad_16x8_sse42(UWORD8 *pu1_src,
     return;
 }
 
+/**
+******************************************************************************
+*
+*  @brief computes distortion (SAD) between 2 8x8  blocks
+*
+*
+*  @par   Description
+*   This functions computes SAD between 2 8x8 blocks. Two rows are packed in
+*   to a register so that each psadbw covers 16 pixels. The whole block is
+*   always evaluated, u4_max_sad is ignored.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] u4_max_sad
+*  integer maximum allowed distortion
+*
+* @param[out] pi4_mb_distortion
+*  integer evaluated sad
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ime_compute_sad_8x8_sse42(UWORD8 *pu1_src,
+                    UWORD8 *pu1_est,
+                    WORD32 src_strd,
+                    WORD32 est_strd,
+                    WORD32 i4_max_sad,
+                    WORD32 *pi4_mb_distortion)
+{
+    __m128i src_r0, src_r1, src_r2, src_r3;
+    __m128i est_r0, est_r1, est_r2, est_r3;
+    __m128i sad_val;
+    WORD32 i;
+    int val1, val2;
+    UNUSED (i4_max_sad);
+
+    sad_val = _mm_setzero_si128();
+
+    for(i = 0; i < 2; i++)
+    {
+        src_r0 = _mm_loadl_epi64((__m128i *) (pu1_src));
+        src_r1 = _mm_loadl_epi64((__m128i *) (pu1_src + src_strd));
+        src_r2 = _mm_loadl_epi64((__m128i *) (pu1_src + 2*src_strd));
+        src_r3 = _mm_loadl_epi64((__m128i *) (pu1_src + 3*src_strd));
+
+        est_r0 = _mm_loadl_epi64((__m128i *) (pu1_est));
+        est_r1 = _mm_loadl_epi64((__m128i *) (pu1_est + est_strd));
+        est_r2 = _mm_loadl_epi64((__m128i *) (pu1_est + 2*est_strd));
+        est_r3 = _mm_loadl_epi64((__m128i *) (pu1_est + 3*est_strd));
+
+        src_r0 = _mm_unpacklo_epi64(src_r0, src_r1);
+        src_r2 = _mm_unpacklo_epi64(src_r2, src_r3);
+        est_r0 = _mm_unpacklo_epi64(est_r0, est_r1);
+        est_r2 = _mm_unpacklo_epi64(est_r2, est_r3);
+
+        sad_val = _mm_add_epi64(sad_val, _mm_sad_epu8(src_r0, est_r0));
+        sad_val = _mm_add_epi64(sad_val, _mm_sad_epu8(src_r2, est_r2));
+
+        pu1_src += 4*src_strd;
+        pu1_est += 4*est_strd;
+    }
+
+    val1 = _mm_extract_epi32(sad_val,0);
+    val2 = _mm_extract_epi32(sad_val, 2);
+    *pi4_mb_distortion = (val1+val2);
+    return;
+}
+
 /**
 ******************************************************************************
 *
@@ -565,6 +647,158 @@ void ime_compute_sad_16x16_fast_sse42(UWORD8 *pu1_src,
     return;
 }
 
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks
+*
+* @par   Description
+*   The candidates are processed in pairs so that every source row is loaded
+*   once for two candidates. The rows are taken row_step apart, a row_step of
+*   2 giving the sad of alternate rows.
+*
+******************************************************************************
+*/
+static void ime_compute_sad_16x16_batch_rows_sse42(UWORD8 *pu1_src,
+                                                   UWORD8 **ppu1_est,
+                                                   WORD32 src_strd,
+                                                   WORD32 est_strd,
+                                                   WORD32 i4_num_est,
+                                                   WORD32 row_step,
+                                                   WORD32 *pi4_sad)
+{
+    __m128i src_r0, src_r1, est0_r0, est0_r1, est1_r0, est1_r1;
+    __m128i sad_val0, sad_val1;
+    UWORD8 *pu1_src_row, *pu1_est0, *pu1_est1;
+    WORD32 i, j;
+
+    for(i = 0; i < i4_num_est; i += 2)
+    {
+        /* an odd last candidate is paired with itself */
+        pu1_est0 = ppu1_est[i];
+        pu1_est1 = (i + 1 < i4_num_est) ? ppu1_est[i + 1] : pu1_est0;
+        pu1_src_row = pu1_src;
+
+        sad_val0 = _mm_setzero_si128();
+        sad_val1 = _mm_setzero_si128();
+
+        for(j = 0; j < 16; j += 2 * row_step)
+        {
+            src_r0 = _mm_loadu_si128((__m128i *) (pu1_src_row));
+            src_r1 = _mm_loadu_si128((__m128i *) (pu1_src_row + row_step * src_strd));
+            est0_r0 = _mm_loadu_si128((__m128i *) (pu1_est0));
+            est0_r1 = _mm_loadu_si128((__m128i *) (pu1_est0 + row_step * est_strd));
+            est1_r0 = _mm_loadu_si128((__m128i *) (pu1_est1));
+            est1_r1 = _mm_loadu_si128((__m128i *) (pu1_est1 + row_step * est_strd));
+
+            sad_val0 = _mm_add_epi64(sad_val0, _mm_sad_epu8(src_r0, est0_r0));
+            sad_val1 = _mm_add_epi64(sad_val1, _mm_sad_epu8(src_r0, est1_r0));
+            sad_val0 = _mm_add_epi64(sad_val0, _mm_sad_epu8(src_r1, est0_r1));
+            sad_val1 = _mm_add_epi64(sad_val1, _mm_sad_epu8(src_r1, est1_r1));
+
+            pu1_src_row += 2 * row_step * src_strd;
+            pu1_est0 += 2 * row_step * est_strd;
+            pu1_est1 += 2 * row_step * est_strd;
+        }
+
+        pi4_sad[i] = _mm_extract_epi32(sad_val0, 0) + _mm_extract_epi32(sad_val0, 2);
+        if(i + 1 < i4_num_est)
+            pi4_sad[i + 1] = _mm_extract_epi32(sad_val1, 0) + _mm_extract_epi32(sad_val1, 2);
+    }
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks
+*
+* @par   Description
+*   This functions computes SAD between the source and each of the candidate
+*   16x16 blocks, two candidates at a time.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ime_compute_sad_16x16_batch_sse42(UWORD8 *pu1_src,
+                                       UWORD8 **ppu1_est,
+                                       WORD32 src_strd,
+                                       WORD32 est_strd,
+                                       WORD32 i4_num_est,
+                                       WORD32 *pi4_sad)
+{
+    ime_compute_sad_16x16_batch_rows_sse42(pu1_src, ppu1_est, src_strd, est_strd,
+                                           i4_num_est, 1, pi4_sad);
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between a 16x16 block and a list of
+* candidate blocks (fast mode)
+*
+* @par   Description
+*   Same as ime_compute_sad_16x16_batch_sse42() but processing alternate rows
+*   as in ime_compute_sad_16x16_fast_sse42().
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ppu1_est
+*  array of UWORD8 pointers to the candidates
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] est_strd
+*  integer candidate stride
+*
+* @param[in] i4_num_est
+*  number of candidates
+*
+* @param[out] pi4_sad
+*  sad of each candidate
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ime_compute_sad_16x16_fast_batch_sse42(UWORD8 *pu1_src,
+                                            UWORD8 **ppu1_est,
+                                            WORD32 src_strd,
+                                            WORD32 est_strd,
+                                            WORD32 i4_num_est,
+                                            WORD32 *pi4_sad)
+{
+    WORD32 i;
+
+    ime_compute_sad_16x16_batch_rows_sse42(pu1_src, ppu1_est, src_strd, est_strd,
+                                           i4_num_est, 2, pi4_sad);
+
+    for(i = 0; i < i4_num_est; i++)
+        pi4_sad[i] <<= 1;
+}
+
 /**
 *******************************************************************************
 *
@@ -0,0 +1,430 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : bitstrm_bench.c                                      */
+/*                                                                           */
+/*  Description       : Parse only benchmark of the decoder bit reader. A    */
+/*                      synthetic RBSP of Exp-Golomb codes and fixed length  */
+/*                      fields is read back through the CAVLC entry points   */
+/*                      and checked, and random data is decoded as CABAC     */
+/*                      regular and bypass bins                              */
+/*                                                                           */
+/*  Usage             : bitstrm_bench [iterations]                           */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_error.h"
+#include "ih264d_structs.h"
+#include "ih264d_bitstrm.h"
+#include "ih264d_cabac.h"
+#include "ih264d_parse_cavlc.h"
+#include "ih264d_tables.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+#define DEFAULT_NUM_ITERS   50
+#define NUM_SYMS            (1 << 18)
+#define NUM_CABAC_WORDS     (1 << 16)
+#define NUM_BENCH_CTXTS     16
+
+/* Words written past the end of the RBSP, the reader may look ahead */
+#define BUF_PAD_WORDS       4
+
+/*****************************************************************************/
+/* Enums                                                                     */
+/*****************************************************************************/
+typedef enum
+{
+    SYM_UEV,
+    SYM_SEV,
+    SYM_FLC,
+    SYM_BIT,
+}SYM_TYPE_T;
+
+/*****************************************************************************/
+/* Structures                                                                */
+/*****************************************************************************/
+typedef struct
+{
+    UWORD8 u1_type;
+    UWORD8 u1_num_bits;
+    WORD32 i4_value;
+}bench_sym_t;
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : put_bits                                                 */
+/*                                                                           */
+/*  Description   : Writes the u4_num_bits lsbs of u4_code, msb first, the   */
+/*                  way ih264d_extract_nal_unit packs the RBSP in words      */
+/*                                                                           */
+/*  Inputs        : pu4_buf    : Word buffer, zeroed                         */
+/*                  pu4_ofst   : Bit offset, advanced                        */
+/*                  u4_code    : Bits to write                               */
+/*                  u4_num_bits: Number of bits, at most 32                  */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void put_bits(UWORD32 *pu4_buf,
+              UWORD32 *pu4_ofst,
+              UWORD32 u4_code,
+              UWORD32 u4_num_bits)
+{
+    UWORD32 i;
+
+    for(i = 0; i < u4_num_bits; i++)
+    {
+        UWORD32 u4_bit = (u4_code >> (u4_num_bits - 1 - i)) & 1;
+
+        pu4_buf[*pu4_ofst >> 5] |= u4_bit << (31 - (*pu4_ofst & 0x1F));
+        (*pu4_ofst)++;
+    }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : put_uev                                                  */
+/*                                                                           */
+/*  Description   : Writes u4_value as ue(v)                                 */
+/*                                                                           */
+/*  Inputs        : pu4_buf  : Word buffer, zeroed                           */
+/*                  pu4_ofst : Bit offset, advanced                          */
+/*                  u4_value : Value, below 1 << 31                          */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void put_uev(UWORD32 *pu4_buf, UWORD32 *pu4_ofst, UWORD32 u4_value)
+{
+    UWORD32 u4_code = u4_value + 1;
+    UWORD32 u4_len = 32 - __builtin_clz(u4_code);
+
+    *pu4_ofst += u4_len - 1;
+    put_bits(pu4_buf, pu4_ofst, u4_code, u4_len);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : make_syms                                                */
+/*                                                                           */
+/*  Description   : Draws the syntax elements and writes them. Exp-Golomb    */
+/*                  values are mostly small, as in slice data, with the odd  */
+/*                  long code                                                */
+/*                                                                           */
+/*  Inputs        : ps_syms  : Syntax elements                               */
+/*                  pu4_buf  : Word buffer, zeroed                           */
+/*  Returns       : Number of bits written                                   */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 make_syms(bench_sym_t *ps_syms, UWORD32 *pu4_buf)
+{
+    UWORD32 u4_ofst = 0;
+    WORD32 i;
+
+    for(i = 0; i < NUM_SYMS; i++)
+    {
+        bench_sym_t *ps_sym = &ps_syms[i];
+        UWORD32 u4_range = (0 == (rand() & 63)) ? 20 : (rand() % 8);
+        UWORD32 u4_mag = rand() & ((1 << u4_range) - 1);
+
+        ps_sym->u1_type = rand() & 3;
+        switch(ps_sym->u1_type)
+        {
+            case SYM_UEV:
+                ps_sym->i4_value = u4_mag;
+                put_uev(pu4_buf, &u4_ofst, u4_mag);
+                break;
+
+            case SYM_SEV:
+                ps_sym->i4_value = (rand() & 1) ? -(WORD32)u4_mag : (WORD32)u4_mag;
+                put_uev(pu4_buf, &u4_ofst,
+                        (ps_sym->i4_value > 0) ? (2 * ps_sym->i4_value - 1) :
+                                        (UWORD32)(-2 * ps_sym->i4_value));
+                break;
+
+            case SYM_FLC:
+                ps_sym->u1_num_bits = 1 + (rand() % 16);
+                ps_sym->i4_value = rand() & ((1 << ps_sym->u1_num_bits) - 1);
+                put_bits(pu4_buf, &u4_ofst, ps_sym->i4_value, ps_sym->u1_num_bits);
+                break;
+
+            default:
+                ps_sym->i4_value = rand() & 1;
+                put_bits(pu4_buf, &u4_ofst, ps_sym->i4_value, 1);
+                break;
+        }
+    }
+    return u4_ofst;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : parse_syms                                               */
+/*                                                                           */
+/*  Description   : Reads the syntax elements back                           */
+/*                                                                           */
+/*  Inputs        : ps_syms    : Syntax elements                             */
+/*                  ps_bitstrm : Bitstream at the first element              */
+/*  Returns       : Number of elements read back wrong                       */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 parse_syms(bench_sym_t *ps_syms, dec_bit_stream_t *ps_bitstrm)
+{
+    WORD32 i4_num_errs = 0;
+    WORD32 i4_value;
+    WORD32 i;
+
+    for(i = 0; i < NUM_SYMS; i++)
+    {
+        bench_sym_t *ps_sym = &ps_syms[i];
+
+        switch(ps_sym->u1_type)
+        {
+            case SYM_UEV:
+                i4_value = ih264d_uev(&ps_bitstrm->u4_ofst, ps_bitstrm->pu4_buffer);
+                break;
+
+            case SYM_SEV:
+                i4_value = ih264d_sev(&ps_bitstrm->u4_ofst, ps_bitstrm->pu4_buffer);
+                break;
+
+            case SYM_FLC:
+                i4_value = ih264d_get_bits_h264(ps_bitstrm, ps_sym->u1_num_bits);
+                break;
+
+            default:
+                i4_value = ih264d_get_bit_h264(ps_bitstrm);
+                break;
+        }
+        i4_num_errs += (i4_value != ps_sym->i4_value);
+    }
+    return i4_num_errs;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : decode_cabac                                             */
+/*                                                                           */
+/*  Description   : Decodes regular bins over NUM_BENCH_CTXTS contexts, with */
+/*                  a run of bypass bins after every eighth, till the data   */
+/*                  runs out                                                 */
+/*                                                                           */
+/*  Inputs        : ps_bitstrm : Bitstream of random data                    */
+/*                  pu4_sum    : Sum of the decoded bins                     */
+/*  Returns       : Number of bins decoded                                   */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 decode_cabac(dec_bit_stream_t *ps_bitstrm, UWORD32 *pu4_sum)
+{
+    bin_ctxt_model_t as_ctxt[NUM_BENCH_CTXTS];
+    decoding_envirnoment_t s_cab_env;
+    UWORD32 u4_num_bins = 0;
+    UWORD32 u4_sum = 0;
+    UWORD32 i;
+
+    for(i = 0; i < NUM_BENCH_CTXTS; i++)
+    {
+        /* states spread over the range, alternate mps */
+        as_ctxt[i].u1_mps_state = ((i & 1) << 6) | (i * 4);
+    }
+
+    s_cab_env.cabac_table = gau4_ih264d_cabac_table;
+    ih264d_init_cabac_dec_envirnoment(&s_cab_env, ps_bitstrm);
+
+    /* a bin never takes more than 9 bits, 4 bypass bins take 4 */
+    for(i = 0; ps_bitstrm->u4_ofst + 64 < ps_bitstrm->u4_max_ofst; i++)
+    {
+        u4_sum += ih264d_decode_bin(i & (NUM_BENCH_CTXTS - 1), as_ctxt,
+                                    ps_bitstrm, &s_cab_env);
+        u4_num_bins++;
+
+        if(7 == (i & 7))
+        {
+            u4_sum += ih264d_decode_bypass_bins(&s_cab_env, 4, ps_bitstrm);
+            u4_num_bins += 4;
+        }
+    }
+
+    *pu4_sum = u4_sum;
+    return u4_num_bins;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : decode_bypass                                            */
+/*                                                                           */
+/*  Description   : Decodes bypass bins the way an mvd suffix is read, an    */
+/*                  Exp-Golomb code of order 3, till the data runs out       */
+/*                                                                           */
+/*  Inputs        : ps_bitstrm : Bitstream of random data                    */
+/*                  pu4_sum    : Sum of the decoded values                   */
+/*  Returns       : Number of bins decoded                                   */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 decode_bypass(dec_bit_stream_t *ps_bitstrm, UWORD32 *pu4_sum)
+{
+    decoding_envirnoment_t s_cab_env;
+    UWORD32 u4_num_bins = 0;
+    UWORD32 u4_sum = 0;
+    UWORD32 k;
+
+    s_cab_env.cabac_table = gau4_ih264d_cabac_table;
+    ih264d_init_cabac_dec_envirnoment(&s_cab_env, ps_bitstrm);
+
+    /* a code of random data takes a few tens of bits at most */
+    while(ps_bitstrm->u4_ofst + 128 < ps_bitstrm->u4_max_ofst)
+    {
+        k = ih264d_decode_bypass_bins_unary(&s_cab_env, ps_bitstrm);
+        u4_sum += k;
+        u4_sum += ih264d_decode_bypass_bins(&s_cab_env, k + 3, ps_bitstrm);
+        u4_num_bins += 2 * k + 4;
+    }
+
+    *pu4_sum = u4_sum;
+    return u4_num_bins;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : print_row                                                */
+/*                                                                           */
+/*  Description   : Prints the throughput of one run                         */
+/*                                                                           */
+/*  Inputs        : pc_name    : Name of the run                             */
+/*                  num_ops    : Codes or bins decoded                       */
+/*                  s_start    : Start time                                  */
+/*                  s_end      : End time                                    */
+/*                  pc_check   : Result of the check                         */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void print_row(const CHAR *pc_name,
+               double num_ops,
+               struct timeval s_start,
+               struct timeval s_end,
+               const CHAR *pc_check)
+{
+    double elapsed_us = (s_end.tv_sec - s_start.tv_sec) * 1000000.0
+                    + (s_end.tv_usec - s_start.tv_usec);
+
+    printf("%-12s  %12.0f  %10.2f  %8.2f  %s\n", pc_name, num_ops,
+           num_ops / elapsed_us, elapsed_us * 1000.0 / num_ops, pc_check);
+}
+
+int main(int argc, char *argv[])
+{
+    WORD32 i4_num_iters = DEFAULT_NUM_ITERS;
+    UWORD32 u4_sym_bits, u4_sum = 0, u4_ref_sum = 0;
+    WORD32 i4_num_errs = 0, i4_sum_errs = 0;
+    struct timeval s_start, s_end;
+    dec_bit_stream_t s_bitstrm;
+    bench_sym_t *ps_syms;
+    UWORD32 *pu4_sym_buf, *pu4_cabac_buf;
+    double num_ops;
+    WORD32 i;
+
+    if(argc > 1)
+        i4_num_iters = atoi(argv[1]);
+    if((i4_num_iters <= 0) || (i4_num_iters > DEFAULT_NUM_ITERS * 1000))
+        i4_num_iters = DEFAULT_NUM_ITERS;
+
+    ps_syms = malloc(NUM_SYMS * sizeof(bench_sym_t));
+    pu4_sym_buf = calloc(NUM_SYMS * 2 + BUF_PAD_WORDS, sizeof(UWORD32));
+    pu4_cabac_buf = calloc(NUM_CABAC_WORDS + BUF_PAD_WORDS, sizeof(UWORD32));
+    if((NULL == ps_syms) || (NULL == pu4_sym_buf) || (NULL == pu4_cabac_buf))
+        return -1;
+
+    srand(1);
+    u4_sym_bits = make_syms(ps_syms, pu4_sym_buf);
+    for(i = 0; i < NUM_CABAC_WORDS; i++)
+        pu4_cabac_buf[i] = ((UWORD32)rand() << 16) ^ rand();
+
+    memset(&s_bitstrm, 0, sizeof(dec_bit_stream_t));
+
+    printf("syntax                 codes  Mcodes/sec   ns/code  check\n");
+
+    /* CAVLC */
+    gettimeofday(&s_start, NULL);
+    for(i = 0; i < i4_num_iters; i++)
+    {
+        s_bitstrm.pu4_buffer = pu4_sym_buf;
+        s_bitstrm.u4_ofst = 0;
+        s_bitstrm.u4_max_ofst = u4_sym_bits;
+        i4_num_errs += parse_syms(ps_syms, &s_bitstrm);
+        i4_num_errs += (s_bitstrm.u4_ofst != u4_sym_bits);
+    }
+    gettimeofday(&s_end, NULL);
+    num_ops = (double)NUM_SYMS * i4_num_iters;
+    print_row("cavlc", num_ops, s_start, s_end, i4_num_errs ? "MISMATCH" : "OK");
+
+    /* CABAC, every iteration decodes the same bins */
+    num_ops = 0;
+    gettimeofday(&s_start, NULL);
+    for(i = 0; i < i4_num_iters; i++)
+    {
+        s_bitstrm.pu4_buffer = pu4_cabac_buf;
+        s_bitstrm.u4_ofst = 0;
+        s_bitstrm.u4_max_ofst = NUM_CABAC_WORDS * 32;
+        num_ops += decode_cabac(&s_bitstrm, &u4_sum);
+        if(0 == i)
+            u4_ref_sum = u4_sum;
+        i4_sum_errs += (u4_sum != u4_ref_sum);
+    }
+    gettimeofday(&s_end, NULL);
+    print_row("cabac", num_ops, s_start, s_end, i4_sum_errs ? "MISMATCH" : "OK");
+    printf("cabac bins %u, sum %u\n", (UWORD32)(num_ops / i4_num_iters), u4_ref_sum);
+
+    /* Bypass bins only */
+    num_ops = 0;
+    gettimeofday(&s_start, NULL);
+    for(i = 0; i < i4_num_iters; i++)
+    {
+        s_bitstrm.pu4_buffer = pu4_cabac_buf;
+        s_bitstrm.u4_ofst = 0;
+        s_bitstrm.u4_max_ofst = NUM_CABAC_WORDS * 32;
+        num_ops += decode_bypass(&s_bitstrm, &u4_sum);
+        if(0 == i)
+            u4_ref_sum = u4_sum;
+        i4_sum_errs += (u4_sum != u4_ref_sum);
+    }
+    gettimeofday(&s_end, NULL);
+    print_row("bypass", num_ops, s_start, s_end, i4_sum_errs ? "MISMATCH" : "OK");
+    printf("bypass bins %u, sum %u\n", (UWORD32)(num_ops / i4_num_iters), u4_ref_sum);
+
+    free(ps_syms);
+    free(pu4_sym_buf);
+    free(pu4_cabac_buf);
+
+    return (i4_num_errs || i4_sum_errs) ? -1 : 0;
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : dec_kernel_bench.c                                   */
+/*                                                                           */
+/*  Description       : Benchmarks the leaf kernels of the decoder function  */
+/*                      pointer slots at every instruction set level the cpu */
+/*                      supports, and checks them against the generic ones   */
+/*                                                                           */
+/*  Usage             : dec_kernel_bench [iterations] [slot name filter]     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_error.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264d_structs.h"
+#include "ih264d_function_selector.h"
+#include "kernel_bench.h"
+
+/*****************************************************************************/
+/* Function Macros                                                           */
+/*****************************************************************************/
+#define DEC_SLOT(slot, call, arg)                                             \
+    { #slot, offsetof(dec_struct_t, slot), call, arg }
+
+/*****************************************************************************/
+/* Call wrappers for the decoder only kernel signatures                      */
+/*****************************************************************************/
+
+/* i4_arg is the number of bytes searched */
+static void bench_find_nal_escape(bench_fxn_t *pf_kernel,
+                                  bench_bufs_t *ps_bufs,
+                                  WORD32 i4_arg)
+{
+    ps_bufs->ps_out->ai4_out[0] =
+                    ((ih264d_find_nal_escape_ft *)pf_kernel)(ps_bufs->pu1_src, 0, i4_arg);
+}
+
+/*****************************************************************************/
+/* Global Variables                                                          */
+/*****************************************************************************/
+
+/** Leaf kernel slots. apf_inter_pred_luma is indexed by dydx, which is also
+ * passed to the kernel */
+static const bench_slot_t gas_dec_slots[] =
+{
+    DEC_SLOT(apf_intra_pred_luma_16x16[0], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_16x16[1], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_16x16[2], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_16x16[3], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[0], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[1], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[2], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[3], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[4], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[5], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[6], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[7], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_8x8[8], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[0], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[1], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[2], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[3], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[4], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[5], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[6], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[7], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_luma_4x4[8], bench_intra_pred, 0),
+    DEC_SLOT(pf_intra_pred_ref_filtering, bench_intra_pred_ref_filtering, 0),
+    DEC_SLOT(apf_intra_pred_chroma[0], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_chroma[1], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_chroma[2], bench_intra_pred, 0),
+    DEC_SLOT(apf_intra_pred_chroma[3], bench_intra_pred, 0),
+
+    DEC_SLOT(pf_default_weighted_pred_luma, bench_default_weighted_pred, 16),
+    DEC_SLOT(pf_default_weighted_pred_chroma, bench_default_weighted_pred, 8),
+    DEC_SLOT(pf_weighted_pred_luma, bench_weighted_pred_luma, 0),
+    DEC_SLOT(pf_weighted_pred_chroma, bench_weighted_pred_chroma, 0),
+    DEC_SLOT(pf_weighted_bi_pred_luma, bench_weighted_bi_pred_luma, 0),
+    DEC_SLOT(pf_weighted_bi_pred_chroma, bench_weighted_bi_pred_chroma, 0),
+
+    DEC_SLOT(pf_pad_top, bench_pad, 64),
+    DEC_SLOT(pf_pad_bottom, bench_pad, 64),
+    DEC_SLOT(pf_pad_left_luma, bench_pad, 16),
+    DEC_SLOT(pf_pad_left_chroma, bench_pad, 8),
+    DEC_SLOT(pf_pad_right_luma, bench_pad, 16),
+    DEC_SLOT(pf_pad_right_chroma, bench_pad, 8),
+
+    DEC_SLOT(pf_iquant_itrans_recon_luma_4x4, bench_iquant_itrans_recon, 4),
+    DEC_SLOT(pf_iquant_itrans_recon_luma_4x4_dc, bench_iquant_itrans_recon, 4),
+    DEC_SLOT(pf_iquant_itrans_recon_luma_8x8, bench_iquant_itrans_recon, 8),
+    DEC_SLOT(pf_iquant_itrans_recon_luma_8x8_dc, bench_iquant_itrans_recon, 8),
+    DEC_SLOT(pf_iquant_itrans_recon_chroma_4x4, bench_iquant_itrans_recon_chroma, 0),
+    DEC_SLOT(pf_iquant_itrans_recon_chroma_4x4_dc, bench_iquant_itrans_recon_chroma, 0),
+    DEC_SLOT(pf_ihadamard_scaling_4x4, bench_ihadamard_scaling, 0),
+
+    DEC_SLOT(pf_deblk_luma_vert_bs4, bench_deblk_bs4, 0),
+    DEC_SLOT(pf_deblk_luma_vert_bslt4, bench_deblk_bslt4, 0),
+    DEC_SLOT(pf_deblk_luma_vert_bs4_mbaff, bench_deblk_bs4, 0),
+    DEC_SLOT(pf_deblk_luma_vert_bslt4_mbaff, bench_deblk_bslt4, 0),
+    DEC_SLOT(pf_deblk_luma_horz_bs4, bench_deblk_bs4, 0),
+    DEC_SLOT(pf_deblk_luma_horz_bslt4, bench_deblk_bslt4, 0),
+    DEC_SLOT(pf_deblk_chroma_vert_bs4, bench_deblk_chroma_bs4, 0),
+    DEC_SLOT(pf_deblk_chroma_vert_bslt4, bench_deblk_chroma_bslt4, 0),
+    DEC_SLOT(pf_deblk_chroma_vert_bs4_mbaff, bench_deblk_chroma_bs4, 0),
+    DEC_SLOT(pf_deblk_chroma_vert_bslt4_mbaff, bench_deblk_chroma_bslt4, 0),
+    DEC_SLOT(pf_deblk_chroma_horz_bs4, bench_deblk_chroma_bs4, 0),
+    DEC_SLOT(pf_deblk_chroma_horz_bslt4, bench_deblk_chroma_bslt4, 0),
+
+    DEC_SLOT(apf_inter_pred_luma[0], bench_inter_pred_luma, 0),
+    DEC_SLOT(apf_inter_pred_luma[1], bench_inter_pred_luma, 1),
+    DEC_SLOT(apf_inter_pred_luma[2], bench_inter_pred_luma, 2),
+    DEC_SLOT(apf_inter_pred_luma[3], bench_inter_pred_luma, 3),
+    DEC_SLOT(apf_inter_pred_luma[4], bench_inter_pred_luma, 4),
+    DEC_SLOT(apf_inter_pred_luma[5], bench_inter_pred_luma, 5),
+    DEC_SLOT(apf_inter_pred_luma[6], bench_inter_pred_luma, 6),
+    DEC_SLOT(apf_inter_pred_luma[7], bench_inter_pred_luma, 7),
+    DEC_SLOT(apf_inter_pred_luma[8], bench_inter_pred_luma, 8),
+    DEC_SLOT(apf_inter_pred_luma[9], bench_inter_pred_luma, 9),
+    DEC_SLOT(apf_inter_pred_luma[10], bench_inter_pred_luma, 10),
+    DEC_SLOT(apf_inter_pred_luma[11], bench_inter_pred_luma, 11),
+    DEC_SLOT(apf_inter_pred_luma[12], bench_inter_pred_luma, 12),
+    DEC_SLOT(apf_inter_pred_luma[13], bench_inter_pred_luma, 13),
+    DEC_SLOT(apf_inter_pred_luma[14], bench_inter_pred_luma, 14),
+    DEC_SLOT(apf_inter_pred_luma[15], bench_inter_pred_luma, 15),
+    DEC_SLOT(pf_inter_pred_chroma, bench_inter_pred_chroma, 0),
+
+    DEC_SLOT(pf_find_nal_escape, bench_find_nal_escape, 16 * BENCH_BUF_STRD),
+};
+
+/** Instruction set levels, each adding to the kernels of the previous one */
+static const struct
+{
+    IVD_ARCH_T e_arch;
+    const CHAR *pc_name;
+}gas_dec_archs[] =
+{
+#if defined(X86)
+    { ARCH_X86_GENERIC, "generic" },
+    { ARCH_X86_SSSE3, "ssse3" },
+    { ARCH_X86_SSE42, "sse42" },
+    { ARCH_X86_AVX2, "avx2" },
+#elif defined(ARMV8)
+    { ARCH_ARM_NONEON, "generic" },
+    { ARCH_ARMV8_GENERIC, "neon" },
+#elif defined(ARM)
+    { ARCH_ARM_NONEON, "generic" },
+    { ARCH_ARM_A9Q, "neon" },
+#else
+    { ARCH_NA, "generic" },
+#endif
+};
+
+int main(int argc, char *argv[])
+{
+    bench_level_t as_levels[BENCH_MAX_LEVELS];
+    WORD32 i4_num_levels = 0;
+    WORD32 ret;
+    WORD32 i;
+
+    for(i = 0; i < (WORD32)(sizeof(gas_dec_archs) / sizeof(gas_dec_archs[0])); i++)
+    {
+        dec_struct_t *ps_dec = calloc(1, sizeof(dec_struct_t));
+
+        if(NULL == ps_dec)
+            break;
+
+        /* the selector raises or lowers levels the cpu lacks, which are then
+         * dropped */
+        ps_dec->e_processor_arch = gas_dec_archs[i].e_arch;
+        ih264d_init_function_ptr(ps_dec);
+        if(ps_dec->e_processor_arch != gas_dec_archs[i].e_arch)
+        {
+            free(ps_dec);
+            break;
+        }
+
+        as_levels[i4_num_levels].pc_name = gas_dec_archs[i].pc_name;
+        as_levels[i4_num_levels].pv_ctxt = ps_dec;
+        i4_num_levels++;
+    }
+
+    if(0 == i4_num_levels)
+        return -1;
+
+    ret = bench_main(as_levels, i4_num_levels, gas_dec_slots,
+                     sizeof(gas_dec_slots) / sizeof(gas_dec_slots[0]), argc,
+                     argv);
+
+    for(i = 0; i < i4_num_levels; i++)
+    {
+        free(as_levels[i].pv_ctxt);
+    }
+
+    return ret;
+}
@@ -0,0 +1,428 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : enc_kernel_bench.c                                   */
+/*                                                                           */
+/*  Description       : Benchmarks the leaf kernels of the encoder function  */
+/*                      pointer slots at every instruction set level the cpu */
+/*                      supports, and checks them against the generic ones   */
+/*                                                                           */
+/*  Usage             : enc_kernel_bench [iterations] [slot name filter]     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_platform_macros.h"
+#include "ih264e_intra_modes_eval.h"
+#include "ih264e_fmt_conv.h"
+#include "ih264e_half_pel.h"
+#include "kernel_bench.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+#define NUM_SAD_BATCH           6
+
+/** Left, top left and top neighbours available */
+#define BENCH_N_AVBLTY          0x07
+
+/*****************************************************************************/
+/* Function Macros                                                           */
+/*****************************************************************************/
+#define CODEC_SLOT(slot, call, arg)                                           \
+    { #slot, offsetof(codec_t, slot), call, arg }
+
+#define ME_SLOT(slot, call, arg)                                              \
+    { #slot, offsetof(codec_t, as_process[0].s_me_ctxt.slot), call, arg }
+
+/*****************************************************************************/
+/* Call wrappers for the encoder only kernel signatures                      */
+/*****************************************************************************/
+
+static void bench_ime_sad(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    /* largest max sad, so that the fast kernels do not exit early */
+    ((ime_compute_sad_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_ref,
+                                      BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                      0x7FFFFFFF, ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sad_batch(bench_fxn_t *pf_kernel,
+                                bench_bufs_t *ps_bufs,
+                                WORD32 i4_arg)
+{
+    UWORD8 *apu1_est[NUM_SAD_BATCH];
+    WORD32 i;
+    UNUSED(i4_arg);
+
+    for(i = 0; i < NUM_SAD_BATCH; i++)
+    {
+        apu1_est[i] = ps_bufs->pu1_ref + (i - 3) * BENCH_BUF_STRD + 2 * i - 5;
+    }
+    ((ime_compute_sad_batch_ft *)pf_kernel)(ps_bufs->pu1_src, apu1_est,
+                                            BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                            NUM_SAD_BATCH,
+                                            ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sad4_diamond(bench_fxn_t *pf_kernel,
+                                   bench_bufs_t *ps_bufs,
+                                   WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ime_compute_sad4_diamond *)pf_kernel)(ps_bufs->pu1_ref, ps_bufs->pu1_src,
+                                            BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                            ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sad3_diamond(bench_fxn_t *pf_kernel,
+                                   bench_bufs_t *ps_bufs,
+                                   WORD32 i4_arg)
+{
+    UWORD8 *pu1_ref = ps_bufs->pu1_ref;
+    UNUSED(i4_arg);
+
+    ((ime_compute_sad3_diamond *)pf_kernel)(pu1_ref - 1, pu1_ref + 1,
+                                            pu1_ref - BENCH_BUF_STRD,
+                                            ps_bufs->pu1_src, BENCH_BUF_STRD,
+                                            BENCH_BUF_STRD,
+                                            ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sad2_diamond(bench_fxn_t *pf_kernel,
+                                   bench_bufs_t *ps_bufs,
+                                   WORD32 i4_arg)
+{
+    UWORD8 *pu1_ref = ps_bufs->pu1_ref;
+    UNUSED(i4_arg);
+
+    ((ime_compute_sad2_diamond *)pf_kernel)(pu1_ref - 1, pu1_ref + 1,
+                                            ps_bufs->pu1_src, BENCH_BUF_STRD,
+                                            BENCH_BUF_STRD,
+                                            ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sub_pel_sad(bench_fxn_t *pf_kernel,
+                                  bench_bufs_t *ps_bufs,
+                                  WORD32 i4_arg)
+{
+    UWORD8 *pu1_ref = ps_bufs->pu1_ref;
+    UNUSED(i4_arg);
+
+    ((ime_sub_pel_compute_sad_16x16_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, pu1_ref, pu1_ref + 24,
+                    pu1_ref + 24 * BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_BUF_STRD, ps_bufs->ps_out->ai4_out);
+}
+
+static void bench_ime_sad_stat(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UWORD16 au2_thrsh[16];
+    WORD32 i;
+    UNUSED(i4_arg);
+
+    for(i = 0; i < 16; i++)
+    {
+        au2_thrsh[i] = 40 + 4 * i;
+    }
+    ((ime_compute_sad_stat *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_ref,
+                                        BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                        au2_thrsh, ps_bufs->ps_out->ai4_out,
+                                        (UWORD32 *)ps_bufs->ps_out->ai4_out + 1);
+}
+
+/* i4_arg is the mask of the modes to evaluate */
+static void bench_evaluate_intra_modes(bench_fxn_t *pf_kernel,
+                                       bench_bufs_t *ps_bufs,
+                                       WORD32 i4_arg)
+{
+    WORD32 *pi4_out = ps_bufs->ps_out->ai4_out;
+
+    ((ih264e_evaluate_intra_modes_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_N_AVBLTY,
+                    (UWORD32 *)pi4_out, pi4_out + 1, i4_arg);
+}
+
+static void bench_evaluate_intra_4x4_modes(bench_fxn_t *pf_kernel,
+                                           bench_bufs_t *ps_bufs,
+                                           WORD32 i4_arg)
+{
+    WORD32 *pi4_out = ps_bufs->ps_out->ai4_out;
+
+    ((ih264e_evaluate_intra_4x4_modes_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_N_AVBLTY | 0x08,
+                    (UWORD32 *)pi4_out, pi4_out + 1, i4_arg, 10, 2);
+}
+
+static void bench_sixtapfilter_horz(bench_fxn_t *pf_kernel,
+                                    bench_bufs_t *ps_bufs,
+                                    WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264e_sixtapfilter_horz_ft *)pf_kernel)(ps_bufs->pu1_src,
+                                               ps_bufs->pu1_dst,
+                                               BENCH_BUF_STRD, BENCH_BUF_STRD);
+}
+
+static void bench_sixtap_filter_2dvh_vert(bench_fxn_t *pf_kernel,
+                                          bench_bufs_t *ps_bufs,
+                                          WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264e_sixtap_filter_2dvh_vert_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                    ps_bufs->pu1_dst + 24 * BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_BUF_STRD, (WORD32 *)ps_bufs->pv_scratch + 3,
+                    BENCH_BUF_STRD);
+}
+
+static void bench_conv_420p_to_420sp(bench_fxn_t *pf_kernel,
+                                     bench_bufs_t *ps_bufs,
+                                     WORD32 i4_arg)
+{
+    UWORD8 *pu1_ref = ps_bufs->pu1_ref;
+    UNUSED(i4_arg);
+
+    ((ih264e_fmt_conv_420p_to_420sp_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, pu1_ref, pu1_ref + 40, ps_bufs->pu1_dst,
+                    ps_bufs->pu1_dst + 40 * BENCH_BUF_STRD, 32, 64,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, 0);
+}
+
+static void bench_fmt_conv_422i_to_420sp(bench_fxn_t *pf_kernel,
+                                         bench_bufs_t *ps_bufs,
+                                         WORD32 i4_arg)
+{
+    UWORD8 *pu1_uv = ps_bufs->pu1_dst + 40 * BENCH_BUF_STRD;
+    UNUSED(i4_arg);
+
+    /* the 422 interleaved stride is in pixels of two bytes */
+    ((ih264e_fmt_conv_422i_to_420sp_ft *)pf_kernel)(
+                    ps_bufs->pu1_dst, pu1_uv, pu1_uv + 1, ps_bufs->pu1_src,
+                    32, 16, BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_BUF_STRD / 2);
+}
+
+/*****************************************************************************/
+/* Global Variables                                                          */
+/*****************************************************************************/
+
+/** Leaf kernel slots. Slots of functions that call other slots, such as
+ * motion estimation or entropy coding, are left out */
+static const bench_slot_t gas_enc_slots[] =
+{
+    CODEC_SLOT(apf_intra_pred_16_l[0], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_16_l[1], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_16_l[2], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_16_l[3], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[0], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[1], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[2], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[3], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[4], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[5], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[6], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[7], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_8_l[8], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[0], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[1], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[2], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[3], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[4], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[5], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[6], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[7], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_4_l[8], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_c[0], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_c[1], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_c[2], bench_intra_pred, 0),
+    CODEC_SLOT(apf_intra_pred_c[3], bench_intra_pred, 0),
+
+    CODEC_SLOT(pf_resi_trans_quant_4x4, bench_resi_trans_quant, 4),
+    CODEC_SLOT(pf_resi_trans_quant_chroma_4x4, bench_resi_trans_quant, 4),
+    CODEC_SLOT(pf_resi_trans_quant_8x8, bench_resi_trans_quant, 8),
+    CODEC_SLOT(pf_hadamard_quant_4x4, bench_hadamard_quant, 0),
+    CODEC_SLOT(pf_hadamard_quant_2x2_uv, bench_hadamard_quant, 0),
+    CODEC_SLOT(pf_iquant_itrans_recon_4x4, bench_iquant_itrans_recon, 4),
+    CODEC_SLOT(pf_iquant_itrans_recon_4x4_dc, bench_iquant_itrans_recon, 4),
+    CODEC_SLOT(pf_iquant_itrans_recon_8x8, bench_iquant_itrans_recon, 8),
+    CODEC_SLOT(pf_iquant_itrans_recon_chroma_4x4, bench_iquant_itrans_recon_chroma, 0),
+    CODEC_SLOT(pf_iquant_itrans_recon_chroma_4x4_dc, bench_iquant_itrans_recon_chroma, 0),
+    CODEC_SLOT(pf_ihadamard_scaling_4x4, bench_ihadamard_scaling, 0),
+    CODEC_SLOT(pf_ihadamard_scaling_2x2_uv, bench_ihadamard_scaling, 0),
+    CODEC_SLOT(pf_interleave_copy, bench_interleave_copy, 0),
+
+    CODEC_SLOT(pf_deblk_luma_vert_bs4, bench_deblk_bs4, 0),
+    CODEC_SLOT(pf_deblk_luma_vert_bslt4, bench_deblk_bslt4, 0),
+    CODEC_SLOT(pf_deblk_luma_horz_bs4, bench_deblk_bs4, 0),
+    CODEC_SLOT(pf_deblk_luma_horz_bslt4, bench_deblk_bslt4, 0),
+    CODEC_SLOT(pf_deblk_chroma_vert_bs4, bench_deblk_chroma_bs4, 0),
+    CODEC_SLOT(pf_deblk_chroma_vert_bslt4, bench_deblk_chroma_bslt4, 0),
+    CODEC_SLOT(pf_deblk_chroma_horz_bs4, bench_deblk_chroma_bs4, 0),
+    CODEC_SLOT(pf_deblk_chroma_horz_bslt4, bench_deblk_chroma_bslt4, 0),
+
+    CODEC_SLOT(pf_pad_top, bench_pad, 64),
+    CODEC_SLOT(pf_pad_bottom, bench_pad, 64),
+    CODEC_SLOT(pf_pad_left_luma, bench_pad, 16),
+    CODEC_SLOT(pf_pad_left_chroma, bench_pad, 8),
+    CODEC_SLOT(pf_pad_right_luma, bench_pad, 16),
+    CODEC_SLOT(pf_pad_right_chroma, bench_pad, 8),
+
+    CODEC_SLOT(pf_inter_pred_luma_copy, bench_inter_pred_luma, 0),
+    CODEC_SLOT(pf_inter_pred_luma_horz, bench_inter_pred_luma, 0),
+    CODEC_SLOT(pf_inter_pred_luma_vert, bench_inter_pred_luma, 0),
+    CODEC_SLOT(pf_inter_pred_luma_bilinear, bench_inter_pred_luma_bilinear, 0),
+    CODEC_SLOT(pf_inter_pred_chroma, bench_inter_pred_chroma, 0),
+
+    CODEC_SLOT(apf_compute_sad_16x16[0], bench_ime_sad, 0),
+    CODEC_SLOT(apf_compute_sad_16x16[1], bench_ime_sad, 0),
+    CODEC_SLOT(pf_compute_sad_16x8, bench_ime_sad, 0),
+
+    CODEC_SLOT(pf_mem_cpy, bench_memcpy, 1000),
+    CODEC_SLOT(pf_mem_cpy_mul8, bench_memcpy, 1024),
+    CODEC_SLOT(pf_mem_set, bench_memset, 1000),
+    CODEC_SLOT(pf_mem_set_mul8, bench_memset, 1024),
+
+    ME_SLOT(pf_ime_compute_sad_16x16[0], bench_ime_sad, 0),
+    ME_SLOT(pf_ime_compute_sad_16x16[1], bench_ime_sad, 0),
+    ME_SLOT(pf_ime_compute_sad_16x16_batch[0], bench_ime_sad_batch, 0),
+    ME_SLOT(pf_ime_compute_sad_16x16_batch[1], bench_ime_sad_batch, 0),
+    ME_SLOT(pf_ime_compute_sad_16x8, bench_ime_sad, 0),
+    ME_SLOT(pf_ime_compute_sad_8x8, bench_ime_sad, 0),
+    ME_SLOT(pf_ime_compute_sad4_diamond, bench_ime_sad4_diamond, 0),
+    ME_SLOT(pf_ime_compute_sad3_diamond, bench_ime_sad3_diamond, 0),
+    ME_SLOT(pf_ime_compute_sad2_diamond, bench_ime_sad2_diamond, 0),
+    ME_SLOT(pf_ime_sub_pel_compute_sad_16x16, bench_ime_sub_pel_sad, 0),
+    ME_SLOT(pf_ime_compute_sad_stat_luma_16x16, bench_ime_sad_stat, 0),
+
+    CODEC_SLOT(pf_ih264e_evaluate_intra16x16_modes, bench_evaluate_intra_modes, 0xF),
+    CODEC_SLOT(pf_ih264e_evaluate_intra_chroma_modes, bench_evaluate_intra_modes, 0xF),
+    CODEC_SLOT(pf_ih264e_evaluate_intra_4x4_modes, bench_evaluate_intra_4x4_modes, 0x1FF),
+
+    CODEC_SLOT(pf_ih264e_sixtapfilter_horz, bench_sixtapfilter_horz, 0),
+    CODEC_SLOT(pf_ih264e_sixtap_filter_2dvh_vert, bench_sixtap_filter_2dvh_vert, 0),
+
+    CODEC_SLOT(pf_ih264e_conv_420p_to_420sp, bench_conv_420p_to_420sp, 0),
+    CODEC_SLOT(pf_ih264e_fmt_conv_422i_to_420sp, bench_fmt_conv_422i_to_420sp, 0),
+};
+
+/** Instruction set levels, each adding to the kernels of the previous one */
+static const struct
+{
+    IV_ARCH_T e_arch;
+    const CHAR *pc_name;
+}gas_enc_archs[] =
+{
+#if defined(X86)
+    { ARCH_X86_GENERIC, "generic" },
+    { ARCH_X86_SSSE3, "ssse3" },
+    { ARCH_X86_SSE42, "sse42" },
+    { ARCH_X86_AVX2, "avx2" },
+#elif defined(ARMV8)
+    { ARCH_ARM_NONEON, "generic" },
+    { ARCH_ARM_V8_NEON, "neon" },
+#elif defined(ARM)
+    { ARCH_ARM_NONEON, "generic" },
+    { ARCH_ARM_A9Q, "neon" },
+#else
+    { ARCH_NA, "generic" },
+#endif
+};
+
+int main(int argc, char *argv[])
+{
+    bench_level_t as_levels[BENCH_MAX_LEVELS];
+    WORD32 i4_num_levels = 0;
+    WORD32 ret;
+    WORD32 i;
+
+    for(i = 0; i < (WORD32)(sizeof(gas_enc_archs) / sizeof(gas_enc_archs[0])); i++)
+    {
+        codec_t *ps_codec = calloc(1, sizeof(codec_t));
+
+        if(NULL == ps_codec)
+            break;
+
+        /* the selector lowers levels the cpu lacks, which are then dropped */
+        ps_codec->s_cfg.e_arch = gas_enc_archs[i].e_arch;
+        ih264e_init_function_ptr(ps_codec);
+        if(ps_codec->s_cfg.e_arch != gas_enc_archs[i].e_arch)
+        {
+            free(ps_codec);
+            break;
+        }
+
+        as_levels[i4_num_levels].pc_name = gas_enc_archs[i].pc_name;
+        as_levels[i4_num_levels].pv_ctxt = ps_codec;
+        i4_num_levels++;
+    }
+
+    if(0 == i4_num_levels)
+        return -1;
+
+    ret = bench_main(as_levels, i4_num_levels, gas_enc_slots,
+                     sizeof(gas_enc_slots) / sizeof(gas_enc_slots[0]), argc,
+                     argv);
+
+    for(i = 0; i < i4_num_levels; i++)
+    {
+        free(as_levels[i].pv_ctxt);
+    }
+
+    return ret;
+}
@@ -0,0 +1,685 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : kernel_bench.c                                       */
+/*                                                                           */
+/*  Description       : Harness shared by the encoder and decoder kernel     */
+/*                      benchmarks. Every slot is run once per instruction   */
+/*                      set level that installs a new kernel in it. The      */
+/*                      output of each kernel is compared bit for bit with   */
+/*                      the one of the generic kernel, and its time per call */
+/*                      is reported along with the speedup over the generic  */
+/*                      kernel                                               */
+/*                                                                           */
+/*  List of Functions : bench_rand                                           */
+/*                      bench_init_bufs                                      */
+/*                      bench_free_bufs                                      */
+/*                      bench_time                                           */
+/*                      bench_run                                            */
+/*                      bench_main                                           */
+/*                      bench_<signature> call wrappers                      */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ih264_structs.h"
+#include "ithread.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_weighted_pred.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_padding.h"
+#include "ih264_mem_fns.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "kernel_bench.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+#define DEFAULT_NUM_ITERS       2000
+#define NUM_TIMED_RUNS          3
+
+/** Arguments of the filters, chosen so that they modify most samples */
+#define BENCH_ALPHA             40
+#define BENCH_BETA              12
+#define BENCH_BS                0x01020301
+#define BENCH_LOG_WD            5
+#define BENCH_WT                40
+#define BENCH_OFST              3
+#define BENCH_NGBR_AVAIL        (LEFT_MB_AVAILABLE_MASK | TOP_LEFT_MB_AVAILABLE_MASK \
+                                 | TOP_MB_AVAILABLE_MASK | TOP_RIGHT_MB_AVAILABLE_MASK)
+#define BENCH_PAD_SIZE          32
+
+/** Flat scaling list */
+#define BENCH_WEIGH             16
+
+/*****************************************************************************/
+/* Global Variables                                                          */
+/*****************************************************************************/
+static const UWORD8 gau1_bench_cliptab[4] = { 0, 1, 2, 4 };
+
+/** Forward and inverse quantizer scales of qp % 6 == 4, by the class of the
+ * row and of the column of a coefficient: even and odd for 4x4, multiple of
+ * 4, odd and 2 modulo 4 for 8x8 */
+static const UWORD16 gau2_bench_scale_4x4[2][2] =
+{
+    { 8192, 5243 }, { 5243, 3355 }
+};
+static const UWORD16 gau2_bench_iscale_4x4[2][2] =
+{
+    { 16, 20 }, { 20, 25 }
+};
+static const UWORD16 gau2_bench_iscale_8x8[3][3] =
+{
+    { 32, 30, 40 }, { 30, 28, 38 }, { 40, 38, 51 }
+};
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_rand                                               */
+/*                                                                           */
+/*  Description   : Linear congruential generator, so that the synthetic     */
+/*                  blocks do not depend on the C library                    */
+/*                                                                           */
+/*  Inputs        : pu4_state : Generator state                              */
+/*  Returns       : 16 random bits                                           */
+/*                                                                           */
+/*****************************************************************************/
+static UWORD32 bench_rand(UWORD32 *pu4_state)
+{
+    *pu4_state = *pu4_state * 1103515245 + 12345;
+    return (*pu4_state >> 16) & 0xFFFF;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_init_bufs                                          */
+/*                                                                           */
+/*  Description   : Allocates and fills the synthetic blocks. Samples are a  */
+/*                  gentle ramp plus noise, so that the deblocking filters   */
+/*                  act on most edges, and coefficients are small and mostly */
+/*                  zero as after quantization                               */
+/*                                                                           */
+/*  Inputs        : ps_bufs : Buffers to initialize                          */
+/*  Returns       : 0 on success, -1 on allocation failure                   */
+/*                                                                           */
+/*****************************************************************************/
+static WORD32 bench_init_bufs(bench_bufs_t *ps_bufs)
+{
+    UWORD32 u4_state = 1;
+    UWORD8 *pu1_src_base, *pu1_ref_base;
+    UWORD16 *pu2_tables;
+    WORD32 i, j, x, y;
+
+    memset(ps_bufs, 0, sizeof(bench_bufs_t));
+
+    pu1_src_base = malloc(2 * BENCH_BUF_SIZE);
+    ps_bufs->pi2_coeff = malloc(BENCH_MAX_COEFFS * sizeof(WORD16));
+    pu2_tables = malloc(4 * (16 + 64) * sizeof(UWORD16));
+    ps_bufs->ps_out = malloc(sizeof(bench_out_t));
+    ps_bufs->ps_pristine = malloc(sizeof(bench_out_t));
+    ps_bufs->pv_scratch = malloc(BENCH_SCRATCH_SIZE);
+
+    if((NULL == pu1_src_base) || (NULL == ps_bufs->pi2_coeff)
+                    || (NULL == pu2_tables) || (NULL == ps_bufs->ps_out)
+                    || (NULL == ps_bufs->ps_pristine)
+                    || (NULL == ps_bufs->pv_scratch))
+    {
+        free(pu1_src_base);
+        free(pu2_tables);
+        ps_bufs->pu1_src = NULL;
+        ps_bufs->apu2_scale_mat[0] = NULL;
+        return -1;
+    }
+
+    pu1_ref_base = pu1_src_base + BENCH_BUF_SIZE;
+    memset(ps_bufs->ps_pristine, 0, sizeof(bench_out_t));
+
+    for(y = 0; y < BENCH_BUF_HT; y++)
+    {
+        for(x = 0; x < BENCH_BUF_STRD; x++)
+        {
+            WORD32 i4_ofst = y * BENCH_BUF_STRD + x;
+
+            pu1_src_base[i4_ofst] = 96 + ((x + y) & 0x3F)
+                            + (bench_rand(&u4_state) & 7);
+            pu1_ref_base[i4_ofst] = 96 + ((2 * x + y) & 0x3F)
+                            + (bench_rand(&u4_state) & 7);
+            ps_bufs->ps_pristine->au1_dst[i4_ofst] = 96 + ((x + 2 * y) & 0x3F)
+                            + (bench_rand(&u4_state) & 7);
+        }
+    }
+
+    for(i = 0; i < BENCH_MAX_COEFFS; i++)
+    {
+        UWORD32 u4_rand = bench_rand(&u4_state);
+
+        ps_bufs->pi2_coeff[i] = (u4_rand & 3) ? 0 : ((u4_rand >> 4) & 15) - 8;
+    }
+
+    ps_bufs->pu1_src = pu1_src_base + BENCH_BUF_OFST;
+    ps_bufs->pu1_ref = pu1_ref_base + BENCH_BUF_OFST;
+    ps_bufs->pu1_dst = ps_bufs->ps_out->au1_dst + BENCH_BUF_OFST;
+
+    /* 4x4 and 8x8 quantizer of qp 28 with flat scaling lists. The 8x8
+     * forward scales are derived from the inverse ones, which is close
+     * enough for timing */
+    for(i = 0; i < 2; i++)
+    {
+        WORD32 i4_size = i ? 64 : 16;
+
+        ps_bufs->apu2_scale_mat[i] = pu2_tables;
+        ps_bufs->apu2_thresh_mat[i] = pu2_tables + i4_size;
+        ps_bufs->apu2_iscale_mat[i] = pu2_tables + 2 * i4_size;
+        ps_bufs->apu2_weigh_mat[i] = pu2_tables + 3 * i4_size;
+        pu2_tables += 4 * i4_size;
+    }
+    ps_bufs->au4_qbits[0] = QP_BITS_h264_4x4 + BENCH_QP_DIV6;
+    ps_bufs->au4_qbits[1] = QP_BITS_h264_8x8 + BENCH_QP_DIV6;
+
+    for(i = 0; i < 16; i++)
+    {
+        WORD32 r = (i >> 2) & 1, c = i & 1;
+
+        ps_bufs->apu2_scale_mat[0][i] = gau2_bench_scale_4x4[r][c];
+        ps_bufs->apu2_iscale_mat[0][i] = gau2_bench_iscale_4x4[r][c];
+    }
+    for(i = 0; i < 64; i++)
+    {
+        WORD32 r = ((i >> 3) & 1) ? 1 : ((i >> 4) & 1) << 1;
+        WORD32 c = (i & 1) ? 1 : ((i >> 1) & 1) << 1;
+
+        ps_bufs->apu2_iscale_mat[1][i] = gau2_bench_iscale_8x8[r][c];
+        ps_bufs->apu2_scale_mat[1][i] = 262144 / gau2_bench_iscale_8x8[r][c];
+    }
+    for(i = 0; i < 2; i++)
+    {
+        WORD32 i4_size = i ? 64 : 16;
+
+        ps_bufs->au4_round_fact[i] = (1 << ps_bufs->au4_qbits[i]) / 3;
+        for(j = 0; j < i4_size; j++)
+        {
+            ps_bufs->apu2_weigh_mat[i][j] = BENCH_WEIGH;
+            ps_bufs->apu2_thresh_mat[i][j] = ((1 << ps_bufs->au4_qbits[i])
+                            - ps_bufs->au4_round_fact[i])
+                            / ps_bufs->apu2_scale_mat[i][j];
+        }
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_free_bufs                                          */
+/*                                                                           */
+/*  Description   : Frees the synthetic blocks                               */
+/*                                                                           */
+/*  Inputs        : ps_bufs : Buffers to free                                */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void bench_free_bufs(bench_bufs_t *ps_bufs)
+{
+    if(ps_bufs->pu1_src)
+        free(ps_bufs->pu1_src - BENCH_BUF_OFST);
+    free(ps_bufs->apu2_scale_mat[0]);
+    free(ps_bufs->pi2_coeff);
+    free(ps_bufs->ps_out);
+    free(ps_bufs->ps_pristine);
+    free(ps_bufs->pv_scratch);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_time                                               */
+/*                                                                           */
+/*  Description   : Times a kernel over i4_num_iters calls, best of          */
+/*                  NUM_TIMED_RUNS runs                                      */
+/*                                                                           */
+/*  Inputs        : pf_kernel    : Kernel                                    */
+/*                  ps_slot      : Slot the kernel is in                     */
+/*                  ps_bufs      : Synthetic blocks                          */
+/*                  i4_num_iters : Calls per run                             */
+/*  Returns       : Nanoseconds per call                                     */
+/*                                                                           */
+/*****************************************************************************/
+static double bench_time(bench_fxn_t *pf_kernel,
+                         const bench_slot_t *ps_slot,
+                         bench_bufs_t *ps_bufs,
+                         WORD32 i4_num_iters)
+{
+    UWORD64 u8_best_ns = 0;
+    WORD32 i, j;
+
+    for(i = 0; i < NUM_TIMED_RUNS; i++)
+    {
+        UWORD64 u8_start_ns, u8_ns;
+
+        /* in place kernels would otherwise run on their own output */
+        memcpy(ps_bufs->ps_out, ps_bufs->ps_pristine, sizeof(bench_out_t));
+
+        u8_start_ns = ithread_get_time_ns();
+        for(j = 0; j < i4_num_iters; j++)
+        {
+            ps_slot->pf_call(pf_kernel, ps_bufs, ps_slot->i4_arg);
+        }
+        u8_ns = ithread_get_time_ns() - u8_start_ns;
+
+        if((0 == i) || (u8_ns < u8_best_ns))
+            u8_best_ns = u8_ns;
+    }
+
+    return (double)u8_best_ns / i4_num_iters;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_run                                                */
+/*                                                                           */
+/*  Description   : Runs every slot at every level that installs a new       */
+/*                  kernel in it, and prints a line per kernel. Slots left   */
+/*                  empty by the generic level are skipped                   */
+/*                                                                           */
+/*  Inputs        : ps_levels     : Levels, generic first                    */
+/*                  i4_num_levels : Number of levels                         */
+/*                  ps_slots      : Slots                                    */
+/*                  i4_num_slots  : Number of slots                          */
+/*                  i4_num_iters  : Calls per timed run                      */
+/*                  pc_filter     : Only slots with this in their name, or   */
+/*                                  NULL                                     */
+/*  Returns       : Number of kernels not bit exact with the generic one, or */
+/*                  -1 on allocation failure                                 */
+/*                                                                           */
+/*****************************************************************************/
+static WORD32 bench_run(bench_level_t *ps_levels,
+                        WORD32 i4_num_levels,
+                        const bench_slot_t *ps_slots,
+                        WORD32 i4_num_slots,
+                        WORD32 i4_num_iters,
+                        const CHAR *pc_filter)
+{
+    bench_bufs_t s_bufs;
+    bench_out_t *ps_ref;
+    WORD32 i4_num_kernels = 0, i4_num_simd = 0, i4_num_mismatch = 0;
+    WORD32 i, j;
+
+    if(bench_init_bufs(&s_bufs))
+    {
+        bench_free_bufs(&s_bufs);
+        return -1;
+    }
+    ps_ref = malloc(sizeof(bench_out_t));
+    if(NULL == ps_ref)
+    {
+        bench_free_bufs(&s_bufs);
+        return -1;
+    }
+
+    printf("%-44s %-8s %10s %8s  %s\n", "slot", "level", "ns/call",
+           "speedup", "check");
+
+    for(i = 0; i < i4_num_slots; i++)
+    {
+        const bench_slot_t *ps_slot = &ps_slots[i];
+        bench_fxn_t *pf_prev = NULL;
+        double ref_ns = 0;
+
+        if(pc_filter && (NULL == strstr(ps_slot->pc_name, pc_filter)))
+            continue;
+
+        for(j = 0; j < i4_num_levels; j++)
+        {
+            bench_fxn_t *pf_kernel;
+            const CHAR *pc_check;
+            double ns;
+
+            pf_kernel = *(bench_fxn_t **)((UWORD8 *)ps_levels[j].pv_ctxt
+                            + ps_slot->offset);
+            if((NULL == pf_kernel) || (pf_kernel == pf_prev))
+            {
+                if(0 == j)
+                    break;
+                continue;
+            }
+            pf_prev = pf_kernel;
+
+            memcpy(s_bufs.ps_out, s_bufs.ps_pristine, sizeof(bench_out_t));
+            ps_slot->pf_call(pf_kernel, &s_bufs, ps_slot->i4_arg);
+            if(0 == j)
+            {
+                memcpy(ps_ref, s_bufs.ps_out, sizeof(bench_out_t));
+                pc_check = "ref";
+            }
+            else if(memcmp(ps_ref, s_bufs.ps_out, sizeof(bench_out_t)))
+            {
+                pc_check = "MISMATCH";
+                i4_num_mismatch++;
+            }
+            else
+            {
+                pc_check = "OK";
+            }
+
+            ns = bench_time(pf_kernel, ps_slot, &s_bufs, i4_num_iters);
+            if(0 == j)
+                ref_ns = ns;
+            else
+                i4_num_simd++;
+            i4_num_kernels++;
+
+            printf("%-44s %-8s %10.1f %7.2fx  %s\n",
+                   j ? "" : ps_slot->pc_name, ps_levels[j].pc_name, ns,
+                   (ns > 0) ? ref_ns / ns : 0.0, pc_check);
+        }
+    }
+
+    printf("%d kernels timed, %d SIMD ones checked, %d mismatches\n",
+           i4_num_kernels, i4_num_simd, i4_num_mismatch);
+
+    free(ps_ref);
+    bench_free_bufs(&s_bufs);
+    return i4_num_mismatch;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_main                                               */
+/*                                                                           */
+/*  Description   : Parses [iterations] [slot name filter] and runs the      */
+/*                  benchmark                                                */
+/*                                                                           */
+/*  Inputs        : ps_levels     : Levels, generic first                    */
+/*                  i4_num_levels : Number of levels                         */
+/*                  ps_slots      : Slots                                    */
+/*                  i4_num_slots  : Number of slots                          */
+/*                  argc, argv    : Command line                             */
+/*  Returns       : 0 if all kernels are bit exact, -1 otherwise             */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 bench_main(bench_level_t *ps_levels,
+                  WORD32 i4_num_levels,
+                  const bench_slot_t *ps_slots,
+                  WORD32 i4_num_slots,
+                  int argc,
+                  char *argv[])
+{
+    WORD32 i4_num_iters = DEFAULT_NUM_ITERS;
+    const CHAR *pc_filter = NULL;
+    WORD32 i;
+
+    if(argc > 1)
+        i4_num_iters = atoi(argv[1]);
+    if(argc > 2)
+        pc_filter = argv[2];
+
+    if((i4_num_iters <= 0) || (i4_num_iters > DEFAULT_NUM_ITERS * 1000))
+        i4_num_iters = DEFAULT_NUM_ITERS;
+
+    printf("levels:");
+    for(i = 0; i < i4_num_levels; i++)
+    {
+        printf(" %s", ps_levels[i].pc_name);
+    }
+    printf("\n");
+
+    return bench_run(ps_levels, i4_num_levels, ps_slots, i4_num_slots,
+                     i4_num_iters, pc_filter) ? -1 : 0;
+}
+
+/*****************************************************************************/
+/* Call wrappers for the kernel signatures in common/                        */
+/*****************************************************************************/
+
+void bench_intra_pred(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_intra_pred_luma_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                            BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                            BENCH_NGBR_AVAIL);
+}
+
+void bench_intra_pred_ref_filtering(bench_fxn_t *pf_kernel,
+                                    bench_bufs_t *ps_bufs,
+                                    WORD32 i4_arg)
+{
+    UWORD8 *pu1_src = ps_bufs->pu1_src;
+    UNUSED(i4_arg);
+
+    ((ih264_intra_pred_ref_filtering_ft *)pf_kernel)(
+                    pu1_src - 1, pu1_src - BENCH_BUF_STRD - 1,
+                    pu1_src - BENCH_BUF_STRD, ps_bufs->pu1_dst, BENCH_BUF_STRD,
+                    BENCH_NGBR_AVAIL);
+}
+
+void bench_inter_pred_luma(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    ((ih264_inter_pred_luma_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                            BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                            16, 16, ps_bufs->pv_scratch, i4_arg);
+}
+
+void bench_inter_pred_luma_bilinear(bench_fxn_t *pf_kernel,
+                                    bench_bufs_t *ps_bufs,
+                                    WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_inter_pred_luma_bilinear_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD, 16, 16);
+}
+
+void bench_inter_pred_chroma(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_inter_pred_chroma_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                              BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                              3, 5, 8, 8);
+}
+
+void bench_default_weighted_pred(bench_fxn_t *pf_kernel,
+                                 bench_bufs_t *ps_bufs,
+                                 WORD32 i4_arg)
+{
+    ((ih264_default_weighted_pred_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD, i4_arg,
+                    i4_arg);
+}
+
+void bench_weighted_pred_luma(bench_fxn_t *pf_kernel,
+                              bench_bufs_t *ps_bufs,
+                              WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_weighted_pred_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                          BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                          BENCH_LOG_WD, BENCH_WT, BENCH_OFST,
+                                          16, 16);
+}
+
+/* chroma weights and offsets hold cb in the low and cr in the high half */
+void bench_weighted_pred_chroma(bench_fxn_t *pf_kernel,
+                                bench_bufs_t *ps_bufs,
+                                WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_weighted_pred_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                          BENCH_BUF_STRD, BENCH_BUF_STRD,
+                                          BENCH_LOG_WD,
+                                          (36 << 16) | BENCH_WT,
+                                          (0xFE << 8) | BENCH_OFST, 8, 8);
+}
+
+void bench_weighted_bi_pred_luma(bench_fxn_t *pf_kernel,
+                                 bench_bufs_t *ps_bufs,
+                                 WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_weighted_bi_pred_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_LOG_WD, BENCH_WT, 24, BENCH_OFST, -1, 16, 16);
+}
+
+void bench_weighted_bi_pred_chroma(bench_fxn_t *pf_kernel,
+                                   bench_bufs_t *ps_bufs,
+                                   WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_weighted_bi_pred_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    BENCH_LOG_WD, (36 << 16) | BENCH_WT, (28 << 16) | 24,
+                    (0xFE << 8) | BENCH_OFST, (0x01 << 8) | 0xFF, 8, 8);
+}
+
+void bench_deblk_bs4(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_deblk_edge_bs4_ft *)pf_kernel)(ps_bufs->pu1_dst, BENCH_BUF_STRD,
+                                           BENCH_ALPHA, BENCH_BETA);
+}
+
+void bench_deblk_bslt4(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_deblk_edge_bslt4_ft *)pf_kernel)(ps_bufs->pu1_dst, BENCH_BUF_STRD,
+                                             BENCH_ALPHA, BENCH_BETA, BENCH_BS,
+                                             gau1_bench_cliptab);
+}
+
+void bench_deblk_chroma_bs4(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_deblk_chroma_edge_bs4_ft *)pf_kernel)(ps_bufs->pu1_dst,
+                                                  BENCH_BUF_STRD, BENCH_ALPHA,
+                                                  BENCH_BETA, BENCH_ALPHA - 4,
+                                                  BENCH_BETA - 2);
+}
+
+void bench_deblk_chroma_bslt4(bench_fxn_t *pf_kernel,
+                              bench_bufs_t *ps_bufs,
+                              WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_deblk_chroma_edge_bslt4_ft *)pf_kernel)(
+                    ps_bufs->pu1_dst, BENCH_BUF_STRD, BENCH_ALPHA, BENCH_BETA,
+                    BENCH_ALPHA - 4, BENCH_BETA - 2, BENCH_BS,
+                    gau1_bench_cliptab, gau1_bench_cliptab + 1);
+}
+
+/* i4_arg is the width for top / bottom padding and the height otherwise */
+void bench_pad(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    ((ih264_pad *)pf_kernel)(ps_bufs->pu1_dst, BENCH_BUF_STRD, i4_arg,
+                             BENCH_PAD_SIZE);
+}
+
+void bench_memcpy(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    ((ih264_memcpy_ft *)pf_kernel)(ps_bufs->pu1_dst, ps_bufs->pu1_src, i4_arg);
+}
+
+void bench_memset(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    ((ih264_memset_ft *)pf_kernel)(ps_bufs->pu1_dst, 0x5A, i4_arg);
+}
+
+/* i4_arg is the transform size, 4 or 8 */
+void bench_resi_trans_quant(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    WORD32 i4_8x8 = (8 == i4_arg);
+
+    ((ih264_resi_trans_quant_ft *)pf_kernel)(
+                    ps_bufs->pu1_src, ps_bufs->pu1_ref, ps_bufs->ps_out->ai2_out,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    ps_bufs->apu2_scale_mat[i4_8x8],
+                    ps_bufs->apu2_thresh_mat[i4_8x8], ps_bufs->au4_qbits[i4_8x8],
+                    ps_bufs->au4_round_fact[i4_8x8], ps_bufs->ps_out->au1_nnz,
+                    ps_bufs->ps_out->ai2_out + BENCH_MAX_COEFFS - 1);
+}
+
+void bench_hadamard_quant(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_hadamard_quant_ft *)pf_kernel)(
+                    ps_bufs->pi2_coeff, ps_bufs->ps_out->ai2_out,
+                    ps_bufs->apu2_scale_mat[0], ps_bufs->apu2_thresh_mat[0],
+                    ps_bufs->au4_qbits[0], ps_bufs->au4_round_fact[0],
+                    ps_bufs->ps_out->au1_nnz);
+}
+
+/* i4_arg is the transform size, 4 or 8 */
+void bench_iquant_itrans_recon(bench_fxn_t *pf_kernel,
+                               bench_bufs_t *ps_bufs,
+                               WORD32 i4_arg)
+{
+    WORD32 i4_8x8 = (8 == i4_arg);
+
+    ((ih264_iquant_itrans_recon_ft *)pf_kernel)(
+                    ps_bufs->pi2_coeff, ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD,
+                    ps_bufs->apu2_iscale_mat[i4_8x8],
+                    ps_bufs->apu2_weigh_mat[i4_8x8], BENCH_QP_DIV6,
+                    ps_bufs->pv_scratch, 0,
+                    ps_bufs->pi2_coeff + BENCH_MAX_COEFFS / 2);
+}
+
+void bench_iquant_itrans_recon_chroma(bench_fxn_t *pf_kernel,
+                                      bench_bufs_t *ps_bufs,
+                                      WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_iquant_itrans_recon_chroma_ft *)pf_kernel)(
+                    ps_bufs->pi2_coeff, ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                    BENCH_BUF_STRD, BENCH_BUF_STRD, ps_bufs->apu2_iscale_mat[0],
+                    ps_bufs->apu2_weigh_mat[0], BENCH_QP_DIV6,
+                    ps_bufs->pv_scratch,
+                    ps_bufs->pi2_coeff + BENCH_MAX_COEFFS / 2);
+}
+
+void bench_ihadamard_scaling(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_ihadamard_scaling_ft *)pf_kernel)(
+                    ps_bufs->pi2_coeff, ps_bufs->ps_out->ai2_out,
+                    ps_bufs->apu2_iscale_mat[0], ps_bufs->apu2_weigh_mat[0],
+                    BENCH_QP_DIV6, ps_bufs->pv_scratch);
+}
+
+void bench_interleave_copy(bench_fxn_t *pf_kernel, bench_bufs_t *ps_bufs, WORD32 i4_arg)
+{
+    UNUSED(i4_arg);
+    ((ih264_interleave_copy_ft *)pf_kernel)(ps_bufs->pu1_src, ps_bufs->pu1_dst,
+                                            BENCH_BUF_STRD, BENCH_BUF_STRD, 4, 4);
+}
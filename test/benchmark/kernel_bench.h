@@ -0,0 +1,161 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : kernel_bench.h                                       */
+/*                                                                           */
+/*  Description       : Harness shared by the encoder and decoder kernel     */
+/*                      benchmarks. A kernel is named by the offset of its   */
+/*                      function pointer slot in the codec context, and is   */
+/*                      called through a wrapper per kernel signature on     */
+/*                      synthetic blocks                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+#ifndef _KERNEL_BENCH_H_
+#define _KERNEL_BENCH_H_
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+/** Synthetic 8 bit planes; blocks start BENCH_BUF_OFST in, leaving a margin
+ * for neighbours, filter taps and padding on every side */
+#define BENCH_BUF_STRD          160
+#define BENCH_BUF_HT            160
+#define BENCH_BUF_SIZE          (BENCH_BUF_STRD * BENCH_BUF_HT)
+#define BENCH_BUF_OFST          (48 * BENCH_BUF_STRD + 48)
+
+#define BENCH_MAX_COEFFS        256
+#define BENCH_MAX_OUTS          64
+#define BENCH_SCRATCH_SIZE      (32 * 1024)
+#define BENCH_MAX_LEVELS        4
+
+/** Quantizer of the transform kernels, qp 28 */
+#define BENCH_QP_DIV6           4
+
+/*****************************************************************************/
+/* Typedefs                                                                  */
+/*****************************************************************************/
+/** Type a slot is read as, cast back to the kernel type by its wrapper */
+typedef void bench_fxn_t(void);
+
+/*****************************************************************************/
+/* Structures                                                                */
+/*****************************************************************************/
+
+/** Everything a kernel may write. Compared as a whole against the output of
+ * the generic kernel */
+typedef struct
+{
+    UWORD8 au1_dst[BENCH_BUF_SIZE];
+    WORD16 ai2_out[BENCH_MAX_COEFFS];
+    WORD32 ai4_out[BENCH_MAX_OUTS];
+    UWORD8 au1_nnz[16];
+}bench_out_t;
+
+typedef struct
+{
+    /** Inputs, never written */
+    UWORD8 *pu1_src;
+    UWORD8 *pu1_ref;
+    WORD16 *pi2_coeff;
+
+    /** Quantizer tables, 4x4 at index 0 and 8x8 at index 1 */
+    UWORD16 *apu2_scale_mat[2];
+    UWORD16 *apu2_thresh_mat[2];
+    UWORD16 *apu2_iscale_mat[2];
+    UWORD16 *apu2_weigh_mat[2];
+    UWORD32 au4_qbits[2];
+    UWORD32 au4_round_fact[2];
+
+    /** Outputs, reset from the pristine copy before every checked call */
+    bench_out_t *ps_out;
+    bench_out_t *ps_pristine;
+    UWORD8 *pu1_dst;
+
+    /** Scratch the kernels are free to trash, not compared */
+    void *pv_scratch;
+}bench_bufs_t;
+
+/** Calls pf_kernel once on the synthetic blocks */
+typedef void bench_call_ft(bench_fxn_t *pf_kernel,
+                           bench_bufs_t *ps_bufs,
+                           WORD32 i4_arg);
+
+typedef struct
+{
+    /** Name of the slot in the codec context */
+    const CHAR *pc_name;
+
+    /** Offset of the slot in the codec context */
+    size_t offset;
+
+    /** Wrapper for the signature of the slot */
+    bench_call_ft *pf_call;
+
+    /** Kernel specific argument, such as dydx or a block size */
+    WORD32 i4_arg;
+}bench_slot_t;
+
+typedef struct
+{
+    /** Name of the instruction set level */
+    const CHAR *pc_name;
+
+    /** Codec context with the function pointers of this level */
+    void *pv_ctxt;
+}bench_level_t;
+
+/*****************************************************************************/
+/* Extern Function Declarations                                              */
+/*****************************************************************************/
+WORD32 bench_main(bench_level_t *ps_levels,
+                  WORD32 i4_num_levels,
+                  const bench_slot_t *ps_slots,
+                  WORD32 i4_num_slots,
+                  int argc,
+                  char *argv[]);
+
+/* Wrappers for the kernel signatures in common/ */
+bench_call_ft bench_intra_pred;
+bench_call_ft bench_intra_pred_ref_filtering;
+bench_call_ft bench_inter_pred_luma;
+bench_call_ft bench_inter_pred_luma_bilinear;
+bench_call_ft bench_inter_pred_chroma;
+bench_call_ft bench_default_weighted_pred;
+bench_call_ft bench_weighted_pred_luma;
+bench_call_ft bench_weighted_pred_chroma;
+bench_call_ft bench_weighted_bi_pred_luma;
+bench_call_ft bench_weighted_bi_pred_chroma;
+bench_call_ft bench_deblk_bs4;
+bench_call_ft bench_deblk_bslt4;
+bench_call_ft bench_deblk_chroma_bs4;
+bench_call_ft bench_deblk_chroma_bslt4;
+bench_call_ft bench_pad;
+bench_call_ft bench_memcpy;
+bench_call_ft bench_memset;
+bench_call_ft bench_resi_trans_quant;
+bench_call_ft bench_hadamard_quant;
+bench_call_ft bench_iquant_itrans_recon;
+bench_call_ft bench_iquant_itrans_recon_chroma;
+bench_call_ft bench_ihadamard_scaling;
+bench_call_ft bench_interleave_copy;
+
+#endif /* _KERNEL_BENCH_H_ */
@@ -0,0 +1,444 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/*****************************************************************************/
+/*                                                                           */
+/*  File Name         : list_bench.c                                         */
+/*                                                                           */
+/*  Description       : Measures the throughput of the job queue (list_t)    */
+/*                      as the number of threads sharing it grows from 1 to  */
+/*                      16. Every thread queues a job and dequeues one, the  */
+/*                      way the encoder threads pull per row jobs. A ring    */
+/*                      buffer behind one mutex, as list_t was before it     */
+/*                      became lock free, is run the same way as baseline    */
+/*                                                                           */
+/*  Usage             : list_bench [iterations per thread] [max threads]     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "ih264_typedefs.h"
+#include "ih264_error.h"
+#include "ithread.h"
+#include "ih264_list.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+#define DEFAULT_NUM_ITERS   200000
+#define MAX_NUM_THREADS     16
+#define NUM_LIST_ENTRIES    64
+
+/*****************************************************************************/
+/* Structures                                                                */
+/*****************************************************************************/
+
+/** Entry of the size of an encoder job */
+typedef struct
+{
+    WORD32 i4_cmd;
+    WORD32 i4_mb_x;
+    WORD32 i4_mb_y;
+    WORD32 i4_num_mbs;
+}bench_job_t;
+
+/** Baseline queue, a ring buffer with every access under one mutex */
+typedef struct
+{
+    void *pv_mutex;
+    void *pv_buf_base;
+    WORD32 i4_entry_size;
+    WORD32 i4_buf_max_idx;
+    volatile WORD32 i4_buf_rd_idx;
+    volatile WORD32 i4_buf_wr_idx;
+}mutex_list_t;
+
+typedef void *bench_create_ft(WORD32 i4_num_entries, WORD32 i4_entry_size);
+typedef void bench_free_ft(void *pv_list);
+typedef IH264_ERROR_T bench_queue_ft(void *pv_list, void *pv_buf, WORD32 blocking);
+
+/** Queue under test */
+typedef struct
+{
+    const CHAR *pc_name;
+    bench_create_ft *pf_create;
+    bench_free_ft *pf_free;
+    bench_queue_ft *pf_queue;
+    bench_queue_ft *pf_dequeue;
+}bench_queue_t;
+
+typedef struct
+{
+    void *pv_list;
+    const bench_queue_t *ps_queue;
+    WORD32 i4_thread_id;
+    WORD32 i4_num_iters;
+    volatile WORD32 *pi4_start;
+    UWORD64 u8_queued_sum;
+    UWORD64 u8_dequeued_sum;
+    WORD32 i4_num_fails;
+}bench_thread_t;
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : mutex_list_create                                        */
+/*                                                                           */
+/*  Description   : Allocates and initializes the baseline queue             */
+/*                                                                           */
+/*  Inputs        : i4_num_entries : Number of entries, a power of 2         */
+/*                  i4_entry_size  : Size of an entry in bytes               */
+/*  Returns       : Baseline queue, NULL on allocation failure               */
+/*                                                                           */
+/*****************************************************************************/
+void *mutex_list_create(WORD32 i4_num_entries, WORD32 i4_entry_size)
+{
+    mutex_list_t *ps_list;
+
+    ps_list = malloc(sizeof(mutex_list_t) + ithread_get_mutex_lock_size()
+                    + i4_num_entries * i4_entry_size);
+    if(NULL == ps_list)
+        return NULL;
+
+    ps_list->pv_mutex = ps_list + 1;
+    ps_list->pv_buf_base = (UWORD8 *)ps_list->pv_mutex + ithread_get_mutex_lock_size();
+    ps_list->i4_entry_size = i4_entry_size;
+    ps_list->i4_buf_max_idx = i4_num_entries;
+    ps_list->i4_buf_rd_idx = 0;
+    ps_list->i4_buf_wr_idx = 0;
+    ithread_mutex_init(ps_list->pv_mutex);
+
+    return ps_list;
+}
+
+void mutex_list_free(void *pv_list)
+{
+    mutex_list_t *ps_list = (mutex_list_t *)pv_list;
+
+    ithread_mutex_destroy(ps_list->pv_mutex);
+    free(ps_list);
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : mutex_list_queue                                         */
+/*                                                                           */
+/*  Description   : Adds an entry to the baseline queue, waiting for a free  */
+/*                  entry if blocking                                        */
+/*                                                                           */
+/*  Inputs        : pv_list  : Baseline queue                                */
+/*                  pv_buf   : Entry to be copied in                         */
+/*                  blocking : Wait if the queue is full                     */
+/*  Returns       : IH264_SUCCESS, IH264_FAIL if full and not blocking       */
+/*                                                                           */
+/*****************************************************************************/
+IH264_ERROR_T mutex_list_queue(void *pv_list, void *pv_buf, WORD32 blocking)
+{
+    mutex_list_t *ps_list = (mutex_list_t *)pv_list;
+    IH264_ERROR_T ret = IH264_SUCCESS;
+
+    ithread_mutex_lock(ps_list->pv_mutex);
+    while(1)
+    {
+        if((ps_list->i4_buf_wr_idx - ps_list->i4_buf_rd_idx) < ps_list->i4_buf_max_idx)
+        {
+            WORD32 wr_idx = ps_list->i4_buf_wr_idx & (ps_list->i4_buf_max_idx - 1);
+
+            memcpy((UWORD8 *)ps_list->pv_buf_base + wr_idx * ps_list->i4_entry_size,
+                   pv_buf, ps_list->i4_entry_size);
+            ps_list->i4_buf_wr_idx++;
+            break;
+        }
+        if(0 == blocking)
+        {
+            ret = IH264_FAIL;
+            break;
+        }
+        ithread_mutex_unlock(ps_list->pv_mutex);
+        ithread_yield();
+        ithread_mutex_lock(ps_list->pv_mutex);
+    }
+    ithread_mutex_unlock(ps_list->pv_mutex);
+
+    return ret;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : mutex_list_dequeue                                       */
+/*                                                                           */
+/*  Description   : Takes the oldest entry from the baseline queue, waiting  */
+/*                  for one if blocking                                      */
+/*                                                                           */
+/*  Inputs        : pv_list  : Baseline queue                                */
+/*                  pv_buf   : Entry to be copied out                        */
+/*                  blocking : Wait if the queue is empty                    */
+/*  Returns       : IH264_SUCCESS, IH264_FAIL if empty and not blocking      */
+/*                                                                           */
+/*****************************************************************************/
+IH264_ERROR_T mutex_list_dequeue(void *pv_list, void *pv_buf, WORD32 blocking)
+{
+    mutex_list_t *ps_list = (mutex_list_t *)pv_list;
+    IH264_ERROR_T ret = IH264_SUCCESS;
+
+    ithread_mutex_lock(ps_list->pv_mutex);
+    while(1)
+    {
+        if((ps_list->i4_buf_wr_idx - ps_list->i4_buf_rd_idx) > 0)
+        {
+            WORD32 rd_idx = ps_list->i4_buf_rd_idx & (ps_list->i4_buf_max_idx - 1);
+
+            memcpy(pv_buf,
+                   (UWORD8 *)ps_list->pv_buf_base + rd_idx * ps_list->i4_entry_size,
+                   ps_list->i4_entry_size);
+            ps_list->i4_buf_rd_idx++;
+            break;
+        }
+        if(0 == blocking)
+        {
+            ret = IH264_FAIL;
+            break;
+        }
+        ithread_mutex_unlock(ps_list->pv_mutex);
+        ithread_yield();
+        ithread_mutex_lock(ps_list->pv_mutex);
+    }
+    ithread_mutex_unlock(ps_list->pv_mutex);
+
+    return ret;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : list_create, list_free, list_queue, list_dequeue         */
+/*                                                                           */
+/*  Description   : Run the job queue (list_t) under test through the same   */
+/*                  calls as the baseline                                    */
+/*                                                                           */
+/*****************************************************************************/
+void *list_create(WORD32 i4_num_entries, WORD32 i4_entry_size)
+{
+    WORD32 i4_list_size = ih264_list_size(i4_num_entries, i4_entry_size);
+    void *pv_buf = malloc(i4_list_size);
+    list_t *ps_list;
+
+    if(NULL == pv_buf)
+        return NULL;
+
+    ps_list = ih264_list_init(pv_buf, i4_list_size, i4_num_entries,
+                              i4_entry_size, 0);
+    if(NULL == ps_list)
+        free(pv_buf);
+
+    return ps_list;
+}
+
+void list_free(void *pv_list)
+{
+    list_t *ps_list = (list_t *)pv_list;
+
+    ih264_list_deinit(ps_list);
+    ih264_list_free(ps_list);
+    free(pv_list);
+}
+
+IH264_ERROR_T list_queue(void *pv_list, void *pv_buf, WORD32 blocking)
+{
+    return ih264_list_queue((list_t *)pv_list, pv_buf, blocking);
+}
+
+IH264_ERROR_T list_dequeue(void *pv_list, void *pv_buf, WORD32 blocking)
+{
+    return ih264_list_dequeue((list_t *)pv_list, pv_buf, blocking);
+}
+
+static const bench_queue_t gas_queues[] =
+{
+    { "mutex", mutex_list_create, mutex_list_free, mutex_list_queue, mutex_list_dequeue },
+    { "list", list_create, list_free, list_queue, list_dequeue },
+};
+
+#define NUM_QUEUES (WORD32)(sizeof(gas_queues) / sizeof(gas_queues[0]))
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : bench_thread                                             */
+/*                                                                           */
+/*  Description   : Queues and dequeues jobs in a loop, keeping a sum of the */
+/*                  jobs seen to verify that none are lost or duplicated     */
+/*                                                                           */
+/*  Inputs        : pv_ctxt : Thread context                                 */
+/*  Returns       : 0                                                        */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 bench_thread(void *pv_ctxt)
+{
+    bench_thread_t *ps_ctxt = (bench_thread_t *)pv_ctxt;
+    WORD32 i;
+
+    while(0 == *ps_ctxt->pi4_start)
+        ;
+
+    for(i = 0; i < ps_ctxt->i4_num_iters; i++)
+    {
+        bench_job_t s_job;
+
+        s_job.i4_cmd = ps_ctxt->i4_thread_id;
+        s_job.i4_mb_x = i;
+        s_job.i4_mb_y = i >> 8;
+        s_job.i4_num_mbs = 1;
+
+        if(IH264_SUCCESS != ps_ctxt->ps_queue->pf_queue(ps_ctxt->pv_list, &s_job, 1))
+        {
+            ps_ctxt->i4_num_fails++;
+            continue;
+        }
+        ps_ctxt->u8_queued_sum += s_job.i4_cmd * (UWORD64)DEFAULT_NUM_ITERS + s_job.i4_mb_x;
+
+        if(IH264_SUCCESS != ps_ctxt->ps_queue->pf_dequeue(ps_ctxt->pv_list, &s_job, 1))
+        {
+            ps_ctxt->i4_num_fails++;
+            continue;
+        }
+        ps_ctxt->u8_dequeued_sum += s_job.i4_cmd * (UWORD64)DEFAULT_NUM_ITERS + s_job.i4_mb_x;
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : run_bench                                                */
+/*                                                                           */
+/*  Description   : Runs the given number of threads on one queue and prints */
+/*                  the throughput, relative to that of the baseline         */
+/*                                                                           */
+/*  Inputs        : ps_queue       : Queue under test                        */
+/*                  i4_num_threads : Number of threads                       */
+/*                  i4_num_iters   : Queue / dequeue pairs per thread        */
+/*                  pd_base_ns     : ns per op of the baseline, set if 0     */
+/*  Returns       : 0 on success, -1 if jobs were lost or duplicated         */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 run_bench(const bench_queue_t *ps_queue,
+                 WORD32 i4_num_threads,
+                 WORD32 i4_num_iters,
+                 double *pd_base_ns)
+{
+    bench_thread_t as_thread[MAX_NUM_THREADS];
+    UWORD8 au1_thread_handle[MAX_NUM_THREADS][64];
+    volatile WORD32 i4_start = 0;
+    struct timeval s_start, s_end;
+    UWORD64 u8_queued_sum = 0, u8_dequeued_sum = 0;
+    WORD32 i4_num_fails = 0;
+    double elapsed_us, num_ops, ns_per_op;
+    void *pv_list;
+    WORD32 i;
+
+    if(ithread_get_handle_size() > sizeof(au1_thread_handle[0]))
+        return -1;
+
+    pv_list = ps_queue->pf_create(NUM_LIST_ENTRIES, sizeof(bench_job_t));
+    if(NULL == pv_list)
+        return -1;
+
+    for(i = 0; i < i4_num_threads; i++)
+    {
+        memset(&as_thread[i], 0, sizeof(bench_thread_t));
+        as_thread[i].pv_list = pv_list;
+        as_thread[i].ps_queue = ps_queue;
+        as_thread[i].i4_thread_id = i;
+        as_thread[i].i4_num_iters = i4_num_iters;
+        as_thread[i].pi4_start = &i4_start;
+        ithread_create(au1_thread_handle[i], NULL, (void *)&bench_thread,
+                       &as_thread[i]);
+    }
+
+    gettimeofday(&s_start, NULL);
+    i4_start = 1;
+
+    for(i = 0; i < i4_num_threads; i++)
+    {
+        ithread_join(au1_thread_handle[i], NULL);
+    }
+    gettimeofday(&s_end, NULL);
+
+    for(i = 0; i < i4_num_threads; i++)
+    {
+        u8_queued_sum += as_thread[i].u8_queued_sum;
+        u8_dequeued_sum += as_thread[i].u8_dequeued_sum;
+        i4_num_fails += as_thread[i].i4_num_fails;
+    }
+
+    ps_queue->pf_free(pv_list);
+
+    elapsed_us = (s_end.tv_sec - s_start.tv_sec) * 1000000.0
+                    + (s_end.tv_usec - s_start.tv_usec);
+    num_ops = 2.0 * i4_num_threads * i4_num_iters;
+    ns_per_op = elapsed_us * 1000.0 / num_ops;
+    if(0 == *pd_base_ns)
+        *pd_base_ns = ns_per_op;
+
+    printf("%7d  %-6s  %12.0f  %10.2f  %10.1f  %6.2fx  %s\n", i4_num_threads,
+           ps_queue->pc_name, num_ops, num_ops / elapsed_us, ns_per_op,
+           *pd_base_ns / ns_per_op,
+           ((u8_queued_sum == u8_dequeued_sum) && (0 == i4_num_fails)) ?
+                           "OK" : "MISMATCH");
+
+    return ((u8_queued_sum == u8_dequeued_sum) && (0 == i4_num_fails)) ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    WORD32 i4_num_iters = DEFAULT_NUM_ITERS;
+    WORD32 i4_max_threads = MAX_NUM_THREADS;
+    WORD32 i4_num_threads;
+    WORD32 ret = 0;
+    WORD32 i;
+
+    if(argc > 1)
+        i4_num_iters = atoi(argv[1]);
+    if(argc > 2)
+        i4_max_threads = atoi(argv[2]);
+
+    if((i4_num_iters <= 0) || (i4_num_iters > DEFAULT_NUM_ITERS * 100))
+        i4_num_iters = DEFAULT_NUM_ITERS;
+    if((i4_max_threads <= 0) || (i4_max_threads > MAX_NUM_THREADS))
+        i4_max_threads = MAX_NUM_THREADS;
+
+    printf("threads  queue            ops   Mops/sec       ns/op  speedup  check\n");
+    for(i4_num_threads = 1; i4_num_threads <= i4_max_threads; i4_num_threads <<= 1)
+    {
+        /* the first queue is the baseline */
+        double d_base_ns = 0;
+
+        for(i = 0; i < NUM_QUEUES; i++)
+        {
+            ret |= run_bench(&gas_queues[i], i4_num_threads, i4_num_iters,
+                             &d_base_ns);
+        }
+    }
+
+    return ret ? -1 : 0;
+}
@@ -199,6 +199,13 @@ typedef struct
     WORD32 i4_degrade_type;
     WORD32 i4_degrade_pics;
     UWORD32 u4_num_cores;
+    UWORD32 u4_async;
+    UWORD32 u4_num_affinity_cpus;
+    UWORD32 au4_affinity_cpus[IH264D_MAX_AFFINITY_CPUS];
+    UWORD32 u4_stats;
+    UWORD32 u4_nal_length_size;
+    UWORD8 *pu1_avcc;
+    UWORD32 u4_avcc_size;
     UWORD32 disp_delay;
     WORD32 trace_enable;
     CHAR ac_trace_fname[STRLENGTH];
@@ -275,6 +282,10 @@ typedef enum
     SOC,
     PICLEN,
     PICLEN_FILE,
+    ASYNC,
+    CPU_LIST,
+    STATS,
+    NAL_LENGTH_SIZE,
 } ARGUMENT_T;
 
 typedef struct
@@ -335,9 +346,17 @@ static const argument_t argument_mapping[] =
          "Degrade pics : 0 : No degrade  1 : Only on non-reference frames  2 : Do not degrade every 4th or key frames  3 : All non-key frames  4 : All frames"},
 
     {"--",  "--arch", ARCH,
-         "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE4 \n" },
+         "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR,ARMV8_GENERIC, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2 \n" },
     {"--",  "--soc", SOC,
          "Set SOC. Supported values  GENERIC, HISI_37X \n" },
+    {"--",  "--async", ASYNC,
+         "Decode through the queue / dequeue calls (Not supported with shared display buffers, display or loopback)\n" },
+    {"--",  "--cpu_list", CPU_LIST,
+         "Comma separated CPUs the app and decoder threads are pinned to\n" },
+    {"--",  "--stats", STATS,
+         "Print per stage and per thread decode statistics at the end\n" },
+    {"--",  "--nal_length_size", NAL_LENGTH_SIZE,
+         "Feed NAL units preceded by their size in 1, 2 or 4 bytes, with the parameter sets ahead of the first slice in an avcC record, as an mp4 demuxer would (Not supported with piclen)\n" },
 
 };
 
@@ -345,6 +364,8 @@ static const argument_t argument_mapping[] =
 #define DEFAULT_SHARE_DISPLAY_BUF   0
 #define STRIDE                      0
 #define DEFAULT_NUM_CORES           1
+#define NUM_ASYNC_BS_BUFS           4
+#define NUM_ASYNC_OUT_BUFS          4
 
 
 #define DUMP_SINGLE_BUF 0
@@ -1090,6 +1111,199 @@ void print_usage(void)
     }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : to_length_prefixed                                       */
+/*                                                                           */
+/*  Description   : Rewrites an Annex B input as NAL units preceded by their */
+/*                  size, the way mp4 samples carry them. The parameter sets */
+/*                  ahead of the first slice go to an avcC record instead    */
+/*                                                                           */
+/*  Inputs        : ps_ip_file         - Annex B input, closed here          */
+/*                  u4_nal_length_size - Size of the NAL unit sizes          */
+/*                  ppu1_avcc          - avcC record, freed by the caller    */
+/*                  pu4_avcc_size      - Size of the avcC record             */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       : ppu1_avcc, pu4_avcc_size                                 */
+/*  Returns       : Temporary file with the length prefixed NAL units        */
+/*                                                                           */
+/*****************************************************************************/
+FILE *to_length_prefixed(FILE *ps_ip_file,
+                         UWORD32 u4_nal_length_size,
+                         UWORD8 **ppu1_avcc,
+                         UWORD32 *pu4_avcc_size)
+{
+    UWORD8 *pu1_buf, *pu1_sps, *pu1_pps, *pu1_avcc;
+    UWORD32 u4_size, u4_pos, u4_start, u4_end, u4_sps_size, u4_pps_size;
+    UWORD32 u4_num_sps, u4_num_pps, u4_slice_seen, i;
+    FILE *ps_op_file;
+
+    if((u4_nal_length_size != 1) && (u4_nal_length_size != 2)
+                    && (u4_nal_length_size != 4))
+    {
+        codec_exit("\nInvalid NAL length size");
+    }
+
+    fseek(ps_ip_file, 0, SEEK_END);
+    u4_size = ftell(ps_ip_file);
+    fseek(ps_ip_file, 0, SEEK_SET);
+
+    pu1_buf = malloc(u4_size + 3);
+    pu1_sps = malloc(u4_size + 3);
+    pu1_pps = malloc(u4_size + 3);
+    ps_op_file = tmpfile();
+    if((NULL == pu1_buf) || (NULL == pu1_sps) || (NULL == pu1_pps)
+                    || (NULL == ps_op_file)
+                    || (u4_size != fread(pu1_buf, 1, u4_size, ps_ip_file)))
+    {
+        codec_exit("\nCould not convert the input to length prefixed NAL units");
+    }
+    fclose(ps_ip_file);
+
+    /* A start code past the end closes the last NAL unit */
+    pu1_buf[u4_size] = 0;
+    pu1_buf[u4_size + 1] = 0;
+    pu1_buf[u4_size + 2] = 1;
+
+    u4_sps_size = 0;
+    u4_pps_size = 0;
+    u4_num_sps = 0;
+    u4_num_pps = 0;
+    u4_slice_seen = 0;
+    u4_start = 0;
+    for(u4_pos = 0; u4_pos < u4_size + 1; u4_pos++)
+    {
+        UWORD32 u4_nal_size;
+        UWORD8 u1_nal_type;
+
+        if((pu1_buf[u4_pos] != 0) || (pu1_buf[u4_pos + 1] != 0)
+                        || (pu1_buf[u4_pos + 2] != 1))
+        {
+            continue;
+        }
+
+        /* Trailing zeros belong to the start code */
+        u4_end = u4_pos;
+        while((u4_end > u4_start) && (0 == pu1_buf[u4_end - 1]))
+        {
+            u4_end--;
+        }
+
+        u4_nal_size = u4_end - u4_start;
+        if(u4_nal_size && u4_start)
+        {
+            u1_nal_type = pu1_buf[u4_start] & 0x1F;
+            if((u1_nal_type >= 1) && (u1_nal_type <= 5))
+            {
+                u4_slice_seen = 1;
+            }
+
+            if(!u4_slice_seen && (7 == u1_nal_type) && (u4_num_sps < 31)
+                            && (u4_nal_size < 0x10000))
+            {
+                pu1_sps[u4_sps_size++] = u4_nal_size >> 8;
+                pu1_sps[u4_sps_size++] = u4_nal_size & 0xFF;
+                memcpy(pu1_sps + u4_sps_size, pu1_buf + u4_start, u4_nal_size);
+                u4_sps_size += u4_nal_size;
+                u4_num_sps++;
+            }
+            else if(!u4_slice_seen && (8 == u1_nal_type)
+                            && (u4_num_pps < 255) && (u4_nal_size < 0x10000))
+            {
+                pu1_pps[u4_pps_size++] = u4_nal_size >> 8;
+                pu1_pps[u4_pps_size++] = u4_nal_size & 0xFF;
+                memcpy(pu1_pps + u4_pps_size, pu1_buf + u4_start, u4_nal_size);
+                u4_pps_size += u4_nal_size;
+                u4_num_pps++;
+            }
+            else
+            {
+                UWORD8 au1_nal_size[4];
+
+                if((u4_nal_length_size < 4)
+                                && (u4_nal_size >> (8 * u4_nal_length_size)))
+                {
+                    codec_exit("\nNAL unit too large for the NAL length size");
+                }
+                for(i = 0; i < u4_nal_length_size; i++)
+                {
+                    au1_nal_size[i] = u4_nal_size
+                                    >> (8 * (u4_nal_length_size - 1 - i));
+                }
+                fwrite(au1_nal_size, 1, u4_nal_length_size, ps_op_file);
+                fwrite(pu1_buf + u4_start, 1, u4_nal_size, ps_op_file);
+            }
+        }
+        u4_start = u4_pos + 3;
+        u4_pos += 2;
+    }
+
+    if(0 == u4_num_sps)
+    {
+        codec_exit("\nNo sequence parameter set ahead of the first slice");
+    }
+
+    /* Version, profile, compatibility and level of the first SPS, */
+    /* lengthSizeMinusOne, then the SPS and the PPS lists           */
+    pu1_avcc = malloc(7 + u4_sps_size + u4_pps_size);
+    if(NULL == pu1_avcc)
+    {
+        codec_exit("\nCould not allocate the avcC record");
+    }
+    pu1_avcc[0] = 1;
+    pu1_avcc[1] = pu1_sps[3];
+    pu1_avcc[2] = pu1_sps[4];
+    pu1_avcc[3] = pu1_sps[5];
+    pu1_avcc[4] = 0xFC | (u4_nal_length_size - 1);
+    pu1_avcc[5] = 0xE0 | u4_num_sps;
+    memcpy(pu1_avcc + 6, pu1_sps, u4_sps_size);
+    pu1_avcc[6 + u4_sps_size] = u4_num_pps;
+    memcpy(pu1_avcc + 7 + u4_sps_size, pu1_pps, u4_pps_size);
+
+    *ppu1_avcc = pu1_avcc;
+    *pu4_avcc_size = 7 + u4_sps_size + u4_pps_size;
+
+    free(pu1_buf);
+    free(pu1_sps);
+    free(pu1_pps);
+    fseek(ps_op_file, 0, SEEK_SET);
+    return ps_op_file;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : get_cpu_list                                             */
+/*                                                                           */
+/*  Description   : Parses a comma separated list of CPUs                    */
+/*                                                                           */
+/*  Inputs        : value       - CPU list string                            */
+/*                  pu4_cpu_ids - Parsed CPUs                                */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       : pu4_cpu_ids                                              */
+/*  Returns       : Number of CPUs in the list                               */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 get_cpu_list(CHAR *value, UWORD32 *pu4_cpu_ids)
+{
+    UWORD32 u4_num_cpus = 0;
+    CHAR *pc_end;
+
+    while((u4_num_cpus < IH264D_MAX_AFFINITY_CPUS) && (*value != '\0'))
+    {
+        pu4_cpu_ids[u4_num_cpus++] = strtoul(value, &pc_end, 10);
+        if((pc_end == value) || ((*pc_end != ',') && (*pc_end != '\0')))
+        {
+            codec_exit("\nInvalid CPU list");
+        }
+        value = (*pc_end == ',') ? pc_end + 1 : pc_end;
+    }
+    return u4_num_cpus;
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : get_argument                                             */
@@ -1295,6 +1509,23 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value)
         case PICLEN_FILE:
             sscanf(value, "%s", ps_app_ctx->ac_piclen_fname);
             break;
+
+        case ASYNC:
+            sscanf(value, "%d", &ps_app_ctx->u4_async);
+            break;
+
+        case CPU_LIST:
+            ps_app_ctx->u4_num_affinity_cpus =
+                            get_cpu_list(value, ps_app_ctx->au4_affinity_cpus);
+            break;
+
+        case STATS:
+            sscanf(value, "%d", &ps_app_ctx->u4_stats);
+            break;
+
+        case NAL_LENGTH_SIZE:
+            sscanf(value, "%d", &ps_app_ctx->u4_nal_length_size);
+            break;
         case DISABLE_DEBLOCK_LEVEL:
             sscanf(value, "%d", &ps_app_ctx->u4_disable_dblk_level);
             break;
@@ -1732,6 +1963,394 @@ void flush_output(iv_obj_t *codec_obj,
 
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : get_au_bytes                                             */
+/*                                                                           */
+/*  Description   : Returns the number of bytes taken by the complete access */
+/*                  units at the start of the buffer, that is the offset of  */
+/*                  the start code of the last access unit beginning in it.  */
+/*                  An access unit begins at an AUD, SEI, SPS, PPS or prefix */
+/*                  NAL following a slice, or at a slice with                */
+/*                  first_mb_in_slice 0 following a slice                    */
+/*                                                                           */
+/*  Inputs        : pu1_buf            : Bitstream buffer                    */
+/*                  u4_num_bytes       : Number of bytes in the buffer       */
+/*                  u4_nal_length_size : Size of the NAL unit sizes, 0 for   */
+/*                                       start codes                         */
+/*  Globals       :                                                          */
+/*  Processing    : Scans the start codes or the NAL unit sizes of the       */
+/*                  buffer                                                   */
+/*                                                                           */
+/*  Outputs       :                                                          */
+/*  Returns       : Number of bytes of complete access units, 0 if none      */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 get_au_bytes(UWORD8 *pu1_buf,
+                     UWORD32 u4_num_bytes,
+                     UWORD32 u4_nal_length_size)
+{
+    UWORD32 i, j;
+    UWORD32 u4_au_start = 0;
+    UWORD32 u4_slice_seen = 0;
+
+    for(i = 0; i + u4_nal_length_size + 4 < u4_num_bytes; i++)
+    {
+        UWORD32 u4_nal_type, u4_start, u4_nal_size;
+
+        if(u4_nal_length_size)
+        {
+            u4_nal_size = 0;
+            for(j = 0; j < u4_nal_length_size; j++)
+                u4_nal_size = (u4_nal_size << 8) | pu1_buf[i + j];
+            if((0 == u4_nal_size) || (u4_nal_size > u4_num_bytes))
+                break;
+
+            u4_start = i;
+            i += u4_nal_length_size;
+        }
+        else
+        {
+            if((0 != pu1_buf[i]) || (0 != pu1_buf[i + 1]) || (1 != pu1_buf[i + 2]))
+                continue;
+
+            u4_nal_size = 0;
+            u4_start = ((i > 0) && (0 == pu1_buf[i - 1])) ? (i - 1) : i;
+            i += 3;
+        }
+
+        u4_nal_type = pu1_buf[i] & 0x1F;
+
+        if((u4_nal_type >= 1) && (u4_nal_type <= 5))
+        {
+            /* first_mb_in_slice 0 is coded as a single 1 bit */
+            if(u4_slice_seen && (pu1_buf[i + 1] & 0x80))
+                u4_au_start = u4_start;
+            u4_slice_seen = 1;
+        }
+        else if(((u4_nal_type >= 6) && (u4_nal_type <= 9))
+                        || ((u4_nal_type >= 14) && (u4_nal_type <= 18)))
+        {
+            if(u4_slice_seen)
+                u4_au_start = u4_start;
+            u4_slice_seen = 0;
+        }
+
+        /* Resume at the next NAL unit, or past the start code */
+        i = u4_nal_length_size ? (i + u4_nal_size - 1) : (i - 1);
+    }
+    return u4_au_start;
+}
+
+typedef struct
+{
+    iv_obj_t *codec_obj;
+    vid_dec_ctx_t *ps_app_ctx;
+    FILE *ps_op_file;
+    FILE *ps_op_chksum_file;
+    UWORD32 *pu4_op_frm_ts;
+    UWORD32 u4_max_op_frm_ts;
+    volatile WORD32 i4_done;
+}async_out_ctxt_t;
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : async_output_thread                                      */
+/*                                                                           */
+/*  Description   : Dequeues the decoded frames in display order, dumps      */
+/*                  them and queues the output buffers back till the last    */
+/*                  one is returned                                          */
+/*                                                                           */
+/*  Inputs        : pv_ctxt : Output thread context                          */
+/*  Globals       :                                                          */
+/*  Processing    : Calls dequeue / queue output                             */
+/*                                                                           */
+/*  Outputs       : Decoded frames in the output file                        */
+/*  Returns       : 0                                                        */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 async_output_thread(void *pv_ctxt)
+{
+    async_out_ctxt_t *ps_ctxt = (async_out_ctxt_t *)pv_ctxt;
+    vid_dec_ctx_t *ps_app_ctx = ps_ctxt->ps_app_ctx;
+    WORD32 ret;
+
+    while(1)
+    {
+        ih264d_dequeue_output_ip_t s_dq_ip;
+        ih264d_dequeue_output_op_t s_dq_op;
+        ih264d_queue_output_ip_t s_q_ip;
+        ih264d_queue_output_op_t s_q_op;
+        ivd_dequeue_output_op_t *ps_dq_op = &s_dq_op.s_ivd_dequeue_output_op_t;
+
+        s_dq_ip.s_ivd_dequeue_output_ip_t.e_cmd = IVD_CMD_DEQUEUE_OUTPUT;
+        s_dq_ip.s_ivd_dequeue_output_ip_t.u4_is_blocking = 1;
+        s_dq_ip.s_ivd_dequeue_output_ip_t.u4_size =
+                        sizeof(ih264d_dequeue_output_ip_t);
+        ps_dq_op->u4_size = sizeof(ih264d_dequeue_output_op_t);
+
+        ret = ivd_api_function(ps_ctxt->codec_obj, (void *)&s_dq_ip,
+                               (void *)&s_dq_op);
+        if(IV_SUCCESS != ret)
+        {
+            printf("Error in dequeue output : Error %x\n",
+                   ps_dq_op->u4_error_code);
+            break;
+        }
+
+        if((1 == ps_dq_op->u4_output_present)
+                        && (*ps_ctxt->pu4_op_frm_ts < ps_ctxt->u4_max_op_frm_ts))
+        {
+            CHAR cur_fname[1000];
+            CHAR *extn = NULL;
+            FILE *ps_op_file = ps_ctxt->ps_op_file;
+
+            if(ps_app_ctx->u4_file_save_flag)
+            {
+                extn = strstr(ps_app_ctx->ac_op_fname, "%d");
+                if(extn != NULL)
+                {
+                    output_write_stall(ps_app_ctx->ac_op_fname,
+                                       *ps_ctxt->pu4_op_frm_ts);
+                    sprintf(cur_fname, ps_app_ctx->ac_op_fname,
+                            *ps_ctxt->pu4_op_frm_ts);
+                    ps_op_file = fopen(cur_fname, "wb");
+                    if(NULL == ps_op_file)
+                    {
+                        CHAR ac_error_str[STRLENGTH];
+                        sprintf(ac_error_str, "Could not open output file %s",
+                                cur_fname);
+
+                        codec_exit(ac_error_str);
+                    }
+                }
+            }
+
+            dump_output(ps_app_ctx, &(ps_dq_op->s_disp_frm_buf),
+                        ps_dq_op->u4_disp_buf_id, ps_op_file,
+                        ps_ctxt->ps_op_chksum_file,
+                        *ps_ctxt->pu4_op_frm_ts, ps_app_ctx->u4_file_save_flag,
+                        ps_app_ctx->u4_chksum_save_flag);
+            if(extn != NULL)
+                fclose(ps_op_file);
+            (*ps_ctxt->pu4_op_frm_ts)++;
+        }
+
+        if(1 == ps_dq_op->u4_is_last)
+            break;
+
+        /* Hand the buffer back to the decoder for a later frame */
+        s_q_ip.s_ivd_queue_output_ip_t.e_cmd = IVD_CMD_QUEUE_OUTPUT;
+        s_q_ip.s_ivd_queue_output_ip_t.s_out_buffer = ps_dq_op->s_out_buffer;
+        s_q_ip.s_ivd_queue_output_ip_t.u4_is_blocking = 1;
+        s_q_ip.s_ivd_queue_output_ip_t.u4_size = sizeof(ih264d_queue_output_ip_t);
+        s_q_op.s_ivd_queue_output_op_t.u4_size = sizeof(ih264d_queue_output_op_t);
+
+        ivd_api_function(ps_ctxt->codec_obj, (void *)&s_q_ip, (void *)&s_q_op);
+    }
+
+    ps_ctxt->i4_done = 1;
+    return 0;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : asynchronous_decode                                      */
+/*                                                                           */
+/*  Description   : Decodes the stream through the queue / dequeue calls.    */
+/*                  Bitstream buffers cut at access unit boundaries are      */
+/*                  queued from this thread while a second thread collects   */
+/*                  the decoded frames                                       */
+/*                                                                           */
+/*  Inputs        : codec_obj      : Codec Handle                            */
+/*                  ps_app_ctx     : App context                             */
+/*                  ps_out_buf     : Output buffer used for the header decode*/
+/*                  ps_ip_file     : Input file                              */
+/*                  ps_piclen_file : Picture length file, if used            */
+/*                  file_pos       : Offset of the first byte to be decoded  */
+/*                  u4_ip_buf_len  : Size of a bitstream buffer              */
+/*                  ps_op_file     : Output file                             */
+/*                  ps_op_chksum_file : Checksum file                        */
+/*                  pu4_op_frm_ts  : Number of frames output                 */
+/*                  u4_max_op_frm_ts : Number of frames to be output         */
+/*  Globals       :                                                          */
+/*  Processing    : Calls queue / dequeue input, output handled by           */
+/*                  async_output_thread                                      */
+/*                                                                           */
+/*  Outputs       : Decoded frames in the output file                        */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        :                                                          */
+/*                                                                           */
+/*****************************************************************************/
+void asynchronous_decode(iv_obj_t *codec_obj,
+                         vid_dec_ctx_t *ps_app_ctx,
+                         ivd_out_bufdesc_t *ps_out_buf,
+                         FILE *ps_ip_file,
+                         FILE *ps_piclen_file,
+                         UWORD32 file_pos,
+                         UWORD32 u4_ip_buf_len,
+                         FILE *ps_op_file,
+                         FILE *ps_op_chksum_file,
+                         UWORD32 *pu4_op_frm_ts,
+                         UWORD32 u4_max_op_frm_ts)
+{
+    UWORD8 *apu1_bs_bufs[NUM_ASYNC_BS_BUFS];
+    UWORD8 *apu1_free_bs_bufs[NUM_ASYNC_BS_BUFS];
+    ivd_out_bufdesc_t as_out_bufs[NUM_ASYNC_OUT_BUFS];
+    async_out_ctxt_t s_out_ctxt;
+    void *pv_out_thread;
+    WORD32 i4_num_free_bs_bufs = NUM_ASYNC_BS_BUFS;
+    UWORD32 u4_ip_frm_ts = 0;
+    UWORD32 u4_outlen = 0;
+    UWORD32 i, j;
+    WORD32 ret;
+
+    for(i = 0; i < ps_out_buf->u4_num_bufs; i++)
+        u4_outlen += ps_out_buf->u4_min_out_buf_size[i];
+
+    for(i = 0; i < NUM_ASYNC_OUT_BUFS; i++)
+    {
+        ih264d_queue_output_ip_t s_q_ip;
+        ih264d_queue_output_op_t s_q_op;
+
+        as_out_bufs[i] = *ps_out_buf;
+        as_out_bufs[i].pu1_bufs[0] = (UWORD8 *)malloc(u4_outlen);
+        if(NULL == as_out_bufs[i].pu1_bufs[0])
+            codec_exit("\nAllocation failure for output buffer\n");
+        for(j = 1; j < ps_out_buf->u4_num_bufs; j++)
+            as_out_bufs[i].pu1_bufs[j] = as_out_bufs[i].pu1_bufs[j - 1]
+                            + ps_out_buf->u4_min_out_buf_size[j - 1];
+
+        s_q_ip.s_ivd_queue_output_ip_t.e_cmd = IVD_CMD_QUEUE_OUTPUT;
+        s_q_ip.s_ivd_queue_output_ip_t.s_out_buffer = as_out_bufs[i];
+        s_q_ip.s_ivd_queue_output_ip_t.u4_is_blocking = 0;
+        s_q_ip.s_ivd_queue_output_ip_t.u4_size = sizeof(ih264d_queue_output_ip_t);
+        s_q_op.s_ivd_queue_output_op_t.u4_size = sizeof(ih264d_queue_output_op_t);
+
+        ret = ivd_api_function(codec_obj, (void *)&s_q_ip, (void *)&s_q_op);
+        if(IV_SUCCESS != ret)
+            codec_exit("\nError in queue output\n");
+    }
+
+    for(i = 0; i < NUM_ASYNC_BS_BUFS; i++)
+    {
+        apu1_bs_bufs[i] = (UWORD8 *)malloc(u4_ip_buf_len);
+        if(NULL == apu1_bs_bufs[i])
+            codec_exit("\nAllocation failure for input buffer\n");
+        apu1_free_bs_bufs[i] = apu1_bs_bufs[i];
+    }
+
+    s_out_ctxt.codec_obj = codec_obj;
+    s_out_ctxt.ps_app_ctx = ps_app_ctx;
+    s_out_ctxt.ps_op_file = ps_op_file;
+    s_out_ctxt.ps_op_chksum_file = ps_op_chksum_file;
+    s_out_ctxt.pu4_op_frm_ts = pu4_op_frm_ts;
+    s_out_ctxt.u4_max_op_frm_ts = u4_max_op_frm_ts;
+    s_out_ctxt.i4_done = 0;
+
+    pv_out_thread = malloc(ithread_get_handle_size());
+    if(NULL == pv_out_thread)
+        codec_exit("\nAllocation failure for output thread handle\n");
+    ithread_create(pv_out_thread, NULL, (void *)&async_output_thread,
+                   (void *)&s_out_ctxt);
+
+    while(1)
+    {
+        ih264d_queue_input_ip_t s_q_ip;
+        ih264d_queue_input_op_t s_q_op;
+        ivd_queue_input_ip_t *ps_q_ip = &s_q_ip.s_ivd_queue_input_ip_t;
+        UWORD8 *pu1_bs_buf;
+        UWORD32 u4_num_bytes = 0;
+
+        /* Wait for the decoder to return a bitstream buffer */
+        if(0 == i4_num_free_bs_bufs)
+        {
+            ih264d_dequeue_input_ip_t s_dq_ip;
+            ih264d_dequeue_input_op_t s_dq_op;
+
+            s_dq_ip.s_ivd_dequeue_input_ip_t.e_cmd = IVD_CMD_DEQUEUE_INPUT;
+            s_dq_ip.s_ivd_dequeue_input_ip_t.u4_is_blocking = 1;
+            s_dq_ip.s_ivd_dequeue_input_ip_t.u4_size =
+                            sizeof(ih264d_dequeue_input_ip_t);
+            s_dq_op.s_ivd_dequeue_input_op_t.u4_size =
+                            sizeof(ih264d_dequeue_input_op_t);
+
+            ret = ivd_api_function(codec_obj, (void *)&s_dq_ip,
+                                   (void *)&s_dq_op);
+            if(IV_SUCCESS != ret)
+                break;
+
+            apu1_free_bs_bufs[i4_num_free_bs_bufs++] =
+                            s_dq_op.s_ivd_dequeue_input_op_t.pv_stream_buffer;
+            continue;
+        }
+
+        pu1_bs_buf = apu1_free_bs_bufs[--i4_num_free_bs_bufs];
+
+        if((*pu4_op_frm_ts < u4_max_op_frm_ts) && (0 == s_out_ctxt.i4_done))
+        {
+            if(0 == ps_app_ctx->u4_piclen_flag)
+            {
+                fseek(ps_ip_file, file_pos, SEEK_SET);
+                u4_num_bytes = fread(pu1_bs_buf, sizeof(UWORD8), u4_ip_buf_len,
+                                     ps_ip_file);
+
+                /* Keep the trailing partial access unit for the next buffer */
+                if(u4_num_bytes == u4_ip_buf_len)
+                {
+                    UWORD32 u4_au_bytes = get_au_bytes(pu1_bs_buf, u4_num_bytes,
+                                                       ps_app_ctx->u4_nal_length_size);
+                    if(u4_au_bytes)
+                        u4_num_bytes = u4_au_bytes;
+                }
+                file_pos += u4_num_bytes;
+            }
+            else
+            {
+                WORD32 numbytes;
+                WORD32 entries;
+
+                entries = fscanf(ps_piclen_file, "%d\n", &numbytes);
+                if((1 != entries) || (numbytes > (WORD32)u4_ip_buf_len))
+                    numbytes = u4_ip_buf_len;
+                u4_num_bytes = fread(pu1_bs_buf, sizeof(UWORD8), numbytes,
+                                     ps_ip_file);
+            }
+        }
+
+        ps_q_ip->e_cmd = IVD_CMD_QUEUE_INPUT;
+        ps_q_ip->u4_ts = u4_ip_frm_ts++;
+        ps_q_ip->u4_num_Bytes = u4_num_bytes;
+        ps_q_ip->pv_stream_buffer = u4_num_bytes ? pu1_bs_buf : NULL;
+        ps_q_ip->u4_is_last = (0 == u4_num_bytes);
+        ps_q_ip->u4_is_blocking = 1;
+        ps_q_ip->u4_size = sizeof(ih264d_queue_input_ip_t);
+        s_q_op.s_ivd_queue_input_op_t.u4_size = sizeof(ih264d_queue_input_op_t);
+
+        ret = ivd_api_function(codec_obj, (void *)&s_q_ip, (void *)&s_q_op);
+        if(0 == u4_num_bytes)
+            apu1_free_bs_bufs[i4_num_free_bs_bufs++] = pu1_bs_buf;
+
+        if((IV_SUCCESS != ret) || (0 == u4_num_bytes))
+            break;
+    }
+
+    ithread_join(pv_out_thread, NULL);
+    free(pv_out_thread);
+
+    /* The decoder has returned every buffer once the last frame is out */
+    for(i = 0; i < NUM_ASYNC_BS_BUFS; i++)
+        free(apu1_bs_bufs[i]);
+
+    for(i = 0; i < NUM_ASYNC_OUT_BUFS; i++)
+        free(as_out_bufs[i].pu1_bufs[0]);
+}
+
 #ifdef X86_MINGW
 void sigsegv_handler()
 {
@@ -1887,6 +2506,12 @@ int main(WORD32 argc, CHAR *argv[])
 #endif
     s_app_ctx.u4_share_disp_buf = DEFAULT_SHARE_DISPLAY_BUF;
     s_app_ctx.u4_num_cores = DEFAULT_NUM_CORES;
+    s_app_ctx.u4_async = 0;
+    s_app_ctx.u4_num_affinity_cpus = 0;
+    s_app_ctx.u4_stats = 0;
+    s_app_ctx.u4_nal_length_size = 0;
+    s_app_ctx.pu1_avcc = NULL;
+    s_app_ctx.u4_avcc_size = 0;
     s_app_ctx.i4_degrade_type = 0;
     s_app_ctx.i4_degrade_pics = 0;
     s_app_ctx.e_arch = ARCH_ARM_A9Q;
@@ -2025,6 +2650,31 @@ int main(WORD32 argc, CHAR *argv[])
         printf("\nNo input file given for decoding\n");
         exit(-1);
     }
+    if((1 == s_app_ctx.u4_async) && (s_app_ctx.u4_share_disp_buf ||
+                    s_app_ctx.display || s_app_ctx.loopback))
+    {
+        printf("\nAsync decode is not supported with shared display buffers, display or loopback\n");
+        exit(-1);
+    }
+
+    /* Pin the app thread before the decoder memory is allocated and first
+     * touched, so that it is placed on the NUMA node of the given CPUs */
+    if(s_app_ctx.u4_num_affinity_cpus)
+    {
+        WORD32 ai4_cpus[IH264D_MAX_AFFINITY_CPUS];
+        UWORD32 u4_cpu;
+
+        for(u4_cpu = 0; u4_cpu < s_app_ctx.u4_num_affinity_cpus; u4_cpu++)
+        {
+            ai4_cpus[u4_cpu] = s_app_ctx.au4_affinity_cpus[u4_cpu];
+        }
+        if(0 != ithread_set_affinity_list(ai4_cpus,
+                                          s_app_ctx.u4_num_affinity_cpus))
+        {
+            printf("\nUnable to pin to the CPU list\n");
+            exit(-1);
+        }
+    }
 
 
 
@@ -2043,6 +2693,17 @@ int main(WORD32 argc, CHAR *argv[])
                 s_app_ctx.ac_ip_fname);
         codec_exit(ac_error_str);
     }
+    if(s_app_ctx.u4_nal_length_size)
+    {
+        if(1 == s_app_ctx.u4_piclen_flag)
+        {
+            codec_exit("\nNAL length size is not supported with piclen");
+        }
+        ps_ip_file = to_length_prefixed(ps_ip_file,
+                                        s_app_ctx.u4_nal_length_size,
+                                        &s_app_ctx.pu1_avcc,
+                                        &s_app_ctx.u4_avcc_size);
+    }
     /***********************************************************************/
     /*          create the file object for input file                      */
     /***********************************************************************/
@@ -2203,6 +2864,89 @@ int main(WORD32 argc, CHAR *argv[])
 
     }
 
+    /*************************************************************************/
+    /* set cpu affinity                                                      */
+    /*************************************************************************/
+    if(s_app_ctx.u4_num_affinity_cpus)
+    {
+
+        ih264d_ctl_set_cpu_affinity_ip_t s_ctl_set_cpu_affinity_ip;
+        ih264d_ctl_set_cpu_affinity_op_t s_ctl_set_cpu_affinity_op;
+
+        s_ctl_set_cpu_affinity_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_cpu_affinity_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_CPU_AFFINITY;
+        s_ctl_set_cpu_affinity_ip.u4_num_cpus = s_app_ctx.u4_num_affinity_cpus;
+        memcpy(s_ctl_set_cpu_affinity_ip.au4_cpu_ids, s_app_ctx.au4_affinity_cpus,
+               s_app_ctx.u4_num_affinity_cpus * sizeof(UWORD32));
+        s_ctl_set_cpu_affinity_ip.u4_size = sizeof(ih264d_ctl_set_cpu_affinity_ip_t);
+        s_ctl_set_cpu_affinity_op.u4_size = sizeof(ih264d_ctl_set_cpu_affinity_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_cpu_affinity_ip,
+                                   (void *)&s_ctl_set_cpu_affinity_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting cpu affinity");
+            codec_exit(ac_error_str);
+        }
+
+    }
+
+    /*************************************************************************/
+    /* enable decode statistics                                              */
+    /*************************************************************************/
+    if(s_app_ctx.u4_stats)
+    {
+
+        ih264d_ctl_set_stats_ip_t s_ctl_set_stats_ip;
+        ih264d_ctl_set_stats_op_t s_ctl_set_stats_op;
+
+        s_ctl_set_stats_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_stats_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_STATS;
+        s_ctl_set_stats_ip.u4_enable_stats = 1;
+        s_ctl_set_stats_ip.u4_reset_stats = 1;
+        s_ctl_set_stats_ip.u4_size = sizeof(ih264d_ctl_set_stats_ip_t);
+        s_ctl_set_stats_op.u4_size = sizeof(ih264d_ctl_set_stats_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_stats_ip,
+                                   (void *)&s_ctl_set_stats_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in enabling statistics");
+            codec_exit(ac_error_str);
+        }
+
+    }
+
+    /*************************************************************************/
+    /* set length prefixed NAL units and the avcC record                     */
+    /*************************************************************************/
+    if(s_app_ctx.u4_nal_length_size)
+    {
+
+        ih264d_ctl_set_nal_format_ip_t s_ctl_set_nal_format_ip;
+        ih264d_ctl_set_nal_format_op_t s_ctl_set_nal_format_op;
+
+        s_ctl_set_nal_format_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_nal_format_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_SET_NAL_FORMAT;
+        s_ctl_set_nal_format_ip.u4_nal_length_size = s_app_ctx.u4_nal_length_size;
+        s_ctl_set_nal_format_ip.pv_avcc = s_app_ctx.pu1_avcc;
+        s_ctl_set_nal_format_ip.u4_avcc_size = s_app_ctx.u4_avcc_size;
+        s_ctl_set_nal_format_ip.u4_size = sizeof(ih264d_ctl_set_nal_format_ip_t);
+        s_ctl_set_nal_format_op.u4_size = sizeof(ih264d_ctl_set_nal_format_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_nal_format_ip,
+                                   (void *)&s_ctl_set_nal_format_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting the NAL format");
+            codec_exit(ac_error_str);
+        }
+
+        /* The decoder keeps its own copy of the record */
+        free(s_app_ctx.pu1_avcc);
+        s_app_ctx.pu1_avcc = NULL;
+    }
+
     /*************************************************************************/
     /* set processsor                                                        */
     /*************************************************************************/
@@ -2228,6 +2972,29 @@ int main(WORD32 argc, CHAR *argv[])
 
     }
 
+    /*************************************************************************/
+    /* get processsor type in use                                            */
+    /*************************************************************************/
+    {
+
+        ih264d_ctl_get_processor_ip_t s_ctl_get_processor_ip;
+        ih264d_ctl_get_processor_op_t s_ctl_get_processor_op;
+
+        s_ctl_get_processor_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_get_processor_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_PROCESSOR;
+        s_ctl_get_processor_ip.u4_size = sizeof(ih264d_ctl_get_processor_ip_t);
+        s_ctl_get_processor_op.u4_size = sizeof(ih264d_ctl_get_processor_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_get_processor_ip,
+                                   (void *)&s_ctl_get_processor_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in getting Processor type");
+            codec_exit(ac_error_str);
+        }
+        printf("Processor type in use: 0x%x\n", s_ctl_get_processor_op.u4_arch);
+    }
+
     flush_output(codec_obj, &s_app_ctx, ps_out_buf,
                  pu1_bs_buf, &u4_op_frm_ts,
                  ps_op_file, ps_op_chksum_file,
@@ -2685,7 +3452,15 @@ int main(WORD32 argc, CHAR *argv[])
 
     u4_num_disp_bufs_with_dec = 0;
 
-    while(u4_op_frm_ts < max_op_frm_ts)
+    if(1 == s_app_ctx.u4_async)
+    {
+        asynchronous_decode(codec_obj, &s_app_ctx, ps_out_buf, ps_ip_file,
+                            ps_piclen_file, file_pos, u4_ip_buf_len,
+                            ps_op_file, ps_op_chksum_file, &u4_op_frm_ts,
+                            max_op_frm_ts);
+    }
+
+    while((0 == s_app_ctx.u4_async) && (u4_op_frm_ts < max_op_frm_ts))
     {
 
 #ifdef TEST_FLUSH
@@ -3072,14 +3847,65 @@ int main(WORD32 argc, CHAR *argv[])
     /***********************************************************************/
     /*      To get the last decoded frames, call process with NULL input    */
     /***********************************************************************/
-    flush_output(codec_obj, &s_app_ctx, ps_out_buf,
-                 pu1_bs_buf, &u4_op_frm_ts,
-                 ps_op_file, ps_op_chksum_file,
-                 u4_ip_frm_ts, u4_bytes_remaining);
+    if(0 == s_app_ctx.u4_async)
+    {
+        flush_output(codec_obj, &s_app_ctx, ps_out_buf,
+                     pu1_bs_buf, &u4_op_frm_ts,
+                     ps_op_file, ps_op_chksum_file,
+                     u4_ip_frm_ts, u4_bytes_remaining);
+    }
 
     /* set disp_end u4_flag */
     s_app_ctx.quit = 1;
 
+    if(s_app_ctx.u4_stats)
+    {
+        static const CHAR *apc_stage_names[IH264D_STATS_NUM_STAGES] =
+            { "NAL parse", "Slice parse", "Recon", "BS compute", "Deblock",
+              "Format conv" };
+        static const CHAR *apc_thread_names[IH264D_STATS_NUM_THREADS] =
+            { "Parse", "Decode", "BS / Deblock" };
+        ih264d_ctl_get_stats_ip_t s_ctl_get_stats_ip;
+        ih264d_ctl_get_stats_op_t s_ctl_get_stats_op;
+        WORD32 i;
+
+        s_ctl_get_stats_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_get_stats_ip.e_sub_cmd =(IVD_CONTROL_API_COMMAND_TYPE_T) IH264D_CMD_CTL_GET_STATS;
+        s_ctl_get_stats_ip.u4_size = sizeof(ih264d_ctl_get_stats_ip_t);
+        s_ctl_get_stats_op.u4_size = sizeof(ih264d_ctl_get_stats_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_get_stats_ip,
+                                   (void *)&s_ctl_get_stats_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in getting statistics");
+            codec_exit(ac_error_str);
+        }
+
+        printf("Decode calls                    : %d\n",
+               s_ctl_get_stats_op.u4_num_decode_calls);
+        printf("Pictures decoded                : %d\n",
+               s_ctl_get_stats_op.u4_num_pics_decoded);
+        printf("Bytes consumed                  : %lld\n",
+               (long long)s_ctl_get_stats_op.u8_num_bytes);
+        printf("CABAC context inits             : %d\n",
+               s_ctl_get_stats_op.u4_num_cabac_ctxt_inits);
+        printf("Decode time(micro sec)          : %lld\n",
+               (long long)(s_ctl_get_stats_op.u8_decode_ns / 1000));
+        for(i = 0; i < IH264D_STATS_NUM_STAGES; i++)
+        {
+            printf("Stage %-12s(micro sec)   : %lld\n", apc_stage_names[i],
+                   (long long)(s_ctl_get_stats_op.au8_stage_ns[i] / 1000));
+        }
+        for(i = 0; i < IH264D_STATS_NUM_THREADS; i++)
+        {
+            printf("Thread %-12s busy / wait(micro sec) : %lld / %lld\n",
+                   apc_thread_names[i],
+                   (long long)(s_ctl_get_stats_op.au8_thread_busy_ns[i] / 1000),
+                   (long long)(s_ctl_get_stats_op.au8_thread_wait_ns[i] / 1000));
+        }
+    }
+
 
 #ifdef PROFILE_ENABLE
     printf("Summary\n");
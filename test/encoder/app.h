@@ -82,6 +82,7 @@
 #define DEFAULT_MAX_FRAMERATE       120000
 #define DEFAULT_NUM_CORES           1
 #define DEFAULT_NUM_CORES_PRE_ENC   0
+#define MAX_AFFINITY_CPUS           64
 #define DEFAULT_FPS                 30
 #define DEFAULT_ENC_SPEED           100
 
@@ -219,6 +220,15 @@ typedef struct
     UWORD32 u4_chksum_enable;
     UWORD32 u4_mb_info_type;
     UWORD32 u4_pic_info_type;
+    UWORD32 u4_keep_threads_active;
+    UWORD32 u4_lookahead;
+    void *pv_rc_stats;
+    UWORD32 u4_rc_stats_size;
+    UWORD32 u4_frame_pipelining;
+    UWORD32 u4_async;
+    UWORD32 u4_num_affinity_cpus;
+    UWORD32 au4_affinity_cpus[MAX_AFFINITY_CPUS];
+    UWORD32 u4_stats;
     UWORD32 u4_mb_info_size;
     UWORD32 u4_pic_info_size;
     UWORD32 u4_start_frm;
@@ -242,6 +252,7 @@ typedef struct
     CHAR ac_chksum_fname[STRLENGTH];
     CHAR ac_mb_info_fname[STRLENGTH];
     CHAR ac_pic_info_fname[STRLENGTH];
+    CHAR ac_rc_stats_fname[STRLENGTH];
 
 
     FILE *fp_ip;
@@ -251,6 +262,7 @@ typedef struct
     FILE *fp_psnr_ip;
     FILE *fp_mb_info;
     FILE *fp_pic_info;
+    FILE *fp_rc_stats;
     FILE *fp_dump_op;
 
 
@@ -319,6 +331,7 @@ typedef struct
     TIMER   enc_start_time;
     TIMER   enc_last_time;
     WORD32  avg_time;
+    WORD32  max_time;
 
 
 } app_ctxt_t;
@@ -345,6 +358,9 @@ void free_input(app_ctxt_t *ps_app_ctxt);
 void free_recon(app_ctxt_t *ps_app_ctxt);
 void free_output(app_ctxt_t *ps_app_ctxt);
 
+void get_stats(iv_obj_t *ps_enc, ih264e_ctl_get_stats_op_t *ps_stats_op);
+void print_stats(ih264e_ctl_get_stats_op_t *ps_stats_op, WORD32 i4_frame);
+
 void init_raw_buf_descr(app_ctxt_t *ps_app_ctxt, iv_raw_buf_t *ps_raw_buf, UWORD8 *pu1_buf, IV_COLOR_FORMAT_T e_color_fmt);
 
 #ifndef MD5_DISABLE
@@ -43,6 +43,7 @@
 #include "iv2.h"
 #include "ive2.h"
 #include "ih264e.h"
+#include "ithread.h"
 #include "app.h"
 #include "psnr.h"
 
@@ -126,6 +127,13 @@ typedef enum
     MB_INFO_TYPE,
     PIC_INFO_FILE,
     PIC_INFO_TYPE,
+    KEEP_THREADS_ACTIVE,
+    LOOKAHEAD,
+    RC_STATS_FILE,
+    FRAME_PIPELINING,
+    ASYNC,
+    CPU_LIST,
+    STATS,
 } ARGUMENT_T;
 
 typedef struct
@@ -151,7 +159,7 @@ static const argument_t argument_mapping[] =
                 { "-h", "--height", HT, "Height file\n" },
                 { "--", "--start_frame", START_FRM,  "Starting frame number\n" },
                 { "-f", "--num_frames", NUM_FRMS,  "Number of frames to be encoded\n" },
-                { "--", "--rc", RC, "Rate control mode 0: Constant Qp, 1: Storage, 2: CBR non low delay, 3: CBR low delay \n" },
+                { "--", "--rc", RC, "Rate control mode 0: Constant Qp, 1: Storage, 2: CBR non low delay, 3: CBR low delay, 4: Two pass \n" },
                 { "--", "--max_framerate", MAX_FRAMERATE, "Maximum frame rate \n" },
                 { "--", "--tgt_framerate", TGT_FRAMERATE, "Target frame rate \n" },
                 { "--", "--src_framerate", SRC_FRAMERATE, "Source frame rate \n" },
@@ -180,7 +188,7 @@ static const argument_t argument_mapping[] =
                 { "--", "--max_wd",      MAX_WD,                "Maximum width (Default: 1920) \n" },
                 { "--", "--max_ht",      MAX_HT,                "Maximum height (Default: 1088)\n" },
                 { "--", "--max_level",   MAX_LEVEL,             "Maximum Level (Default: 50)\n" },
-                { "--", "--arch", ARCH, "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, X86_GENERIC, X86_SSSE3, X86_SSE4 \n" },
+                { "--", "--arch", ARCH, "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, ARM_A53, ARM_A57, ARM_V8_NEON, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2 \n" },
                 { "--", "--soc", SOC, "Set SOC. Supported values  GENERIC, HISI_37X \n" },
                 { "--", "--chksum",            CHKSUM_FILE,              "Save Check sum file for recon data\n" },
                 { "--", "--chksum_enable",          CHKSUM_ENABLE,               "Recon MD5 Checksum file\n"},
@@ -206,6 +214,13 @@ static const argument_t argument_mapping[] =
                 { "--", "--mb_info_type",     MB_INFO_TYPE,              "MB info type\n"},
                 { "--", "--pic_info_file",     PIC_INFO_FILE,              "Pic info file\n"},
                 { "--", "--pic_info_type",     PIC_INFO_TYPE,              "Pic info type\n"},
+                { "--", "--keep_threads_active", KEEP_THREADS_ACTIVE,      "Keep threads active across encode calls\n"},
+                { "--", "--lookahead",           LOOKAHEAD,                "Number of frames analysed ahead for scene cut detection, 0 disables\n"},
+                { "--", "--rc_stats_file",       RC_STATS_FILE,            "Rate control stats file, read with --rc 4 and written otherwise\n"},
+                { "--", "--frame_pipelining",    FRAME_PIPELINING,         "Overlap entropy coding of a frame with analysis of the next, used with --rc 0\n"},
+                { "--", "--async",               ASYNC,                    "Use the queue / dequeue API, recon, checksum and psnr are not supported\n"},
+                { "--", "--cpu_list",            CPU_LIST,                 "Comma separated CPUs the app and encoder threads are pinned to\n"},
+                { "--", "--stats",               STATS,                    "Print per frame stage times, bits, qp and skip mbs (frames are not listed with --async)\n"},
         };
 
 
@@ -433,6 +448,38 @@ void print_usage(void)
     }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : get_cpu_list                                             */
+/*                                                                           */
+/*  Description   : Parses a comma separated list of CPUs                    */
+/*                                                                           */
+/*  Inputs        : value       - CPU list string                            */
+/*                  pu4_cpu_ids - Parsed CPUs                                */
+/*  Globals       :                                                          */
+/*  Processing    :                                                          */
+/*                                                                           */
+/*  Outputs       : pu4_cpu_ids                                              */
+/*  Returns       : Number of CPUs in the list                               */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 get_cpu_list(CHAR *value, UWORD32 *pu4_cpu_ids)
+{
+    UWORD32 u4_num_cpus = 0;
+    CHAR *pc_end;
+
+    while((u4_num_cpus < MAX_AFFINITY_CPUS) && (*value != '\0'))
+    {
+        pu4_cpu_ids[u4_num_cpus++] = strtoul(value, &pc_end, 10);
+        if((pc_end == value) || ((*pc_end != ',') && (*pc_end != '\0')))
+        {
+            codec_exit("Invalid CPU list\n");
+        }
+        value = (*pc_end == ',') ? pc_end + 1 : pc_end;
+    }
+    return u4_num_cpus;
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : get_argument                                             */
@@ -553,6 +600,35 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
         sscanf(value, "%d", &ps_app_ctxt->u4_pic_info_type);
         break;
 
+      case KEEP_THREADS_ACTIVE:
+        sscanf(value, "%d", &ps_app_ctxt->u4_keep_threads_active);
+        break;
+
+      case LOOKAHEAD:
+        sscanf(value, "%d", &ps_app_ctxt->u4_lookahead);
+        break;
+
+      case RC_STATS_FILE:
+        sscanf(value, "%s", ps_app_ctxt->ac_rc_stats_fname);
+        break;
+
+      case FRAME_PIPELINING:
+        sscanf(value, "%d", &ps_app_ctxt->u4_frame_pipelining);
+        break;
+
+      case ASYNC:
+        sscanf(value, "%d", &ps_app_ctxt->u4_async);
+        break;
+
+      case CPU_LIST:
+        ps_app_ctxt->u4_num_affinity_cpus = get_cpu_list(value,
+                                                         ps_app_ctxt->au4_affinity_cpus);
+        break;
+
+      case STATS:
+        sscanf(value, "%d", &ps_app_ctxt->u4_stats);
+        break;
+
       case INPUT_CHROMA_FORMAT:
         ps_app_ctxt->e_inp_color_fmt = get_chroma_fmt(value);
         break;
@@ -688,6 +764,8 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
               ps_app_ctxt->e_arch = ARCH_X86_SSSE3;
           else if((strcmp(value, "X86_SSE42")) == 0)
               ps_app_ctxt->e_arch = ARCH_X86_SSE42;
+          else if((strcmp(value, "X86_AVX2")) == 0)
+              ps_app_ctxt->e_arch = ARCH_X86_AVX2;
           else if((strcmp(value, "ARM_A53")) == 0)
               ps_app_ctxt->e_arch = ARCH_ARM_A53;
           else if((strcmp(value, "ARM_A57")) == 0)
@@ -900,6 +978,11 @@ void validate_params(app_ctxt_t *ps_app_ctxt)
         sprintf(ac_error, "Invalid number of frames to be encoded: %d", ps_app_ctxt->u4_max_num_frms);
         invalid_argument_exit(ac_error);
     }
+    if((1 == ps_app_ctxt->u4_async) && (ps_app_ctxt->u4_recon_enable
+                    || ps_app_ctxt->u4_chksum_enable || ps_app_ctxt->u4_psnr_enable))
+    {
+        invalid_argument_exit("Recon, checksum and psnr are not supported with --async");
+    }
     if ((0 != (WORD32)ps_app_ctxt->u4_entropy_coding_mode)
                     && (1 != (WORD32)ps_app_ctxt->u4_entropy_coding_mode))
     {
@@ -920,11 +1003,20 @@ void init_default_params(app_ctxt_t *ps_app_ctxt)
     ps_app_ctxt->u4_chksum_enable        = DEFAULT_CHKSUM_ENABLE;
     ps_app_ctxt->u4_mb_info_type         = 0;
     ps_app_ctxt->u4_pic_info_type        = 0;
+    ps_app_ctxt->u4_keep_threads_active  = 0;
+    ps_app_ctxt->u4_lookahead            = 0;
+    ps_app_ctxt->pv_rc_stats             = NULL;
+    ps_app_ctxt->u4_rc_stats_size        = 0;
+    ps_app_ctxt->u4_frame_pipelining     = 0;
+    ps_app_ctxt->u4_async                = 0;
+    ps_app_ctxt->u4_num_affinity_cpus    = 0;
+    ps_app_ctxt->u4_stats                = 0;
     ps_app_ctxt->u4_mb_info_size         = 0;
     ps_app_ctxt->u4_pic_info_size        = 0;
     ps_app_ctxt->u4_start_frm            = DEFAULT_START_FRM;
     ps_app_ctxt->u4_max_num_frms         = DEFAULT_NUM_FRMS;
     ps_app_ctxt->avg_time                = 0;
+    ps_app_ctxt->max_time                = 0;
     ps_app_ctxt->u4_total_bytes          = 0;
     ps_app_ctxt->u4_pics_cnt             = 0;
     ps_app_ctxt->e_inp_color_fmt         = DEFAULT_INP_COLOR_FMT;
@@ -941,6 +1033,7 @@ void init_default_params(app_ctxt_t *ps_app_ctxt)
     ps_app_ctxt->ac_recon_fname[0]       = '\0';
     ps_app_ctxt->ac_chksum_fname[0]      = '\0';
     ps_app_ctxt->ac_mb_info_fname[0]     = '\0';
+    ps_app_ctxt->ac_rc_stats_fname[0]    = '\0';
     ps_app_ctxt->fp_ip                   = NULL;
     ps_app_ctxt->fp_op                   = NULL;
     ps_app_ctxt->fp_recon                = NULL;
@@ -948,6 +1041,7 @@ void init_default_params(app_ctxt_t *ps_app_ctxt)
     ps_app_ctxt->fp_psnr_ip              = NULL;
     ps_app_ctxt->fp_mb_info              = NULL;
     ps_app_ctxt->fp_pic_info             = NULL;
+    ps_app_ctxt->fp_rc_stats             = NULL;
     ps_app_ctxt->u4_loopback             = DEFAULT_LOOPBACK;
     ps_app_ctxt->u4_max_frame_rate       = DEFAULT_MAX_FRAMERATE;
     ps_app_ctxt->u4_src_frame_rate       = DEFAULT_SRC_FRAME_RATE;
@@ -1506,6 +1600,123 @@ void set_vui_params(app_ctxt_t *ps_app_ctxt)
 }
 #define PEAK_WINDOW_SIZE    8
 
+void init_input_buf_descr(app_ctxt_t *ps_app_ctxt,
+                          iv_raw_buf_t *ps_inp_raw_buf,
+                          UWORD8 *pu1_buf)
+{
+    /*
+     * Since the buffers are used for reading,
+     * And after each row we have a stride we nned to calculate
+     * the luma size according to the stride
+     */
+    ps_inp_raw_buf->e_color_fmt = ps_app_ctxt->e_inp_color_fmt;
+
+    /* Initialize for 420SP */
+    if(IV_YUV_420SP_UV == ps_app_ctxt->e_inp_color_fmt||
+                    IV_YUV_420SP_VU == ps_app_ctxt->e_inp_color_fmt)
+    {
+        /*init luma buffer*/
+        ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
+
+        /*Init chroma buffer*/
+        pu1_buf += ps_app_ctxt->u4_strd * ps_app_ctxt->u4_ht;
+        ps_inp_raw_buf->apv_bufs[1] = pu1_buf;
+
+        ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd;
+        ps_inp_raw_buf->au4_wd[1] =  ps_app_ctxt->u4_wd;
+
+        ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
+        ps_inp_raw_buf->au4_ht[1] =  ps_app_ctxt->u4_ht / 2;
+
+        ps_inp_raw_buf->au4_strd[0] =  ps_app_ctxt->u4_strd;
+        ps_inp_raw_buf->au4_strd[1] =  ps_app_ctxt->u4_strd;
+    }
+    else if(IV_YUV_420P == ps_app_ctxt->e_inp_color_fmt)
+    {
+        /* init buffers */
+        ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
+        pu1_buf += (ps_app_ctxt->u4_wd) * ps_app_ctxt->u4_ht;
+        ps_inp_raw_buf->apv_bufs[1] = pu1_buf;
+        pu1_buf += (ps_app_ctxt->u4_wd >> 1) * (ps_app_ctxt->u4_ht >> 1);
+        ps_inp_raw_buf->apv_bufs[2] = pu1_buf;
+
+        ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd;
+        ps_inp_raw_buf->au4_wd[1] =  ps_app_ctxt->u4_wd / 2;
+        ps_inp_raw_buf->au4_wd[2] =  ps_app_ctxt->u4_wd / 2;
+
+        ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
+        ps_inp_raw_buf->au4_ht[1] =  ps_app_ctxt->u4_ht / 2;
+        ps_inp_raw_buf->au4_ht[2] =  ps_app_ctxt->u4_ht / 2;
+
+        ps_inp_raw_buf->au4_strd[0] =  ps_app_ctxt->u4_strd;
+        ps_inp_raw_buf->au4_strd[1] =  ps_app_ctxt->u4_strd / 2;
+        ps_inp_raw_buf->au4_strd[2] =  ps_app_ctxt->u4_strd / 2;
+
+    }
+    else if(IV_YUV_422ILE == ps_app_ctxt->e_inp_color_fmt)
+    {
+        /*init luma buffer*/
+        ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
+
+        ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd * 2;
+
+        ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
+
+        ps_inp_raw_buf->au4_strd[0] = ps_app_ctxt->u4_strd *2;
+    }
+}
+
+void get_stats(iv_obj_t *ps_enc, ih264e_ctl_get_stats_op_t *ps_stats_op)
+{
+    ih264e_ctl_get_stats_ip_t s_stats_ip;
+    IV_STATUS_T status;
+
+    s_stats_ip.e_cmd = IVE_CMD_VIDEO_CTL;
+    s_stats_ip.e_sub_cmd = (IVE_CONTROL_API_COMMAND_TYPE_T)IH264E_CMD_CTL_GET_STATS;
+    s_stats_ip.u4_size = sizeof(ih264e_ctl_get_stats_ip_t);
+    ps_stats_op->u4_size = sizeof(ih264e_ctl_get_stats_op_t);
+
+    status = ih264e_api_function(ps_enc, &s_stats_ip, ps_stats_op);
+    if(IV_SUCCESS != status)
+    {
+        CHAR ac_error[STRLENGTH];
+        sprintf(ac_error, "Unable to get statistics = 0x%x\n",
+                ps_stats_op->u4_error_code);
+        codec_exit(ac_error);
+    }
+}
+
+/* prints the last frame returned, or the totals if i4_frame is negative */
+void print_stats(ih264e_ctl_get_stats_op_t *ps_stats_op, WORD32 i4_frame)
+{
+    static const CHAR *apc_stage_names[IH264E_STATS_NUM_STAGES] =
+        { "ME", "IntraEval", "CoreCoding", "Entropy", "DblkPadHpel", "RC" };
+    UWORD64 *pu8_stage_ns = ps_stats_op->au8_stage_ns;
+    UWORD64 u8_wait_ns = ps_stats_op->u8_wait_ns;
+    WORD32 i;
+
+    if(i4_frame >= 0)
+    {
+        pu8_stage_ns = ps_stats_op->au8_frame_stage_ns;
+        u8_wait_ns = ps_stats_op->u8_frame_wait_ns;
+        printf("Frame %4d type %d qp %2d bits %8d sad %9d skip %5d / %-5d",
+               i4_frame, ps_stats_op->u4_frame_type, ps_stats_op->u4_frame_qp,
+               ps_stats_op->u4_frame_bits, ps_stats_op->u4_frame_sad,
+               ps_stats_op->u4_frame_num_skip_mbs, ps_stats_op->u4_frame_num_mbs);
+    }
+    else
+    {
+        printf("Frames %d bits %lld, time in stages", ps_stats_op->u4_num_frames,
+               (long long)ps_stats_op->u8_num_bits);
+    }
+
+    for(i = 0; i < IH264E_STATS_NUM_STAGES; i++)
+    {
+        printf(" %s %lld", apc_stage_names[i], (long long)(pu8_stage_ns[i] / 1000));
+    }
+    printf(" Wait %lld (micro sec)\n", (long long)(u8_wait_ns / 1000));
+}
+
 void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
 {
     ih264e_video_encode_ip_t ih264e_video_encode_ip;
@@ -1616,6 +1827,17 @@ void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
         }
     }
 
+    /* A first pass writes the rc stats of every encoded frame */
+    if((IVE_RC_TWOPASS != ps_app_ctxt->u4_rc) && (ps_app_ctxt->ac_rc_stats_fname[0] != '\0'))
+    {
+        ps_app_ctxt->fp_rc_stats = fopen(ps_app_ctxt->ac_rc_stats_fname, "wb");
+        if(NULL == ps_app_ctxt->fp_rc_stats)
+        {
+            sprintf(ac_error, "Unable to open rc stats file for writing: %s", ps_app_ctxt->ac_rc_stats_fname);
+            invalid_argument_exit(ac_error);
+        }
+    }
+
     GETTIME(&ps_app_ctxt->enc_start_time);
     ps_app_ctxt->enc_last_time = ps_app_ctxt->enc_start_time;
 
@@ -1652,66 +1874,7 @@ void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
         ps_video_encode_ip->pv_mb_info = pv_mb_info;
         ps_video_encode_ip->pv_pic_info = pv_pic_info;
         ps_video_encode_ip->u4_pic_info_type = ps_app_ctxt->u4_pic_info_type;
-        /*
-         * Since the buffers are used for reading,
-         * And after each row we have a stride we nned to calculate
-         * the luma size according to the stride
-         */
-        ps_inp_raw_buf->e_color_fmt = ps_app_ctxt->e_inp_color_fmt;
-
-        /* Initialize for 420SP */
-        if(IV_YUV_420SP_UV == ps_app_ctxt->e_inp_color_fmt||
-                        IV_YUV_420SP_VU == ps_app_ctxt->e_inp_color_fmt)
-        {
-            /*init luma buffer*/
-            ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
-
-            /*Init chroma buffer*/
-            pu1_buf += ps_app_ctxt->u4_strd * ps_app_ctxt->u4_ht;
-            ps_inp_raw_buf->apv_bufs[1] = pu1_buf;
-
-            ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd;
-            ps_inp_raw_buf->au4_wd[1] =  ps_app_ctxt->u4_wd;
-
-            ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
-            ps_inp_raw_buf->au4_ht[1] =  ps_app_ctxt->u4_ht / 2;
-
-            ps_inp_raw_buf->au4_strd[0] =  ps_app_ctxt->u4_strd;
-            ps_inp_raw_buf->au4_strd[1] =  ps_app_ctxt->u4_strd;
-        }
-        else if(IV_YUV_420P == ps_app_ctxt->e_inp_color_fmt)
-        {
-            /* init buffers */
-            ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
-            pu1_buf += (ps_app_ctxt->u4_wd) * ps_app_ctxt->u4_ht;
-            ps_inp_raw_buf->apv_bufs[1] = pu1_buf;
-            pu1_buf += (ps_app_ctxt->u4_wd >> 1) * (ps_app_ctxt->u4_ht >> 1);
-            ps_inp_raw_buf->apv_bufs[2] = pu1_buf;
-
-            ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd;
-            ps_inp_raw_buf->au4_wd[1] =  ps_app_ctxt->u4_wd / 2;
-            ps_inp_raw_buf->au4_wd[2] =  ps_app_ctxt->u4_wd / 2;
-
-            ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
-            ps_inp_raw_buf->au4_ht[1] =  ps_app_ctxt->u4_ht / 2;
-            ps_inp_raw_buf->au4_ht[2] =  ps_app_ctxt->u4_ht / 2;
-
-            ps_inp_raw_buf->au4_strd[0] =  ps_app_ctxt->u4_strd;
-            ps_inp_raw_buf->au4_strd[1] =  ps_app_ctxt->u4_strd / 2;
-            ps_inp_raw_buf->au4_strd[2] =  ps_app_ctxt->u4_strd / 2;
-
-        }
-        else if(IV_YUV_422ILE == ps_app_ctxt->e_inp_color_fmt)
-        {
-            /*init luma buffer*/
-            ps_inp_raw_buf->apv_bufs[0] = pu1_buf;
-
-            ps_inp_raw_buf->au4_wd[0] =  ps_app_ctxt->u4_wd * 2;
-
-            ps_inp_raw_buf->au4_ht[0] =  ps_app_ctxt->u4_ht;
-
-            ps_inp_raw_buf->au4_strd[0] = ps_app_ctxt->u4_strd *2;
-        }
+        init_input_buf_descr(ps_app_ctxt, ps_inp_raw_buf, pu1_buf);
 
         /*
          * Here we read input and other associated buffers. Regardless of success
@@ -1839,6 +2002,8 @@ void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
             peak_avg /= PEAK_WINDOW_SIZE;
             if (peak_avg > peak_avg_max)
                 peak_avg_max = peak_avg;
+            if (timetaken > ps_app_ctxt->max_time)
+                ps_app_ctxt->max_time = timetaken;
         }
 #endif
 
@@ -1859,6 +2024,21 @@ void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
                 printf("Error: Unable to write to output file\n");
                 break;
             }
+
+            if(ps_app_ctxt->fp_rc_stats && ih264e_video_encode_op.pv_rc_stats)
+            {
+                fwrite(ih264e_video_encode_op.pv_rc_stats, 1,
+                       ih264e_video_encode_op.u4_rc_stats_size,
+                       ps_app_ctxt->fp_rc_stats);
+            }
+
+            if(ps_app_ctxt->u4_stats)
+            {
+                ih264e_ctl_get_stats_op_t s_stats_op;
+
+                get_stats(ps_enc, &s_stats_op);
+                print_stats(&s_stats_op, s_stats_op.u4_num_frames - 1);
+            }
         }
 
         /* free input bufer if codec returns a valid input buffer */
@@ -2082,12 +2262,336 @@ void synchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
     {
         fclose(ps_app_ctxt->fp_pic_info);
     }
+    if(ps_app_ctxt->fp_rc_stats)
+    {
+        fclose(ps_app_ctxt->fp_rc_stats);
+    }
 
     free_input(ps_app_ctxt);
     free_output(ps_app_ctxt);
     free_recon(ps_app_ctxt);
 }
 
+void release_input(app_ctxt_t *ps_app_ctxt, iv_raw_buf_t *ps_inp_raw_buf)
+{
+    WORD32 i;
+
+    for(i = 0; i < DEFAULT_MAX_INPUT_BUFS; i++)
+    {
+        if(ps_app_ctxt->as_input_buf[i].pu1_buf == ps_inp_raw_buf->apv_bufs[0])
+        {
+            ps_app_ctxt->as_input_buf[i].u4_is_free = 1;
+            break;
+        }
+    }
+}
+
+void wait_for_input(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
+{
+    ih264e_dequeue_inp_ip_t s_dequeue_inp_ip;
+    ih264e_dequeue_inp_op_t s_dequeue_inp_op;
+    IV_STATUS_T status;
+
+    s_dequeue_inp_ip.s_ive_ip.u4_size = sizeof(ih264e_dequeue_inp_ip_t);
+    s_dequeue_inp_op.s_ive_op.u4_size = sizeof(ih264e_dequeue_inp_op_t);
+    s_dequeue_inp_ip.s_ive_ip.e_cmd = IVE_CMD_DEQUEUE_INPUT;
+    s_dequeue_inp_ip.s_ive_ip.u4_is_blocking = 1;
+
+    status = ih264e_api_function(ps_enc, &s_dequeue_inp_ip, &s_dequeue_inp_op);
+    if(IV_SUCCESS != status)
+    {
+        CHAR ac_error[STRLENGTH];
+        sprintf(ac_error, "Dequeue input failed = 0x%x\n",
+                s_dequeue_inp_op.s_ive_op.u4_error_code);
+        codec_exit(ac_error);
+    }
+
+    release_input(ps_app_ctxt, &s_dequeue_inp_op.s_ive_op.s_inp_buf);
+}
+
+void asynchronous_encode(iv_obj_t *ps_enc, app_ctxt_t *ps_app_ctxt)
+{
+    ih264e_queue_inp_ip_t s_queue_inp_ip;
+    ih264e_queue_inp_op_t s_queue_inp_op;
+    ih264e_dequeue_inp_ip_t s_dequeue_inp_ip;
+    ih264e_dequeue_inp_op_t s_dequeue_inp_op;
+    ih264e_queue_out_ip_t s_queue_out_ip;
+    ih264e_queue_out_op_t s_queue_out_op;
+    ih264e_dequeue_out_ip_t s_dequeue_out_ip;
+    ih264e_dequeue_out_op_t s_dequeue_out_op;
+
+    iv_raw_buf_t *ps_inp_raw_buf = &s_queue_inp_ip.s_ive_ip.s_inp_buf;
+
+    IV_STATUS_T status = IV_SUCCESS;
+
+    WORD32 i, is_last = 0, inp_pending = 0;
+    UWORD8 *pu1_buf = NULL;
+    UWORD32 u4_timestamp_low = 0;
+    void *pv_mb_info = NULL, *pv_pic_info = NULL;
+    CHAR ac_error[STRLENGTH];
+    UWORD8 u1_pic_type[][5] = { "IDR", "I", "P", "B", "NA" };
+    WORD32 timetaken = 0;
+    TIMER curtime;
+#ifdef WINDOWS_TIMER
+    TIMER frequency;
+#endif
+
+    /*************************************************************************/
+    /*                         Allocate I/O Buffers                          */
+    /*************************************************************************/
+    allocate_input(ps_app_ctxt);
+    allocate_output(ps_app_ctxt);
+
+    ps_app_ctxt->fp_ip = fopen(ps_app_ctxt->ac_ip_fname, "rb");
+    if(NULL == ps_app_ctxt->fp_ip)
+    {
+        sprintf(ac_error, "Unable to open input file for reading: %s", ps_app_ctxt->ac_ip_fname);
+        invalid_argument_exit(ac_error);
+    }
+
+    ps_app_ctxt->fp_op = fopen(ps_app_ctxt->ac_op_fname, "wb");
+    if(NULL == ps_app_ctxt->fp_op)
+    {
+        sprintf(ac_error, "Unable to open output file for writing: %s", ps_app_ctxt->ac_op_fname);
+        invalid_argument_exit(ac_error);
+    }
+
+    if(0 != ps_app_ctxt->u4_mb_info_type)
+    {
+        ps_app_ctxt->fp_mb_info  = fopen(ps_app_ctxt->ac_mb_info_fname, "rb");
+        if(NULL == ps_app_ctxt->fp_mb_info)
+        {
+            sprintf(ac_error, "Unable to open MB info file for reading: %s", ps_app_ctxt->ac_mb_info_fname);
+            invalid_argument_exit(ac_error);
+        }
+    }
+    if (ps_app_ctxt->u4_pic_info_type)
+    {
+        ps_app_ctxt->fp_pic_info  = fopen(ps_app_ctxt->ac_pic_info_fname, "rb");
+        if(NULL == ps_app_ctxt->fp_pic_info)
+        {
+            sprintf(ac_error, "Unable to open Pic info file for reading: %s", ps_app_ctxt->ac_pic_info_fname);
+            invalid_argument_exit(ac_error);
+        }
+    }
+
+    s_queue_inp_ip.s_ive_ip.u4_size = sizeof(ih264e_queue_inp_ip_t);
+    s_queue_inp_op.s_ive_op.u4_size = sizeof(ih264e_queue_inp_op_t);
+    s_queue_inp_ip.s_ive_ip.e_cmd = IVE_CMD_QUEUE_INPUT;
+    s_queue_inp_ip.s_ive_ip.u4_is_blocking = 0;
+
+    s_dequeue_inp_ip.s_ive_ip.u4_size = sizeof(ih264e_dequeue_inp_ip_t);
+    s_dequeue_inp_op.s_ive_op.u4_size = sizeof(ih264e_dequeue_inp_op_t);
+    s_dequeue_inp_ip.s_ive_ip.e_cmd = IVE_CMD_DEQUEUE_INPUT;
+
+    s_queue_out_ip.s_ive_ip.u4_size = sizeof(ih264e_queue_out_ip_t);
+    s_queue_out_op.s_ive_op.u4_size = sizeof(ih264e_queue_out_op_t);
+    s_queue_out_ip.s_ive_ip.e_cmd = IVE_CMD_QUEUE_OUTPUT;
+    s_queue_out_ip.s_ive_ip.u4_is_blocking = 0;
+    s_queue_out_ip.s_ive_ip.u4_is_last = 0;
+
+    s_dequeue_out_ip.s_ive_ip.u4_size = sizeof(ih264e_dequeue_out_ip_t);
+    s_dequeue_out_op.s_ive_op.u4_size = sizeof(ih264e_dequeue_out_op_t);
+    s_dequeue_out_ip.s_ive_ip.e_cmd = IVE_CMD_DEQUEUE_OUTPUT;
+
+    /* hand over as many bitstream buffers as the encoder takes */
+    for(i = 0; i < DEFAULT_MAX_OUTPUT_BUFS; i++)
+    {
+        if(ps_app_ctxt->as_output_buf[i].u4_is_free)
+        {
+            s_queue_out_ip.s_ive_ip.s_out_buf.pv_buf = ps_app_ctxt->as_output_buf[i].pu1_buf;
+            s_queue_out_ip.s_ive_ip.s_out_buf.u4_bytes = 0;
+            s_queue_out_ip.s_ive_ip.s_out_buf.u4_bufsize = ps_app_ctxt->as_output_buf[i].u4_buf_size;
+
+            status = ih264e_api_function(ps_enc, &s_queue_out_ip, &s_queue_out_op);
+            if(IV_SUCCESS != status)
+                break;
+
+            ps_app_ctxt->as_output_buf[i].u4_is_free = 0;
+        }
+    }
+
+    GETTIME(&ps_app_ctxt->enc_start_time);
+    ps_app_ctxt->enc_last_time = ps_app_ctxt->enc_start_time;
+
+    while(1)
+    {
+        WORD32 blocking = 0, inp_queued = 0;
+
+        /******************************************************************************/
+        /****************** Queue an input ********************************************/
+        /******************************************************************************/
+        if((0 == is_last) && (0 == inp_pending))
+        {
+            for(i = 0; i < DEFAULT_MAX_INPUT_BUFS; i++)
+            {
+                if(ps_app_ctxt->as_input_buf[i].u4_is_free)
+                    break;
+            }
+
+            if(i < DEFAULT_MAX_INPUT_BUFS)
+            {
+                WORD32 end_of_input = 0;
+
+                pu1_buf = ps_app_ctxt->as_input_buf[i].pu1_buf;
+                pv_mb_info = ps_app_ctxt->as_input_buf[i].pv_mb_info;
+                pv_pic_info = ps_app_ctxt->as_input_buf[i].pv_pic_info;
+
+                init_input_buf_descr(ps_app_ctxt, ps_inp_raw_buf, pu1_buf);
+
+                if(((ps_app_ctxt->u4_max_num_frms) <= u4_timestamp_low)
+                                || (IV_SUCCESS != read_input(ps_app_ctxt->fp_ip, ps_inp_raw_buf))
+                                || ((ps_app_ctxt->u4_mb_info_type != 0)
+                                                && (IV_SUCCESS != read_mb_info(ps_app_ctxt, pv_mb_info)))
+                                || ((ps_app_ctxt->u4_pic_info_type != 0)
+                                                && (IV_SUCCESS != read_pic_info(ps_app_ctxt, pv_pic_info))))
+                {
+                    /* end of stream is signalled with an empty input */
+                    end_of_input = 1;
+                    ps_inp_raw_buf->apv_bufs[0] = NULL;
+                    ps_inp_raw_buf->apv_bufs[1] = NULL;
+                    ps_inp_raw_buf->apv_bufs[2] = NULL;
+                }
+                else
+                {
+                    ps_app_ctxt->as_input_buf[i].u4_is_free = 0;
+                }
+
+                s_queue_inp_ip.s_ive_ip.u4_mb_info_type = ps_app_ctxt->u4_mb_info_type;
+                s_queue_inp_ip.s_ive_ip.u4_mb_info_size = ps_app_ctxt->u4_mb_info_size;
+                s_queue_inp_ip.s_ive_ip.pv_mb_info = pv_mb_info;
+                s_queue_inp_ip.s_ive_ip.u4_pic_info_type = ps_app_ctxt->u4_pic_info_type;
+                s_queue_inp_ip.s_ive_ip.pv_pic_info = pv_pic_info;
+                s_queue_inp_ip.s_ive_ip.u4_timestamp_low = u4_timestamp_low;
+                s_queue_inp_ip.s_ive_ip.u4_timestamp_high = 0;
+                s_queue_inp_ip.s_ive_ip.u4_is_last = end_of_input;
+
+                inp_pending = 1;
+            }
+        }
+
+        /* the encoder refuses the input while too many are outstanding, it is
+         * queued again in the next iteration */
+        if(inp_pending)
+        {
+            status = ih264e_api_function(ps_enc, &s_queue_inp_ip, &s_queue_inp_op);
+            if(IV_SUCCESS == status)
+            {
+                is_last = s_queue_inp_ip.s_ive_ip.u4_is_last;
+                inp_pending = 0;
+                inp_queued = 1;
+                u4_timestamp_low++;
+            }
+        }
+
+        /******************************************************************************/
+        /****************** Recycle inputs ********************************************/
+        /******************************************************************************/
+        s_dequeue_inp_ip.s_ive_ip.u4_is_blocking = 0;
+        while(IV_SUCCESS == ih264e_api_function(ps_enc, &s_dequeue_inp_ip, &s_dequeue_inp_op))
+        {
+            release_input(ps_app_ctxt, &s_dequeue_inp_op.s_ive_op.s_inp_buf);
+        }
+
+        /******************************************************************************/
+        /****************** Writing Output ********************************************/
+        /******************************************************************************/
+        /* once all inputs are queued, wait for the remaining outputs */
+        blocking = is_last;
+
+        while(1)
+        {
+            WORD32 lookup_idx = 4, num_bytes;
+
+            s_dequeue_out_ip.s_ive_ip.u4_is_blocking = blocking;
+            status = ih264e_api_function(ps_enc, &s_dequeue_out_ip, &s_dequeue_out_op);
+            if(IV_SUCCESS != status)
+                break;
+
+            if(NULL == s_dequeue_out_op.s_ive_op.s_out_buf.pv_buf)
+                break;
+
+            num_bytes = s_dequeue_out_op.s_ive_op.s_out_buf.u4_bytes;
+            pu1_buf = (UWORD8 *)s_dequeue_out_op.s_ive_op.s_out_buf.pv_buf;
+
+            status = write_output(ps_app_ctxt->fp_op, pu1_buf, num_bytes);
+            if(IV_SUCCESS != status)
+            {
+                printf("Error: Unable to write to output file\n");
+                break;
+            }
+
+            if(IV_IDR_FRAME == s_dequeue_out_op.u4_encoded_frame_type)
+                lookup_idx = 0;
+            else if(IV_I_FRAME == s_dequeue_out_op.u4_encoded_frame_type)
+                lookup_idx = 1;
+            else if(IV_P_FRAME == s_dequeue_out_op.u4_encoded_frame_type)
+                lookup_idx = 2;
+            else if(IV_B_FRAME == s_dequeue_out_op.u4_encoded_frame_type)
+                lookup_idx = 3;
+
+            if(4 != lookup_idx)
+            {
+                /* frames are encoded in parallel with the queue calls, so the
+                 * average is the wall time since the start over frames out */
+#ifdef WINDOWS_TIMER
+                QueryPerformanceFrequency(&frequency);
+#endif
+                GETTIME(&curtime);
+                ELAPSEDTIME(ps_app_ctxt->enc_start_time, curtime, timetaken, frequency);
+
+                ps_app_ctxt->u4_pics_cnt++;
+                ps_app_ctxt->avg_time = timetaken / ps_app_ctxt->u4_pics_cnt;
+                ps_app_ctxt->u4_total_bytes += num_bytes;
+
+                printf("[%s] PicNum %4d Bytes Generated %6d\n",
+                       u1_pic_type[lookup_idx], ps_app_ctxt->u4_pics_cnt,
+                       num_bytes);
+            }
+
+            if(1 == s_dequeue_out_op.s_ive_op.u4_is_last)
+                break;
+
+            /* give the buffer back to the encoder, it is refused once the
+             * encoder has returned its last output */
+            s_queue_out_ip.s_ive_ip.s_out_buf = s_dequeue_out_op.s_ive_op.s_out_buf;
+            s_queue_out_ip.s_ive_ip.s_out_buf.u4_bytes = 0;
+
+            ih264e_api_function(ps_enc, &s_queue_out_ip, &s_queue_out_op);
+        }
+
+        /* Break if all the encoded frames are taken from encoder */
+        if(is_last)
+        {
+            if(IV_SUCCESS != status)
+                printf("Dequeue output failed = 0x%x\n", s_dequeue_out_op.s_ive_op.u4_error_code);
+            break;
+        }
+
+        /* no input could be queued, wait for the encoder to return one */
+        if(0 == inp_queued)
+        {
+            wait_for_input(ps_enc, ps_app_ctxt);
+        }
+    }
+
+    /* house keeping operations */
+    fclose(ps_app_ctxt->fp_ip);
+    fclose(ps_app_ctxt->fp_op);
+
+    if(0 != ps_app_ctxt->u4_mb_info_type)
+    {
+        fclose(ps_app_ctxt->fp_mb_info);
+    }
+    if (ps_app_ctxt->u4_pic_info_type)
+    {
+        fclose(ps_app_ctxt->fp_pic_info);
+    }
+
+    free_input(ps_app_ctxt);
+    free_output(ps_app_ctxt);
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : main                                                     */
@@ -2230,6 +2734,23 @@ int main(int argc, char *argv[])
 
     validate_params(&s_app_ctxt);
 
+    /* Pin the app thread before the encoder memory is allocated and first
+     * touched, so that it is placed on the NUMA node of the given CPUs */
+    if(s_app_ctxt.u4_num_affinity_cpus)
+    {
+        WORD32 ai4_cpus[MAX_AFFINITY_CPUS];
+
+        for(i = 0; i < (WORD32)s_app_ctxt.u4_num_affinity_cpus; i++)
+        {
+            ai4_cpus[i] = s_app_ctxt.au4_affinity_cpus[i];
+        }
+        if(0 != ithread_set_affinity_list(ai4_cpus,
+                                          s_app_ctxt.u4_num_affinity_cpus))
+        {
+            codec_exit("Unable to pin to the CPU list\n");
+        }
+    }
+
 
     /*************************************************************************/
     /*                      Getting Number of MemRecords                     */
@@ -2381,6 +2902,34 @@ int main(int argc, char *argv[])
         s_init_ip.s_ive_ip.u4_slice_param       = s_app_ctxt.u4_slice_param;
         s_init_ip.s_ive_ip.e_arch               = s_app_ctxt.e_arch;
         s_init_ip.s_ive_ip.e_soc                = s_app_ctxt.e_soc;
+        s_init_ip.u4_keep_threads_active        = s_app_ctxt.u4_keep_threads_active;
+        s_init_ip.u4_lookahead                  = s_app_ctxt.u4_lookahead;
+
+        /* A second pass reads the rc stats written by the first pass */
+        if(IVE_RC_TWOPASS == s_app_ctxt.u4_rc)
+        {
+            FILE *fp_rc_stats = fopen(s_app_ctxt.ac_rc_stats_fname, "rb");
+            if(NULL == fp_rc_stats)
+            {
+                sprintf(ac_error, "Unable to open rc stats file for reading: %s", s_app_ctxt.ac_rc_stats_fname);
+                invalid_argument_exit(ac_error);
+            }
+            fseek(fp_rc_stats, 0, SEEK_END);
+            s_app_ctxt.u4_rc_stats_size = ftell(fp_rc_stats);
+            fseek(fp_rc_stats, 0, SEEK_SET);
+            s_app_ctxt.pv_rc_stats = malloc(s_app_ctxt.u4_rc_stats_size);
+            if((NULL == s_app_ctxt.pv_rc_stats)
+                            || (fread(s_app_ctxt.pv_rc_stats, 1, s_app_ctxt.u4_rc_stats_size, fp_rc_stats)
+                                            != s_app_ctxt.u4_rc_stats_size))
+            {
+                sprintf(ac_error, "Unable to read rc stats file: %s", s_app_ctxt.ac_rc_stats_fname);
+                codec_exit(ac_error);
+            }
+            fclose(fp_rc_stats);
+        }
+        s_init_ip.pv_rc_stats                   = s_app_ctxt.pv_rc_stats;
+        s_init_ip.u4_rc_stats_size              = s_app_ctxt.u4_rc_stats_size;
+        s_init_ip.u4_frame_pipelining           = s_app_ctxt.u4_frame_pipelining;
 
         status = ih264e_api_function(ps_enc, &s_init_ip, &s_init_op);
 
@@ -2418,6 +2967,62 @@ int main(int argc, char *argv[])
 
     }
 
+    /*************************************************************************/
+    /*                        set cpu affinity                               */
+    /*************************************************************************/
+    if(s_app_ctxt.u4_num_affinity_cpus)
+    {
+        ih264e_ctl_set_cpu_affinity_ip_t s_ctl_set_cpu_affinity_ip;
+        ih264e_ctl_set_cpu_affinity_op_t s_ctl_set_cpu_affinity_op;
+
+        s_ctl_set_cpu_affinity_ip.e_cmd = IVE_CMD_VIDEO_CTL;
+        s_ctl_set_cpu_affinity_ip.e_sub_cmd =
+                        (IVE_CONTROL_API_COMMAND_TYPE_T)IH264E_CMD_CTL_SET_CPU_AFFINITY;
+        s_ctl_set_cpu_affinity_ip.u4_num_cpus = s_app_ctxt.u4_num_affinity_cpus;
+        memcpy(s_ctl_set_cpu_affinity_ip.au4_cpu_ids,
+               s_app_ctxt.au4_affinity_cpus,
+               s_app_ctxt.u4_num_affinity_cpus * sizeof(UWORD32));
+        s_ctl_set_cpu_affinity_ip.u4_size = sizeof(ih264e_ctl_set_cpu_affinity_ip_t);
+
+        s_ctl_set_cpu_affinity_op.u4_size = sizeof(ih264e_ctl_set_cpu_affinity_op_t);
+
+        status = ih264e_api_function(ps_enc, (void *) &s_ctl_set_cpu_affinity_ip,
+                (void *) &s_ctl_set_cpu_affinity_op);
+        if(status != IV_SUCCESS)
+        {
+            sprintf(ac_error, "Unable to set cpu affinity = 0x%x\n",
+                    s_ctl_set_cpu_affinity_op.u4_error_code);
+            codec_exit(ac_error);
+        }
+    }
+
+    /*************************************************************************/
+    /*                        enable statistics                              */
+    /*************************************************************************/
+    if(s_app_ctxt.u4_stats)
+    {
+        ih264e_ctl_set_stats_ip_t s_ctl_set_stats_ip;
+        ih264e_ctl_set_stats_op_t s_ctl_set_stats_op;
+
+        s_ctl_set_stats_ip.e_cmd = IVE_CMD_VIDEO_CTL;
+        s_ctl_set_stats_ip.e_sub_cmd =
+                        (IVE_CONTROL_API_COMMAND_TYPE_T)IH264E_CMD_CTL_SET_STATS;
+        s_ctl_set_stats_ip.u4_enable_stats = 1;
+        s_ctl_set_stats_ip.u4_reset_stats = 1;
+        s_ctl_set_stats_ip.u4_size = sizeof(ih264e_ctl_set_stats_ip_t);
+
+        s_ctl_set_stats_op.u4_size = sizeof(ih264e_ctl_set_stats_op_t);
+
+        status = ih264e_api_function(ps_enc, (void *) &s_ctl_set_stats_ip,
+                (void *) &s_ctl_set_stats_op);
+        if(status != IV_SUCCESS)
+        {
+            sprintf(ac_error, "Unable to enable statistics = 0x%x\n",
+                    s_ctl_set_stats_op.u4_error_code);
+            codec_exit(ac_error);
+        }
+    }
+
     /*************************************************************************/
     /*                        Get Codec Version                              */
     /*************************************************************************/
@@ -2443,6 +3048,29 @@ int main(int argc, char *argv[])
         printf("CODEC VERSION %s\n", ac_version_string);
     }
 
+    /*************************************************************************/
+    /*                        Get Codec Architecture                         */
+    /*************************************************************************/
+    {
+        ih264e_ctl_get_arch_ip_t s_ctl_get_arch_ip;
+        ih264e_ctl_get_arch_op_t s_ctl_get_arch_op;
+
+        s_ctl_get_arch_ip.s_ive_ip.e_cmd = IVE_CMD_VIDEO_CTL;
+        s_ctl_get_arch_ip.s_ive_ip.e_sub_cmd = IVE_CMD_CTL_GET_ARCH;
+        s_ctl_get_arch_ip.s_ive_ip.u4_size = sizeof(ih264e_ctl_get_arch_ip_t);
+        s_ctl_get_arch_op.s_ive_op.u4_size = sizeof(ih264e_ctl_get_arch_op_t);
+
+        status = ih264e_api_function(ps_enc, (void *) &s_ctl_get_arch_ip,
+                (void *) &s_ctl_get_arch_op);
+        if(status != IV_SUCCESS)
+        {
+            sprintf(ac_error, "Unable to get codec arch = 0x%x\n",
+                    s_ctl_get_arch_op.s_ive_op.u4_error_code);
+            codec_exit(ac_error);
+        }
+        printf("CODEC ARCH %d\n", s_ctl_get_arch_op.s_ive_op.e_arch);
+    }
+
     /*************************************************************************/
     /*                      Get I/O Buffer Requirement                       */
     /*************************************************************************/
@@ -2560,13 +3188,19 @@ int main(int argc, char *argv[])
 
     sprintf(filename_with_path, "%s/%s", documentdir, s_app_ctxt.ac_pic_info_fname);
     strcpy (s_app_ctxt.ac_pic_info_fname, filename_with_path);
+
+    sprintf(filename_with_path, "%s/%s", documentdir, s_app_ctxt.ac_rc_stats_fname);
+    strcpy (s_app_ctxt.ac_rc_stats_fname, filename_with_path);
 #endif
 
     /*************************************************************************/
     /*               begin encoding                                          */
     /*************************************************************************/
 
-    synchronous_encode(ps_enc, &s_app_ctxt);
+    if(1 == s_app_ctxt.u4_async)
+        asynchronous_encode(ps_enc, &s_app_ctxt);
+    else
+        synchronous_encode(ps_enc, &s_app_ctxt);
 
     {
         DOUBLE bytes_per_frame;
@@ -2593,8 +3227,23 @@ int main(int argc, char *argv[])
         printf("Output Height                   : %-4d\n", s_app_ctxt.u4_ht);
         printf("Target Bitrate (bps)            : %-4d\n", s_app_ctxt.u4_bitrate);
         printf("Achieved Bitrate (bps)          : %-4d\n", achieved_bitrate);
-        printf("Average Time per Frame          : %-4d\n", s_app_ctxt.avg_time);
-        printf("Achieved FPS                    : %-4.2f\n", 1000000.0 / s_app_ctxt.avg_time);
+        if(0 != s_app_ctxt.avg_time)
+        {
+            printf("Average Time per Frame          : %-4d\n", s_app_ctxt.avg_time);
+            printf("Achieved FPS                    : %-4.2f\n", 1000000.0 / s_app_ctxt.avg_time);
+        }
+        if(0 != s_app_ctxt.max_time)
+        {
+            printf("Max Time per Frame              : %-4d\n", s_app_ctxt.max_time);
+        }
+    }
+
+    if(s_app_ctxt.u4_stats)
+    {
+        ih264e_ctl_get_stats_op_t s_stats_op;
+
+        get_stats(ps_enc, &s_stats_op);
+        print_stats(&s_stats_op, -1);
     }
 
 
@@ -2635,6 +3284,8 @@ int main(int argc, char *argv[])
 
     }
 
+    free(s_app_ctxt.pv_rc_stats);
+
     return 0;
 }
 